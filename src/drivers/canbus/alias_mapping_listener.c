@@ -28,7 +28,9 @@
  * @brief On-demand alias resolution table for consist listener nodes.
  *
  * @details Single static table instance using a linear array. Empty slots have
- * node_id == 0. First-fit allocation. NOT thread-safe — callers must use
+ * node_id == 0. First-fit allocation. Node ID and alias lookups go through two
+ * open-addressed hash indexes (LISTENER_ALIAS_HASH_SIZE buckets each); only
+ * resolved entries (alias != 0) are in the alias index. NOT thread-safe — callers must use
  * lock_shared_resources / unlock_shared_resources around shared access.
  *
  * @author Jim Kueneman
@@ -37,15 +39,26 @@
 
 #include "alias_mapping_listener.h"
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
 #include "can_types.h"
+#include "can_utilities.h"
 #include "../../openlcb/openlcb_types.h"
 
+/** @brief Bucket mask for both hash indexes. */
+#define LISTENER_ALIAS_HASH_MASK ((uint16_t) (LISTENER_ALIAS_HASH_SIZE - 1))
+
 /** @brief Static storage for the listener alias table. */
 static listener_alias_entry_t _table[LISTENER_ALIAS_TABLE_DEPTH];
 
+/** @brief Hash index by Node ID; each bucket holds table slot + 1, 0 = empty. */
+static uint16_t _node_id_index[LISTENER_ALIAS_HASH_SIZE];
+
+/** @brief Hash index by resolved alias; each bucket holds table slot + 1, 0 = empty. */
+static uint16_t _alias_index[LISTENER_ALIAS_HASH_SIZE];
+
 /** @brief Round-robin cursor for distributed verification. */
 static uint16_t _verify_cursor = 0;
 
@@ -57,6 +70,110 @@ static uint8_t _verify_last_tick = 0;
  *  up to 65535 work correctly without wraparound issues. */
 static uint16_t _verify_counter = 0;
 
+/** @brief Number of registered listener Node IDs; selects targeted or bulk probing. */
+static uint16_t _registered_count = 0;
+
+/** @brief True from a bulk round's global AME until its timeout sweep has run. */
+static bool _bulk_pending = false;
+
+/** @brief _verify_counter value when the last bulk round started. */
+static uint16_t _bulk_ticks = 0;
+
+/** @brief Set when a bulk round starts; cleared by AliasMappingListener_take_bulk_enquiry(). */
+static bool _bulk_enquiry_due = false;
+
+    /** @brief Returns the Node ID-index home bucket of the Node ID stored in a table slot. */
+static uint16_t _node_id_home_of_slot(uint16_t slot) {
+
+    return CanUtilities_hash_node_id(_table[slot].node_id, LISTENER_ALIAS_HASH_MASK);
+
+}
+
+    /** @brief Returns the alias-index home bucket of the alias stored in a table slot. */
+static uint16_t _alias_home_of_slot(uint16_t slot) {
+
+    return CanUtilities_hash_alias(_table[slot].alias, LISTENER_ALIAS_HASH_MASK);
+
+}
+
+    /** @brief Returns the table slot registered for node_id, or -1. */
+static int _find_slot_by_node_id(node_id_t node_id) {
+
+    uint16_t bucket = CanUtilities_hash_node_id(node_id, LISTENER_ALIAS_HASH_MASK);
+
+    while (_node_id_index[bucket] != 0) {
+
+        int slot = _node_id_index[bucket] - 1;
+
+        if (_table[slot].node_id == node_id) {
+
+            return slot;
+
+        }
+
+        bucket = (bucket + 1) & LISTENER_ALIAS_HASH_MASK;
+
+    }
+
+    return -1;
+
+}
+
+    /** @brief Returns the table slot whose resolved alias is alias, or -1. */
+static int _find_slot_by_alias(uint16_t alias) {
+
+    uint16_t bucket = CanUtilities_hash_alias(alias, LISTENER_ALIAS_HASH_MASK);
+
+    while (_alias_index[bucket] != 0) {
+
+        int slot = _alias_index[bucket] - 1;
+
+        if (_table[slot].alias == alias) {
+
+            return slot;
+
+        }
+
+        bucket = (bucket + 1) & LISTENER_ALIAS_HASH_MASK;
+
+    }
+
+    return -1;
+
+}
+
+    /**
+     * @brief Changes the alias of a table slot and keeps the alias index in step.
+     *
+     * @verbatim
+     * @param slot   Table slot (must hold a registered node_id).
+     * @param alias  New alias, or 0 to mark the entry unresolved.
+     * @endverbatim
+     */
+static void _set_slot_alias(int slot, uint16_t alias) {
+
+    if (_table[slot].alias == alias) {
+
+        return;
+
+    }
+
+    if (_table[slot].alias != 0) {
+
+        CanUtilities_hash_index_remove(_alias_index, LISTENER_ALIAS_HASH_MASK, _alias_home_of_slot(slot), slot, &_alias_home_of_slot);
+
+    }
+
+    _table[slot].alias = alias;
+
+    if (alias != 0) {
+
+        CanUtilities_hash_index_insert(_alias_index, LISTENER_ALIAS_HASH_MASK, _alias_home_of_slot(slot), slot);
+
+    }
+
+}
+
     /** @brief Zeros all entries in the listener alias table and resets the prober cursor. */
 void AliasMappingListener_initialize(void) {
 
@@ -69,9 +186,20 @@ void AliasMappingListener_initialize(void) {
 
     }
 
+    for (int i = 0; i < LISTENER_ALIAS_HASH_SIZE; i++) {
+
+        _node_id_index[i] = 0;
+        _alias_index[i] = 0;
+
+    }
+
     _verify_cursor = 0;
     _verify_last_tick = 0;
     _verify_counter = 0;
+    _registered_count = 0;
+    _bulk_pending = false;
+    _bulk_ticks = 0;
+    _bulk_enquiry_due = false;
 
 }
 
@@ -80,8 +208,9 @@ void AliasMappingListener_initialize(void) {
      *
      * @details Algorithm:
      * -# Validate node_id is non-zero, return NULL if invalid
-     * -# Scan for existing entry with matching node_id, return it if found
+     * -# Look up node_id in the Node ID index, return the entry if found
      * -# Scan for first empty slot (node_id == 0), store node_id with alias = 0
+     *    and add it to the Node ID index
      * -# Return NULL if no empty slot (table full)
      *
      * @verbatim
@@ -99,13 +228,11 @@ listener_alias_entry_t *AliasMappingListener_register(node_id_t node_id) {
     }
 
     // Check if already registered
-    for (int i = 0; i < LISTENER_ALIAS_TABLE_DEPTH; i++) {
+    int slot = _find_slot_by_node_id(node_id);
 
-        if (_table[i].node_id == node_id) {
+    if (slot >= 0) {
 
-            return &_table[i];
-
-        }
+        return &_table[slot];
 
     }
 
@@ -118,6 +245,10 @@ listener_alias_entry_t *AliasMappingListener_register(node_id_t node_id) {
             _table[i].alias = 0;
             _table[i].verify_ticks = 0;
             _table[i].verify_pending = 0;
+
+            CanUtilities_hash_index_insert(_node_id_index, LISTENER_ALIAS_HASH_MASK, _node_id_home_of_slot(i), i);
+            _registered_count++;
+
             return &_table[i];
 
         }
@@ -132,7 +263,8 @@ listener_alias_entry_t *AliasMappingListener_register(node_id_t node_id) {
      * @brief Removes the entry matching node_id from the table.
      *
      * @details Algorithm:
-     * -# Scan for entry with matching node_id
+     * -# Look up node_id in the Node ID index, return if not registered
+     * -# Drop the entry from both indexes
      * -# Clear both node_id and alias fields
      *
      * @verbatim
@@ -147,20 +279,22 @@ void AliasMappingListener_unregister(node_id_t node_id) {
 
     }
 
-    for (int i = 0; i < LISTENER_ALIAS_TABLE_DEPTH; i++) {
+    int slot = _find_slot_by_node_id(node_id);
 
-        if (_table[i].node_id == node_id) {
+    if (slot < 0) {
 
-            _table[i].node_id = 0;
-            _table[i].alias = 0;
-            _table[i].verify_ticks = 0;
-            _table[i].verify_pending = 0;
-            return;
-
-        }
+        return;
 
     }
 
+    _set_slot_alias(slot, 0);
+    CanUtilities_hash_index_remove(_node_id_index, LISTENER_ALIAS_HASH_MASK, _node_id_home_of_slot(slot), slot, &_node_id_home_of_slot);
+
+    _table[slot].node_id = 0;
+    _table[slot].verify_ticks = 0;
+    _table[slot].verify_pending = 0;
+    _registered_count--;
+
 }
 
     /**
@@ -168,8 +302,8 @@ void AliasMappingListener_unregister(node_id_t node_id) {
      *
      * @details Algorithm:
      * -# Validate alias is in range 0x001-0xFFF, return if invalid
-     * -# Scan for entry with matching node_id
-     * -# Store alias if found; no-op if node_id is not in the table
+     * -# Look up node_id in the Node ID index
+     * -# Store alias (re-indexing it) if found; no-op if node_id is not in the table
      *
      * @verbatim
      * @param node_id  48-bit OpenLCB Node ID from the AMD payload.
@@ -190,26 +324,25 @@ void AliasMappingListener_set_alias(node_id_t node_id, uint16_t alias) {
 
     }
 
-    for (int i = 0; i < LISTENER_ALIAS_TABLE_DEPTH; i++) {
-
-        if (_table[i].node_id == node_id) {
+    int slot = _find_slot_by_node_id(node_id);
 
-            _table[i].alias = alias;
-            _table[i].verify_ticks = _verify_counter;
-            _table[i].verify_pending = 0;
-            return;
+    if (slot < 0) {
 
-        }
+        return;
 
     }
 
+    _set_slot_alias(slot, alias);
+    _table[slot].verify_ticks = _verify_counter;
+    _table[slot].verify_pending = 0;
+
 }
 
     /**
      * @brief Finds the table entry for a given listener Node ID.
      *
      * @details Algorithm:
-     * -# Scan for entry with matching node_id
+     * -# Probe the Node ID index from the Node ID's home bucket
      * -# Return pointer to entry, or NULL if not found
      *
      * @verbatim
@@ -226,17 +359,15 @@ listener_alias_entry_t *AliasMappingListener_find_by_node_id(node_id_t node_id)
 
     }
 
-    for (int i = 0; i < LISTENER_ALIAS_TABLE_DEPTH; i++) {
-
-        if (_table[i].node_id == node_id) {
+    int slot = _find_slot_by_node_id(node_id);
 
-            return &_table[i];
+    if (slot < 0) {
 
-        }
+        return NULL;
 
     }
 
-    return NULL;
+    return &_table[slot];
 
 }
 
@@ -246,6 +377,7 @@ listener_alias_entry_t *AliasMappingListener_find_by_node_id(node_id_t node_id)
      * @details Algorithm:
      * -# Iterate all LISTENER_ALIAS_TABLE_DEPTH entries
      * -# Set alias = 0 on each; leave node_id untouched
+     * -# Empty the alias index (the Node ID index is unchanged)
      */
 void AliasMappingListener_flush_aliases(void) {
 
@@ -256,6 +388,12 @@ void AliasMappingListener_flush_aliases(void) {
 
     }
 
+    for (int i = 0; i < LISTENER_ALIAS_HASH_SIZE; i++) {
+
+        _alias_index[i] = 0;
+
+    }
+
 }
 
     /**
@@ -263,8 +401,8 @@ void AliasMappingListener_flush_aliases(void) {
      *
      * @details Algorithm:
      * -# Validate alias is non-zero
-     * -# Scan for entry with matching alias
-     * -# Set alias = 0 if found; leave node_id intact
+     * -# Probe the alias index for the entry holding alias
+     * -# Set alias = 0 (dropping it from the index) if found; leave node_id intact
      *
      * @verbatim
      * @param alias  12-bit CAN alias being released.
@@ -278,18 +416,104 @@ void AliasMappingListener_clear_alias_by_alias(uint16_t alias) {
 
     }
 
-    for (int i = 0; i < LISTENER_ALIAS_TABLE_DEPTH; i++) {
+    int slot = _find_slot_by_alias(alias);
 
-        if (_table[i].alias == alias) {
+    if (slot < 0) {
+
+        return;
+
+    }
+
+    _set_slot_alias(slot, 0);
+    _table[slot].verify_pending = 0;
+
+}
+
+    /** @brief Returns true when the table is large enough to revalidate with one global AME. */
+static bool _is_bulk_mode(void) {
+
+#if USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD > 0
+
+    return _registered_count >= USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD;
+
+#else
+
+    return false;
+
+#endif
+
+}
+
+    /**
+     * @brief Advances one bulk revalidation round.
+     *
+     * @details Algorithm:
+     * -# While a round is pending: once VERIFY_TIMEOUT has passed, clear the
+     *    alias of every entry still pending in one pass and end the round
+     * -# Otherwise, once PROBE_INTERVAL has passed since the last round: mark
+     *    every resolved entry pending and request a global AME
+     *
+     * AMD replies reach AliasMappingListener_set_alias(), which clears pending
+     * through the Node ID index, so the sweep only finds listeners that stayed
+     * silent.
+     */
+static void _run_bulk_verification(void) {
+
+    if (_bulk_pending) {
+
+        if ((uint16_t) (_verify_counter - _bulk_ticks) < USER_DEFINED_LISTENER_VERIFY_TIMEOUT_TICKS) {
 
-            _table[i].alias = 0;
-            _table[i].verify_pending = 0;
             return;
 
         }
 
+        for (int i = 0; i < LISTENER_ALIAS_TABLE_DEPTH; i++) {
+
+            if (!_table[i].verify_pending) {
+
+                continue;
+
+            }
+
+            if ((uint16_t) (_verify_counter - _table[i].verify_ticks) >= USER_DEFINED_LISTENER_VERIFY_TIMEOUT_TICKS) {
+
+                _set_slot_alias(i, 0);
+                _table[i].verify_pending = 0;
+
+            }
+
+        }
+
+        _bulk_pending = false;
+
+        return;
+
     }
 
+    if ((uint16_t) (_verify_counter - _bulk_ticks) < USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS) {
+
+        return;
+
+    }
+
+    _bulk_ticks = _verify_counter;
+
+    for (int i = 0; i < LISTENER_ALIAS_TABLE_DEPTH; i++) {
+
+        if (_table[i].node_id == 0 || _table[i].alias == 0) {
+
+            continue;
+
+        }
+
+        _table[i].verify_pending = 1;
+        _table[i].verify_ticks = _verify_counter;
+        _bulk_pending = true;
+
+    }
+
+    _bulk_enquiry_due = _bulk_pending;
+
 }
 
     /**
@@ -302,6 +526,8 @@ void AliasMappingListener_clear_alias_by_alias(uint16_t alias) {
      *
      * Algorithm:
      * -# If fewer than PROBE_TICK_INTERVAL ticks have elapsed, return 0
+     * -# If at least LISTENER_BULK_VERIFY_THRESHOLD listeners are registered,
+     *    run the bulk round instead and return 0
      * -# Scan up to LISTENER_ALIAS_TABLE_DEPTH entries from the cursor
      * -# For each entry with verify_pending set: check timeout, clear alias
      *    if expired, continue to next entry
@@ -330,6 +556,14 @@ node_id_t AliasMappingListener_check_one_verification(uint8_t current_tick) {
     _verify_last_tick = current_tick;
     _verify_counter++;
 
+    if (_is_bulk_mode()) {
+
+        _run_bulk_verification();
+
+        return 0;  // caller picks up the global AME via take_bulk_enquiry
+
+    }
+
     // Scan up to one full table rotation looking for work
     for (int scanned = 0; scanned < LISTENER_ALIAS_TABLE_DEPTH; scanned++) {
 
@@ -355,7 +589,7 @@ node_id_t AliasMappingListener_check_one_verification(uint8_t current_tick) {
             if (age >= USER_DEFINED_LISTENER_VERIFY_TIMEOUT_TICKS) {
 
                 // Stale — no AMD reply within timeout
-                entry->alias = 0;
+                _set_slot_alias(_verify_cursor, 0);
                 entry->verify_pending = 0;
 
             }
@@ -382,4 +616,19 @@ node_id_t AliasMappingListener_check_one_verification(uint8_t current_tick) {
 
     return 0;  // nothing to do this cycle
 
+}
+
+    /**
+     * @brief Reports and clears a pending bulk revalidation request.
+     *
+     * @return true once per bulk round, after the caller should queue a global AME.
+     */
+bool AliasMappingListener_take_bulk_enquiry(void) {
+
+    bool due = _bulk_enquiry_due;
+
+    _bulk_enquiry_due = false;
+
+    return due;
+
 }
@@ -140,12 +140,31 @@ extern "C" {
          * - Verifying + timeout elapsed -> Stale (alias cleared)
          * - Verifying + AMD arrives (via set_alias) -> Resolved
          *
+         * Once USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD or more listeners are
+         * registered, entries are no longer probed one at a time: every
+         * PROBE_INTERVAL_TICKS all resolved entries go to Verifying together and
+         * AliasMappingListener_take_bulk_enquiry() asks for one global AME; after
+         * VERIFY_TIMEOUT_TICKS every entry that did not answer is cleared in a
+         * single pass.  This call then always returns 0.
+         *
          * @param current_tick  Current value of the global 100ms tick counter.
          *
          * @return @ref node_id_t to probe (caller queues targeted AME), or 0.
          */
     extern node_id_t AliasMappingListener_check_one_verification(uint8_t current_tick);
 
+        /**
+         * @brief Reports and clears a pending bulk revalidation request.
+         *
+         * @details Becomes true when AliasMappingListener_check_one_verification()
+         * starts a bulk round.  The caller queues one global AME (plus AMDs for
+         * its own aliases) and replies are reconciled through
+         * AliasMappingListener_set_alias().
+         *
+         * @return true if a global AME should be sent now, false otherwise.
+         */
+    extern bool AliasMappingListener_take_bulk_enquiry(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -976,3 +976,210 @@ TEST(AliasMappingListener, verify_initialize_resets_cursor) {
     EXPECT_EQ(result, TEST_NODE_ID_C);
 
 }
+
+/*******************************************************************************
+ * Bulk Verification Tests
+ ******************************************************************************/
+
+#if (USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD > 0) && (USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD <= LISTENER_ALIAS_TABLE_DEPTH)
+
+/**
+ * Register and resolve count listeners: Node IDs TEST_NODE_ID_A + i,
+ * aliases 0x100 + i.
+ */
+static void register_resolved_listeners(int count) {
+
+    for (int i = 0; i < count; i++) {
+
+        AliasMappingListener_register(TEST_NODE_ID_A + i);
+        AliasMappingListener_set_alias(TEST_NODE_ID_A + i, (uint16_t) (0x100 + i));
+
+    }
+
+}
+
+TEST(AliasMappingListener, bulk_round_requests_one_global_ame) {
+
+    setup_test();
+    register_resolved_listeners(USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD);
+
+    // Nothing is probed individually and no round starts before the interval
+    for (uint16_t i = 1; i < USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS; i++) {
+
+        EXPECT_EQ(AliasMappingListener_check_one_verification((uint8_t) i), (node_id_t) 0);
+        EXPECT_FALSE(AliasMappingListener_take_bulk_enquiry());
+
+    }
+
+    EXPECT_EQ(AliasMappingListener_check_one_verification((uint8_t) USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS), (node_id_t) 0);
+
+    EXPECT_TRUE(AliasMappingListener_take_bulk_enquiry());
+    EXPECT_FALSE(AliasMappingListener_take_bulk_enquiry());
+
+    for (int i = 0; i < USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD; i++) {
+
+        EXPECT_EQ(AliasMappingListener_find_by_node_id(TEST_NODE_ID_A + i)->verify_pending, 1);
+
+    }
+
+}
+
+TEST(AliasMappingListener, bulk_round_sweeps_only_silent_listeners) {
+
+    setup_test();
+    register_resolved_listeners(USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD);
+
+    uint16_t tick = 0;
+
+    for (uint16_t i = 0; i < USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS; i++) {
+
+        AliasMappingListener_check_one_verification((uint8_t) ++tick);
+
+    }
+
+    ASSERT_TRUE(AliasMappingListener_take_bulk_enquiry());
+
+    // Every listener but the first answers the global AME
+    for (int i = 1; i < USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD; i++) {
+
+        AliasMappingListener_set_alias(TEST_NODE_ID_A + i, (uint16_t) (0x100 + i));
+
+    }
+
+    for (uint16_t i = 0; i < USER_DEFINED_LISTENER_VERIFY_TIMEOUT_TICKS - 1; i++) {
+
+        AliasMappingListener_check_one_verification((uint8_t) ++tick);
+
+    }
+
+    // Still inside the reply window
+    EXPECT_EQ(AliasMappingListener_find_by_node_id(TEST_NODE_ID_A)->alias, 0x100);
+
+    AliasMappingListener_check_one_verification((uint8_t) ++tick);
+
+    listener_alias_entry_t *silent = AliasMappingListener_find_by_node_id(TEST_NODE_ID_A);
+    EXPECT_EQ(silent->alias, 0);
+    EXPECT_EQ(silent->verify_pending, 0);
+
+    for (int i = 1; i < USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD; i++) {
+
+        listener_alias_entry_t *entry = AliasMappingListener_find_by_node_id(TEST_NODE_ID_A + i);
+        EXPECT_EQ(entry->alias, (uint16_t) (0x100 + i));
+        EXPECT_EQ(entry->verify_pending, 0);
+
+    }
+
+    EXPECT_FALSE(AliasMappingListener_take_bulk_enquiry());
+
+}
+
+TEST(AliasMappingListener, bulk_mode_ends_below_threshold) {
+
+    setup_test();
+    register_resolved_listeners(USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD);
+    AliasMappingListener_unregister(TEST_NODE_ID_A);
+
+    node_id_t probed = 0;
+
+    for (uint16_t i = 1; i <= USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS; i++) {
+
+        node_id_t result = AliasMappingListener_check_one_verification((uint8_t) i);
+
+        if (result != 0) {
+
+            probed = result;
+
+        }
+
+    }
+
+    // One short of the threshold: back to one targeted probe at a time
+    EXPECT_NE(probed, (node_id_t) 0);
+    EXPECT_FALSE(AliasMappingListener_take_bulk_enquiry());
+
+}
+
+#endif
+
+/*******************************************************************************
+ * Hash Index Tests
+ ******************************************************************************/
+
+TEST(AliasMappingListener, hash_index_survives_churn) {
+
+    setup_test();
+
+    // Per slot: 0 = unregistered, 1 = registered unresolved, 2 = resolved
+    uint8_t model[LISTENER_ALIAS_TABLE_DEPTH] = {0};
+    uint32_t rng = 54321;
+
+    for (int step = 0; step < 4000; step++) {
+
+        rng = rng * 1103515245u + 12345u;
+        int pick = (rng >> 16) % LISTENER_ALIAS_TABLE_DEPTH;
+        int action = (rng >> 8) % 4;
+
+        node_id_t node_id = TEST_NODE_ID_A + pick;
+        uint16_t alias = (uint16_t) (0x200 + pick * 2);
+
+        if (model[pick] == 0) {
+
+            ASSERT_NE(AliasMappingListener_register(node_id), nullptr);
+            model[pick] = 1;
+
+        } else if (action == 0) {
+
+            AliasMappingListener_unregister(node_id);
+            model[pick] = 0;
+
+        } else if (action == 1) {
+
+            AliasMappingListener_clear_alias_by_alias(alias);
+            model[pick] = 1;
+
+        } else {
+
+            AliasMappingListener_set_alias(node_id, alias);
+            model[pick] = 2;
+
+        }
+
+        for (int i = 0; i < LISTENER_ALIAS_TABLE_DEPTH; i++) {
+
+            listener_alias_entry_t *entry = AliasMappingListener_find_by_node_id(TEST_NODE_ID_A + i);
+
+            if (model[i] == 0) {
+
+                ASSERT_EQ(entry, nullptr);
+
+            } else {
+
+                ASSERT_NE(entry, nullptr);
+                ASSERT_EQ(entry->alias, model[i] == 2 ? (uint16_t) (0x200 + i * 2) : 0);
+
+            }
+
+        }
+
+    }
+
+}
+
+TEST(AliasMappingListener, flush_then_clear_by_alias_is_noop) {
+
+    setup_test();
+
+    AliasMappingListener_register(TEST_NODE_ID_A);
+    AliasMappingListener_set_alias(TEST_NODE_ID_A, TEST_ALIAS_A);
+
+    AliasMappingListener_flush_aliases();
+    AliasMappingListener_clear_alias_by_alias(TEST_ALIAS_A);
+
+    AliasMappingListener_set_alias(TEST_NODE_ID_A, TEST_ALIAS_B);
+
+    // The flushed alias must not linger in the index and clear the new one
+    AliasMappingListener_clear_alias_by_alias(TEST_ALIAS_A);
+
+    EXPECT_EQ(AliasMappingListener_find_by_node_id(TEST_NODE_ID_A)->alias, TEST_ALIAS_B);
+
+}
@@ -0,0 +1,370 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file can_acceptance_filter.c
+ * @brief Implementation of the hardware acceptance filter generator.
+ *
+ * @details Exact filter set is one filter for control frames, one for OpenLCB
+ * standard frames and one per local alias for datagram/stream frames.  Filters
+ * are added one at a time; when the array is full the cheapest pair is merged.
+ * The last reported set is kept in static storage.  NOT thread-safe.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#include "can_acceptance_filter.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "can_types.h"
+#include "../../openlcb/openlcb_defines.h"
+
+
+/** @brief Control frames: bit 27 (CAN_OPENLCB_MSG) clear. */
+#define ACCEPTANCE_FILTER_CONTROL_ID    0x00000000
+#define ACCEPTANCE_FILTER_CONTROL_MASK  CAN_OPENLCB_MSG
+
+/** @brief OpenLCB standard frames, global or addressed (destination is in the payload). */
+#define ACCEPTANCE_FILTER_STANDARD_ID   (CAN_OPENLCB_MSG | OPENLCB_MESSAGE_STANDARD_FRAME_TYPE)
+#define ACCEPTANCE_FILTER_STANDARD_MASK (CAN_OPENLCB_MSG | MASK_CAN_FRAME_TYPE)
+
+/** @brief Datagram and stream frames for one alias (destination in bits 12-23, any frame type). */
+#define ACCEPTANCE_FILTER_ALIAS_MASK    (CAN_OPENLCB_MSG | MASK_CAN_VARIABLE_FIELD)
+
+/** @brief Saved pointer to the dependency-injected interface. */
+static interface_can_acceptance_filter_t *_interface;
+
+/** @brief Last filter set handed to the application. */
+static can_acceptance_filter_t _filters[LEN_CAN_ACCEPTANCE_FILTER];
+
+/** @brief Number of valid entries in _filters. */
+static uint16_t _filter_count;
+
+/** @brief Alias table change count the current set was built from. */
+static uint16_t _built_change_count;
+
+/** @brief False until the first set has been built and reported. */
+static bool _is_built;
+
+    /** @brief Stores the interface pointer and marks the filter set stale. */
+void CanAcceptanceFilter_initialize(const interface_can_acceptance_filter_t *interface) {
+
+    _interface = (interface_can_acceptance_filter_t *) interface;
+
+    _filter_count = 0;
+    _built_change_count = 0;
+    _is_built = false;
+
+}
+
+    /** @brief Returns the number of set bits in value. */
+static uint8_t _count_bits(uint32_t value) {
+
+    uint8_t count = 0;
+
+    while (value) {
+
+        value &= value - 1;
+        count++;
+
+    }
+
+    return count;
+
+}
+
+    /** @brief Returns true if every identifier passed by inner is also passed by outer. */
+static bool _is_subsumed(const can_acceptance_filter_t *outer, const can_acceptance_filter_t *inner) {
+
+    return ((outer->mask & ~inner->mask) == 0) && (((outer->id ^ inner->id) & outer->mask) == 0);
+
+}
+
+    /** @brief Returns the narrowest single filter passing everything a and b pass. */
+static can_acceptance_filter_t _merge(const can_acceptance_filter_t *a, const can_acceptance_filter_t *b) {
+
+    can_acceptance_filter_t result;
+
+    result.mask = a->mask & b->mask & ~(a->id ^ b->id);
+    result.id = a->id & result.mask;
+
+    return result;
+
+}
+
+    /**
+     * @brief Stores filters[index] and drops every other filter it now covers.
+     *
+     * @verbatim
+     * @param filters  Filter array.
+     * @param count    Number of valid entries.
+     * @param index    Entry that just changed.
+     * @endverbatim
+     *
+     * @return New number of valid entries.
+     */
+static uint16_t _remove_subsumed(can_acceptance_filter_t *filters, uint16_t count, uint16_t index) {
+
+    uint16_t i = 0;
+
+    while (i < count) {
+
+        if ((i != index) && _is_subsumed(&filters[index], &filters[i])) {
+
+            count--;
+            filters[i] = filters[count];
+
+            if (index == count) {
+
+                index = i;
+
+            }
+
+            continue;
+
+        }
+
+        i++;
+
+    }
+
+    return count;
+
+}
+
+    /**
+     * @brief Adds one filter, merging the cheapest pair if the array is full.
+     *
+     * @details Algorithm:
+     * -# Skip the candidate if an existing filter already passes all it passes.
+     * -# If there is room, append it and drop filters it covers.
+     * -# Otherwise find, over all pairs of existing filters plus the candidate,
+     *    the merge keeping the most mask bits and apply it, dropping covered
+     *    filters; if two existing filters merged, add the candidate again into
+     *    the freed slot.
+     *
+     * @verbatim
+     * @param filters      Filter array.
+     * @param count        Number of valid entries.
+     * @param max_filters  Array capacity.
+     * @param candidate    Filter to add.
+     * @endverbatim
+     *
+     * @return New number of valid entries.
+     */
+static uint16_t _add_filter(can_acceptance_filter_t *filters, uint16_t count, uint16_t max_filters, can_acceptance_filter_t candidate) {
+
+    candidate.id &= candidate.mask;
+
+    for (uint16_t i = 0; i < count; i++) {
+
+        if (_is_subsumed(&filters[i], &candidate)) {
+
+            return count;
+
+        }
+
+    }
+
+    if (count < max_filters) {
+
+        filters[count] = candidate;
+
+        return _remove_subsumed(filters, count + 1, count);
+
+    }
+
+    // Pair (i, count) means "existing filter i with the candidate"
+    uint16_t best_i = 0;
+    uint16_t best_j = count;
+    int best_bits = -1;
+
+    for (uint16_t i = 0; i < count; i++) {
+
+        for (uint16_t j = i + 1; j <= count; j++) {
+
+            const can_acceptance_filter_t *other = (j == count) ? &candidate : &filters[j];
+            can_acceptance_filter_t merged = _merge(&filters[i], other);
+            int bits = _count_bits(merged.mask);
+
+            if (bits > best_bits) {
+
+                best_bits = bits;
+                best_i = i;
+                best_j = j;
+
+            }
+
+        }
+
+    }
+
+    if (best_j == count) {
+
+        filters[best_i] = _merge(&filters[best_i], &candidate);
+
+        return _remove_subsumed(filters, count, best_i);
+
+    }
+
+    filters[best_i] = _merge(&filters[best_i], &filters[best_j]);
+
+    count--;
+    filters[best_j] = filters[count]; // best_i < best_j, so best_i is not the entry moved
+
+    count = _remove_subsumed(filters, count, best_i);
+
+    return _add_filter(filters, count, max_filters, candidate);
+
+}
+
+    /**
+     * @brief Computes acceptance filters for an alias table.
+     *
+     * @details Algorithm:
+     * -# Return 0 if max_filters is 0.
+     * -# Add the control frame filter and the standard frame filter.
+     * -# Add one datagram/stream filter per non-zero alias in the table.
+     *
+     * @verbatim
+     * @param alias_mapping_info  Alias table to build from.
+     * @param filters             Output array of at least max_filters entries.
+     * @param max_filters         Number of hardware filters available.
+     * @endverbatim
+     *
+     * @return Number of filters written.
+     */
+uint16_t CanAcceptanceFilter_generate(const alias_mapping_info_t *alias_mapping_info, can_acceptance_filter_t *filters, uint16_t max_filters) {
+
+    if (max_filters == 0) {
+
+        return 0;
+
+    }
+
+    uint16_t count = 0;
+    can_acceptance_filter_t candidate;
+
+    candidate.id = ACCEPTANCE_FILTER_CONTROL_ID;
+    candidate.mask = ACCEPTANCE_FILTER_CONTROL_MASK;
+    count = _add_filter(filters, count, max_filters, candidate);
+
+    candidate.id = ACCEPTANCE_FILTER_STANDARD_ID;
+    candidate.mask = ACCEPTANCE_FILTER_STANDARD_MASK;
+    count = _add_filter(filters, count, max_filters, candidate);
+
+    for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
+
+        uint16_t alias = alias_mapping_info->list[i].alias;
+
+        if (alias == 0) {
+
+            continue;
+
+        }
+
+        candidate.id = CAN_OPENLCB_MSG | ((uint32_t) alias << 12);
+        candidate.mask = ACCEPTANCE_FILTER_ALIAS_MASK;
+        count = _add_filter(filters, count, max_filters, candidate);
+
+    }
+
+    return count;
+
+}
+
+    /** @brief Returns true if (identifier & mask) == id for any filter. */
+bool CanAcceptanceFilter_is_accepted(const can_acceptance_filter_t *filters, uint16_t count, uint32_t identifier) {
+
+    for (uint16_t i = 0; i < count; i++) {
+
+        if ((identifier & filters[i].mask) == (filters[i].id & filters[i].mask)) {
+
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+    /**
+     * @brief Rebuilds and reports the filter set if the alias table changed.
+     *
+     * @details Algorithm:
+     * -# Return false if a set was already built for the current change count.
+     * -# Under lock, rebuild the static set from the alias table.
+     * -# Hand the set to on_acceptance_filters_changed and return true.
+     *
+     * @return true if a new filter set was reported.
+     */
+bool CanAcceptanceFilter_run(void) {
+
+    uint16_t change_count = _interface->alias_mapping_get_change_count();
+
+    if (_is_built && (change_count == _built_change_count)) {
+
+        return false;
+
+    }
+
+    _interface->lock_shared_resources();
+    _filter_count = CanAcceptanceFilter_generate(_interface->alias_mapping_get_alias_mapping_info(), _filters, USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT);
+    _interface->unlock_shared_resources();
+
+    _built_change_count = change_count;
+    _is_built = true;
+
+    _interface->on_acceptance_filters_changed(_filters, _filter_count);
+
+    return true;
+
+}
+
+    /** @brief Returns the number of filters in the last reported set. */
+uint16_t CanAcceptanceFilter_get_count(void) {
+
+    return _filter_count;
+
+}
+
+    /** @brief Returns a pointer to filter index, or NULL if out of range. */
+can_acceptance_filter_t *CanAcceptanceFilter_get_filter(uint16_t index) {
+
+    if (index >= _filter_count) {
+
+        return NULL;
+
+    }
+
+    return &_filters[index];
+
+}
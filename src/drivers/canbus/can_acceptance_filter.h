@@ -0,0 +1,165 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file can_acceptance_filter.h
+ * @brief Builds hardware CAN acceptance filters from the local alias table.
+ *
+ * @details On a busy bus most datagram and stream frames are addressed to other
+ * nodes, yet each one interrupts the CPU before the stack can discard it.  This
+ * module computes at most USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT ID/mask
+ * filters that pass:
+ * - every CAN control frame (CID, RID, AMD, AME, AMR, error reports),
+ * - every OpenLCB standard frame (global, or addressed with the destination in
+ *   the payload where hardware cannot see it),
+ * - datagram and stream frames whose destination alias is in the
+ *   internal alias table.
+ *
+ * When the hardware has fewer filters than needed, filter pairs are merged
+ * (matching bits kept, differing bits made "don't care") so nothing the stack
+ * needs is ever rejected; only precision is lost.  CanAcceptanceFilter_run()
+ * rebuilds the set whenever the alias table's change count moves and hands it
+ * to the application, which programs the controller.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __DRIVERS_CANBUS_CAN_ACCEPTANCE_FILTER__
+#define __DRIVERS_CANBUS_CAN_ACCEPTANCE_FILTER__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_types.h"
+
+    /**
+     * @brief Dependency-injection interface for the acceptance filter generator.
+     *
+     * @details All function pointers are REQUIRED (must not be NULL).
+     *
+     * @see CanAcceptanceFilter_initialize
+     */
+typedef struct {
+
+        /** @brief REQUIRED. Access the local alias table. Typical impl: InternalNodeAliasTable_get_alias_mapping_info. */
+    alias_mapping_info_t *(*alias_mapping_get_alias_mapping_info)(void);
+
+        /** @brief REQUIRED. Counter that moves when an alias changes. Typical impl: InternalNodeAliasTable_get_change_count. */
+    uint16_t (*alias_mapping_get_change_count)(void);
+
+        /** @brief REQUIRED. Disable interrupts / acquire mutex. */
+    void (*lock_shared_resources)(void);
+
+        /** @brief REQUIRED. Re-enable interrupts / release mutex. */
+    void (*unlock_shared_resources)(void);
+
+        /** @brief REQUIRED. Program the controller with the new filter set. Typical impl: can_config_t.on_acceptance_filters_changed. */
+    void (*on_acceptance_filters_changed)(const can_acceptance_filter_t *filters, uint16_t count);
+
+} interface_can_acceptance_filter_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+        /**
+         * @brief Registers the interface and marks the filter set stale.
+         *
+         * @details The first CanAcceptanceFilter_run() after this always builds
+         * and reports a filter set.
+         *
+         * @param interface  Pointer to a populated @ref interface_can_acceptance_filter_t.
+         *                   Must remain valid for the lifetime of the application.
+         *
+         * @warning NOT thread-safe - call during single-threaded initialization only.
+         */
+    extern void CanAcceptanceFilter_initialize(const interface_can_acceptance_filter_t *interface);
+
+        /**
+         * @brief Rebuilds and reports the filter set if the alias table changed.
+         *
+         * @details Cheap when nothing changed (one counter compare).  Called
+         * every CanMainStatemachine_run().
+         *
+         * @return true if a new filter set was handed to on_acceptance_filters_changed.
+         *
+         * @warning Locks shared resources while reading the alias table.
+         * @warning NOT thread-safe.
+         */
+    extern bool CanAcceptanceFilter_run(void);
+
+        /**
+         * @brief Computes acceptance filters for an alias table.
+         *
+         * @details Pure function; does not touch module state.  Aliases held by
+         * more than one entry produce a single filter.  If more filters are
+         * needed than max_filters, the pair whose merge keeps the most mask bits
+         * is merged until they fit, so the result never rejects a frame the
+         * exact set would pass.  O(aliases * max_filters^2) in the worst case.
+         *
+         * @param alias_mapping_info  Alias table to build from.
+         * @param filters             Output array of at least max_filters entries.
+         * @param max_filters         Number of hardware filters available.
+         *
+         * @return Number of filters written (0 only if max_filters is 0).
+         */
+    extern uint16_t CanAcceptanceFilter_generate(const alias_mapping_info_t *alias_mapping_info, can_acceptance_filter_t *filters, uint16_t max_filters);
+
+        /**
+         * @brief Software model of the hardware match, for tests and drivers without filters.
+         *
+         * @param filters     Filter array.
+         * @param count       Number of filters in the array.
+         * @param identifier  29-bit extended CAN identifier.
+         *
+         * @return true if any filter passes the identifier.
+         */
+    extern bool CanAcceptanceFilter_is_accepted(const can_acceptance_filter_t *filters, uint16_t count, uint32_t identifier);
+
+        /**
+         * @brief Returns the number of filters in the last reported set.
+         *
+         * @return Filter count, 0 before the first CanAcceptanceFilter_run().
+         */
+    extern uint16_t CanAcceptanceFilter_get_count(void);
+
+        /**
+         * @brief Returns a pointer to one filter of the last reported set (for testing/debugging).
+         *
+         * @param index  Filter index (0 to CanAcceptanceFilter_get_count() - 1).
+         *
+         * @return Pointer to the @ref can_acceptance_filter_t, or NULL if out of range.
+         */
+    extern can_acceptance_filter_t *CanAcceptanceFilter_get_filter(uint16_t index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __DRIVERS_CANBUS_CAN_ACCEPTANCE_FILTER__ */
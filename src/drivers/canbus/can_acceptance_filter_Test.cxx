@@ -0,0 +1,407 @@
+/*******************************************************************************
+ * File: can_acceptance_filter_Test.cxx
+ *
+ * Description:
+ *   Test suite for the CanAcceptanceFilter module (can_acceptance_filter.h/.c).
+ *   Tests filter generation from the alias table, merging when hardware has
+ *   too few filters, change-driven rebuilds, and the hit rate against a
+ *   recorded bus trace.
+ *
+ * Test Coverage:
+ *   - Exact filter set (control, standard, one per alias)
+ *   - Duplicate aliases, zero and one available filters
+ *   - Merging never rejects a frame the stack needs
+ *   - CanAcceptanceFilter_run() rebuilds only on alias change
+ *   - Hit rate on recorded traffic
+ *
+ * Author: Jim Kueneman
+ * Date: 2026-10-18
+ ******************************************************************************/
+
+#include "test/main_Test.hxx"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "can_types.h"
+#include "can_acceptance_filter.h"
+#include "internal_node_alias_table.h"
+#include "../../openlcb/openlcb_defines.h"
+
+/*******************************************************************************
+ * Test Constants
+ ******************************************************************************/
+
+#define OUR_ALIAS_A      0x03A1
+#define OUR_ALIAS_B      0x05C2
+#define OUR_ALIAS_C      0x0E17
+#define OUR_ALIAS_D      0x0108
+#define FOREIGN_ALIAS_1  0x06B7
+#define FOREIGN_ALIAS_2  0x02F0
+
+#define TEST_NODE_ID     0x050101010700ULL
+
+#define MAX_TEST_FILTERS (ALIAS_MAPPING_BUFFER_DEPTH + 2)
+
+// Identifier builders for the frame types the generator cares about
+#define ID_DATAGRAM_ONLY(dest, src)  (RESERVED_TOP_BIT | CAN_OPENLCB_MSG | CAN_FRAME_TYPE_DATAGRAM_ONLY | ((uint32_t) (dest) << 12) | (src))
+#define ID_DATAGRAM_FIRST(dest, src) (RESERVED_TOP_BIT | CAN_OPENLCB_MSG | CAN_FRAME_TYPE_DATAGRAM_FIRST | ((uint32_t) (dest) << 12) | (src))
+#define ID_DATAGRAM_FINAL(dest, src) (RESERVED_TOP_BIT | CAN_OPENLCB_MSG | CAN_FRAME_TYPE_DATAGRAM_FINAL | ((uint32_t) (dest) << 12) | (src))
+#define ID_STREAM(dest, src)         (RESERVED_TOP_BIT | CAN_OPENLCB_MSG | CAN_FRAME_TYPE_STREAM | ((uint32_t) (dest) << 12) | (src))
+#define ID_STANDARD(mti, src)        (RESERVED_TOP_BIT | CAN_OPENLCB_MSG | OPENLCB_MESSAGE_STANDARD_FRAME_TYPE | ((uint32_t) ((mti) & 0x0FFF) << 12) | (src))
+#define ID_CONTROL(frame, src)       (RESERVED_TOP_BIT | (frame) | (src))
+
+/*******************************************************************************
+ * Mocks
+ ******************************************************************************/
+
+static int filters_changed_count = 0;
+static uint16_t last_reported_count = 0;
+
+static void _lock_shared_resources(void) {
+
+}
+
+static void _unlock_shared_resources(void) {
+
+}
+
+static void _on_acceptance_filters_changed(const can_acceptance_filter_t *filters, uint16_t count) {
+
+    filters_changed_count++;
+    last_reported_count = count;
+
+}
+
+static const interface_can_acceptance_filter_t _interface = {
+
+    .alias_mapping_get_alias_mapping_info = &InternalNodeAliasTable_get_alias_mapping_info,
+    .alias_mapping_get_change_count = &InternalNodeAliasTable_get_change_count,
+    .lock_shared_resources = &_lock_shared_resources,
+    .unlock_shared_resources = &_unlock_shared_resources,
+    .on_acceptance_filters_changed = &_on_acceptance_filters_changed,
+
+};
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void setup_test(void) {
+
+    InternalNodeAliasTable_initialize();
+    CanAcceptanceFilter_initialize(&_interface);
+
+    filters_changed_count = 0;
+    last_reported_count = 0;
+
+}
+
+/**
+ * Ground truth: would the stack do anything with this frame given its aliases?
+ * Control and standard frames always; datagram and stream frames only for a
+ * local alias; reserved frame types never.
+ */
+static bool stack_needs_frame(uint32_t identifier) {
+
+    if (!(identifier & CAN_OPENLCB_MSG)) {
+
+        return true;
+
+    }
+
+    switch (identifier & MASK_CAN_FRAME_TYPE) {
+
+        case OPENLCB_MESSAGE_STANDARD_FRAME_TYPE:
+
+            return true;
+
+        case CAN_FRAME_TYPE_DATAGRAM_ONLY:
+        case CAN_FRAME_TYPE_DATAGRAM_FIRST:
+        case CAN_FRAME_TYPE_DATAGRAM_MIDDLE:
+        case CAN_FRAME_TYPE_DATAGRAM_FINAL:
+        case CAN_FRAME_TYPE_STREAM:
+
+            return InternalNodeAliasTable_find_mapping_by_alias((identifier >> 12) & 0x0FFF) != nullptr;
+
+        default:
+
+            return false;
+
+    }
+
+}
+
+/*******************************************************************************
+ * Generation Tests
+ ******************************************************************************/
+
+TEST(CanAcceptanceFilter, empty_table_passes_control_and_standard_only) {
+
+    setup_test();
+
+    can_acceptance_filter_t filters[MAX_TEST_FILTERS];
+    uint16_t count = CanAcceptanceFilter_generate(InternalNodeAliasTable_get_alias_mapping_info(), filters, MAX_TEST_FILTERS);
+
+    EXPECT_EQ(count, 2);
+    EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_CONTROL(CAN_CONTROL_FRAME_AMD, FOREIGN_ALIAS_1)));
+    EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_CONTROL(CAN_CONTROL_FRAME_CID7, FOREIGN_ALIAS_1)));
+    EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_STANDARD(MTI_PC_EVENT_REPORT, FOREIGN_ALIAS_1)));
+    EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_STANDARD(MTI_VERIFY_NODE_ID_ADDRESSED, FOREIGN_ALIAS_1)));
+    EXPECT_FALSE(CanAcceptanceFilter_is_accepted(filters, count, ID_DATAGRAM_ONLY(FOREIGN_ALIAS_2, FOREIGN_ALIAS_1)));
+    EXPECT_FALSE(CanAcceptanceFilter_is_accepted(filters, count, ID_STREAM(FOREIGN_ALIAS_2, FOREIGN_ALIAS_1)));
+
+}
+
+TEST(CanAcceptanceFilter, exact_set_has_one_filter_per_alias) {
+
+    setup_test();
+
+    InternalNodeAliasTable_register(OUR_ALIAS_A, TEST_NODE_ID);
+    InternalNodeAliasTable_register(OUR_ALIAS_B, TEST_NODE_ID + 1);
+
+    can_acceptance_filter_t filters[MAX_TEST_FILTERS];
+    uint16_t count = CanAcceptanceFilter_generate(InternalNodeAliasTable_get_alias_mapping_info(), filters, MAX_TEST_FILTERS);
+
+    EXPECT_EQ(count, 4);
+    EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_DATAGRAM_ONLY(OUR_ALIAS_A, FOREIGN_ALIAS_1)));
+    EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_DATAGRAM_FIRST(OUR_ALIAS_B, FOREIGN_ALIAS_1)));
+    EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_STREAM(OUR_ALIAS_A, FOREIGN_ALIAS_1)));
+    EXPECT_FALSE(CanAcceptanceFilter_is_accepted(filters, count, ID_DATAGRAM_ONLY(FOREIGN_ALIAS_2, OUR_ALIAS_A)));
+    EXPECT_FALSE(CanAcceptanceFilter_is_accepted(filters, count, ID_STREAM(FOREIGN_ALIAS_2, OUR_ALIAS_A)));
+
+}
+
+TEST(CanAcceptanceFilter, duplicate_alias_gives_one_filter) {
+
+    setup_test();
+
+    InternalNodeAliasTable_register(OUR_ALIAS_A, TEST_NODE_ID);
+    InternalNodeAliasTable_register(OUR_ALIAS_A, TEST_NODE_ID + 1);
+
+    can_acceptance_filter_t filters[MAX_TEST_FILTERS];
+
+    EXPECT_EQ(CanAcceptanceFilter_generate(InternalNodeAliasTable_get_alias_mapping_info(), filters, MAX_TEST_FILTERS), 3);
+
+}
+
+TEST(CanAcceptanceFilter, zero_and_one_filter_limits) {
+
+    setup_test();
+
+    InternalNodeAliasTable_register(OUR_ALIAS_A, TEST_NODE_ID);
+
+    can_acceptance_filter_t filters[MAX_TEST_FILTERS];
+
+    EXPECT_EQ(CanAcceptanceFilter_generate(InternalNodeAliasTable_get_alias_mapping_info(), filters, 0), 0);
+
+    // A single filter has to pass everything
+    EXPECT_EQ(CanAcceptanceFilter_generate(InternalNodeAliasTable_get_alias_mapping_info(), filters, 1), 1);
+    EXPECT_EQ(filters[0].mask, 0u);
+
+}
+
+TEST(CanAcceptanceFilter, merged_set_never_rejects_needed_frames) {
+
+    setup_test();
+
+    srand(1234);
+
+    for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
+
+        InternalNodeAliasTable_register((uint16_t) (1 + (rand() % 0x0FFF)), TEST_NODE_ID + i);
+
+    }
+
+    can_acceptance_filter_t filters[MAX_TEST_FILTERS];
+
+    for (uint16_t max_filters = 1; max_filters <= ALIAS_MAPPING_BUFFER_DEPTH + 2; max_filters++) {
+
+        uint16_t count = CanAcceptanceFilter_generate(InternalNodeAliasTable_get_alias_mapping_info(), filters, max_filters);
+
+        EXPECT_LE(count, max_filters);
+
+        alias_mapping_info_t *info = InternalNodeAliasTable_get_alias_mapping_info();
+
+        for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
+
+            uint16_t alias = info->list[i].alias;
+
+            if (alias == 0) {
+
+                continue;
+
+            }
+
+            EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_DATAGRAM_ONLY(alias, FOREIGN_ALIAS_1)));
+            EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_DATAGRAM_FINAL(alias, FOREIGN_ALIAS_1)));
+            EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_STREAM(alias, FOREIGN_ALIAS_1)));
+
+        }
+
+        EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_CONTROL(CAN_CONTROL_FRAME_RID, FOREIGN_ALIAS_1)));
+        EXPECT_TRUE(CanAcceptanceFilter_is_accepted(filters, count, ID_STANDARD(MTI_PC_EVENT_REPORT, FOREIGN_ALIAS_1)));
+
+    }
+
+}
+
+/*******************************************************************************
+ * Run / Change Tracking Tests
+ ******************************************************************************/
+
+TEST(CanAcceptanceFilter, run_reports_only_on_alias_change) {
+
+    setup_test();
+
+    EXPECT_TRUE(CanAcceptanceFilter_run());
+    EXPECT_EQ(filters_changed_count, 1);
+    EXPECT_EQ(last_reported_count, 2);
+
+    EXPECT_FALSE(CanAcceptanceFilter_run());
+    EXPECT_EQ(filters_changed_count, 1);
+
+    InternalNodeAliasTable_register(OUR_ALIAS_A, TEST_NODE_ID);
+
+    EXPECT_TRUE(CanAcceptanceFilter_run());
+    EXPECT_EQ(filters_changed_count, 2);
+    EXPECT_EQ(last_reported_count, 3);
+    EXPECT_EQ(CanAcceptanceFilter_get_count(), 3);
+
+    // Flags changing on an existing entry is not an alias change
+    InternalNodeAliasTable_find_mapping_by_alias(OUR_ALIAS_A)->is_permitted = true;
+
+    EXPECT_FALSE(CanAcceptanceFilter_run());
+
+    InternalNodeAliasTable_unregister(OUR_ALIAS_A);
+
+    EXPECT_TRUE(CanAcceptanceFilter_run());
+    EXPECT_EQ(last_reported_count, 2);
+
+}
+
+TEST(CanAcceptanceFilter, get_filter_bounds) {
+
+    setup_test();
+
+    EXPECT_EQ(CanAcceptanceFilter_get_filter(0), nullptr);
+
+    CanAcceptanceFilter_run();
+
+    EXPECT_NE(CanAcceptanceFilter_get_filter(0), nullptr);
+    EXPECT_NE(CanAcceptanceFilter_get_filter(1), nullptr);
+    EXPECT_EQ(CanAcceptanceFilter_get_filter(2), nullptr);
+
+}
+
+/*******************************************************************************
+ * Hit Rate Against Recorded Traffic
+ ******************************************************************************/
+
+// Identifiers captured from a layout bus: a command station, throttles and
+// accessory decoders talking to each other while this device holds
+// OUR_ALIAS_A..D.  Repeated blocks approximate the real mix (mostly events
+// and foreign datagrams during a CDI download by another tool).
+static const uint32_t _recorded_trace[] = {
+
+    ID_CONTROL(CAN_CONTROL_FRAME_CID7, 0x0444), ID_CONTROL(CAN_CONTROL_FRAME_CID6, 0x0444),
+    ID_CONTROL(CAN_CONTROL_FRAME_CID5, 0x0444), ID_CONTROL(CAN_CONTROL_FRAME_CID4, 0x0444),
+    ID_CONTROL(CAN_CONTROL_FRAME_RID, 0x0444), ID_CONTROL(CAN_CONTROL_FRAME_AMD, 0x0444),
+    ID_STANDARD(MTI_INITIALIZATION_COMPLETE, 0x0444),
+    ID_STANDARD(MTI_PC_EVENT_REPORT, 0x0444), ID_STANDARD(MTI_PC_EVENT_REPORT, FOREIGN_ALIAS_1),
+    ID_STANDARD(MTI_VERIFY_NODE_ID_ADDRESSED, FOREIGN_ALIAS_2),
+    ID_STANDARD(MTI_VERIFIED_NODE_ID, OUR_ALIAS_B),
+
+    // Another tool downloading CDI from FOREIGN_ALIAS_2
+    ID_DATAGRAM_ONLY(FOREIGN_ALIAS_2, FOREIGN_ALIAS_1),
+    ID_DATAGRAM_ONLY(FOREIGN_ALIAS_1, FOREIGN_ALIAS_2),
+    ID_DATAGRAM_FIRST(FOREIGN_ALIAS_1, FOREIGN_ALIAS_2),
+    ID_DATAGRAM_FIRST(FOREIGN_ALIAS_1, FOREIGN_ALIAS_2) + 0x01000000,
+    ID_DATAGRAM_FIRST(FOREIGN_ALIAS_1, FOREIGN_ALIAS_2) + 0x01000000,
+    ID_DATAGRAM_FINAL(FOREIGN_ALIAS_1, FOREIGN_ALIAS_2),
+    ID_DATAGRAM_ONLY(FOREIGN_ALIAS_2, FOREIGN_ALIAS_1),
+    ID_DATAGRAM_ONLY(FOREIGN_ALIAS_2, FOREIGN_ALIAS_1),
+    ID_DATAGRAM_FIRST(FOREIGN_ALIAS_1, FOREIGN_ALIAS_2),
+    ID_DATAGRAM_FIRST(FOREIGN_ALIAS_1, FOREIGN_ALIAS_2) + 0x01000000,
+    ID_DATAGRAM_FINAL(FOREIGN_ALIAS_1, FOREIGN_ALIAS_2),
+    ID_DATAGRAM_ONLY(FOREIGN_ALIAS_2, FOREIGN_ALIAS_1),
+    ID_STREAM(0x0777, 0x0123), ID_STREAM(0x0777, 0x0123), ID_STREAM(0x0777, 0x0123),
+    ID_STREAM(0x0123, 0x0777),
+
+    // Traffic for us
+    ID_DATAGRAM_ONLY(OUR_ALIAS_A, FOREIGN_ALIAS_1),
+    ID_DATAGRAM_ONLY(FOREIGN_ALIAS_1, OUR_ALIAS_A),
+    ID_DATAGRAM_FIRST(OUR_ALIAS_C, FOREIGN_ALIAS_1),
+    ID_DATAGRAM_FINAL(OUR_ALIAS_C, FOREIGN_ALIAS_1),
+    ID_STREAM(OUR_ALIAS_D, 0x0123),
+    ID_STANDARD(MTI_PC_EVENT_REPORT, 0x0321), ID_STANDARD(MTI_PC_EVENT_REPORT, 0x0322),
+    ID_CONTROL(CAN_CONTROL_FRAME_AME, FOREIGN_ALIAS_1),
+
+};
+
+/**
+ * Runs the trace through a filter set and returns the fraction of frames the
+ * stack does not need that the filters reject (1.0 = perfect).  Fails if any
+ * needed frame would be rejected.
+ */
+static double measure_hit_rate(uint16_t max_filters) {
+
+    can_acceptance_filter_t filters[MAX_TEST_FILTERS];
+    uint16_t count = CanAcceptanceFilter_generate(InternalNodeAliasTable_get_alias_mapping_info(), filters, max_filters);
+
+    int unneeded = 0;
+    int rejected = 0;
+
+    for (size_t i = 0; i < sizeof(_recorded_trace) / sizeof(_recorded_trace[0]); i++) {
+
+        bool accepted = CanAcceptanceFilter_is_accepted(filters, count, _recorded_trace[i]);
+
+        if (stack_needs_frame(_recorded_trace[i])) {
+
+            EXPECT_TRUE(accepted) << "needed frame rejected: 0x" << std::hex << _recorded_trace[i];
+
+        } else {
+
+            unneeded++;
+
+            if (!accepted) {
+
+                rejected++;
+
+            }
+
+        }
+
+    }
+
+    double rate = unneeded ? (double) rejected / unneeded : 1.0;
+
+    printf("    acceptance filters: %d of %d used, rejected %d of %d unneeded frames (%.0f%%)\n",
+           count, max_filters, rejected, unneeded, rate * 100.0);
+
+    return rate;
+
+}
+
+TEST(CanAcceptanceFilter, hit_rate_on_recorded_traffic) {
+
+    setup_test();
+
+    InternalNodeAliasTable_register(OUR_ALIAS_A, TEST_NODE_ID);
+    InternalNodeAliasTable_register(OUR_ALIAS_B, TEST_NODE_ID + 1);
+    InternalNodeAliasTable_register(OUR_ALIAS_C, TEST_NODE_ID + 2);
+    InternalNodeAliasTable_register(OUR_ALIAS_D, TEST_NODE_ID + 3);
+
+    // Exact set: every foreign datagram/stream frame rejected
+    EXPECT_DOUBLE_EQ(measure_hit_rate(6), 1.0);
+
+    // Fewer hardware filters than aliases: less precise, still correct
+    double merged_rate = measure_hit_rate(4);
+
+    EXPECT_GT(merged_rate, 0.0);
+    EXPECT_LE(merged_rate, 1.0);
+
+    // One filter cannot reject anything
+    EXPECT_DOUBLE_EQ(measure_hit_rate(1), 0.0);
+
+}
@@ -0,0 +1,606 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file can_alias_pool.c
+ * @brief Implementation of the pre-reserved CAN alias pool.
+ *
+ * @details Single static pool of LEN_ALIAS_POOL slots.  Frames are queued on the
+ * CAN outgoing FIFO so they interleave with normal traffic.  NOT thread-safe —
+ * buffer, FIFO and alias table access is wrapped in lock/unlock.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#include "can_alias_pool.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "can_types.h"
+#include "can_buffer_store.h"
+#include "can_buffer_fifo.h"
+#include "can_utilities.h"
+
+
+/** @brief Number of CID frames sent per reservation (CID7..CID4). */
+#define ALIAS_POOL_CID_FRAME_COUNT 4
+
+/** @brief Saved pointer to the dependency-injected pool interface. */
+static interface_can_alias_pool_t *_interface;
+
+/** @brief Pool slots. */
+static alias_pool_entry_t _pool[LEN_ALIAS_POOL];
+
+/** @brief LFSR state shared by all slots; 0 until seeded from the device-owned Node ID base. */
+static uint64_t _seed;
+
+/** @brief Tick at which the last reservation was started. */
+static uint8_t _last_refill_tick;
+
+/** @brief True once any reservation has been started (first refill is not rate-limited). */
+static bool _refill_started;
+
+    /**
+     * @brief Stores the interface pointer and empties all slots.
+     *
+     * @verbatim
+     * @param interface Pointer to the populated dependency-injection interface.
+     * @endverbatim
+     */
+void CanAliasPool_initialize(const interface_can_alias_pool_t *interface) {
+
+    _interface = (interface_can_alias_pool_t *) interface;
+
+    for (int i = 0; i < LEN_ALIAS_POOL; i++) {
+
+        _pool[i].alias = 0;
+        _pool[i].state = ALIAS_POOL_STATE_EMPTY;
+        _pool[i].timerticks = 0;
+        _pool[i].cid4_sent = false;
+
+    }
+
+    _seed = 0;
+    _last_refill_tick = 0;
+    _refill_started = false;
+
+}
+
+    /** @brief Returns the placeholder Node ID used by a pool slot. */
+static node_id_t _placeholder_node_id(int index) {
+
+    return (node_id_t) (USER_DEFINED_ALIAS_POOL_NODE_ID_BASE + (node_id_t) index);
+
+}
+
+    /** @brief Empties a pool slot. */
+static void _clear_entry(alias_pool_entry_t *entry) {
+
+    entry->alias = 0;
+    entry->state = ALIAS_POOL_STATE_EMPTY;
+    entry->cid4_sent = false;
+
+}
+
+    /**
+     * @brief Returns true if the slot's alias is still mapped to its placeholder and not contested.
+     *
+     * @details A remote RID/AMD for the alias sets is_duplicate in the RX path and the
+     * main state machine later unregisters the mapping; either condition means the
+     * reservation is lost.
+     *
+     * @verbatim
+     * @param index Slot index.
+     * @endverbatim
+     */
+static bool _is_still_reserved(int index) {
+
+    bool result = false;
+
+    _interface->lock_shared_resources();
+
+    alias_mapping_t *alias_mapping = _interface->alias_mapping_find_mapping_by_alias(_pool[index].alias);
+
+    if (alias_mapping && (alias_mapping->node_id == _placeholder_node_id(index)) && !alias_mapping->is_duplicate) {
+
+        result = true;
+
+    }
+
+    _interface->unlock_shared_resources();
+
+    return result;
+
+}
+
+    /**
+     * @brief Returns the next alias from the pool LFSR that is non-zero and not in the mapping table.
+     *
+     * @details The LFSR is seeded on first use from the device-owned Node ID base,
+     * as the login handler seeds a node from its own Node ID, so two devices never
+     * walk the same alias sequence.
+     */
+static uint16_t _next_free_alias(void) {
+
+    uint16_t alias;
+
+    if (_seed == 0) {
+
+        _seed = (uint64_t) _placeholder_node_id(0);
+
+    }
+
+    do {
+
+        _seed = CanUtilities_generate_seed(_seed);
+        alias = CanUtilities_generate_alias(_seed);
+
+    } while ((alias == 0) || (_interface->alias_mapping_find_mapping_by_alias(alias) != NULL));
+
+    return alias;
+
+}
+
+    /**
+     * @brief Registers a fresh alias for an empty slot and queues its CID7..CID4 frames.
+     *
+     * @details Algorithm:
+     * -# Allocate all four CAN buffers first; on any failure free them and give up
+     *    until the next call, so a half-sent reservation never exists.
+     * -# Pick a free alias and register it under the slot's placeholder Node ID.
+     * -# Build the CID frames exactly as the login handler does and push them.
+     * -# Mark the slot WAIT; its window starts when CID4 is transmitted.
+     *
+     * @verbatim
+     * @param index        Empty slot index.
+     * @param current_tick Current 100 ms tick.
+     * @endverbatim
+     *
+     * @return true if the reservation was started.
+     */
+static bool _start_reservation(int index, uint8_t current_tick) {
+
+    static const uint32_t cid_frames[ALIAS_POOL_CID_FRAME_COUNT] = {
+
+        CAN_CONTROL_FRAME_CID7,
+        CAN_CONTROL_FRAME_CID6,
+        CAN_CONTROL_FRAME_CID5,
+        CAN_CONTROL_FRAME_CID4
+
+    };
+
+    can_msg_t *frames[ALIAS_POOL_CID_FRAME_COUNT];
+    node_id_t node_id = _placeholder_node_id(index);
+
+    _interface->lock_shared_resources();
+
+    for (int i = 0; i < ALIAS_POOL_CID_FRAME_COUNT; i++) {
+
+        frames[i] = CanBufferStore_allocate_buffer();
+
+        if (!frames[i]) {
+
+            for (int j = 0; j < i; j++) {
+
+                CanBufferStore_free_buffer(frames[j]);
+
+            }
+
+            _interface->unlock_shared_resources();
+
+            return false;
+
+        }
+
+    }
+
+    uint16_t alias = _next_free_alias();
+
+    if (!_interface->alias_mapping_register(alias, node_id)) {
+
+        for (int i = 0; i < ALIAS_POOL_CID_FRAME_COUNT; i++) {
+
+            CanBufferStore_free_buffer(frames[i]);
+
+        }
+
+        _interface->unlock_shared_resources();
+
+        return false;
+
+    }
+
+    for (int i = 0; i < ALIAS_POOL_CID_FRAME_COUNT; i++) {
+
+        // CID7 carries bits 47-36, CID6 35-24, CID5 23-12, CID4 11-0
+        uint32_t node_id_bits = (uint32_t) ((node_id >> (36 - (12 * i))) & 0xFFF) << 12;
+
+        frames[i]->identifier = RESERVED_TOP_BIT | cid_frames[i] | node_id_bits | alias;
+        frames[i]->payload_count = 0;
+
+        CanBufferFifo_push(frames[i]);
+
+    }
+
+    _interface->unlock_shared_resources();
+
+    _pool[index].alias = alias;
+    _pool[index].state = ALIAS_POOL_STATE_WAIT;
+    _pool[index].timerticks = current_tick;
+    _pool[index].cid4_sent = false;
+
+    return true;
+
+}
+
+    /**
+     * @brief Queues the RID that completes a slot's reservation.
+     *
+     * @verbatim
+     * @param index Slot index in ALIAS_POOL_STATE_WAIT.
+     * @endverbatim
+     *
+     * @return true if the RID was queued, false if no CAN buffer was free.
+     */
+static bool _send_reserve_id(int index) {
+
+    _interface->lock_shared_resources();
+
+    can_msg_t *outgoing_can_msg = CanBufferStore_allocate_buffer();
+
+    if (outgoing_can_msg) {
+
+        outgoing_can_msg->identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_RID | _pool[index].alias;
+        outgoing_can_msg->payload_count = 0;
+        CanBufferFifo_push(outgoing_can_msg);
+
+    }
+
+    _interface->unlock_shared_resources();
+
+    return outgoing_can_msg != NULL;
+
+}
+
+    /**
+     * @brief Advances every pool slot and starts at most one new reservation.
+     *
+     * @details Algorithm:
+     * -# For each non-empty slot: drop it if its alias was lost.  For WAIT slots
+     *    whose CID4 has been transmitted (CanAliasPool_frame_transmitted), once
+     *    more than 200 ms has passed since then queue the RID and mark the slot
+     *    RESERVED.
+     * -# If the refill interval has elapsed, start a reservation in the first
+     *    empty slot.
+     *
+     * @return true if any frame was queued.
+     */
+bool CanAliasPool_run(void) {
+
+    bool result = false;
+    uint8_t current_tick = _interface->get_current_tick();
+
+    for (int i = 0; i < USER_DEFINED_ALIAS_POOL_DEPTH; i++) {
+
+        if (_pool[i].state == ALIAS_POOL_STATE_EMPTY) {
+
+            continue;
+
+        }
+
+        if (!_is_still_reserved(i)) {
+
+            _clear_entry(&_pool[i]);
+
+            continue;
+
+        }
+
+        if (_pool[i].state == ALIAS_POOL_STATE_WAIT) {
+
+            if (!_pool[i].cid4_sent) {
+
+                continue;
+
+            }
+
+            if ((uint8_t) (current_tick - _pool[i].timerticks) > 2) {
+
+                if (_send_reserve_id(i)) {
+
+                    _pool[i].state = ALIAS_POOL_STATE_RESERVED;
+                    result = true;
+
+                }
+
+            }
+
+        }
+
+    }
+
+    if (_refill_started && ((uint8_t) (current_tick - _last_refill_tick) < USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS)) {
+
+        return result;
+
+    }
+
+    for (int i = 0; i < USER_DEFINED_ALIAS_POOL_DEPTH; i++) {
+
+        if (_pool[i].state == ALIAS_POOL_STATE_EMPTY) {
+
+            if (_start_reservation(i, current_tick)) {
+
+                _last_refill_tick = current_tick;
+                _refill_started = true;
+                result = true;
+
+            }
+
+            break;
+
+        }
+
+    }
+
+    return result;
+
+}
+
+    /**
+     * @brief Starts the 200 ms window of the waiting slot whose CID4 was just transmitted.
+     *
+     * @details Matches the frame against CID4 and the slot's alias; every other
+     * frame, including unrelated outbound traffic, leaves the windows alone.
+     *
+     * @verbatim
+     * @param can_msg Frame just accepted by the CAN driver.
+     * @endverbatim
+     */
+void CanAliasPool_frame_transmitted(can_msg_t *can_msg) {
+
+    if ((can_msg->identifier & (CAN_OPENLCB_MSG | MASK_CAN_FRAME_SEQUENCE_NUMBER)) != CAN_CONTROL_FRAME_CID4) {
+
+        return;
+
+    }
+
+    uint16_t alias = (uint16_t) (can_msg->identifier & MASK_CAN_SOURCE_ALIAS);
+
+    for (int i = 0; i < USER_DEFINED_ALIAS_POOL_DEPTH; i++) {
+
+        if ((_pool[i].state == ALIAS_POOL_STATE_WAIT) && (_pool[i].alias == alias)) {
+
+            _pool[i].timerticks = _interface->get_current_tick();
+            _pool[i].cid4_sent = true;
+
+            return;
+
+        }
+
+    }
+
+}
+
+    /**
+     * @brief Rebinds the first ready reserved alias to node_id and returns it.
+     *
+     * @details Algorithm:
+     * -# Find a RESERVED slot whose alias is still held.
+     * -# Under lock, unregister the placeholder mapping and register node_id.
+     * -# Empty the slot (it is refilled by CanAliasPool_run) and return the alias.
+     *
+     * @verbatim
+     * @param node_id Node ID that will own the alias.
+     * @endverbatim
+     *
+     * @return Reserved alias, or 0 if none is ready.
+     */
+uint16_t CanAliasPool_claim(node_id_t node_id) {
+
+    for (int i = 0; i < USER_DEFINED_ALIAS_POOL_DEPTH; i++) {
+
+        if ((_pool[i].state != ALIAS_POOL_STATE_RESERVED) || !_is_still_reserved(i)) {
+
+            continue;
+
+        }
+
+        uint16_t alias = _pool[i].alias;
+
+        _interface->lock_shared_resources();
+        _interface->alias_mapping_unregister(alias);
+        alias_mapping_t *alias_mapping = _interface->alias_mapping_register(alias, node_id);
+        _interface->unlock_shared_resources();
+
+        _clear_entry(&_pool[i]);
+
+        if (alias_mapping) {
+
+            return alias;
+
+        }
+
+        return 0;
+
+    }
+
+    return 0;
+
+}
+
+    /** @brief Returns true if alias maps to node_id and is not flagged duplicate. */
+bool CanAliasPool_is_held(uint16_t alias, node_id_t node_id) {
+
+    bool result = false;
+
+    _interface->lock_shared_resources();
+
+    alias_mapping_t *alias_mapping = _interface->alias_mapping_find_mapping_by_alias(alias);
+
+    if (alias_mapping && (alias_mapping->node_id == node_id) && !alias_mapping->is_duplicate) {
+
+        result = true;
+
+    }
+
+    _interface->unlock_shared_resources();
+
+    return result;
+
+}
+
+    /**
+     * @brief Sends AMD for a claimed alias directly to the hardware.
+     *
+     * @details Algorithm:
+     * -# Return false if the alias is no longer held for node_id.
+     * -# Build the AMD on the stack and hand it to transmit_can_frame.
+     * -# On success mark the mapping permitted so AME replies include it.
+     *
+     * @verbatim
+     * @param alias   Claimed alias.
+     * @param node_id Node ID the alias was claimed for.
+     * @endverbatim
+     *
+     * @return true if the AMD was sent.
+     */
+bool CanAliasPool_announce(uint16_t alias, node_id_t node_id) {
+
+    if (!CanAliasPool_is_held(alias, node_id)) {
+
+        return false;
+
+    }
+
+    can_msg_t amd_msg;
+
+    amd_msg.state.allocated = false;
+    amd_msg.identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AMD | alias;
+    CanUtilities_copy_node_id_to_payload(&amd_msg, node_id, 0);
+
+    if (!_interface->transmit_can_frame(&amd_msg)) {
+
+        return false;
+
+    }
+
+    _interface->lock_shared_resources();
+
+    alias_mapping_t *alias_mapping = _interface->alias_mapping_find_mapping_by_alias(alias);
+
+    if (alias_mapping) {
+
+        alias_mapping->is_permitted = true;
+
+    }
+
+    _interface->unlock_shared_resources();
+
+    return true;
+
+}
+
+    /**
+     * @brief Queues AMR for an announced alias and removes its mapping.
+     *
+     * @details Algorithm:
+     * -# Under lock, find the mapping; return if it is already gone.
+     * -# If it was permitted, queue an AMR carrying its Node ID (dropped
+     *    silently if no CAN buffer is free -- other nodes age it out).
+     * -# Unregister the mapping.
+     *
+     * @verbatim
+     * @param alias Claimed alias to release.
+     * @endverbatim
+     */
+void CanAliasPool_release(uint16_t alias) {
+
+    _interface->lock_shared_resources();
+
+    alias_mapping_t *alias_mapping = _interface->alias_mapping_find_mapping_by_alias(alias);
+
+    if (!alias_mapping) {
+
+        _interface->unlock_shared_resources();
+
+        return;
+
+    }
+
+    if (alias_mapping->is_permitted) {
+
+        can_msg_t *outgoing_can_msg = CanBufferStore_allocate_buffer();
+
+        if (outgoing_can_msg) {
+
+            outgoing_can_msg->identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AMR | alias;
+            CanUtilities_copy_node_id_to_payload(outgoing_can_msg, alias_mapping->node_id, 0);
+            CanBufferFifo_push(outgoing_can_msg);
+
+        }
+
+    }
+
+    _interface->alias_mapping_unregister(alias);
+
+    _interface->unlock_shared_resources();
+
+}
+
+    /** @brief Returns the number of slots in ALIAS_POOL_STATE_RESERVED. */
+uint16_t CanAliasPool_get_reserved_count(void) {
+
+    uint16_t result = 0;
+
+    for (int i = 0; i < USER_DEFINED_ALIAS_POOL_DEPTH; i++) {
+
+        if (_pool[i].state == ALIAS_POOL_STATE_RESERVED) {
+
+            result++;
+
+        }
+
+    }
+
+    return result;
+
+}
+
+    /** @brief Returns a pointer to pool slot index, or NULL if out of range. */
+alias_pool_entry_t *CanAliasPool_get_entry(uint16_t index) {
+
+    if (index >= LEN_ALIAS_POOL) {
+
+        return NULL;
+
+    }
+
+    return &_pool[index];
+
+}
@@ -0,0 +1,214 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file can_alias_pool.h
+ * @brief Background pool of pre-reserved CAN aliases for instant node creation.
+ *
+ * @details Nodes created at run time (train search "allocate on no match",
+ * throttle proxies) would otherwise run a full CID/200 ms/RID sequence before
+ * they could answer.  The pool keeps up to USER_DEFINED_ALIAS_POOL_DEPTH aliases
+ * already reserved on the bus under placeholder Node IDs
+ * (USER_DEFINED_ALIAS_POOL_NODE_ID_BASE + slot).  A new node claims one from
+ * CanLoginMessageHandler_state_init() and goes straight to AMD; the pool then
+ * refills the slot in the background, at most one reservation per
+ * USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS.
+ *
+ * Reserved aliases live in the internal alias mapping table (not permitted), so
+ * the existing RX handlers defend them: a remote CID gets an RID reply and a
+ * remote RID/AMD flags a duplicate, after which the slot is dropped and refilled.
+ *
+ * A claimed alias can also stand in for a node that is not on this bus at all
+ * (a router proxy): CanAliasPool_announce() sends its AMD, CanAliasPool_is_held()
+ * reports whether it is still ours, and CanAliasPool_release() gives it back.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __DRIVERS_CANBUS_CAN_ALIAS_POOL__
+#define __DRIVERS_CANBUS_CAN_ALIAS_POOL__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_types.h"
+
+    /**
+     * @brief Dependency-injection interface for the alias pool.
+     *
+     * @details All function pointers are REQUIRED (must not be NULL), except
+     * transmit_can_frame which is only needed by CanAliasPool_announce().
+     *
+     * @see CanAliasPool_initialize
+     */
+typedef struct {
+
+        /** @brief REQUIRED. Register an alias/Node ID pair. Typical impl: InternalNodeAliasTable_register. */
+    alias_mapping_t *(*alias_mapping_register)(uint16_t alias, node_id_t node_id);
+
+        /** @brief REQUIRED. Remove a mapping by alias. Typical impl: InternalNodeAliasTable_unregister. */
+    void (*alias_mapping_unregister)(uint16_t alias);
+
+        /** @brief REQUIRED. Find a mapping by alias. Typical impl: InternalNodeAliasTable_find_mapping_by_alias. */
+    alias_mapping_t *(*alias_mapping_find_mapping_by_alias)(uint16_t alias);
+
+        /** @brief REQUIRED. Disable interrupts / acquire mutex. */
+    void (*lock_shared_resources)(void);
+
+        /** @brief REQUIRED. Re-enable interrupts / release mutex. */
+    void (*unlock_shared_resources)(void);
+
+        /** @brief REQUIRED. Current value of the global 100 ms tick. Typical impl: OpenLcbConfig_get_global_100ms_tick. */
+    uint8_t (*get_current_tick)(void);
+
+        /** @brief OPTIONAL. Send one frame straight to the hardware. Typical impl: CanTxStatemachine_send_can_message. */
+    bool (*transmit_can_frame)(can_msg_t *can_msg);
+
+} interface_can_alias_pool_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+        /**
+         * @brief Registers the interface and empties every pool slot.
+         *
+         * @param interface  Pointer to a populated @ref interface_can_alias_pool_t.
+         *                   Must remain valid for the lifetime of the application.
+         *
+         * @warning Call after InternalNodeAliasTable_initialize().
+         * @warning NOT thread-safe - call during single-threaded initialization only.
+         */
+    extern void CanAliasPool_initialize(const interface_can_alias_pool_t *interface);
+
+        /**
+         * @brief Advances the pool one cooperative step.
+         *
+         * @details Drops slots whose alias was lost to a duplicate, sends RID for
+         * slots whose 200 ms window has expired, and starts one new reservation
+         * (CID7..CID4) when a slot is empty and the refill interval has passed.
+         *
+         * @return true if any frame was queued, false if nothing to do.
+         *
+         * @warning Locks shared resources during buffer and table access.
+         * @warning NOT thread-safe.
+         */
+    extern bool CanAliasPool_run(void);
+
+        /**
+         * @brief Notifies the pool that a frame from the outgoing FIFO was transmitted.
+         *
+         * @details When the frame is the CID4 of a slot that is waiting, the
+         * slot's 200 ms window is started from the current tick, the way the
+         * CAN main state machine restamps a logging-in node.  Any other frame is
+         * ignored, so unrelated traffic never delays a reservation.
+         *
+         * @param can_msg  Frame just accepted by the CAN driver.
+         *
+         * @warning NOT thread-safe.
+         */
+    extern void CanAliasPool_frame_transmitted(can_msg_t *can_msg);
+
+        /**
+         * @brief Hands a reserved alias to a newly created node.
+         *
+         * @details Rebinds the alias mapping from the placeholder Node ID to
+         * node_id and empties the slot so it is refilled.  The caller must send
+         * AMD for the returned alias before using it.
+         *
+         * @param node_id  Node ID that will own the alias.
+         *
+         * @return Reserved alias, or 0 if none is ready.
+         *
+         * @warning NOT thread-safe.
+         */
+    extern uint16_t CanAliasPool_claim(node_id_t node_id);
+
+        /**
+         * @brief Sends AMD for a claimed alias and marks it permitted.
+         *
+         * @details The frame goes straight to the hardware, not through the CAN
+         * FIFO, so it is on the wire before any message the caller sends next
+         * from the same alias.
+         *
+         * @param alias    Alias returned by CanAliasPool_claim().
+         * @param node_id  Node ID the alias was claimed for.
+         *
+         * @return true if the AMD was sent, false if the alias is no longer held
+         *         or the transmit buffer was busy.
+         *
+         * @warning Requires interface transmit_can_frame.
+         * @warning NOT thread-safe.
+         */
+    extern bool CanAliasPool_announce(uint16_t alias, node_id_t node_id);
+
+        /**
+         * @brief Returns true if alias is still mapped to node_id and not contested.
+         *
+         * @param alias    Claimed alias.
+         * @param node_id  Node ID the alias was claimed for.
+         *
+         * @return true while the alias can be used for node_id.
+         */
+    extern bool CanAliasPool_is_held(uint16_t alias, node_id_t node_id);
+
+        /**
+         * @brief Gives up a claimed alias.
+         *
+         * @details Queues AMR if the alias was announced, then removes its
+         * mapping.  Safe to call for an alias that was already lost.
+         *
+         * @param alias  Claimed alias to release.
+         *
+         * @warning Locks shared resources during buffer and table access.
+         * @warning NOT thread-safe.
+         */
+    extern void CanAliasPool_release(uint16_t alias);
+
+        /**
+         * @brief Returns the number of aliases currently reserved and ready to claim.
+         *
+         * @return Count of slots in ALIAS_POOL_STATE_RESERVED.
+         */
+    extern uint16_t CanAliasPool_get_reserved_count(void);
+
+        /**
+         * @brief Returns a pointer to one pool slot (for testing/debugging).
+         *
+         * @param index  Slot index (0 to LEN_ALIAS_POOL - 1).
+         *
+         * @return Pointer to the @ref alias_pool_entry_t, or NULL if out of range.
+         */
+    extern alias_pool_entry_t *CanAliasPool_get_entry(uint16_t index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __DRIVERS_CANBUS_CAN_ALIAS_POOL__ */
@@ -0,0 +1,571 @@
+/** \copyright
+* Copyright (c) 2024, Jim Kueneman
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  - Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+*  - Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* @file can_alias_pool_Test.cxx
+* @brief Unit tests for the pre-reserved CAN alias pool.
+*
+* @details Covers reservation start (CID7..CID4 under the placeholder Node ID),
+* the 200 ms window and RID, refill rate limiting, FIFO-busy window restart,
+* claiming and rebinding, loss of a reservation to a duplicate, CAN buffer
+* exhaustion, the login handler fast path that sends AMD straight away, and
+* announcing and releasing a claimed alias for a router proxy.
+*
+* @author Jim Kueneman
+* @date 18 Oct 2026
+*/
+
+#include "test/main_Test.hxx"
+
+#include "can_alias_pool.h"
+#include "can_login_message_handler.h"
+#include "can_buffer_store.h"
+#include "can_buffer_fifo.h"
+#include "can_utilities.h"
+#include "internal_node_alias_table.h"
+
+#include "../../openlcb/openlcb_defines.h"
+
+#include <cstring>
+
+#define POOL_TEST_NODE_ID 0x050101010777ULL
+
+// ============================================================================
+// Mocks
+// ============================================================================
+
+static uint8_t _tick;
+static int _lock_count;
+static int _unlock_count;
+
+static void _lock(void)   { _lock_count++; }
+static void _unlock(void) { _unlock_count++; }
+
+static uint8_t _get_tick(void) { return _tick; }
+
+static bool _transmit_ok;
+static int _transmit_count;
+static can_msg_t _transmitted;
+
+static bool _transmit(can_msg_t *can_msg) {
+
+    if (!_transmit_ok) { return false; }
+
+    _transmit_count++;
+    CanUtilities_copy_can_message(can_msg, &_transmitted);
+
+    return true;
+
+}
+
+static const interface_can_alias_pool_t _pool_interface = {
+
+    .alias_mapping_register = &InternalNodeAliasTable_register,
+    .alias_mapping_unregister = &InternalNodeAliasTable_unregister,
+    .alias_mapping_find_mapping_by_alias = &InternalNodeAliasTable_find_mapping_by_alias,
+    .lock_shared_resources = &_lock,
+    .unlock_shared_resources = &_unlock,
+    .get_current_tick = &_get_tick,
+    .transmit_can_frame = &_transmit,
+
+};
+
+static const interface_can_login_message_handler_t _login_interface = {
+
+    .alias_mapping_register = &InternalNodeAliasTable_register,
+    .alias_mapping_find_mapping_by_alias = &InternalNodeAliasTable_find_mapping_by_alias,
+    .on_alias_change = NULL,
+    .alias_pool_claim = &CanAliasPool_claim,
+
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void _setup(void) {
+
+    _tick = 0;
+    _lock_count = 0;
+    _unlock_count = 0;
+    _transmit_ok = true;
+    _transmit_count = 0;
+    memset(&_transmitted, 0, sizeof(_transmitted));
+
+    CanBufferStore_initialize();
+    CanBufferFifo_initialize();
+    InternalNodeAliasTable_initialize();
+    CanAliasPool_initialize(&_pool_interface);
+    CanLoginMessageHandler_initialize(&_login_interface);
+
+}
+
+// Pops every queued frame into out[] (up to max), reports each as transmitted
+// the way CanMainStatemachine_handle_outgoing_can_message does, and frees it.
+static int _drain_fifo(can_msg_t *out, int max) {
+
+    int count = 0;
+    can_msg_t *msg = CanBufferFifo_pop();
+
+    while (msg) {
+
+        if (out && count < max) {
+
+            CanUtilities_copy_can_message(msg, &out[count]);
+
+        }
+
+        CanAliasPool_frame_transmitted(msg);
+
+        count++;
+        CanBufferStore_free_buffer(msg);
+        msg = CanBufferFifo_pop();
+
+    }
+
+    return count;
+
+}
+
+// Runs the pool until slot 0 is reserved and the FIFO is empty.
+static uint16_t _reserve_first_slot(void) {
+
+    CanAliasPool_run();
+    _drain_fifo(NULL, 0);
+
+    _tick += 3;
+    CanAliasPool_run();
+    _drain_fifo(NULL, 0);
+
+    return CanAliasPool_get_entry(0)->alias;
+
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+TEST(CanAliasPool, initialize)
+{
+
+    _setup();
+
+    EXPECT_EQ(CanAliasPool_get_reserved_count(), 0);
+
+    for (int i = 0; i < USER_DEFINED_ALIAS_POOL_DEPTH; i++) {
+
+        EXPECT_EQ(CanAliasPool_get_entry(i)->state, ALIAS_POOL_STATE_EMPTY);
+        EXPECT_EQ(CanAliasPool_get_entry(i)->alias, 0);
+
+    }
+
+    EXPECT_EQ(CanAliasPool_get_entry(LEN_ALIAS_POOL), nullptr);
+    EXPECT_EQ(CanAliasPool_claim(POOL_TEST_NODE_ID), 0);
+
+}
+
+TEST(CanAliasPool, run_starts_reservation_with_four_cid_frames)
+{
+
+    _setup();
+
+    EXPECT_TRUE(CanAliasPool_run());
+
+    alias_pool_entry_t *entry = CanAliasPool_get_entry(0);
+    ASSERT_EQ(entry->state, ALIAS_POOL_STATE_WAIT);
+    ASSERT_NE(entry->alias, 0);
+
+    // Alias is held in the mapping table under the placeholder, not permitted
+    alias_mapping_t *mapping = InternalNodeAliasTable_find_mapping_by_alias(entry->alias);
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ(mapping->node_id, (node_id_t) USER_DEFINED_ALIAS_POOL_NODE_ID_BASE);
+    EXPECT_FALSE(mapping->is_permitted);
+
+    can_msg_t frames[8];
+    ASSERT_EQ(_drain_fifo(frames, 8), 4);
+
+    node_id_t id = USER_DEFINED_ALIAS_POOL_NODE_ID_BASE;
+
+    EXPECT_EQ(frames[0].identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_CID7 | ((id >> 24) & 0xFFF000) | entry->alias);
+    EXPECT_EQ(frames[1].identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_CID6 | ((id >> 12) & 0xFFF000) | entry->alias);
+    EXPECT_EQ(frames[2].identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_CID5 | (id & 0xFFF000) | entry->alias);
+    EXPECT_EQ(frames[3].identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_CID4 | ((id << 12) & 0xFFF000) | entry->alias);
+
+    for (int i = 0; i < 4; i++) {
+
+        EXPECT_EQ(frames[i].payload_count, 0);
+
+    }
+
+    EXPECT_EQ(_lock_count, _unlock_count);
+
+}
+
+TEST(CanAliasPool, refill_is_rate_limited)
+{
+
+    _setup();
+
+    EXPECT_TRUE(CanAliasPool_run());
+    _drain_fifo(NULL, 0);
+
+    // Same tick: no second reservation
+    EXPECT_FALSE(CanAliasPool_run());
+    EXPECT_EQ(CanAliasPool_get_entry(1)->state, ALIAS_POOL_STATE_EMPTY);
+
+    _tick += USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS;
+
+    EXPECT_TRUE(CanAliasPool_run());
+    EXPECT_EQ(CanAliasPool_get_entry(1)->state, ALIAS_POOL_STATE_WAIT);
+    EXPECT_NE(CanAliasPool_get_entry(1)->alias, CanAliasPool_get_entry(0)->alias);
+
+    // Second slot reserves under its own placeholder Node ID
+    alias_mapping_t *mapping = InternalNodeAliasTable_find_mapping_by_alias(CanAliasPool_get_entry(1)->alias);
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ(mapping->node_id, (node_id_t) USER_DEFINED_ALIAS_POOL_NODE_ID_BASE + 1);
+
+}
+
+TEST(CanAliasPool, rid_sent_after_window)
+{
+
+    _setup();
+
+    CanAliasPool_run();
+    _drain_fifo(NULL, 0);
+
+    uint16_t alias = CanAliasPool_get_entry(0)->alias;
+
+    // 200 ms not yet elapsed
+    _tick += 2;
+    CanAliasPool_run();
+
+    can_msg_t frames[8];
+    int count = _drain_fifo(frames, 8);
+
+    for (int i = 0; i < count; i++) {
+
+        EXPECT_NE(frames[i].identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_RID | alias);
+
+    }
+
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_WAIT);
+
+    _tick += 1;
+    EXPECT_TRUE(CanAliasPool_run());
+
+    count = _drain_fifo(frames, 8);
+    ASSERT_GE(count, 1);
+    EXPECT_EQ(frames[0].identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_RID | alias);
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_RESERVED);
+    EXPECT_EQ(CanAliasPool_get_reserved_count(), 1);
+
+}
+
+TEST(CanAliasPool, window_starts_when_cid4_transmitted)
+{
+
+    _setup();
+
+    CanAliasPool_run(); // CIDs left sitting in the FIFO
+
+    _tick += 3;
+    CanAliasPool_run();
+
+    // CID4 has not left yet, so the window has not started
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_WAIT);
+    EXPECT_FALSE(CanAliasPool_get_entry(0)->cid4_sent);
+
+    _drain_fifo(NULL, 0);
+
+    EXPECT_TRUE(CanAliasPool_get_entry(0)->cid4_sent);
+    EXPECT_EQ(CanAliasPool_get_entry(0)->timerticks, _tick);
+
+    _tick += 2;
+    CanAliasPool_run();
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_WAIT);
+
+    _tick += 1;
+    CanAliasPool_run();
+
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_RESERVED);
+
+}
+
+TEST(CanAliasPool, unrelated_traffic_does_not_restart_window)
+{
+
+    _setup();
+
+    CanAliasPool_run();
+    _drain_fifo(NULL, 0);
+
+    uint8_t window_start = CanAliasPool_get_entry(0)->timerticks;
+
+    // Other outbound traffic keeps the FIFO busy on every pass
+    for (int i = 0; i < 3; i++) {
+
+        can_msg_t *other = CanBufferStore_allocate_buffer();
+        ASSERT_NE(other, nullptr);
+        other->identifier = RESERVED_TOP_BIT | CAN_OPENLCB_MSG | OPENLCB_MESSAGE_STANDARD_FRAME_TYPE | 0x123;
+        other->payload_count = 0;
+        CanBufferFifo_push(other);
+
+        _tick += 1;
+        CanAliasPool_run();
+
+        EXPECT_EQ(CanAliasPool_get_entry(0)->timerticks, window_start);
+
+    }
+
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_RESERVED);
+
+    _drain_fifo(NULL, 0);
+
+}
+
+TEST(CanAliasPool, claim_rebinds_mapping_and_empties_slot)
+{
+
+    _setup();
+
+    uint16_t alias = _reserve_first_slot();
+    ASSERT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_RESERVED);
+
+    EXPECT_EQ(CanAliasPool_claim(POOL_TEST_NODE_ID), alias);
+
+    alias_mapping_t *mapping = InternalNodeAliasTable_find_mapping_by_alias(alias);
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ(mapping->node_id, POOL_TEST_NODE_ID);
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_EMPTY);
+
+    // Nothing else is reserved yet
+    EXPECT_EQ(CanAliasPool_claim(POOL_TEST_NODE_ID + 1), 0);
+
+    // The emptied slot is refilled on a later call
+    _tick += USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS;
+    CanAliasPool_run();
+    EXPECT_NE(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_EMPTY);
+    EXPECT_NE(CanAliasPool_get_entry(0)->alias, alias);
+
+}
+
+TEST(CanAliasPool, duplicate_drops_reservation)
+{
+
+    _setup();
+
+    uint16_t alias = _reserve_first_slot();
+
+    alias_mapping_t *mapping = InternalNodeAliasTable_find_mapping_by_alias(alias);
+    ASSERT_NE(mapping, nullptr);
+    mapping->is_duplicate = true;
+
+    // Contested alias is never handed out
+    EXPECT_EQ(CanAliasPool_claim(POOL_TEST_NODE_ID), 0);
+
+    // Main statemachine unregisters it; the pool notices and refills the slot
+    InternalNodeAliasTable_unregister(alias);
+
+    _tick += USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS;
+    CanAliasPool_run();
+
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_WAIT);
+    EXPECT_NE(CanAliasPool_get_entry(0)->alias, alias);
+
+}
+
+TEST(CanAliasPool, no_reservation_without_four_buffers)
+{
+
+    _setup();
+
+    can_msg_t *held[USER_DEFINED_CAN_MSG_BUFFER_DEPTH];
+    int held_count = 0;
+
+    while (held_count < USER_DEFINED_CAN_MSG_BUFFER_DEPTH - 3) {
+
+        held[held_count++] = CanBufferStore_allocate_buffer();
+
+    }
+
+    EXPECT_FALSE(CanAliasPool_run());
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_EMPTY);
+    EXPECT_EQ(CanBufferStore_messages_allocated(), USER_DEFINED_CAN_MSG_BUFFER_DEPTH - 3);
+    EXPECT_TRUE(CanBufferFifo_is_empty());
+
+    for (int i = 0; i < held_count; i++) {
+
+        CanBufferStore_free_buffer(held[i]);
+
+    }
+
+    EXPECT_TRUE(CanAliasPool_run());
+    EXPECT_EQ(CanAliasPool_get_entry(0)->state, ALIAS_POOL_STATE_WAIT);
+
+}
+
+TEST(CanAliasPool, fills_to_depth_then_idles)
+{
+
+    _setup();
+
+    for (int i = 0; i < USER_DEFINED_ALIAS_POOL_DEPTH * 4 + 4; i++) {
+
+        CanAliasPool_run();
+        _drain_fifo(NULL, 0);
+        _tick++;
+
+    }
+
+    EXPECT_EQ(CanAliasPool_get_reserved_count(), USER_DEFINED_ALIAS_POOL_DEPTH);
+
+    _tick += 10;
+    EXPECT_FALSE(CanAliasPool_run());
+    EXPECT_EQ(_drain_fifo(NULL, 0), 0);
+
+}
+
+TEST(CanAliasPool, login_init_claims_pooled_alias)
+{
+
+    _setup();
+
+    uint16_t alias = _reserve_first_slot();
+
+    openlcb_node_t node;
+    memset(&node, 0, sizeof(node));
+    node.id = POOL_TEST_NODE_ID;
+    node.state.run_state = RUNSTATE_INIT;
+
+    can_msg_t login_msg;
+    can_statemachine_info_t info;
+    memset(&info, 0, sizeof(info));
+    info.openlcb_node = &node;
+    info.login_outgoing_can_msg = &login_msg;
+
+    CanLoginMessageHandler_state_init(&info);
+
+    EXPECT_EQ(node.alias, alias);
+    EXPECT_EQ(node.state.run_state, RUNSTATE_LOAD_ALIAS_MAP_DEFINITION);
+
+    // Next state sends AMD straight away and marks the node permitted
+    CanLoginMessageHandler_state_load_amd(&info);
+
+    EXPECT_TRUE(info.login_outgoing_can_msg_valid);
+    EXPECT_EQ(login_msg.identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AMD | alias);
+    EXPECT_EQ(CanUtilities_extract_can_payload_as_node_id(&login_msg), POOL_TEST_NODE_ID);
+    EXPECT_TRUE(node.state.permitted);
+    EXPECT_TRUE(InternalNodeAliasTable_find_mapping_by_alias(alias)->is_permitted);
+
+}
+
+TEST(CanAliasPool, login_init_falls_back_when_pool_empty)
+{
+
+    _setup();
+
+    openlcb_node_t node;
+    memset(&node, 0, sizeof(node));
+    node.id = POOL_TEST_NODE_ID;
+    node.state.run_state = RUNSTATE_INIT;
+
+    can_statemachine_info_t info;
+    memset(&info, 0, sizeof(info));
+    info.openlcb_node = &node;
+
+    CanLoginMessageHandler_state_init(&info);
+
+    EXPECT_EQ(node.alias, 0);
+    EXPECT_EQ(node.seed, POOL_TEST_NODE_ID);
+    EXPECT_EQ(node.state.run_state, RUNSTATE_GENERATE_ALIAS);
+
+}
+
+TEST(CanAliasPool, announce_sends_amd_directly_and_permits)
+{
+
+    _setup();
+
+    _reserve_first_slot();
+    uint16_t alias = CanAliasPool_claim(POOL_TEST_NODE_ID);
+    ASSERT_NE(alias, 0);
+    EXPECT_TRUE(CanAliasPool_is_held(alias, POOL_TEST_NODE_ID));
+    EXPECT_FALSE(CanAliasPool_is_held(alias, POOL_TEST_NODE_ID + 1));
+
+    // Busy hardware: nothing changes
+    _transmit_ok = false;
+    EXPECT_FALSE(CanAliasPool_announce(alias, POOL_TEST_NODE_ID));
+    EXPECT_FALSE(InternalNodeAliasTable_find_mapping_by_alias(alias)->is_permitted);
+
+    _transmit_ok = true;
+    EXPECT_TRUE(CanAliasPool_announce(alias, POOL_TEST_NODE_ID));
+    EXPECT_EQ(_transmit_count, 1);
+    EXPECT_EQ(_transmitted.identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AMD | alias);
+    EXPECT_EQ(CanUtilities_extract_can_payload_as_node_id(&_transmitted), POOL_TEST_NODE_ID);
+    EXPECT_TRUE(InternalNodeAliasTable_find_mapping_by_alias(alias)->is_permitted);
+
+    // Nothing went through the FIFO
+    EXPECT_EQ(_drain_fifo(NULL, 0), 0);
+
+    // A contested alias is not announced
+    InternalNodeAliasTable_find_mapping_by_alias(alias)->is_duplicate = true;
+    EXPECT_FALSE(CanAliasPool_is_held(alias, POOL_TEST_NODE_ID));
+    EXPECT_FALSE(CanAliasPool_announce(alias, POOL_TEST_NODE_ID));
+    EXPECT_EQ(_transmit_count, 1);
+
+}
+
+TEST(CanAliasPool, release_queues_amr_and_unregisters)
+{
+
+    _setup();
+
+    _reserve_first_slot();
+    uint16_t alias = CanAliasPool_claim(POOL_TEST_NODE_ID);
+    ASSERT_TRUE(CanAliasPool_announce(alias, POOL_TEST_NODE_ID));
+
+    CanAliasPool_release(alias);
+
+    can_msg_t frames[2];
+    ASSERT_EQ(_drain_fifo(frames, 2), 1);
+    EXPECT_EQ(frames[0].identifier, RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AMR | alias);
+    EXPECT_EQ(CanUtilities_extract_can_payload_as_node_id(&frames[0]), POOL_TEST_NODE_ID);
+    EXPECT_EQ(InternalNodeAliasTable_find_mapping_by_alias(alias), nullptr);
+
+    // Already gone: no-op
+    CanAliasPool_release(alias);
+    EXPECT_EQ(_drain_fifo(NULL, 0), 0);
+
+    // Never announced: no AMR
+    _tick += USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS;
+    _reserve_first_slot();
+    alias = CanAliasPool_claim(POOL_TEST_NODE_ID);
+    ASSERT_NE(alias, 0);
+    CanAliasPool_release(alias);
+    EXPECT_EQ(_drain_fifo(NULL, 0), 0);
+    EXPECT_EQ(InternalNodeAliasTable_find_mapping_by_alias(alias), nullptr);
+
+}
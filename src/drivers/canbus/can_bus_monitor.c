@@ -0,0 +1,279 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file can_bus_monitor.c
+ * @brief Implementation of the CAN bus-load monitor.
+ *
+ * @details The receive interrupt and the transmit path add to a set of window
+ * accumulators; CanBusMonitor_run() swaps them out under the shared-resource
+ * lock once per tick and does all arithmetic in the main loop.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#include "can_bus_monitor.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "can_types.h"
+
+
+/** @brief Bus bits available in one 100 ms tick (at least 1 so a disabled monitor still compiles). */
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE >= 10
+#define CAN_BUS_MONITOR_BITS_PER_TICK ((uint32_t) USER_DEFINED_CAN_BUS_MONITOR_BITRATE / 10)
+#else
+#define CAN_BUS_MONITOR_BITS_PER_TICK ((uint32_t) 1)
+#endif
+
+/** @brief Percentage points below the throttle threshold at which congestion clears. */
+#define CAN_BUS_MONITOR_THROTTLE_HYSTERESIS 5
+
+/** @brief Saved pointer to the dependency-injected interface. */
+static interface_can_bus_monitor_t *_interface;
+
+/** @brief Published figures. */
+static can_bus_monitor_stats_t _stats;
+
+/** @brief Bits received in the open window (written from the RX interrupt). */
+static uint32_t _window_rx_bits;
+
+/** @brief Bits transmitted in the open window. */
+static uint32_t _window_tx_bits;
+
+/** @brief Frames received in the open window (written from the RX interrupt). */
+static uint16_t _window_rx_frames;
+
+/** @brief Frames transmitted in the open window. */
+static uint16_t _window_tx_frames;
+
+/** @brief Error frames reported in the open window. */
+static uint16_t _window_error_frames;
+
+/** @brief Tick at which the open window started. */
+static uint8_t _window_tick;
+
+/** @brief Congestion flag with hysteresis. */
+static bool _is_congested;
+
+    /** @brief Stores the interface pointer, clears every counter and starts a window at the current tick. */
+void CanBusMonitor_initialize(const interface_can_bus_monitor_t *interface) {
+
+    _interface = (interface_can_bus_monitor_t *) interface;
+
+    _window_rx_bits = 0;
+    _window_tx_bits = 0;
+    _window_rx_frames = 0;
+    _window_tx_frames = 0;
+    _window_error_frames = 0;
+    _window_tick = _interface->get_current_tick();
+    _is_congested = false;
+
+    _stats.average_utilisation_percent = 0;
+    _stats.utilisation_percent = 0;
+    _stats.rx_frames_per_tick = 0;
+    _stats.tx_frames_per_tick = 0;
+
+    CanBusMonitor_reset_stats();
+
+}
+
+    /**
+     * @brief Estimates the bits a frame occupies on the wire.
+     *
+     * @details Extended frame: 67 bits of framing and intermission plus 8 per
+     * data byte, plus the worst-case stuff bits over the 54 + 8n stuffed bits.
+     *
+     * @verbatim
+     * @param can_msg  Frame to measure.
+     * @endverbatim
+     *
+     * @return Bit count, 80 for an empty frame up to 160 for 8 data bytes.
+     */
+static uint16_t _frame_bits(can_msg_t *can_msg) {
+
+    uint16_t data_bits = (uint16_t) (can_msg->payload_count * 8);
+
+    return (uint16_t) (67 + data_bits + ((54 + data_bits - 1) / 4));
+
+}
+
+    /** @brief Maps a per-tick frame count to its power-of-two histogram bucket. */
+static uint8_t _histogram_bucket(uint16_t frames) {
+
+    uint8_t bucket = 0;
+
+    while (frames != 0 && bucket < (CAN_BUS_MONITOR_HISTOGRAM_BUCKETS - 1)) {
+
+        frames >>= 1;
+        bucket++;
+
+    }
+
+    return bucket;
+
+}
+
+    /** @brief Adds a received frame to the open window. */
+void CanBusMonitor_count_rx_frame(can_msg_t *can_msg) {
+
+    _window_rx_bits += _frame_bits(can_msg);
+    _window_rx_frames++;
+
+}
+
+    /** @brief Adds a transmitted frame to the open window. */
+void CanBusMonitor_count_tx_frame(can_msg_t *can_msg) {
+
+    _window_tx_bits += _frame_bits(can_msg);
+    _window_tx_frames++;
+
+}
+
+    /** @brief Adds a bus error frame to the open window. */
+void CanBusMonitor_count_error_frame(void) {
+
+    _window_error_frames++;
+
+}
+
+    /**
+     * @brief Closes the open window once the tick has moved.
+     *
+     * @details Algorithm:
+     * -# Return false if the tick has not moved since the window opened
+     * -# Under the lock, take and zero the window accumulators
+     * -# Utilisation = bits * 100 / (bits per tick * ticks elapsed), capped at 100
+     * -# Update totals, peak, the histogram (once per elapsed tick, at the mean
+     *    frame count) and the smoothed utilisation
+     * -# Set congestion at the threshold, clear it HYSTERESIS points below
+     *
+     * @return true if a window was closed.
+     */
+bool CanBusMonitor_run(void) {
+
+    uint8_t tick = _interface->get_current_tick();
+    uint8_t elapsed = (uint8_t) (tick - _window_tick);
+
+    if (elapsed == 0) {
+
+        return false;
+
+    }
+
+    _interface->lock_shared_resources();
+
+    uint32_t bits = _window_rx_bits + _window_tx_bits;
+    uint16_t rx_frames = _window_rx_frames;
+    uint16_t tx_frames = _window_tx_frames;
+    uint16_t error_frames = _window_error_frames;
+
+    _window_rx_bits = 0;
+    _window_tx_bits = 0;
+    _window_rx_frames = 0;
+    _window_tx_frames = 0;
+    _window_error_frames = 0;
+
+    _interface->unlock_shared_resources();
+
+    _window_tick = tick;
+
+    uint32_t utilisation = (bits * 100) / (CAN_BUS_MONITOR_BITS_PER_TICK * elapsed);
+
+    if (utilisation > 100) {
+
+        utilisation = 100;
+
+    }
+
+    _stats.utilisation_percent = (uint8_t) utilisation;
+    _stats.rx_frames_per_tick = rx_frames;
+    _stats.tx_frames_per_tick = tx_frames;
+    _stats.rx_frames += rx_frames;
+    _stats.tx_frames += tx_frames;
+    _stats.error_frames += error_frames;
+    _stats.ticks += elapsed;
+    _stats.frame_rate_histogram[_histogram_bucket((uint16_t) ((rx_frames + tx_frames) / elapsed))] += elapsed;
+
+    if (_stats.utilisation_percent > _stats.peak_utilisation_percent) {
+
+        _stats.peak_utilisation_percent = _stats.utilisation_percent;
+
+    }
+
+    _stats.average_utilisation_percent =
+            (uint8_t) ((_stats.average_utilisation_percent * 3 + _stats.utilisation_percent + 2) / 4);
+
+#if USER_DEFINED_CAN_BUS_THROTTLE_PERCENT > 0
+
+    if (_stats.average_utilisation_percent >= USER_DEFINED_CAN_BUS_THROTTLE_PERCENT) {
+
+        _is_congested = true;
+
+    } else if (_stats.average_utilisation_percent + CAN_BUS_MONITOR_THROTTLE_HYSTERESIS < USER_DEFINED_CAN_BUS_THROTTLE_PERCENT) {
+
+        _is_congested = false;
+
+    }
+
+#endif
+
+    return true;
+
+}
+
+    /** @brief Returns a read-only pointer to the published figures. */
+const can_bus_monitor_stats_t *CanBusMonitor_get_stats(void) {
+
+    return &_stats;
+
+}
+
+    /** @brief Returns the congestion flag. */
+bool CanBusMonitor_is_congested(void) {
+
+    return _is_congested;
+
+}
+
+    /** @brief Clears totals, peak and the histogram. */
+void CanBusMonitor_reset_stats(void) {
+
+    _stats.peak_utilisation_percent = 0;
+    _stats.rx_frames = 0;
+    _stats.tx_frames = 0;
+    _stats.error_frames = 0;
+    _stats.ticks = 0;
+
+    for (int i = 0; i < CAN_BUS_MONITOR_HISTOGRAM_BUCKETS; i++) {
+
+        _stats.frame_rate_histogram[i] = 0;
+
+    }
+
+}
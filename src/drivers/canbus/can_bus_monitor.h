@@ -0,0 +1,156 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file can_bus_monitor.h
+ * @brief CAN bus-load monitor with low-priority traffic throttling.
+ *
+ * @details Counts every frame received (from
+ * CanRxStatemachine_incoming_can_driver_callback()) and transmitted (from the
+ * transmit message handler), together with an estimate of the bits each one
+ * occupies on the wire.  CanBusMonitor_run() closes a window on every 100 ms
+ * tick and turns the bit count into a utilisation figure against
+ * USER_DEFINED_CAN_BUS_MONITOR_BITRATE.
+ *
+ * The bit estimate is the extended-frame length including the 3-bit intermission
+ * plus the worst-case number of stuff bits, so the figure errs high.  Bus error
+ * frames are invisible to the stack; the CAN driver reports them through
+ * CanBusMonitor_count_error_frame().
+ *
+ * When USER_DEFINED_CAN_BUS_THROTTLE_PERCENT is set, CanBusMonitor_is_congested()
+ * goes true once the smoothed utilisation reaches it and false again 5 points
+ * below it.  The OpenLCB main state machine then holds multi-message event
+ * enumeration and the config-memory stream pump until the bus calms down.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __DRIVERS_CANBUS_CAN_BUS_MONITOR__
+#define __DRIVERS_CANBUS_CAN_BUS_MONITOR__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_types.h"
+
+    /**
+     * @brief Dependency-injection interface for the bus monitor.
+     *
+     * @details All function pointers are REQUIRED (must not be NULL).
+     *
+     * @see CanBusMonitor_initialize
+     */
+typedef struct {
+
+        /** @brief REQUIRED. Current value of the global 100 ms tick. Typical impl: OpenLcbConfig_get_global_100ms_tick. */
+    uint8_t (*get_current_tick)(void);
+
+        /** @brief REQUIRED. Disable interrupts / acquire mutex. */
+    void (*lock_shared_resources)(void);
+
+        /** @brief REQUIRED. Re-enable interrupts / release mutex. */
+    void (*unlock_shared_resources)(void);
+
+} interface_can_bus_monitor_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+        /**
+         * @brief Registers the interface and clears all counters.
+         *
+         * @param interface  Pointer to a populated @ref interface_can_bus_monitor_t.
+         *                   Must remain valid for the lifetime of the application.
+         *
+         * @warning NOT thread-safe - call during single-threaded initialization only.
+         */
+    extern void CanBusMonitor_initialize(const interface_can_bus_monitor_t *interface);
+
+        /**
+         * @brief Counts one received frame.
+         *
+         * @details Safe to call from the CAN receive interrupt.
+         *
+         * @param can_msg  Frame as delivered by the driver.
+         */
+    extern void CanBusMonitor_count_rx_frame(can_msg_t *can_msg);
+
+        /**
+         * @brief Counts one transmitted frame.
+         *
+         * @param can_msg  Frame handed to the controller.
+         */
+    extern void CanBusMonitor_count_tx_frame(can_msg_t *can_msg);
+
+        /**
+         * @brief Counts one bus error frame seen by the controller.
+         *
+         * @details Called by the application's CAN driver from its error
+         * interrupt or status poll.  Safe to call from an interrupt.
+         */
+    extern void CanBusMonitor_count_error_frame(void);
+
+        /**
+         * @brief Closes the current window when the 100 ms tick has moved.
+         *
+         * @details Updates utilisation, the frame-rate histogram and the
+         * congestion flag.  Called from CanMainStatemachine_run().
+         *
+         * @return true if a window was closed, false if the tick has not moved.
+         *
+         * @warning Locks shared resources while taking the window counters.
+         */
+    extern bool CanBusMonitor_run(void);
+
+        /**
+         * @brief Returns the current bus-load figures.
+         *
+         * @return Pointer to the monitor's @ref can_bus_monitor_stats_t (read only).
+         */
+    extern const can_bus_monitor_stats_t *CanBusMonitor_get_stats(void);
+
+        /**
+         * @brief Returns whether low-priority traffic should be deferred.
+         *
+         * @return true while the smoothed utilisation is above the throttle
+         *         threshold, always false when USER_DEFINED_CAN_BUS_THROTTLE_PERCENT is 0.
+         */
+    extern bool CanBusMonitor_is_congested(void);
+
+        /**
+         * @brief Clears totals, peak and histogram; the smoothed utilisation is kept.
+         */
+    extern void CanBusMonitor_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __DRIVERS_CANBUS_CAN_BUS_MONITOR__ */
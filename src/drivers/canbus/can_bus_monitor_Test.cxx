@@ -0,0 +1,307 @@
+/*******************************************************************************
+ * File: can_bus_monitor_Test.cxx
+ *
+ * Description:
+ *   Test suite for the CanBusMonitor module (can_bus_monitor.h/.c).
+ *   Tests frame and bit counting, window closing on the 100 ms tick,
+ *   the frame-rate histogram and the congestion flag.
+ *
+ * Test Coverage:
+ *   - Utilisation from RX and TX bit estimates
+ *   - Windows spanning several ticks, 100% cap
+ *   - Error frame and total counters, reset
+ *   - Histogram bucket edges
+ *   - Congestion set at the threshold, cleared with hysteresis
+ *
+ * Author: Jim Kueneman
+ * Date: 2026-10-18
+ ******************************************************************************/
+
+#include "test/main_Test.hxx"
+
+#include "can_types.h"
+#include "can_bus_monitor.h"
+
+/*******************************************************************************
+ * Mocks
+ ******************************************************************************/
+
+static uint8_t _test_tick = 0;
+
+static uint8_t _get_current_tick(void) {
+
+    return _test_tick;
+
+}
+
+static void _lock_shared_resources(void) {
+
+}
+
+static void _unlock_shared_resources(void) {
+
+}
+
+static const interface_can_bus_monitor_t _interface = {
+
+    .get_current_tick = &_get_current_tick,
+    .lock_shared_resources = &_lock_shared_resources,
+    .unlock_shared_resources = &_unlock_shared_resources,
+
+};
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+/** Bits the monitor charges for an extended frame with payload_count bytes. */
+#define FRAME_BITS(n) (67 + (n) * 8 + ((54 + (n) * 8 - 1) / 4))
+
+#define BITS_PER_TICK (USER_DEFINED_CAN_BUS_MONITOR_BITRATE / 10)
+
+static void setup_test(void) {
+
+    _test_tick = 0;
+    CanBusMonitor_initialize(&_interface);
+
+}
+
+static void count_frames(bool is_rx, uint16_t count, uint8_t payload_count) {
+
+    can_msg_t msg = {};
+    msg.payload_count = payload_count;
+
+    for (uint16_t i = 0; i < count; i++) {
+
+        if (is_rx) {
+
+            CanBusMonitor_count_rx_frame(&msg);
+
+        } else {
+
+            CanBusMonitor_count_tx_frame(&msg);
+
+        }
+
+    }
+
+}
+
+/** Fills one window to roughly percent utilisation with 8-byte RX frames and closes it. */
+static void run_window(uint8_t percent) {
+
+    count_frames(true, (uint16_t) ((BITS_PER_TICK * percent) / 100 / FRAME_BITS(8)), 8);
+    _test_tick++;
+    CanBusMonitor_run();
+
+}
+
+/*******************************************************************************
+ * Tests
+ ******************************************************************************/
+
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0
+
+TEST(CanBusMonitor, frame_bit_estimate_bounds) {
+
+    EXPECT_EQ(FRAME_BITS(0), 80);
+    EXPECT_EQ(FRAME_BITS(8), 160);
+
+}
+
+TEST(CanBusMonitor, run_waits_for_tick) {
+
+    setup_test();
+
+    count_frames(true, 5, 8);
+
+    EXPECT_FALSE(CanBusMonitor_run());
+    EXPECT_EQ(CanBusMonitor_get_stats()->ticks, 0u);
+
+    _test_tick++;
+
+    EXPECT_TRUE(CanBusMonitor_run());
+    EXPECT_EQ(CanBusMonitor_get_stats()->ticks, 1u);
+    EXPECT_EQ(CanBusMonitor_get_stats()->rx_frames_per_tick, 5);
+
+    // The next window starts empty
+    _test_tick++;
+
+    EXPECT_TRUE(CanBusMonitor_run());
+    EXPECT_EQ(CanBusMonitor_get_stats()->rx_frames_per_tick, 0);
+    EXPECT_EQ(CanBusMonitor_get_stats()->rx_frames, 5u);
+
+}
+
+TEST(CanBusMonitor, utilisation_counts_rx_and_tx_bits) {
+
+    setup_test();
+
+    count_frames(true, 50, 8);
+    count_frames(false, 10, 0);
+
+    _test_tick++;
+    CanBusMonitor_run();
+
+    const can_bus_monitor_stats_t *stats = CanBusMonitor_get_stats();
+
+    uint32_t expected = ((50 * FRAME_BITS(8) + 10 * FRAME_BITS(0)) * 100) / BITS_PER_TICK;
+
+    EXPECT_EQ(stats->utilisation_percent, expected);
+    EXPECT_EQ(stats->peak_utilisation_percent, expected);
+    EXPECT_EQ(stats->rx_frames_per_tick, 50);
+    EXPECT_EQ(stats->tx_frames_per_tick, 10);
+    EXPECT_EQ(stats->rx_frames, 50u);
+    EXPECT_EQ(stats->tx_frames, 10u);
+
+    // 60 frames lands in the 32-63 bucket
+    EXPECT_EQ(stats->frame_rate_histogram[6], 1u);
+
+}
+
+TEST(CanBusMonitor, window_over_several_ticks_is_averaged) {
+
+    setup_test();
+
+    count_frames(true, 40, 8);
+
+    _test_tick = (uint8_t) (_test_tick + 4);
+    CanBusMonitor_run();
+
+    const can_bus_monitor_stats_t *stats = CanBusMonitor_get_stats();
+
+    EXPECT_EQ(stats->utilisation_percent, (40 * FRAME_BITS(8) * 100) / (BITS_PER_TICK * 4));
+    EXPECT_EQ(stats->ticks, 4u);
+
+    // 10 frames per tick on average, recorded for each of the 4 ticks
+    EXPECT_EQ(stats->frame_rate_histogram[4], 4u);
+
+}
+
+TEST(CanBusMonitor, utilisation_capped_at_100) {
+
+    setup_test();
+
+    count_frames(true, (uint16_t) (2 * BITS_PER_TICK / FRAME_BITS(8)), 8);
+
+    _test_tick++;
+    CanBusMonitor_run();
+
+    EXPECT_EQ(CanBusMonitor_get_stats()->utilisation_percent, 100);
+
+}
+
+TEST(CanBusMonitor, histogram_bucket_edges) {
+
+    setup_test();
+
+    const uint16_t frames[] = {0, 1, 2, 3, 4, 127, 128, 300};
+    const uint8_t buckets[] = {0, 1, 2, 2, 3, 7, 8, 8};
+
+    for (unsigned i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+
+        CanBusMonitor_reset_stats();
+
+        count_frames(false, frames[i], 0);
+        _test_tick++;
+        CanBusMonitor_run();
+
+        EXPECT_EQ(CanBusMonitor_get_stats()->frame_rate_histogram[buckets[i]], 1u) << "frames " << frames[i];
+
+    }
+
+}
+
+TEST(CanBusMonitor, error_frames_and_reset) {
+
+    setup_test();
+
+    CanBusMonitor_count_error_frame();
+    CanBusMonitor_count_error_frame();
+    count_frames(true, 3, 2);
+
+    _test_tick++;
+    CanBusMonitor_run();
+
+    EXPECT_EQ(CanBusMonitor_get_stats()->error_frames, 2u);
+
+    CanBusMonitor_reset_stats();
+
+    const can_bus_monitor_stats_t *stats = CanBusMonitor_get_stats();
+
+    EXPECT_EQ(stats->error_frames, 0u);
+    EXPECT_EQ(stats->rx_frames, 0u);
+    EXPECT_EQ(stats->ticks, 0u);
+    EXPECT_EQ(stats->peak_utilisation_percent, 0);
+
+    for (int i = 0; i < CAN_BUS_MONITOR_HISTOGRAM_BUCKETS; i++) {
+
+        EXPECT_EQ(stats->frame_rate_histogram[i], 0u);
+
+    }
+
+}
+
+#if USER_DEFINED_CAN_BUS_THROTTLE_PERCENT > 0
+
+TEST(CanBusMonitor, congestion_follows_average_with_hysteresis) {
+
+    setup_test();
+
+    EXPECT_FALSE(CanBusMonitor_is_congested());
+
+    // A single busy window does not trip the smoothed figure
+    run_window(100);
+    EXPECT_FALSE(CanBusMonitor_is_congested());
+
+    int windows = 1;
+
+    while (!CanBusMonitor_is_congested() && windows < 50) {
+
+        run_window(100);
+        windows++;
+
+    }
+
+    ASSERT_TRUE(CanBusMonitor_is_congested());
+    EXPECT_GE(CanBusMonitor_get_stats()->average_utilisation_percent, USER_DEFINED_CAN_BUS_THROTTLE_PERCENT);
+
+    // Drain: stays congested until the average is 5 points under the threshold
+    while (CanBusMonitor_is_congested() && windows < 100) {
+
+        EXPECT_GE(CanBusMonitor_get_stats()->average_utilisation_percent + 5, USER_DEFINED_CAN_BUS_THROTTLE_PERCENT);
+
+        run_window(0);
+        windows++;
+
+    }
+
+    EXPECT_FALSE(CanBusMonitor_is_congested());
+    EXPECT_LT(CanBusMonitor_get_stats()->average_utilisation_percent + 5, USER_DEFINED_CAN_BUS_THROTTLE_PERCENT);
+
+}
+
+TEST(CanBusMonitor, congestion_holds_inside_hysteresis_band) {
+
+    setup_test();
+
+    while (!CanBusMonitor_is_congested()) {
+
+        run_window(100);
+
+    }
+
+    // Hover just under the threshold: the flag must not chatter off
+    for (int i = 0; i < 20; i++) {
+
+        run_window(USER_DEFINED_CAN_BUS_THROTTLE_PERCENT - 3);
+
+        EXPECT_TRUE(CanBusMonitor_is_congested());
+
+    }
+
+}
+
+#endif
+
+#endif
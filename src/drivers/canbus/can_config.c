@@ -57,11 +57,19 @@
 #include "can_main_statemachine.h"
 #include "internal_node_alias_table.h"
 #include "alias_mapping_listener.h"
+#include "can_alias_pool.h"
+#include "remote_alias_cache.h"
+#include "can_acceptance_filter.h"
+#include "can_bus_monitor.h"
+#include "can_tx_scheduler.h"
 
 // Cross-layer includes
 #include "../../openlcb/openlcb_buffer_store.h"
 #include "../../openlcb/openlcb_node.h"
 #include "../../openlcb/openlcb_config.h"
+#ifdef OPENLCB_COMPILE_DATAGRAMS
+#include "../../openlcb/protocol_datagram_handler.h"
+#endif
 
 // ---- Internal storage for built interface structs ----
 
@@ -86,6 +94,26 @@ static interface_can_tx_statemachine_t _tx_sm;
 /** @brief Built interface struct for the main state machine. */
 static interface_can_main_statemachine_t _main_sm;
 
+#if USER_DEFINED_ALIAS_POOL_DEPTH > 0
+/** @brief Built interface struct for the pre-reserved alias pool. */
+static interface_can_alias_pool_t _alias_pool;
+#endif
+
+#if USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 0
+/** @brief Built interface struct for the hardware acceptance filter generator. */
+static interface_can_acceptance_filter_t _acceptance_filter;
+#endif
+
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0
+/** @brief Built interface struct for the bus-load monitor. */
+static interface_can_bus_monitor_t _bus_monitor;
+#endif
+
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+/** @brief Built interface struct for the TX priority scheduler. */
+static interface_can_tx_scheduler_t _tx_scheduler;
+#endif
+
 /** @brief Saved pointer to the user-provided configuration. */
 static const can_config_t *_config;
 
@@ -103,6 +131,11 @@ static void _build_login_message_handler(void) {
     // User callback (optional)
     _login_msg.on_alias_change = _config->on_alias_change;
 
+    // Pre-reserved alias pool (OPTIONAL — NULL if USER_DEFINED_ALIAS_POOL_DEPTH is 0)
+#if USER_DEFINED_ALIAS_POOL_DEPTH > 0
+    _login_msg.alias_pool_claim = &CanAliasPool_claim;
+#endif
+
 }
 
     /** @brief Wires the login state machine interface with all 10 state handlers. */
@@ -145,6 +178,14 @@ static void _build_rx_message_handler(void) {
     _rx_msg.listener_flush_aliases = &AliasMappingListener_flush_aliases;
 #endif
 
+    // Remote alias cache (OPTIONAL — NULL if USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH is 0)
+#if USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH > 0
+    _rx_msg.remote_alias_cache_update = &RemoteAliasCache_update;
+    _rx_msg.remote_alias_cache_find_node_id = &RemoteAliasCache_find_node_id;
+    _rx_msg.remote_alias_cache_invalidate_alias = &RemoteAliasCache_invalidate_alias;
+    _rx_msg.remote_alias_cache_flush = &RemoteAliasCache_flush;
+#endif
+
 }
 
     /** @brief Wires the receive state machine interface with all 12 frame handlers and user callback. */
@@ -168,10 +209,16 @@ static void _build_rx_statemachine(void) {
 
     // Library-internal wiring -- alias lookup
     _rx_sm.alias_mapping_find_mapping_by_alias = &InternalNodeAliasTable_find_mapping_by_alias;
+    _rx_sm.alias_mapping_is_local_alias = &InternalNodeAliasTable_is_local_alias;
 
     // User callback (optional)
     _rx_sm.on_receive = _config->on_rx;
 
+    // Bus-load monitor (OPTIONAL — NULL if USER_DEFINED_CAN_BUS_MONITOR_BITRATE is 0)
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0
+    _rx_sm.bus_monitor_count_rx_frame = &CanBusMonitor_count_rx_frame;
+#endif
+
 }
 
     /** @brief Wires the transmit message handler interface from user config. */
@@ -182,9 +229,23 @@ static void _build_tx_message_handler(void) {
     // User hardware driver (required)
     _tx_msg.transmit_can_frame = _config->transmit_raw_can_frame;
 
+    // TX priority scheduler (OPTIONAL — only when the driver reports its mailboxes)
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+    if (_config->get_free_tx_mailbox_count) {
+
+        _tx_msg.transmit_can_frame = &CanTxScheduler_queue_frame;
+
+    }
+#endif
+
     // User callback (optional)
     _tx_msg.on_transmit = _config->on_tx;
 
+    // Bus-load monitor (OPTIONAL — NULL if USER_DEFINED_CAN_BUS_MONITOR_BITRATE is 0)
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0
+    _tx_msg.bus_monitor_count_tx_frame = &CanBusMonitor_count_tx_frame;
+#endif
+
 }
 
     /** @brief Wires the transmit state machine interface with all 5 message type handlers. */
@@ -195,6 +256,15 @@ static void _build_tx_statemachine(void) {
     // User hardware driver (required)
     _tx_sm.is_tx_buffer_empty = _config->is_tx_buffer_clear;
 
+    // TX priority scheduler (OPTIONAL — only when the driver reports its mailboxes)
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+    if (_config->get_free_tx_mailbox_count) {
+
+        _tx_sm.is_tx_buffer_empty = &CanTxScheduler_is_ready;
+
+    }
+#endif
+
     // Library-internal wiring -- 5 message type handlers
     _tx_sm.handle_addressed_msg_frame   = &CanTxMessageHandler_addressed_msg_frame;
     _tx_sm.handle_unaddressed_msg_frame = &CanTxMessageHandler_unaddressed_msg_frame;
@@ -214,6 +284,11 @@ static void _build_tx_statemachine(void) {
     _tx_sm.unlock_shared_resources   = _config->unlock_shared_resources;
 #endif
 
+    // Remote alias resolution for messages addressed by Node ID (OPTIONAL)
+#if USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH > 0
+    _tx_sm.remote_alias_cache_find_alias = &RemoteAliasCache_find_alias;
+#endif
+
 }
 
     /** @brief Wires the main state machine interface from user config and library internals. */
@@ -236,6 +311,7 @@ static void _build_main_statemachine(void) {
 
     // Clock access (injected to maintain decoupling)
     _main_sm.get_current_tick = &OpenLcbConfig_get_global_100ms_tick;
+    _main_sm.get_time_ms      = &OpenLcbConfig_get_time_ms;
 
     // Internal handlers (exposed for testability)
     _main_sm.handle_duplicate_aliases = &CanMainStatemachine_handle_duplicate_aliases;
@@ -244,17 +320,122 @@ static void _build_main_statemachine(void) {
     _main_sm.handle_try_enumerate_first_node = &CanMainStatemachine_handle_try_enumerate_first_node;
     _main_sm.handle_try_enumerate_next_node = &CanMainStatemachine_handle_try_enumerate_next_node;
 
+    // Pre-reserved alias pool (OPTIONAL — NULL if USER_DEFINED_ALIAS_POOL_DEPTH is 0)
+#if USER_DEFINED_ALIAS_POOL_DEPTH > 0
+    _main_sm.handle_alias_pool = &CanAliasPool_run;
+    _main_sm.alias_pool_frame_transmitted = &CanAliasPool_frame_transmitted;
+#endif
+
+    // Bus-load monitor (OPTIONAL — NULL if USER_DEFINED_CAN_BUS_MONITOR_BITRATE is 0)
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0
+    _main_sm.handle_bus_monitor = &CanBusMonitor_run;
+#endif
+
+    // TX priority scheduler (OPTIONAL — only when the driver reports its mailboxes)
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+    if (_config->get_free_tx_mailbox_count) {
+
+        _main_sm.handle_tx_scheduler = &CanTxScheduler_run;
+
+    }
+#endif
+
+    // Hardware acceptance filters (OPTIONAL — NULL if disabled or no user callback)
+#if USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 0
+    if (_config->on_acceptance_filters_changed) {
+
+        _main_sm.handle_acceptance_filters = &CanAcceptanceFilter_run;
+
+    }
+#endif
+
     // Listener verification and alias management
     // (OPTIONAL — NULL if OPENLCB_COMPILE_TRAIN not defined)
 #ifdef OPENLCB_COMPILE_TRAIN
     _main_sm.handle_listener_verification = &CanMainStatemachine_handle_listener_verification;
     _main_sm.listener_check_one_verification = &AliasMappingListener_check_one_verification;
+    _main_sm.listener_take_bulk_enquiry = &AliasMappingListener_take_bulk_enquiry;
     _main_sm.listener_flush_aliases = &AliasMappingListener_flush_aliases;
     _main_sm.listener_set_alias = &AliasMappingListener_set_alias;
 #endif
 
+    // Outstanding datagrams of a node reset by a duplicate alias
+    // (OPTIONAL — NULL if OPENLCB_COMPILE_DATAGRAMS not defined)
+#ifdef OPENLCB_COMPILE_DATAGRAMS
+    _main_sm.clear_resend_datagram_message = &ProtocolDatagramHandler_clear_resend_datagram_message;
+#endif
+
 }
 
+#if USER_DEFINED_ALIAS_POOL_DEPTH > 0
+    /** @brief Wires the alias pool interface from user config and library internals. */
+static void _build_alias_pool(void) {
+
+    memset(&_alias_pool, 0, sizeof(_alias_pool));
+
+    // User hardware drivers (required -- duplicated from openlcb_config_t)
+    _alias_pool.lock_shared_resources   = _config->lock_shared_resources;
+    _alias_pool.unlock_shared_resources = _config->unlock_shared_resources;
+
+    // Library-internal wiring
+    _alias_pool.alias_mapping_register = &InternalNodeAliasTable_register;
+    _alias_pool.alias_mapping_unregister = &InternalNodeAliasTable_unregister;
+    _alias_pool.alias_mapping_find_mapping_by_alias = &InternalNodeAliasTable_find_mapping_by_alias;
+    _alias_pool.get_current_tick = &OpenLcbConfig_get_global_100ms_tick;
+    _alias_pool.transmit_can_frame = &CanTxStatemachine_send_can_message;
+
+}
+#endif
+
+#if USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 0
+    /** @brief Wires the acceptance filter generator interface from user config and library internals. */
+static void _build_acceptance_filter(void) {
+
+    memset(&_acceptance_filter, 0, sizeof(_acceptance_filter));
+
+    // User hardware drivers (required -- duplicated from openlcb_config_t)
+    _acceptance_filter.lock_shared_resources   = _config->lock_shared_resources;
+    _acceptance_filter.unlock_shared_resources = _config->unlock_shared_resources;
+    _acceptance_filter.on_acceptance_filters_changed = _config->on_acceptance_filters_changed;
+
+    // Library-internal wiring
+    _acceptance_filter.alias_mapping_get_alias_mapping_info = &InternalNodeAliasTable_get_alias_mapping_info;
+    _acceptance_filter.alias_mapping_get_change_count = &InternalNodeAliasTable_get_change_count;
+
+}
+#endif
+
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0
+    /** @brief Wires the bus-load monitor interface from user config and library internals. */
+static void _build_bus_monitor(void) {
+
+    memset(&_bus_monitor, 0, sizeof(_bus_monitor));
+
+    // User hardware drivers (required -- duplicated from openlcb_config_t)
+    _bus_monitor.lock_shared_resources   = _config->lock_shared_resources;
+    _bus_monitor.unlock_shared_resources = _config->unlock_shared_resources;
+
+    // Clock access
+    _bus_monitor.get_current_tick = &OpenLcbConfig_get_global_100ms_tick;
+
+}
+#endif
+
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+    /** @brief Wires the TX priority scheduler interface from user config. */
+static void _build_tx_scheduler(void) {
+
+    memset(&_tx_scheduler, 0, sizeof(_tx_scheduler));
+
+    // User hardware drivers (required)
+    _tx_scheduler.transmit_raw_can_frame    = _config->transmit_raw_can_frame;
+    _tx_scheduler.get_free_tx_mailbox_count = _config->get_free_tx_mailbox_count;
+    _tx_scheduler.lock_shared_resources     = _config->lock_shared_resources;
+    _tx_scheduler.unlock_shared_resources   = _config->unlock_shared_resources;
+
+}
+#endif
+
 // ---- Public API ----
 
     /**
@@ -266,7 +447,13 @@ static void _build_main_statemachine(void) {
      * -# Build all 7 internal interface structs from user config and library functions.
      * -# Initialize all CAN modules in dependency order:
      *    RxMessageHandler, RxStatemachine, TxMessageHandler, TxStatemachine,
-     *    LoginMessageHandler, LoginStateMachine, MainStatemachine, InternalNodeAliasTable.
+     *    LoginMessageHandler, LoginStateMachine, MainStatemachine, InternalNodeAliasTable,
+     *    CanAliasPool when USER_DEFINED_ALIAS_POOL_DEPTH > 0, RemoteAliasCache
+     *    when USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH > 0, CanAcceptanceFilter
+     *    when USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 0, CanBusMonitor
+     *    when USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0, and CanTxScheduler
+     *    when USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0.  The scheduler only sits in
+     *    the TX path when config->get_free_tx_mailbox_count is set.
      *
      * @verbatim
      * @param config  Pointer to @ref can_config_t configuration. Must remain
@@ -293,6 +480,18 @@ void CanConfig_initialize(const can_config_t *config) {
     _build_tx_message_handler();
     _build_tx_statemachine();
     _build_main_statemachine();
+#if USER_DEFINED_ALIAS_POOL_DEPTH > 0
+    _build_alias_pool();
+#endif
+#if USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 0
+    _build_acceptance_filter();
+#endif
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0
+    _build_bus_monitor();
+#endif
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+    _build_tx_scheduler();
+#endif
 
     // 3. Initialize modules in dependency order
     CanRxMessageHandler_initialize(&_rx_msg);
@@ -307,6 +506,26 @@ void CanConfig_initialize(const can_config_t *config) {
 
     InternalNodeAliasTable_initialize();
 
+#if USER_DEFINED_ALIAS_POOL_DEPTH > 0
+    CanAliasPool_initialize(&_alias_pool);
+#endif
+
+#if USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH > 0
+    RemoteAliasCache_initialize();
+#endif
+
+#if USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 0
+    CanAcceptanceFilter_initialize(&_acceptance_filter);
+#endif
+
+#if USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0
+    CanBusMonitor_initialize(&_bus_monitor);
+#endif
+
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+    CanTxScheduler_initialize(&_tx_scheduler);
+#endif
+
 #ifdef OPENLCB_COMPILE_TRAIN
     AliasMappingListener_initialize();
 #endif
@@ -65,11 +65,13 @@ extern "C" {
      * static const can_config_t can_config = {
      *     .transmit_raw_can_frame  = &MyCanDriver_transmit,
      *     .is_tx_buffer_clear      = &MyCanDriver_is_tx_clear,
+     *     .get_free_tx_mailbox_count = &MyCanDriver_free_mailboxes, // optional
      *     .lock_shared_resources   = &MyDriver_lock,
      *     .unlock_shared_resources = &MyDriver_unlock,
      *     .on_rx                   = &my_can_rx_handler,   // optional
      *     .on_tx                   = &my_can_tx_handler,   // optional
      *     .on_alias_change         = &my_alias_handler,    // optional
+     *     .on_acceptance_filters_changed = &my_program_filters, // optional
      * };
      *
      * CanConfig_initialize(&can_config);
@@ -83,6 +85,13 @@ extern "C" {
         /** @brief Check if CAN TX hardware buffer can accept another frame. REQUIRED. */
         bool (*is_tx_buffer_clear)(void);
 
+        /** @brief Number of free CAN TX mailboxes.  Optional; when set and
+         *  USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0, frames go through the TX priority
+         *  scheduler.  The driver's TX-complete interrupt should call
+         *  CanTxScheduler_on_tx_complete(); without it a mailbox is only
+         *  refilled for an alias once every mailbox is empty. */
+        uint16_t (*get_free_tx_mailbox_count)(void);
+
         /** @brief Disable interrupts / acquire mutex for shared resource access. REQUIRED.
          *  Same function as openlcb_config_t.lock_shared_resources. */
         void (*lock_shared_resources)(void);
@@ -100,6 +109,12 @@ extern "C" {
         /** @brief Called when a node's CAN alias changes. Optional. */
         void (*on_alias_change)(uint16_t alias, node_id_t node_id);
 
+        /** @brief Called with a new set of hardware acceptance filters whenever a local
+         *  alias changes.  Program the controller from filters[0..count-1]; a frame
+         *  must pass if (id & mask) matches any one.  Optional; only used when
+         *  USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 0. */
+        void (*on_acceptance_filters_changed)(const can_acceptance_filter_t *filters, uint16_t count);
+
     } can_config_t;
 
         /**
@@ -44,6 +44,8 @@
 #include "can_types.h"
 #include "can_utilities.h"
 
+    /** @brief Alias reservation window between CID4 and RID, in milliseconds. */
+#define CAN_LOGIN_RESERVE_WAIT_MS 200
 
 /** @brief Saved pointer to the dependency-injected login message handler interface. */
 static interface_can_login_message_handler_t *_interface;
@@ -62,54 +64,45 @@ void CanLoginMessageHandler_initialize(const interface_can_login_message_handler
 }
 
     /**
-     * @brief Advances a 48-bit seed one step using the OpenLCB LFSR algorithm.
+     * @brief Takes a pre-reserved alias from the alias pool, if one is wired and ready.
      *
-     * @details Splits the seed into two 24-bit halves (lfsr1 = upper, lfsr2 = lower),
-     * applies shift-and-add with magic constants 0x1B0CA3 and 0x7A4BA9 per TN §6.1.3,
-     * then recombines. Ensures a different alias is produced on each conflict retry.
+     * @details On success the node skips CID/wait/RID entirely and jumps to
+     * LOAD_ALIAS_MAP_DEFINITION, since the pool has already defended the alias
+     * for at least 200 ms.
      *
-     * @param start_seed Current 48-bit seed.
-     *
-     * @return New 48-bit seed.
+     * @verbatim
+     * @param can_statemachine_info State machine context.
+     * @endverbatim
      *
-     * @see CanLoginMessageHandler_state_generate_seed
+     * @return true if an alias was claimed.
      */
-static uint64_t _generate_seed(uint64_t start_seed) {
+static bool _try_claim_pooled_alias(can_statemachine_info_t *can_statemachine_info) {
 
-    uint32_t lfsr2 = start_seed & 0xFFFFFF;         // lower 24 bits
-    uint32_t lfsr1 = (start_seed >> 24) & 0xFFFFFF; // upper 24 bits
+    if (!_interface->alias_pool_claim) {
 
-    uint32_t temp1 = ((lfsr1 << 9) | ((lfsr2 >> 15) & 0x1FF)) & 0xFFFFFF;
-    uint32_t temp2 = (lfsr2 << 9) & 0xFFFFFF;
+        return false;
 
-    lfsr1 = lfsr1 + temp1 + 0x1B0CA3L;
-    lfsr2 = lfsr2 + temp2 + 0x7A4BA9L;
+    }
 
-    lfsr1 = (lfsr1 & 0xFFFFFF) + ((lfsr2 & 0xFF000000) >> 24);
-    lfsr2 = lfsr2 & 0xFFFFFF;
+    uint16_t alias = _interface->alias_pool_claim(can_statemachine_info->openlcb_node->id);
 
-    return ( (uint64_t) lfsr1 << 24) | lfsr2;
+    if (alias == 0) {
 
-}
+        return false;
 
-    /**
-     * @brief Extracts a 12-bit alias from a 48-bit seed.
-     *
-     * @details XORs the two 24-bit halves of the seed and their upper 12 bits,
-     * then masks to 12 bits. Returns 0x000-0xFFF; alias 0x000 is invalid per spec.
-     *
-     * @param seed 48-bit seed value.
-     *
-     * @return 12-bit alias (0x000-0xFFF).
-     *
-     * @see CanLoginMessageHandler_state_generate_alias
-     */
-static uint16_t _generate_alias(uint64_t seed) {
+    }
+
+    can_statemachine_info->openlcb_node->alias = alias;
+
+    if (_interface->on_alias_change) {
 
-    uint32_t lfsr2 = seed & 0xFFFFFF;
-    uint32_t lfsr1 = (seed >> 24) & 0xFFFFFF;
+        _interface->on_alias_change(alias, can_statemachine_info->openlcb_node->id);
 
-    return ( lfsr1 ^ lfsr2 ^ (lfsr1 >> 12) ^ (lfsr2 >> 12)) & 0x0FFF;
+    }
+
+    can_statemachine_info->openlcb_node->state.run_state = RUNSTATE_LOAD_ALIAS_MAP_DEFINITION;
+
+    return true;
 
 }
 
@@ -119,6 +112,8 @@ static uint16_t _generate_alias(uint64_t seed) {
      * @details On first login the Node ID itself is the initial seed, so GENERATE_SEED
      * (which advances the PRNG one step) is skipped. GENERATE_SEED is only entered on
      * alias conflict retry, when _reset_node() sets run_state back to RUNSTATE_GENERATE_SEED.
+     * If the alias pool has a reserved alias ready, the node claims it and goes
+     * straight to LOAD_ALIAS_MAP_DEFINITION instead.
      *
      * @verbatim
      * @param can_statemachine_info State machine context.
@@ -127,14 +122,28 @@ static uint16_t _generate_alias(uint64_t seed) {
 void CanLoginMessageHandler_state_init(can_statemachine_info_t *can_statemachine_info) {
 
     can_statemachine_info->openlcb_node->seed = can_statemachine_info->openlcb_node->id;
+
+    if (_try_claim_pooled_alias(can_statemachine_info)) {
+
+        return;
+
+    }
+
     can_statemachine_info->openlcb_node->state.run_state = RUNSTATE_GENERATE_ALIAS; // Skip GENERATE_SEED — only used on alias conflict retry
 
 }
 
-    /** @brief State 2: Advances the seed one LFSR step, then transitions to GENERATE_ALIAS. */
+    /** @brief State 2: Advances the seed one LFSR step, then transitions to GENERATE_ALIAS (or claims a pooled alias). */
 void CanLoginMessageHandler_state_generate_seed(can_statemachine_info_t *can_statemachine_info) {
 
-    can_statemachine_info->openlcb_node->seed = _generate_seed(can_statemachine_info->openlcb_node->seed);
+    can_statemachine_info->openlcb_node->seed = CanUtilities_generate_seed(can_statemachine_info->openlcb_node->seed);
+
+    if (_try_claim_pooled_alias(can_statemachine_info)) {
+
+        return;
+
+    }
+
     can_statemachine_info->openlcb_node->state.run_state = RUNSTATE_GENERATE_ALIAS;
 
 }
@@ -153,12 +162,12 @@ void CanLoginMessageHandler_state_generate_seed(can_statemachine_info_t *can_sta
      */
 void CanLoginMessageHandler_state_generate_alias(can_statemachine_info_t *can_statemachine_info) {
 
-    can_statemachine_info->openlcb_node->alias = _generate_alias(can_statemachine_info->openlcb_node->seed);
+    can_statemachine_info->openlcb_node->alias = CanUtilities_generate_alias(can_statemachine_info->openlcb_node->seed);
 
     while ((can_statemachine_info->openlcb_node->alias == 0) || (_interface->alias_mapping_find_mapping_by_alias(can_statemachine_info->openlcb_node->alias) != (void*) 0)) {
 
-        can_statemachine_info->openlcb_node->seed = _generate_seed(can_statemachine_info->openlcb_node->seed);
-        can_statemachine_info->openlcb_node->alias = _generate_alias(can_statemachine_info->openlcb_node->seed);
+        can_statemachine_info->openlcb_node->seed = CanUtilities_generate_seed(can_statemachine_info->openlcb_node->seed);
+        can_statemachine_info->openlcb_node->alias = CanUtilities_generate_alias(can_statemachine_info->openlcb_node->seed);
 
     }
 
@@ -207,25 +216,50 @@ void CanLoginMessageHandler_state_load_cid05(can_statemachine_info_t *can_statem
 
 }
 
-    /** @brief State 7: Loads a CID4 frame (Node ID bits 11-0) and snapshots current_tick for the 200 ms wait. */
+    /**
+     * @brief State 7: Loads a CID4 frame (Node ID bits 11-0) and snapshots the clock for the 200 ms wait.
+     *
+     * @details The CAN main state machine restamps timerticks / timer_ms when
+     * the frame is actually transmitted, so a busy transmitter cannot shorten
+     * the window.
+     */
 void CanLoginMessageHandler_state_load_cid04(can_statemachine_info_t *can_statemachine_info) {
 
     can_statemachine_info->login_outgoing_can_msg->payload_count = 0;
     can_statemachine_info->login_outgoing_can_msg->identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_CID4 | (((can_statemachine_info->openlcb_node->id << 12) & 0xFFF000) | can_statemachine_info->openlcb_node->alias);
     can_statemachine_info->openlcb_node->timerticks = can_statemachine_info->current_tick;
+    can_statemachine_info->openlcb_node->timer_ms = can_statemachine_info->current_time_ms;
     can_statemachine_info->login_outgoing_can_msg_valid = true;
 
     can_statemachine_info->openlcb_node->state.run_state = RUNSTATE_WAIT_200ms;
 
 }
 
-    /** @brief State 8: Waits until 200ms have elapsed (via elapsed-time subtraction on current_tick), then transitions to LOAD_RESERVE_ID. */
+    /**
+     * @brief State 8: Waits until more than 200ms have elapsed, then transitions to LOAD_RESERVE_ID.
+     *
+     * @details With use_time_ms the wait is measured on the millisecond clock
+     * and ends 201 ms after CID4 left (or one 100 ms clock step later when the
+     * clock is built from the tick).  Otherwise it is measured in 100ms ticks
+     * and needs 3 of them, since the first may be partial.
+     */
 void CanLoginMessageHandler_state_wait_200ms(can_statemachine_info_t *can_statemachine_info) {
 
-    uint8_t elapsed = (uint8_t)(can_statemachine_info->current_tick
-            - (uint8_t) can_statemachine_info->openlcb_node->timerticks);
+    bool expired;
+
+    if (can_statemachine_info->use_time_ms) {
+
+        expired = (uint32_t) (can_statemachine_info->current_time_ms
+                - can_statemachine_info->openlcb_node->timer_ms) > CAN_LOGIN_RESERVE_WAIT_MS;
+
+    } else {
+
+        expired = (uint8_t) (can_statemachine_info->current_tick
+                - (uint8_t) can_statemachine_info->openlcb_node->timerticks) > 2;
+
+    }
 
-    if (elapsed > 2) {
+    if (expired) {
 
         can_statemachine_info->openlcb_node->state.run_state = RUNSTATE_LOAD_RESERVE_ID;
 
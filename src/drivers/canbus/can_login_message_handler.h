@@ -44,7 +44,8 @@
      * @brief Dependency-injection interface for the CAN login message handler.
      *
      * @details Provides alias-mapping callbacks required by the login sequence.
-     * All function pointers are REQUIRED (must not be NULL) except on_alias_change.
+     * All function pointers are REQUIRED (must not be NULL) except on_alias_change
+     * and alias_pool_claim.
      *
      * @see CanLoginMessageHandler_initialize
      */
@@ -59,6 +60,9 @@ typedef struct {
         /** @brief OPTIONAL. Called when an alias is successfully registered. May be NULL. */
     void (*on_alias_change)(uint16_t alias, node_id_t node_id);
 
+        /** @brief OPTIONAL. Claim a pre-reserved alias for node_id, returning 0 if none is ready. Typical impl: CanAliasPool_claim. May be NULL. */
+    uint16_t (*alias_pool_claim)(node_id_t node_id);
+
 } interface_can_login_message_handler_t;
 
 
@@ -227,6 +227,8 @@ void initialize_statemachine_info(can_statemachine_info_t *info)
     info->openlcb_node->alias = ALIAS;
     
     info->current_tick = 0;
+    info->current_time_ms = 0;
+    info->use_time_ms = false;
     info->enumerating = false;
     info->login_outgoing_can_msg_valid = false;
     
@@ -569,6 +571,38 @@ TEST(CanLoginMessageHandler, wait_200ms)
     EXPECT_FALSE(info.openlcb_node->state.initialized);
 }
 
+/**
+ * Test: 200ms wait on the millisecond clock
+ * Verifies that with use_time_ms the wait ends once more than 200 ms have
+ * passed since CID4, independent of the 100 ms tick, including across the
+ * 32-bit clock wrap
+ */
+TEST(CanLoginMessageHandler, wait_200ms_time_ms)
+{
+    can_statemachine_info_t info;
+
+    setup_test(&interface_can_login_message_handler);
+    reset_test_variables();
+    initialize_statemachine_info(&info);
+
+    info.use_time_ms = true;
+    info.openlcb_node->state.run_state = RUNSTATE_WAIT_200ms;
+    info.openlcb_node->timer_ms = 0xFFFFFFFFUL - 49;  // CID4 sent 50 ms before the wrap
+    info.openlcb_node->timerticks = 0;
+
+    // Tick has moved on by 3 but only 200 ms have passed
+    info.current_tick = 3;
+    info.current_time_ms = 150;
+    CanLoginMessageHandler_state_wait_200ms(&info);
+    EXPECT_EQ(info.openlcb_node->state.run_state, RUNSTATE_WAIT_200ms);
+
+    // 201 ms - should transition
+    info.current_time_ms = 151;
+    CanLoginMessageHandler_state_wait_200ms(&info);
+    EXPECT_EQ(info.openlcb_node->state.run_state, RUNSTATE_LOAD_RESERVE_ID);
+    EXPECT_FALSE(info.openlcb_node->state.permitted);
+}
+
 /*******************************************************************************
  * Alias Reservation Tests
  ******************************************************************************/
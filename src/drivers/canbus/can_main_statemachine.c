@@ -90,14 +90,17 @@ void CanMainStatemachine_initialize(const interface_can_main_statemachine_t *int
     _can_statemachine_info.login_outgoing_can_msg_valid = false;
     _can_statemachine_info.enumerating = false;
     _can_statemachine_info.outgoing_can_msg = NULL;
+    _can_statemachine_info.use_time_ms = (_interface->get_time_ms != NULL);
 
 }
 
     /**
      * @brief Resets a node to force it through alias reallocation from GENERATE_SEED.
      *
-     * @details Clears alias, all state flags, frees any pending datagram, and sets
-     * run_state to RUNSTATE_GENERATE_SEED. Safe to call with NULL.
+     * @details Clears alias, all state flags, and sets run_state to
+     * RUNSTATE_GENERATE_SEED. Safe to call with NULL.  Outstanding datagrams
+     * are left for the caller to release through the datagram handler once
+     * the shared-resource lock has been dropped.
      *
      * @verbatim
      * @param openlcb_node Node to reset. NULL is safely ignored.
@@ -118,15 +121,7 @@ static void _reset_node(openlcb_node_t *openlcb_node) {
     openlcb_node->state.initialized = false;
     openlcb_node->state.duplicate_id_detected = false;
     openlcb_node->state.firmware_upgrade_active = false;
-    openlcb_node->state.resend_datagram = false;
     openlcb_node->state.openlcb_datagram_ack_sent = false;
-    if (openlcb_node->last_received_datagram) {
-
-        OpenLcbBufferStore_free_buffer(openlcb_node->last_received_datagram);
-        openlcb_node->last_received_datagram = NULL;
-
-    }
-
     openlcb_node->state.run_state = RUNSTATE_GENERATE_SEED; // Re-log in with a new generated Alias
 
 }
@@ -136,19 +131,21 @@ static void _reset_node(openlcb_node_t *openlcb_node) {
      *
      * @details Algorithm:
      * -# Iterate all ALIAS_MAPPING_BUFFER_DEPTH entries; for each with is_duplicate set:
-     *    unregister the alias, find the owning node, call _reset_node().
+     *    unregister the alias, find the owning node, call _reset_node() and
+     *    record the node in reset_nodes.
      * -# Clear the has_duplicate_alias flag.
-     * -# Return true if any were found.
+     * -# Return the number of nodes recorded.
      *
      * @verbatim
      * @param alias_mapping_info Pointer to the alias mapping table.
+     * @param reset_nodes        Array of ALIAS_MAPPING_BUFFER_DEPTH slots that receives each reset node.
      * @endverbatim
      *
-     * @return true if at least one duplicate was resolved, false if none.
+     * @return Number of nodes written to reset_nodes.
      */
-static bool _process_duplicate_aliases(alias_mapping_info_t *alias_mapping_info) {
+static uint16_t _process_duplicate_aliases(alias_mapping_info_t *alias_mapping_info, openlcb_node_t *reset_nodes[]) {
 
-    bool result = false;
+    uint16_t reset_count = 0;
 
     for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
 
@@ -158,9 +155,15 @@ static bool _process_duplicate_aliases(alias_mapping_info_t *alias_mapping_info)
 
             _interface->alias_mapping_unregister(alias);
 
-            _reset_node(_interface->openlcb_node_find_by_alias(alias));
+            openlcb_node_t *openlcb_node = _interface->openlcb_node_find_by_alias(alias);
+
+            if (openlcb_node) {
+
+                _reset_node(openlcb_node);
 
-            result = true;
+                reset_nodes[reset_count++] = openlcb_node;
+
+            }
 
         }
 
@@ -168,7 +171,7 @@ static bool _process_duplicate_aliases(alias_mapping_info_t *alias_mapping_info)
 
     alias_mapping_info->has_duplicate_alias = false;
 
-    return result;
+    return reset_count;
 
 }
 
@@ -183,13 +186,17 @@ can_statemachine_info_t *CanMainStatemachine_get_can_statemachine_info(void) {
      * @brief Checks for the has_duplicate_alias flag; resolves any duplicates found.
      *
      * @details Locks shared resources, reads the flag, calls _process_duplicate_aliases()
-     * if needed, then unlocks.
+     * if needed, then unlocks.  Each reset node's outstanding datagrams are then
+     * released through clear_resend_datagram_message outside the lock, since the
+     * datagram handler owns the retry heap and takes the lock itself.
      *
      * @return true if duplicates were found and processed, false if none.
      */
 bool CanMainStatemachine_handle_duplicate_aliases(void) {
 
     bool result = false;
+    openlcb_node_t *reset_nodes[ALIAS_MAPPING_BUFFER_DEPTH];
+    uint16_t reset_count = 0;
 
     _interface->lock_shared_resources();
 
@@ -197,7 +204,7 @@ bool CanMainStatemachine_handle_duplicate_aliases(void) {
 
     if (alias_mapping_info->has_duplicate_alias) {
 
-        _process_duplicate_aliases(alias_mapping_info);
+        reset_count = _process_duplicate_aliases(alias_mapping_info, reset_nodes);
 
         result = true;
 
@@ -205,6 +212,16 @@ bool CanMainStatemachine_handle_duplicate_aliases(void) {
 
     _interface->unlock_shared_resources();
 
+    if (_interface->clear_resend_datagram_message) {
+
+        for (int i = 0; i < reset_count; i++) {
+
+            _interface->clear_resend_datagram_message(reset_nodes[i]);
+
+        }
+
+    }
+
     return result;
 
 }
@@ -214,7 +231,8 @@ bool CanMainStatemachine_handle_duplicate_aliases(void) {
      *
      * @details Algorithm:
      * -# If no frame is held in the working slot, pop one from the FIFO (under lock).
-     * -# If a frame is held, try to send it; free it (under lock) only on success.
+     * -# If a frame is held, try to send it; on success tell the alias pool (a
+     *    pooled CID4 starts its 200 ms window now) and free it (under lock).
      * -# Return true if a frame was pending (sent or not), false if FIFO was empty.
      *
      * @return true if a frame was pending, false if the FIFO was empty.
@@ -235,6 +253,12 @@ bool CanMainStatemachine_handle_outgoing_can_message(void) {
 
         if (_interface->send_can_message(_can_statemachine_info.outgoing_can_msg)) {
 
+            if (_interface->alias_pool_frame_transmitted) {
+
+                _interface->alias_pool_frame_transmitted(_can_statemachine_info.outgoing_can_msg);
+
+            }
+
             _interface->lock_shared_resources();
             CanBufferStore_free_buffer(_can_statemachine_info.outgoing_can_msg);
             _interface->unlock_shared_resources();
@@ -249,13 +273,96 @@ bool CanMainStatemachine_handle_outgoing_can_message(void) {
 
     return false;
 
+}
+
+    /**
+     * @brief Returns true if the run_state loads the next frame of a back-to-back login burst.
+     *
+     * @details CID7..CID4 carry no timing requirement between them and AMD must
+     * follow RID immediately, so these states are advanced as soon as the
+     * previous login frame has left instead of waiting for the next enumeration pass.
+     *
+     * @verbatim
+     * @param run_state Node run_state to test.
+     * @endverbatim
+     *
+     * @return true for LOAD_CHECK_ID_06/05/04 and LOAD_ALIAS_MAP_DEFINITION.
+     */
+static bool _is_login_burst_state(uint8_t run_state) {
+
+    switch (run_state) {
+
+        case RUNSTATE_LOAD_CHECK_ID_06:
+        case RUNSTATE_LOAD_CHECK_ID_05:
+        case RUNSTATE_LOAD_CHECK_ID_04:
+        case RUNSTATE_LOAD_ALIAS_MAP_DEFINITION:
+
+            return true;
+
+        default:
+
+            return false;
+
+    }
+
+}
+
+    /**
+     * @brief Runs the login state machine for the current node until it loads a frame or must wait.
+     *
+     * @details Algorithm:
+     * -# Snapshot the current tick (and the millisecond clock when wired) into
+     *    the context.
+     * -# Run one login state; repeat while no frame was loaded, the state actually
+     *    advanced, and the node is still logging in.
+     *
+     * States that only compute (INIT, GENERATE_SEED, GENERATE_ALIAS, an expired
+     * WAIT_200ms) therefore no longer cost a full enumeration pass each.  A
+     * WAIT_200ms that has not expired leaves run_state unchanged and ends the loop.
+     */
+static void _run_login_statemachine(void) {
+
+    openlcb_node_t *openlcb_node = _can_statemachine_info.openlcb_node;
+    uint8_t previous_run_state;
+
+    _can_statemachine_info.current_tick = _interface->get_current_tick();
+
+    if (_can_statemachine_info.use_time_ms) {
+
+        _can_statemachine_info.current_time_ms = _interface->get_time_ms();
+
+    }
+
+    do {
+
+        previous_run_state = openlcb_node->state.run_state;
+
+        _interface->login_statemachine_run(&_can_statemachine_info);
+
+    } while (!_can_statemachine_info.login_outgoing_can_msg_valid &&
+            (openlcb_node->state.run_state != previous_run_state) &&
+            (openlcb_node->state.run_state < RUNSTATE_LOAD_INITIALIZATION_COMPLETE));
+
 }
 
     /**
      * @brief Transmits the pending login frame (CID/RID/AMD) if one is flagged as valid.
      *
-     * @details Clears login_outgoing_can_msg_valid only after successful transmission.
-     * Returns true if a login frame was pending (sent or retried), false if none.
+     * @details Algorithm:
+     * -# If no login frame is pending, return false.
+     * -# Try to send it; on failure return true and retry next call.
+     * -# On success clear the valid flag, then for the owning node:
+     *    - if it just sent CID4 (now in WAIT_200ms), restart its reservation window
+     *      from this tick so the 200 ms is measured from when the frame left, not
+     *      from when it was loaded;
+     *    - if it is in the middle of a CID or RID/AMD burst, load its next frame now.
+     * -# Return true.
+     *
+     * Every pending node therefore sends CID7..CID4 back to back and the enumerator
+     * moves straight on to the next node, so all reservation windows open within a
+     * few frame times of each other and expire together.
+     *
+     * @return true if a login frame was pending (sent or retried), false if none.
      */
 bool CanMainStatemachine_handle_login_outgoing_can_message(void) {
 
@@ -265,6 +372,28 @@ bool CanMainStatemachine_handle_login_outgoing_can_message(void) {
 
             _can_statemachine_info.login_outgoing_can_msg_valid = false;
 
+            openlcb_node_t *openlcb_node = _can_statemachine_info.openlcb_node;
+
+            if (openlcb_node) {
+
+                if (openlcb_node->state.run_state == RUNSTATE_WAIT_200ms) {
+
+                    openlcb_node->timerticks = _interface->get_current_tick();
+
+                    if (_can_statemachine_info.use_time_ms) {
+
+                        openlcb_node->timer_ms = _interface->get_time_ms();
+
+                    }
+
+                } else if (_is_login_burst_state(openlcb_node->state.run_state)) {
+
+                    _run_login_statemachine();
+
+                }
+
+            }
+
         }
 
         return true; // done for this loop, try again next time
@@ -300,8 +429,7 @@ bool CanMainStatemachine_handle_try_enumerate_first_node(void) {
 
         if (_can_statemachine_info.openlcb_node->state.run_state < RUNSTATE_LOAD_INITIALIZATION_COMPLETE) {
 
-            _can_statemachine_info.current_tick = _interface->get_current_tick();
-            _interface->login_statemachine_run(&_can_statemachine_info);
+            _run_login_statemachine();
 
         }
 
@@ -314,33 +442,107 @@ bool CanMainStatemachine_handle_try_enumerate_first_node(void) {
 }
 
     /**
-     * @brief Advances node enumeration to the next node.
+     * @brief Advances node enumeration to the next node that produces a login frame.
      *
-     * @details Fetches the next node and runs its login state machine if still logging in.
-     * Returns true when there are no more nodes (enumeration complete), false otherwise.
+     * @details Algorithm:
+     * -# Fetch the next node; return true when the list is exhausted.
+     * -# Skip nodes that have finished CAN login.
+     * -# Run the login state machine for a logging-in node; return false as soon as
+     *    it loads a frame so the frame is sent on the next call.
+     * -# Otherwise (node is waiting out its reservation window) keep going.
+     *
+     * One call therefore covers every idle or waiting node, so a large population of
+     * already-permitted nodes does not stretch a pending node's login.
      *
      * @return true when all nodes have been processed, false if more nodes remain.
      */
 bool CanMainStatemachine_handle_try_enumerate_next_node(void) {
 
-    _can_statemachine_info.openlcb_node = _interface->openlcb_node_get_next(CAN_STATEMACHINE_NODE_ENUMRATOR_KEY);
+    while (true) {
 
-    if (!_can_statemachine_info.openlcb_node) {
+        _can_statemachine_info.openlcb_node = _interface->openlcb_node_get_next(CAN_STATEMACHINE_NODE_ENUMRATOR_KEY);
 
-        return true; // done, nothing to do
+        if (!_can_statemachine_info.openlcb_node) {
+
+            return true; // done, nothing to do
+
+        }
+
+        // Need to make sure the correct state-machine is run depending of if the Node had finished the login process
+
+        if (_can_statemachine_info.openlcb_node->state.run_state < RUNSTATE_LOAD_INITIALIZATION_COMPLETE) {
+
+            _run_login_statemachine();
+
+            if (_can_statemachine_info.login_outgoing_can_msg_valid) {
+
+                return false;
+
+            }
+
+        }
 
     }
 
-    // Need to make sure the correct state-machine is run depending of if the Node had finished the login process
+}
+
+    /**
+     * @brief Queues AMDs for every local alias and one global AME.
+     *
+     * @details Algorithm:
+     * -# For each permitted local alias: set its listener entry (local virtual
+     *    nodes never see their own AMDs on the wire) and queue an AMD
+     * -# Queue the global AME (triggers AMD responses from external nodes)
+     *
+     * @warning Locks shared resources during CAN buffer allocation and FIFO push.
+     */
+static void _queue_local_amds_and_global_ame(void) {
 
-    if (_can_statemachine_info.openlcb_node->state.run_state < RUNSTATE_LOAD_INITIALIZATION_COMPLETE) {
+    alias_mapping_info_t *alias_mapping_info =
+            _interface->alias_mapping_get_alias_mapping_info();
 
-        _can_statemachine_info.current_tick = _interface->get_current_tick();
-        _interface->login_statemachine_run(&_can_statemachine_info);
+    _interface->lock_shared_resources();
+
+    for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
+
+        if (alias_mapping_info->list[i].alias != 0x00 &&
+                alias_mapping_info->list[i].is_permitted) {
+
+            // Repopulate listener table for local virtual nodes immediately.
+            // Their aliases are already known — no need to wait for AMD off the wire.
+            if (_interface->listener_set_alias) {
+
+                _interface->listener_set_alias(alias_mapping_info->list[i].node_id, alias_mapping_info->list[i].alias);
+
+            }
+
+            // Send AMD for this local alias (external nodes need it)
+            can_msg_t *outgoing_can_msg = CanBufferStore_allocate_buffer();
+
+            if (outgoing_can_msg) {
+
+                outgoing_can_msg->identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AMD | alias_mapping_info->list[i].alias;
+                CanUtilities_copy_node_id_to_payload(outgoing_can_msg, alias_mapping_info->list[i].node_id, 0);
+                CanBufferFifo_push(outgoing_can_msg);
+
+            }
+
+        }
 
     }
 
-    return false;
+    // Queue the global AME (triggers AMD responses from external nodes)
+    can_msg_t *ame_msg = CanBufferStore_allocate_buffer();
+
+    if (ame_msg) {
+
+        ame_msg->identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AME;
+        ame_msg->payload_count = 0;
+        CanBufferFifo_push(ame_msg);
+
+    }
+
+    _interface->unlock_shared_resources();
 
 }
 
@@ -349,6 +551,8 @@ bool CanMainStatemachine_handle_try_enumerate_next_node(void) {
      *
      * @details Algorithm:
      * -# Call _interface->listener_check_one_verification() with current tick
+     * -# If the listener table started a bulk round (listener_take_bulk_enquiry),
+     *    queue local AMDs and one global AME without flushing, return true
      * -# If non-zero node_id returned: get first node's alias, allocate a CAN
      *    buffer (with lock/unlock), build targeted AME, push to CAN FIFO
      *    (with lock/unlock)
@@ -356,7 +560,7 @@ bool CanMainStatemachine_handle_try_enumerate_next_node(void) {
      *
      * No-ops if listener_check_one_verification is NULL (train support not wired).
      *
-     * @return true if a probe AME was queued, false if nothing to do.
+     * @return true if a probe or global AME was queued, false if nothing to do.
      */
 bool CanMainStatemachine_handle_listener_verification(void) {
 
@@ -369,6 +573,15 @@ bool CanMainStatemachine_handle_listener_verification(void) {
     node_id_t probe_id =
             _interface->listener_check_one_verification(_interface->get_current_tick());
 
+    if (_interface->listener_take_bulk_enquiry && _interface->listener_take_bulk_enquiry()) {
+
+        // Listener entries stay resolved; AMD replies clear their pending flag
+        _queue_local_amds_and_global_ame();
+
+        return true;
+
+    }
+
     if (probe_id != 0) {
 
         // Use first node's alias as AME source
@@ -426,68 +639,49 @@ void CanMainStatemachine_send_global_alias_enquiry(void) {
 
     }
 
-    // Step 2: repopulate local virtual node entries + queue AMDs
-    alias_mapping_info_t *alias_mapping_info =
-            _interface->alias_mapping_get_alias_mapping_info();
-
-    _interface->lock_shared_resources();
-
-    for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
-
-        if (alias_mapping_info->list[i].alias != 0x00 &&
-                alias_mapping_info->list[i].is_permitted) {
-
-            // Repopulate listener table for local virtual nodes immediately.
-            // Their aliases are already known — no need to wait for AMD off the wire.
-            if (_interface->listener_set_alias) {
-
-                _interface->listener_set_alias(alias_mapping_info->list[i].node_id, alias_mapping_info->list[i].alias);
+    // Steps 2 and 3: repopulate local entries, queue AMDs and the global AME
+    _queue_local_amds_and_global_ame();
 
-            }
+}
 
-            // Send AMD for this local alias (external nodes need it)
-            can_msg_t *outgoing_can_msg = CanBufferStore_allocate_buffer();
+    /**
+     * @brief Executes one cooperative iteration of the main CAN state machine.
+     *
+     * @details Calls each handler in priority order, returning after the first one
+     * that does work. Bus monitor, TX scheduler refill, acceptance filter refresh and
+     * listener verification (if wired) run unconditionally before the priority chain. Priority: duplicate aliases -> outgoing CAN frame ->
+     * login frame -> alias pool (if wired) -> enumerate first node ->
+     * enumerate next node.
+     */
+void CanMainStatemachine_run(void) {
 
-            if (outgoing_can_msg) {
+    _interface->lock_shared_resources();
+    OpenLcbBufferList_check_timeouts(_interface->get_current_tick());
+    _interface->unlock_shared_resources();
 
-                outgoing_can_msg->identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AMD | alias_mapping_info->list[i].alias;
-                CanUtilities_copy_node_id_to_payload(outgoing_can_msg, alias_mapping_info->list[i].node_id, 0);
-                CanBufferFifo_push(outgoing_can_msg);
+    // Unconditional — a tick compare unless a 100 ms window has ended, so the
+    // utilisation figure and congestion flag stay current.
+    if (_interface->handle_bus_monitor) {
 
-            }
-
-        }
+        _interface->handle_bus_monitor();
 
     }
 
-    // Step 3: queue the global AME (triggers AMD responses from external nodes)
-    can_msg_t *ame_msg = CanBufferStore_allocate_buffer();
-
-    if (ame_msg) {
+    // Unconditional — refills TX mailboxes for drivers without a TX-complete
+    // interrupt; returns at once when the queue is empty.
+    if (_interface->handle_tx_scheduler) {
 
-        ame_msg->identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AME;
-        ame_msg->payload_count = 0;
-        CanBufferFifo_push(ame_msg);
+        _interface->handle_tx_scheduler();
 
     }
 
-    _interface->unlock_shared_resources();
+    // Unconditional — a counter compare unless an alias changed since the
+    // last call, so the hardware filters follow logins and releases promptly.
+    if (_interface->handle_acceptance_filters) {
 
-}
+        _interface->handle_acceptance_filters();
 
-    /**
-     * @brief Executes one cooperative iteration of the main CAN state machine.
-     *
-     * @details Calls each handler in priority order, returning after the first one
-     * that does work. Listener verification runs unconditionally before the priority
-     * chain. Priority: duplicate aliases -> outgoing CAN frame ->
-     * login frame -> enumerate first node -> enumerate next node.
-     */
-void CanMainStatemachine_run(void) {
-
-    _interface->lock_shared_resources();
-    OpenLcbBufferList_check_timeouts(_interface->get_current_tick());
-    _interface->unlock_shared_resources();
+    }
 
     // Unconditional — runs every call so rate-limiting and stale timeouts
     // advance reliably regardless of outgoing message traffic.
@@ -515,6 +709,12 @@ void CanMainStatemachine_run(void) {
 
     }
 
+    if (_interface->handle_alias_pool && _interface->handle_alias_pool()) {
+
+        return;
+
+    }
+
     if (_interface->handle_try_enumerate_first_node()) {
 
         return;
@@ -86,6 +86,9 @@ extern "C" {
         /** @brief REQUIRED. Return the current value of the global 100ms tick counter. Typical: OpenLcbConfig_get_global_100ms_tick. */
         uint8_t (*get_current_tick)(void);
 
+        /** @brief OPTIONAL. Millisecond clock for the 200 ms login wait (NULL = time it in 100 ms ticks). Typical: OpenLcbConfig_get_time_ms. */
+        uint32_t (*get_time_ms)(void);
+
         /** @brief REQUIRED. Scan and resolve all duplicate aliases. Typical: CanMainStatemachine_handle_duplicate_aliases. */
         bool (*handle_duplicate_aliases)(void);
 
@@ -101,18 +104,39 @@ extern "C" {
         /** @brief REQUIRED. Continue enumeration to the next node. Typical: CanMainStatemachine_handle_try_enumerate_next_node. */
         bool (*handle_try_enumerate_next_node)(void);
 
+        /** @brief OPTIONAL. Advance the pre-reserved alias pool one step. NULL if the pool is disabled. Typical: CanAliasPool_run. */
+        bool (*handle_alias_pool)(void);
+
+        /** @brief OPTIONAL. Told about each FIFO frame the driver accepted, so a pooled CID4 starts its 200 ms window. NULL if the pool is disabled. Typical: CanAliasPool_frame_transmitted. */
+        void (*alias_pool_frame_transmitted)(can_msg_t *can_msg);
+
+        /** @brief OPTIONAL. Rebuild hardware acceptance filters if an alias changed. NULL if unused. Typical: CanAcceptanceFilter_run. */
+        bool (*handle_acceptance_filters)(void);
+
+        /** @brief OPTIONAL. Close the bus-load window when the tick moves. NULL if the monitor is disabled. Typical: CanBusMonitor_run. */
+        bool (*handle_bus_monitor)(void);
+
+        /** @brief OPTIONAL. Load free TX mailboxes from the priority queue. NULL if the scheduler is disabled. Typical: CanTxScheduler_run. */
+        bool (*handle_tx_scheduler)(void);
+
         /** @brief OPTIONAL. Probe one listener alias for staleness. NULL if unused. Typical: CanMainStatemachine_handle_listener_verification. */
         bool (*handle_listener_verification)(void);
 
         /** @brief OPTIONAL. Check one listener entry for alias staleness (round-robin). NULL if train support not compiled. Typical: AliasMappingListener_check_one_verification. */
         node_id_t (*listener_check_one_verification)(uint8_t current_tick);
 
+        /** @brief OPTIONAL. Report and clear a bulk revalidation request (global AME). NULL if train support not compiled. Typical: AliasMappingListener_take_bulk_enquiry. */
+        bool (*listener_take_bulk_enquiry)(void);
+
         /** @brief OPTIONAL. Flush all cached listener aliases. NULL if train support not compiled. Typical: AliasMappingListener_flush_aliases. */
         void (*listener_flush_aliases)(void);
 
         /** @brief OPTIONAL. Set alias for a node_id in the listener table. NULL if train support not compiled. Typical: AliasMappingListener_set_alias. */
         void (*listener_set_alias)(node_id_t node_id, uint16_t alias);
 
+        /** @brief OPTIONAL. Unschedule and free a reset node's outstanding datagrams. NULL if datagram support not compiled. Typical: ProtocolDatagramHandler_clear_resend_datagram_message. */
+        void (*clear_resend_datagram_message)(openlcb_node_t *openlcb_node);
+
     } interface_can_main_statemachine_t;
 
 
@@ -178,6 +202,9 @@ extern "C" {
      * @brief Attempts to transmit the pending login frame (CID, RID, or AMD).
      *
      * @details Exposed for unit testing. Normally called via the interface pointer.
+     * After a successful send the same node loads its next CID (or the AMD after RID)
+     * immediately, and a node that just sent CID4 restarts its 200 ms window from the
+     * transmit tick.
      *
      * @return true if a login frame was pending (sent or not), false if nothing pending.
      *
@@ -216,6 +243,8 @@ extern "C" {
      * @brief Continues enumeration and processes the next node.
      *
      * @details Exposed for unit testing. Normally called via the interface pointer.
+     * Skips nodes that have finished CAN login or are still inside their 200 ms
+     * window, stopping at the first node that loads a login frame.
      *
      * @return true if no more nodes remain (enumeration complete), false if more nodes exist.
      *
@@ -229,8 +258,11 @@ extern "C" {
      *
      * @details Exposed for unit testing. Normally called via the interface pointer.
      * No-ops if listener_check_one_verification is NULL (train support not wired).
+     * When the listener table asks for a bulk round (listener_take_bulk_enquiry),
+     * queues AMDs for the local aliases and one global AME instead, without
+     * flushing the listener table.
      *
-     * @return true if a probe AME was queued, false if nothing to do.
+     * @return true if a probe or global AME was queued, false if nothing to do.
      *
      * @warning Locks shared resources during CAN buffer allocation and FIFO push.
      * @warning NOT thread-safe.
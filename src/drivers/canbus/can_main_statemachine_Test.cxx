@@ -97,6 +97,9 @@ bool handle_outgoing_can_message_called = false;
 bool handle_try_enumerate_first_node_called = false;
 bool handle_try_enumerate_next_node_called = false;
 bool handle_listener_verification_called = false;
+bool handle_acceptance_filters_called = false;
+bool handle_bus_monitor_called = false;
+bool handle_tx_scheduler_called = false;
 
 // Mock behavior control
 bool send_can_message_enabled = true;
@@ -331,6 +334,33 @@ bool _handle_listener_verification(void)
     return CanMainStatemachine_handle_listener_verification();
 }
 
+/**
+ * Mock: Handle acceptance filters
+ */
+bool _handle_acceptance_filters(void)
+{
+    handle_acceptance_filters_called = true;
+    return false;
+}
+
+/**
+ * Mock: Handle bus monitor
+ */
+bool _handle_bus_monitor(void)
+{
+    handle_bus_monitor_called = true;
+    return true;
+}
+
+/**
+ * Mock: Handle TX scheduler
+ */
+bool _handle_tx_scheduler(void)
+{
+    handle_tx_scheduler_called = true;
+    return true;
+}
+
 // Listener mock tracking
 bool listener_flush_called = false;
 int listener_set_alias_call_count = 0;
@@ -364,6 +394,41 @@ void _mock_listener_set_alias(node_id_t node_id, uint16_t alias)
 
 }
 
+// Datagram clear mock tracking
+int clear_resend_datagram_call_count = 0;
+bool clear_resend_datagram_called_under_lock = false;
+
+/**
+ * Mock: Clear a node's outstanding datagrams
+ * Stands in for ProtocolDatagramHandler_clear_resend_datagram_message and
+ * records whether the caller still held the shared-resource lock
+ */
+void _mock_clear_resend_datagram_message(openlcb_node_t *openlcb_node)
+{
+
+    clear_resend_datagram_call_count++;
+
+    if (!unlock_shared_resources_called) {
+
+        clear_resend_datagram_called_under_lock = true;
+
+    }
+
+    for (int i = 0; i < USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH; i++) {
+
+        if (openlcb_node->outstanding_datagrams[i].datagram) {
+
+            OpenLcbBufferStore_free_buffer(openlcb_node->outstanding_datagrams[i].datagram);
+            openlcb_node->outstanding_datagrams[i].datagram = NULL;
+
+        }
+
+    }
+
+    openlcb_node->state.resend_datagram = false;
+
+}
+
 // Interface struct with all mocks
 const interface_openlcb_node_t interface_openlcb_node = {};
 
@@ -383,10 +448,15 @@ const interface_can_main_statemachine_t interface_can_main_statemachine = {
     .handle_login_outgoing_can_message = &_handle_login_outgoing_can_message,
     .handle_try_enumerate_first_node = &_handle_try_enumerate_first_node,
     .handle_try_enumerate_next_node = &_handle_try_enumerate_next_node,
+    .handle_acceptance_filters = &_handle_acceptance_filters,
+    .handle_bus_monitor = &_handle_bus_monitor,
+    .handle_tx_scheduler = &_handle_tx_scheduler,
     .handle_listener_verification = &_handle_listener_verification,
     .listener_check_one_verification = &AliasMappingListener_check_one_verification,
+    .listener_take_bulk_enquiry = &AliasMappingListener_take_bulk_enquiry,
     .listener_flush_aliases = &_mock_listener_flush_aliases,
-    .listener_set_alias = &_mock_listener_set_alias
+    .listener_set_alias = &_mock_listener_set_alias,
+    .clear_resend_datagram_message = &_mock_clear_resend_datagram_message
 };
 
 /*******************************************************************************
@@ -400,6 +470,8 @@ void reset_test_variables(void)
 {
     lock_shared_resources_called = false;
     unlock_shared_resources_called = false;
+    clear_resend_datagram_call_count = 0;
+    clear_resend_datagram_called_under_lock = false;
     send_can_message_called = false;
     node_find_node_by_alias_called = false;
     node_get_first_called = false;
@@ -412,6 +484,9 @@ void reset_test_variables(void)
     handle_try_enumerate_first_node_called = false;
     handle_try_enumerate_next_node_called = false;
     handle_listener_verification_called = false;
+    handle_acceptance_filters_called = false;
+    handle_bus_monitor_called = false;
+    handle_tx_scheduler_called = false;
     send_can_message_enabled = true;
     node_find_node_by_alias_fail = false;
     listener_flush_called = false;
@@ -613,7 +688,7 @@ TEST(CanMainStatemachine, duplicate_alias)
     EXPECT_FALSE(node1->state.duplicate_id_detected);
     EXPECT_FALSE(node1->state.firmware_upgrade_active);
     EXPECT_FALSE(node1->state.resend_datagram);
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
     EXPECT_EQ(node1->state.run_state, RUNSTATE_GENERATE_SEED);
     
     // Test with pending datagram
@@ -625,7 +700,8 @@ TEST(CanMainStatemachine, duplicate_alias)
     node1->state.permitted = true;
     node1->state.initialized = true;
     node1->state.run_state = RUNSTATE_RUN;
-    node1->last_received_datagram = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    node1->outstanding_datagrams[0].datagram = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    node1->outstanding_datagrams[1].datagram = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
     
     alias_mapping = InternalNodeAliasTable_register(NODE_ALIAS_1, NODE_ID_1);
     alias_mapping->is_duplicate = true;
@@ -639,9 +715,14 @@ TEST(CanMainStatemachine, duplicate_alias)
     // Verify node was reset and datagram freed
     EXPECT_FALSE(node1->state.permitted);
     EXPECT_FALSE(node1->state.initialized);
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[1].datagram, nullptr);
     EXPECT_EQ(node1->state.run_state, RUNSTATE_GENERATE_SEED);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
+
+    // Datagrams are released by the datagram handler, once, outside the lock
+    EXPECT_EQ(clear_resend_datagram_call_count, 1);
+    EXPECT_FALSE(clear_resend_datagram_called_under_lock);
 }
 
 /**
@@ -678,6 +759,7 @@ TEST(CanMainStatemachine, duplicate_alias_fail_to_find_mapping)
     EXPECT_TRUE(node1->state.initialized);
     EXPECT_FALSE(node1->state.duplicate_id_detected);
     EXPECT_EQ(node1->state.run_state, RUNSTATE_RUN);
+    EXPECT_EQ(clear_resend_datagram_call_count, 0);
 }
 
 /*******************************************************************************
@@ -1310,6 +1392,51 @@ TEST(CanMainStatemachine, listener_verification_buffer_alloc_fail_returns_false)
     EXPECT_FALSE(result);
 }
 
+#if (USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD > 0) && (USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD <= LISTENER_ALIAS_TABLE_DEPTH)
+
+// ============================================================================
+// TEST: Listener verification — large table sends one global AME, no flush
+// ============================================================================
+
+TEST(CanMainStatemachine, listener_verification_bulk_queues_global_ame)
+{
+    setup_test();
+    reset_test_variables();
+
+    for (int i = 0; i < USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD; i++) {
+
+        AliasMappingListener_register(LISTENER_NODE_ID + i);
+        AliasMappingListener_set_alias(LISTENER_NODE_ID + i, (uint16_t) (LISTENER_ALIAS + i));
+
+    }
+
+    _advance_listener_prober(USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS - 1);
+
+    // No targeted probe went out while the round was not due
+    EXPECT_EQ(CanBufferFifo_pop(), nullptr);
+
+    _test_global_100ms_tick = (uint8_t) USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS;
+
+    EXPECT_TRUE(CanMainStatemachine_handle_listener_verification());
+
+    can_msg_t *ame = CanBufferFifo_pop();
+    ASSERT_NE(ame, nullptr);
+    EXPECT_EQ(ame->identifier, (uint32_t) (RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AME));
+    EXPECT_EQ(ame->payload_count, 0);
+    EXPECT_EQ(CanBufferFifo_pop(), nullptr);
+
+    // Listener aliases stay usable while the replies come back
+    EXPECT_FALSE(listener_flush_called);
+    EXPECT_EQ(AliasMappingListener_find_by_node_id(LISTENER_NODE_ID)->alias, LISTENER_ALIAS);
+    EXPECT_EQ(AliasMappingListener_find_by_node_id(LISTENER_NODE_ID)->verify_pending, 1);
+
+    // The round is requested once
+    _test_global_100ms_tick++;
+    EXPECT_FALSE(CanMainStatemachine_handle_listener_verification());
+}
+
+#endif
+
 // ============================================================================
 // TEST: Run calls handle_listener_verification when wired
 // ============================================================================
@@ -1324,6 +1451,49 @@ TEST(CanMainStatemachine, run_calls_listener_verification)
     EXPECT_TRUE(handle_listener_verification_called);
 }
 
+// ============================================================================
+// TEST: Run calls handle_acceptance_filters when wired
+// ============================================================================
+
+TEST(CanMainStatemachine, run_calls_acceptance_filters)
+{
+    setup_test();
+    reset_test_variables();
+
+    CanMainStatemachine_run();
+
+    EXPECT_TRUE(handle_acceptance_filters_called);
+}
+
+// ============================================================================
+// TEST: Run calls handle_bus_monitor every pass, even when it reports work
+// ============================================================================
+
+TEST(CanMainStatemachine, run_calls_bus_monitor)
+{
+    setup_test();
+    reset_test_variables();
+
+    CanMainStatemachine_run();
+
+    EXPECT_TRUE(handle_bus_monitor_called);
+    EXPECT_TRUE(handle_acceptance_filters_called);
+}
+
+// ============================================================================
+// TEST: Run refills TX mailboxes every pass when the scheduler is wired
+// ============================================================================
+
+TEST(CanMainStatemachine, run_calls_tx_scheduler)
+{
+    setup_test();
+    reset_test_variables();
+
+    CanMainStatemachine_run();
+
+    EXPECT_TRUE(handle_tx_scheduler_called);
+}
+
 // ============================================================================
 // TEST: send_global_alias_enquiry — flushes listeners
 // ============================================================================
@@ -43,6 +43,15 @@
 *      performs the same flush-then-repopulate sequence and queues the correct
 *      wire frames.
 *
+*   4. Many nodes reserve aliases in one pipelined burst: every CID goes out
+*      before the first RID and all nodes share a single 200 ms window.
+*
+*   5. A duplicate alias during the shared window restarts only the affected
+*      node; its siblings finish login without waiting for it.
+*
+*   6. With the alias pool wired, a node created after the pool has filled
+*      claims a reserved alias and sends AMD with no CID/RID of its own.
+*
 * All real CAN layer implementations are wired (no mocks for login, alias table,
 * or listener table).  listener_flush_aliases and listener_set_alias are wired
 * unconditionally regardless of OPENLCB_COMPILE_TRAIN.
@@ -61,6 +70,7 @@
 #include "can_buffer_fifo.h"
 #include "internal_node_alias_table.h"
 #include "alias_mapping_listener.h"
+#include "can_alias_pool.h"
 #include "can_utilities.h"
 
 #include "../../openlcb/openlcb_node.h"
@@ -153,8 +163,9 @@ static bool _wire_has_amd_for_alias(uint16_t alias) {
 // ============================================================================
 
 static uint8_t _tick_counter;
+static bool _tick_frozen;
 
-static uint8_t _can_e2e_get_tick(void) { return _tick_counter++; }
+static uint8_t _can_e2e_get_tick(void) { return _tick_frozen ? _tick_counter : _tick_counter++; }
 
 // ============================================================================
 // Lock / unlock stubs
@@ -258,6 +269,7 @@ static void _can_e2e_reset(void) {
 
     _can_wire_count = 0;
     _tick_counter   = 0;
+    _tick_frozen    = false;
     memset(_can_wire_log, 0, sizeof(_can_wire_log));
 
 }
@@ -542,3 +554,308 @@ TEST(CanMultinodeE2E, self_originated_global_ame_repopulates_listener_and_queues
     EXPECT_EQ(global_ame_count, 1);
 
 }
+
+// Counts wire frames whose identifier carries the given control-frame type.
+static int _wire_count_frames(uint32_t frame_type, uint32_t frame_mask) {
+
+    int count = 0;
+
+    for (int i = 0; i < _can_wire_count; i++) {
+
+        if ((_can_wire_log[i].identifier & frame_mask) == frame_type) { count++; }
+
+    }
+
+    return count;
+
+}
+
+#define CAN_E2E_CID_MASK 0x0F000000
+#define CAN_E2E_CONTROL_MASK 0x0FFFF000
+#define CAN_E2E_PIPELINE_NODES 40
+
+// ============================================================================
+// TEST 4: Pipelined alias reservation across many nodes
+//
+// Forty nodes start in RUNSTATE_INIT with the clock frozen.  Each node must
+// send CID7..CID4 back to back and then park in WAIT_200ms without any RID
+// reaching the wire.  After the clock advances past the 200 ms window every
+// node sends RID+AMD without another window being opened, so total login
+// time is one window regardless of node count.
+// ============================================================================
+
+TEST(CanMultinodeE2E, many_nodes_share_one_reservation_window)
+{
+
+    _can_e2e_init();
+    _tick_frozen = true;
+
+    openlcb_node_t *nodes[CAN_E2E_PIPELINE_NODES];
+
+    for (int i = 0; i < CAN_E2E_PIPELINE_NODES; i++) {
+
+        nodes[i] = OpenLcbNode_allocate(0x050101010100 + i, &_node_parameters_main_node);
+        ASSERT_NE(nodes[i], nullptr);
+        nodes[i]->state.run_state = RUNSTATE_INIT;
+
+    }
+
+    // With the clock frozen every node should reach the window in roughly one
+    // run() per CID frame plus one enumeration pass.
+    int calls = 0;
+
+    while (_wire_count_frames(CAN_CONTROL_FRAME_CID4, CAN_E2E_CID_MASK) < CAN_E2E_PIPELINE_NODES) {
+
+        CanMainStatemachine_run();
+        calls++;
+
+        ASSERT_LT(calls, CAN_E2E_PIPELINE_NODES * 6);
+
+    }
+
+    EXPECT_EQ(_wire_count_frames(CAN_CONTROL_FRAME_CID7, CAN_E2E_CID_MASK), CAN_E2E_PIPELINE_NODES);
+    EXPECT_EQ(_wire_count_frames(CAN_CONTROL_FRAME_CID6, CAN_E2E_CID_MASK), CAN_E2E_PIPELINE_NODES);
+    EXPECT_EQ(_wire_count_frames(CAN_CONTROL_FRAME_CID5, CAN_E2E_CID_MASK), CAN_E2E_PIPELINE_NODES);
+    EXPECT_EQ(_wire_count_frames(CAN_CONTROL_FRAME_RID, CAN_E2E_CONTROL_MASK), 0);
+
+    for (int i = 0; i < CAN_E2E_PIPELINE_NODES; i++) {
+
+        EXPECT_EQ(nodes[i]->state.run_state, RUNSTATE_WAIT_200ms);
+
+    }
+
+    // Still inside the window: nothing more may be sent
+    for (int i = 0; i < 100; i++) {
+
+        CanMainStatemachine_run();
+
+    }
+
+    EXPECT_EQ(_wire_count_frames(CAN_CONTROL_FRAME_RID, CAN_E2E_CONTROL_MASK), 0);
+
+    // One window later every node finishes
+    _tick_counter += 3;
+
+    calls = 0;
+
+    while (!_all_nodes_can_login_complete()) {
+
+        CanMainStatemachine_run();
+        calls++;
+
+        ASSERT_LT(calls, CAN_E2E_PIPELINE_NODES * 4);
+
+    }
+
+    for (int i = 0; i < 10; i++) {
+
+        CanMainStatemachine_run();
+
+    }
+
+    EXPECT_EQ(_wire_count_frames(CAN_CONTROL_FRAME_RID, CAN_E2E_CONTROL_MASK), CAN_E2E_PIPELINE_NODES);
+    EXPECT_EQ(_wire_count_frames(CAN_CONTROL_FRAME_AMD, CAN_E2E_CONTROL_MASK), CAN_E2E_PIPELINE_NODES);
+
+    // Every CID precedes every RID on the wire
+    int last_cid = -1;
+    int first_rid = _can_wire_count;
+
+    for (int i = 0; i < _can_wire_count; i++) {
+
+        uint32_t identifier = _can_wire_log[i].identifier;
+
+        if (!(identifier & CAN_OPENLCB_MSG) && ((identifier & CAN_E2E_CID_MASK) >= CAN_CONTROL_FRAME_CID4)) {
+
+            last_cid = i;
+
+        }
+
+        if (((identifier & CAN_E2E_CONTROL_MASK) == CAN_CONTROL_FRAME_RID) && (i < first_rid)) {
+
+            first_rid = i;
+
+        }
+
+    }
+
+    EXPECT_LT(last_cid, first_rid);
+
+    for (int i = 0; i < CAN_E2E_PIPELINE_NODES; i++) {
+
+        EXPECT_TRUE(_wire_has_amd_for_alias(nodes[i]->alias));
+
+    }
+
+}
+
+// ============================================================================
+// TEST 5: Duplicate alias inside the shared window restarts only that node
+//
+// Three nodes reserve aliases together.  While they wait, the middle node's
+// alias is flagged as a duplicate (as the RX handler would on a conflicting
+// CID).  Once the window expires the other two nodes complete immediately;
+// the flagged node re-seeds, sends a fresh CID sequence and opens its own
+// window.
+// ============================================================================
+
+TEST(CanMultinodeE2E, duplicate_alias_in_window_restarts_only_that_node)
+{
+
+    _can_e2e_init();
+    _tick_frozen = true;
+
+    openlcb_node_t *nodeA = OpenLcbNode_allocate(0x050101010201, &_node_parameters_main_node);
+    openlcb_node_t *nodeB = OpenLcbNode_allocate(0x050101010202, &_node_parameters_main_node);
+    openlcb_node_t *nodeC = OpenLcbNode_allocate(0x050101010203, &_node_parameters_main_node);
+    nodeA->state.run_state = RUNSTATE_INIT;
+    nodeB->state.run_state = RUNSTATE_INIT;
+    nodeC->state.run_state = RUNSTATE_INIT;
+
+    for (int i = 0; i < 100; i++) {
+
+        CanMainStatemachine_run();
+
+    }
+
+    ASSERT_EQ(nodeA->state.run_state, RUNSTATE_WAIT_200ms);
+    ASSERT_EQ(nodeB->state.run_state, RUNSTATE_WAIT_200ms);
+    ASSERT_EQ(nodeC->state.run_state, RUNSTATE_WAIT_200ms);
+
+    uint16_t old_alias_b = nodeB->alias;
+
+    alias_mapping_t *mapping = InternalNodeAliasTable_find_mapping_by_alias(old_alias_b);
+    ASSERT_NE(mapping, nullptr);
+    mapping->is_duplicate = true;
+    InternalNodeAliasTable_set_has_duplicate_alias_flag();
+
+    _tick_counter += 3;
+
+    for (int i = 0; i < 100; i++) {
+
+        CanMainStatemachine_run();
+
+    }
+
+    // Siblings finished in the original window
+    alias_mapping_t *mappingA = InternalNodeAliasTable_find_mapping_by_node_id(nodeA->id);
+    alias_mapping_t *mappingC = InternalNodeAliasTable_find_mapping_by_node_id(nodeC->id);
+    ASSERT_NE(mappingA, nullptr);
+    ASSERT_NE(mappingC, nullptr);
+    EXPECT_TRUE(mappingA->is_permitted);
+    EXPECT_TRUE(mappingC->is_permitted);
+
+    // The restarted node picked a new alias and is waiting in its own window
+    EXPECT_NE(nodeB->alias, old_alias_b);
+    EXPECT_NE(nodeB->alias, 0);
+    EXPECT_EQ(nodeB->state.run_state, RUNSTATE_WAIT_200ms);
+    EXPECT_FALSE(nodeB->state.permitted);
+
+    _tick_counter += 3;
+
+    for (int i = 0; i < 100; i++) {
+
+        CanMainStatemachine_run();
+
+    }
+
+    EXPECT_TRUE(_all_nodes_can_login_complete());
+    EXPECT_TRUE(_wire_has_amd_for_alias(nodeB->alias));
+    EXPECT_FALSE(_wire_has_amd_for_alias(old_alias_b));
+
+}
+
+// ============================================================================
+// TEST 6: Node created at run time claims a pre-reserved alias
+//
+// The alias pool and login handler are wired with the pool claim hook.  Once
+// the pool has reserved its aliases, a freshly allocated node must go from
+// RUNSTATE_INIT to permitted with a single AMD frame and without waiting for
+// the clock — no CID or RID carries its Node ID.
+// ============================================================================
+
+#if USER_DEFINED_ALIAS_POOL_DEPTH > 0
+
+static const interface_can_login_message_handler_t _can_login_msg_interface_with_pool = {
+
+    .alias_mapping_register           = &InternalNodeAliasTable_register,
+    .alias_mapping_find_mapping_by_alias = &InternalNodeAliasTable_find_mapping_by_alias,
+    .on_alias_change                  = NULL,
+    .alias_pool_claim                 = &CanAliasPool_claim,
+
+};
+
+static const interface_can_alias_pool_t _can_alias_pool_interface = {
+
+    .alias_mapping_register              = &InternalNodeAliasTable_register,
+    .alias_mapping_unregister            = &InternalNodeAliasTable_unregister,
+    .alias_mapping_find_mapping_by_alias = &InternalNodeAliasTable_find_mapping_by_alias,
+    .lock_shared_resources               = &_can_e2e_lock,
+    .unlock_shared_resources             = &_can_e2e_unlock,
+    .get_current_tick                    = &_can_e2e_get_tick,
+
+};
+
+static interface_can_main_statemachine_t _can_main_interface_with_pool;
+
+TEST(CanMultinodeE2E, runtime_node_claims_pooled_alias_and_sends_amd_at_once)
+{
+
+    _can_e2e_init();
+    _tick_frozen = true;
+
+    _can_main_interface_with_pool = _can_main_interface;
+    _can_main_interface_with_pool.handle_alias_pool = &CanAliasPool_run;
+    _can_main_interface_with_pool.alias_pool_frame_transmitted = &CanAliasPool_frame_transmitted;
+
+    CanLoginMessageHandler_initialize(&_can_login_msg_interface_with_pool);
+    CanAliasPool_initialize(&_can_alias_pool_interface);
+    CanMainStatemachine_initialize(&_can_main_interface_with_pool);
+
+    // Let the pool fill: one reservation per refill interval, then one window
+    for (int t = 0; t < USER_DEFINED_ALIAS_POOL_DEPTH * (USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS + 1) + 8; t++) {
+
+        for (int i = 0; i < 20; i++) {
+
+            CanMainStatemachine_run();
+
+        }
+
+        _tick_counter++;
+
+    }
+
+    ASSERT_EQ(CanAliasPool_get_reserved_count(), USER_DEFINED_ALIAS_POOL_DEPTH);
+
+    _can_wire_count = 0;
+
+    openlcb_node_t *node = OpenLcbNode_allocate(0x050101010301, &_node_parameters_main_node);
+    ASSERT_NE(node, nullptr);
+    node->state.run_state = RUNSTATE_INIT;
+
+    // Clock stays frozen: the node must not need a 200 ms window
+    for (int i = 0; i < 10; i++) {
+
+        CanMainStatemachine_run();
+
+    }
+
+    ASSERT_TRUE(_all_nodes_can_login_complete());
+    EXPECT_NE(node->alias, 0);
+    EXPECT_TRUE(_wire_has_amd_for_alias(node->alias));
+
+    for (int i = 0; i < _can_wire_count; i++) {
+
+        uint32_t identifier = _can_wire_log[i].identifier;
+
+        // No CID carries this node's alias and no RID for it was needed
+        if ((identifier & 0xFFF) == node->alias) {
+
+            EXPECT_EQ(identifier & CAN_E2E_CONTROL_MASK, (uint32_t) CAN_CONTROL_FRAME_AMD);
+
+        }
+
+    }
+
+}
+
+#endif /* USER_DEFINED_ALIAS_POOL_DEPTH > 0 */
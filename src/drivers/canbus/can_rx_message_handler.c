@@ -115,6 +115,38 @@ static void _load_reject_message(uint16_t source_alias, uint16_t dest_alias, uin
 
     }
 
+}
+
+    /**
+     * @brief Returns the cached Node ID of a remote alias.
+     *
+     * @verbatim
+     * @param source_alias  Alias of the sending node.
+     * @endverbatim
+     *
+     * @return Cached @ref node_id_t, or 0 if unknown or the cache is not linked in.
+     */
+static node_id_t _find_source_id(uint16_t source_alias) {
+
+    if (_interface->remote_alias_cache_find_node_id) {
+
+        return _interface->remote_alias_cache_find_node_id(source_alias);
+
+    }
+
+    return 0;
+
+}
+
+    /** @brief Drops an alias from the remote alias cache (DI, no-op if not linked in). */
+static void _invalidate_remote_alias(uint16_t alias) {
+
+    if (_interface->remote_alias_cache_invalidate_alias) {
+
+        _interface->remote_alias_cache_invalidate_alias(alias);
+
+    }
+
 }
 
     /**
@@ -123,6 +155,7 @@ static void _load_reject_message(uint16_t source_alias, uint16_t dest_alias, uin
      * @details Algorithm:
      * -# Extract source alias from can_msg identifier.
      * -# Look up alias in our mapping table; return false if not found.
+     * -# Drop the alias from the remote alias cache.
      * -# Mark the mapping entry as duplicate and set the global duplicate flag.
      * -# If our alias is already permitted, send an AMR frame to signal the conflict.
      * -# Return true.
@@ -147,6 +180,8 @@ static bool _check_for_duplicate_alias(can_msg_t *can_msg) {
 
     }
 
+    _invalidate_remote_alias(source_alias);
+
     alias_mapping->is_duplicate = true; // flag for the main loop to handle
     _interface->alias_mapping_set_has_duplicate_alias_flag();
 
@@ -197,7 +232,7 @@ void CanRxMessageHandler_first_frame(can_msg_t *can_msg, uint8_t offset, payload
 
     }
 
-    OpenLcbUtilities_load_openlcb_message(target_openlcb_msg, source_alias, 0, dest_alias, 0, mti);
+    OpenLcbUtilities_load_openlcb_message(target_openlcb_msg, source_alias, _find_source_id(source_alias), dest_alias, 0, mti);
 
     target_openlcb_msg->timer.assembly_ticks = _interface->get_current_tick();
     target_openlcb_msg->state.inprocess = true;
@@ -265,6 +300,40 @@ void CanRxMessageHandler_last_frame(can_msg_t *can_msg, uint8_t offset) {
     OpenLcbBufferList_release(target_openlcb_msg);
     OpenLcbBufferFifo_push(target_openlcb_msg);
 
+}
+
+    /**
+     * @brief Returns true for Verified Node ID and Initialization Complete messages carrying a full Node ID.
+     *
+     * @verbatim
+     * @param openlcb_msg  Assembled single-frame message.
+     * @endverbatim
+     *
+     * @return true if payload bytes 0-5 hold the sender's Node ID.
+     */
+static bool _is_node_id_announcement(openlcb_msg_t *openlcb_msg) {
+
+    if (openlcb_msg->payload_count < 6) {
+
+        return false;
+
+    }
+
+    switch (openlcb_msg->mti) {
+
+        case MTI_VERIFIED_NODE_ID:
+        case MTI_VERIFIED_NODE_ID_SIMPLE:
+        case MTI_INITIALIZATION_COMPLETE:
+        case MTI_INITIALIZATION_COMPLETE_SIMPLE:
+
+            return true;
+
+        default:
+
+            return false;
+
+    }
+
 }
 
 void CanRxMessageHandler_single_frame(can_msg_t *can_msg, uint8_t offset, payload_type_enum data_type) {
@@ -280,10 +349,23 @@ void CanRxMessageHandler_single_frame(can_msg_t *can_msg, uint8_t offset, payloa
     uint16_t dest_alias = CanUtilities_extract_dest_alias_from_can_message(can_msg);
     uint16_t source_alias = CanUtilities_extract_source_alias_from_can_identifier(can_msg);
     uint16_t mti = CanUtilities_convert_can_mti_to_openlcb_mti(can_msg);
-    OpenLcbUtilities_load_openlcb_message(target_openlcb_msg, source_alias, 0, dest_alias, 0, mti);
+    OpenLcbUtilities_load_openlcb_message(target_openlcb_msg, source_alias, _find_source_id(source_alias), dest_alias, 0, mti);
 
     CanUtilities_append_can_payload_to_openlcb_payload(target_openlcb_msg, can_msg, offset);
 
+    // Messages that announce the sender's own Node ID feed the remote alias cache
+    if (_is_node_id_announcement(target_openlcb_msg)) {
+
+        target_openlcb_msg->source_id = OpenLcbUtilities_extract_node_id_from_openlcb_payload(target_openlcb_msg, 0);
+
+        if (_interface->remote_alias_cache_update && !_interface->alias_mapping_find_mapping_by_alias(source_alias)) {
+
+            _interface->remote_alias_cache_update(target_openlcb_msg->source_id, source_alias);
+
+        }
+
+    }
+
     OpenLcbBufferFifo_push(target_openlcb_msg); // Can not fail List is as large as the number of buffers
 
 }
@@ -363,7 +445,7 @@ void CanRxMessageHandler_stream_frame(can_msg_t *can_msg, uint8_t offset, payloa
     uint16_t source_alias = CanUtilities_extract_source_alias_from_can_identifier(can_msg);
     uint16_t mti = CanUtilities_convert_can_mti_to_openlcb_mti(can_msg);
 
-    OpenLcbUtilities_load_openlcb_message(target_openlcb_msg, source_alias, 0, dest_alias, 0, mti);
+    OpenLcbUtilities_load_openlcb_message(target_openlcb_msg, source_alias, _find_source_id(source_alias), dest_alias, 0, mti);
 
     // Copy the entire CAN payload (DID + data bytes) starting at offset 0
     CanUtilities_append_can_payload_to_openlcb_payload(target_openlcb_msg, can_msg, 0);
@@ -378,7 +460,8 @@ void CanRxMessageHandler_stream_frame(can_msg_t *can_msg, uint8_t offset, payloa
      * @details Per the standard (§6.2.5 Node ID Alias Collision Handling):
      * "If the frame is a Check ID (CID) frame, send a Reserve ID (RID) frame
      * in response."  The correct defence is always RID, regardless of whether
-     * the node is Permitted or still Inhibited.
+     * the node is Permitted or still Inhibited.  The alias is also dropped from
+     * the remote alias cache since a new owner is reserving it.
      * This differs from non-CID frames (RID/AMD/AMR) which indicate an active
      * alias collision and are handled by the internal `_check_for_duplicate_alias()`
      * helper.
@@ -396,6 +479,10 @@ void CanRxMessageHandler_cid_frame(can_msg_t *can_msg) {
     }
 
     uint16_t source_alias = CanUtilities_extract_source_alias_from_can_identifier(can_msg);
+
+    // Someone is reserving this alias; any cached owner is gone or about to be challenged
+    _invalidate_remote_alias(source_alias);
+
     alias_mapping_t *alias_mapping = _interface->alias_mapping_find_mapping_by_alias(source_alias);
 
     if (alias_mapping) {
@@ -415,11 +502,13 @@ void CanRxMessageHandler_cid_frame(can_msg_t *can_msg) {
 
 }
 
-    /** @brief Handles RID frames: checks for a duplicate alias and flags it if found. */
+    /** @brief Handles RID frames: flags a duplicate of our alias and drops the alias from the remote alias cache. */
 void CanRxMessageHandler_rid_frame(can_msg_t *can_msg) {
 
     _check_for_duplicate_alias(can_msg);
 
+    _invalidate_remote_alias(CanUtilities_extract_source_alias_from_can_identifier(can_msg));
+
 }
 
     /**
@@ -434,11 +523,19 @@ void CanRxMessageHandler_rid_frame(can_msg_t *can_msg) {
      *
      * Called from the AMD handler after the listener alias table has been
      * updated — the attach can now proceed because the alias is resolved.
+     * Returns at once when the BufferList is empty, which is the normal case
+     * for the AMD burst that follows a global AME.
      *
      * @param listener_id  48-bit Node ID from the AMD payload.
      */
 static void _release_held_messages_for_listener(node_id_t listener_id) {
 
+    if (OpenLcbBufferList_is_empty()) {
+
+        return;
+
+    }
+
     for (int i = 0; i < LEN_MESSAGE_BUFFER; i++) {
 
         openlcb_msg_t *msg = OpenLcbBufferList_index_of(i);
@@ -497,8 +594,10 @@ static void _release_held_messages_for_listener(node_id_t listener_id) {
     /**
      * @brief Handles AMD (Alias Map Definition) CAN control frames.
      *
-     * @details Performs two actions:
+     * @details Performs three actions:
      * -# Checks for a duplicate alias condition (our own alias conflict).
+     * -# If no conflict and the remote alias cache is linked in, records the
+     *    alias / Node ID pair.
      * -# If the listener alias feature is linked in, updates the listener
      *    table with the resolved alias and releases any held attach messages
      *    that were waiting on this Node ID.
@@ -511,7 +610,11 @@ static void _release_held_messages_for_listener(node_id_t listener_id) {
      */
 void CanRxMessageHandler_amd_frame(can_msg_t *can_msg) {
 
-    _check_for_duplicate_alias(can_msg);
+    if (!_check_for_duplicate_alias(can_msg) && _interface->remote_alias_cache_update) {
+
+        _interface->remote_alias_cache_update(CanUtilities_extract_can_payload_as_node_id(can_msg), CanUtilities_extract_source_alias_from_can_identifier(can_msg));
+
+    }
 
     // Update listener alias table and release held attach messages (DI, no-op if not linked in)
     if (_interface->listener_set_alias) {
@@ -534,7 +637,8 @@ void CanRxMessageHandler_amd_frame(can_msg_t *can_msg) {
      * -# Check for duplicate alias; return early if detected.
      * -# If payload is non-empty: look up by Node ID, respond with one AMD if found.
      * -# If payload is empty (global query):
-     *    - Flush the listener alias cache (CanFrameTransferS §6.2.3).
+     *    - Flush the listener alias cache and the remote alias cache
+     *      (CanFrameTransferS §6.2.3).
      *    - For each permitted alias: repopulate the listener table entry
      *      immediately (local virtual nodes' aliases are already known),
      *      then send AMD.
@@ -586,6 +690,12 @@ void CanRxMessageHandler_ame_frame(can_msg_t *can_msg) {
 
     }
 
+    if (_interface->remote_alias_cache_flush) {
+
+        _interface->remote_alias_cache_flush();
+
+    }
+
     alias_mapping_info_t *alias_mapping_info = _interface->alias_mapping_get_alias_mapping_info();
 
     for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
@@ -619,8 +729,9 @@ void CanRxMessageHandler_ame_frame(can_msg_t *can_msg) {
     /**
      * @brief Releases and frees all BufferList messages from a released alias.
      *
-     * @details Scans the OpenLcbBufferList for messages whose source_alias
-     * matches the released alias.  The sender has gone away — partial
+     * @details Drains the OpenLcbBufferList of messages whose source_alias
+     * matches the released alias, visiting only that alias's index bucket
+     * so an AMR burst stays linear.  The sender has gone away — partial
      * assemblies will never complete, and completed messages that have not
      * yet been pushed to the FIFO should not be processed (any reply would
      * target a stale alias).  Freeing them immediately reclaims scarce
@@ -630,25 +741,15 @@ void CanRxMessageHandler_ame_frame(can_msg_t *can_msg) {
      */
 static void _check_and_release_messages_by_source_alias(uint16_t alias) {
 
-    for (int i = 0; i < LEN_MESSAGE_BUFFER; i++) {
-
-        openlcb_msg_t *msg = OpenLcbBufferList_index_of(i);
-
-        if (!msg) {
-
-            continue;
-
-        }
-
-        if (msg->source_alias != alias) {
+    openlcb_msg_t *msg = OpenLcbBufferList_find_by_source_alias(alias);
 
-            continue;
-
-        }
+    while (msg) {
 
         OpenLcbBufferList_release(msg);
         OpenLcbBufferStore_free_buffer(msg);
 
+        msg = OpenLcbBufferList_find_by_source_alias(alias);
+
     }
 
 }
@@ -656,7 +757,7 @@ static void _check_and_release_messages_by_source_alias(uint16_t alias) {
     /**
      * @brief Handles AMR (Alias Map Reset) CAN control frames.
      *
-     * @details Performs four actions when a remote node releases its alias:
+     * @details Performs five actions when a remote node releases its alias:
      * -# Checks for a duplicate alias condition (our own alias conflict).
      * -# BufferList scrub: frees all messages from the released alias
      *    (partial assemblies will never complete, completed messages should
@@ -667,6 +768,9 @@ static void _check_and_release_messages_by_source_alias(uint16_t alias) {
      * -# Listener table cleanup: clears the released alias from the listener
      *    table so future TX-path lookups return alias == 0 (unresolved)
      *    instead of the stale alias.  DI, no-op if not linked in.
+     * -# Remote alias cache cleanup: forgets the released alias so incoming
+     *    messages from its next owner are not tagged with the old Node ID.
+     *    DI, no-op if not linked in.
      *
      * @verbatim
      * @param can_msg  Received AMR frame.
@@ -691,6 +795,8 @@ void CanRxMessageHandler_amr_frame(can_msg_t *can_msg) {
 
     }
 
+    _invalidate_remote_alias(alias);
+
 }
 
     /** @brief Handles Error Information Report frames: checks for a duplicate alias and flags it if found. */
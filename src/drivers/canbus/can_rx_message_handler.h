@@ -51,7 +51,8 @@ extern "C" {
      * @details Provides buffer allocation and alias-mapping callbacks needed to
      * assemble incoming CAN frames into OpenLCB messages and to respond to CAN
      * control frames (CID, AME, etc.).  The first 7 pointers are REQUIRED.
-     * The listener_* pointers are OPTIONAL (NULL = feature not linked in).
+     * The listener_* and remote_alias_cache_* pointers are OPTIONAL (NULL =
+     * feature not linked in).
      *
      * @see CanRxMessageHandler_initialize
      */
@@ -122,6 +123,47 @@ extern "C" {
          */
         void (*listener_flush_aliases)(void);
 
+        /**
+         * @brief OPTIONAL. Remember a remote Node ID / alias pair.
+         *
+         * @details Called for AMD frames and for Verified Node ID and
+         * Initialization Complete messages.  NULL = remote alias cache not
+         * linked in.
+         *
+         * @note Typical: RemoteAliasCache_update.
+         */
+        void (*remote_alias_cache_update)(node_id_t node_id, uint16_t alias);
+
+        /**
+         * @brief OPTIONAL. Look up the Node ID of a remote alias.
+         *
+         * @details Used to fill source_id of every incoming OpenLCB message.
+         * NULL = remote alias cache not linked in.
+         *
+         * @note Typical: RemoteAliasCache_find_node_id.
+         */
+        node_id_t (*remote_alias_cache_find_node_id)(uint16_t alias);
+
+        /**
+         * @brief OPTIONAL. Forget a remote alias.
+         *
+         * @details Called for CID, RID and AMR frames and when a duplicate of
+         * one of our aliases is detected.  NULL = remote alias cache not
+         * linked in.
+         *
+         * @note Typical: RemoteAliasCache_invalidate_alias.
+         */
+        void (*remote_alias_cache_invalidate_alias)(uint16_t alias);
+
+        /**
+         * @brief OPTIONAL. Forget every remote alias (global AME).
+         *
+         * @details NULL = remote alias cache not linked in.
+         *
+         * @note Typical: RemoteAliasCache_flush.
+         */
+        void (*remote_alias_cache_flush)(void);
+
     } interface_can_rx_message_handler_t;
 
 
@@ -199,7 +241,9 @@ extern "C" {
      * @brief Handles a complete single-frame OpenLCB message.
      *
      * @details Allocates a buffer, copies all payload data, and pushes directly to the
-     * OpenLCB FIFO.  Silently drops if allocation fails.
+     * OpenLCB FIFO.  Silently drops if allocation fails.  source_id is filled from
+     * the remote alias cache, and Verified Node ID / Initialization Complete
+     * messages feed their Node ID into it.
      *
      * @param can_msg    Received CAN frame.
      * @param offset     Byte offset where OpenLCB data begins.
@@ -245,7 +289,8 @@ extern "C" {
     /**
      * @brief Handles RID (Reserve ID) CAN control frames.
      *
-     * @details Checks for a duplicate alias condition and flags it if found.
+     * @details Checks for a duplicate alias condition and flags it if found, and
+     * drops the alias from the remote alias cache.
      *
      * @param can_msg  Received RID frame.
      *
@@ -257,7 +302,9 @@ extern "C" {
     /**
      * @brief Handles AMD (Alias Map Definition) CAN control frames.
      *
-     * @details Checks for a duplicate alias condition and flags it if found.
+     * @details Checks for a duplicate alias condition and flags it if found;
+     * otherwise records the alias / Node ID pair in the listener table and the
+     * remote alias cache.
      *
      * @param can_msg  Received AMD frame (6-byte NodeID in payload).
      *
@@ -283,7 +330,9 @@ extern "C" {
     /**
      * @brief Handles AMR (Alias Map Reset) CAN control frames.
      *
-     * @details Checks for a duplicate alias condition and flags it if found.
+     * @details Checks for a duplicate alias condition and flags it if found,
+     * scrubs messages from the released alias, and drops it from the listener
+     * table and the remote alias cache.
      *
      * @param can_msg  Received AMR frame.
      *
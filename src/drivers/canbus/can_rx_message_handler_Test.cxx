@@ -25,6 +25,7 @@
 #include "../../openlcb/openlcb_buffer_list.h"
 #include "../../openlcb/openlcb_defines.h"
 #include "../../drivers/canbus/internal_node_alias_table.h"
+#include "../../drivers/canbus/remote_alias_cache.h"
 #include "../../openlcb/openlcb_utilities.h"
 
 /*******************************************************************************
@@ -173,6 +174,20 @@ const interface_can_rx_message_handler_t _can_rx_message_handler_interface_with_
     .listener_flush_aliases = &_mock_listener_flush_aliases,
 };
 
+const interface_can_rx_message_handler_t _can_rx_message_handler_interface_with_remote_cache = {
+    .can_buffer_store_allocate_buffer = &can_buffer_store_allocate_buffer,
+    .openlcb_buffer_store_allocate_buffer = &openlcb_buffer_store_allocate_buffer,
+    .alias_mapping_find_mapping_by_alias = &InternalNodeAliasTable_find_mapping_by_alias,
+    .alias_mapping_find_mapping_by_node_id = &InternalNodeAliasTable_find_mapping_by_node_id,
+    .alias_mapping_get_alias_mapping_info = &InternalNodeAliasTable_get_alias_mapping_info,
+    .alias_mapping_set_has_duplicate_alias_flag = &InternalNodeAliasTable_set_has_duplicate_alias_flag,
+    .get_current_tick = &_mock_get_current_tick,
+    .remote_alias_cache_update = &RemoteAliasCache_update,
+    .remote_alias_cache_find_node_id = &RemoteAliasCache_find_node_id,
+    .remote_alias_cache_invalidate_alias = &RemoteAliasCache_invalidate_alias,
+    .remote_alias_cache_flush = &RemoteAliasCache_flush,
+};
+
 /*******************************************************************************
  * Helper Functions
  ******************************************************************************/
@@ -199,6 +214,18 @@ void _global_initialize_with_listeners(void)
     CanRxMessageHandler_initialize(&_can_rx_message_handler_interface_with_listeners);
 }
 
+void _global_initialize_with_remote_cache(void)
+{
+    CanBufferStore_initialize();
+    CanBufferFifo_initialize();
+    OpenLcbBufferStore_initialize();
+    OpenLcbBufferFifo_initialize();
+    OpenLcbBufferList_initialize();
+    InternalNodeAliasTable_initialize();
+    RemoteAliasCache_initialize();
+    CanRxMessageHandler_initialize(&_can_rx_message_handler_interface_with_remote_cache);
+}
+
 void _global_reset_variables(void)
 {
     fail_buffer = false;
@@ -2538,3 +2565,143 @@ TEST(CanRxMessageHandler, ame_global_skips_non_permitted_for_listener)
     _test_for_all_buffer_stores_empty();
 
 }
+
+// ============================================================================
+// TEST: Remote alias cache is filled passively and feeds source_id
+// ============================================================================
+
+TEST(CanRxMessageHandler, amd_frame_fills_remote_alias_cache)
+{
+
+    _global_initialize_with_remote_cache();
+    _global_reset_variables();
+
+    can_msg_t can_msg;
+
+    CanUtilities_load_can_message(&can_msg, 0x10701000 | SOURCE_ALIAS, 6,
+                                   0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0, 0);
+
+    CanRxMessageHandler_amd_frame(&can_msg);
+
+    EXPECT_EQ(RemoteAliasCache_find_node_id(SOURCE_ALIAS), 0x010203040506ULL);
+
+    // A later single frame from that alias carries the Node ID for free
+    CanUtilities_load_can_message(&can_msg, 0x195B4000 | SOURCE_ALIAS, 8,
+                                   0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08);
+
+    CanRxMessageHandler_single_frame(&can_msg, 0, BASIC);
+
+    openlcb_msg_t *openlcb_msg = OpenLcbBufferFifo_pop();
+    ASSERT_NE(openlcb_msg, nullptr);
+    EXPECT_EQ(openlcb_msg->source_alias, SOURCE_ALIAS);
+    EXPECT_EQ(openlcb_msg->source_id, 0x010203040506ULL);
+    OpenLcbBufferStore_free_buffer(openlcb_msg);
+
+    _test_for_all_buffer_lists_empty();
+    _test_for_all_buffer_stores_empty();
+
+}
+
+TEST(CanRxMessageHandler, amd_frame_duplicate_alias_not_cached)
+{
+
+    _global_initialize_with_remote_cache();
+    _global_reset_variables();
+
+    InternalNodeAliasTable_register(NODE_ALIAS_1, NODE_ID_1);
+
+    can_msg_t can_msg;
+
+    CanUtilities_load_can_message(&can_msg, 0x10701000 | NODE_ALIAS_1, 6,
+                                   0x01, 0x02, 0x03, 0x04, 0x05, 0x07, 0, 0);
+
+    CanRxMessageHandler_amd_frame(&can_msg);
+
+    EXPECT_EQ(RemoteAliasCache_find_node_id(NODE_ALIAS_1), 0ULL);
+    EXPECT_EQ(RemoteAliasCache_get_count(), 0);
+
+    _test_for_all_buffer_lists_empty();
+    _test_for_all_buffer_stores_empty();
+
+}
+
+TEST(CanRxMessageHandler, verified_node_id_fills_remote_alias_cache)
+{
+
+    _global_initialize_with_remote_cache();
+    _global_reset_variables();
+
+    can_msg_t can_msg;
+
+    // Verified Node ID (0x0170), global, Node ID in payload
+    CanUtilities_load_can_message(&can_msg, 0x19170000 | SOURCE_ALIAS, 6,
+                                   0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0, 0);
+
+    CanRxMessageHandler_single_frame(&can_msg, 0, BASIC);
+
+    openlcb_msg_t *openlcb_msg = OpenLcbBufferFifo_pop();
+    ASSERT_NE(openlcb_msg, nullptr);
+    EXPECT_EQ(openlcb_msg->source_id, 0x0A0B0C0D0E0FULL);
+    OpenLcbBufferStore_free_buffer(openlcb_msg);
+
+    EXPECT_EQ(RemoteAliasCache_find_alias(0x0A0B0C0D0E0FULL), SOURCE_ALIAS);
+
+    // Initialization Complete from a node that reused the alias replaces it
+    CanUtilities_load_can_message(&can_msg, 0x19100000 | SOURCE_ALIAS, 6,
+                                   0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0, 0);
+
+    CanRxMessageHandler_single_frame(&can_msg, 0, BASIC);
+
+    openlcb_msg = OpenLcbBufferFifo_pop();
+    ASSERT_NE(openlcb_msg, nullptr);
+    EXPECT_EQ(openlcb_msg->source_id, 0x010101010101ULL);
+    OpenLcbBufferStore_free_buffer(openlcb_msg);
+
+    EXPECT_EQ(RemoteAliasCache_find_alias(0x0A0B0C0D0E0FULL), 0);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(SOURCE_ALIAS), 0x010101010101ULL);
+
+    _test_for_all_buffer_lists_empty();
+    _test_for_all_buffer_stores_empty();
+
+}
+
+TEST(CanRxMessageHandler, control_frames_invalidate_remote_alias_cache)
+{
+
+    _global_initialize_with_remote_cache();
+    _global_reset_variables();
+
+    can_msg_t can_msg;
+
+    // AMR releases the alias
+    RemoteAliasCache_update(NODE_ID_2, SOURCE_ALIAS);
+    CanUtilities_load_can_message(&can_msg, 0x10703000 | SOURCE_ALIAS, 6,
+                                   0x01, 0x02, 0x03, 0x04, 0x05, 0x07, 0, 0);
+    CanRxMessageHandler_amr_frame(&can_msg);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(SOURCE_ALIAS), 0ULL);
+
+    // CID means someone is reserving the alias
+    RemoteAliasCache_update(NODE_ID_2, SOURCE_ALIAS);
+    CanUtilities_load_can_message(&can_msg, 0x17000000 | SOURCE_ALIAS, 0,
+                                   0, 0, 0, 0, 0, 0, 0, 0);
+    CanRxMessageHandler_cid_frame(&can_msg);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(SOURCE_ALIAS), 0ULL);
+
+    // RID completes a new reservation
+    RemoteAliasCache_update(NODE_ID_2, SOURCE_ALIAS);
+    CanUtilities_load_can_message(&can_msg, 0x10700000 | SOURCE_ALIAS, 0,
+                                   0, 0, 0, 0, 0, 0, 0, 0);
+    CanRxMessageHandler_rid_frame(&can_msg);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(SOURCE_ALIAS), 0ULL);
+
+    // Global AME flushes everything
+    RemoteAliasCache_update(NODE_ID_2, SOURCE_ALIAS);
+    CanUtilities_load_can_message(&can_msg, 0x10702000 | NODE_ALIAS_2, 0,
+                                   0, 0, 0, 0, 0, 0, 0, 0);
+    CanRxMessageHandler_ame_frame(&can_msg);
+    EXPECT_EQ(RemoteAliasCache_get_count(), 0);
+
+    _test_for_all_buffer_lists_empty();
+    _test_for_all_buffer_stores_empty();
+
+}
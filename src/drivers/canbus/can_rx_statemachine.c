@@ -497,6 +497,40 @@ static void _handle_can_control_frame_sequence_number(can_msg_t *can_msg) {
 
     }
 
+}
+
+    /**
+     * @brief First-stage filter for OpenLCB frames addressed to other nodes.
+     *
+     * @details Algorithm:
+     * -# If no alias_mapping_is_local_alias filter is wired, return false
+     * -# Extract the destination alias (0 for global frames), return false if 0
+     * -# Return true if the alias bit is clear, i.e. no local node holds it
+     *
+     * @verbatim
+     * @param can_msg Received OpenLCB CAN frame.
+     * @endverbatim
+     *
+     * @return true if the frame can be discarded without further lookups.
+     */
+static bool _is_addressed_to_foreign_alias(can_msg_t *can_msg) {
+
+    if (!_interface->alias_mapping_is_local_alias) {
+
+        return false;
+
+    }
+
+    uint16_t dest_alias = CanUtilities_extract_dest_alias_from_can_message(can_msg);
+
+    if (dest_alias == 0) {
+
+        return false;
+
+    }
+
+    return !_interface->alias_mapping_is_local_alias(dest_alias);
+
 }
 
     /**
@@ -533,6 +567,12 @@ void CanRxStatemachine_incoming_can_driver_callback(can_msg_t *can_msg) {
 
     // This is called directly from the incoming CAN receiver as raw Openlcb CAN messages
 
+    if (_interface->bus_monitor_count_rx_frame) {
+
+        _interface->bus_monitor_count_rx_frame(can_msg);
+
+    }
+
     // First see if the application has defined a callback
     if (_interface->on_receive) {
 
@@ -544,6 +584,12 @@ void CanRxStatemachine_incoming_can_driver_callback(can_msg_t *can_msg) {
     // Second split the message up between is it a CAN control message (AMR, AME, AMD, RID, CID, etc.)
     if (CanUtilities_is_openlcb_message(can_msg)) {
 
+        if (_is_addressed_to_foreign_alias(can_msg)) {
+
+            return; // Addressed to a node that is not ours, nothing else to do
+
+        }
+
         _handle_can_type_frame(can_msg); //  Handle pure OpenLCB CAN Messages
 
 
@@ -44,8 +44,9 @@
     /**
      * @brief Dependency-injection interface for the CAN receive state machine.
      *
-     * @details Provides 12 REQUIRED frame-handler callbacks plus 1 REQUIRED alias lookup
-     * and 1 OPTIONAL receive-notification callback.  All REQUIRED pointers must be non-NULL.
+     * @details Provides 12 REQUIRED frame-handler callbacks plus 1 REQUIRED alias lookup,
+     * 1 OPTIONAL receive-notification callback and 1 OPTIONAL alias-bitmap filter.
+     * All REQUIRED pointers must be non-NULL.
      *
      * Frame dispatch rules:
      * - CAN control frames  → handle_cid/rid/amd/ame/amr/error_info_report
@@ -102,6 +103,12 @@ typedef struct {
     /** @brief OPTIONAL. Called immediately when a frame arrives, before any routing. Good for counters/LEDs. May be NULL. */
     void (*on_receive)(can_msg_t *can_msg);
 
+    /** @brief OPTIONAL. O(1) test whether an alias belongs to one of our nodes; addressed frames failing it are dropped before dispatch. Typical: InternalNodeAliasTable_is_local_alias. May be NULL. */
+    bool (*alias_mapping_is_local_alias)(uint16_t alias);
+
+    /** @brief OPTIONAL. Counts every received frame for bus-load figures; runs in the receive context. Typical: CanBusMonitor_count_rx_frame. May be NULL. */
+    void (*bus_monitor_count_rx_frame)(can_msg_t *can_msg);
+
 } interface_can_rx_statemachine_t;
 
 #ifdef __cplusplus
@@ -126,8 +133,10 @@ extern "C" {
     /**
      * @brief Primary entry point called by the hardware CAN driver on frame reception.
      *
-     * @details Invokes the optional on_receive callback, then classifies the frame as
-     * an OpenLCB message or a CAN control frame and dispatches accordingly.
+     * @details Invokes the optional on_receive callback, drops addressed OpenLCB frames
+     * whose destination alias fails the optional alias_mapping_is_local_alias filter,
+     * then classifies the frame as an OpenLCB message or a CAN control frame and
+     * dispatches accordingly.
      *
      * This function is typically called from an interrupt or receive thread and accesses
      * shared resources (FIFOs, buffer lists).  It must NOT be called while the main state
@@ -1800,6 +1800,136 @@ TEST(CanRxStatemachine, null_handlers_unaddressed_messages)
     EXPECT_FALSE(can_single_frame_called);  // Handler NULL
 }
 
+/*******************************************************************************
+ * Alias Bitmap Filter Tests
+ ******************************************************************************/
+
+// Tracks calls into the full table lookup so the tests can prove the bitmap
+// filter rejected a frame before any table was consulted
+int find_mapping_call_count = 0;
+
+alias_mapping_t *_counting_find_mapping_by_alias(uint16_t alias)
+{
+    find_mapping_call_count++;
+
+    return _find_mapping_by_alias(alias);
+}
+
+/**
+ * Mock: Bitmap filter that only knows the alias in alias_mapping
+ */
+bool _is_local_alias(uint16_t alias)
+{
+    return (alias != 0) && (alias == alias_mapping.alias);
+}
+
+const interface_can_rx_statemachine_t interface_with_alias_filter = {
+    .handle_can_legacy_snip = &_handle_can_legacy_snip,
+    .handle_single_frame = &_handle_single_frame,
+    .handle_first_frame = &_handle_first_frame,
+    .handle_middle_frame = &_handle_middle_frame,
+    .handle_last_frame = &_handle_last_frame,
+    .handle_stream_frame = &_handle_stream_frame,
+    .handle_rid_frame = &_handle_rid_frame,
+    .handle_amd_frame = &_handle_amd_frame,
+    .handle_ame_frame = &_handle_ame_frame,
+    .handle_amr_frame = &_handle_amr_frame,
+    .handle_error_info_report_frame = &_handle_error_info_report_frame,
+    .handle_cid_frame = &_handle_cid_frame,
+    .alias_mapping_find_mapping_by_alias = &_counting_find_mapping_by_alias,
+    .on_receive = &_on_receive,
+    .alias_mapping_is_local_alias = &_is_local_alias
+};
+
+/**
+ * Test: Frames addressed to a foreign alias are dropped by the bitmap filter
+ *
+ * Purpose:
+ *   Verifies addressed standard, datagram and stream frames for an alias that
+ *   is not ours never reach a handler or the alias table lookup.
+ */
+TEST(CanRxStatemachine, alias_filter_drops_foreign_destinations)
+{
+    CanRxStatemachine_initialize(&interface_with_alias_filter);
+    reset_test_variables();
+    find_mapping_call_count = 0;
+
+    alias_mapping.alias = 0x0BBB;
+    alias_mapping.node_id = 0x010203040506;
+
+    can_msg_t msg;
+
+    // Addressed Verify Node ID to 0x0CCC
+    CanUtilities_clear_can_message(&msg);
+    msg.identifier = RESERVED_TOP_BIT | CAN_OPENLCB_MSG | OPENLCB_MESSAGE_STANDARD_FRAME_TYPE |
+                     ((MTI_VERIFY_NODE_ID_ADDRESSED & 0x0FFF) << 12) | 0x0AAA;
+    msg.payload[0] = MULTIFRAME_ONLY | 0x0C;
+    msg.payload[1] = 0xCC;
+    msg.payload_count = 2;
+    CanRxStatemachine_incoming_can_driver_callback(&msg);
+
+    // Datagram only to 0x0CCC
+    CanUtilities_clear_can_message(&msg);
+    msg.identifier = RESERVED_TOP_BIT | CAN_OPENLCB_MSG | CAN_FRAME_TYPE_DATAGRAM_ONLY |
+                     (0x0CCC << 12) | 0x0AAA;
+    msg.payload_count = 8;
+    CanRxStatemachine_incoming_can_driver_callback(&msg);
+
+    // Stream frame to 0x0CCC
+    CanUtilities_clear_can_message(&msg);
+    msg.identifier = RESERVED_TOP_BIT | CAN_OPENLCB_MSG | CAN_FRAME_TYPE_STREAM |
+                     (0x0CCC << 12) | 0x0AAA;
+    msg.payload_count = 8;
+    CanRxStatemachine_incoming_can_driver_callback(&msg);
+
+    EXPECT_TRUE(on_receive_called);
+    EXPECT_FALSE(can_single_frame_called);
+    EXPECT_FALSE(can_stream_called);
+    EXPECT_EQ(find_mapping_call_count, 0);
+}
+
+/**
+ * Test: Frames for our alias and global frames pass the bitmap filter
+ */
+TEST(CanRxStatemachine, alias_filter_passes_local_and_global)
+{
+    CanRxStatemachine_initialize(&interface_with_alias_filter);
+    reset_test_variables();
+    find_mapping_call_count = 0;
+
+    alias_mapping.alias = 0x0BBB;
+    alias_mapping.node_id = 0x010203040506;
+
+    can_msg_t msg;
+
+    // Datagram only to our alias
+    CanUtilities_clear_can_message(&msg);
+    msg.identifier = RESERVED_TOP_BIT | CAN_OPENLCB_MSG | CAN_FRAME_TYPE_DATAGRAM_ONLY |
+                     (0x0BBB << 12) | 0x0AAA;
+    msg.payload_count = 8;
+    CanRxStatemachine_incoming_can_driver_callback(&msg);
+
+    EXPECT_TRUE(can_single_frame_called);
+    EXPECT_EQ(find_mapping_call_count, 1);
+
+    // Global Verify Node ID has no destination and is never filtered
+    reset_test_variables();
+    CanUtilities_clear_can_message(&msg);
+    msg.identifier = RESERVED_TOP_BIT | CAN_OPENLCB_MSG | OPENLCB_MESSAGE_STANDARD_FRAME_TYPE |
+                     ((MTI_VERIFY_NODE_ID_GLOBAL & 0x0FFF) << 12) | 0x0AAA;
+    CanRxStatemachine_incoming_can_driver_callback(&msg);
+
+    EXPECT_TRUE(can_single_frame_called);
+
+    // Control frames are never filtered
+    reset_test_variables();
+    CanUtilities_clear_can_message(&msg);
+    msg.identifier = RESERVED_TOP_BIT | CAN_CONTROL_FRAME_AMD | 0x0AAA;
+    CanRxStatemachine_incoming_can_driver_callback(&msg);
+
+    EXPECT_TRUE(can_amd_called);
+}
+
 /*******************************************************************************
  * COVERAGE SUMMARY
  ******************************************************************************/
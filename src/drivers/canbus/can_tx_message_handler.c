@@ -119,7 +119,8 @@ static uint32_t _construct_addressed_message_identifier(openlcb_msg_t *openlcb_m
 // ---- Low-level transmit helper ----
 
     /**
-     * @brief Calls the hardware transmit function and invokes the optional on_transmit callback.
+     * @brief Calls the hardware transmit function and invokes the optional on_transmit
+     * and bus-monitor callbacks.
      *
      * @param can_msg Fully-constructed CAN frame to send.
      *
@@ -135,6 +136,12 @@ static bool _transmit_can_frame(can_msg_t *can_msg) {
 
     }
 
+    if (_interface->bus_monitor_count_tx_frame && result) {
+
+        _interface->bus_monitor_count_tx_frame(can_msg);
+
+    }
+
     return result;
 
 }
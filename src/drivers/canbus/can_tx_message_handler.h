@@ -72,6 +72,13 @@ typedef struct {
          */
         void (*on_transmit)(can_msg_t *can_msg);
 
+        /**
+         * @brief OPTIONAL.  Counts every transmitted frame for bus-load figures.
+         *
+         * @details Typical: CanBusMonitor_count_tx_frame.  May be NULL.
+         */
+        void (*bus_monitor_count_tx_frame)(can_msg_t *can_msg);
+
 } interface_can_tx_message_handler_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,323 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file can_tx_scheduler.c
+ * @brief Implementation of the CAN TX priority scheduler.
+ *
+ * @details The queue is kept in arrival order; selection scans it for the
+ * lowest identifier whose source alias has no earlier queued frame and no frame
+ * in a mailbox.  Queue depths are small, so the scan is cheaper than keeping a
+ * sorted copy alongside the per-alias ordering.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#include "can_tx_scheduler.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "can_types.h"
+#include "../../openlcb/openlcb_defines.h"
+
+
+/** @brief Saved pointer to the dependency-injected interface. */
+static interface_can_tx_scheduler_t *_interface;
+
+/** @brief Frames waiting for a mailbox, in arrival order. */
+static can_msg_t _queue[LEN_CAN_TX_QUEUE];
+
+/** @brief Number of frames in @ref _queue. */
+static uint16_t _queue_count;
+
+/** @brief Identifiers of the frames currently in hardware mailboxes. */
+static uint32_t _in_flight[USER_DEFINED_CAN_TX_MAILBOX_COUNT];
+
+/** @brief Number of entries in @ref _in_flight. */
+static uint16_t _in_flight_count;
+
+    /** @brief Stores the interface pointer and empties the queue and mailbox records. */
+void CanTxScheduler_initialize(const interface_can_tx_scheduler_t *interface) {
+
+    _interface = (interface_can_tx_scheduler_t *) interface;
+
+    _queue_count = 0;
+    _in_flight_count = 0;
+
+}
+
+    /** @brief Returns true if a frame from the given source alias is in a mailbox. */
+static bool _is_alias_in_flight(uint16_t alias) {
+
+    for (int i = 0; i < _in_flight_count; i++) {
+
+        if ((_in_flight[i] & MASK_CAN_SOURCE_ALIAS) == alias) {
+
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+    /** @brief Returns true if a frame queued before index comes from the same source alias. */
+static bool _is_alias_queued_before(uint16_t index, uint16_t alias) {
+
+    for (int i = 0; i < index; i++) {
+
+        if ((_queue[i].identifier & MASK_CAN_SOURCE_ALIAS) == alias) {
+
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+    /**
+     * @brief Picks the next frame allowed into a mailbox.
+     *
+     * @details Algorithm:
+     * -# Skip frames whose source alias is in a mailbox or has an earlier queued frame
+     * -# Of the rest, return the one with the lowest identifier
+     *
+     * @return Queue index of the chosen frame, or -1 if none may go.
+     */
+static int _select_next(void) {
+
+    int best = -1;
+
+    for (int i = 0; i < _queue_count; i++) {
+
+        if ((best >= 0) && (_queue[i].identifier >= _queue[best].identifier)) {
+
+            continue;
+
+        }
+
+        uint16_t alias = (uint16_t) (_queue[i].identifier & MASK_CAN_SOURCE_ALIAS);
+
+        if (_is_alias_in_flight(alias) || _is_alias_queued_before((uint16_t) i, alias)) {
+
+            continue;
+
+        }
+
+        best = i;
+
+    }
+
+    return best;
+
+}
+
+    /** @brief Removes one frame from the queue, keeping the rest in arrival order. */
+static void _remove(int index) {
+
+    for (int i = index; i < _queue_count - 1; i++) {
+
+        _queue[i] = _queue[i + 1];
+
+    }
+
+    _queue_count--;
+
+}
+
+    /**
+     * @brief Loads free hardware mailboxes from the queue.
+     *
+     * @details Algorithm:
+     * -# Read the free mailbox count; if every mailbox is free, forget the
+     *    mailbox records (covers drivers that never report TX-complete)
+     * -# While a mailbox is free and a frame may go, hand the lowest-identifier
+     *    candidate to the driver, record it in flight and drop it from the queue
+     *
+     * Caller holds the shared-resource lock or runs in interrupt context.
+     *
+     * @return true if any frame was loaded.
+     */
+static bool _fill_mailboxes(void) {
+
+    bool loaded = false;
+    uint16_t free_mailboxes = _interface->get_free_tx_mailbox_count();
+
+    if (free_mailboxes >= USER_DEFINED_CAN_TX_MAILBOX_COUNT) {
+
+        _in_flight_count = 0;
+
+    }
+
+    while ((free_mailboxes > 0) && (_in_flight_count < USER_DEFINED_CAN_TX_MAILBOX_COUNT)) {
+
+        int index = _select_next();
+
+        if (index < 0) {
+
+            break;
+
+        }
+
+        if (!_interface->transmit_raw_can_frame(&_queue[index])) {
+
+            break;
+
+        }
+
+        _in_flight[_in_flight_count] = _queue[index].identifier;
+        _in_flight_count++;
+        _remove(index);
+
+        free_mailboxes--;
+        loaded = true;
+
+    }
+
+    return loaded;
+
+}
+
+    /**
+     * @brief Queues a copy of a frame and loads any free mailboxes.
+     *
+     * @details Algorithm:
+     * -# If the queue is full, load mailboxes first to make room
+     * -# Return false if it is still full
+     * -# Append the frame and load mailboxes
+     *
+     * @verbatim
+     * @param can_msg  Frame to send.
+     * @endverbatim
+     *
+     * @return true if the frame was accepted.
+     */
+bool CanTxScheduler_queue_frame(can_msg_t *can_msg) {
+
+    _interface->lock_shared_resources();
+
+    if (_queue_count >= LEN_CAN_TX_QUEUE) {
+
+        _fill_mailboxes();
+
+    }
+
+    if (_queue_count >= LEN_CAN_TX_QUEUE) {
+
+        _interface->unlock_shared_resources();
+
+        return false;
+
+    }
+
+    _queue[_queue_count] = *can_msg;
+    _queue_count++;
+
+    _fill_mailboxes();
+
+    _interface->unlock_shared_resources();
+
+    return true;
+
+}
+
+    /** @brief Loads free mailboxes and returns true if the queue has room for another frame. */
+bool CanTxScheduler_is_ready(void) {
+
+    _interface->lock_shared_resources();
+
+    _fill_mailboxes();
+
+    bool result = _queue_count < LEN_CAN_TX_QUEUE;
+
+    _interface->unlock_shared_resources();
+
+    return result;
+
+}
+
+    /** @brief Polled refill; returns true if any frame was loaded. */
+bool CanTxScheduler_run(void) {
+
+    if (_queue_count == 0) {
+
+        return false;
+
+    }
+
+    _interface->lock_shared_resources();
+
+    bool result = _fill_mailboxes();
+
+    _interface->unlock_shared_resources();
+
+    return result;
+
+}
+
+    /**
+     * @brief Releases a completed mailbox and refills.
+     *
+     * @details Algorithm:
+     * -# Drop the first mailbox record matching identifier
+     * -# Load free mailboxes
+     *
+     * @verbatim
+     * @param identifier  Identifier of the frame that left the controller.
+     * @endverbatim
+     */
+void CanTxScheduler_on_tx_complete(uint32_t identifier) {
+
+    for (int i = 0; i < _in_flight_count; i++) {
+
+        if (_in_flight[i] == identifier) {
+
+            _in_flight_count--;
+            _in_flight[i] = _in_flight[_in_flight_count];
+
+            break;
+
+        }
+
+    }
+
+    _fill_mailboxes();
+
+}
+
+    /** @brief Returns the number of frames waiting in the queue. */
+uint16_t CanTxScheduler_get_queued_count(void) {
+
+    return _queue_count;
+
+}
@@ -0,0 +1,161 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file can_tx_scheduler.h
+ * @brief Priority scheduler feeding several CAN controller TX mailboxes.
+ *
+ * @details Without the scheduler the stack treats the controller as having one
+ * TX slot and frames leave strictly in the order they were built.  With it,
+ * frames from the transmit message handler wait in a queue of
+ * USER_DEFINED_CAN_TX_QUEUE_DEPTH and every free mailbox is loaded with the
+ * lowest-identifier (highest-priority) frame that may go next, so control
+ * frames and high-priority messages win locally as they would on the bus.
+ *
+ * Two rules keep OpenLCB ordering intact.  A frame never overtakes an earlier
+ * queued frame from the same source alias, and only one frame per source
+ * alias sits in a mailbox at a time, because the controller itself arbitrates
+ * between its mailboxes by identifier.  Priority therefore applies between
+ * aliases (virtual nodes, the alias pool, logins) and never inside one
+ * node's message stream.
+ *
+ * Mailboxes are refilled from the driver's TX-complete interrupt through
+ * CanTxScheduler_on_tx_complete(), from every queue call, and once per main
+ * loop pass from CanTxScheduler_run() for drivers that only poll.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __DRIVERS_CANBUS_CAN_TX_SCHEDULER__
+#define __DRIVERS_CANBUS_CAN_TX_SCHEDULER__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_types.h"
+
+    /**
+     * @brief Dependency-injection interface for the TX scheduler.
+     *
+     * @details All function pointers are REQUIRED (must not be NULL).
+     *
+     * @see CanTxScheduler_initialize
+     */
+typedef struct {
+
+        /** @brief REQUIRED. Load one frame into a free hardware mailbox. Typical impl: application CAN driver function. */
+    bool (*transmit_raw_can_frame)(can_msg_t *can_msg);
+
+        /** @brief REQUIRED. Number of TX mailboxes currently free (0 to USER_DEFINED_CAN_TX_MAILBOX_COUNT). */
+    uint16_t (*get_free_tx_mailbox_count)(void);
+
+        /** @brief REQUIRED. Disable interrupts / acquire mutex. */
+    void (*lock_shared_resources)(void);
+
+        /** @brief REQUIRED. Re-enable interrupts / release mutex. */
+    void (*unlock_shared_resources)(void);
+
+} interface_can_tx_scheduler_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+        /**
+         * @brief Registers the interface and empties the queue.
+         *
+         * @param interface  Pointer to a populated @ref interface_can_tx_scheduler_t.
+         *                   Must remain valid for the lifetime of the application.
+         *
+         * @warning NOT thread-safe - call during single-threaded initialization only.
+         */
+    extern void CanTxScheduler_initialize(const interface_can_tx_scheduler_t *interface);
+
+        /**
+         * @brief Queues a copy of a frame and loads any free mailboxes.
+         *
+         * @details Drop-in replacement for the driver's transmit function in
+         * the transmit message handler.
+         *
+         * @param can_msg  Frame to send; copied, so the caller may reuse it.
+         *
+         * @return true if the frame was queued or sent, false if the queue is
+         *         still full after the free mailboxes were loaded.
+         *
+         * @warning Locks shared resources.
+         */
+    extern bool CanTxScheduler_queue_frame(can_msg_t *can_msg);
+
+        /**
+         * @brief Loads free mailboxes and reports whether another frame fits.
+         *
+         * @details Drop-in replacement for the driver's is_tx_buffer_clear in
+         * the TX state machine.
+         *
+         * @return true if the queue has at least one free slot.
+         *
+         * @warning Locks shared resources.
+         */
+    extern bool CanTxScheduler_is_ready(void);
+
+        /**
+         * @brief Polled refill of free mailboxes, called once per main loop pass.
+         *
+         * @return true if any frame was loaded into a mailbox.
+         *
+         * @warning Locks shared resources.
+         */
+    extern bool CanTxScheduler_run(void);
+
+        /**
+         * @brief Tells the scheduler a mailbox finished and refills it.
+         *
+         * @details Call from the CAN driver's TX-complete interrupt with the
+         * identifier of the frame that just left.  Releases that frame's source
+         * alias so its next frame may be loaded.
+         *
+         * @param identifier  29-bit identifier of the completed frame.
+         *
+         * @warning Does not lock; call from interrupt context, or with shared
+         *          resources locked when called from the main loop.
+         */
+    extern void CanTxScheduler_on_tx_complete(uint32_t identifier);
+
+        /**
+         * @brief Returns the number of frames waiting in the queue.
+         *
+         * @return Frames queued but not yet loaded into a mailbox.
+         */
+    extern uint16_t CanTxScheduler_get_queued_count(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __DRIVERS_CANBUS_CAN_TX_SCHEDULER__ */
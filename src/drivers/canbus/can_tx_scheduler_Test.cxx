@@ -0,0 +1,303 @@
+/*******************************************************************************
+ * File: can_tx_scheduler_Test.cxx
+ *
+ * Description:
+ *   Test suite for the CanTxScheduler module (can_tx_scheduler.h/.c).
+ *   Uses a mock controller with a settable number of free mailboxes.
+ *
+ * Test Coverage:
+ *   - Immediate send when a mailbox is free
+ *   - Lowest identifier first across source aliases
+ *   - Per-alias ordering and one frame per alias in flight
+ *   - TX-complete refill and polled refill
+ *   - Queue full / is_ready, driver refusal
+ *
+ * Author: Jim Kueneman
+ * Date: 2026-10-18
+ ******************************************************************************/
+
+#include "test/main_Test.hxx"
+
+#include "can_types.h"
+#include "can_tx_scheduler.h"
+
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+
+/*******************************************************************************
+ * Mocks
+ ******************************************************************************/
+
+#define MAX_SENT 32
+
+static uint16_t _free_mailboxes = 0;
+static bool _transmit_fails = false;
+static uint32_t _sent[MAX_SENT];
+static uint8_t _sent_payload_count[MAX_SENT];
+static int _sent_count = 0;
+
+static bool _transmit_raw_can_frame(can_msg_t *can_msg) {
+
+    if (_transmit_fails || _free_mailboxes == 0) {
+
+        return false;
+
+    }
+
+    if (_sent_count < MAX_SENT) {
+
+        _sent[_sent_count] = can_msg->identifier;
+        _sent_payload_count[_sent_count] = can_msg->payload_count;
+        _sent_count++;
+
+    }
+
+    _free_mailboxes--;
+
+    return true;
+
+}
+
+static uint16_t _get_free_tx_mailbox_count(void) {
+
+    return _free_mailboxes;
+
+}
+
+static void _lock_shared_resources(void) {
+
+}
+
+static void _unlock_shared_resources(void) {
+
+}
+
+static const interface_can_tx_scheduler_t _interface = {
+
+    .transmit_raw_can_frame = &_transmit_raw_can_frame,
+    .get_free_tx_mailbox_count = &_get_free_tx_mailbox_count,
+    .lock_shared_resources = &_lock_shared_resources,
+    .unlock_shared_resources = &_unlock_shared_resources,
+
+};
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static void setup_test(uint16_t free_mailboxes) {
+
+    _free_mailboxes = free_mailboxes;
+    _transmit_fails = false;
+    _sent_count = 0;
+
+    CanTxScheduler_initialize(&_interface);
+
+}
+
+static bool queue(uint32_t identifier) {
+
+    can_msg_t msg = {};
+    msg.identifier = identifier;
+
+    return CanTxScheduler_queue_frame(&msg);
+
+}
+
+/** Hardware finished the frame: free its mailbox and report it. */
+static void complete(uint32_t identifier) {
+
+    _free_mailboxes++;
+    CanTxScheduler_on_tx_complete(identifier);
+
+}
+
+/*******************************************************************************
+ * Tests
+ ******************************************************************************/
+
+TEST(CanTxScheduler, sends_at_once_when_mailbox_free) {
+
+    setup_test(1);
+
+    can_msg_t msg = {};
+    msg.identifier = 0x195B4101;
+    msg.payload_count = 6;
+
+    EXPECT_TRUE(CanTxScheduler_queue_frame(&msg));
+
+    // The queue holds a copy; reusing the caller's frame changes nothing
+    msg.payload_count = 0;
+
+    ASSERT_EQ(_sent_count, 1);
+    EXPECT_EQ(_sent[0], 0x195B4101u);
+    EXPECT_EQ(_sent_payload_count[0], 6);
+    EXPECT_EQ(CanTxScheduler_get_queued_count(), 0);
+
+}
+
+TEST(CanTxScheduler, lowest_identifier_first_across_aliases) {
+
+    setup_test(0);
+
+    EXPECT_TRUE(queue(0x19A28101));  // addressed message, alias 0x101
+    EXPECT_TRUE(queue(0x195B4303));  // event report, alias 0x303
+    EXPECT_TRUE(queue(0x10700202));  // RID control frame, alias 0x202
+
+    EXPECT_EQ(_sent_count, 0);
+    EXPECT_EQ(CanTxScheduler_get_queued_count(), 3);
+
+    _free_mailboxes = 3;
+    EXPECT_TRUE(CanTxScheduler_run());
+
+    ASSERT_EQ(_sent_count, 3);
+    EXPECT_EQ(_sent[0], 0x10700202u);
+    EXPECT_EQ(_sent[1], 0x195B4303u);
+    EXPECT_EQ(_sent[2], 0x19A28101u);
+
+}
+
+TEST(CanTxScheduler, fills_only_free_mailboxes_then_refills_on_complete) {
+
+    setup_test(0);
+
+    queue(0x19A28101);
+    queue(0x195B4202);
+    queue(0x19490303);
+
+    _free_mailboxes = 1;
+    CanTxScheduler_run();
+
+    ASSERT_EQ(_sent_count, 1);
+    EXPECT_EQ(_sent[0], 0x19490303u);
+
+    complete(0x19490303);
+
+    ASSERT_EQ(_sent_count, 2);
+    EXPECT_EQ(_sent[1], 0x195B4202u);
+
+    complete(0x195B4202);
+
+    ASSERT_EQ(_sent_count, 3);
+    EXPECT_EQ(_sent[2], 0x19A28101u);
+    EXPECT_EQ(CanTxScheduler_get_queued_count(), 0);
+
+}
+
+TEST(CanTxScheduler, same_alias_keeps_order_and_one_in_flight) {
+
+    setup_test(0);
+
+    // PCER-with-payload frames count down (first 0x0F16, last 0x0F14)
+    queue(0x1F16A101);
+    queue(0x1F15A101);
+    queue(0x1F14A101);
+    queue(0x195B4202);
+
+    _free_mailboxes = 3;
+    CanTxScheduler_run();
+
+    // Alias 0x202 overtakes, but alias 0x101 only gets its first frame in
+    ASSERT_EQ(_sent_count, 2);
+    EXPECT_EQ(_sent[0], 0x195B4202u);
+    EXPECT_EQ(_sent[1], 0x1F16A101u);
+
+    CanTxScheduler_run();
+    EXPECT_EQ(_sent_count, 2);
+
+    complete(0x1F16A101);
+
+    ASSERT_EQ(_sent_count, 3);
+    EXPECT_EQ(_sent[2], 0x1F15A101u);
+
+    complete(0x1F15A101);
+
+    ASSERT_EQ(_sent_count, 4);
+    EXPECT_EQ(_sent[3], 0x1F14A101u);
+
+}
+
+TEST(CanTxScheduler, identical_identifiers_go_one_at_a_time) {
+
+    setup_test(3);
+
+    queue(0x19A28101);
+    queue(0x19A28101);
+
+    EXPECT_EQ(_sent_count, 1);
+    EXPECT_EQ(CanTxScheduler_get_queued_count(), 1);
+
+    complete(0x19A28101);
+
+    EXPECT_EQ(_sent_count, 2);
+    EXPECT_EQ(CanTxScheduler_get_queued_count(), 0);
+
+}
+
+TEST(CanTxScheduler, polled_driver_releases_when_all_mailboxes_free) {
+
+    setup_test(USER_DEFINED_CAN_TX_MAILBOX_COUNT);
+
+    queue(0x19A28101);
+    queue(0x19A28101);
+
+    EXPECT_EQ(_sent_count, 1);
+
+    // Mailbox empties but the driver never calls on_tx_complete
+    _free_mailboxes = USER_DEFINED_CAN_TX_MAILBOX_COUNT;
+
+    EXPECT_TRUE(CanTxScheduler_run());
+    EXPECT_EQ(_sent_count, 2);
+
+    EXPECT_FALSE(CanTxScheduler_run());
+
+}
+
+TEST(CanTxScheduler, full_queue_refuses_until_mailbox_frees) {
+
+    setup_test(0);
+
+    for (int i = 0; i < USER_DEFINED_CAN_TX_QUEUE_DEPTH; i++) {
+
+        EXPECT_TRUE(queue(0x19A28000 | (uint32_t) (0x100 + i)));
+
+    }
+
+    EXPECT_FALSE(CanTxScheduler_is_ready());
+    EXPECT_FALSE(queue(0x195B4300));
+    EXPECT_EQ(CanTxScheduler_get_queued_count(), USER_DEFINED_CAN_TX_QUEUE_DEPTH);
+
+    _free_mailboxes = 1;
+
+    EXPECT_TRUE(CanTxScheduler_is_ready());
+    EXPECT_EQ(_sent_count, 1);
+    EXPECT_TRUE(queue(0x195B4300));
+
+}
+
+TEST(CanTxScheduler, driver_refusal_keeps_frame_queued) {
+
+    setup_test(2);
+    _transmit_fails = true;
+
+    EXPECT_TRUE(queue(0x195B4101));
+    EXPECT_EQ(_sent_count, 0);
+    EXPECT_EQ(CanTxScheduler_get_queued_count(), 1);
+
+    _transmit_fails = false;
+
+    EXPECT_TRUE(CanTxScheduler_run());
+    EXPECT_EQ(_sent_count, 1);
+    EXPECT_EQ(CanTxScheduler_get_queued_count(), 0);
+
+}
+
+TEST(CanTxScheduler, run_with_empty_queue_does_nothing) {
+
+    setup_test(3);
+
+    EXPECT_FALSE(CanTxScheduler_run());
+    EXPECT_TRUE(CanTxScheduler_is_ready());
+
+}
+
+#endif
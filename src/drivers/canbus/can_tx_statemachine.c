@@ -197,6 +197,43 @@ static bool _transmit_openlcb_message(openlcb_msg_t *openlcb_msg, can_msg_t *wor
 
     }
 
+}
+
+    /**
+     * @brief Looks up the alias of a destination Node ID.
+     *
+     * @details Algorithm:
+     * -# Try the listener alias table (train consist listeners).
+     * -# Fall back to the remote alias cache.
+     *
+     * @verbatim
+     * @param dest_id  48-bit Node ID of the destination.
+     * @endverbatim
+     *
+     * @return Resolved alias, or 0 if neither table knows dest_id.
+     */
+static uint16_t _resolve_dest_alias(node_id_t dest_id) {
+
+    if (_interface->listener_find_by_node_id) {
+
+        listener_alias_entry_t *entry = _interface->listener_find_by_node_id(dest_id);
+
+        if (entry && entry->alias != 0) {
+
+            return entry->alias;
+
+        }
+
+    }
+
+    if (_interface->remote_alias_cache_find_alias) {
+
+        return _interface->remote_alias_cache_find_alias(dest_id);
+
+    }
+
+    return 0;
+
 }
 
     /**
@@ -205,7 +242,8 @@ static bool _transmit_openlcb_message(openlcb_msg_t *openlcb_msg, can_msg_t *wor
      * @details Algorithm:
      * -# Discard immediately if state.invalid is set (AMR scrub marked it).
      * -# If dest_alias == 0 and dest_id != 0, resolve the alias via
-     *    listener_find_by_node_id (DI, nullable). Drop the message if
+     *    listener_find_by_node_id, then remote_alias_cache_find_alias (DI,
+     *    nullable). Drop the message if
      *    unresolvable (return true so the caller clears the outgoing slot).
      * -# Return false immediately if the TX hardware buffer is busy.
      * -# If payload_count == 0: send a single zero-payload frame and return.
@@ -229,19 +267,14 @@ bool CanTxStatemachine_send_openlcb_message(openlcb_msg_t *openlcb_msg) {
 
     }
 
-    // Resolve listener alias via DI if needed (forwarded consist commands)
-    if (openlcb_msg->dest_alias == 0) {
-
-        if (openlcb_msg->dest_id != 0 && _interface->listener_find_by_node_id) {
-
-            listener_alias_entry_t *entry =
-                    _interface->listener_find_by_node_id(openlcb_msg->dest_id);
+    // Resolve dest alias via DI if needed (forwarded consist commands, address by Node ID)
+    if (openlcb_msg->dest_alias == 0 && openlcb_msg->dest_id != 0) {
 
-            if (entry && entry->alias != 0) {
+        if (_interface->listener_find_by_node_id || _interface->remote_alias_cache_find_alias) {
 
-                openlcb_msg->dest_alias = entry->alias;
+            openlcb_msg->dest_alias = _resolve_dest_alias(openlcb_msg->dest_id);
 
-            } else {
+            if (openlcb_msg->dest_alias == 0) {
 
                 return true;  // alias unresolvable — drop message, don't retry
 
@@ -49,7 +49,8 @@ extern "C" {
      * @brief Dependency-injection interface for the CAN transmit state machine.
      *
      * @details The first 6 pointers are REQUIRED (must not be NULL).
-     * listener_find_by_node_id is OPTIONAL (NULL = feature not linked in).
+     * listener_find_by_node_id and remote_alias_cache_find_alias are OPTIONAL
+     * (NULL = feature not linked in).
      *
      * @see CanTxStatemachine_initialize
      */
@@ -85,6 +86,18 @@ extern "C" {
          */
         listener_alias_entry_t *(*listener_find_by_node_id)(node_id_t node_id);
 
+        /**
+         * @brief OPTIONAL. Resolve any remote Node ID to its CAN alias.
+         *
+         * @details Consulted after listener_find_by_node_id when dest_alias == 0
+         * and dest_id != 0, so the application can address a message by Node ID
+         * alone.  Returns 0 when the Node ID is not cached.  NULL = remote alias
+         * cache not linked in.
+         *
+         * @note Typical: RemoteAliasCache_find_alias. May be NULL.
+         */
+        uint16_t (*remote_alias_cache_find_alias)(node_id_t node_id);
+
 #ifdef OPENLCB_COMPILE_TRAIN
 
         /**
@@ -1341,6 +1341,133 @@ TEST(CanTxStatemachine, no_listener_find_skips_resolution)
 
 }
 
+/*******************************************************************************
+ * Remote Alias Cache Resolution Tests
+ ******************************************************************************/
+
+node_id_t _remote_cache_last_arg = 0;
+uint16_t _remote_cache_return_value = 0;
+
+/**
+ * Mock remote_alias_cache_find_alias: records the query, returns the
+ * configured alias (0 = miss)
+ */
+uint16_t _mock_remote_alias_cache_find_alias(node_id_t node_id)
+{
+
+    _remote_cache_last_arg = node_id;
+
+    return _remote_cache_return_value;
+
+}
+
+const interface_can_tx_statemachine_t interface_can_tx_statemachine_with_remote_cache = {
+    .is_tx_buffer_empty = &_is_can_tx_buffer_empty,
+    .handle_addressed_msg_frame = &_handle_addressed_msg_frame,
+    .handle_unaddressed_msg_frame = &_handle_unaddressed_msg_frame,
+    .handle_datagram_frame = &_handle_datagram_frame,
+    .handle_stream_frame = &_handle_stream_frame,
+    .handle_can_frame = &_handle_can_frame,
+    .listener_find_by_node_id = &_mock_listener_find_by_node_id,
+    .remote_alias_cache_find_alias = &_mock_remote_alias_cache_find_alias
+};
+
+/**
+ * Test: Listener table misses, remote alias cache resolves the Node ID
+ * Verifies:
+ * - The listener table is consulted first
+ * - The cache result becomes dest_alias and the message is transmitted
+ */
+TEST(CanTxStatemachine, remote_cache_resolves_alias_after_listener_miss)
+{
+
+    OpenLcbBufferStore_initialize();
+    CanTxStatemachine_initialize(&interface_can_tx_statemachine_with_remote_cache);
+    _reset_variables();
+    _remote_cache_last_arg = 0;
+    _remote_cache_return_value = 0x456;
+
+    openlcb_msg_t *openlcb_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(openlcb_msg, nullptr);
+
+    OpenLcbUtilities_load_openlcb_message(openlcb_msg, 0xAAA, 0x010203040506,
+                                           0x000, 0x060504030201,
+                                           MTI_VERIFY_NODE_ID_ADDRESSED);
+
+    EXPECT_TRUE(CanTxStatemachine_send_openlcb_message(openlcb_msg));
+
+    EXPECT_TRUE(_listener_find_by_node_id_called);
+    EXPECT_EQ(_remote_cache_last_arg, (node_id_t) 0x060504030201);
+    EXPECT_EQ(openlcb_msg->dest_alias, 0x456);
+    EXPECT_TRUE(_handle_addressed_msg_frame_called);
+
+    OpenLcbBufferStore_free_buffer(openlcb_msg);
+
+}
+
+/**
+ * Test: Listener table hit wins over the remote alias cache
+ */
+TEST(CanTxStatemachine, listener_hit_skips_remote_cache)
+{
+
+    OpenLcbBufferStore_initialize();
+    CanTxStatemachine_initialize(&interface_can_tx_statemachine_with_remote_cache);
+    _reset_variables();
+    _remote_cache_last_arg = 0;
+    _remote_cache_return_value = 0x456;
+
+    _listener_mock_entry.node_id = 0x060504030201;
+    _listener_mock_entry.alias = 0x123;
+    _listener_find_return_value = &_listener_mock_entry;
+
+    openlcb_msg_t *openlcb_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(openlcb_msg, nullptr);
+
+    OpenLcbUtilities_load_openlcb_message(openlcb_msg, 0xAAA, 0x010203040506,
+                                           0x000, 0x060504030201,
+                                           MTI_VERIFY_NODE_ID_ADDRESSED);
+
+    EXPECT_TRUE(CanTxStatemachine_send_openlcb_message(openlcb_msg));
+
+    EXPECT_EQ(_remote_cache_last_arg, (node_id_t) 0);
+    EXPECT_EQ(openlcb_msg->dest_alias, 0x123);
+
+    OpenLcbBufferStore_free_buffer(openlcb_msg);
+
+}
+
+/**
+ * Test: Neither the listener table nor the cache know the Node ID
+ * Verifies:
+ * - The message is dropped (returns true, nothing transmitted)
+ */
+TEST(CanTxStatemachine, remote_cache_miss_drops_message)
+{
+
+    OpenLcbBufferStore_initialize();
+    CanTxStatemachine_initialize(&interface_can_tx_statemachine_with_remote_cache);
+    _reset_variables();
+    _remote_cache_last_arg = 0;
+    _remote_cache_return_value = 0;
+
+    openlcb_msg_t *openlcb_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(openlcb_msg, nullptr);
+
+    OpenLcbUtilities_load_openlcb_message(openlcb_msg, 0xAAA, 0x010203040506,
+                                           0x000, 0x060504030201,
+                                           MTI_VERIFY_NODE_ID_ADDRESSED);
+
+    EXPECT_TRUE(CanTxStatemachine_send_openlcb_message(openlcb_msg));
+
+    EXPECT_EQ(_remote_cache_last_arg, (node_id_t) 0x060504030201);
+    EXPECT_FALSE(_handle_addressed_msg_frame_called);
+    EXPECT_FALSE(_is_can_tx_buffer_empty_called);
+
+    OpenLcbBufferStore_free_buffer(openlcb_msg);
+
+}
+
 #ifdef OPENLCB_COMPILE_TRAIN
 
 /*******************************************************************************
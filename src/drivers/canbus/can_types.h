@@ -82,15 +82,239 @@ extern "C" {
 
 #if USER_DEFINED_CAN_MSG_BUFFER_DEPTH < 1
 #error "USER_DEFINED_CAN_MSG_BUFFER_DEPTH must be >= 1 to avoid a zero-length array"
+#endif
+
+    /**
+     * @brief Number of aliases kept pre-reserved (CID/RID sent, no AMD) by can_alias_pool.h.
+     *
+     * @details A node allocated at run time claims one and sends AMD at once instead
+     * of running its own CID/200 ms/RID sequence.  0 disables the pool.  Each slot
+     * also takes one entry in the alias mapping table.
+     *
+     * Override at compile time: -D USER_DEFINED_ALIAS_POOL_DEPTH=4
+     */
+#ifndef USER_DEFINED_ALIAS_POOL_DEPTH
+#define USER_DEFINED_ALIAS_POOL_DEPTH 0
+#endif
+
+#if (USER_DEFINED_ALIAS_POOL_DEPTH < 0) || (USER_DEFINED_ALIAS_POOL_DEPTH > 255)
+#error "USER_DEFINED_ALIAS_POOL_DEPTH must be 0-255"
+#endif
+
+    /**
+     * @brief Minimum 100 ms ticks between two pool reservations being started.
+     *
+     * @details Limits the bus load of refilling; 0 starts one reservation per
+     * CanMainStatemachine_run() call until the pool is full.
+     */
+#ifndef USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS
+#define USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS 1
+#endif
+
+    /**
+     * @brief First placeholder Node ID the pool reserves aliases under; slot n uses base + n.
+     *
+     * @details Must be taken from a Node ID range the device owns so placeholder
+     * CID frames never carry another device's ID, and it seeds the pool's alias
+     * generator so two devices do not walk the same alias sequence.  There is no
+     * default: it is required when USER_DEFINED_ALIAS_POOL_DEPTH > 0.  It may be
+     * a run-time expression (e.g. read from the unit's serial number); it is first
+     * evaluated when the pool starts its first reservation.
+     */
+#if (USER_DEFINED_ALIAS_POOL_DEPTH > 0) && !defined(USER_DEFINED_ALIAS_POOL_NODE_ID_BASE)
+#error "USER_DEFINED_ALIAS_POOL_NODE_ID_BASE must be defined (from a Node ID range the device owns) when USER_DEFINED_ALIAS_POOL_DEPTH > 0"
+#endif
+
+#ifndef USER_DEFINED_ALIAS_POOL_NODE_ID_BASE
+#define USER_DEFINED_ALIAS_POOL_NODE_ID_BASE 0ULL  // pool disabled, never transmitted
+#endif
+
+    /**
+     * @brief Number of remote alias / Node ID pairs remembered by remote_alias_cache.h.
+     *
+     * @details Filled passively from AMD, Verified Node ID and Initialization
+     * Complete traffic so incoming messages carry source_id and outgoing messages
+     * can be addressed by dest_id alone.  Least recently used entries are
+     * replaced when full.  0 disables the cache.
+     *
+     * Override at compile time: -D USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH=32
+     */
+#ifndef USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH
+#define USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH 0
+#endif
+
+#if (USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH < 0) || (USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH > 4095)
+#error "USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH must be 0-4095"
+#endif
+
+    /**
+     * @brief Number of hardware CAN acceptance filters (ID/mask pairs) available.
+     *
+     * @details can_acceptance_filter.h builds at most this many filters from the
+     * alias table and hands them to can_config_t.on_acceptance_filters_changed
+     * whenever an alias changes.  0 disables the generator.
+     *
+     * Override at compile time: -D USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT=14
+     */
+#ifndef USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT
+#define USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT 0
+#endif
+
+#if (USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT < 0) || (USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 255)
+#error "USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT must be 0-255"
+#endif
+
+    /**
+     * @brief Registered listener count at which alias verification switches to bulk rounds.
+     *
+     * @details Below it, alias_mapping_listener.h probes one listener per
+     * USER_DEFINED_LISTENER_PROBE_TICK_INTERVAL with a targeted AME.  At or above
+     * it, all listeners are revalidated together by one global AME every
+     * USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS.  0 keeps targeted probing always.
+     *
+     * Override at compile time: -D USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD=64
+     */
+#ifndef USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD
+#define USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD 32
+#endif
+
+#if (USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD < 0) || (USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD > 16384)
+#error "USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD must be 0-16384"
+#endif
+
+    /**
+     * @brief Nominal CAN bit rate in bits per second, used by the bus-load monitor.
+     *
+     * @details can_bus_monitor.h counts RX and TX frames and estimated bits per
+     * 100 ms tick and reports utilisation against this rate.  0 disables the
+     * monitor.  LCC segments run at 125000.
+     *
+     * Override at compile time: -D USER_DEFINED_CAN_BUS_MONITOR_BITRATE=125000
+     */
+#ifndef USER_DEFINED_CAN_BUS_MONITOR_BITRATE
+#define USER_DEFINED_CAN_BUS_MONITOR_BITRATE 0
+#endif
+
+#if (USER_DEFINED_CAN_BUS_MONITOR_BITRATE < 0) || (USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 1000000)
+#error "USER_DEFINED_CAN_BUS_MONITOR_BITRATE must be 0-1000000"
+#endif
+
+    /**
+     * @brief Average bus utilisation (percent) above which low-priority traffic is deferred.
+     *
+     * @details While the monitor's smoothed utilisation is at or above this value,
+     * multi-message event enumeration and config-memory stream pumping wait.
+     * 0 never defers.  Requires USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0.
+     */
+#ifndef USER_DEFINED_CAN_BUS_THROTTLE_PERCENT
+#define USER_DEFINED_CAN_BUS_THROTTLE_PERCENT 0
+#endif
+
+#if (USER_DEFINED_CAN_BUS_THROTTLE_PERCENT < 0) || (USER_DEFINED_CAN_BUS_THROTTLE_PERCENT > 100)
+#error "USER_DEFINED_CAN_BUS_THROTTLE_PERCENT must be 0-100"
+#endif
+
+    /**
+     * @brief Frames held by the TX priority scheduler.  0 disables it.
+     *
+     * @details When > 0 and the driver supplies get_free_tx_mailbox_count, frames
+     * wait in this queue and the scheduler loads every free hardware mailbox with
+     * the lowest-identifier frame that may go next.
+     *
+     * Override at compile time: -D USER_DEFINED_CAN_TX_QUEUE_DEPTH=8
+     */
+#ifndef USER_DEFINED_CAN_TX_QUEUE_DEPTH
+#define USER_DEFINED_CAN_TX_QUEUE_DEPTH 0
+#endif
+
+#if (USER_DEFINED_CAN_TX_QUEUE_DEPTH < 0) || (USER_DEFINED_CAN_TX_QUEUE_DEPTH > 255)
+#error "USER_DEFINED_CAN_TX_QUEUE_DEPTH must be 0-255"
+#endif
+
+    /**
+     * @brief Number of transmit mailboxes in the CAN controller.
+     *
+     * Override at compile time: -D USER_DEFINED_CAN_TX_MAILBOX_COUNT=3
+     */
+#ifndef USER_DEFINED_CAN_TX_MAILBOX_COUNT
+#define USER_DEFINED_CAN_TX_MAILBOX_COUNT 1
+#endif
+
+#if (USER_DEFINED_CAN_TX_MAILBOX_COUNT < 1) || (USER_DEFINED_CAN_TX_MAILBOX_COUNT > 32)
+#error "USER_DEFINED_CAN_TX_MAILBOX_COUNT must be 1-32"
 #endif
 
     // *********************END USER DEFINED VARIABLES *****************************
 
-    /** @brief Number of @ref alias_mapping_t slots. Defaults to USER_DEFINED_NODE_BUFFER_DEPTH. */
+    /** @brief Number of @ref alias_mapping_t slots. Defaults to one per node plus one per pool slot. */
 #ifndef ALIAS_MAPPING_BUFFER_DEPTH
-#define ALIAS_MAPPING_BUFFER_DEPTH USER_DEFINED_NODE_BUFFER_DEPTH
+#define ALIAS_MAPPING_BUFFER_DEPTH (USER_DEFINED_NODE_BUFFER_DEPTH + USER_DEFINED_ALIAS_POOL_DEPTH)
+#endif
+
+    /**
+     * @brief Bucket count of a hash index over n table slots.
+     *
+     * @details Smallest power of two >= 2n, so the load factor stays at or below
+     * one half and every linear-probe chain ends on an empty bucket.
+     *
+     * @see CanUtilities_hash_index_insert
+     */
+#define CAN_HASH_INDEX_SIZE(n) \
+    (((n) * 2) <= 8 ? 8 : ((n) * 2) <= 16 ? 16 : ((n) * 2) <= 32 ? 32 : \
+     ((n) * 2) <= 64 ? 64 : ((n) * 2) <= 128 ? 128 : ((n) * 2) <= 256 ? 256 : \
+     ((n) * 2) <= 512 ? 512 : ((n) * 2) <= 1024 ? 1024 : ((n) * 2) <= 2048 ? 2048 : \
+     ((n) * 2) <= 4096 ? 4096 : ((n) * 2) <= 8192 ? 8192 : ((n) * 2) <= 16384 ? 16384 : 32768)
+
+#if ALIAS_MAPPING_BUFFER_DEPTH > 16384
+#error "ALIAS_MAPPING_BUFFER_DEPTH must be <= 16384"
+#endif
+
+    /** @brief Buckets in each of the alias mapping table's alias and Node ID indexes. */
+#define ALIAS_MAPPING_HASH_SIZE CAN_HASH_INDEX_SIZE(ALIAS_MAPPING_BUFFER_DEPTH)
+
+    /** @brief Alias pool array length — at least 1 so a disabled pool still compiles. */
+#if USER_DEFINED_ALIAS_POOL_DEPTH > 0
+#define LEN_ALIAS_POOL USER_DEFINED_ALIAS_POOL_DEPTH
+#else
+#define LEN_ALIAS_POOL 1
+#endif
+
+    /** @brief Alias pool slot is unused. */
+#define ALIAS_POOL_STATE_EMPTY 0
+
+    /** @brief CID7..CID4 queued; the 200 ms reservation window runs once CID4 is transmitted. */
+#define ALIAS_POOL_STATE_WAIT 1
+
+    /** @brief RID sent; alias is reserved and ready to be claimed. */
+#define ALIAS_POOL_STATE_RESERVED 2
+
+    /** @brief Remote alias cache array length — at least 1 so a disabled cache still compiles. */
+#if USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH > 0
+#define LEN_REMOTE_ALIAS_CACHE USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH
+#else
+#define LEN_REMOTE_ALIAS_CACHE 1
+#endif
+
+    /** @brief Acceptance filter array length — at least 1 so a disabled generator still compiles. */
+#if USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT > 0
+#define LEN_CAN_ACCEPTANCE_FILTER USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT
+#else
+#define LEN_CAN_ACCEPTANCE_FILTER 1
+#endif
+
+    /** @brief Frame-rate histogram buckets: 0, 1, 2-3, 4-7, ... 64-127, 128+ frames per tick. */
+#define CAN_BUS_MONITOR_HISTOGRAM_BUCKETS 9
+
+    /** @brief TX scheduler queue length — at least 1 so a disabled scheduler still compiles. */
+#if USER_DEFINED_CAN_TX_QUEUE_DEPTH > 0
+#define LEN_CAN_TX_QUEUE USER_DEFINED_CAN_TX_QUEUE_DEPTH
+#else
+#define LEN_CAN_TX_QUEUE 1
 #endif
 
+    /** @brief Bytes in a bitmap with one bit per 12-bit alias (4096 bits). */
+#define ALIAS_BITMAP_BYTES 512
+
     /** @brief FIFO slot count — one extra slot so head==tail always means empty. */
 #define LEN_CAN_FIFO_BUFFER (USER_DEFINED_CAN_MSG_BUFFER_DEPTH + 1)
 
@@ -177,6 +401,8 @@ extern "C" {
         can_msg_t *outgoing_can_msg;              /**< @brief Pool-allocated reply frame; freed after TX. */
         uint8_t enumerating : 1;                  /**< @brief Set when the handler will produce N reply frames. */
         uint8_t current_tick;                     /**< @brief Snapshot of the global 100ms tick for login timing. */
+        uint32_t current_time_ms;                 /**< @brief Snapshot of the millisecond clock for login timing. */
+        uint8_t use_time_ms : 1;                  /**< @brief Time the login wait in ms (current_time_ms) rather than ticks. */
     } can_statemachine_info_t;
 
     /**
@@ -195,6 +421,53 @@ extern "C" {
         uint8_t is_permitted : 1; /**< @brief Set after successful login (AMD transmitted). */
     } alias_mapping_t;
 
+    /**
+     * @typedef can_acceptance_filter_t
+     * @brief One 29-bit extended-ID acceptance filter.
+     *
+     * @details A frame passes when (identifier & mask) == (id & mask).  Bits clear
+     * in mask are "don't care".  This is the ID/mask form used by bxCAN, TWAI,
+     * ECAN and most other controllers.
+     */
+    typedef struct can_acceptance_filter_struct {
+        uint32_t id;   /**< @brief Identifier bits to match (already masked). */
+        uint32_t mask; /**< @brief 1 = bit must match, 0 = don't care. */
+    } can_acceptance_filter_t;
+
+    /**
+     * @typedef can_bus_monitor_stats_t
+     * @brief Bus-load figures kept by the CAN bus monitor.
+     *
+     * @details Per-tick figures describe the last closed 100 ms window.  Totals
+     * and the histogram run from initialization or the last reset.
+     *
+     * @see can_bus_monitor.h
+     */
+    typedef struct can_bus_monitor_stats_struct {
+
+        uint8_t utilisation_percent;         /**< @brief Utilisation of the last window (0-100). */
+        uint8_t average_utilisation_percent; /**< @brief Smoothed utilisation (1/4 weight per window) that drives throttling. */
+        uint8_t peak_utilisation_percent;    /**< @brief Highest single-window utilisation. */
+        uint16_t rx_frames_per_tick;         /**< @brief Frames received in the last window. */
+        uint16_t tx_frames_per_tick;         /**< @brief Frames transmitted in the last window. */
+        uint32_t rx_frames;                  /**< @brief Frames received in total. */
+        uint32_t tx_frames;                  /**< @brief Frames transmitted in total. */
+        uint32_t error_frames;               /**< @brief Bus error frames reported by the driver. */
+        uint32_t ticks;                      /**< @brief 100 ms windows closed. */
+        uint32_t frame_rate_histogram[CAN_BUS_MONITOR_HISTOGRAM_BUCKETS]; /**< @brief Windows per RX+TX frame-count bucket. */
+
+    } can_bus_monitor_stats_t;
+
+    /**
+     * @typedef alias_bitmap_t
+     * @brief One bit per 12-bit alias; bit n set means alias n is in use.
+     *
+     * @details O(1) membership filter in front of the alias hash indexes.
+     *
+     * @see CanUtilities_is_alias_bit_set
+     */
+    typedef uint8_t alias_bitmap_t[ALIAS_BITMAP_BYTES];
+
     /**
      * @typedef alias_mapping_info_t
      * @brief Container for all @ref alias_mapping_t entries plus a global duplicate flag.
@@ -210,10 +483,46 @@ extern "C" {
         bool has_duplicate_alias;                          /**< @brief True if any entry has is_duplicate set. */
     } alias_mapping_info_t;
 
+    /**
+     * @typedef alias_pool_entry_t
+     * @brief One pre-reserved alias held under a placeholder Node ID.
+     *
+     * @see can_alias_pool.h
+     */
+    typedef struct alias_pool_entry_struct {
+
+        uint16_t alias;     /**< @brief Reserved 12-bit alias (0 when the slot is empty). */
+        uint8_t state;      /**< @brief ALIAS_POOL_STATE_EMPTY, _WAIT or _RESERVED. */
+        uint8_t timerticks; /**< @brief Tick at which CID4 was transmitted, starting the 200 ms window. */
+        bool cid4_sent;     /**< @brief True once the slot's CID4 has been handed to the CAN driver. */
+
+    } alias_pool_entry_t;
+
+    /**
+     * @typedef remote_alias_cache_entry_t
+     * @brief One remembered remote @ref node_id_t / 12-bit alias pair.
+     *
+     * @see remote_alias_cache.h
+     */
+    typedef struct remote_alias_cache_entry_struct {
+
+        node_id_t node_id;  /**< @brief Remote Node ID. 0 = unused. */
+        uint16_t alias;     /**< @brief Remote CAN alias last seen for node_id. */
+        uint16_t last_used; /**< @brief Use-counter stamp for LRU replacement. */
+
+    } remote_alias_cache_entry_t;
+
     /** @brief Total listener alias table slots across all train nodes. */
 #define LISTENER_ALIAS_TABLE_DEPTH \
     (USER_DEFINED_MAX_LISTENERS_PER_TRAIN * USER_DEFINED_TRAIN_NODE_COUNT)
 
+#if LISTENER_ALIAS_TABLE_DEPTH > 16384
+#error "USER_DEFINED_MAX_LISTENERS_PER_TRAIN * USER_DEFINED_TRAIN_NODE_COUNT must be <= 16384"
+#endif
+
+    /** @brief Buckets in each of the listener table's alias and Node ID indexes. */
+#define LISTENER_ALIAS_HASH_SIZE CAN_HASH_INDEX_SIZE(LISTENER_ALIAS_TABLE_DEPTH)
+
     /**
      * @typedef listener_alias_entry_t
      * @brief One entry in the listener alias table: a @ref node_id_t / 12-bit alias pair.
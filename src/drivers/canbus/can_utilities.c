@@ -476,4 +476,220 @@ bool CanUtilities_is_openlcb_message(can_msg_t *can_msg) {
 
     return (can_msg->identifier & CAN_OPENLCB_MSG) == CAN_OPENLCB_MSG;
 
+}
+
+    /**
+     * @brief Advances a 48-bit seed one step using the OpenLCB LFSR algorithm.
+     *
+     * @details Splits the seed into two 24-bit halves (lfsr1 = upper, lfsr2 = lower),
+     * applies shift-and-add with magic constants 0x1B0CA3 and 0x7A4BA9 per TN §6.1.3,
+     * then recombines. Ensures a different alias is produced on each conflict retry.
+     *
+     * @verbatim
+     * @param start_seed Current 48-bit seed.
+     * @endverbatim
+     *
+     * @return New 48-bit seed.
+     *
+     * @see CanLoginMessageHandler_state_generate_seed
+     */
+uint64_t CanUtilities_generate_seed(uint64_t start_seed) {
+
+    uint32_t lfsr2 = start_seed & 0xFFFFFF;         // lower 24 bits
+    uint32_t lfsr1 = (start_seed >> 24) & 0xFFFFFF; // upper 24 bits
+
+    uint32_t temp1 = ((lfsr1 << 9) | ((lfsr2 >> 15) & 0x1FF)) & 0xFFFFFF;
+    uint32_t temp2 = (lfsr2 << 9) & 0xFFFFFF;
+
+    lfsr1 = lfsr1 + temp1 + 0x1B0CA3L;
+    lfsr2 = lfsr2 + temp2 + 0x7A4BA9L;
+
+    lfsr1 = (lfsr1 & 0xFFFFFF) + ((lfsr2 & 0xFF000000) >> 24);
+    lfsr2 = lfsr2 & 0xFFFFFF;
+
+    return ( (uint64_t) lfsr1 << 24) | lfsr2;
+
+}
+
+    /**
+     * @brief Extracts a 12-bit alias from a 48-bit seed.
+     *
+     * @details XORs the two 24-bit halves of the seed and their upper 12 bits,
+     * then masks to 12 bits. Returns 0x000-0xFFF; alias 0x000 is invalid per spec.
+     *
+     * @verbatim
+     * @param seed 48-bit seed value.
+     * @endverbatim
+     *
+     * @return 12-bit alias (0x000-0xFFF).
+     *
+     * @see CanLoginMessageHandler_state_generate_alias
+     */
+uint16_t CanUtilities_generate_alias(uint64_t seed) {
+
+    uint32_t lfsr2 = seed & 0xFFFFFF;
+    uint32_t lfsr1 = (seed >> 24) & 0xFFFFFF;
+
+    return ( lfsr1 ^ lfsr2 ^ (lfsr1 >> 12) ^ (lfsr2 >> 12)) & 0x0FFF;
+
+}
+
+    /** @brief Sets bit (alias & 0xFFF) of the bitmap. */
+void CanUtilities_set_alias_bit(alias_bitmap_t bitmap, uint16_t alias) {
+
+    alias &= 0x0FFF;
+
+    bitmap[alias >> 3] |= (uint8_t) (1 << (alias & 0x07));
+
+}
+
+    /** @brief Clears bit (alias & 0xFFF) of the bitmap. */
+void CanUtilities_clear_alias_bit(alias_bitmap_t bitmap, uint16_t alias) {
+
+    alias &= 0x0FFF;
+
+    bitmap[alias >> 3] &= (uint8_t) ~(1 << (alias & 0x07));
+
+}
+
+    /** @brief Returns bit (alias & 0xFFF) of the bitmap. */
+bool CanUtilities_is_alias_bit_set(const alias_bitmap_t bitmap, uint16_t alias) {
+
+    alias &= 0x0FFF;
+
+    return (bitmap[alias >> 3] & (1 << (alias & 0x07))) != 0;
+
+}
+
+    /** @brief Fibonacci-hashing multiplier (2^32 / golden ratio). */
+#define CAN_HASH_MULTIPLIER 0x9E3779B1UL
+
+    /**
+     * @brief Maps an alias to its home bucket.
+     *
+     * @details Fibonacci hashing: multiply by 2^32/phi and keep the upper bits,
+     * so neighbouring aliases land far apart.
+     *
+     * @verbatim
+     * @param alias 12-bit CAN alias.
+     * @param mask  Bucket count - 1.
+     * @endverbatim
+     *
+     * @return Bucket number (0 to mask).
+     */
+uint16_t CanUtilities_hash_alias(uint16_t alias, uint16_t mask) {
+
+    return (uint16_t) ((((uint32_t) alias * CAN_HASH_MULTIPLIER) & 0xFFFFFFFFUL) >> 16) & mask;
+
+}
+
+    /**
+     * @brief Maps a Node ID to its home bucket.
+     *
+     * @details Folds the 48 bits into 32 (so both the manufacturer prefix and the
+     * serial bits count), then Fibonacci-hashes the result.  Sequential Node IDs
+     * from one manufacturer spread across the index.
+     *
+     * @verbatim
+     * @param node_id 48-bit OpenLCB Node ID.
+     * @param mask    Bucket count - 1.
+     * @endverbatim
+     *
+     * @return Bucket number (0 to mask).
+     */
+uint16_t CanUtilities_hash_node_id(node_id_t node_id, uint16_t mask) {
+
+    uint32_t folded = (uint32_t) ((node_id ^ (node_id >> 24)) & 0xFFFFFFFFUL);
+
+    return (uint16_t) (((folded * CAN_HASH_MULTIPLIER) & 0xFFFFFFFFUL) >> 16) & mask;
+
+}
+
+    /** @brief Stores slot + 1 in the first empty bucket at or after home. */
+void CanUtilities_hash_index_insert(uint16_t *index, uint16_t mask, uint16_t home, uint16_t slot) {
+
+    uint16_t bucket = home;
+
+    while (index[bucket] != 0) {
+
+        bucket = (bucket + 1) & mask;
+
+    }
+
+    index[bucket] = slot + 1;
+
+}
+
+    /**
+     * @brief Deletes a slot from a linear-probing index by backward shifting.
+     *
+     * @details Algorithm:
+     * -# Probe from home for the bucket holding slot + 1; return if an empty
+     *    bucket is reached first (slot not indexed).
+     * -# Walk the following buckets until an empty one.  A bucket whose home
+     *    lies cyclically outside (hole, bucket] can move into the hole; move
+     *    it and make its old bucket the new hole.
+     * -# Empty the final hole.
+     *
+     * @verbatim
+     * @param index        Bucket array.
+     * @param mask         Bucket count - 1.
+     * @param home         Home bucket of the slot's key.
+     * @param slot         Table slot to remove.
+     * @param home_of_slot Returns the home bucket of another indexed slot.
+     * @endverbatim
+     */
+void CanUtilities_hash_index_remove(uint16_t *index, uint16_t mask, uint16_t home, uint16_t slot, uint16_t (*home_of_slot)(uint16_t slot)) {
+
+    uint16_t hole = home;
+
+    while (index[hole] != (uint16_t) (slot + 1)) {
+
+        if (index[hole] == 0) {
+
+            return;
+
+        }
+
+        hole = (hole + 1) & mask;
+
+    }
+
+    uint16_t bucket = hole;
+
+    while (true) {
+
+        bucket = (bucket + 1) & mask;
+
+        if (index[bucket] == 0) {
+
+            break;
+
+        }
+
+        uint16_t bucket_home = home_of_slot(index[bucket] - 1);
+
+        bool stays;
+
+        if (hole <= bucket) {
+
+            stays = (hole < bucket_home) && (bucket_home <= bucket);
+
+        } else {
+
+            stays = (hole < bucket_home) || (bucket_home <= bucket);
+
+        }
+
+        if (!stays) {
+
+            index[hole] = index[bucket];
+            hole = bucket;
+
+        }
+
+    }
+
+    index[hole] = 0;
+
 }
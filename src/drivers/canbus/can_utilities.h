@@ -232,6 +232,115 @@ extern "C" {
          */
     extern bool CanUtilities_is_openlcb_message(can_msg_t *can_msg);
 
+        /**
+         * @brief Advances a 48-bit alias seed one step of the OpenLCB LFSR (TN §6.1.3).
+         *
+         * @param start_seed  Current 48-bit seed.
+         *
+         * @return Next 48-bit seed.
+         *
+         * @see CanUtilities_generate_alias
+         */
+    extern uint64_t CanUtilities_generate_seed(uint64_t start_seed);
+
+        /**
+         * @brief Folds a 48-bit seed into a 12-bit alias candidate.
+         *
+         * @details May return 0x000, which is not a legal alias; callers advance
+         * the seed and try again.
+         *
+         * @param seed  48-bit seed value.
+         *
+         * @return 12-bit alias (0x000-0xFFF).
+         *
+         * @see CanUtilities_generate_seed
+         */
+    extern uint16_t CanUtilities_generate_alias(uint64_t seed);
+
+        /**
+         * @brief Marks an alias as present in an alias bitmap.
+         *
+         * @param bitmap  Bitmap to update.
+         * @param alias   12-bit CAN alias (bits above 11 are ignored).
+         */
+    extern void CanUtilities_set_alias_bit(alias_bitmap_t bitmap, uint16_t alias);
+
+        /**
+         * @brief Marks an alias as absent in an alias bitmap.
+         *
+         * @param bitmap  Bitmap to update.
+         * @param alias   12-bit CAN alias (bits above 11 are ignored).
+         */
+    extern void CanUtilities_clear_alias_bit(alias_bitmap_t bitmap, uint16_t alias);
+
+        /**
+         * @brief Tests an alias in an alias bitmap.
+         *
+         * @param bitmap  Bitmap to query.
+         * @param alias   12-bit CAN alias (bits above 11 are ignored).
+         *
+         * @return true if the alias bit is set.
+         */
+    extern bool CanUtilities_is_alias_bit_set(const alias_bitmap_t bitmap, uint16_t alias);
+
+        /**
+         * @brief Returns the home bucket of a 12-bit alias in a hash index.
+         *
+         * @param alias  12-bit CAN alias.
+         * @param mask   Bucket count - 1 (bucket count is a power of two).
+         *
+         * @return Bucket number (0 to mask).
+         *
+         * @see CAN_HASH_INDEX_SIZE
+         */
+    extern uint16_t CanUtilities_hash_alias(uint16_t alias, uint16_t mask);
+
+        /**
+         * @brief Returns the home bucket of a 48-bit Node ID in a hash index.
+         *
+         * @param node_id  48-bit OpenLCB Node ID.
+         * @param mask     Bucket count - 1 (bucket count is a power of two).
+         *
+         * @return Bucket number (0 to mask).
+         *
+         * @see CAN_HASH_INDEX_SIZE
+         */
+    extern uint16_t CanUtilities_hash_node_id(node_id_t node_id, uint16_t mask);
+
+        /**
+         * @brief Adds a table slot to an open-addressed hash index.
+         *
+         * @details Buckets hold slot + 1; 0 marks an empty bucket.  Linear probing
+         * from home.  The index must be sized with CAN_HASH_INDEX_SIZE so a free
+         * bucket always exists.
+         *
+         * @param index  Bucket array.
+         * @param mask   Bucket count - 1.
+         * @param home   Home bucket of the slot's key.
+         * @param slot   Table slot to add.
+         *
+         * @see CanUtilities_hash_index_remove
+         */
+    extern void CanUtilities_hash_index_insert(uint16_t *index, uint16_t mask, uint16_t home, uint16_t slot);
+
+        /**
+         * @brief Removes a table slot from an open-addressed hash index without tombstones.
+         *
+         * @details Following buckets are shifted back into the hole whenever that
+         * keeps them reachable from their own home bucket, so lookups never have
+         * to skip deleted markers.  The table must still hold the keys of every
+         * other indexed slot when this is called.
+         *
+         * @param index        Bucket array.
+         * @param mask         Bucket count - 1.
+         * @param home         Home bucket of the slot's key.
+         * @param slot         Table slot to remove.
+         * @param home_of_slot Returns the home bucket of another indexed slot.
+         *
+         * @see CanUtilities_hash_index_insert
+         */
+    extern void CanUtilities_hash_index_remove(uint16_t *index, uint16_t mask, uint16_t home, uint16_t slot, uint16_t (*home_of_slot)(uint16_t slot));
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
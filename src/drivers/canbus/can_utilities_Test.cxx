@@ -1227,6 +1227,56 @@ TEST(CAN_Utilities, extract_dest_comprehensive)
     }
 }
 
+/*
+ * Test: hash_index_wraparound_remove
+ * Keys whose home is the last bucket wrap to bucket 0; removing the first
+ * must shift the wrapped one back so it stays reachable.
+ */
+static uint16_t _test_slot_homes[4];
+
+static uint16_t _test_home_of_slot(uint16_t slot)
+{
+    return _test_slot_homes[slot];
+}
+
+TEST(CAN_Utilities, hash_index_wraparound_remove)
+{
+    uint16_t index[8] = {0};
+    const uint16_t mask = 7;
+
+    _test_slot_homes[0] = 7;
+    _test_slot_homes[1] = 7;
+    _test_slot_homes[2] = 0;
+
+    CanUtilities_hash_index_insert(index, mask, 7, 0);  // bucket 7
+    CanUtilities_hash_index_insert(index, mask, 7, 1);  // wraps to bucket 0
+    CanUtilities_hash_index_insert(index, mask, 0, 2);  // bucket 1
+
+    EXPECT_EQ(index[7], 1);
+    EXPECT_EQ(index[0], 2);
+    EXPECT_EQ(index[1], 3);
+
+    CanUtilities_hash_index_remove(index, mask, 7, 0, &_test_home_of_slot);
+
+    // Slot 1 moves home, slot 2 moves to its own home bucket 0
+    EXPECT_EQ(index[7], 2);
+    EXPECT_EQ(index[0], 3);
+    EXPECT_EQ(index[1], 0);
+
+    // Removing a slot that is not indexed changes nothing
+    CanUtilities_hash_index_remove(index, mask, 3, 3, &_test_home_of_slot);
+    EXPECT_EQ(index[7], 2);
+    EXPECT_EQ(index[0], 3);
+
+    // Hashes always land inside the mask
+    for (uint16_t alias = 1; alias <= 0xFFF; alias++)
+    {
+        EXPECT_LE(CanUtilities_hash_alias(alias, mask), mask);
+    }
+
+    EXPECT_LE(CanUtilities_hash_node_id(0xFFFFFFFFFFFFULL, 0x3F), 0x3F);
+}
+
 /*******************************************************************************
  * COVERAGE SUMMARY
  ******************************************************************************/
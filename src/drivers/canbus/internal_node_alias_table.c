@@ -29,7 +29,11 @@
  *
  * @details Single static buffer instance using a linear array.  Empty slots are
  * marked by alias = 0 and node_id = 0.  First-fit allocation.  One alias per
- * Node ID enforced.  NOT thread-safe.
+ * Node ID enforced.  Two open-addressed hash indexes (by alias and by Node ID,
+ * ALIAS_MAPPING_HASH_SIZE buckets each) make lookups constant time; deletion
+ * shifts probe chains back instead of leaving tombstones.  A 512-byte bitmap of
+ * registered aliases answers "not ours" for foreign aliases without touching
+ * either index.  NOT thread-safe.
  *
  * @author Jim Kueneman
  * @date 4 Mar 2026
@@ -43,18 +47,122 @@
 #include <stddef.h>
 
 #include "can_types.h"
+#include "can_utilities.h"
 #include "../../openlcb/openlcb_types.h"
 
+/** @brief Bucket mask for both hash indexes. */
+#define ALIAS_MAPPING_HASH_MASK ((uint16_t) (ALIAS_MAPPING_HASH_SIZE - 1))
+
 /** @brief Static storage for the alias mapping buffer and control flags. */
 static alias_mapping_info_t _alias_mapping_info;
 
+/** @brief Hash index by alias; each bucket holds list slot + 1, 0 = empty. */
+static uint16_t _alias_index[ALIAS_MAPPING_HASH_SIZE];
+
+/** @brief Hash index by Node ID; each bucket holds list slot + 1, 0 = empty. */
+static uint16_t _node_id_index[ALIAS_MAPPING_HASH_SIZE];
+
+/** @brief One bit per alias currently registered in the list. */
+static alias_bitmap_t _alias_bitmap;
+
+/** @brief Bumped whenever the set of registered aliases changes. */
+static uint16_t _change_count = 0;
+
+    /** @brief Returns the alias-index home bucket of the alias stored in a list slot. */
+static uint16_t _alias_home_of_slot(uint16_t slot) {
+
+    return CanUtilities_hash_alias(_alias_mapping_info.list[slot].alias, ALIAS_MAPPING_HASH_MASK);
+
+}
+
+    /** @brief Returns the Node ID-index home bucket of the Node ID stored in a list slot. */
+static uint16_t _node_id_home_of_slot(uint16_t slot) {
+
+    return CanUtilities_hash_node_id(_alias_mapping_info.list[slot].node_id, ALIAS_MAPPING_HASH_MASK);
+
+}
+
+    /**
+     * @brief Returns the list slot holding alias via the alias index.
+     *
+     * @verbatim
+     * @param alias  12-bit CAN alias (non-zero).
+     * @endverbatim
+     *
+     * @return Slot number, or -1 if not indexed.
+     */
+static int _find_slot_by_alias(uint16_t alias) {
+
+    uint16_t bucket = CanUtilities_hash_alias(alias, ALIAS_MAPPING_HASH_MASK);
+
+    while (_alias_index[bucket] != 0) {
+
+        int slot = _alias_index[bucket] - 1;
+
+        if (_alias_mapping_info.list[slot].alias == alias) {
+
+            return slot;
+
+        }
+
+        bucket = (bucket + 1) & ALIAS_MAPPING_HASH_MASK;
+
+    }
+
+    return -1;
+
+}
+
+    /**
+     * @brief Returns the list slot holding node_id via the Node ID index.
+     *
+     * @verbatim
+     * @param node_id  48-bit OpenLCB Node ID (non-zero).
+     * @endverbatim
+     *
+     * @return Slot number, or -1 if not indexed.
+     */
+static int _find_slot_by_node_id(node_id_t node_id) {
+
+    uint16_t bucket = CanUtilities_hash_node_id(node_id, ALIAS_MAPPING_HASH_MASK);
+
+    while (_node_id_index[bucket] != 0) {
+
+        int slot = _node_id_index[bucket] - 1;
+
+        if (_alias_mapping_info.list[slot].node_id == node_id) {
+
+            return slot;
+
+        }
+
+        bucket = (bucket + 1) & ALIAS_MAPPING_HASH_MASK;
+
+    }
+
+    return -1;
+
+}
+
+    /** @brief Clears the bitmap bit of a just-removed alias unless another slot still holds it. */
+static void _update_alias_bit(uint16_t alias) {
+
+    if (_find_slot_by_alias(alias) < 0) {
+
+        CanUtilities_clear_alias_bit(_alias_bitmap, alias);
+
+    }
+
+}
+
     /**
      * @brief Resets all mapping entries and clears the duplicate alias flag.
      *
      * @details Algorithm:
      * -# Iterate through all ALIAS_MAPPING_BUFFER_DEPTH entries
      * -# Set alias, node_id to 0 and both flags to false in each entry
-     * -# Clear the has_duplicate_alias flag
+     * -# Empty both hash indexes and the alias bitmap
+     * -# Clear the has_duplicate_alias flag and bump the change count
      *
      * @see InternalNodeAliasTable_initialize
      * @see InternalNodeAliasTable_flush
@@ -70,8 +178,23 @@ static void _reset_mappings(void) {
 
     }
 
+    for (int i = 0; i < ALIAS_MAPPING_HASH_SIZE; i++) {
+
+        _alias_index[i] = 0;
+        _node_id_index[i] = 0;
+
+    }
+
+    for (int i = 0; i < ALIAS_BITMAP_BYTES; i++) {
+
+        _alias_bitmap[i] = 0;
+
+    }
+
     _alias_mapping_info.has_duplicate_alias = false;
 
+    _change_count++;
+
 }
 
     /** @brief Initializes the alias mapping buffer, clearing all entries and flags. */
@@ -112,9 +235,10 @@ void InternalNodeAliasTable_clear_has_duplicate_alias_flag(void) {
      * @details Algorithm:
      * -# Validate alias is in range 0x001–0xFFF, return NULL if not
      * -# Validate node_id is in range 0x000000000001–0xFFFFFFFFFFFF, return NULL if not
-     * -# Iterate through all ALIAS_MAPPING_BUFFER_DEPTH entries
-     * -# On first empty slot (alias == 0) or matching Node ID: store alias and
-     *    node_id, return pointer to that entry
+     * -# If the Node ID is already indexed: move its entry to the new alias in
+     *    the alias index and bitmap and return it
+     * -# Otherwise take the first empty slot (alias == 0), store alias and
+     *    node_id, add it to both indexes and the bitmap and return it
      * -# If no slot found, return NULL (buffer full)
      *
      * Use cases:
@@ -153,13 +277,45 @@ alias_mapping_t *InternalNodeAliasTable_register(uint16_t alias, node_id_t node_
 
     }
 
+    int slot = _find_slot_by_node_id(node_id);
+
+    if (slot >= 0) {
+
+        alias_mapping_t *existing = &_alias_mapping_info.list[slot];
+
+        if (existing->alias != alias) {
+
+            uint16_t old_alias = existing->alias;
+
+            CanUtilities_hash_index_remove(_alias_index, ALIAS_MAPPING_HASH_MASK, _alias_home_of_slot(slot), slot, &_alias_home_of_slot);
+            existing->alias = alias;
+            CanUtilities_hash_index_insert(_alias_index, ALIAS_MAPPING_HASH_MASK, _alias_home_of_slot(slot), slot);
+
+            _update_alias_bit(old_alias);
+            CanUtilities_set_alias_bit(_alias_bitmap, alias);
+
+            _change_count++;
+
+        }
+
+        return existing;
+
+    }
+
     for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
 
-        if ((_alias_mapping_info.list[i].alias == 0) || (_alias_mapping_info.list[i].node_id == node_id)) {
+        if (_alias_mapping_info.list[i].alias == 0) {
 
             _alias_mapping_info.list[i].alias = alias;
             _alias_mapping_info.list[i].node_id = node_id;
 
+            CanUtilities_hash_index_insert(_alias_index, ALIAS_MAPPING_HASH_MASK, _alias_home_of_slot(i), i);
+            CanUtilities_hash_index_insert(_node_id_index, ALIAS_MAPPING_HASH_MASK, _node_id_home_of_slot(i), i);
+
+            CanUtilities_set_alias_bit(_alias_bitmap, alias);
+
+            _change_count++;
+
             return &_alias_mapping_info.list[i];
 
         }
@@ -174,9 +330,11 @@ alias_mapping_t *InternalNodeAliasTable_register(uint16_t alias, node_id_t node_
      * @brief Removes the entry matching the given alias from the buffer.
      *
      * @details Algorithm:
-     * -# Iterate through all ALIAS_MAPPING_BUFFER_DEPTH entries
-     * -# On matching alias: clear all four fields and break
-     * -# If no match found, return without action
+     * -# Look up the slot through the alias index; return if not found
+     * -# Remove the slot from both indexes while its keys are still stored
+     * -# Clear all four fields
+     * -# Clear the alias bit unless another slot still holds the alias
+     * -# Bump the change count
      *
      * @verbatim
      * @param alias  12-bit CAN alias to remove.
@@ -187,21 +345,32 @@ alias_mapping_t *InternalNodeAliasTable_register(uint16_t alias, node_id_t node_
      */
 void InternalNodeAliasTable_unregister(uint16_t alias) {
 
-    for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
+    if (alias == 0 || alias > 0xFFF) {
 
-        if (_alias_mapping_info.list[i].alias == alias) {
+        return;
 
-            _alias_mapping_info.list[i].alias = 0;
-            _alias_mapping_info.list[i].node_id = 0;
-            _alias_mapping_info.list[i].is_duplicate = false;
-            _alias_mapping_info.list[i].is_permitted = false;
+    }
 
-            break;
+    int slot = _find_slot_by_alias(alias);
 
-        }
+    if (slot < 0) {
+
+        return;
 
     }
 
+    CanUtilities_hash_index_remove(_alias_index, ALIAS_MAPPING_HASH_MASK, _alias_home_of_slot(slot), slot, &_alias_home_of_slot);
+    CanUtilities_hash_index_remove(_node_id_index, ALIAS_MAPPING_HASH_MASK, _node_id_home_of_slot(slot), slot, &_node_id_home_of_slot);
+
+    _alias_mapping_info.list[slot].alias = 0;
+    _alias_mapping_info.list[slot].node_id = 0;
+    _alias_mapping_info.list[slot].is_duplicate = false;
+    _alias_mapping_info.list[slot].is_permitted = false;
+
+    _update_alias_bit(alias);
+
+    _change_count++;
+
 }
 
     /**
@@ -209,8 +378,9 @@ void InternalNodeAliasTable_unregister(uint16_t alias) {
      *
      * @details Algorithm:
      * -# Validate alias is in range 0x001–0xFFF, return NULL if not
-     * -# Iterate through all entries; return pointer on first match
-     * -# Return NULL if no match found
+     * -# Return NULL at once if the alias bit is clear (not one of ours)
+     * -# Probe the alias index from the alias's home bucket; return pointer on match
+     * -# Return NULL on reaching an empty bucket
      *
      * @verbatim
      * @param alias  12-bit CAN alias to search for.
@@ -230,17 +400,21 @@ alias_mapping_t *InternalNodeAliasTable_find_mapping_by_alias(uint16_t alias) {
 
     }
 
-    for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
+    if (!CanUtilities_is_alias_bit_set(_alias_bitmap, alias)) {
 
-        if (_alias_mapping_info.list[i].alias == alias) {
+        return NULL;
 
-            return &_alias_mapping_info.list[i];
+    }
 
-        }
+    int slot = _find_slot_by_alias(alias);
+
+    if (slot < 0) {
+
+        return NULL;
 
     }
 
-    return NULL;
+    return &_alias_mapping_info.list[slot];
 
 }
 
@@ -249,8 +423,8 @@ alias_mapping_t *InternalNodeAliasTable_find_mapping_by_alias(uint16_t alias) {
      *
      * @details Algorithm:
      * -# Validate node_id is in range 0x000000000001–0xFFFFFFFFFFFF, return NULL if not
-     * -# Iterate through all entries; return pointer on first match
-     * -# Return NULL if no match found
+     * -# Probe the Node ID index from the Node ID's home bucket; return pointer on match
+     * -# Return NULL on reaching an empty bucket
      *
      * @verbatim
      * @param node_id  48-bit OpenLCB Node ID to search for.
@@ -270,17 +444,35 @@ alias_mapping_t *InternalNodeAliasTable_find_mapping_by_node_id(node_id_t node_i
 
     }
 
-    for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++) {
+    int slot = _find_slot_by_node_id(node_id);
 
-        if (_alias_mapping_info.list[i].node_id == node_id) {
+    if (slot < 0) {
 
-            return &_alias_mapping_info.list[i];
+        return NULL;
 
-        }
+    }
+
+    return &_alias_mapping_info.list[slot];
+
+}
+
+    /** @brief Returns true if alias is registered, using only the alias bitmap. */
+bool InternalNodeAliasTable_is_local_alias(uint16_t alias) {
+
+    if (alias == 0 || alias > 0xFFF) {
+
+        return false;
 
     }
 
-    return NULL;
+    return CanUtilities_is_alias_bit_set(_alias_bitmap, alias);
+
+}
+
+    /** @brief Returns the counter bumped by every register, unregister and flush that changes an alias. */
+uint16_t InternalNodeAliasTable_get_change_count(void) {
+
+    return _change_count;
 
 }
 
@@ -35,7 +35,7 @@
  *
  * It is NOT a general-purpose alias resolution table:
  *  - It does NOT cache remote nodes' aliases learned from AMD frames on
- *    the bus.
+ *    the bus (see remote_alias_cache.h).
  *  - It does NOT support "look up arbitrary NodeID for a remote alias I
  *    just received."  To learn a remote node's NodeID from its alias,
  *    send an MTI_VERIFY_NODE_ID_ADDRESSED to that alias and handle the
@@ -45,8 +45,9 @@
  *
  * @details Bidirectional lookup (by alias or by NodeID) is provided so the
  * RX path can answer "does this incoming alias collide with one of ours?"
- * and "do we already host this NodeID under a different alias?".  Must be
- * initialized before any node operations.
+ * and "do we already host this NodeID under a different alias?".  Both
+ * lookups go through hash indexes, so the per-frame cost does not grow with
+ * the node count.  Must be initialized before any node operations.
  *
  * @author Jim Kueneman
  * @date 4 Mar 2026
@@ -176,6 +177,35 @@ extern "C" {
          */
     extern alias_mapping_t *InternalNodeAliasTable_find_mapping_by_node_id(node_id_t node_id);
 
+        /**
+         * @brief Returns true if the alias is registered to any local node.
+         *
+         * @details Answers from a 512-byte alias bitmap without walking or
+         * probing the table, so it is cheap enough to run on every received
+         * frame as a first-stage "is this addressed to us" filter.
+         *
+         * @param alias  12-bit CAN alias to test.
+         *
+         * @return true if some entry currently holds alias, false otherwise.
+         *
+         * @see InternalNodeAliasTable_find_mapping_by_alias
+         */
+    extern bool InternalNodeAliasTable_is_local_alias(uint16_t alias);
+
+        /**
+         * @brief Returns a counter that changes whenever the set of registered aliases changes.
+         *
+         * @details Bumped by register (new entry or new alias), unregister and
+         * flush/initialize.  Consumers compare it with the value they last saw
+         * to decide when to rebuild data derived from the table, such as
+         * hardware acceptance filters.  Wraps at 65535.
+         *
+         * @return Current change count.
+         *
+         * @see CanAcceptanceFilter_run
+         */
+    extern uint16_t InternalNodeAliasTable_get_change_count(void);
+
         /**
          * @brief Clears all alias mappings and resets all flags.
          *
@@ -721,6 +721,135 @@ TEST(AliasMapping, multiple_initializations_work_correctly)
     EXPECT_NE(mapping, nullptr);
 }
 
+/*******************************************************************************
+ * Hash Index Tests
+ ******************************************************************************/
+
+/**
+ * Test: Random register/unregister churn matches a brute-force model
+ * Verifies that backward-shift deletion never strands an entry: after every
+ * operation, every live pair is found both ways and every removed pair is gone.
+ */
+TEST(AliasMapping, hash_index_survives_register_unregister_churn)
+{
+    setup_test();
+
+    uint16_t model_alias[ALIAS_MAPPING_BUFFER_DEPTH] = {0};
+    uint32_t rng = 12345;
+
+    for (int step = 0; step < 4000; step++)
+    {
+        rng = rng * 1103515245u + 12345u;
+        int pick = (rng >> 16) % ALIAS_MAPPING_BUFFER_DEPTH;
+
+        // Clustered aliases/Node IDs force long probe chains and wraparound
+        uint16_t alias = (uint16_t) (0x100 + pick * 4);
+        node_id_t node_id = NODE_ID + pick;
+
+        if (model_alias[pick])
+        {
+            InternalNodeAliasTable_unregister(model_alias[pick]);
+            model_alias[pick] = 0;
+        }
+        else
+        {
+            ASSERT_NE(InternalNodeAliasTable_register(alias, node_id), nullptr);
+            model_alias[pick] = alias;
+        }
+
+        for (int i = 0; i < ALIAS_MAPPING_BUFFER_DEPTH; i++)
+        {
+            alias_mapping_t *by_alias = InternalNodeAliasTable_find_mapping_by_alias((uint16_t) (0x100 + i * 4));
+            alias_mapping_t *by_node_id = InternalNodeAliasTable_find_mapping_by_node_id(NODE_ID + i);
+
+            if (model_alias[i])
+            {
+                ASSERT_NE(by_alias, nullptr);
+                ASSERT_EQ(by_alias, by_node_id);
+                EXPECT_EQ(by_alias->node_id, NODE_ID + i);
+            }
+            else
+            {
+                ASSERT_EQ(by_alias, nullptr);
+                ASSERT_EQ(by_node_id, nullptr);
+            }
+        }
+    }
+}
+
+/**
+ * Test: Re-registering a Node ID under a new alias re-indexes it
+ * Verifies that the old alias no longer resolves and no second slot is used.
+ */
+TEST(AliasMapping, reregister_node_id_moves_alias_index)
+{
+    setup_test();
+
+    alias_mapping_t *first = InternalNodeAliasTable_register(NODE_ALIAS, NODE_ID);
+    first->is_permitted = true;
+
+    alias_mapping_t *second = InternalNodeAliasTable_register(NODE_ALIAS + 1, NODE_ID);
+
+    EXPECT_EQ(first, second);
+    EXPECT_TRUE(second->is_permitted);
+    EXPECT_EQ(InternalNodeAliasTable_find_mapping_by_alias(NODE_ALIAS), nullptr);
+    EXPECT_EQ(InternalNodeAliasTable_find_mapping_by_alias(NODE_ALIAS + 1), second);
+    EXPECT_EQ(InternalNodeAliasTable_find_mapping_by_node_id(NODE_ID), second);
+}
+
+/**
+ * Test: Alias bitmap follows register, re-register, unregister and flush
+ */
+TEST(AliasMapping, is_local_alias_tracks_table)
+{
+    setup_test();
+
+    EXPECT_FALSE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS));
+
+    InternalNodeAliasTable_register(NODE_ALIAS, NODE_ID);
+
+    EXPECT_TRUE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS));
+    EXPECT_FALSE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS + 1));
+    EXPECT_FALSE(InternalNodeAliasTable_is_local_alias(0));
+    EXPECT_FALSE(InternalNodeAliasTable_is_local_alias(0x1000 | NODE_ALIAS));
+
+    InternalNodeAliasTable_register(NODE_ALIAS + 1, NODE_ID);
+
+    EXPECT_FALSE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS));
+    EXPECT_TRUE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS + 1));
+
+    InternalNodeAliasTable_unregister(NODE_ALIAS + 1);
+
+    EXPECT_FALSE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS + 1));
+
+    InternalNodeAliasTable_register(NODE_ALIAS, NODE_ID);
+    InternalNodeAliasTable_flush();
+
+    EXPECT_FALSE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS));
+}
+
+/**
+ * Test: An alias held by two slots stays set until both are removed
+ * Duplicate aliases occur briefly while a conflict is being resolved.
+ */
+TEST(AliasMapping, is_local_alias_survives_duplicate_unregister)
+{
+    setup_test();
+
+    InternalNodeAliasTable_register(NODE_ALIAS, NODE_ID);
+    InternalNodeAliasTable_register(NODE_ALIAS, NODE_ID + 1);
+
+    InternalNodeAliasTable_unregister(NODE_ALIAS);
+
+    EXPECT_TRUE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS));
+    EXPECT_NE(InternalNodeAliasTable_find_mapping_by_alias(NODE_ALIAS), nullptr);
+
+    InternalNodeAliasTable_unregister(NODE_ALIAS);
+
+    EXPECT_FALSE(InternalNodeAliasTable_is_local_alias(NODE_ALIAS));
+    EXPECT_EQ(InternalNodeAliasTable_find_mapping_by_alias(NODE_ALIAS), nullptr);
+}
+
 /*******************************************************************************
  * End of Test Suite
  ******************************************************************************/
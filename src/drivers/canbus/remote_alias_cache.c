@@ -0,0 +1,315 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file remote_alias_cache.c
+ * @brief Implementation of the remote alias / Node ID LRU cache.
+ *
+ * @details Single static table of LEN_REMOTE_ALIAS_CACHE entries searched
+ * linearly.  Recency is a 16-bit use counter stamped into each entry on every
+ * hit; the entry with the oldest stamp is the replacement victim.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#include "remote_alias_cache.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "can_types.h"
+#include "can_utilities.h"
+#include "../../openlcb/openlcb_types.h"
+
+/** @brief Static storage for the cache. */
+static remote_alias_cache_entry_t _cache[LEN_REMOTE_ALIAS_CACHE];
+
+/** @brief Monotonic use counter stamped into entries on insert and lookup. */
+static uint16_t _use_counter = 0;
+
+/** @brief One bit per alias held by a live entry; aliases are unique in the cache. */
+static alias_bitmap_t _alias_bitmap;
+
+    /** @brief Zeros one entry and drops its alias from the bitmap. */
+static void _clear_entry(remote_alias_cache_entry_t *entry) {
+
+    if (entry->node_id != 0) {
+
+        CanUtilities_clear_alias_bit(_alias_bitmap, entry->alias);
+
+    }
+
+    entry->node_id = 0;
+    entry->alias = 0;
+    entry->last_used = 0;
+
+}
+
+    /** @brief Zeros all entries, the alias bitmap and the use counter. */
+void RemoteAliasCache_initialize(void) {
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        _clear_entry(&_cache[i]);
+
+    }
+
+    for (int i = 0; i < ALIAS_BITMAP_BYTES; i++) {
+
+        _alias_bitmap[i] = 0;
+
+    }
+
+    _use_counter = 0;
+
+}
+
+    /**
+     * @brief Stamps an entry as most recently used.
+     *
+     * @details Algorithm:
+     * -# Advance the use counter.
+     * -# On wrap, restart every live entry's stamp at 0 so stale stamps never
+     *    look newer than fresh ones (recency order is lost once per 65535 uses).
+     * -# Store the counter in the entry.
+     *
+     * @verbatim
+     * @param entry  Entry that was just inserted or hit.
+     * @endverbatim
+     */
+static void _touch(remote_alias_cache_entry_t *entry) {
+
+    _use_counter++;
+
+    if (_use_counter == 0) {
+
+        for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+            _cache[i].last_used = 0;
+
+        }
+
+        _use_counter = 1;
+
+    }
+
+    entry->last_used = _use_counter;
+
+}
+
+    /**
+     * @brief Records that node_id currently owns alias.
+     *
+     * @details Algorithm:
+     * -# Ignore invalid Node IDs and aliases outside 0x001-0xFFF.
+     * -# Drop any entry whose alias or Node ID matches, remembering a free slot.
+     * -# If no slot is free, evict the entry with the oldest last_used stamp.
+     * -# Store the pair, set its alias bit and stamp it as most recently used.
+     *
+     * @verbatim
+     * @param node_id  48-bit OpenLCB Node ID of the remote node.
+     * @param alias    12-bit CAN alias the node is using.
+     * @endverbatim
+     */
+void RemoteAliasCache_update(node_id_t node_id, uint16_t alias) {
+
+    if ((node_id == 0) || (node_id > 0xFFFFFFFFFFFF) || (alias == 0) || (alias > 0xFFF)) {
+
+        return;
+
+    }
+
+    remote_alias_cache_entry_t *target = NULL;
+    remote_alias_cache_entry_t *victim = &_cache[0];
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        remote_alias_cache_entry_t *entry = &_cache[i];
+
+        if ((entry->node_id != 0) && ((entry->alias == alias) || (entry->node_id == node_id))) {
+
+            _clear_entry(entry);
+
+        }
+
+        if (entry->node_id == 0) {
+
+            if (!target) {
+
+                target = entry;
+
+            }
+
+        } else if ((uint16_t) (_use_counter - entry->last_used) > (uint16_t) (_use_counter - victim->last_used)) {
+
+            victim = entry;
+
+        }
+
+    }
+
+    if (!target) {
+
+        target = victim;
+        _clear_entry(target);
+
+    }
+
+    target->node_id = node_id;
+    target->alias = alias;
+    CanUtilities_set_alias_bit(_alias_bitmap, alias);
+
+    _touch(target);
+
+}
+
+    /** @brief Returns the alias cached for node_id (0 if absent) and refreshes its stamp. */
+uint16_t RemoteAliasCache_find_alias(node_id_t node_id) {
+
+    if (node_id == 0) {
+
+        return 0;
+
+    }
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        if (_cache[i].node_id == node_id) {
+
+            _touch(&_cache[i]);
+
+            return _cache[i].alias;
+
+        }
+
+    }
+
+    return 0;
+
+}
+
+    /** @brief Returns the Node ID cached for alias (0 if absent) and refreshes its stamp. */
+node_id_t RemoteAliasCache_find_node_id(uint16_t alias) {
+
+    if ((alias == 0) || (alias > 0xFFF) || !CanUtilities_is_alias_bit_set(_alias_bitmap, alias)) {
+
+        return 0;
+
+    }
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        if ((_cache[i].node_id != 0) && (_cache[i].alias == alias)) {
+
+            _touch(&_cache[i]);
+
+            return _cache[i].node_id;
+
+        }
+
+    }
+
+    return 0;
+
+}
+
+    /** @brief Clears the entry holding alias, if any. */
+void RemoteAliasCache_invalidate_alias(uint16_t alias) {
+
+    if (alias == 0) {
+
+        return;
+
+    }
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        if ((_cache[i].node_id != 0) && (_cache[i].alias == alias)) {
+
+            _clear_entry(&_cache[i]);
+
+        }
+
+    }
+
+}
+
+    /** @brief Tests the alias bitmap; does not touch LRU stamps. */
+bool RemoteAliasCache_is_known_alias(uint16_t alias) {
+
+    if ((alias == 0) || (alias > 0xFFF)) {
+
+        return false;
+
+    }
+
+    return CanUtilities_is_alias_bit_set(_alias_bitmap, alias);
+
+}
+
+    /** @brief Clears every entry; the use counter keeps running. */
+void RemoteAliasCache_flush(void) {
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        _clear_entry(&_cache[i]);
+
+    }
+
+}
+
+    /** @brief Counts entries with a non-zero node_id. */
+uint16_t RemoteAliasCache_get_count(void) {
+
+    uint16_t count = 0;
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        if (_cache[i].node_id != 0) {
+
+            count++;
+
+        }
+
+    }
+
+    return count;
+
+}
+
+    /** @brief Returns a pointer to entry index, or NULL if out of range. */
+remote_alias_cache_entry_t *RemoteAliasCache_get_entry(uint16_t index) {
+
+    if (index >= LEN_REMOTE_ALIAS_CACHE) {
+
+        return NULL;
+
+    }
+
+    return &_cache[index];
+
+}
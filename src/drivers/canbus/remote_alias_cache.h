@@ -0,0 +1,147 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file remote_alias_cache.h
+ * @brief Bounded LRU cache of remote node alias / Node ID pairs.
+ *
+ * @details Only local aliases (internal_node_alias_table.h) and train listeners
+ * (alias_mapping_listener.h) are otherwise known to the CAN layer.  This cache
+ * remembers every other node seen on the bus so the RX path can fill
+ * openlcb_msg_t.source_id and the TX path can resolve dest_alias from dest_id
+ * without a Verify Node ID round trip.
+ *
+ * Entries are learned passively from AMD frames and from Verified Node ID and
+ * Initialization Complete messages.  They are dropped when the alias is
+ * released (AMR), re-reserved (CID/RID), collides with one of our own aliases,
+ * or when a global AME asks every node to re-announce.  When the table is full
+ * the least recently used entry is replaced.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __DRIVERS_CANBUS_REMOTE_ALIAS_CACHE__
+#define __DRIVERS_CANBUS_REMOTE_ALIAS_CACHE__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_types.h"
+#include "../../openlcb/openlcb_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+        /**
+         * @brief Empties every cache entry and resets the LRU counter.
+         *
+         * @details Must be called once at startup before any cache operations.
+         */
+    extern void RemoteAliasCache_initialize(void);
+
+        /**
+         * @brief Records that node_id currently owns alias.
+         *
+         * @details Any other entry holding the same alias or the same Node ID is
+         * removed first, so each alias and each Node ID appears at most once.
+         * When no slot is free the least recently used entry is replaced.
+         *
+         * @param node_id  48-bit OpenLCB Node ID of the remote node.
+         * @param alias    12-bit CAN alias the node is using.
+         */
+    extern void RemoteAliasCache_update(node_id_t node_id, uint16_t alias);
+
+        /**
+         * @brief Returns the alias cached for a Node ID and marks it recently used.
+         *
+         * @param node_id  48-bit OpenLCB Node ID to look up.
+         *
+         * @return Cached alias, or 0 if node_id is not cached.
+         */
+    extern uint16_t RemoteAliasCache_find_alias(node_id_t node_id);
+
+        /**
+         * @brief Returns the Node ID cached for an alias and marks it recently used.
+         *
+         * @param alias  12-bit CAN alias to look up.
+         *
+         * @return Cached @ref node_id_t, or 0 if alias is not cached.
+         */
+    extern node_id_t RemoteAliasCache_find_node_id(uint16_t alias);
+
+        /**
+         * @brief Removes the entry holding alias, if any.
+         *
+         * @details Called on AMR, CID, RID and duplicate-alias detection.
+         *
+         * @param alias  12-bit CAN alias that is no longer trustworthy.
+         */
+    extern void RemoteAliasCache_invalidate_alias(uint16_t alias);
+
+        /**
+         * @brief Returns true if alias is held by a cached remote node.
+         *
+         * @details Answers from a 512-byte alias bitmap without scanning the
+         * cache and does not refresh the entry's LRU stamp.
+         *
+         * @param alias  12-bit CAN alias to test.
+         *
+         * @return true if an entry currently holds alias.
+         */
+    extern bool RemoteAliasCache_is_known_alias(uint16_t alias);
+
+        /**
+         * @brief Removes every entry.
+         *
+         * @details Called when a global AME is received; the AMD replies it
+         * triggers re-populate the cache.
+         */
+    extern void RemoteAliasCache_flush(void);
+
+        /**
+         * @brief Returns the number of entries currently in use.
+         *
+         * @return Count of entries with a non-zero node_id.
+         */
+    extern uint16_t RemoteAliasCache_get_count(void);
+
+        /**
+         * @brief Returns a pointer to one cache entry (for testing/debugging).
+         *
+         * @param index  Entry index (0 to LEN_REMOTE_ALIAS_CACHE - 1).
+         *
+         * @return Pointer to the @ref remote_alias_cache_entry_t, or NULL if out of range.
+         */
+    extern remote_alias_cache_entry_t *RemoteAliasCache_get_entry(uint16_t index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __DRIVERS_CANBUS_REMOTE_ALIAS_CACHE__ */
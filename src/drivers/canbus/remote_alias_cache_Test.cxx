@@ -0,0 +1,290 @@
+/*******************************************************************************
+ * File: remote_alias_cache_Test.cxx
+ *
+ * Description:
+ *   Test suite for the RemoteAliasCache module (remote_alias_cache.h/.c).
+ *   Tests passive learning of remote alias / Node ID pairs, invalidation and
+ *   least-recently-used replacement.
+ *
+ * Test Coverage:
+ *   - Initialization and reset
+ *   - Update, find by alias, find by Node ID
+ *   - Re-mapping (same Node ID new alias, same alias new Node ID)
+ *   - Invalidate by alias and flush
+ *   - LRU replacement when full
+ *   - Boundary and validation checks
+ *
+ * Author: Jim Kueneman
+ * Date: 2026-10-18
+ ******************************************************************************/
+
+#include "test/main_Test.hxx"
+
+#include "can_types.h"
+#include "remote_alias_cache.h"
+#include "../../openlcb/openlcb_types.h"
+
+/*******************************************************************************
+ * Test Constants
+ ******************************************************************************/
+
+#define TEST_NODE_ID_A   0x010203040506ULL
+#define TEST_NODE_ID_B   0xAABBCCDDEEFFULL
+#define TEST_NODE_ID_C   0x112233445566ULL
+
+#define TEST_ALIAS_A     0x0AAA
+#define TEST_ALIAS_B     0x0BBB
+#define TEST_ALIAS_C     0x0CCC
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void setup_test(void) {
+
+    RemoteAliasCache_initialize();
+
+}
+
+/**
+ * Fill the cache to capacity; entry i maps TEST_NODE_ID_A + i to alias 0x100 + i.
+ */
+static void fill_cache(void) {
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        RemoteAliasCache_update(TEST_NODE_ID_A + i, 0x100 + i);
+
+    }
+
+}
+
+/*******************************************************************************
+ * Initialization Tests
+ ******************************************************************************/
+
+TEST(RemoteAliasCache, initialize_clears_all_entries) {
+
+    setup_test();
+
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_A);
+
+    setup_test();
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), 0);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A), 0);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(TEST_ALIAS_A), 0ULL);
+
+}
+
+/*******************************************************************************
+ * Update and Find Tests
+ ******************************************************************************/
+
+TEST(RemoteAliasCache, update_then_find_both_ways) {
+
+    setup_test();
+
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_A);
+    RemoteAliasCache_update(TEST_NODE_ID_B, TEST_ALIAS_B);
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), 2);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A), TEST_ALIAS_A);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_B), TEST_ALIAS_B);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(TEST_ALIAS_A), TEST_NODE_ID_A);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(TEST_ALIAS_B), TEST_NODE_ID_B);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_C), 0);
+
+}
+
+TEST(RemoteAliasCache, node_id_takes_new_alias) {
+
+    setup_test();
+
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_A);
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_B);
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), 1);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A), TEST_ALIAS_B);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(TEST_ALIAS_A), 0ULL);
+
+}
+
+TEST(RemoteAliasCache, alias_reused_by_new_node) {
+
+    setup_test();
+
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_A);
+    RemoteAliasCache_update(TEST_NODE_ID_B, TEST_ALIAS_A);
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), 1);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(TEST_ALIAS_A), TEST_NODE_ID_B);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A), 0);
+
+}
+
+TEST(RemoteAliasCache, invalid_arguments_ignored) {
+
+    setup_test();
+
+    RemoteAliasCache_update(0, TEST_ALIAS_A);
+    RemoteAliasCache_update(TEST_NODE_ID_A, 0);
+    RemoteAliasCache_update(TEST_NODE_ID_A, 0x1000);
+    RemoteAliasCache_update(0x1000000000000ULL, TEST_ALIAS_A);
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), 0);
+    EXPECT_EQ(RemoteAliasCache_find_alias(0), 0);
+    EXPECT_EQ(RemoteAliasCache_find_node_id(0), 0ULL);
+
+}
+
+/*******************************************************************************
+ * Invalidation Tests
+ ******************************************************************************/
+
+TEST(RemoteAliasCache, invalidate_alias_removes_only_that_entry) {
+
+    setup_test();
+
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_A);
+    RemoteAliasCache_update(TEST_NODE_ID_B, TEST_ALIAS_B);
+
+    RemoteAliasCache_invalidate_alias(TEST_ALIAS_A);
+    RemoteAliasCache_invalidate_alias(TEST_ALIAS_C);
+    RemoteAliasCache_invalidate_alias(0);
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), 1);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A), 0);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_B), TEST_ALIAS_B);
+
+}
+
+TEST(RemoteAliasCache, is_known_alias_tracks_entries) {
+
+    setup_test();
+
+    EXPECT_FALSE(RemoteAliasCache_is_known_alias(TEST_ALIAS_A));
+
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_A);
+
+    EXPECT_TRUE(RemoteAliasCache_is_known_alias(TEST_ALIAS_A));
+    EXPECT_FALSE(RemoteAliasCache_is_known_alias(0));
+
+    // Node moves to a new alias: old bit clears, new bit sets
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_B);
+
+    EXPECT_FALSE(RemoteAliasCache_is_known_alias(TEST_ALIAS_A));
+    EXPECT_TRUE(RemoteAliasCache_is_known_alias(TEST_ALIAS_B));
+
+    RemoteAliasCache_invalidate_alias(TEST_ALIAS_B);
+
+    EXPECT_FALSE(RemoteAliasCache_is_known_alias(TEST_ALIAS_B));
+
+    RemoteAliasCache_update(TEST_NODE_ID_C, TEST_ALIAS_C);
+    RemoteAliasCache_flush();
+
+    EXPECT_FALSE(RemoteAliasCache_is_known_alias(TEST_ALIAS_C));
+
+}
+
+TEST(RemoteAliasCache, eviction_clears_alias_bit) {
+
+    setup_test();
+
+    fill_cache();
+
+    RemoteAliasCache_update(TEST_NODE_ID_C, TEST_ALIAS_C);
+
+    EXPECT_FALSE(RemoteAliasCache_is_known_alias(0x100));
+    EXPECT_TRUE(RemoteAliasCache_is_known_alias(TEST_ALIAS_C));
+    EXPECT_EQ(RemoteAliasCache_find_node_id(0x100), 0);
+
+}
+
+TEST(RemoteAliasCache, flush_removes_everything) {
+
+    setup_test();
+
+    fill_cache();
+
+    RemoteAliasCache_flush();
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), 0);
+
+    for (int i = 0; i < LEN_REMOTE_ALIAS_CACHE; i++) {
+
+        EXPECT_EQ(RemoteAliasCache_get_entry(i)->node_id, 0ULL);
+
+    }
+
+}
+
+/*******************************************************************************
+ * LRU Replacement Tests
+ ******************************************************************************/
+
+TEST(RemoteAliasCache, full_cache_replaces_least_recently_inserted) {
+
+    setup_test();
+
+    fill_cache();
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), LEN_REMOTE_ALIAS_CACHE);
+
+    RemoteAliasCache_update(TEST_NODE_ID_C, TEST_ALIAS_C);
+
+    EXPECT_EQ(RemoteAliasCache_get_count(), LEN_REMOTE_ALIAS_CACHE);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_C), TEST_ALIAS_C);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A), 0);
+
+}
+
+TEST(RemoteAliasCache, lookup_protects_entry_from_replacement) {
+
+    setup_test();
+
+    fill_cache();
+
+    // Touch the oldest entry so the second-oldest becomes the victim
+    EXPECT_EQ(RemoteAliasCache_find_node_id(0x100), TEST_NODE_ID_A);
+
+    RemoteAliasCache_update(TEST_NODE_ID_C, TEST_ALIAS_C);
+
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A), 0x100);
+
+    if (LEN_REMOTE_ALIAS_CACHE > 1) {
+
+        EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A + 1), 0);
+
+    }
+
+}
+
+TEST(RemoteAliasCache, counter_wrap_keeps_cache_usable) {
+
+    setup_test();
+
+    RemoteAliasCache_update(TEST_NODE_ID_A, TEST_ALIAS_A);
+
+    for (int i = 0; i < 70000; i++) {
+
+        RemoteAliasCache_find_alias(TEST_NODE_ID_A);
+
+    }
+
+    RemoteAliasCache_update(TEST_NODE_ID_B, TEST_ALIAS_B);
+
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_A), TEST_ALIAS_A);
+    EXPECT_EQ(RemoteAliasCache_find_alias(TEST_NODE_ID_B), TEST_ALIAS_B);
+
+}
+
+TEST(RemoteAliasCache, get_entry_bounds) {
+
+    setup_test();
+
+    EXPECT_NE(RemoteAliasCache_get_entry(0), nullptr);
+    EXPECT_NE(RemoteAliasCache_get_entry(LEN_REMOTE_ALIAS_CACHE - 1), nullptr);
+    EXPECT_EQ(RemoteAliasCache_get_entry(LEN_REMOTE_ALIAS_CACHE), nullptr);
+
+}
@@ -72,21 +72,78 @@ static bool _send_openlcb_msg_wrapper(openlcb_msg_t *msg) {
     return TcpTxStatemachine_send_openlcb_message(msg);
 }
 
+// The TX, link control and main modules always pass a connection index; these
+// adapters send it to the connection-aware user callback or, if only the
+// single-connection one is set, drop it.
+
+static bool _transmit_data(uint8_t connection, uint8_t *data, uint16_t len) {
+
+    if (_user_config->transmit_connection_data)
+        return _user_config->transmit_connection_data(connection, data, len);
+
+    return _user_config->transmit_raw_tcp_data(data, len);
+}
+
+static bool _transmit_segments(uint8_t connection, const tcp_tx_segment_t *segments, uint8_t count) {
+
+    if (_user_config->transmit_connection_segments)
+        return _user_config->transmit_connection_segments(connection, segments, count);
+
+    return _user_config->transmit_raw_tcp_segments(segments, count);
+}
+
+static bool _is_tx_buffer_clear(uint8_t connection) {
+
+    if (_user_config->is_connection_tx_buffer_clear)
+        return _user_config->is_connection_tx_buffer_clear(connection);
+
+    return _user_config->is_tx_buffer_clear();
+}
+
+static void _on_link_status_changed(uint8_t connection, bool is_up) {
+
+    if (_user_config->on_connection_status_changed)
+        _user_config->on_connection_status_changed(connection, is_up);
+
+    if (_user_config->on_link_status_changed)
+        _user_config->on_link_status_changed(is_up);
+}
+
+static void _on_link_drop_requested(uint8_t connection) {
+
+    if (_user_config->on_connection_drop_requested)
+        _user_config->on_connection_drop_requested(connection);
+
+    if (_user_config->on_link_drop_requested)
+        _user_config->on_link_drop_requested();
+}
+
 static void _build_rx_interface(void) {
 
     _rx_interface.allocate_buffer = &OpenLcbBufferStore_allocate_buffer;
     _rx_interface.free_buffer = &OpenLcbBufferStore_free_buffer;
     _rx_interface.push_to_fifo = &OpenLcbBufferFifo_push;
     _rx_interface.handle_link_control = &TcpLinkControl_handle;
+    _rx_interface.learn_route = &TcpTxStatemachine_learn_route;
     _rx_interface.lock_shared_resources = _user_config->lock_shared_resources;
     _rx_interface.unlock_shared_resources = _user_config->unlock_shared_resources;
+    _rx_interface.get_current_tick = &OpenLcbConfig_get_global_100ms_tick;
     _rx_interface.on_rx = _user_config->on_rx;
 }
 
 static void _build_tx_interface(void) {
 
-    _tx_interface.transmit_raw_tcp_data = _user_config->transmit_raw_tcp_data;
-    _tx_interface.is_tx_buffer_clear = _user_config->is_tx_buffer_clear;
+    _tx_interface.transmit_raw_tcp_data = NULL;
+    _tx_interface.transmit_raw_tcp_segments = NULL;
+
+    if (_user_config->transmit_connection_data || _user_config->transmit_raw_tcp_data)
+        _tx_interface.transmit_raw_tcp_data = &_transmit_data;
+
+    if (_user_config->transmit_connection_segments || _user_config->transmit_raw_tcp_segments)
+        _tx_interface.transmit_raw_tcp_segments = &_transmit_segments;
+
+    _tx_interface.is_tx_buffer_clear = &_is_tx_buffer_clear;
+    _tx_interface.get_link_state = &TcpMainStatemachine_get_link_state;
     _tx_interface.get_local_node_id = _user_config->get_local_node_id;
     _tx_interface.get_capture_time_ms = _user_config->get_capture_time_ms;
     _tx_interface.on_tx = _user_config->on_tx;
@@ -96,13 +153,13 @@ static void _build_link_control_interface(void) {
 
     _link_control_interface.send_link_control = &TcpTxStatemachine_send_link_control;
     _link_control_interface.get_statemachine_info = &TcpMainStatemachine_get_statemachine_info;
-    _link_control_interface.on_link_drop_requested = _user_config->on_link_drop_requested;
-    _link_control_interface.on_link_status_changed = _user_config->on_link_status_changed;
+    _link_control_interface.on_link_drop_requested = &_on_link_drop_requested;
+    _link_control_interface.on_link_status_changed = &_on_link_status_changed;
 }
 
 static void _build_login_interface(void) {
 
-    _login_interface.send_openlcb_msg = &_send_openlcb_msg_wrapper;
+    _login_interface.send_openlcb_msg = &TcpTxStatemachine_send_openlcb_message_to;
     _login_interface.allocate_buffer = &OpenLcbBufferStore_allocate_buffer;
     _login_interface.free_buffer = &OpenLcbBufferStore_free_buffer;
     _login_interface.lock_shared_resources = _user_config->lock_shared_resources;
@@ -116,7 +173,8 @@ static void _build_main_interface(void) {
     _main_interface.login_get_state = &TcpLoginStatemachine_get_state;
     _main_interface.link_control_run = &TcpLinkControl_run;
     _main_interface.get_current_tick = &OpenLcbConfig_get_global_100ms_tick;
-    _main_interface.on_link_status_changed = _user_config->on_link_status_changed;
+    _main_interface.on_link_status_changed = &_on_link_status_changed;
+    _main_interface.tx_run = &TcpTxStatemachine_run;
 }
 
 // =========================================================================
@@ -144,13 +202,41 @@ void TcpConfig_initialize(const tcp_config_t *config) {
 
 void TcpConfig_link_up(void) {
 
-    TcpMainStatemachine_link_up();
+    TcpConfig_connection_up(0);
 }
 
 void TcpConfig_link_down(void) {
 
-    TcpRxStatemachine_reset();
-    TcpMainStatemachine_link_down();
+    TcpConfig_connection_down(0);
+}
+
+void TcpConfig_connection_up(uint8_t connection) {
+
+    TcpMainStatemachine_link_up(connection);
+}
+
+void TcpConfig_connection_down(uint8_t connection) {
+
+    TcpRxStatemachine_reset(connection);
+    TcpTxStatemachine_reset(connection);
+    TcpMainStatemachine_link_down(connection);
+}
+
+bool TcpConfig_is_link_up(void) {
+
+    for (uint8_t connection = 0; connection < USER_DEFINED_TCP_MAX_CONNECTIONS; connection++) {
+
+        tcp_link_state_enum state = TcpMainStatemachine_get_link_state(connection);
+
+        if ((state == TCP_LINK_STATE_LOGGING_IN) || (state == TCP_LINK_STATE_RUNNING)) {
+
+            return true;
+
+        }
+
+    }
+
+    return false;
 }
 
 bool TcpConfig_run(void) {
@@ -158,9 +244,14 @@ bool TcpConfig_run(void) {
     return TcpMainStatemachine_run();
 }
 
-void TcpConfig_incoming_data(uint8_t *data, uint16_t len) {
+uint16_t TcpConfig_incoming_data(uint8_t *data, uint16_t len) {
+
+    return TcpRxStatemachine_incoming_data(0, data, len);
+}
+
+uint16_t TcpConfig_connection_incoming_data(uint8_t connection, uint8_t *data, uint16_t len) {
 
-    TcpRxStatemachine_incoming_data(data, len);
+    return TcpRxStatemachine_incoming_data(connection, data, len);
 }
 
 bool (*TcpConfig_get_send_openlcb_msg(void))(openlcb_msg_t *msg) {
@@ -30,6 +30,13 @@
  * @details Users provide their hardware-specific TCP driver functions here.
  * All other TCP-internal wiring is handled automatically by tcp_config.c.
  *
+ * With USER_DEFINED_TCP_MAX_CONNECTIONS > 1 the node serves several TCP
+ * connections at once (e.g. JMRI and a configuration tool connecting
+ * directly, no hub).  Connections are numbered 0 to
+ * USER_DEFINED_TCP_MAX_CONNECTIONS - 1; the application maps them to its
+ * sockets and uses the TcpConfig_connection_* calls and the transmit_connection_*
+ * callbacks.  The single-connection calls and callbacks act on connection 0.
+ *
  * @author Jim Kueneman
  * @date 4 Apr 2026
  *
@@ -59,6 +66,7 @@ extern "C" {
      * @code
      * static const tcp_config_t tcp_config = {
      *     .transmit_raw_tcp_data   = &MyTcpDriver_send,
+     *     .transmit_raw_tcp_segments = &MyTcpDriver_sendv,  // optional
      *     .is_tx_buffer_clear      = &MyTcpDriver_is_tx_ready,
      *     .get_local_node_id       = &MyApp_get_node_id,
      *     .get_capture_time_ms     = &MyApp_get_uptime_ms,
@@ -71,13 +79,26 @@ extern "C" {
      *
      * TcpConfig_initialize(&tcp_config);
      * @endcode
+     *
+     * A multi-connection server sets the connection-aware callbacks instead:
+     * @code
+     *     .transmit_connection_data      = &MyServer_send,     // (connection, data, len)
+     *     .is_connection_tx_buffer_clear = &MyServer_is_tx_ready,
+     *     .on_connection_drop_requested  = &MyServer_close,
+     * @endcode
      */
     typedef struct {
 
-        /** @brief Transmit raw bytes over the TCP connection. REQUIRED.
+        /** @brief Transmit raw bytes over the TCP connection. REQUIRED unless
+         *  transmit_raw_tcp_segments is set.
          *  Returns true on success, false if the socket is unavailable. */
         bool (*transmit_raw_tcp_data)(uint8_t *data, uint16_t len);
 
+        /** @brief Transmit one message as header + payload segments (writev style). Optional.
+         *  When set, payloads are sent straight from the message buffer with no copy
+         *  and are not limited by USER_DEFINED_TCP_TX_BUFFER_LEN. */
+        bool (*transmit_raw_tcp_segments)(const tcp_tx_segment_t *segments, uint8_t count);
+
         /** @brief Check if TCP TX buffer can accept another message. REQUIRED. */
         bool (*is_tx_buffer_clear)(void);
 
@@ -110,6 +131,28 @@ extern "C" {
          *  The application should close the TCP socket. */
         void (*on_link_drop_requested)(void);
 
+        /** @brief Transmit raw bytes on one connection. REQUIRED instead of
+         *  transmit_raw_tcp_data (or transmit_connection_segments) when
+         *  USER_DEFINED_TCP_MAX_CONNECTIONS > 1. */
+        bool (*transmit_connection_data)(uint8_t connection, uint8_t *data, uint16_t len);
+
+        /** @brief Scatter-gather transmit on one connection. Optional; the
+         *  multi-connection form of transmit_raw_tcp_segments. */
+        bool (*transmit_connection_segments)(uint8_t connection, const tcp_tx_segment_t *segments, uint8_t count);
+
+        /** @brief Check if one connection's TX buffer can accept another message.
+         *  REQUIRED instead of is_tx_buffer_clear when
+         *  USER_DEFINED_TCP_MAX_CONNECTIONS > 1. */
+        bool (*is_connection_tx_buffer_clear)(uint8_t connection);
+
+        /** @brief Called when a connection's link state changes. Optional.
+         *  Fired in addition to on_link_status_changed. */
+        void (*on_connection_status_changed)(uint8_t connection, bool is_up);
+
+        /** @brief Called when the peer on a connection requests a link drop. Optional.
+         *  Fired in addition to on_link_drop_requested; close that socket. */
+        void (*on_connection_drop_requested)(uint8_t connection);
+
     } tcp_config_t;
 
     /**
@@ -131,6 +174,7 @@ extern "C" {
      *
      * @details Call after successfully connecting the TCP socket.
      * Starts the login sequence (Verify Node ID Global, etc.).
+     * Same as TcpConfig_connection_up(0).
      */
     extern void TcpConfig_link_up(void);
 
@@ -138,9 +182,40 @@ extern "C" {
      * @brief Signals that the TCP connection has been lost.
      *
      * @details Call when the socket disconnects or an error occurs.
+     * Same as TcpConfig_connection_down(0).
      */
     extern void TcpConfig_link_down(void);
 
+    /**
+     * @brief Signals that a TCP connection has been established.
+     *
+     * @details Call after accepting or connecting the socket mapped to
+     * connection.  Starts that connection's login sequence; from then on
+     * global messages are also sent on it.
+     *
+     * @param connection  0 to USER_DEFINED_TCP_MAX_CONNECTIONS - 1.
+     */
+    extern void TcpConfig_connection_up(uint8_t connection);
+
+    /**
+     * @brief Signals that a TCP connection has been lost.
+     *
+     * @details Discards the connection's buffered RX bytes, partial multi-part
+     * messages, unsent batch and learned routes.
+     *
+     * @param connection  0 to USER_DEFINED_TCP_MAX_CONNECTIONS - 1.
+     */
+    extern void TcpConfig_connection_down(uint8_t connection);
+
+    /**
+     * @brief Returns true if any connection is logging in or running.
+     *
+     * @details Global messages are only sent while this is true.
+     *
+     * @return true if at least one connection can carry traffic.
+     */
+    extern bool TcpConfig_is_link_up(void);
+
     /**
      * @brief Drives the TCP transport run-loop.
      *
@@ -158,8 +233,22 @@ extern "C" {
      *
      * @param data  Pointer to received bytes.
      * @param len   Number of bytes received.
+     *
+     * @return Bytes consumed; offer the rest again later (see
+     *         TcpRxStatemachine_incoming_data()).
+     */
+    extern uint16_t TcpConfig_incoming_data(uint8_t *data, uint16_t len);
+
+    /**
+     * @brief Feeds data received on one connection into the receive state machine.
+     *
+     * @param connection  Connection the bytes arrived on.
+     * @param data        Pointer to received bytes.
+     * @param len         Number of bytes received.
+     *
+     * @return Bytes consumed; offer the rest again later.
      */
-    extern void TcpConfig_incoming_data(uint8_t *data, uint16_t len);
+    extern uint16_t TcpConfig_connection_incoming_data(uint8_t connection, uint8_t *data, uint16_t len);
 
     /**
      * @brief Returns the transmit function for use by the protocol layer.
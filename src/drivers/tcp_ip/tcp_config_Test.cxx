@@ -15,6 +15,8 @@
  *   - TcpConfig_link_down transitions main statemachine to DISCONNECTED
  *   - TcpConfig_incoming_data routes to RX statemachine (messages pushed to FIFO)
  *   - End-to-end TX: send via returned function pointer → mock transmit called
+ *   - Connection-aware callbacks: per-connection login, routing of replies to
+ *     the connection a node was heard on, drop request and status callbacks
  *
  * Author: Test Suite
  * Date: 2026-04-05
@@ -132,7 +134,7 @@ TEST(TCP_Config, initialize_succeeds)
     setup_test();
 
     // No crash = pass. Verify main statemachine is in disconnected state.
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_DISCONNECTED);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_DISCONNECTED);
 }
 
 // =============================================================================
@@ -166,9 +168,19 @@ TEST(TCP_Config, send_via_function_pointer)
     msg->dest_id = 0;
     msg->payload_count = 0;
 
+    // Nothing to send to before a connection is up
+    EXPECT_FALSE(send_fn(msg));
+
+    TcpConfig_link_up();
+
     bool result = send_fn(msg);
 
     EXPECT_TRUE(result);
+
+    // Coalesced: the first run sees a fresh batch, the next (idle) run flushes it
+    EXPECT_FALSE(_transmit_called);
+    TcpConfig_run();
+    TcpConfig_run();
     EXPECT_TRUE(_transmit_called);
     EXPECT_GT(_transmitted_len, 0);
 
@@ -190,14 +202,14 @@ TEST(TCP_Config, link_up_transitions_to_running)
     TcpConfig_link_up();
 
     // link_up transitions to LOGGING_IN
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_LOGGING_IN);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_LOGGING_IN);
     EXPECT_TRUE(_link_status_called);
     EXPECT_TRUE(_link_status_is_up);
 
     // run() drives login to completion, transitions to RUNNING
     TcpConfig_run();
 
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_RUNNING);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_RUNNING);
 }
 
 TEST(TCP_Config, link_down_transitions_to_disconnected)
@@ -209,11 +221,24 @@ TEST(TCP_Config, link_down_transitions_to_disconnected)
 
     TcpConfig_link_down();
 
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_DISCONNECTED);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_DISCONNECTED);
     EXPECT_TRUE(_link_status_called);
     EXPECT_FALSE(_link_status_is_up);
 }
 
+TEST(TCP_Config, is_link_up_while_any_connection_is_open)
+{
+    setup_test();
+
+    EXPECT_FALSE(TcpConfig_is_link_up());
+
+    TcpConfig_connection_up(USER_DEFINED_TCP_MAX_CONNECTIONS - 1);
+    EXPECT_TRUE(TcpConfig_is_link_up());
+
+    TcpConfig_connection_down(USER_DEFINED_TCP_MAX_CONNECTIONS - 1);
+    EXPECT_FALSE(TcpConfig_is_link_up());
+}
+
 // =============================================================================
 // Incoming Data — routes to RX statemachine
 // =============================================================================
@@ -254,7 +279,9 @@ TEST(TCP_Config, link_up_sends_verify_node_id_global)
     // link_up does not send immediately
     EXPECT_FALSE(_transmit_called);
 
-    // run() drives the login statemachine which sends Verify Node ID Global
+    // run() drives the login statemachine which sends Verify Node ID Global;
+    // the next (idle) run flushes the coalesced batch
+    TcpConfig_run();
     TcpConfig_run();
 
     EXPECT_TRUE(_transmit_called);
@@ -263,3 +290,161 @@ TEST(TCP_Config, link_up_sends_verify_node_id_global)
     uint16_t mti = TcpUtilities_decode_mti(&_transmitted_data[TCP_PREAMBLE_LEN]);
     EXPECT_EQ(mti, MTI_VERIFY_NODE_ID_GLOBAL);
 }
+
+// =============================================================================
+// Connection-aware callbacks
+// =============================================================================
+
+static int _conn_transmit_count[USER_DEFINED_TCP_MAX_CONNECTIONS];
+static uint8_t _conn_last_data[USER_DEFINED_TCP_MAX_CONNECTIONS][256];
+static uint8_t _conn_status_connection = 0xFF;
+static bool _conn_status_is_up = false;
+static uint8_t _conn_drop_connection = 0xFF;
+
+static bool _mock_transmit_connection(uint8_t connection, uint8_t *data, uint16_t len)
+{
+    _conn_transmit_count[connection]++;
+    if (len <= sizeof(_conn_last_data[connection]))
+        memcpy(_conn_last_data[connection], data, len);
+    return true;
+}
+
+static bool _mock_is_connection_tx_clear(uint8_t connection)
+{
+    (void) connection;
+    return true;
+}
+
+static void _mock_on_connection_status(uint8_t connection, bool is_up)
+{
+    _conn_status_connection = connection;
+    _conn_status_is_up = is_up;
+}
+
+static void _mock_on_connection_drop(uint8_t connection)
+{
+    _conn_drop_connection = connection;
+}
+
+static const tcp_config_t _tcp_config_connections = {
+    .transmit_raw_tcp_data         = NULL,
+    .is_tx_buffer_clear            = NULL,
+    .get_local_node_id             = &_mock_get_node_id,
+    .get_capture_time_ms           = &_mock_get_time,
+    .lock_shared_resources         = &_mock_lock,
+    .unlock_shared_resources       = &_mock_unlock,
+    .transmit_connection_data      = &_mock_transmit_connection,
+    .is_connection_tx_buffer_clear = &_mock_is_connection_tx_clear,
+    .on_connection_status_changed  = &_mock_on_connection_status,
+    .on_connection_drop_requested  = &_mock_on_connection_drop,
+};
+
+static void setup_connections_test(void)
+{
+    reset_mocks();
+    memset(_conn_transmit_count, 0, sizeof(_conn_transmit_count));
+    memset(_conn_last_data, 0, sizeof(_conn_last_data));
+    _conn_status_connection = 0xFF;
+    _conn_status_is_up = false;
+    _conn_drop_connection = 0xFF;
+    OpenLcbBufferStore_initialize();
+    OpenLcbBufferFifo_initialize();
+    OpenLcbBufferList_initialize();
+    TcpConfig_initialize(&_tcp_config_connections);
+}
+
+static uint16_t build_wire(uint8_t *wire, uint16_t mti, node_id_t source_id)
+{
+    uint16_t offset = TcpUtilities_encode_preamble(
+            wire, TCP_FLAGS_MESSAGE, TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN, source_id, 500);
+    offset += TcpUtilities_encode_uint16(&wire[offset], mti);
+    offset += TcpUtilities_encode_node_id(&wire[offset], source_id);
+    return offset;
+}
+
+TEST(TCP_Config, connections_log_in_separately)
+{
+    setup_connections_test();
+
+    TcpConfig_connection_up(0);
+    EXPECT_EQ(_conn_status_connection, 0);
+    EXPECT_TRUE(_conn_status_is_up);
+
+    TcpConfig_run();
+    TcpConfig_run();
+    EXPECT_EQ(_conn_transmit_count[0], 1);
+    EXPECT_EQ(_conn_transmit_count[1], 0);
+
+    // A second client gets its own Verify Node ID Global; the first does not
+    TcpConfig_connection_up(1);
+    TcpConfig_run();
+    TcpConfig_run();
+    EXPECT_EQ(_conn_transmit_count[0], 1);
+    EXPECT_EQ(_conn_transmit_count[1], 1);
+    EXPECT_EQ(TcpUtilities_decode_mti(&_conn_last_data[1][TCP_PREAMBLE_LEN]), MTI_VERIFY_NODE_ID_GLOBAL);
+
+    TcpConfig_connection_down(1);
+    EXPECT_EQ(_conn_status_connection, 1);
+    EXPECT_FALSE(_conn_status_is_up);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_RUNNING);
+}
+
+TEST(TCP_Config, reply_routed_to_connection_node_was_heard_on)
+{
+    setup_connections_test();
+
+    TcpConfig_connection_up(0);
+    TcpConfig_connection_up(1);
+    TcpConfig_run();
+    TcpConfig_run();
+    memset(_conn_transmit_count, 0, sizeof(_conn_transmit_count));
+
+    uint8_t wire[64];
+    uint16_t len = build_wire(wire, MTI_VERIFIED_NODE_ID, 0x0A0B0C0D0E0FULL);
+    EXPECT_EQ(TcpConfig_connection_incoming_data(1, wire, len), len);
+
+    openlcb_msg_t *rx = OpenLcbBufferFifo_pop();
+    ASSERT_NE(rx, nullptr);
+    OpenLcbBufferStore_free_buffer(rx);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    msg->mti = MTI_VERIFY_NODE_ID_ADDRESSED;
+    msg->source_id = 0x050101012200ULL;
+    msg->dest_id = 0x0A0B0C0D0E0FULL;
+    msg->payload_count = 0;
+
+    EXPECT_TRUE(TcpConfig_get_send_openlcb_msg()(msg));
+    EXPECT_EQ(_conn_transmit_count[0], 0);
+    EXPECT_EQ(_conn_transmit_count[1], 1);
+
+    // Once that connection drops the route is forgotten
+    TcpConfig_connection_down(1);
+    EXPECT_TRUE(TcpConfig_get_send_openlcb_msg()(msg));
+    EXPECT_EQ(_conn_transmit_count[0], 1);
+    EXPECT_EQ(_conn_transmit_count[1], 1);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_Config, drop_request_reported_with_connection)
+{
+    setup_connections_test();
+
+    TcpConfig_connection_up(1);
+    TcpConfig_run();
+    TcpConfig_run();
+    memset(_conn_transmit_count, 0, sizeof(_conn_transmit_count));
+
+    uint8_t wire[32];
+    uint16_t len = TcpUtilities_encode_preamble(wire, 0x0000, 2, 0x0A0B0C0D0E0FULL, 0);
+    len += TcpUtilities_encode_uint16(&wire[len], TCP_LINK_CONTROL_DROP_REQUEST);
+
+    TcpConfig_connection_incoming_data(1, wire, len);
+    TcpConfig_run();
+
+    EXPECT_EQ(_conn_drop_connection, 1);
+    EXPECT_FALSE(_drop_requested);
+    EXPECT_EQ(_conn_transmit_count[1], 1);
+    EXPECT_EQ(_conn_transmit_count[0], 0);
+}
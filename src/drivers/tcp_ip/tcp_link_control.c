@@ -58,9 +58,9 @@ static uint16_t _decode_link_control_type(const uint8_t *data, uint16_t len) {
 /**
  * @brief Sets the pending Status Reply flag in the statemachine info.
  */
-static void _handle_status_request(void) {
+static void _handle_status_request(uint8_t connection) {
 
-    tcp_statemachine_info_t *info = _interface->get_statemachine_info();
+    tcp_statemachine_info_t *info = _interface->get_statemachine_info(connection);
 
     if (info) {
 
@@ -76,9 +76,9 @@ static void _handle_status_request(void) {
  * @details The on_link_drop_requested callback is NOT fired here.
  * It fires in TcpLinkControl_run() after the reply has been sent.
  */
-static void _handle_drop_link_request(void) {
+static void _handle_drop_link_request(uint8_t connection) {
 
-    tcp_statemachine_info_t *info = _interface->get_statemachine_info();
+    tcp_statemachine_info_t *info = _interface->get_statemachine_info(connection);
 
     if (info) {
 
@@ -97,7 +97,7 @@ void TcpLinkControl_initialize(const interface_tcp_link_control_t *interface) {
     _interface = interface;
 }
 
-void TcpLinkControl_handle(uint16_t flags, const uint8_t *data, uint16_t len) {
+void TcpLinkControl_handle(uint8_t connection, uint16_t flags, const uint8_t *data, uint16_t len) {
 
     (void) flags;
 
@@ -106,21 +106,21 @@ void TcpLinkControl_handle(uint16_t flags, const uint8_t *data, uint16_t len) {
     switch (type) {
 
         case TCP_LINK_CONTROL_STATUS_REQUEST:
-            _handle_status_request();
+            _handle_status_request(connection);
             break;
 
         case TCP_LINK_CONTROL_STATUS_REPLY:
             if (_interface->on_link_status_changed)
-                _interface->on_link_status_changed(true);
+                _interface->on_link_status_changed(connection, true);
             break;
 
         case TCP_LINK_CONTROL_DROP_REQUEST:
-            _handle_drop_link_request();
+            _handle_drop_link_request(connection);
             break;
 
         case TCP_LINK_CONTROL_DROP_REPLY:
             if (_interface->on_link_status_changed)
-                _interface->on_link_status_changed(false);
+                _interface->on_link_status_changed(connection, false);
             break;
 
         default:
@@ -141,7 +141,7 @@ bool TcpLinkControl_run(tcp_statemachine_info_t *info) {
         uint8_t reply_body[2];
         TcpUtilities_encode_uint16(reply_body, TCP_LINK_CONTROL_STATUS_REPLY);
 
-        if (_interface->send_link_control(0x0000, reply_body, 2)) {
+        if (_interface->send_link_control(info->connection, 0x0000, reply_body, 2)) {
 
             info->pending_status_reply = 0;
 
@@ -154,13 +154,13 @@ bool TcpLinkControl_run(tcp_statemachine_info_t *info) {
         uint8_t reply_body[2];
         TcpUtilities_encode_uint16(reply_body, TCP_LINK_CONTROL_DROP_REPLY);
 
-        if (_interface->send_link_control(0x0000, reply_body, 2)) {
+        if (_interface->send_link_control(info->connection, 0x0000, reply_body, 2)) {
 
             info->pending_drop_reply = 0;
 
             if (_interface->on_link_drop_requested) {
 
-                _interface->on_link_drop_requested();
+                _interface->on_link_drop_requested(info->connection);
 
             }
 
@@ -172,20 +172,20 @@ bool TcpLinkControl_run(tcp_statemachine_info_t *info) {
 
 }
 
-bool TcpLinkControl_send_status_request(void) {
+bool TcpLinkControl_send_status_request(uint8_t connection) {
 
     uint8_t body[2];
 
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
 
-    return _interface->send_link_control(0x0000, body, 2);
+    return _interface->send_link_control(connection, 0x0000, body, 2);
 }
 
-bool TcpLinkControl_send_drop_link_request(void) {
+bool TcpLinkControl_send_drop_link_request(uint8_t connection) {
 
     uint8_t body[2];
 
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REQUEST);
 
-    return _interface->send_link_control(0x0000, body, 2);
+    return _interface->send_link_control(connection, 0x0000, body, 2);
 }
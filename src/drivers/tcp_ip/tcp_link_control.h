@@ -51,18 +51,18 @@ typedef struct {
 
     /** @brief REQUIRED. Send a link control message via the TX path.
      *  Typical: TcpTxStatemachine_send_link_control. */
-    bool (*send_link_control)(uint16_t flags, const uint8_t *body, uint16_t body_len);
+    bool (*send_link_control)(uint8_t connection, uint16_t flags, const uint8_t *body, uint16_t body_len);
 
-    /** @brief REQUIRED. Return a pointer to the TCP statemachine info.
+    /** @brief REQUIRED. Return a pointer to a connection's TCP statemachine info.
      *  Typical: TcpMainStatemachine_get_statemachine_info. */
-    tcp_statemachine_info_t *(*get_statemachine_info)(void);
+    tcp_statemachine_info_t *(*get_statemachine_info)(uint8_t connection);
 
     /** @brief OPTIONAL. Called when a Drop Link Request is received.
-     *  The application should close the TCP connection.  May be NULL. */
-    void (*on_link_drop_requested)(void);
+     *  The application should close that TCP connection.  May be NULL. */
+    void (*on_link_drop_requested)(uint8_t connection);
 
     /** @brief OPTIONAL. Called when link status changes.  May be NULL. */
-    void (*on_link_status_changed)(bool is_up);
+    void (*on_link_status_changed)(uint8_t connection, bool is_up);
 
 } interface_tcp_link_control_t;
 
@@ -87,11 +87,12 @@ extern "C" {
      * bit 15 = 0 is received.  Routes to the appropriate handler based
      * on the link control type in the body.
      *
-     * @param flags    16-bit flags from the preamble.
-     * @param data     Pointer to the link control body bytes (after preamble).
-     * @param len      Number of body bytes.
+     * @param connection  Connection the message arrived on.
+     * @param flags       16-bit flags from the preamble.
+     * @param data        Pointer to the link control body bytes (after preamble).
+     * @param len         Number of body bytes.
      */
-    extern void TcpLinkControl_handle(uint16_t flags, const uint8_t *data, uint16_t len);
+    extern void TcpLinkControl_handle(uint8_t connection, uint16_t flags, const uint8_t *data, uint16_t len);
 
     /**
      * @brief Drives the link control run-loop.
@@ -100,7 +101,8 @@ extern "C" {
      * For Drop Link Reply, fires on_link_drop_requested only after
      * the reply has been successfully sent.
      *
-     * @param info  Pointer to the TCP statemachine info (carries pending bits).
+     * @param info  Pointer to one connection's TCP statemachine info (carries
+     *              the connection index and pending bits).
      *
      * @return true if work is still pending, false if idle.
      */
@@ -109,16 +111,20 @@ extern "C" {
     /**
      * @brief Sends a Status Request message to the peer.
      *
+     * @param connection  Connection to send on.
+     *
      * @return true on success, false if transmit fails.
      */
-    extern bool TcpLinkControl_send_status_request(void);
+    extern bool TcpLinkControl_send_status_request(uint8_t connection);
 
     /**
      * @brief Sends a Drop Link Request to the peer.
      *
+     * @param connection  Connection to send on.
+     *
      * @return true on success, false if transmit fails.
      */
-    extern bool TcpLinkControl_send_drop_link_request(void);
+    extern bool TcpLinkControl_send_drop_link_request(uint8_t connection);
 
 #ifdef __cplusplus
 }
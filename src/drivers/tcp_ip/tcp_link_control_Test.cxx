@@ -20,6 +20,7 @@
  *   - Send Drop Link Request
  *   - Unknown link control type ignored
  *   - Body too short ignored
+ *   - Connection index carried through handle, run, send and callbacks
  *
  * Author: Test Suite
  * Date: 2026-04-05
@@ -38,11 +39,14 @@ static uint16_t _sent_flags = 0;
 static uint8_t _sent_body[64];
 static uint16_t _sent_body_len = 0;
 static int _send_count = 0;
+static uint8_t _sent_connection = 0xFF;
 static bool _send_returns_false = false;
 
 static bool _link_drop_requested = false;
 static bool _link_status_changed_called = false;
 static bool _link_status_is_up = false;
+static uint8_t _callback_connection = 0xFF;
+static uint8_t _info_requested_connection = 0xFF;
 
 static tcp_statemachine_info_t _mock_info;
 
@@ -50,7 +54,7 @@ static tcp_statemachine_info_t _mock_info;
 // Mock functions
 // =============================================================================
 
-static bool _mock_send_link_control(uint16_t flags, const uint8_t *body, uint16_t body_len)
+static bool _mock_send_link_control(uint8_t connection, uint16_t flags, const uint8_t *body, uint16_t body_len)
 {
 
     if (_send_returns_false) {
@@ -59,6 +63,7 @@ static bool _mock_send_link_control(uint16_t flags, const uint8_t *body, uint16_
 
     }
 
+    _sent_connection = connection;
     _sent_flags = flags;
     _sent_body_len = body_len;
     _send_count++;
@@ -72,9 +77,11 @@ static bool _mock_send_link_control(uint16_t flags, const uint8_t *body, uint16_
 
 static bool _statemachine_info_returns_null = false;
 
-static tcp_statemachine_info_t *_mock_get_statemachine_info(void)
+static tcp_statemachine_info_t *_mock_get_statemachine_info(uint8_t connection)
 {
 
+    _info_requested_connection = connection;
+
     if (_statemachine_info_returns_null)
         return NULL;
 
@@ -82,16 +89,20 @@ static tcp_statemachine_info_t *_mock_get_statemachine_info(void)
 
 }
 
-static void _mock_on_link_drop_requested(void)
+static void _mock_on_link_drop_requested(uint8_t connection)
 {
 
+    _callback_connection = connection;
+
     _link_drop_requested = true;
 
 }
 
-static void _mock_on_link_status_changed(bool is_up)
+static void _mock_on_link_status_changed(uint8_t connection, bool is_up)
 {
 
+    _callback_connection = connection;
+
     _link_status_changed_called = true;
     _link_status_is_up = is_up;
 
@@ -116,12 +127,15 @@ static void reset_mocks(void)
     _sent_flags = 0;
     _sent_body_len = 0;
     _send_count = 0;
+    _sent_connection = 0xFF;
     _send_returns_false = false;
     memset(_sent_body, 0, sizeof(_sent_body));
 
     _link_drop_requested = false;
     _link_status_changed_called = false;
     _link_status_is_up = false;
+    _callback_connection = 0xFF;
+    _info_requested_connection = 0xFF;
 
     _statemachine_info_returns_null = false;
     memset(&_mock_info, 0, sizeof(_mock_info));
@@ -148,7 +162,7 @@ TEST(TCP_LinkControl, handle_status_request_sets_pending_bit)
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
 
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     // Should NOT send immediately
     EXPECT_EQ(_send_count, 0);
@@ -170,7 +184,7 @@ TEST(TCP_LinkControl, run_sends_status_reply)
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
 
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     // Run flushes the pending reply
     bool busy = TcpLinkControl_run(&_mock_info);
@@ -198,7 +212,7 @@ TEST(TCP_LinkControl, handle_status_reply_notifies_link_up)
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REPLY);
 
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     EXPECT_TRUE(_link_status_changed_called);
     EXPECT_TRUE(_link_status_is_up);
@@ -218,7 +232,7 @@ TEST(TCP_LinkControl, handle_drop_link_request_sets_pending_bit)
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REQUEST);
 
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     // Should NOT send immediately and NOT call drop callback
     EXPECT_EQ(_send_count, 0);
@@ -241,7 +255,7 @@ TEST(TCP_LinkControl, run_sends_drop_reply_and_notifies)
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REQUEST);
 
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     // Run flushes the pending reply
     bool busy = TcpLinkControl_run(&_mock_info);
@@ -271,7 +285,7 @@ TEST(TCP_LinkControl, run_retries_status_reply_on_send_failure)
 
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     // First run: send fails
     _send_returns_false = true;
@@ -304,7 +318,7 @@ TEST(TCP_LinkControl, run_retries_drop_reply_on_send_failure)
 
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REQUEST);
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     // First run: send fails
     _send_returns_false = true;
@@ -371,7 +385,7 @@ TEST(TCP_LinkControl, handle_drop_link_reply_notifies_link_down)
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REPLY);
 
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     EXPECT_TRUE(_link_status_changed_called);
     EXPECT_FALSE(_link_status_is_up);
@@ -388,7 +402,7 @@ TEST(TCP_LinkControl, send_status_request)
 
     setup_test();
 
-    bool result = TcpLinkControl_send_status_request();
+    bool result = TcpLinkControl_send_status_request(0);
 
     EXPECT_TRUE(result);
     EXPECT_EQ(_send_count, 1);
@@ -408,7 +422,7 @@ TEST(TCP_LinkControl, send_drop_link_request)
 
     setup_test();
 
-    bool result = TcpLinkControl_send_drop_link_request();
+    bool result = TcpLinkControl_send_drop_link_request(0);
 
     EXPECT_TRUE(result);
     EXPECT_EQ(_send_count, 1);
@@ -431,7 +445,7 @@ TEST(TCP_LinkControl, unknown_type_ignored)
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, 0x00FF);
 
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
 
     EXPECT_EQ(_send_count, 0);
     EXPECT_FALSE(_link_drop_requested);
@@ -450,7 +464,7 @@ TEST(TCP_LinkControl, body_too_short_ignored)
 
     uint8_t body[1] = {0x00};
 
-    TcpLinkControl_handle(0x0000, body, 1);
+    TcpLinkControl_handle(0, 0x0000, body, 1);
 
     EXPECT_EQ(_send_count, 0);
     EXPECT_FALSE(_link_drop_requested);
@@ -467,7 +481,7 @@ TEST(TCP_LinkControl, empty_body_ignored)
 
     setup_test();
 
-    TcpLinkControl_handle(0x0000, NULL, 0);
+    TcpLinkControl_handle(0, 0x0000, NULL, 0);
 
     EXPECT_EQ(_send_count, 0);
 
@@ -495,17 +509,17 @@ TEST(TCP_LinkControl, null_callbacks_no_crash)
     // Status Reply with NULL on_link_status_changed -- should not crash
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REPLY);
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
     EXPECT_EQ(_send_count, 0);
 
     // Drop Link Reply with NULL on_link_status_changed -- should not crash
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REPLY);
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
     EXPECT_EQ(_send_count, 0);
 
     // Drop Link Request sets pending bit
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REQUEST);
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
     EXPECT_EQ(_mock_info.pending_drop_reply, (uint8_t) 1);
 
     // run() sends reply with NULL on_link_drop_requested -- should not crash
@@ -527,12 +541,45 @@ TEST(TCP_LinkControl, null_statemachine_info_no_crash)
     // Status Request with NULL info -- should not crash or set pending bit
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
     EXPECT_EQ(_send_count, 0);
 
     // Drop Link Request with NULL info -- should not crash or set pending bit
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REQUEST);
-    TcpLinkControl_handle(0x0000, body, 2);
+    TcpLinkControl_handle(0, 0x0000, body, 2);
     EXPECT_EQ(_send_count, 0);
 
 }
+
+// =============================================================================
+// Connection index
+// =============================================================================
+
+TEST(TCP_LinkControl, connection_carried_through)
+{
+
+    setup_test();
+    _mock_info.connection = 1;
+
+    uint8_t body[2];
+    TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_DROP_REQUEST);
+    TcpLinkControl_handle(1, 0x0000, body, 2);
+
+    EXPECT_EQ(_info_requested_connection, 1);
+    EXPECT_EQ(_mock_info.pending_drop_reply, (uint8_t) 1);
+
+    // The reply goes back on the connection the request came from
+    TcpLinkControl_run(&_mock_info);
+    EXPECT_EQ(_sent_connection, 1);
+    EXPECT_TRUE(_link_drop_requested);
+    EXPECT_EQ(_callback_connection, 1);
+
+    TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REPLY);
+    _callback_connection = 0xFF;
+    TcpLinkControl_handle(1, 0x0000, body, 2);
+    EXPECT_EQ(_callback_connection, 1);
+
+    EXPECT_TRUE(TcpLinkControl_send_status_request(1));
+    EXPECT_EQ(_sent_connection, 1);
+
+}
@@ -42,7 +42,7 @@
 
 static const interface_tcp_login_statemachine_t *_interface;
 
-static tcp_login_state_enum _login_state;
+static tcp_login_state_enum _login_state[USER_DEFINED_TCP_MAX_CONNECTIONS];
 
 // =========================================================================
 // Public API
@@ -51,12 +51,17 @@ static tcp_login_state_enum _login_state;
 void TcpLoginStatemachine_initialize(const interface_tcp_login_statemachine_t *interface) {
 
     _interface = interface;
-    _login_state = TCP_LOGIN_IDLE;
+
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_CONNECTIONS; i++)
+        _login_state[i] = TCP_LOGIN_IDLE;
 }
 
-void TcpLoginStatemachine_link_up(void) {
+void TcpLoginStatemachine_link_up(uint8_t connection) {
+
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return;
 
-    _login_state = TCP_LOGIN_SEND_VERIFY_GLOBAL;
+    _login_state[connection] = TCP_LOGIN_SEND_VERIFY_GLOBAL;
 
     // The protocol layer's OpenLCB login statemachine handles the rest:
     // - Initialization Complete for each local node
@@ -70,9 +75,10 @@ void TcpLoginStatemachine_link_up(void) {
     // TcpLoginStatemachine_run(), which retries until the transport accepts it.
 }
 
-bool TcpLoginStatemachine_run(void) {
+bool TcpLoginStatemachine_run(uint8_t connection) {
 
-    if (_login_state != TCP_LOGIN_SEND_VERIFY_GLOBAL) {
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS ||
+            _login_state[connection] != TCP_LOGIN_SEND_VERIFY_GLOBAL) {
 
         return false;
 
@@ -96,7 +102,7 @@ bool TcpLoginStatemachine_run(void) {
     msg->dest_alias = 0;
     msg->payload_count = 0;
 
-    bool sent = _interface->send_openlcb_msg(msg);
+    bool sent = _interface->send_openlcb_msg(connection, msg);
 
     _interface->lock_shared_resources();
     _interface->free_buffer(msg);
@@ -104,7 +110,7 @@ bool TcpLoginStatemachine_run(void) {
 
     if (sent) {
 
-        _login_state = TCP_LOGIN_COMPLETE;
+        _login_state[connection] = TCP_LOGIN_COMPLETE;
         return false; // done
 
     }
@@ -113,7 +119,10 @@ bool TcpLoginStatemachine_run(void) {
 
 }
 
-tcp_login_state_enum TcpLoginStatemachine_get_state(void) {
+tcp_login_state_enum TcpLoginStatemachine_get_state(uint8_t connection) {
+
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return TCP_LOGIN_IDLE;
 
-    return _login_state;
+    return _login_state[connection];
 }
@@ -35,6 +35,9 @@
  * 1. Notifying the protocol layer that the link is up
  * 2. Triggering node login through the existing OpenLCB login statemachine
  *
+ * Each connection logs in on its own: the Verify Node ID Global that discovers
+ * remote nodes is sent only on the connection that just came up.
+ *
  * @author Jim Kueneman
  * @date 4 Apr 2026
  */
@@ -54,9 +57,9 @@
  */
 typedef struct {
 
-    /** @brief REQUIRED. Send a Verify Node ID Global to discover remote nodes.
-     *  Typical: wired to send through TcpTxStatemachine_send_openlcb_message. */
-    bool (*send_openlcb_msg)(openlcb_msg_t *msg);
+    /** @brief REQUIRED. Send a Verify Node ID Global on one connection to discover remote nodes.
+     *  Typical: TcpTxStatemachine_send_openlcb_message_to. */
+    bool (*send_openlcb_msg)(uint8_t connection, openlcb_msg_t *msg);
 
     /** @brief REQUIRED. Allocate a message buffer.
      *  Typical: OpenLcbBufferStore_allocate_buffer. */
@@ -93,8 +96,10 @@ extern "C" {
      *
      * @details Transitions to TCP_LOGIN_SEND_VERIFY_GLOBAL state.
      * The actual send happens in TcpLoginStatemachine_run().
+     *
+     * @param connection  Connection that came up.
      */
-    extern void TcpLoginStatemachine_link_up(void);
+    extern void TcpLoginStatemachine_link_up(uint8_t connection);
 
     /**
      * @brief Drives the login state machine.
@@ -103,16 +108,20 @@ extern "C" {
      * allocate a buffer and send a Verify Node ID Global message.  Retries
      * each cycle until the transport accepts the message.
      *
+     * @param connection  Connection to drive.
+     *
      * @return true if work is pending (caller should keep calling), false if idle or done.
      */
-    extern bool TcpLoginStatemachine_run(void);
+    extern bool TcpLoginStatemachine_run(uint8_t connection);
 
     /**
-     * @brief Returns the current login state.
+     * @brief Returns the current login state of a connection.
+     *
+     * @param connection  Connection to query.
      *
-     * @return Current @ref tcp_login_state_enum value.
+     * @return Current @ref tcp_login_state_enum value (TCP_LOGIN_IDLE if out of range).
      */
-    extern tcp_login_state_enum TcpLoginStatemachine_get_state(void);
+    extern tcp_login_state_enum TcpLoginStatemachine_get_state(uint8_t connection);
 
 #ifdef __cplusplus
 }
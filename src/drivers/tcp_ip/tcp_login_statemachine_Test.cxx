@@ -16,6 +16,7 @@
  *   - run() retries on send failure
  *   - run() retries on allocation failure
  *   - run() returns false when IDLE or COMPLETE
+ *   - Each connection logs in on its own and sends only on itself
  *
  * Author: Test Suite
  * Date: 2026-04-05
@@ -36,6 +37,7 @@ static uint16_t _sent_mti = 0;
 static node_id_t _sent_source_id = 0;
 static node_id_t _sent_dest_id = 0;
 static bool _send_returns_false = false;
+static uint8_t _sent_connection = 0xFF;
 
 static int _allocate_count = 0;
 static int _free_count = 0;
@@ -45,7 +47,7 @@ static bool _allocate_returns_null = false;
 // Mock functions
 // =============================================================================
 
-static bool _mock_send(openlcb_msg_t *msg)
+static bool _mock_send(uint8_t connection, openlcb_msg_t *msg)
 {
 
     if (_send_returns_false) {
@@ -55,6 +57,7 @@ static bool _mock_send(openlcb_msg_t *msg)
     }
 
     _send_called = true;
+    _sent_connection = connection;
     _sent_mti = msg->mti;
     _sent_source_id = msg->source_id;
     _sent_dest_id = msg->dest_id;
@@ -107,6 +110,7 @@ static void reset_mocks(void)
     _sent_source_id = 0;
     _sent_dest_id = 0;
     _send_returns_false = false;
+    _sent_connection = 0xFF;
     _allocate_count = 0;
     _free_count = 0;
     _allocate_returns_null = false;
@@ -131,7 +135,7 @@ TEST(TCP_LoginStatemachine, initialize_sets_idle)
 
     setup_test();
 
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_IDLE);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_IDLE);
 
 }
 
@@ -144,9 +148,9 @@ TEST(TCP_LoginStatemachine, link_up_transitions_to_send_verify_global)
 
     setup_test();
 
-    TcpLoginStatemachine_link_up();
+    TcpLoginStatemachine_link_up(0);
 
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_SEND_VERIFY_GLOBAL);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_SEND_VERIFY_GLOBAL);
     EXPECT_FALSE(_send_called);
     EXPECT_EQ(_allocate_count, 0);
 
@@ -161,16 +165,16 @@ TEST(TCP_LoginStatemachine, run_sends_verify_and_completes)
 
     setup_test();
 
-    TcpLoginStatemachine_link_up();
+    TcpLoginStatemachine_link_up(0);
 
-    bool busy = TcpLoginStatemachine_run();
+    bool busy = TcpLoginStatemachine_run(0);
 
     EXPECT_FALSE(busy);
     EXPECT_TRUE(_send_called);
     EXPECT_EQ(_sent_mti, MTI_VERIFY_NODE_ID_GLOBAL);
     EXPECT_EQ(_sent_source_id, (node_id_t) 0);
     EXPECT_EQ(_sent_dest_id, (node_id_t) 0);
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_COMPLETE);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_COMPLETE);
     EXPECT_EQ(_allocate_count, 1);
     EXPECT_EQ(_free_count, 1);
 
@@ -185,27 +189,27 @@ TEST(TCP_LoginStatemachine, run_retries_on_send_failure)
 
     setup_test();
 
-    TcpLoginStatemachine_link_up();
+    TcpLoginStatemachine_link_up(0);
 
     // First run: send fails
     _send_returns_false = true;
 
-    bool busy = TcpLoginStatemachine_run();
+    bool busy = TcpLoginStatemachine_run(0);
 
     EXPECT_TRUE(busy);
     EXPECT_FALSE(_send_called);
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_SEND_VERIFY_GLOBAL);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_SEND_VERIFY_GLOBAL);
     EXPECT_EQ(_allocate_count, 1);
     EXPECT_EQ(_free_count, 1);
 
     // Second run: send succeeds
     _send_returns_false = false;
 
-    busy = TcpLoginStatemachine_run();
+    busy = TcpLoginStatemachine_run(0);
 
     EXPECT_FALSE(busy);
     EXPECT_TRUE(_send_called);
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_COMPLETE);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_COMPLETE);
     EXPECT_EQ(_allocate_count, 2);
     EXPECT_EQ(_free_count, 2);
 
@@ -220,27 +224,27 @@ TEST(TCP_LoginStatemachine, run_retries_on_allocation_failure)
 
     setup_test();
 
-    TcpLoginStatemachine_link_up();
+    TcpLoginStatemachine_link_up(0);
 
     // First run: allocation fails
     _allocate_returns_null = true;
 
-    bool busy = TcpLoginStatemachine_run();
+    bool busy = TcpLoginStatemachine_run(0);
 
     EXPECT_TRUE(busy);
     EXPECT_FALSE(_send_called);
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_SEND_VERIFY_GLOBAL);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_SEND_VERIFY_GLOBAL);
     EXPECT_EQ(_allocate_count, 1);
     EXPECT_EQ(_free_count, 0);
 
     // Second run: allocation succeeds, send succeeds
     _allocate_returns_null = false;
 
-    busy = TcpLoginStatemachine_run();
+    busy = TcpLoginStatemachine_run(0);
 
     EXPECT_FALSE(busy);
     EXPECT_TRUE(_send_called);
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_COMPLETE);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_COMPLETE);
     EXPECT_EQ(_allocate_count, 2);
     EXPECT_EQ(_free_count, 1);
 
@@ -256,7 +260,7 @@ TEST(TCP_LoginStatemachine, run_returns_false_when_idle)
     setup_test();
 
     // State is IDLE, run should be a no-op
-    bool busy = TcpLoginStatemachine_run();
+    bool busy = TcpLoginStatemachine_run(0);
 
     EXPECT_FALSE(busy);
     EXPECT_FALSE(_send_called);
@@ -273,15 +277,15 @@ TEST(TCP_LoginStatemachine, run_returns_false_when_complete)
 
     setup_test();
 
-    TcpLoginStatemachine_link_up();
-    TcpLoginStatemachine_run();
+    TcpLoginStatemachine_link_up(0);
+    TcpLoginStatemachine_run(0);
 
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_COMPLETE);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_COMPLETE);
 
     // Run again after completion
     reset_mocks();
 
-    bool busy = TcpLoginStatemachine_run();
+    bool busy = TcpLoginStatemachine_run(0);
 
     EXPECT_FALSE(busy);
     EXPECT_FALSE(_send_called);
@@ -298,11 +302,42 @@ TEST(TCP_LoginStatemachine, reinitialize_resets_to_idle)
 
     setup_test();
 
-    TcpLoginStatemachine_link_up();
-    TcpLoginStatemachine_run();
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_COMPLETE);
+    TcpLoginStatemachine_link_up(0);
+    TcpLoginStatemachine_run(0);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_COMPLETE);
 
     TcpLoginStatemachine_initialize(&_interface);
-    EXPECT_EQ(TcpLoginStatemachine_get_state(), TCP_LOGIN_IDLE);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_IDLE);
+
+}
+
+// =============================================================================
+// Multiple connections
+// =============================================================================
+
+TEST(TCP_LoginStatemachine, connections_log_in_independently)
+{
+
+    setup_test();
+
+    TcpLoginStatemachine_link_up(0);
+    TcpLoginStatemachine_run(0);
+    EXPECT_EQ(_sent_connection, 0);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_COMPLETE);
+
+    // A second client connecting later gets its own Verify Node ID Global
+    EXPECT_EQ(TcpLoginStatemachine_get_state(1), TCP_LOGIN_IDLE);
+    TcpLoginStatemachine_link_up(1);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(0), TCP_LOGIN_COMPLETE);
+
+    EXPECT_FALSE(TcpLoginStatemachine_run(1));
+    EXPECT_EQ(_sent_connection, 1);
+    EXPECT_EQ(_sent_mti, MTI_VERIFY_NODE_ID_GLOBAL);
+    EXPECT_EQ(TcpLoginStatemachine_get_state(1), TCP_LOGIN_COMPLETE);
+
+    // Out of range is ignored
+    TcpLoginStatemachine_link_up(USER_DEFINED_TCP_MAX_CONNECTIONS);
+    EXPECT_FALSE(TcpLoginStatemachine_run(USER_DEFINED_TCP_MAX_CONNECTIONS));
+    EXPECT_EQ(TcpLoginStatemachine_get_state(USER_DEFINED_TCP_MAX_CONNECTIONS), TCP_LOGIN_IDLE);
 
 }
@@ -39,7 +39,7 @@
 
 static const interface_tcp_main_statemachine_t *_interface;
 
-static tcp_statemachine_info_t _statemachine_info;
+static tcp_statemachine_info_t _statemachine_info[USER_DEFINED_TCP_MAX_CONNECTIONS];
 
 // =========================================================================
 // Public API
@@ -49,54 +49,86 @@ void TcpMainStatemachine_initialize(const interface_tcp_main_statemachine_t *int
 
     _interface = interface;
 
-    _statemachine_info.openlcb_node = NULL;
-    _statemachine_info.login_state = TCP_LOGIN_IDLE;
-    _statemachine_info.link_state = TCP_LINK_STATE_DISCONNECTED;
-    _statemachine_info.current_tick = 0;
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_CONNECTIONS; i++) {
+
+        _statemachine_info[i].openlcb_node = NULL;
+        _statemachine_info[i].login_state = TCP_LOGIN_IDLE;
+        _statemachine_info[i].link_state = TCP_LINK_STATE_DISCONNECTED;
+        _statemachine_info[i].current_tick = 0;
+        _statemachine_info[i].connection = i;
+        _statemachine_info[i].pending_status_reply = 0;
+        _statemachine_info[i].pending_drop_reply = 0;
+    }
 }
 
-void TcpMainStatemachine_link_up(void) {
+void TcpMainStatemachine_link_up(uint8_t connection) {
+
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return;
 
-    _statemachine_info.link_state = TCP_LINK_STATE_LOGGING_IN;
-    _statemachine_info.pending_status_reply = 0;
-    _statemachine_info.pending_drop_reply = 0;
+    tcp_statemachine_info_t *info = &_statemachine_info[connection];
 
-    _interface->login_link_up();
+    info->link_state = TCP_LINK_STATE_LOGGING_IN;
+    info->pending_status_reply = 0;
+    info->pending_drop_reply = 0;
+
+    _interface->login_link_up(connection);
 
     if (_interface->on_link_status_changed)
-        _interface->on_link_status_changed(true);
+        _interface->on_link_status_changed(connection, true);
 }
 
-void TcpMainStatemachine_link_down(void) {
+void TcpMainStatemachine_link_down(uint8_t connection) {
+
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return;
 
-    _statemachine_info.link_state = TCP_LINK_STATE_DISCONNECTED;
-    _statemachine_info.login_state = TCP_LOGIN_IDLE;
+    tcp_statemachine_info_t *info = &_statemachine_info[connection];
+
+    info->link_state = TCP_LINK_STATE_DISCONNECTED;
+    info->login_state = TCP_LOGIN_IDLE;
 
     if (_interface->on_link_status_changed)
-        _interface->on_link_status_changed(false);
+        _interface->on_link_status_changed(connection, false);
 }
 
 bool TcpMainStatemachine_run(void) {
 
     bool busy = false;
 
-    // Drive login sequence
-    if (_statemachine_info.link_state == TCP_LINK_STATE_LOGGING_IN) {
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_CONNECTIONS; i++) {
 
-        if (_interface->login_run()) {
+        tcp_statemachine_info_t *info = &_statemachine_info[i];
 
-            busy = true;
+        if (info->link_state == TCP_LINK_STATE_DISCONNECTED)
+            continue;
+
+        // Drive login sequence
+        if (info->link_state == TCP_LINK_STATE_LOGGING_IN) {
+
+            if (_interface->login_run(i)) {
 
-        } else if (_interface->login_get_state() == TCP_LOGIN_COMPLETE) {
+                busy = true;
 
-            _statemachine_info.link_state = TCP_LINK_STATE_RUNNING;
+            } else if (_interface->login_get_state(i) == TCP_LOGIN_COMPLETE) {
+
+                info->link_state = TCP_LINK_STATE_RUNNING;
+
+            }
+
+        }
+
+        // Drive link control pending replies
+        if (_interface->link_control_run(info)) {
+
+            busy = true;
 
         }
 
     }
 
-    // Drive link control pending replies
-    if (_interface->link_control_run(&_statemachine_info)) {
+    // Flush batched TX on deadline or when nothing new was queued
+    if (_interface->tx_run && _interface->tx_run()) {
 
         busy = true;
 
@@ -106,12 +138,18 @@ bool TcpMainStatemachine_run(void) {
 
 }
 
-tcp_link_state_enum TcpMainStatemachine_get_link_state(void) {
+tcp_link_state_enum TcpMainStatemachine_get_link_state(uint8_t connection) {
 
-    return _statemachine_info.link_state;
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return TCP_LINK_STATE_DISCONNECTED;
+
+    return _statemachine_info[connection].link_state;
 }
 
-tcp_statemachine_info_t *TcpMainStatemachine_get_statemachine_info(void) {
+tcp_statemachine_info_t *TcpMainStatemachine_get_statemachine_info(uint8_t connection) {
+
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return NULL;
 
-    return &_statemachine_info;
+    return &_statemachine_info[connection];
 }
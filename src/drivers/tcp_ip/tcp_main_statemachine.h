@@ -30,7 +30,8 @@
  *
  * @details Simpler than the CAN main state machine: no alias management,
  * no duplicate detection.  Coordinates link-up/down signaling and drives
- * the TCP login sequence.
+ * the TCP login sequence.  Keeps one @ref tcp_statemachine_info_t per
+ * connection and drives every connection on each run.
  *
  * @author Jim Kueneman
  * @date 4 Apr 2026
@@ -53,15 +54,15 @@ typedef struct {
 
     /** @brief REQUIRED. Trigger TCP login (sends Verify Node ID Global).
      *  Typical: TcpLoginStatemachine_link_up. */
-    void (*login_link_up)(void);
+    void (*login_link_up)(uint8_t connection);
 
-    /** @brief REQUIRED. Drive the login state machine.
+    /** @brief REQUIRED. Drive the login state machine of one connection.
      *  Typical: TcpLoginStatemachine_run. */
-    bool (*login_run)(void);
+    bool (*login_run)(uint8_t connection);
 
-    /** @brief REQUIRED. Get current login state.
+    /** @brief REQUIRED. Get the login state of one connection.
      *  Typical: TcpLoginStatemachine_get_state. */
-    tcp_login_state_enum (*login_get_state)(void);
+    tcp_login_state_enum (*login_get_state)(uint8_t connection);
 
     /** @brief REQUIRED. Drive the link control run-loop.
      *  Typical: TcpLinkControl_run. */
@@ -72,7 +73,11 @@ typedef struct {
     uint8_t (*get_current_tick)(void);
 
     /** @brief OPTIONAL. Called when the link state changes. May be NULL. */
-    void (*on_link_status_changed)(bool is_up);
+    void (*on_link_status_changed)(uint8_t connection, bool is_up);
+
+    /** @brief OPTIONAL. Drive the TX coalescing flush rules.
+     *  Typical: TcpTxStatemachine_run. May be NULL. */
+    bool (*tx_run)(void);
 
 } interface_tcp_main_statemachine_t;
 
@@ -91,45 +96,56 @@ extern "C" {
     extern void TcpMainStatemachine_initialize(const interface_tcp_main_statemachine_t *interface);
 
     /**
-     * @brief Signals that the TCP connection has been established.
+     * @brief Signals that a TCP connection has been established.
+     *
+     * @details Transitions the connection's link state to LOGGING_IN and
+     * starts its login sequence.
      *
-     * @details Transitions the link state to CONNECTING and starts the
-     * login sequence.
+     * @param connection  Connection that came up.
      */
-    extern void TcpMainStatemachine_link_up(void);
+    extern void TcpMainStatemachine_link_up(uint8_t connection);
 
     /**
-     * @brief Signals that the TCP connection has been lost.
+     * @brief Signals that a TCP connection has been lost.
+     *
+     * @details Transitions the connection's link state to DISCONNECTED.
      *
-     * @details Transitions the link state to DISCONNECTED.
+     * @param connection  Connection that went down.
      */
-    extern void TcpMainStatemachine_link_down(void);
+    extern void TcpMainStatemachine_link_down(uint8_t connection);
 
     /**
-     * @brief Returns the current link state.
+     * @brief Returns the current link state of a connection.
      *
-     * @return Current @ref tcp_link_state_enum value.
+     * @param connection  Connection to query.
+     *
+     * @return Current @ref tcp_link_state_enum value (DISCONNECTED if out of range).
      */
-    extern tcp_link_state_enum TcpMainStatemachine_get_link_state(void);
+    extern tcp_link_state_enum TcpMainStatemachine_get_link_state(uint8_t connection);
 
     /**
      * @brief Drives the TCP main state machine run-loop.
      *
-     * @details Calls the login run-loop during LOGGING_IN state, and the
-     * link control run-loop to flush pending replies.
+     * @details For every connection, calls the login run-loop during
+     * LOGGING_IN state and the link control run-loop to flush pending
+     * replies; then applies the TX coalescing flush rules once.
      *
      * @return true if work is pending, false if idle.
      */
     extern bool TcpMainStatemachine_run(void);
 
     /**
-     * @brief Returns a pointer to the internal statemachine context.
+     * @brief Returns a pointer to a connection's statemachine context.
+     *
+     * @details Used by link control to set pending reply bits, and for
+     * unit testing and debugging.
      *
-     * @details Intended for unit testing and debugging only.
+     * @param connection  Connection to query.
      *
-     * @return Pointer to the internal @ref tcp_statemachine_info_t.
+     * @return Pointer to the internal @ref tcp_statemachine_info_t, or NULL
+     *         if out of range.
      */
-    extern tcp_statemachine_info_t *TcpMainStatemachine_get_statemachine_info(void);
+    extern tcp_statemachine_info_t *TcpMainStatemachine_get_statemachine_info(uint8_t connection);
 
 #ifdef __cplusplus
 }
@@ -16,8 +16,11 @@
  *   - run() drives login and transitions to RUNNING on completion
  *   - run() stays in LOGGING_IN while login is busy
  *   - run() drives link control pending replies
+ *   - run() drives the optional TX coalescing flush
  *   - link_down transitions to DISCONNECTED
  *   - NULL on_link_status_changed does not crash
+ *   - Connections: independent link state and login, link control per
+ *     connection, disconnected connections skipped
  *
  * Author: Test Suite
  * Date: 2026-04-05
@@ -32,6 +35,7 @@
 // =============================================================================
 
 static bool _login_link_up_called = false;
+static uint8_t _login_connection = 0xFF;
 static tcp_login_state_enum _mock_login_state = TCP_LOGIN_IDLE;
 static bool _login_run_returns_busy = false;
 static int _login_run_count = 0;
@@ -39,33 +43,40 @@ static uint8_t _mock_tick = 0;
 
 static bool _status_changed_called = false;
 static bool _status_is_up = false;
+static uint8_t _status_connection = 0xFF;
 
 static int _link_control_run_count = 0;
 static bool _link_control_run_returns_busy = false;
 static tcp_statemachine_info_t *_link_control_run_info = NULL;
+static int _tx_run_count = 0;
+static bool _tx_run_returns_busy = false;
 
 // =============================================================================
 // Mock functions
 // =============================================================================
 
-static void _mock_login_link_up(void)
+static void _mock_login_link_up(uint8_t connection)
 {
 
     _login_link_up_called = true;
+    _login_connection = connection;
 
 }
 
-static tcp_login_state_enum _mock_login_get_state(void)
+static tcp_login_state_enum _mock_login_get_state(uint8_t connection)
 {
 
+    (void) connection;
+
     return _mock_login_state;
 
 }
 
-static bool _mock_login_run(void)
+static bool _mock_login_run(uint8_t connection)
 {
 
     _login_run_count++;
+    _login_connection = connection;
 
     if (_login_run_returns_busy) {
 
@@ -87,6 +98,14 @@ static bool _mock_link_control_run(tcp_statemachine_info_t *info)
 
 }
 
+static bool _mock_tx_run(void)
+{
+
+    _tx_run_count++;
+    return _tx_run_returns_busy;
+
+}
+
 static uint8_t _mock_get_tick(void)
 {
 
@@ -94,10 +113,11 @@ static uint8_t _mock_get_tick(void)
 
 }
 
-static void _mock_on_link_status_changed(bool is_up)
+static void _mock_on_link_status_changed(uint8_t connection, bool is_up)
 {
 
     _status_changed_called = true;
+    _status_connection = connection;
     _status_is_up = is_up;
 
 }
@@ -112,6 +132,8 @@ static void reset_mocks(void)
 {
 
     _login_link_up_called = false;
+    _login_connection = 0xFF;
+    _status_connection = 0xFF;
     _mock_login_state = TCP_LOGIN_IDLE;
     _login_run_returns_busy = false;
     _login_run_count = 0;
@@ -121,6 +143,8 @@ static void reset_mocks(void)
     _link_control_run_count = 0;
     _link_control_run_returns_busy = false;
     _link_control_run_info = NULL;
+    _tx_run_count = 0;
+    _tx_run_returns_busy = false;
 
 }
 
@@ -135,6 +159,7 @@ static void setup_test(void)
     _interface.link_control_run       = &_mock_link_control_run;
     _interface.get_current_tick       = &_mock_get_tick;
     _interface.on_link_status_changed = &_mock_on_link_status_changed;
+    _interface.tx_run                 = NULL;
 
     TcpMainStatemachine_initialize(&_interface);
 
@@ -149,7 +174,7 @@ TEST(TCP_MainStatemachine, initialize_sets_disconnected)
 
     setup_test();
 
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_DISCONNECTED);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_DISCONNECTED);
 
 }
 
@@ -158,7 +183,7 @@ TEST(TCP_MainStatemachine, initialize_clears_statemachine_info)
 
     setup_test();
 
-    tcp_statemachine_info_t *info = TcpMainStatemachine_get_statemachine_info();
+    tcp_statemachine_info_t *info = TcpMainStatemachine_get_statemachine_info(0);
     ASSERT_NE(info, nullptr);
     EXPECT_EQ(info->openlcb_node, nullptr);
     EXPECT_EQ(info->login_state, TCP_LOGIN_IDLE);
@@ -176,7 +201,7 @@ TEST(TCP_MainStatemachine, link_up_triggers_login)
 
     setup_test();
 
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
 
     EXPECT_TRUE(_login_link_up_called);
 
@@ -187,9 +212,9 @@ TEST(TCP_MainStatemachine, link_up_transitions_to_logging_in)
 
     setup_test();
 
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
 
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_LOGGING_IN);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_LOGGING_IN);
 
 }
 
@@ -198,7 +223,7 @@ TEST(TCP_MainStatemachine, link_up_notifies_status_changed_true)
 
     setup_test();
 
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
 
     EXPECT_TRUE(_status_changed_called);
     EXPECT_TRUE(_status_is_up);
@@ -211,11 +236,11 @@ TEST(TCP_MainStatemachine, link_up_clears_pending_bits)
     setup_test();
 
     // Set pending bits before link_up
-    tcp_statemachine_info_t *info = TcpMainStatemachine_get_statemachine_info();
+    tcp_statemachine_info_t *info = TcpMainStatemachine_get_statemachine_info(0);
     info->pending_status_reply = 1;
     info->pending_drop_reply = 1;
 
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
 
     EXPECT_EQ(info->pending_status_reply, (uint8_t) 0);
     EXPECT_EQ(info->pending_drop_reply, (uint8_t) 0);
@@ -231,13 +256,13 @@ TEST(TCP_MainStatemachine, run_completes_login_transitions_to_running)
 
     setup_test();
 
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
 
     // login_run will set state to COMPLETE and return false
     bool busy = TcpMainStatemachine_run();
 
     EXPECT_EQ(_login_run_count, 1);
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_RUNNING);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_RUNNING);
     EXPECT_FALSE(busy);
 
 }
@@ -247,14 +272,14 @@ TEST(TCP_MainStatemachine, run_stays_logging_in_while_login_busy)
 
     setup_test();
 
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
 
     _login_run_returns_busy = true;
 
     bool busy = TcpMainStatemachine_run();
 
     EXPECT_TRUE(busy);
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_LOGGING_IN);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_LOGGING_IN);
 
 }
 
@@ -268,9 +293,9 @@ TEST(TCP_MainStatemachine, run_drives_link_control)
     setup_test();
 
     // Get past login
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
     TcpMainStatemachine_run();
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_RUNNING);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_RUNNING);
 
     _link_control_run_count = 0;
 
@@ -287,7 +312,7 @@ TEST(TCP_MainStatemachine, run_returns_busy_when_link_control_busy)
     setup_test();
 
     // Get past login
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
     TcpMainStatemachine_run();
 
     _link_control_run_returns_busy = true;
@@ -298,6 +323,34 @@ TEST(TCP_MainStatemachine, run_returns_busy_when_link_control_busy)
 
 }
 
+TEST(TCP_MainStatemachine, run_drives_tx_flush_when_wired)
+{
+
+    setup_test();
+
+    TcpMainStatemachine_link_up(0);
+    TcpMainStatemachine_run();
+
+    // Not wired in setup_test: optional hook is skipped
+    EXPECT_EQ(_tx_run_count, 0);
+
+    _interface.tx_run = &_mock_tx_run;
+    TcpMainStatemachine_initialize(&_interface);
+    TcpMainStatemachine_link_up(0);
+    TcpMainStatemachine_run();
+
+    _tx_run_count = 0;
+    _tx_run_returns_busy = true;
+
+    EXPECT_TRUE(TcpMainStatemachine_run());
+    EXPECT_EQ(_tx_run_count, 1);
+
+    _tx_run_returns_busy = false;
+
+    EXPECT_FALSE(TcpMainStatemachine_run());
+
+}
+
 // =============================================================================
 // Link Down
 // =============================================================================
@@ -307,14 +360,14 @@ TEST(TCP_MainStatemachine, link_down_transitions_to_disconnected)
 
     setup_test();
 
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
     TcpMainStatemachine_run();
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_RUNNING);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_RUNNING);
 
     _status_changed_called = false;
-    TcpMainStatemachine_link_down();
+    TcpMainStatemachine_link_down(0);
 
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_DISCONNECTED);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_DISCONNECTED);
 
 }
 
@@ -323,11 +376,11 @@ TEST(TCP_MainStatemachine, link_down_notifies_status_changed_false)
 
     setup_test();
 
-    TcpMainStatemachine_link_up();
+    TcpMainStatemachine_link_up(0);
     TcpMainStatemachine_run();
     _status_changed_called = false;
 
-    TcpMainStatemachine_link_down();
+    TcpMainStatemachine_link_down(0);
 
     EXPECT_TRUE(_status_changed_called);
     EXPECT_FALSE(_status_is_up);
@@ -352,10 +405,10 @@ TEST(TCP_MainStatemachine, null_status_callback_no_crash)
 
     TcpMainStatemachine_initialize(&_interface);
 
-    TcpMainStatemachine_link_up();
-    TcpMainStatemachine_link_down();
+    TcpMainStatemachine_link_up(0);
+    TcpMainStatemachine_link_down(0);
 
-    EXPECT_EQ(TcpMainStatemachine_get_link_state(), TCP_LINK_STATE_DISCONNECTED);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_DISCONNECTED);
 
 }
 
@@ -368,6 +421,64 @@ TEST(TCP_MainStatemachine, get_statemachine_info_not_null)
 
     setup_test();
 
-    EXPECT_NE(TcpMainStatemachine_get_statemachine_info(), nullptr);
+    EXPECT_NE(TcpMainStatemachine_get_statemachine_info(0), nullptr);
+
+}
+
+// =============================================================================
+// Multiple connections
+// =============================================================================
+
+TEST(TCP_MainStatemachine, connections_have_independent_link_state)
+{
+
+    setup_test();
+
+    TcpMainStatemachine_link_up(0);
+    TcpMainStatemachine_run();
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_RUNNING);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(1), TCP_LINK_STATE_DISCONNECTED);
+
+    // Only the open connection is driven
+    _link_control_run_count = 0;
+    TcpMainStatemachine_run();
+    EXPECT_EQ(_link_control_run_count, 1);
+    EXPECT_EQ(_link_control_run_info, TcpMainStatemachine_get_statemachine_info(0));
+
+    TcpMainStatemachine_link_up(1);
+    EXPECT_EQ(_login_connection, 1);
+    EXPECT_EQ(_status_connection, 1);
+    EXPECT_TRUE(_status_is_up);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(1), TCP_LINK_STATE_LOGGING_IN);
+
+    _mock_login_state = TCP_LOGIN_SEND_VERIFY_GLOBAL;
+    _login_run_count = 0;
+    _link_control_run_count = 0;
+    TcpMainStatemachine_run();
+    EXPECT_EQ(_login_run_count, 1);
+    EXPECT_EQ(_link_control_run_count, 2);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(1), TCP_LINK_STATE_RUNNING);
+
+    // Dropping one leaves the other running
+    TcpMainStatemachine_link_down(0);
+    EXPECT_EQ(_status_connection, 0);
+    EXPECT_FALSE(_status_is_up);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(0), TCP_LINK_STATE_DISCONNECTED);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(1), TCP_LINK_STATE_RUNNING);
+
+}
+
+TEST(TCP_MainStatemachine, statemachine_info_carries_connection)
+{
+
+    setup_test();
+
+    EXPECT_EQ(TcpMainStatemachine_get_statemachine_info(0)->connection, 0);
+    EXPECT_EQ(TcpMainStatemachine_get_statemachine_info(1)->connection, 1);
+    EXPECT_EQ(TcpMainStatemachine_get_statemachine_info(USER_DEFINED_TCP_MAX_CONNECTIONS), nullptr);
+    EXPECT_EQ(TcpMainStatemachine_get_link_state(USER_DEFINED_TCP_MAX_CONNECTIONS), TCP_LINK_STATE_DISCONNECTED);
+
+    TcpMainStatemachine_link_up(USER_DEFINED_TCP_MAX_CONNECTIONS);
+    EXPECT_FALSE(_login_link_up_called);
 
 }
@@ -41,12 +41,308 @@
 // Module state
 // =========================================================================
 
+    /** @brief Largest link control body handed over when it wraps in the ring. */
+#define TCP_RX_LINK_CONTROL_LINEAR_LEN 32
+
+    /** @brief Largest body header: MTI + source Node ID + destination Node ID. */
+#define TCP_RX_BODY_HEADER_LEN (TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN + TCP_BODY_NODE_ID_LEN)
+
 static const interface_tcp_rx_statemachine_t *_interface;
 
-static tcp_rx_accumulation_buffer_t _rx_buffer;
-static uint16_t _rx_count;
+    /** @brief Ring and discard count of every connection. */
+static tcp_rx_connection_t _rx[USER_DEFINED_TCP_MAX_CONNECTIONS];
+
+    /** @brief Multi-part reassemblies of all connections and their payload arena. */
+static tcp_multipart_table_t _multipart;
+
+// =========================================================================
+// Ring helpers
+// =========================================================================
+
+    /** @brief Ring index of the byte offset bytes past the head (offset < buffer length). */
+static uint16_t _ring_index(tcp_rx_connection_t *rx, uint32_t offset) {
+
+    uint32_t index = (uint32_t) rx->head + offset;
+
+    if (index >= USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN)
+        index -= USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN;
+
+    return (uint16_t) index;
+}
+
+    /** @brief Copies len unparsed bytes starting at offset out of the ring, splitting at the wrap. */
+static void _ring_copy_out(tcp_rx_connection_t *rx, uint8_t *dest, uint32_t offset, uint16_t len) {
+
+    uint16_t index = _ring_index(rx, offset);
+    uint16_t first = USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN - index;
+
+    if (first > len)
+        first = len;
+
+    memcpy(dest, &rx->buffer[index], first);
+
+    if (len > first)
+        memcpy(&dest[first], rx->buffer, len - first);
+}
+
+    /** @brief Appends len bytes at the tail of the ring (caller checks free space). */
+static void _ring_copy_in(tcp_rx_connection_t *rx, const uint8_t *src, uint16_t len) {
+
+    uint16_t index = _ring_index(rx, rx->count);
+    uint16_t first = USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN - index;
+
+    if (first > len)
+        first = len;
+
+    memcpy(&rx->buffer[index], src, first);
+
+    if (len > first)
+        memcpy(rx->buffer, &src[first], len - first);
+
+    rx->count += len;
+}
+
+    /** @brief Releases len parsed bytes from the head; an empty ring restarts at index 0. */
+static void _ring_consume(tcp_rx_connection_t *rx, uint16_t len) {
+
+    rx->head = _ring_index(rx, len);
+    rx->count -= len;
+
+    if (rx->count == 0)
+        rx->head = 0;
+}
+
+// =========================================================================
+// Multi-part table
+// =========================================================================
+
+    /** @brief Hash bucket of a connection / originating Node ID pair. */
+static uint16_t _multipart_hash(uint8_t connection, node_id_t node_id) {
+
+    uint32_t hash = (uint32_t) node_id ^ (uint32_t) (node_id >> 24) ^ connection;
+
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+
+    return (uint16_t) (hash & (USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS - 1));
+}
+
+    /** @brief Empties the table: every entry and arena block on its free list. */
+static void _multipart_initialize(void) {
+
+    for (uint16_t i = 0; i < USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS; i++)
+        _multipart.bucket[i] = TCP_MULTIPART_INDEX_NONE;
+
+    for (uint16_t i = 0; i < USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES; i++)
+        _multipart.entry[i].hash_next = (uint16_t) (i + 1);
+
+    _multipart.entry[USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES - 1].hash_next = TCP_MULTIPART_INDEX_NONE;
+    _multipart.free_entry = 0;
+
+    for (uint16_t i = 0; i < USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS; i++)
+        _multipart.block_next[i] = (uint16_t) (i + 1);
+
+    _multipart.block_next[USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS - 1] = TCP_MULTIPART_INDEX_NONE;
+    _multipart.free_block = 0;
+
+    _multipart.oldest = TCP_MULTIPART_INDEX_NONE;
+    _multipart.newest = TCP_MULTIPART_INDEX_NONE;
+}
+
+    /** @brief Unlinks an in-use entry from the activity list. */
+static void _multipart_age_unlink(uint16_t index) {
+
+    tcp_multipart_entry_t *entry = &_multipart.entry[index];
+
+    if (entry->age_prev == TCP_MULTIPART_INDEX_NONE)
+        _multipart.oldest = entry->age_next;
+    else
+        _multipart.entry[entry->age_prev].age_next = entry->age_next;
+
+    if (entry->age_next == TCP_MULTIPART_INDEX_NONE)
+        _multipart.newest = entry->age_prev;
+    else
+        _multipart.entry[entry->age_next].age_prev = entry->age_prev;
+}
+
+    /** @brief Stamps an entry with the current tick and moves it to the newest end of the activity list. */
+static void _multipart_age_touch(uint16_t index, uint8_t current_tick) {
+
+    tcp_multipart_entry_t *entry = &_multipart.entry[index];
+
+    entry->last_tick = current_tick;
+    entry->age_prev = _multipart.newest;
+    entry->age_next = TCP_MULTIPART_INDEX_NONE;
+
+    if (_multipart.newest == TCP_MULTIPART_INDEX_NONE)
+        _multipart.oldest = index;
+    else
+        _multipart.entry[_multipart.newest].age_next = index;
+
+    _multipart.newest = index;
+}
+
+/**
+ * @brief Finds the in-progress reassembly of a connection / originating Node ID.
+ *
+ * @return Entry index, or TCP_MULTIPART_INDEX_NONE if there is none.
+ */
+static uint16_t _multipart_find(uint8_t connection, node_id_t node_id) {
+
+    uint16_t index = _multipart.bucket[_multipart_hash(connection, node_id)];
+
+    while (index != TCP_MULTIPART_INDEX_NONE) {
+
+        tcp_multipart_entry_t *entry = &_multipart.entry[index];
+
+        if (entry->originating_node_id == node_id && entry->connection == connection)
+            return index;
+
+        index = entry->hash_next;
+    }
+
+    return TCP_MULTIPART_INDEX_NONE;
+}
+
+/**
+ * @brief Takes a free entry for a new reassembly and indexes it.
+ *
+ * @details A FIRST that repeats an originating Node ID restarts its
+ * reassembly, so the caller frees any existing entry before this.
+ *
+ * @return Entry index, or TCP_MULTIPART_INDEX_NONE if the table is full.
+ */
+static uint16_t _multipart_allocate(uint8_t connection, node_id_t node_id, uint8_t current_tick) {
+
+    uint16_t index = _multipart.free_entry;
+
+    if (index == TCP_MULTIPART_INDEX_NONE)
+        return TCP_MULTIPART_INDEX_NONE;
+
+    tcp_multipart_entry_t *entry = &_multipart.entry[index];
+    uint16_t bucket = _multipart_hash(connection, node_id);
+
+    _multipart.free_entry = entry->hash_next;
+
+    entry->originating_node_id = node_id;
+    entry->connection = connection;
+    entry->payload_count = 0;
+    entry->first_block = TCP_MULTIPART_INDEX_NONE;
+    entry->last_block = TCP_MULTIPART_INDEX_NONE;
+    entry->hash_next = _multipart.bucket[bucket];
+    _multipart.bucket[bucket] = index;
+
+    _multipart_age_touch(index, current_tick);
+
+    return index;
+}
+
+    /** @brief Returns an entry and its arena blocks to the free lists. */
+static void _multipart_free(uint16_t index) {
+
+    tcp_multipart_entry_t *entry = &_multipart.entry[index];
+    uint16_t *link = &_multipart.bucket[_multipart_hash(entry->connection, entry->originating_node_id)];
+
+    while (*link != index)
+        link = &_multipart.entry[*link].hash_next;
+
+    *link = entry->hash_next;
+
+    _multipart_age_unlink(index);
+
+    if (entry->first_block != TCP_MULTIPART_INDEX_NONE) {
+
+        _multipart.block_next[entry->last_block] = _multipart.free_block;
+        _multipart.free_block = entry->first_block;
+    }
+
+    entry->hash_next = _multipart.free_entry;
+    _multipart.free_entry = index;
+}
+
+    /** @brief Drops every reassembly whose latest part is older than the timeout, oldest first. */
+static void _multipart_purge_expired(uint8_t current_tick) {
+
+    while (_multipart.oldest != TCP_MULTIPART_INDEX_NONE) {
+
+        uint8_t age = (uint8_t) (current_tick - _multipart.entry[_multipart.oldest].last_tick);
+
+        if (age < USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS)
+            return;
+
+        _multipart_free(_multipart.oldest);
+    }
+}
+
+/**
+ * @brief Appends len bytes at ring offset to an entry's arena chain.
+ *
+ * @details Bytes beyond LEN_MESSAGE_BYTES_SNIP are discarded, as for any
+ * assembled message.
+ *
+ * @return false if the arena ran out of blocks.
+ */
+static bool _multipart_append(tcp_rx_connection_t *rx, tcp_multipart_entry_t *entry, uint32_t offset, uint16_t len) {
+
+    uint16_t room = LEN_MESSAGE_BYTES_SNIP - entry->payload_count;
+
+    if (len > room)
+        len = room;
+
+    while (len > 0) {
+
+        uint16_t used = entry->payload_count % TCP_MULTIPART_ARENA_BLOCK_LEN;
+
+        if (used == 0) {
+
+            uint16_t block = _multipart.free_block;
+
+            if (block == TCP_MULTIPART_INDEX_NONE)
+                return false;
+
+            _multipart.free_block = _multipart.block_next[block];
+            _multipart.block_next[block] = TCP_MULTIPART_INDEX_NONE;
+
+            if (entry->last_block == TCP_MULTIPART_INDEX_NONE)
+                entry->first_block = block;
+            else
+                _multipart.block_next[entry->last_block] = block;
+
+            entry->last_block = block;
+        }
+
+        uint16_t chunk = TCP_MULTIPART_ARENA_BLOCK_LEN - used;
 
-static tcp_multipart_table_t _multipart_table;
+        if (chunk > len)
+            chunk = len;
+
+        _ring_copy_out(rx, &_multipart.block[entry->last_block][used], offset, chunk);
+
+        entry->payload_count += chunk;
+        offset += chunk;
+        len -= chunk;
+    }
+
+    return true;
+}
+
+    /** @brief Copies an entry's arena chain into dest. */
+static void _multipart_copy_out(const tcp_multipart_entry_t *entry, uint8_t *dest) {
+
+    uint16_t block = entry->first_block;
+    uint16_t remaining = entry->payload_count;
+
+    while (remaining > 0) {
+
+        uint16_t chunk = (remaining < TCP_MULTIPART_ARENA_BLOCK_LEN) ? remaining : TCP_MULTIPART_ARENA_BLOCK_LEN;
+
+        memcpy(dest, _multipart.block[block], chunk);
+
+        dest += chunk;
+        remaining -= chunk;
+        block = _multipart.block_next[block];
+    }
+}
 
 // =========================================================================
 // Internal helpers
@@ -67,70 +363,74 @@ static payload_type_enum _select_payload_type(uint16_t byte_count) {
 }
 
 /**
- * @brief Finds or allocates a multi-part slot for the given originating Node ID.
+ * @brief Decodes MTI, source and (if addressed) destination from the body
+ * header in the ring.
  *
- * @param node_id  Originating Node ID from the preamble.
- * @param is_first true if this is the first part (allocates a new slot).
+ * @param rx           Connection whose ring holds the message.
+ * @param body_offset  Ring offset of the message body.
+ * @param body_len     Length of the body in bytes.
+ * @param mti          Receives the MTI.
+ * @param source_id    Receives the source Node ID.
+ * @param dest_id      Receives the destination Node ID (0 if unaddressed or truncated).
  *
- * @return Pointer to the slot, or NULL if table is full / not found.
+ * @return Offset of the payload within the body.
  */
-static tcp_multipart_entry_t *_find_multipart_slot(node_id_t node_id, bool is_first) {
+static uint16_t _decode_body_header(tcp_rx_connection_t *rx, uint32_t body_offset, uint16_t body_len,
+                                    uint16_t *mti, node_id_t *source_id, node_id_t *dest_id) {
 
-    if (is_first) {
+    uint8_t header[TCP_RX_BODY_HEADER_LEN];
+    uint16_t header_len = (body_len < TCP_RX_BODY_HEADER_LEN) ? body_len : TCP_RX_BODY_HEADER_LEN;
 
-        for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES; i++) {
+    _ring_copy_out(rx, header, body_offset, header_len);
 
-            if (_multipart_table[i].originating_node_id == 0) {
-                _multipart_table[i].originating_node_id = node_id;
-                return &_multipart_table[i];
-            }
-        }
-        return NULL;
-    }
+    *mti = TcpUtilities_decode_mti(header);
+    *source_id = TcpUtilities_decode_node_id(&header[TCP_BODY_OFFSET_SOURCE_NODE_ID]);
+    *dest_id = 0;
 
-    for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES; i++) {
+    if ((*mti & MASK_DEST_ADDRESS_PRESENT) == MASK_DEST_ADDRESS_PRESENT &&
+            header_len == TCP_RX_BODY_HEADER_LEN) {
 
-        if (_multipart_table[i].originating_node_id == node_id)
-            return &_multipart_table[i];
+        *dest_id = TcpUtilities_decode_node_id(&header[TCP_BODY_OFFSET_DEST_NODE_ID]);
+        return TCP_RX_BODY_HEADER_LEN;
     }
-    return NULL;
-}
-
-/**
- * @brief Frees a multi-part slot.
- */
-static void _free_multipart_slot(tcp_multipart_entry_t *slot) {
 
-    slot->originating_node_id = 0;
-    slot->openlcb_msg = NULL;
+    return TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN;
 }
 
 /**
  * @brief Parses a complete message body into an openlcb_msg_t and pushes to FIFO.
  *
- * @param body      Pointer to the message body (after preamble).
- * @param body_len  Length of the body in bytes.
+ * @param connection   Connection index the message arrived on.
+ * @param body_offset  Ring offset of the message body (after preamble).
+ * @param body_len     Length of the body in bytes.
+ *
+ * @return false if no buffer was available (leave the message in the ring),
+ *         true if it was delivered or dropped as malformed.
  */
-static void _forward_complete_message(const uint8_t *body, uint16_t body_len) {
+static bool _forward_complete_message(uint8_t connection, uint32_t body_offset, uint16_t body_len) {
 
-    if (body_len < TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN)
-        return;
+    tcp_rx_connection_t *rx = &_rx[connection];
 
-    uint16_t mti = TcpUtilities_decode_mti(body);
-    node_id_t source_id = TcpUtilities_decode_node_id(&body[TCP_BODY_OFFSET_SOURCE_NODE_ID]);
+    if (body_len < TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN)
+        return true;
 
-    node_id_t dest_id = 0;
-    uint16_t data_offset = TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN;
+    uint16_t mti;
+    node_id_t source_id;
+    node_id_t dest_id;
 
-    if ((mti & MASK_DEST_ADDRESS_PRESENT) == MASK_DEST_ADDRESS_PRESENT) {
+    uint16_t data_offset = _decode_body_header(rx, body_offset, body_len, &mti, &source_id, &dest_id);
 
-        if (body_len < TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN + TCP_BODY_NODE_ID_LEN)
-            return;
+    if (_interface->learn_route) {
 
-        dest_id = TcpUtilities_decode_node_id(&body[TCP_BODY_OFFSET_DEST_NODE_ID]);
-        data_offset = TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN + TCP_BODY_NODE_ID_LEN;
+        _interface->lock_shared_resources();
+        _interface->learn_route(connection, source_id);
+        _interface->unlock_shared_resources();
     }
 
+    if ((mti & MASK_DEST_ADDRESS_PRESENT) == MASK_DEST_ADDRESS_PRESENT &&
+            body_len < TCP_RX_BODY_HEADER_LEN)
+        return true;
+
     uint16_t payload_len = (body_len > data_offset) ? (body_len - data_offset) : 0;
 
     payload_type_enum ptype = _select_payload_type(payload_len);
@@ -140,7 +440,7 @@ static void _forward_complete_message(const uint8_t *body, uint16_t body_len) {
     _interface->unlock_shared_resources();
 
     if (!msg)
-        return;
+        return false;
 
     msg->mti = mti;
     msg->source_id = source_id;
@@ -163,130 +463,220 @@ static void _forward_complete_message(const uint8_t *body, uint16_t body_len) {
         if (payload_len > max_payload)
             payload_len = max_payload;
 
-        memcpy(msg->payload, &body[data_offset], payload_len);
+        _ring_copy_out(rx, (uint8_t *) msg->payload, body_offset + data_offset, payload_len);
         msg->payload_count = payload_len;
     }
 
     _interface->lock_shared_resources();
     _interface->push_to_fifo(msg);
     _interface->unlock_shared_resources();
+
+    return true;
 }
 
 /**
- * @brief Processes one complete TCP message (preamble + body) from the
- * accumulation buffer.
- *
- * @param preamble_start  Pointer to the start of the preamble in _rx_buffer.
- * @param total_len       Total bytes consumed (5 + length field value).
+ * @brief Hands a link control body to the link control handler, straight
+ * from the ring unless it wraps.
  */
-static void _process_message(const uint8_t *preamble_start, uint32_t total_len) {
-
-    uint16_t flags = TcpUtilities_decode_flags(preamble_start);
-    uint32_t length = TcpUtilities_decode_length(preamble_start);
+static void _forward_link_control(uint8_t connection, uint16_t flags, uint16_t body_len) {
 
-    if (!TcpUtilities_is_openlcb_message(flags)) {
+    tcp_rx_connection_t *rx = &_rx[connection];
+    uint16_t index = _ring_index(rx, TCP_PREAMBLE_LEN);
 
-        uint16_t body_len = (length > 12) ? (uint16_t) (length - 12) : 0;
+    if ((uint32_t) index + body_len <= USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN) {
 
-        _interface->handle_link_control(
-                flags,
-                &preamble_start[TCP_PREAMBLE_LEN],
-                body_len);
+        _interface->handle_link_control(connection, flags, &rx->buffer[index], body_len);
         return;
     }
 
-    const uint8_t *body = &preamble_start[TCP_PREAMBLE_LEN];
-    uint16_t body_len = (length > 12) ? (uint16_t) (length - 12) : 0;
+    uint8_t linear[TCP_RX_LINK_CONTROL_LINEAR_LEN];
 
-    uint16_t multipart = TcpUtilities_multipart_type(flags);
+    if (body_len > TCP_RX_LINK_CONTROL_LINEAR_LEN)
+        body_len = TCP_RX_LINK_CONTROL_LINEAR_LEN;
 
-    if (multipart == TCP_FLAGS_MULTIPART_SINGLE) {
+    _ring_copy_out(rx, linear, TCP_PREAMBLE_LEN, body_len);
+    _interface->handle_link_control(connection, flags, linear, body_len);
+}
 
-        _forward_complete_message(body, body_len);
+/**
+ * @brief Handles one part of a multi-part message.
+ *
+ * @details Algorithm:
+ * -# Drop reassemblies that have waited longer than the timeout
+ * -# FIRST: restart any reassembly with the same key, take a table entry,
+ *    keep the header and append the payload to the arena
+ * -# MIDDLE: append the body to the matching reassembly
+ * -# LAST: allocate a buffer sized to the assembled payload, copy the arena
+ *    chain and the final body into it and push it; the entry is freed
+ * -# A part with no matching reassembly, or that overflows the arena, is
+ *    dropped along with its reassembly
+ *
+ * @param connection  Connection index the part arrived on.
+ * @param multipart   TCP_FLAGS_MULTIPART_FIRST, _MIDDLE or _LAST.
+ * @param orig_id     Originating Node ID from the preamble.
+ * @param body_len    Length of the body in bytes.
+ *
+ * @return false if the LAST part could not get a buffer (leave it in the ring).
+ *
+ * @warning Caller holds the shared resource lock.
+ */
+static bool _process_multipart(uint8_t connection, uint16_t multipart, node_id_t orig_id, uint16_t body_len) {
 
-    } else {
+    tcp_rx_connection_t *rx = &_rx[connection];
+    uint8_t current_tick = _interface->get_current_tick();
 
-        node_id_t orig_id = TcpUtilities_decode_originating_node_id(preamble_start);
+    _multipart_purge_expired(current_tick);
 
-        if (multipart == TCP_FLAGS_MULTIPART_FIRST) {
+    uint16_t index = _multipart_find(connection, orig_id);
 
-            tcp_multipart_entry_t *slot = _find_multipart_slot(orig_id, true);
+    if (multipart == TCP_FLAGS_MULTIPART_FIRST) {
 
-            if (!slot)
-                return;
+        if (body_len < TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN)
+            return true;
 
-            if (body_len < TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN)
-                return;
+        if (index != TCP_MULTIPART_INDEX_NONE)
+            _multipart_free(index);
 
-            uint16_t mti = TcpUtilities_decode_mti(body);
-            node_id_t source_id = TcpUtilities_decode_node_id(&body[TCP_BODY_OFFSET_SOURCE_NODE_ID]);
+        index = _multipart_allocate(connection, orig_id, current_tick);
 
-            node_id_t dest_id = 0;
-            uint16_t data_offset = TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN;
+        if (index == TCP_MULTIPART_INDEX_NONE)
+            return true;
 
-            if ((mti & MASK_DEST_ADDRESS_PRESENT) == MASK_DEST_ADDRESS_PRESENT) {
-                if (body_len >= TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN + TCP_BODY_NODE_ID_LEN) {
-                    dest_id = TcpUtilities_decode_node_id(&body[TCP_BODY_OFFSET_DEST_NODE_ID]);
-                    data_offset = TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN + TCP_BODY_NODE_ID_LEN;
-                }
-            }
+        tcp_multipart_entry_t *entry = &_multipart.entry[index];
+        uint16_t data_offset = _decode_body_header(rx, TCP_PREAMBLE_LEN, body_len,
+                &entry->mti, &entry->source_id, &entry->dest_id);
+        uint16_t payload_len = (body_len > data_offset) ? (body_len - data_offset) : 0;
 
-            uint16_t payload_len = (body_len > data_offset) ? (body_len - data_offset) : 0;
+        if (_interface->learn_route) {
 
             _interface->lock_shared_resources();
-            slot->openlcb_msg = _interface->allocate_buffer(SNIP);
+            _interface->learn_route(connection, entry->source_id);
             _interface->unlock_shared_resources();
+        }
 
-            if (!slot->openlcb_msg) {
-                _free_multipart_slot(slot);
-                return;
-            }
+        if (!_multipart_append(rx, entry, TCP_PREAMBLE_LEN + data_offset, payload_len))
+            _multipart_free(index);
 
-            slot->openlcb_msg->mti = mti;
-            slot->openlcb_msg->source_id = source_id;
-            slot->openlcb_msg->dest_id = dest_id;
-            slot->openlcb_msg->source_alias = 0;
-            slot->openlcb_msg->dest_alias = 0;
-            slot->openlcb_msg->payload_count = 0;
+        return true;
+    }
 
-            if (payload_len > 0 && slot->openlcb_msg->payload) {
-                uint16_t max_p = LEN_MESSAGE_BYTES_SNIP;
-                if (payload_len > max_p) payload_len = max_p;
-                memcpy(slot->openlcb_msg->payload, &body[data_offset], payload_len);
-                slot->openlcb_msg->payload_count = payload_len;
-            }
+    if (index == TCP_MULTIPART_INDEX_NONE)
+        return true;
 
-        } else if (multipart == TCP_FLAGS_MULTIPART_MIDDLE ||
-                   multipart == TCP_FLAGS_MULTIPART_LAST) {
+    tcp_multipart_entry_t *entry = &_multipart.entry[index];
 
-            tcp_multipart_entry_t *slot = _find_multipart_slot(orig_id, false);
+    if (multipart == TCP_FLAGS_MULTIPART_MIDDLE) {
 
-            if (!slot || !slot->openlcb_msg)
-                return;
+        _multipart_age_unlink(index);
+        _multipart_age_touch(index, current_tick);
 
-            if (body_len > 0 && slot->openlcb_msg->payload) {
+        if (!_multipart_append(rx, entry, TCP_PREAMBLE_LEN, body_len))
+            _multipart_free(index);
 
-                uint16_t max_p = LEN_MESSAGE_BYTES_SNIP;
-                uint16_t remaining = (max_p > slot->openlcb_msg->payload_count) ?
-                    (max_p - slot->openlcb_msg->payload_count) : 0;
-                uint16_t copy_len = (body_len < remaining) ? body_len : remaining;
+        return true;
+    }
 
-                if (copy_len > 0) {
-                    memcpy(&((uint8_t *) slot->openlcb_msg->payload)[slot->openlcb_msg->payload_count],
-                           body, copy_len);
-                    slot->openlcb_msg->payload_count += copy_len;
-                }
-            }
+    uint16_t room = LEN_MESSAGE_BYTES_SNIP - entry->payload_count;
+    uint16_t last_len = (body_len < room) ? body_len : room;
 
-            if (multipart == TCP_FLAGS_MULTIPART_LAST) {
+    openlcb_msg_t *msg = _interface->allocate_buffer(_select_payload_type(entry->payload_count + last_len));
 
-                _interface->lock_shared_resources();
-                _interface->push_to_fifo(slot->openlcb_msg);
-                _interface->unlock_shared_resources();
+    if (!msg)
+        return false;
 
-                _free_multipart_slot(slot);
-            }
+    msg->mti = entry->mti;
+    msg->source_id = entry->source_id;
+    msg->dest_id = entry->dest_id;
+    msg->source_alias = 0;
+    msg->dest_alias = 0;
+    msg->payload_count = 0;
+
+    if (msg->payload) {
+
+        _multipart_copy_out(entry, (uint8_t *) msg->payload);
+
+        if (last_len > 0)
+            _ring_copy_out(rx, &((uint8_t *) msg->payload)[entry->payload_count], TCP_PREAMBLE_LEN, last_len);
+
+        msg->payload_count = entry->payload_count + last_len;
+    }
+
+    _interface->push_to_fifo(msg);
+    _multipart_free(index);
+
+    return true;
+}
+
+/**
+ * @brief Processes the complete TCP message (preamble + body) at the head
+ * of the ring.
+ *
+ * @param connection  Connection index the message arrived on.
+ * @param preamble  Copy of the message's 17-byte preamble.
+ *
+ * @return false if the message must stay in the ring until a buffer frees up.
+ */
+static bool _process_message(uint8_t connection, const uint8_t *preamble) {
+
+    uint16_t flags = TcpUtilities_decode_flags(preamble);
+    uint32_t length = TcpUtilities_decode_length(preamble);
+    uint16_t body_len = (length > 12) ? (uint16_t) (length - 12) : 0;
+
+    if (!TcpUtilities_is_openlcb_message(flags)) {
+
+        _forward_link_control(connection, flags, body_len);
+        return true;
+    }
+
+    uint16_t multipart = TcpUtilities_multipart_type(flags);
+
+    if (multipart == TCP_FLAGS_MULTIPART_SINGLE)
+        return _forward_complete_message(connection, TCP_PREAMBLE_LEN, body_len);
+
+    node_id_t orig_id = TcpUtilities_decode_originating_node_id(preamble);
+
+    _interface->lock_shared_resources();
+    bool result = _process_multipart(connection, multipart, orig_id, body_len);
+    _interface->unlock_shared_resources();
+
+    return result;
+}
+
+/**
+ * @brief Parses every complete message at the head of the ring.
+ *
+ * @details Algorithm:
+ * -# Copy the 17-byte preamble out of the ring (it may wrap) and decode the length
+ * -# A message longer than the ring can never complete: drop what is
+ *    buffered and skip the rest of it as it arrives
+ * -# Stop at the first incomplete message, or at one that cannot get a buffer
+ * -# Otherwise process it in place and release its bytes
+ */
+static void _parse_messages(uint8_t connection) {
+
+    tcp_rx_connection_t *rx = &_rx[connection];
+    uint8_t preamble[TCP_PREAMBLE_LEN];
+
+    while (rx->discard == 0 && rx->count >= TCP_PREAMBLE_LEN) {
+
+        _ring_copy_out(rx, preamble, 0, TCP_PREAMBLE_LEN);
+
+        uint32_t total_msg_len = 5 + TcpUtilities_decode_length(preamble);
+
+        if (total_msg_len > USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN) {
+
+            rx->discard = total_msg_len - rx->count;
+            _ring_consume(rx, rx->count);
+            return;
         }
+
+        if (rx->count < total_msg_len)
+            return;
+
+        if (!_process_message(connection, preamble))
+            return;
+
+        _ring_consume(rx, (uint16_t) total_msg_len);
     }
 }
 
@@ -297,57 +687,84 @@ static void _process_message(const uint8_t *preamble_start, uint32_t total_len)
 void TcpRxStatemachine_initialize(const interface_tcp_rx_statemachine_t *interface) {
 
     _interface = interface;
-    _rx_count = 0;
-    memset(_multipart_table, 0, sizeof(_multipart_table));
+    memset(_rx, 0, sizeof(_rx));
+    _multipart_initialize();
 }
 
-void TcpRxStatemachine_incoming_data(uint8_t *data, uint16_t len) {
+uint16_t TcpRxStatemachine_incoming_data(uint8_t connection, uint8_t *data, uint16_t len) {
 
-    if (_interface->on_rx)
-        _interface->on_rx(data, len);
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return 0;
 
-    for (uint16_t i = 0; i < len; i++) {
+    tcp_rx_connection_t *rx = &_rx[connection];
+    uint16_t consumed = 0;
 
-        if (_rx_count >= USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN) {
-            _rx_count = 0;
-            break;
-        }
+    for (;;) {
 
-        _rx_buffer[_rx_count++] = data[i];
-    }
+        _parse_messages(connection);
 
-    while (_rx_count >= TCP_PREAMBLE_LEN) {
+        if (rx->discard > 0) {
 
-        uint32_t length = TcpUtilities_decode_length(_rx_buffer);
-        uint32_t total_msg_len = 5 + length;
+            uint16_t skip = len - consumed;
 
-        if (_rx_count < total_msg_len)
-            return;
+            if (skip > rx->discard)
+                skip = (uint16_t) rx->discard;
+
+            rx->discard -= skip;
+            consumed += skip;
+
+            if (rx->discard > 0)
+                break;
+
+            continue;
+        }
+
+        if (consumed == len)
+            break;
 
-        _process_message(_rx_buffer, total_msg_len);
+        uint16_t space = USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN - rx->count;
+        uint16_t chunk = len - consumed;
 
-        uint32_t remaining = _rx_count - total_msg_len;
+        if (space == 0)
+            break;
 
-        if (remaining > 0)
-            memmove(_rx_buffer, &_rx_buffer[total_msg_len], remaining);
+        if (chunk > space)
+            chunk = space;
 
-        _rx_count = (uint16_t) remaining;
+        _ring_copy_in(rx, &data[consumed], chunk);
+        consumed += chunk;
     }
+
+    if (_interface->on_rx && consumed > 0)
+        _interface->on_rx(data, consumed);
+
+    return consumed;
 }
 
-void TcpRxStatemachine_reset(void) {
+void TcpRxStatemachine_reset(uint8_t connection) {
 
-    _rx_count = 0;
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return;
 
-    for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES; i++) {
+    tcp_rx_connection_t *rx = &_rx[connection];
 
-        if (_multipart_table[i].openlcb_msg) {
+    rx->head = 0;
+    rx->count = 0;
+    rx->discard = 0;
 
-            _interface->lock_shared_resources();
-            _interface->free_buffer(_multipart_table[i].openlcb_msg);
-            _interface->unlock_shared_resources();
-        }
+    _interface->lock_shared_resources();
+
+    uint16_t index = _multipart.oldest;
+
+    while (index != TCP_MULTIPART_INDEX_NONE) {
+
+        uint16_t next = _multipart.entry[index].age_next;
 
-        _free_multipart_slot(&_multipart_table[i]);
+        if (_multipart.entry[index].connection == connection)
+            _multipart_free(index);
+
+        index = next;
     }
+
+    _interface->unlock_shared_resources();
 }
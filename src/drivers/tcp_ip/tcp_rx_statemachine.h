@@ -27,11 +27,14 @@
  * @file tcp_rx_statemachine.h
  * @brief Receive state machine for the TCP/IP transport layer.
  *
- * @details Accumulates incoming TCP bytes, parses the 17-byte preamble,
+ * @details Accumulates incoming TCP bytes in a ring, parses the 17-byte preamble,
  * reassembles multi-part messages, and pushes complete @ref openlcb_msg_t
  * messages to the OpenLCB buffer FIFO.  Link control messages are routed
  * to the link control handler.
  *
+ * Every connection (0 to USER_DEFINED_TCP_MAX_CONNECTIONS - 1) has its own
+ * ring and multi-part table, so interleaved streams never mix.
+ *
  * @author Jim Kueneman
  * @date 4 Apr 2026
  */
@@ -67,7 +70,12 @@ typedef struct {
 
     /** @brief REQUIRED. Handle an incoming link control message.
      *  Typical: TcpLinkControl_handle. */
-    void (*handle_link_control)(uint16_t flags, const uint8_t *data, uint16_t len);
+    void (*handle_link_control)(uint8_t connection, uint16_t flags, const uint8_t *data, uint16_t len);
+
+    /** @brief OPTIONAL. Remember the connection a remote source Node ID was heard on.
+     *  Called with shared resources locked, since the route table is also
+     *  read by the TX path.  Typical: TcpTxStatemachine_learn_route. May be NULL. */
+    void (*learn_route)(uint8_t connection, node_id_t node_id);
 
     /** @brief REQUIRED. Disable interrupts / acquire mutex. */
     void (*lock_shared_resources)(void);
@@ -75,7 +83,11 @@ typedef struct {
     /** @brief REQUIRED. Re-enable interrupts / release mutex. */
     void (*unlock_shared_resources)(void);
 
-    /** @brief OPTIONAL. Called when raw bytes arrive, before processing. May be NULL. */
+    /** @brief REQUIRED. Return the current 100ms tick counter, used to time out
+     *  multi-part reassemblies.  Typical: OpenLcbConfig_get_global_100ms_tick. */
+    uint8_t (*get_current_tick)(void);
+
+    /** @brief OPTIONAL. Called with the bytes each incoming_data call consumed. May be NULL. */
     void (*on_rx)(uint8_t *data, uint16_t len);
 
 } interface_tcp_rx_statemachine_t;
@@ -98,26 +110,46 @@ extern "C" {
      * @brief Feeds incoming TCP data into the receive state machine.
      *
      * @details Called from the user's socket receive callback or thread.
-     * Accumulates bytes, parses preambles, and pushes complete OpenLCB
-     * messages to the FIFO.  May be called with any number of bytes
-     * (partial messages are buffered internally).
+     * Bytes are appended to a ring buffer and every complete message is
+     * parsed where it lies, so a segment full of small messages costs no
+     * copying beyond the one append.  Partial messages stay buffered.
+     *
+     * When the OpenLCB buffer store is exhausted the message at the head of
+     * the ring is kept, not dropped, and once the ring is full the call
+     * returns early.  The caller keeps the unconsumed tail (or leaves it in
+     * the socket, e.g. lwIP tcp_recved() with the return value) and offers it
+     * again later; a call with len 0 just retries the parse.  A message longer
+     * than USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN can never be held and is
+     * skipped.
      *
-     * @param data  Pointer to received bytes.
-     * @param len   Number of bytes received.
+     * Multi-part messages are reassembled in a table shared by all
+     * connections, indexed by connection and originating Node ID, with the
+     * payload held in a shared block arena until the last part arrives.  A
+     * reassembly that hears no part for USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS
+     * is dropped.
+     *
+     * @param connection  Connection the bytes arrived on.
+     * @param data        Pointer to received bytes.
+     * @param len         Number of bytes received.
+     *
+     * @return Number of bytes consumed from data (== len unless backpressured,
+     *         0 for an out-of-range connection).
      *
      * @warning May be called from an interrupt context or a dedicated receive
      *          thread.  Uses lock_shared_resources/unlock_shared_resources
-     *          around buffer allocation and FIFO push.
+     *          around buffer allocation, FIFO push and multi-part table access.
      */
-    extern void TcpRxStatemachine_incoming_data(uint8_t *data, uint16_t len);
+    extern uint16_t TcpRxStatemachine_incoming_data(uint8_t connection, uint8_t *data, uint16_t len);
 
     /**
-     * @brief Resets the receive state machine, clearing the accumulation
+     * @brief Resets one connection's receive state, clearing its accumulation
      * buffer and freeing any in-progress multi-part assemblies.
      *
-     * @warning NOT thread-safe — call only when no data is arriving.
+     * @param connection  Connection to reset.
+     *
+     * @warning NOT thread-safe — call only when no data is arriving on it.
      */
-    extern void TcpRxStatemachine_reset(void);
+    extern void TcpRxStatemachine_reset(uint8_t connection);
 
 #ifdef __cplusplus
 }
@@ -17,8 +17,13 @@
  *   - Two messages back-to-back in one buffer
  *   - Link control message routing
  *   - Multi-part message reassembly (first + last)
- *   - Buffer overflow reset
+ *   - Oversized message skipped without losing the following message
+ *   - Ring wrap-around of preamble, body and link control
+ *   - Many small messages in one segment
+ *   - Backpressure: held message and partial consume when buffers run out
  *   - on_rx callback invocation
+ *   - Connections: separate rings and multi-part tables, link control and
+ *     route learning tagged with the connection, per-connection reset
  *
  * Author: Test Suite
  * Date: 2026-04-05
@@ -44,11 +49,21 @@ static uint16_t _link_control_flags = 0;
 static uint8_t _link_control_data[64];
 static uint16_t _link_control_len = 0;
 static bool _link_control_called = false;
+static uint8_t _link_control_connection = 0xFF;
+
+static int _learn_route_count = 0;
+static uint8_t _learn_route_connection = 0xFF;
+static node_id_t _learn_route_node_id = 0;
+static bool _learn_route_locked = false;
+static int _lock_depth = 0;
 
 static bool _on_rx_called = false;
 static uint16_t _on_rx_len = 0;
 
 static bool _mock_allocate_returns_null = false;
+static bool _mock_free_on_push = false;
+
+static uint8_t _mock_tick = 0;
 
 // =============================================================================
 // Mock functions
@@ -70,20 +85,38 @@ static openlcb_msg_t *_mock_push_to_fifo(openlcb_msg_t *msg)
 {
     _last_pushed_msg = msg;
     _push_count++;
+    if (_mock_free_on_push) {
+        OpenLcbBufferStore_free_buffer(msg);
+        _last_pushed_msg = NULL;
+    }
     return msg;
 }
 
-static void _mock_handle_link_control(uint16_t flags, const uint8_t *data, uint16_t len)
+static void _mock_handle_link_control(uint8_t connection, uint16_t flags, const uint8_t *data, uint16_t len)
 {
     _link_control_called = true;
+    _link_control_connection = connection;
     _link_control_flags = flags;
     _link_control_len = len;
     if (len > 0 && len <= sizeof(_link_control_data))
         memcpy(_link_control_data, data, len);
 }
 
-static void _mock_lock(void) {}
-static void _mock_unlock(void) {}
+static void _mock_learn_route(uint8_t connection, node_id_t node_id)
+{
+    _learn_route_count++;
+    _learn_route_connection = connection;
+    _learn_route_node_id = node_id;
+    _learn_route_locked = (_lock_depth > 0);
+}
+
+static void _mock_lock(void) { _lock_depth++; }
+static void _mock_unlock(void) { _lock_depth--; }
+
+static uint8_t _mock_get_current_tick(void)
+{
+    return _mock_tick;
+}
 
 static void _mock_on_rx(uint8_t *data, uint16_t len)
 {
@@ -100,8 +133,10 @@ static const interface_tcp_rx_statemachine_t _interface = {
     .free_buffer           = &_mock_free_buffer,
     .push_to_fifo          = &_mock_push_to_fifo,
     .handle_link_control   = &_mock_handle_link_control,
+    .learn_route           = &_mock_learn_route,
     .lock_shared_resources = &_mock_lock,
     .unlock_shared_resources = &_mock_unlock,
+    .get_current_tick      = &_mock_get_current_tick,
     .on_rx                 = &_mock_on_rx,
 };
 
@@ -112,9 +147,17 @@ static void reset_mocks(void)
     _link_control_called = false;
     _link_control_flags = 0;
     _link_control_len = 0;
+    _link_control_connection = 0xFF;
+    _learn_route_count = 0;
+    _learn_route_connection = 0xFF;
+    _learn_route_node_id = 0;
+    _learn_route_locked = false;
+    _lock_depth = 0;
     _on_rx_called = false;
     _on_rx_len = 0;
     _mock_allocate_returns_null = false;
+    _mock_free_on_push = false;
+    _mock_tick = 0;
     memset(_link_control_data, 0, sizeof(_link_control_data));
 }
 
@@ -214,7 +257,7 @@ TEST(TCP_RxStatemachine, receive_unaddressed_message)
     uint8_t wire[64];
     uint16_t wire_len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
 
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    TcpRxStatemachine_incoming_data(0, wire, wire_len);
 
     EXPECT_EQ(_push_count, 1);
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -238,7 +281,7 @@ TEST(TCP_RxStatemachine, receive_addressed_message)
     uint16_t wire_len = build_addressed_msg(
             wire, 0x0828, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, NULL, 0);
 
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    TcpRxStatemachine_incoming_data(0, wire, wire_len);
 
     EXPECT_EQ(_push_count, 1);
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -263,7 +306,7 @@ TEST(TCP_RxStatemachine, receive_message_with_payload)
             wire, 0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL,
             payload, 4);
 
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    TcpRxStatemachine_incoming_data(0, wire, wire_len);
 
     EXPECT_EQ(_push_count, 1);
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -285,11 +328,11 @@ TEST(TCP_RxStatemachine, partial_delivery)
     uint16_t wire_len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
 
     // Feed first 10 bytes — not enough for a complete message
-    TcpRxStatemachine_incoming_data(wire, 10);
+    TcpRxStatemachine_incoming_data(0, wire, 10);
     EXPECT_EQ(_push_count, 0);
 
     // Feed remaining bytes
-    TcpRxStatemachine_incoming_data(&wire[10], wire_len - 10);
+    TcpRxStatemachine_incoming_data(0, &wire[10], wire_len - 10);
     EXPECT_EQ(_push_count, 1);
     ASSERT_NE(_last_pushed_msg, nullptr);
     EXPECT_EQ(_last_pushed_msg->mti, 0x0490);
@@ -309,7 +352,7 @@ TEST(TCP_RxStatemachine, two_messages_in_one_buffer)
     uint16_t offset = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
     offset += build_unaddressed_msg(&wire[offset], 0x0100, 0xAABBCCDDEEFFULL);
 
-    TcpRxStatemachine_incoming_data(wire, offset);
+    TcpRxStatemachine_incoming_data(0, wire, offset);
 
     EXPECT_EQ(_push_count, 2);
 
@@ -337,7 +380,7 @@ TEST(TCP_RxStatemachine, link_control_routed_to_handler)
     TcpUtilities_encode_uint16(&wire[offset], TCP_LINK_CONTROL_STATUS_REQUEST);
     offset += 2;
 
-    TcpRxStatemachine_incoming_data(wire, offset);
+    TcpRxStatemachine_incoming_data(0, wire, offset);
 
     EXPECT_TRUE(_link_control_called);
     EXPECT_EQ(_link_control_len, 2);
@@ -355,7 +398,7 @@ TEST(TCP_RxStatemachine, on_rx_callback_invoked)
     uint8_t wire[64];
     uint16_t wire_len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
 
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    TcpRxStatemachine_incoming_data(0, wire, wire_len);
 
     EXPECT_TRUE(_on_rx_called);
     EXPECT_EQ(_on_rx_len, wire_len);
@@ -376,14 +419,14 @@ TEST(TCP_RxStatemachine, reset_clears_accumulation)
     uint16_t wire_len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
 
     // Feed partial data
-    TcpRxStatemachine_incoming_data(wire, 10);
+    TcpRxStatemachine_incoming_data(0, wire, 10);
     EXPECT_EQ(_push_count, 0);
 
     // Reset
-    TcpRxStatemachine_reset();
+    TcpRxStatemachine_reset(0);
 
     // Feed complete message fresh
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    TcpRxStatemachine_incoming_data(0, wire, wire_len);
     EXPECT_EQ(_push_count, 1);
 
     if (_last_pushed_msg)
@@ -418,8 +461,11 @@ TEST(TCP_RxStatemachine, multipart_first_and_last)
     memcpy(&first_wire[offset], first_payload, 4);
     offset += 4;
 
-    TcpRxStatemachine_incoming_data(first_wire, offset);
+    TcpRxStatemachine_incoming_data(0, first_wire, offset);
     EXPECT_EQ(_push_count, 0);  // Not yet complete
+    EXPECT_EQ(_learn_route_node_id, source_id);
+    EXPECT_TRUE(_learn_route_locked);
+    EXPECT_EQ(_lock_depth, 0);
 
     // --- Build LAST part ---
     uint8_t last_wire[64];
@@ -432,7 +478,7 @@ TEST(TCP_RxStatemachine, multipart_first_and_last)
     memcpy(&last_wire[offset2], last_payload, 4);
     offset2 += 4;
 
-    TcpRxStatemachine_incoming_data(last_wire, offset2);
+    TcpRxStatemachine_incoming_data(0, last_wire, offset2);
     EXPECT_EQ(_push_count, 1);
 
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -466,7 +512,7 @@ TEST(TCP_RxStatemachine, body_too_short_dropped)
     wire[offset++] = 0x00;
     wire[offset++] = 0x00;
 
-    TcpRxStatemachine_incoming_data(wire, offset);
+    TcpRxStatemachine_incoming_data(0, wire, offset);
 
     EXPECT_EQ(_push_count, 0);  // Dropped, not pushed
 }
@@ -487,7 +533,7 @@ TEST(TCP_RxStatemachine, receive_datagram_size_payload)
             wire, 0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL,
             payload, 20);
 
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    TcpRxStatemachine_incoming_data(0, wire, wire_len);
 
     EXPECT_EQ(_push_count, 1);
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -513,7 +559,7 @@ TEST(TCP_RxStatemachine, receive_snip_size_payload)
             wire, 0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL,
             payload, 100);
 
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    TcpRxStatemachine_incoming_data(0, wire, wire_len);
 
     EXPECT_EQ(_push_count, 1);
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -540,7 +586,7 @@ TEST(TCP_RxStatemachine, receive_stream_size_payload_truncated)
             wire, 0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL,
             payload, 260);
 
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    TcpRxStatemachine_incoming_data(0, wire, wire_len);
 
     EXPECT_EQ(_push_count, 1);
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -551,7 +597,7 @@ TEST(TCP_RxStatemachine, receive_stream_size_payload_truncated)
 }
 
 // =============================================================================
-// Multipart FIRST — table full, third FIRST dropped
+// Multipart FIRST — table full, one more FIRST dropped
 // =============================================================================
 
 TEST(TCP_RxStatemachine, multipart_first_table_full_dropped)
@@ -565,33 +611,34 @@ TEST(TCP_RxStatemachine, multipart_first_table_full_dropped)
     uint8_t wire[128];
     uint16_t len;
 
-    // Fill slot 0
-    len = build_multipart_first_msg(wire, 0xAAAAAAAAAAAAULL,
-            0x1C48, source, dest, pay, 2);
-    TcpRxStatemachine_incoming_data(wire, len);
-    EXPECT_EQ(_push_count, 0);
+    // Fill every entry
+    for (int i = 0; i < USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES; i++) {
 
-    // Fill slot 1
-    len = build_multipart_first_msg(wire, 0xBBBBBBBBBBBBULL,
-            0x1C48, source, dest, pay, 2);
-    TcpRxStatemachine_incoming_data(wire, len);
+        len = build_multipart_first_msg(wire, 0xAAAAAAAA0000ULL + i,
+                0x1C48, source, dest, pay, 2);
+        TcpRxStatemachine_incoming_data(0, wire, len);
+    }
     EXPECT_EQ(_push_count, 0);
 
-    // Third FIRST — table full, dropped
+    // One more FIRST — table full, dropped
     len = build_multipart_first_msg(wire, 0xCCCCCCCCCCCCULL,
             0x1C48, source, dest, pay, 2);
-    TcpRxStatemachine_incoming_data(wire, len);
-    EXPECT_EQ(_push_count, 0);
+    TcpRxStatemachine_incoming_data(0, wire, len);
 
-    // Verify slot 0 still works — send LAST for it
     uint8_t last_pay[] = {0x03, 0x04};
     len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
-            0xAAAAAAAAAAAAULL, last_pay, 2);
-    TcpRxStatemachine_incoming_data(wire, len);
+            0xCCCCCCCCCCCCULL, last_pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    EXPECT_EQ(_push_count, 0);
+
+    // Verify the first entry still works — send LAST for it
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
+            0xAAAAAAAA0000ULL, last_pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 1);
 
     OpenLcbBufferStore_free_buffer(_last_pushed_msg);
-    TcpRxStatemachine_reset();
+    TcpRxStatemachine_reset(0);
 }
 
 // =============================================================================
@@ -607,7 +654,7 @@ TEST(TCP_RxStatemachine, multipart_middle_no_slot_dropped)
     uint16_t len = build_multipart_continuation_msg(wire,
             TCP_FLAGS_MULTIPART_MIDDLE, 0xDDDDDDDDDDDDULL, pay, 3);
 
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
 
     EXPECT_EQ(_push_count, 0);
 }
@@ -625,7 +672,7 @@ TEST(TCP_RxStatemachine, multipart_last_no_slot_dropped)
     uint16_t len = build_multipart_continuation_msg(wire,
             TCP_FLAGS_MULTIPART_LAST, 0xEEEEEEEEEEEEULL, pay, 3);
 
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
 
     EXPECT_EQ(_push_count, 0);
 }
@@ -649,16 +696,16 @@ TEST(TCP_RxStatemachine, addressed_body_too_short_for_dest)
     wire[offset++] = 0x00;
     wire[offset++] = 0x00;
 
-    TcpRxStatemachine_incoming_data(wire, offset);
+    TcpRxStatemachine_incoming_data(0, wire, offset);
 
     EXPECT_EQ(_push_count, 0);
 }
 
 // =============================================================================
-// allocate_buffer returns NULL for single-part message — dropped
+// allocate_buffer returns NULL for single-part message — held, not dropped
 // =============================================================================
 
-TEST(TCP_RxStatemachine, allocate_null_single_part_dropped)
+TEST(TCP_RxStatemachine, allocate_null_single_part_held)
 {
     setup_test();
     _mock_allocate_returns_null = true;
@@ -666,9 +713,21 @@ TEST(TCP_RxStatemachine, allocate_null_single_part_dropped)
     uint8_t wire[64];
     uint16_t wire_len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
 
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, wire, wire_len), wire_len);
+    EXPECT_EQ(_push_count, 0);
 
+    // Still out of buffers: an empty call retries and still holds it
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, wire, 0), 0);
     EXPECT_EQ(_push_count, 0);
+
+    // Buffers back: an empty call delivers the held message
+    _mock_allocate_returns_null = false;
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, wire, 0), 0);
+    EXPECT_EQ(_push_count, 1);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->mti, 0x0490);
+
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
 }
 
 // =============================================================================
@@ -689,64 +748,243 @@ TEST(TCP_RxStatemachine, multipart_first_body_too_short)
     wire[offset++] = 0x00;
     wire[offset++] = 0x00;
 
-    TcpRxStatemachine_incoming_data(wire, offset);
+    TcpRxStatemachine_incoming_data(0, wire, offset);
 
     EXPECT_EQ(_push_count, 0);
 
-    TcpRxStatemachine_reset();
+    TcpRxStatemachine_reset(0);
 }
 
 // =============================================================================
-// Multipart FIRST — allocate_buffer returns NULL
+// Multipart LAST — allocate_buffer returns NULL, held until a buffer frees up
 // =============================================================================
 
-TEST(TCP_RxStatemachine, multipart_first_allocate_null)
+TEST(TCP_RxStatemachine, multipart_last_allocate_null_held)
 {
     setup_test();
-    _mock_allocate_returns_null = true;
 
+    node_id_t orig = 0xAAAAAAAAAAAAULL;
     uint8_t pay[] = {0x01, 0x02};
     uint8_t wire[128];
-    uint16_t len = build_multipart_first_msg(wire, 0xAAAAAAAAAAAAULL,
+    uint16_t len = build_multipart_first_msg(wire, orig,
             0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, pay, 2);
 
-    TcpRxStatemachine_incoming_data(wire, len);
+    // FIRST needs no buffer: its payload goes to the arena
+    _mock_allocate_returns_null = true;
+    TcpRxStatemachine_incoming_data(0, wire, len);
 
+    uint8_t last_pay[] = {0x03, 0x04};
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
+            orig, last_pay, 2);
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, wire, len), len);
     EXPECT_EQ(_push_count, 0);
+
+    _mock_allocate_returns_null = false;
+    TcpRxStatemachine_incoming_data(0, wire, 0);
+    EXPECT_EQ(_push_count, 1);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->payload_count, 4);
+    uint8_t expected[] = {0x01, 0x02, 0x03, 0x04};
+    EXPECT_EQ(memcmp(_last_pushed_msg->payload, expected, 4), 0);
+
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
 }
 
 // =============================================================================
-// Buffer overflow — accumulation buffer full resets _rx_count
+// Oversized message — longer than the ring, skipped as it streams past
 // =============================================================================
 
-TEST(TCP_RxStatemachine, buffer_overflow_resets)
+TEST(TCP_RxStatemachine, oversized_message_skipped)
 {
     setup_test();
 
-    // Build a preamble declaring a very large body (1100 bytes)
-    // so the while loop waits for more data, and we keep feeding bytes
-    uint8_t big_buf[1030];
+    // Preamble declaring a 1100-byte body, which can never fit the ring
+    uint8_t big_buf[1100 + TCP_PREAMBLE_LEN];
     uint16_t offset = TcpUtilities_encode_preamble(
             big_buf, TCP_FLAGS_MESSAGE, 1100, 0x050101012200ULL, 500);
     memset(&big_buf[offset], 0xAA, sizeof(big_buf) - offset);
 
-    // Feed 1020 bytes — fills accumulation buffer to 1020
-    TcpRxStatemachine_incoming_data(big_buf, 1020);
-    EXPECT_EQ(_push_count, 0);
+    uint8_t wire[64];
+    uint16_t wire_len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
 
-    // Feed 10 more — at byte 1024 the overflow fires, resets _rx_count
-    TcpRxStatemachine_incoming_data(&big_buf[1020], 10);
+    // Stream the oversized message in pieces, then a valid one; all consumed
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, big_buf, 500), 500);
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, &big_buf[500], 500), 500);
     EXPECT_EQ(_push_count, 0);
 
-    // Verify system recovers — send a fresh valid message
-    uint8_t wire[64];
-    uint16_t wire_len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
-    TcpRxStatemachine_incoming_data(wire, wire_len);
+    uint8_t tail[256];
+    uint16_t tail_len = (uint16_t) (sizeof(big_buf) - 1000);
+    memcpy(tail, &big_buf[1000], tail_len);
+    memcpy(&tail[tail_len], wire, wire_len);
+
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, tail, tail_len + wire_len), tail_len + wire_len);
     EXPECT_EQ(_push_count, 1);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->mti, 0x0490);
+
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
+
+// =============================================================================
+// Ring wrap-around — preamble, body header and link control body split
+// across the end of the ring
+// =============================================================================
+
+/**
+ * @brief Feeds messages totalling head bytes plus the first 5 bytes of
+ * next, leaving the ring head parked at offset head with next pending.
+ *
+ * @return Number of messages pushed by the filler (freed on push).
+ */
+static int park_ring_head(uint16_t head, const uint8_t *next)
+{
+    uint8_t stream[USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN];
+    uint8_t pay[25] = {0};
+    uint16_t len = 0;
+    int count = 0;
+
+    // 25-byte unaddressed fillers, then one addressed message (31 + n bytes)
+    // sized to land exactly on head
+    while (head - len - 31 >= 25) {
+        len += build_unaddressed_msg(&stream[len], 0x0490, 0x010203040506ULL);
+        count++;
+    }
+    len += build_addressed_msg(&stream[len], 0x0A28, 0x010203040506ULL,
+            0x0A0B0C0D0E0FULL, pay, (uint16_t) (head - len - 31));
+    count++;
+
+    memcpy(&stream[len], next, 5);
+
+    _mock_free_on_push = true;
+    TcpRxStatemachine_incoming_data(0, stream, (uint16_t) (len + 5));
+    _mock_free_on_push = false;
+
+    return count;
+}
+
+TEST(TCP_RxStatemachine, preamble_wraps_ring)
+{
+    setup_test();
+
+    uint8_t pay[40];
+    for (int i = 0; i < 40; i++)
+        pay[i] = (uint8_t) (0x80 + i);
+
+    uint8_t wire[128];
+    uint16_t wire_len = build_addressed_msg(wire, 0x0A28, 0x010203040506ULL,
+            0x0A0B0C0D0E0FULL, pay, 40);
+
+    // Preamble occupies the last 8 bytes of the ring and the first 9
+    int parked = park_ring_head(USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN - 8, wire);
+    EXPECT_EQ(_push_count, parked);
+
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, &wire[5], wire_len - 5), wire_len - 5);
+    ASSERT_EQ(_push_count, parked + 1);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->mti, 0x0A28);
+    EXPECT_EQ(_last_pushed_msg->dest_id, 0x0A0B0C0D0E0FULL);
+    ASSERT_EQ(_last_pushed_msg->payload_count, 40);
+    EXPECT_EQ(memcmp(_last_pushed_msg->payload, pay, 40), 0);
+
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
+
+TEST(TCP_RxStatemachine, body_header_and_payload_wrap_ring)
+{
+    setup_test();
+
+    uint8_t pay[64];
+    for (int i = 0; i < 64; i++)
+        pay[i] = (uint8_t) (0x40 + i);
+
+    uint8_t wire[128];
+    uint16_t wire_len = build_addressed_msg(wire, 0x0A28, 0x010203040506ULL,
+            0x0A0B0C0D0E0FULL, pay, 64);
+
+    // Body header starts on the last ring byte, so MTI, source and destination wrap
+    int parked = park_ring_head(USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN - 18, wire);
+
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, &wire[5], wire_len - 5), wire_len - 5);
+    ASSERT_EQ(_push_count, parked + 1);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->mti, 0x0A28);
+    EXPECT_EQ(_last_pushed_msg->source_id, 0x010203040506ULL);
+    EXPECT_EQ(_last_pushed_msg->dest_id, 0x0A0B0C0D0E0FULL);
+    ASSERT_EQ(_last_pushed_msg->payload_count, 64);
+    EXPECT_EQ(memcmp(_last_pushed_msg->payload, pay, 64), 0);
 
     OpenLcbBufferStore_free_buffer(_last_pushed_msg);
 }
 
+TEST(TCP_RxStatemachine, link_control_body_wraps_ring)
+{
+    setup_test();
+
+    uint8_t lc[32];
+    uint16_t lc_len = TcpUtilities_encode_preamble(lc, 0x0000, 2, 0x050101012200ULL, 0);
+    lc_len += TcpUtilities_encode_uint16(&lc[lc_len], 0x0001);
+
+    // Two-byte link control type sits on the last and first ring bytes
+    int parked = park_ring_head(USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN - 18, lc);
+
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, &lc[5], lc_len - 5), lc_len - 5);
+    EXPECT_EQ(_push_count, parked);
+    EXPECT_TRUE(_link_control_called);
+    EXPECT_EQ(_link_control_len, 2);
+    EXPECT_EQ(_link_control_data[0], 0x00);
+    EXPECT_EQ(_link_control_data[1], 0x01);
+}
+
+// =============================================================================
+// Many small messages in one TCP segment — all parsed in one call
+// =============================================================================
+
+TEST(TCP_RxStatemachine, many_small_messages_one_segment)
+{
+    setup_test();
+    _mock_free_on_push = true;
+
+    // 58 x 25-byte messages = 1450 bytes, more than the 1024-byte ring
+    uint8_t segment[1460];
+    uint16_t seg_len = 0;
+
+    for (int i = 0; i < 58; i++)
+        seg_len += build_unaddressed_msg(&segment[seg_len], 0x0490, 0x010203040500ULL + (uint64_t) i);
+
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, segment, seg_len), seg_len);
+    EXPECT_EQ(_push_count, 58);
+    EXPECT_TRUE(_on_rx_called);
+    EXPECT_EQ(_on_rx_len, seg_len);
+}
+
+// =============================================================================
+// Backpressure — ring full behind a held message returns a partial count
+// =============================================================================
+
+TEST(TCP_RxStatemachine, backpressure_returns_bytes_consumed)
+{
+    setup_test();
+    _mock_free_on_push = true;
+    _mock_allocate_returns_null = true;
+
+    uint8_t segment[1460];
+    uint16_t seg_len = 0;
+
+    for (int i = 0; i < 58; i++)
+        seg_len += build_unaddressed_msg(&segment[seg_len], 0x0490, 0x010203040500ULL + (uint64_t) i);
+
+    // No buffers: the ring fills and the rest is pushed back to the caller
+    uint16_t consumed = TcpRxStatemachine_incoming_data(0, segment, seg_len);
+    EXPECT_EQ(consumed, USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN);
+    EXPECT_EQ(_push_count, 0);
+    EXPECT_EQ(_on_rx_len, consumed);
+
+    // Buffers return: offering the remainder drains everything in order
+    _mock_allocate_returns_null = false;
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(0, &segment[consumed], seg_len - consumed), seg_len - consumed);
+    EXPECT_EQ(_push_count, 58);
+}
+
 // =============================================================================
 // Partial message — preamble complete but body incomplete (while loop return)
 // =============================================================================
@@ -760,11 +998,11 @@ TEST(TCP_RxStatemachine, partial_preamble_complete_body_incomplete)
 
     // Send 20 bytes: enough for preamble (17) but not full message (25)
     // This enters the while loop but hits _rx_count < total_msg_len → return
-    TcpRxStatemachine_incoming_data(wire, 20);
+    TcpRxStatemachine_incoming_data(0, wire, 20);
     EXPECT_EQ(_push_count, 0);
 
     // Send remaining bytes — message completes
-    TcpRxStatemachine_incoming_data(&wire[20], wire_len - 20);
+    TcpRxStatemachine_incoming_data(0, &wire[20], wire_len - 20);
     EXPECT_EQ(_push_count, 1);
     ASSERT_NE(_last_pushed_msg, nullptr);
     EXPECT_EQ(_last_pushed_msg->mti, 0x0490);
@@ -785,16 +1023,16 @@ TEST(TCP_RxStatemachine, reset_frees_in_progress_multipart)
     uint16_t len = build_multipart_first_msg(wire, 0xAAAAAAAAAAAAULL,
             0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, pay, 4);
 
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 0);
 
     // Reset should free the in-progress multipart buffer
-    TcpRxStatemachine_reset();
+    TcpRxStatemachine_reset(0);
 
     // Verify system works after reset
     uint8_t wire2[64];
     uint16_t wire2_len = build_unaddressed_msg(wire2, 0x0490, 0x010203040506ULL);
-    TcpRxStatemachine_incoming_data(wire2, wire2_len);
+    TcpRxStatemachine_incoming_data(0, wire2, wire2_len);
     EXPECT_EQ(_push_count, 1);
 
     OpenLcbBufferStore_free_buffer(_last_pushed_msg);
@@ -816,7 +1054,7 @@ TEST(TCP_RxStatemachine, link_control_zero_body)
     uint16_t offset = TcpUtilities_encode_preamble(
             wire, 0x0000, 0, 0x050101012200ULL, 500);
 
-    TcpRxStatemachine_incoming_data(wire, offset);
+    TcpRxStatemachine_incoming_data(0, wire, offset);
 
     EXPECT_TRUE(_link_control_called);
     EXPECT_EQ(_link_control_len, 0);
@@ -835,7 +1073,7 @@ TEST(TCP_RxStatemachine, message_zero_body_dropped)
     uint16_t offset = TcpUtilities_encode_preamble(
             wire, TCP_FLAGS_MESSAGE, 0, 0x050101012200ULL, 500);
 
-    TcpRxStatemachine_incoming_data(wire, offset);
+    TcpRxStatemachine_incoming_data(0, wire, offset);
 
     EXPECT_EQ(_push_count, 0);
 }
@@ -858,7 +1096,7 @@ TEST(TCP_RxStatemachine, multipart_first_addressed_body_short_for_dest)
     offset += TcpUtilities_encode_uint16(&wire[offset], 0x0828);  // addressed MTI
     offset += TcpUtilities_encode_node_id(&wire[offset], 0x010203040506ULL);
 
-    TcpRxStatemachine_incoming_data(wire, offset);
+    TcpRxStatemachine_incoming_data(0, wire, offset);
 
     EXPECT_EQ(_push_count, 0);
 
@@ -866,7 +1104,7 @@ TEST(TCP_RxStatemachine, multipart_first_addressed_body_short_for_dest)
     uint8_t last_wire[64];
     uint16_t last_len = build_multipart_continuation_msg(last_wire,
             TCP_FLAGS_MULTIPART_LAST, 0x050101012200ULL, NULL, 0);
-    TcpRxStatemachine_incoming_data(last_wire, last_len);
+    TcpRxStatemachine_incoming_data(0, last_wire, last_len);
 
     if (_last_pushed_msg)
         OpenLcbBufferStore_free_buffer(_last_pushed_msg);
@@ -888,20 +1126,20 @@ TEST(TCP_RxStatemachine, multipart_middle_zero_body)
     // Send FIRST
     len = build_multipart_first_msg(wire, orig,
             0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, pay, 2);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 0);
 
     // Send MIDDLE with zero body
     len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_MIDDLE,
             orig, NULL, 0);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 0);
 
     // Send LAST to complete
     uint8_t last_pay[] = {0x03, 0x04};
     len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
             orig, last_pay, 2);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 1);
 
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -928,7 +1166,7 @@ TEST(TCP_RxStatemachine, multipart_payload_overflow_capped)
     memset(big_pay, 0xAA, sizeof(big_pay));
     len = build_multipart_first_msg(wire, orig,
             0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, big_pay, 250);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 0);
 
     // Send MIDDLE with 10 bytes — only 6 fit (256-250=6), remaining after = 0
@@ -936,7 +1174,7 @@ TEST(TCP_RxStatemachine, multipart_payload_overflow_capped)
     memset(mid_pay, 0xBB, sizeof(mid_pay));
     len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_MIDDLE,
             orig, mid_pay, 10);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 0);
 
     // Send another MIDDLE — remaining = 0, copy_len = 0
@@ -944,13 +1182,13 @@ TEST(TCP_RxStatemachine, multipart_payload_overflow_capped)
     memset(mid_pay2, 0xCC, sizeof(mid_pay2));
     len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_MIDDLE,
             orig, mid_pay2, 5);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 0);
 
     // Send LAST to complete
     len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
             orig, NULL, 0);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 1);
 
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -977,21 +1215,21 @@ TEST(TCP_RxStatemachine, multipart_first_middle_last)
     // FIRST with 4-byte payload
     uint8_t p1[] = {0x01, 0x02, 0x03, 0x04};
     len = build_multipart_first_msg(wire, orig, 0x1C48, source, dest, p1, 4);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 0);
 
     // MIDDLE with 4-byte payload
     uint8_t p2[] = {0x05, 0x06, 0x07, 0x08};
     len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_MIDDLE,
             orig, p2, 4);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 0);
 
     // LAST with 4-byte payload
     uint8_t p3[] = {0x09, 0x0A, 0x0B, 0x0C};
     len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
             orig, p3, 4);
-    TcpRxStatemachine_incoming_data(wire, len);
+    TcpRxStatemachine_incoming_data(0, wire, len);
     EXPECT_EQ(_push_count, 1);
 
     ASSERT_NE(_last_pushed_msg, nullptr);
@@ -1007,3 +1245,327 @@ TEST(TCP_RxStatemachine, multipart_first_middle_last)
 
     OpenLcbBufferStore_free_buffer(_last_pushed_msg);
 }
+
+// =============================================================================
+// Multiple connections
+// =============================================================================
+
+TEST(TCP_RxStatemachine, connections_keep_separate_rings)
+{
+    setup_test();
+
+    uint8_t wire_a[64];
+    uint8_t wire_b[64];
+    uint16_t len_a = build_unaddressed_msg(wire_a, 0x0490, 0x010203040506ULL);
+    uint16_t len_b = build_unaddressed_msg(wire_b, 0x0914, 0x0A0B0C0D0E0FULL);
+
+    // Half of each message on each connection: nothing is complete yet
+    TcpRxStatemachine_incoming_data(0, wire_a, 10);
+    TcpRxStatemachine_incoming_data(1, wire_b, 10);
+    EXPECT_EQ(_push_count, 0);
+
+    TcpRxStatemachine_incoming_data(1, &wire_b[10], len_b - 10);
+    EXPECT_EQ(_push_count, 1);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->mti, 0x0914);
+    EXPECT_EQ(_learn_route_connection, 1);
+    EXPECT_EQ(_learn_route_node_id, 0x0A0B0C0D0E0FULL);
+    EXPECT_TRUE(_learn_route_locked);
+    EXPECT_EQ(_lock_depth, 0);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+
+    TcpRxStatemachine_incoming_data(0, &wire_a[10], len_a - 10);
+    EXPECT_EQ(_push_count, 2);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->mti, 0x0490);
+    EXPECT_EQ(_last_pushed_msg->source_id, 0x010203040506ULL);
+    EXPECT_EQ(_learn_route_connection, 0);
+    EXPECT_EQ(_learn_route_count, 2);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
+
+TEST(TCP_RxStatemachine, connections_keep_separate_multipart_tables)
+{
+    setup_test();
+
+    // Same originating Node ID on both connections must not collide
+    node_id_t orig = 0x050101012200ULL;
+    uint8_t wire[128];
+    uint16_t len;
+    uint8_t p_a[] = {0xA1, 0xA2};
+    uint8_t p_b[] = {0xB1, 0xB2};
+
+    len = build_multipart_first_msg(wire, orig, 0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, p_a, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    len = build_multipart_first_msg(wire, orig, 0x1C48, 0x020202020202ULL, 0x0A0B0C0D0E0FULL, p_b, 2);
+    TcpRxStatemachine_incoming_data(1, wire, len);
+
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST, orig, p_a, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+
+    ASSERT_EQ(_push_count, 1);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->source_id, 0x010203040506ULL);
+    EXPECT_EQ(_last_pushed_msg->payload_count, 4);
+    uint8_t expected_a[] = {0xA1, 0xA2, 0xA1, 0xA2};
+    EXPECT_EQ(memcmp(_last_pushed_msg->payload, expected_a, 4), 0);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST, orig, p_b, 2);
+    TcpRxStatemachine_incoming_data(1, wire, len);
+
+    ASSERT_EQ(_push_count, 2);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    EXPECT_EQ(_last_pushed_msg->source_id, 0x020202020202ULL);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
+
+TEST(TCP_RxStatemachine, link_control_reports_connection)
+{
+    setup_test();
+
+    uint8_t wire[32];
+    uint8_t body[2];
+    TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
+    uint16_t len = TcpUtilities_encode_preamble(wire, 0x0000, 2, 0x050101012200ULL, 0);
+    memcpy(&wire[len], body, 2);
+    len += 2;
+
+    TcpRxStatemachine_incoming_data(1, wire, len);
+
+    EXPECT_TRUE(_link_control_called);
+    EXPECT_EQ(_link_control_connection, 1);
+    EXPECT_EQ(_learn_route_count, 0);
+}
+
+TEST(TCP_RxStatemachine, reset_one_connection_keeps_other)
+{
+    setup_test();
+
+    uint8_t wire[64];
+    uint16_t len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
+
+    TcpRxStatemachine_incoming_data(0, wire, 10);
+    TcpRxStatemachine_incoming_data(1, wire, 10);
+
+    TcpRxStatemachine_reset(0);
+
+    // Connection 0 lost its partial bytes, so the tail alone is garbage there;
+    // connection 1 completes normally
+    TcpRxStatemachine_incoming_data(1, &wire[10], len - 10);
+    EXPECT_EQ(_push_count, 1);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    EXPECT_EQ(_push_count, 2);
+    ASSERT_NE(_last_pushed_msg, nullptr);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
+
+TEST(TCP_RxStatemachine, out_of_range_connection_ignored)
+{
+    setup_test();
+
+    uint8_t wire[64];
+    uint16_t len = build_unaddressed_msg(wire, 0x0490, 0x010203040506ULL);
+
+    EXPECT_EQ(TcpRxStatemachine_incoming_data(USER_DEFINED_TCP_MAX_CONNECTIONS, wire, len), 0);
+    EXPECT_EQ(_push_count, 0);
+
+    TcpRxStatemachine_reset(USER_DEFINED_TCP_MAX_CONNECTIONS);
+}
+
+// =============================================================================
+// Multi-part table: timeouts, shared arena, restart
+// =============================================================================
+
+TEST(TCP_RxStatemachine, multipart_times_out_without_parts)
+{
+    setup_test();
+
+    node_id_t orig = 0xAAAAAAAAAAAAULL;
+    uint8_t pay[] = {0x01, 0x02};
+    uint8_t wire[128];
+    uint16_t len;
+
+    len = build_multipart_first_msg(wire, orig,
+            0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+
+    // A MIDDLE inside the window keeps it alive
+    _mock_tick = USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS - 1;
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_MIDDLE,
+            orig, pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+
+    // Silent for the whole window: the LAST finds nothing
+    _mock_tick += USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS;
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
+            orig, pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    EXPECT_EQ(_push_count, 0);
+}
+
+TEST(TCP_RxStatemachine, multipart_timeout_frees_entries_for_reuse)
+{
+    setup_test();
+
+    uint8_t pay[] = {0x01, 0x02};
+    uint8_t wire[128];
+    uint16_t len;
+
+    for (int i = 0; i < USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES; i++) {
+
+        len = build_multipart_first_msg(wire, 0xAAAAAAAA0000ULL + i,
+                0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, pay, 2);
+        TcpRxStatemachine_incoming_data(0, wire, len);
+    }
+
+    // All stale: the next FIRST purges them and gets an entry
+    _mock_tick = USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS;
+    len = build_multipart_first_msg(wire, 0xCCCCCCCCCCCCULL,
+            0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
+            0xCCCCCCCCCCCCULL, pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    EXPECT_EQ(_push_count, 1);
+
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
+
+TEST(TCP_RxStatemachine, multipart_assemblies_complete_in_any_order)
+{
+    setup_test();
+
+    uint8_t wire[128];
+    uint16_t len;
+
+    for (int i = 0; i < USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES; i++) {
+
+        uint8_t pay[] = {(uint8_t) i};
+        len = build_multipart_first_msg(wire, 0xAAAAAAAA0000ULL + i,
+                0x1C48, 0x010203040500ULL + i, 0x0A0B0C0D0E0FULL, pay, 1);
+        TcpRxStatemachine_incoming_data((uint8_t) (i % USER_DEFINED_TCP_MAX_CONNECTIONS), wire, len);
+    }
+
+    for (int i = USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES - 1; i >= 0; i--) {
+
+        uint8_t pay[] = {(uint8_t) (0x80 | i)};
+        len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
+                0xAAAAAAAA0000ULL + i, pay, 1);
+        TcpRxStatemachine_incoming_data((uint8_t) (i % USER_DEFINED_TCP_MAX_CONNECTIONS), wire, len);
+
+        ASSERT_NE(_last_pushed_msg, nullptr);
+        EXPECT_EQ(_last_pushed_msg->source_id, 0x010203040500ULL + i);
+        ASSERT_EQ(_last_pushed_msg->payload_count, 2);
+        EXPECT_EQ(((uint8_t *) _last_pushed_msg->payload)[0], (uint8_t) i);
+        EXPECT_EQ(((uint8_t *) _last_pushed_msg->payload)[1], (uint8_t) (0x80 | i));
+        OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+        _last_pushed_msg = NULL;
+    }
+
+    EXPECT_EQ(_push_count, USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES);
+}
+
+TEST(TCP_RxStatemachine, multipart_arena_exhausted_drops_assembly)
+{
+    setup_test();
+
+    uint8_t wire[400];
+    uint8_t big_pay[TCP_MULTIPART_ARENA_BLOCK_LEN * 4];
+    uint16_t len;
+    memset(big_pay, 0x55, sizeof(big_pay));
+
+    // Each assembly takes 8 blocks (256 bytes): fill the arena
+    int filled = USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS / 8;
+    ASSERT_LT(filled, USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES);
+
+    for (int i = 0; i < filled; i++) {
+
+        len = build_multipart_first_msg(wire, 0xAAAAAAAA0000ULL + i,
+                0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, big_pay, sizeof(big_pay));
+        TcpRxStatemachine_incoming_data(0, wire, len);
+        len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_MIDDLE,
+                0xAAAAAAAA0000ULL + i, big_pay, sizeof(big_pay));
+        TcpRxStatemachine_incoming_data(0, wire, len);
+    }
+
+    // No blocks left: this assembly is dropped
+    len = build_multipart_first_msg(wire, 0xCCCCCCCCCCCCULL,
+            0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, big_pay, 4);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
+            0xCCCCCCCCCCCCULL, NULL, 0);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    EXPECT_EQ(_push_count, 0);
+
+    // Completing one returns its blocks
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
+            0xAAAAAAAA0000ULL, NULL, 0);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    ASSERT_EQ(_push_count, 1);
+    EXPECT_EQ(_last_pushed_msg->payload_count, LEN_MESSAGE_BYTES_SNIP);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+
+    len = build_multipart_first_msg(wire, 0xCCCCCCCCCCCCULL,
+            0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, big_pay, 4);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST,
+            0xCCCCCCCCCCCCULL, NULL, 0);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    ASSERT_EQ(_push_count, 2);
+    EXPECT_EQ(_last_pushed_msg->payload_count, 4);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
+
+TEST(TCP_RxStatemachine, multipart_repeated_first_restarts)
+{
+    setup_test();
+
+    node_id_t orig = 0xAAAAAAAAAAAAULL;
+    uint8_t p1[] = {0x01, 0x02};
+    uint8_t p2[] = {0x03};
+    uint8_t wire[128];
+    uint16_t len;
+
+    len = build_multipart_first_msg(wire, orig, 0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, p1, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    len = build_multipart_first_msg(wire, orig, 0x1C48, 0x060504030201ULL, 0x0A0B0C0D0E0FULL, p2, 1);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST, orig, NULL, 0);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+
+    ASSERT_EQ(_push_count, 1);
+    EXPECT_EQ(_last_pushed_msg->source_id, 0x060504030201ULL);
+    EXPECT_EQ(_last_pushed_msg->payload_count, 1);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
+
+TEST(TCP_RxStatemachine, reset_keeps_other_connection_multipart)
+{
+    setup_test();
+
+    node_id_t orig = 0x050101012200ULL;
+    uint8_t pay[] = {0x01, 0x02};
+    uint8_t wire[128];
+    uint16_t len;
+
+    len = build_multipart_first_msg(wire, orig, 0x1C48, 0x010203040506ULL, 0x0A0B0C0D0E0FULL, pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    TcpRxStatemachine_incoming_data(1, wire, len);
+
+    TcpRxStatemachine_reset(0);
+
+    len = build_multipart_continuation_msg(wire, TCP_FLAGS_MULTIPART_LAST, orig, pay, 2);
+    TcpRxStatemachine_incoming_data(0, wire, len);
+    EXPECT_EQ(_push_count, 0);
+
+    TcpRxStatemachine_incoming_data(1, wire, len);
+    ASSERT_EQ(_push_count, 1);
+    EXPECT_EQ(_last_pushed_msg->payload_count, 4);
+    OpenLcbBufferStore_free_buffer(_last_pushed_msg);
+}
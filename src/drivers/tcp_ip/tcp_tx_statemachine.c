@@ -45,6 +45,274 @@ static const interface_tcp_tx_statemachine_t *_interface;
 
 static tcp_tx_buffer_t _tx_buffer;
 
+    /** @brief Encoded preamble and body header for the scatter-gather path. */
+static uint8_t _tx_header[TCP_TX_HEADER_LEN];
+
+    /** @brief Coalescing batch of every connection. */
+static tcp_tx_connection_t _tx[USER_DEFINED_TCP_MAX_CONNECTIONS];
+
+    /** @brief Remote Node IDs and the connection each was last heard on. */
+static tcp_route_entry_t _routes[USER_DEFINED_TCP_ROUTE_TABLE_DEPTH];
+
+    /** @brief Entry replaced next when the route table is full. */
+static uint8_t _route_victim;
+
+    /** @brief Runtime switch; coalescing also needs a non-zero buffer length. */
+static bool _coalesce_enabled;
+
+static tcp_tx_coalesce_stats_t _coalesce_stats;
+
+// =========================================================================
+// Internal helpers
+// =========================================================================
+
+/**
+ * @brief Encodes the preamble, MTI, source and (if addressed) destination
+ * Node ID of msg into buf.
+ *
+ * @param buf       Output buffer (>= TCP_TX_HEADER_LEN bytes).
+ * @param msg       Message being sent.
+ * @param body_len  Full body length including the payload.
+ *
+ * @return Number of header bytes written.
+ */
+static uint16_t _encode_message_header(uint8_t *buf, openlcb_msg_t *msg, uint32_t body_len) {
+
+    uint16_t offset = TcpUtilities_encode_preamble(
+            buf,
+            TCP_FLAGS_MESSAGE,
+            body_len,
+            _interface->get_local_node_id(),
+            _interface->get_capture_time_ms());
+
+    // MTI (2 bytes, big-endian)
+    offset += TcpUtilities_encode_uint16(&buf[offset], msg->mti);
+
+    // Source Node ID (6 bytes)
+    offset += TcpUtilities_encode_node_id(&buf[offset], msg->source_id);
+
+    // Destination Node ID (6 bytes, if addressed)
+    if ((msg->mti & MASK_DEST_ADDRESS_PRESENT) == MASK_DEST_ADDRESS_PRESENT)
+        offset += TcpUtilities_encode_node_id(&buf[offset], msg->dest_id);
+
+    return offset;
+}
+
+/**
+ * @brief Sends a header held in _tx_header plus an optional body segment
+ * through transmit_raw_tcp_segments.
+ */
+static bool _transmit_segments(uint8_t connection, uint16_t header_len, const uint8_t *body, uint16_t body_len) {
+
+    tcp_tx_segment_t segments[TCP_TX_MAX_SEGMENTS];
+    uint8_t count = 1;
+
+    segments[0].data = _tx_header;
+    segments[0].len = header_len;
+
+    if (body_len > 0 && body) {
+
+        segments[1].data = body;
+        segments[1].len = body_len;
+        count = 2;
+    }
+
+    bool result = _interface->transmit_raw_tcp_segments(connection, segments, count);
+
+    if (result && _interface->on_tx) {
+
+        for (uint8_t i = 0; i < count; i++)
+            _interface->on_tx((uint8_t *) segments[i].data, segments[i].len);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Hands the bytes built in _tx_buffer to one connection.
+ */
+static bool _transmit_buffer(uint8_t connection, uint16_t len) {
+
+    bool result = _interface->transmit_raw_tcp_data(connection, _tx_buffer, len);
+
+    if (result && _interface->on_tx)
+        _interface->on_tx(_tx_buffer, len);
+
+    return result;
+}
+
+/**
+ * @brief Hands the whole coalescing batch of one connection to the driver as one send.
+ *
+ * @param connection  Connection whose batch is flushed.
+ * @param reason      Stats counter to bump when the flush succeeds.
+ *
+ * @return true if the batch is now empty, false if the driver refused it
+ *         (the batch is kept for the next attempt).
+ */
+static bool _flush_batch(uint8_t connection, uint32_t *reason) {
+
+    tcp_tx_connection_t *tx = &_tx[connection];
+
+    if (tx->batch_len == 0)
+        return true;
+
+    bool result;
+
+    if (_interface->transmit_raw_tcp_data) {
+
+        result = _interface->transmit_raw_tcp_data(connection, tx->batch, tx->batch_len);
+
+    } else {
+
+        tcp_tx_segment_t segment;
+
+        segment.data = tx->batch;
+        segment.len = tx->batch_len;
+        result = _interface->transmit_raw_tcp_segments(connection, &segment, 1);
+    }
+
+    if (!result)
+        return false;
+
+    if (_interface->on_tx)
+        _interface->on_tx(tx->batch, tx->batch_len);
+
+    _coalesce_stats.batches_sent++;
+    _coalesce_stats.messages_coalesced += tx->batch_count;
+    _coalesce_stats.segments_saved += (uint32_t) (tx->batch_count - 1);
+    (*reason)++;
+
+    tx->batch_len = 0;
+    tx->batch_count = 0;
+
+    return true;
+}
+
+#if USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN > 0
+
+/**
+ * @brief Appends a message that fits the coalescing buffer of one connection
+ * and applies the size and priority flush rules.
+ *
+ * @details Algorithm:
+ * -# Flush the current batch first if the message does not fit behind it
+ * -# Encode the header and copy the payload to the end of the batch
+ * -# Flush right away if the message is addressed (a peer is waiting on it),
+ *    or if the batch reached USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD
+ *
+ * @return false only if a full batch could not be flushed to make room.
+ */
+static bool _append_to_batch(uint8_t connection, openlcb_msg_t *msg, uint32_t body_len, uint16_t total_len) {
+
+    tcp_tx_connection_t *tx = &_tx[connection];
+
+    if ((uint32_t) tx->batch_len + total_len > USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN) {
+
+        if (!_flush_batch(connection, &_coalesce_stats.flush_size))
+            return false;
+    }
+
+    if (tx->batch_len == 0)
+        tx->batch_start_ms = _interface->get_capture_time_ms();
+
+    uint16_t offset = tx->batch_len;
+
+    offset += _encode_message_header(&tx->batch[offset], msg, body_len);
+
+    if (msg->payload_count > 0 && msg->payload) {
+
+        memcpy(&tx->batch[offset], msg->payload, msg->payload_count);
+        offset += msg->payload_count;
+    }
+
+    tx->batch_len = offset;
+    tx->batch_count++;
+    tx->batch_appended = true;
+
+    if ((msg->mti & MASK_DEST_ADDRESS_PRESENT) == MASK_DEST_ADDRESS_PRESENT)
+        _flush_batch(connection, &_coalesce_stats.flush_priority);
+    else if (tx->batch_len >= USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD)
+        _flush_batch(connection, &_coalesce_stats.flush_size);
+
+    return true;
+}
+
+#endif
+
+/**
+ * @brief Returns true if the connection is logging in or running.
+ *
+ * @details Without a get_link_state callback every connection counts as open
+ * and the driver's transmit result decides.
+ */
+static bool _is_open(uint8_t connection) {
+
+    if (!_interface->get_link_state)
+        return true;
+
+    tcp_link_state_enum state = _interface->get_link_state(connection);
+
+    return state == TCP_LINK_STATE_LOGGING_IN || state == TCP_LINK_STATE_RUNNING;
+}
+
+/**
+ * @brief Picks the connection an addressed message is routed to.
+ *
+ * @return The connection the destination was last heard on if it is still
+ *         open, or TCP_CONNECTION_NONE to send on every open connection.
+ */
+static uint8_t _route_message(openlcb_msg_t *msg) {
+
+    if ((msg->mti & MASK_DEST_ADDRESS_PRESENT) != MASK_DEST_ADDRESS_PRESENT)
+        return TCP_CONNECTION_NONE;
+
+    uint8_t connection = TcpTxStatemachine_find_route(msg->dest_id);
+
+    if (connection != TCP_CONNECTION_NONE && !_is_open(connection))
+        return TCP_CONNECTION_NONE;
+
+    return connection;
+}
+
+    /** @brief True if connection is one of the targets selected by route. */
+static bool _is_target(uint8_t connection, uint8_t route) {
+
+    if (route != TCP_CONNECTION_NONE)
+        return connection == route;
+
+    return _is_open(connection);
+}
+
+/**
+ * @brief Sends one message on one connection that has already reported a
+ * clear TX buffer.
+ *
+ * @details Algorithm:
+ * -# Pack it into the connection's batch when batched is set
+ * -# Otherwise flush the batch so the stream keeps its order, then send the
+ *    header built once by the caller (scatter-gather) or the whole message
+ *    built once in _tx_buffer
+ */
+static bool _send_on_connection(uint8_t connection, openlcb_msg_t *msg, uint32_t body_len, bool batched, uint16_t built_len) {
+
+#if USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN > 0
+    if (batched)
+        return _append_to_batch(connection, msg, body_len, (uint16_t) (TCP_PREAMBLE_LEN + body_len));
+#else
+    (void) body_len;
+    (void) batched;
+#endif
+
+    if (!_flush_batch(connection, &_coalesce_stats.flush_size))
+        return false;
+
+    if (_interface->transmit_raw_tcp_segments)
+        return _transmit_segments(connection, built_len, (const uint8_t *) msg->payload, msg->payload_count);
+
+    return _transmit_buffer(connection, built_len);
+}
+
 // =========================================================================
 // Public API
 // =========================================================================
@@ -52,80 +320,124 @@ static tcp_tx_buffer_t _tx_buffer;
 void TcpTxStatemachine_initialize(const interface_tcp_tx_statemachine_t *interface) {
 
     _interface = interface;
+
+    memset(_tx, 0, sizeof(_tx));
+    memset(_routes, 0, sizeof(_routes));
+    _route_victim = 0;
+    _coalesce_enabled = true;
+    memset(&_coalesce_stats, 0, sizeof(_coalesce_stats));
 }
 
 bool TcpTxStatemachine_send_openlcb_message(openlcb_msg_t *msg) {
 
-    if (!_interface->is_tx_buffer_clear())
+    return TcpTxStatemachine_send_openlcb_message_to(TCP_CONNECTION_NONE, msg);
+}
+
+bool TcpTxStatemachine_send_openlcb_message_to(uint8_t connection, openlcb_msg_t *msg) {
+
+    uint8_t route = (connection == TCP_CONNECTION_NONE) ? _route_message(msg) : connection;
+    uint8_t targets = 0;
+
+    // All or nothing: a refused target would make the caller retry the
+    // message on the connections that already took it
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_CONNECTIONS; i++) {
+
+        if (!_is_target(i, route))
+            continue;
+
+        if (!_interface->is_tx_buffer_clear(i))
+            return false;
+
+        targets++;
+    }
+
+    if (targets == 0)
         return false;
 
     // Calculate message body length:
     //   2 (MTI) + 6 (source NodeID) + [6 (dest NodeID)] + payload
-    uint16_t body_len = TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN;
+    uint32_t body_len = TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN;
 
     if ((msg->mti & MASK_DEST_ADDRESS_PRESENT) == MASK_DEST_ADDRESS_PRESENT)
         body_len += TCP_BODY_NODE_ID_LEN;
 
     body_len += msg->payload_count;
 
-    // Check total fits in TX buffer
-    uint16_t total_len = TCP_PREAMBLE_LEN + body_len;
+    // Coalescing: pack anything that fits; larger messages first flush the
+    // batch so the byte stream keeps its order
+#if USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN > 0
+    bool batched = _coalesce_enabled && TCP_PREAMBLE_LEN + body_len <= USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN;
+#else
+    bool batched = false;
+#endif
 
-    if (total_len > USER_DEFINED_TCP_TX_BUFFER_LEN)
-        return false;
+    // Build the unbatched form once and reuse it for every target
+    uint16_t built_len = 0;
 
-    // Build preamble
-    uint16_t offset = TcpUtilities_encode_preamble(
-            _tx_buffer,
-            TCP_FLAGS_MESSAGE,
-            body_len,
-            _interface->get_local_node_id(),
-            _interface->get_capture_time_ms());
+    if (!batched) {
 
-    // MTI (2 bytes, big-endian)
-    offset += TcpUtilities_encode_uint16(&_tx_buffer[offset], msg->mti);
+        if (_interface->transmit_raw_tcp_segments) {
 
-    // Source Node ID (6 bytes)
-    offset += TcpUtilities_encode_node_id(&_tx_buffer[offset], msg->source_id);
+            // Scatter-gather: header and payload as separate segments, no size limit
+            built_len = _encode_message_header(_tx_header, msg, body_len);
 
-    // Destination Node ID (6 bytes, if addressed)
-    if ((msg->mti & MASK_DEST_ADDRESS_PRESENT) == MASK_DEST_ADDRESS_PRESENT)
-        offset += TcpUtilities_encode_node_id(&_tx_buffer[offset], msg->dest_id);
+        } else {
 
-    // Payload
-    if (msg->payload_count > 0 && msg->payload) {
+            if (TCP_PREAMBLE_LEN + body_len > USER_DEFINED_TCP_TX_BUFFER_LEN)
+                return false;
 
-        memcpy(&_tx_buffer[offset], msg->payload, msg->payload_count);
-        offset += msg->payload_count;
+            built_len = _encode_message_header(_tx_buffer, msg, body_len);
+
+            if (msg->payload_count > 0 && msg->payload) {
+
+                memcpy(&_tx_buffer[built_len], msg->payload, msg->payload_count);
+                built_len += msg->payload_count;
+            }
+        }
     }
 
-    // Transmit
-    bool result = _interface->transmit_raw_tcp_data(_tx_buffer, offset);
+    // Any target that took it counts: one that fails after reporting a clear
+    // buffer is going down and a retry would duplicate it on the others
+    bool sent = false;
 
-    if (result && _interface->on_tx)
-        _interface->on_tx(_tx_buffer, offset);
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_CONNECTIONS; i++) {
 
-    return result;
+        if (_is_target(i, route) && _send_on_connection(i, msg, body_len, batched, built_len))
+            sent = true;
+    }
+
+    return sent;
 }
 
-bool TcpTxStatemachine_send_link_control(uint16_t flags, const uint8_t *body, uint16_t body_len) {
+bool TcpTxStatemachine_send_link_control(uint8_t connection, uint16_t flags, const uint8_t *body, uint16_t body_len) {
+
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return false;
 
     uint16_t total_len = TCP_PREAMBLE_LEN + body_len;
 
-    if (total_len > USER_DEFINED_TCP_TX_BUFFER_LEN)
+    if (!_interface->transmit_raw_tcp_segments && total_len > USER_DEFINED_TCP_TX_BUFFER_LEN)
+        return false;
+
+    if (!_interface->is_tx_buffer_clear(connection))
         return false;
 
-    if (!_interface->is_tx_buffer_clear())
+    // Link control must not overtake messages already batched
+    if (!_flush_batch(connection, &_coalesce_stats.flush_priority))
         return false;
 
     // Build preamble with bit 15 clear (link control)
+    uint8_t *buf = _interface->transmit_raw_tcp_segments ? _tx_header : _tx_buffer;
     uint16_t offset = TcpUtilities_encode_preamble(
-            _tx_buffer,
+            buf,
             flags & (uint16_t) ~TCP_FLAGS_MESSAGE,
             body_len,
             _interface->get_local_node_id(),
             _interface->get_capture_time_ms());
 
+    if (_interface->transmit_raw_tcp_segments)
+        return _transmit_segments(connection, offset, body, body_len);
+
     // Copy body
     if (body_len > 0 && body) {
 
@@ -133,10 +445,113 @@ bool TcpTxStatemachine_send_link_control(uint16_t flags, const uint8_t *body, ui
         offset += body_len;
     }
 
-    bool result = _interface->transmit_raw_tcp_data(_tx_buffer, offset);
+    return _transmit_buffer(connection, offset);
+}
 
-    if (result && _interface->on_tx)
-        _interface->on_tx(_tx_buffer, offset);
+bool TcpTxStatemachine_run(void) {
 
-    return result;
+    bool pending = false;
+
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_MAX_CONNECTIONS; i++) {
+
+        tcp_tx_connection_t *tx = &_tx[i];
+
+        if (tx->batch_len == 0) {
+
+            tx->batch_appended = false;
+            continue;
+        }
+
+        if (!_interface->is_tx_buffer_clear(i)) {
+
+            pending = true;
+            continue;
+        }
+
+        if (!tx->batch_appended)
+            _flush_batch(i, &_coalesce_stats.flush_idle);
+        else if (_interface->get_capture_time_ms() - tx->batch_start_ms >= USER_DEFINED_TCP_TX_COALESCE_DEADLINE_MS)
+            _flush_batch(i, &_coalesce_stats.flush_deadline);
+
+        tx->batch_appended = false;
+
+        if (tx->batch_len > 0)
+            pending = true;
+    }
+
+    return pending;
+}
+
+void TcpTxStatemachine_set_coalescing(bool enable) {
+
+    _coalesce_enabled = enable;
+}
+
+void TcpTxStatemachine_reset(uint8_t connection) {
+
+    if (connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return;
+
+    _tx[connection].batch_len = 0;
+    _tx[connection].batch_count = 0;
+    _tx[connection].batch_appended = false;
+
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_ROUTE_TABLE_DEPTH; i++) {
+
+        if (_routes[i].node_id != 0 && _routes[i].connection == connection)
+            _routes[i].node_id = 0;
+    }
+}
+
+void TcpTxStatemachine_learn_route(uint8_t connection, node_id_t node_id) {
+
+    if (node_id == 0 || connection >= USER_DEFINED_TCP_MAX_CONNECTIONS)
+        return;
+
+    tcp_route_entry_t *empty = NULL;
+
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_ROUTE_TABLE_DEPTH; i++) {
+
+        if (_routes[i].node_id == node_id) {
+
+            _routes[i].connection = connection;
+            return;
+        }
+
+        if (!empty && _routes[i].node_id == 0)
+            empty = &_routes[i];
+    }
+
+    if (!empty) {
+
+        empty = &_routes[_route_victim];
+        _route_victim++;
+
+        if (_route_victim >= USER_DEFINED_TCP_ROUTE_TABLE_DEPTH)
+            _route_victim = 0;
+    }
+
+    empty->node_id = node_id;
+    empty->connection = connection;
+}
+
+uint8_t TcpTxStatemachine_find_route(node_id_t node_id) {
+
+    for (uint8_t i = 0; i < USER_DEFINED_TCP_ROUTE_TABLE_DEPTH; i++) {
+
+        if (_routes[i].node_id == node_id && node_id != 0)
+            return _routes[i].connection;
+    }
+
+    return TCP_CONNECTION_NONE;
+}
+
+const tcp_tx_coalesce_stats_t *TcpTxStatemachine_get_coalesce_stats(void) {
+
+    return &_coalesce_stats;
+}
+
+void TcpTxStatemachine_reset_coalesce_stats(void) {
+
+    memset(&_coalesce_stats, 0, sizeof(_coalesce_stats));
 }
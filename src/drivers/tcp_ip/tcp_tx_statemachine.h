@@ -29,7 +29,22 @@
  *
  * @details Converts @ref openlcb_msg_t messages into TCP/IP wire format
  * (17-byte preamble + message body) and sends them via the user's transmit
- * callback.  No fragmentation is needed since TCP is a byte stream.
+ * callback.  No fragmentation is needed since TCP is a byte stream.  With a
+ * scatter-gather callback the encoded header and the message payload go out
+ * as separate segments, so the payload is never copied.
+ *
+ * With USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN > 0 small messages are packed
+ * into one buffer and sent together.  The batch is flushed when it reaches
+ * USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD, when its oldest message is
+ * USER_DEFINED_TCP_TX_COALESCE_DEADLINE_MS old, when an addressed message (one
+ * a peer is waiting on) or link control is queued, or when a
+ * TcpTxStatemachine_run() pass finds nothing new was queued (main loop idle).
+ *
+ * With several connections (USER_DEFINED_TCP_MAX_CONNECTIONS > 1) each one has
+ * its own batch.  An addressed message goes only to the connection its
+ * destination was last heard on (see TcpTxStatemachine_learn_route()); global
+ * messages and unknown destinations go to every open connection.  The message
+ * is encoded once and the same bytes are handed to each connection.
  *
  * @author Jim Kueneman
  * @date 4 Apr 2026
@@ -52,12 +67,23 @@
  */
 typedef struct {
 
-    /** @brief REQUIRED. Transmit raw bytes over the TCP connection.
-     *  Returns true on success, false if the socket is unavailable. */
-    bool (*transmit_raw_tcp_data)(uint8_t *data, uint16_t len);
+    /** @brief REQUIRED unless transmit_raw_tcp_segments is set. Transmit raw bytes
+     *  over one TCP connection.  Returns true on success, false if the socket is unavailable. */
+    bool (*transmit_raw_tcp_data)(uint8_t connection, uint8_t *data, uint16_t len);
+
+    /** @brief OPTIONAL. Transmit one message as up to TCP_TX_MAX_SEGMENTS pieces
+     *  (e.g. with writev() or lwIP tcp_write() per segment).  When set it is used
+     *  instead of transmit_raw_tcp_data and the payload is read straight from the
+     *  openlcb_msg_t, so nothing is copied into the TX buffer.  May be NULL. */
+    bool (*transmit_raw_tcp_segments)(uint8_t connection, const tcp_tx_segment_t *segments, uint8_t count);
 
-    /** @brief REQUIRED. Check if the TCP TX buffer can accept more data. */
-    bool (*is_tx_buffer_clear)(void);
+    /** @brief REQUIRED. Check if a connection's TCP TX buffer can accept more data. */
+    bool (*is_tx_buffer_clear)(uint8_t connection);
+
+    /** @brief OPTIONAL. Link state of a connection; only logging-in and running
+     *  connections are sent to.  Typical: TcpMainStatemachine_get_link_state.
+     *  May be NULL (every connection is sent to). */
+    tcp_link_state_enum (*get_link_state)(uint8_t connection);
 
     /** @brief REQUIRED. Get the local Node ID for the originating-node field. */
     node_id_t (*get_local_node_id)(void);
@@ -65,7 +91,8 @@ typedef struct {
     /** @brief REQUIRED. Get the monotonic capture time in milliseconds. */
     uint64_t (*get_capture_time_ms)(void);
 
-    /** @brief OPTIONAL. Called after a message is transmitted. May be NULL. */
+    /** @brief OPTIONAL. Called after a message is transmitted (once per segment
+     *  on the scatter-gather path). May be NULL. */
     void (*on_tx)(uint8_t *data, uint16_t len);
 
 } interface_tcp_tx_statemachine_t;
@@ -89,31 +116,121 @@ extern "C" {
      *
      * @details Builds the 17-byte preamble followed by MTI, source Node ID,
      * optional destination Node ID, and payload bytes.  Calls the user's
-     * transmit_raw_tcp_data() callback with the complete byte sequence.
+     * transmit_raw_tcp_data() callback with the complete byte sequence, or
+     * transmit_raw_tcp_segments() with the header and the payload as two
+     * segments.  Only the copying path is limited to USER_DEFINED_TCP_TX_BUFFER_LEN.
      *
      * This function is wired as the transport's send_openlcb_msg() in the
      * OpenLCB main state machine interface when OPENLCB_COMPILE_TCP is defined.
      *
+     * The message is routed by destination: see
+     * TcpTxStatemachine_send_openlcb_message_to().
+     *
      * @param msg  Pointer to the message to send.  The caller retains ownership
      *             of the buffer (this function does not free it).
      *
-     * @return true on success, false if TX buffer is busy or transmit fails.
+     * @return true on success (sent or batched), false if a target TX buffer
+     *         is busy, no connection is open, or transmit fails.
      */
     extern bool TcpTxStatemachine_send_openlcb_message(openlcb_msg_t *msg);
 
+    /**
+     * @brief Transmits an OpenLCB message on one connection, or routes it.
+     *
+     * @details With TCP_CONNECTION_NONE an addressed message whose destination
+     * has a route on an open connection goes there alone; anything else goes to
+     * every open connection.  Sending is all or nothing up front: if any target
+     * reports a busy TX buffer nothing is sent and false is returned, so the
+     * caller's retry cannot duplicate the message.  A target that then fails
+     * inside the driver is skipped (its socket is going down).
+     *
+     * @param connection  Target connection, or TCP_CONNECTION_NONE to route.
+     * @param msg         Message to send; the caller keeps ownership.
+     *
+     * @return true if at least one target sent or batched it.
+     */
+    extern bool TcpTxStatemachine_send_openlcb_message_to(uint8_t connection, openlcb_msg_t *msg);
+
     /**
      * @brief Sends raw bytes with a TCP/IP OpenLCB preamble (link control).
      *
      * @details Used by TcpLinkControl to send link-level messages (status,
      * drop link).  The flags field has bit 15 clear (not an OpenLCB message).
      *
-     * @param flags     16-bit flags (bit 15 = 0 for link control).
-     * @param body      Pointer to the link control body bytes.
-     * @param body_len  Number of body bytes.
+     * @param connection  Connection to send on.
+     * @param flags       16-bit flags (bit 15 = 0 for link control).
+     * @param body        Pointer to the link control body bytes.
+     * @param body_len    Number of body bytes.
      *
      * @return true on success, false if transmit fails.
      */
-    extern bool TcpTxStatemachine_send_link_control(uint16_t flags, const uint8_t *body, uint16_t body_len);
+    extern bool TcpTxStatemachine_send_link_control(uint8_t connection, uint16_t flags, const uint8_t *body, uint16_t body_len);
+
+    /**
+     * @brief Applies the deadline and idle flush rules to every connection's
+     * coalescing batch.
+     *
+     * @details Call once per main-loop pass (TcpMainStatemachine_run() does).
+     * Flushes if no message was queued since the previous call, or if the
+     * oldest batched message has waited USER_DEFINED_TCP_TX_COALESCE_DEADLINE_MS.
+     * Does nothing when coalescing is disabled.
+     *
+     * @return true if messages are still waiting in any batch.
+     */
+    extern bool TcpTxStatemachine_run(void);
+
+    /**
+     * @brief Turns TX coalescing on or off at run time.
+     *
+     * @details On by default whenever USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN > 0.
+     * While off, each message is sent on its own; a batch already pending is
+     * flushed ahead of the next message.
+     *
+     * @param enable  true to pack messages, false to send each immediately.
+     */
+    extern void TcpTxStatemachine_set_coalescing(bool enable);
+
+    /**
+     * @brief Discards a connection's batched, unsent messages and its routes.
+     *
+     * @details Call when the connection drops.  Statistics are kept.
+     *
+     * @param connection  Connection that went down.
+     */
+    extern void TcpTxStatemachine_reset(uint8_t connection);
+
+    /**
+     * @brief Remembers the connection a remote Node ID was heard on.
+     *
+     * @details Wired to the RX state machine, which calls it with the source
+     * of every received message.  The oldest entry is replaced when the table
+     * (USER_DEFINED_TCP_ROUTE_TABLE_DEPTH) is full.
+     *
+     * @param connection  Connection the message arrived on.
+     * @param node_id     Source Node ID of the message.
+     */
+    extern void TcpTxStatemachine_learn_route(uint8_t connection, node_id_t node_id);
+
+    /**
+     * @brief Looks up the connection a remote Node ID was last heard on.
+     *
+     * @param node_id  Remote Node ID.
+     *
+     * @return Connection index, or TCP_CONNECTION_NONE if not known.
+     */
+    extern uint8_t TcpTxStatemachine_find_route(node_id_t node_id);
+
+    /**
+     * @brief Returns the TX coalescing counters.
+     *
+     * @return Pointer to the live @ref tcp_tx_coalesce_stats_t.
+     */
+    extern const tcp_tx_coalesce_stats_t *TcpTxStatemachine_get_coalesce_stats(void);
+
+    /**
+     * @brief Zeroes the TX coalescing counters.
+     */
+    extern void TcpTxStatemachine_reset_coalesce_stats(void);
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,12 @@
  *   - TX buffer busy rejection
  *   - Link control message encoding
  *   - on_tx callback invocation
+ *   - Scatter-gather transmit: header/payload segments, zero-copy payload,
+ *     messages larger than the TX buffer, link control
+ *   - TX coalescing: idle, priority, deadline and size flushes, ordering
+ *     around large messages and link control, reset, stats
+ *   - Connections: global fan-out, routing by learned destination, all-or-
+ *     nothing busy check, per-connection batches, route table replacement
  *
  * Author: Test Suite
  * Date: 2026-04-05
@@ -38,10 +44,25 @@ static bool _transmit_should_fail = false;
 static uint8_t _transmitted_data[1024];
 static uint16_t _transmitted_len = 0;
 static bool _transmit_called = false;
+static uint8_t _transmitted_connection = 0xFF;
+static int _transmit_calls_on[USER_DEFINED_TCP_MAX_CONNECTIONS];
+
+    /** @brief Bit n set: connection n is running.  Default: connection 0 only. */
+static uint32_t _open_mask = 0x01;
+    /** @brief Bit n set: connection n reports a busy TX buffer. */
+static uint32_t _busy_mask = 0;
 
 static node_id_t _local_node_id = 0x050101012200ULL;
 static uint64_t _capture_time = 1000;
 
+static const uint8_t *_segment_data[TCP_TX_MAX_SEGMENTS];
+static uint16_t _segment_len[TCP_TX_MAX_SEGMENTS];
+static uint8_t _segment_count = 0;
+static int _segment_calls = 0;
+static int _transmit_calls = 0;
+static uint8_t _segment_header[TCP_TX_HEADER_LEN];
+static int _on_tx_count = 0;
+
 static uint8_t _on_tx_data[1024];
 static uint16_t _on_tx_len = 0;
 static bool _on_tx_called = false;
@@ -50,8 +71,12 @@ static bool _on_tx_called = false;
 // Mock functions
 // =============================================================================
 
-static bool _mock_transmit(uint8_t *data, uint16_t len)
+static bool _mock_transmit(uint8_t connection, uint8_t *data, uint16_t len)
 {
+    _transmit_calls++;
+    _transmitted_connection = connection;
+    if (connection < USER_DEFINED_TCP_MAX_CONNECTIONS)
+        _transmit_calls_on[connection]++;
     _transmit_called = true;
     _transmitted_len = len;
     if (len <= sizeof(_transmitted_data))
@@ -59,9 +84,14 @@ static bool _mock_transmit(uint8_t *data, uint16_t len)
     return !_transmit_should_fail;
 }
 
-static bool _mock_is_tx_buffer_clear(void)
+static bool _mock_is_tx_buffer_clear(uint8_t connection)
+{
+    return _tx_buffer_clear && !(_busy_mask & (1u << connection));
+}
+
+static tcp_link_state_enum _mock_get_link_state(uint8_t connection)
 {
-    return _tx_buffer_clear;
+    return (_open_mask & (1u << connection)) ? TCP_LINK_STATE_RUNNING : TCP_LINK_STATE_DISCONNECTED;
 }
 
 static node_id_t _mock_get_local_node_id(void)
@@ -74,8 +104,27 @@ static uint64_t _mock_get_capture_time_ms(void)
     return _capture_time;
 }
 
+static bool _mock_transmit_segments(uint8_t connection, const tcp_tx_segment_t *segments, uint8_t count)
+{
+    _transmit_called = true;
+    _transmitted_connection = connection;
+    if (connection < USER_DEFINED_TCP_MAX_CONNECTIONS)
+        _transmit_calls_on[connection]++;
+    _segment_calls++;
+    _segment_count = count;
+    for (uint8_t i = 0; i < count && i < TCP_TX_MAX_SEGMENTS; i++) {
+        _segment_data[i] = segments[i].data;
+        _segment_len[i] = segments[i].len;
+    }
+    // The header lives in module scratch space; capture it during the call
+    if (count > 0 && segments[0].len <= sizeof(_segment_header))
+        memcpy(_segment_header, segments[0].data, segments[0].len);
+    return !_transmit_should_fail;
+}
+
 static void _mock_on_tx(uint8_t *data, uint16_t len)
 {
+    _on_tx_count++;
     _on_tx_called = true;
     _on_tx_len = len;
     if (len <= sizeof(_on_tx_data))
@@ -89,6 +138,7 @@ static void _mock_on_tx(uint8_t *data, uint16_t len)
 static const interface_tcp_tx_statemachine_t _interface = {
     .transmit_raw_tcp_data = &_mock_transmit,
     .is_tx_buffer_clear    = &_mock_is_tx_buffer_clear,
+    .get_link_state        = &_mock_get_link_state,
     .get_local_node_id     = &_mock_get_local_node_id,
     .get_capture_time_ms   = &_mock_get_capture_time_ms,
     .on_tx                 = &_mock_on_tx,
@@ -97,32 +147,64 @@ static const interface_tcp_tx_statemachine_t _interface = {
 static const interface_tcp_tx_statemachine_t _interface_no_on_tx = {
     .transmit_raw_tcp_data = &_mock_transmit,
     .is_tx_buffer_clear    = &_mock_is_tx_buffer_clear,
+    .get_link_state        = &_mock_get_link_state,
     .get_local_node_id     = &_mock_get_local_node_id,
     .get_capture_time_ms   = &_mock_get_capture_time_ms,
     .on_tx                 = NULL,
 };
 
+static const interface_tcp_tx_statemachine_t _interface_segments = {
+    .transmit_raw_tcp_data     = NULL,
+    .transmit_raw_tcp_segments = &_mock_transmit_segments,
+    .is_tx_buffer_clear        = &_mock_is_tx_buffer_clear,
+    .get_link_state            = &_mock_get_link_state,
+    .get_local_node_id         = &_mock_get_local_node_id,
+    .get_capture_time_ms       = &_mock_get_capture_time_ms,
+    .on_tx                     = &_mock_on_tx,
+};
+
 static void reset_mocks(void)
 {
     _tx_buffer_clear = true;
     _transmit_should_fail = false;
     _transmitted_len = 0;
     _transmit_called = false;
+    _transmitted_connection = 0xFF;
+    memset(_transmit_calls_on, 0, sizeof(_transmit_calls_on));
+    _open_mask = 0x01;
+    _busy_mask = 0;
     memset(_transmitted_data, 0, sizeof(_transmitted_data));
 
     _on_tx_called = false;
+    _on_tx_count = 0;
     _on_tx_len = 0;
+    _segment_count = 0;
+    _segment_calls = 0;
+    _transmit_calls = 0;
+    memset(_segment_data, 0, sizeof(_segment_data));
+    memset(_segment_len, 0, sizeof(_segment_len));
+    memset(_segment_header, 0, sizeof(_segment_header));
     memset(_on_tx_data, 0, sizeof(_on_tx_data));
 
     _local_node_id = 0x050101012200ULL;
     _capture_time = 1000;
 }
 
+/**
+ * @brief Initializes the module with coalescing off, so each send reaches
+ * the driver immediately.
+ */
+static void init_direct(const interface_tcp_tx_statemachine_t *interface)
+{
+    TcpTxStatemachine_initialize(interface);
+    TcpTxStatemachine_set_coalescing(false);
+}
+
 static void setup_test(void)
 {
     reset_mocks();
     OpenLcbBufferStore_initialize();
-    TcpTxStatemachine_initialize(&_interface);
+    init_direct(&_interface);
 }
 
 // =============================================================================
@@ -300,7 +382,7 @@ TEST(TCP_TxStatemachine, send_link_control_status_request)
     uint8_t body[2];
     TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
 
-    bool result = TcpTxStatemachine_send_link_control(0x0000, body, 2);
+    bool result = TcpTxStatemachine_send_link_control(0, 0x0000, body, 2);
 
     EXPECT_TRUE(result);
     EXPECT_TRUE(_transmit_called);
@@ -324,7 +406,7 @@ TEST(TCP_TxStatemachine, send_link_control_busy_returns_false)
 
     uint8_t body[2] = {0x00, 0x00};
 
-    bool result = TcpTxStatemachine_send_link_control(0x0000, body, 2);
+    bool result = TcpTxStatemachine_send_link_control(0, 0x0000, body, 2);
 
     EXPECT_FALSE(result);
     EXPECT_FALSE(_transmit_called);
@@ -357,7 +439,7 @@ TEST(TCP_TxStatemachine, send_link_control_overflow_returns_false)
 {
     setup_test();
 
-    bool result = TcpTxStatemachine_send_link_control(0x0000, NULL, 1008);
+    bool result = TcpTxStatemachine_send_link_control(0, 0x0000, NULL, 1008);
 
     EXPECT_FALSE(result);
     EXPECT_FALSE(_transmit_called);
@@ -392,7 +474,7 @@ TEST(TCP_TxStatemachine, send_link_control_null_body_with_nonzero_len_skips_copy
 {
     setup_test();
 
-    bool result = TcpTxStatemachine_send_link_control(0x0000, NULL, 2);
+    bool result = TcpTxStatemachine_send_link_control(0, 0x0000, NULL, 2);
 
     EXPECT_TRUE(result);
     EXPECT_TRUE(_transmit_called);
@@ -403,7 +485,7 @@ TEST(TCP_TxStatemachine, send_link_control_empty_body)
 {
     setup_test();
 
-    bool result = TcpTxStatemachine_send_link_control(0x0000, NULL, 0);
+    bool result = TcpTxStatemachine_send_link_control(0, 0x0000, NULL, 0);
 
     EXPECT_TRUE(result);
     EXPECT_TRUE(_transmit_called);
@@ -442,7 +524,7 @@ TEST(TCP_TxStatemachine, send_link_control_transmit_failure_skips_on_tx)
 
     uint8_t body[2] = {0x00, 0x00};
 
-    bool result = TcpTxStatemachine_send_link_control(0x0000, body, 2);
+    bool result = TcpTxStatemachine_send_link_control(0, 0x0000, body, 2);
 
     EXPECT_FALSE(result);
     EXPECT_TRUE(_transmit_called);
@@ -457,7 +539,7 @@ TEST(TCP_TxStatemachine, send_message_on_tx_null_does_not_crash)
 {
     reset_mocks();
     OpenLcbBufferStore_initialize();
-    TcpTxStatemachine_initialize(&_interface_no_on_tx);
+    init_direct(&_interface_no_on_tx);
 
     openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
     ASSERT_NE(msg, nullptr);
@@ -479,13 +561,566 @@ TEST(TCP_TxStatemachine, send_link_control_on_tx_null_does_not_crash)
 {
     reset_mocks();
     OpenLcbBufferStore_initialize();
-    TcpTxStatemachine_initialize(&_interface_no_on_tx);
+    init_direct(&_interface_no_on_tx);
 
     uint8_t body[2] = {0x00, 0x00};
 
-    bool result = TcpTxStatemachine_send_link_control(0x0000, body, 2);
+    bool result = TcpTxStatemachine_send_link_control(0, 0x0000, body, 2);
 
     EXPECT_TRUE(result);
     EXPECT_TRUE(_transmit_called);
     EXPECT_FALSE(_on_tx_called);
 }
+
+// =============================================================================
+// Scatter-gather transmit
+// =============================================================================
+
+TEST(TCP_TxStatemachine, segments_header_and_payload_without_copy)
+{
+    setup_test();
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+
+    msg->mti = 0x0100;
+    msg->source_id = 0x010203040506ULL;
+    uint8_t payload_data[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+    memcpy(msg->payload, payload_data, 6);
+    msg->payload_count = 6;
+
+    // Reference bytes from the copying path
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+    uint8_t reference[64];
+    uint16_t reference_len = _transmitted_len;
+    memcpy(reference, _transmitted_data, reference_len);
+
+    reset_mocks();
+    init_direct(&_interface_segments);
+
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+
+    ASSERT_EQ(_segment_count, 2);
+    EXPECT_EQ(_segment_len[0], TCP_PREAMBLE_LEN + TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN);
+    EXPECT_EQ(memcmp(_segment_header, reference, _segment_len[0]), 0);
+
+    // Payload segment points straight at the message buffer
+    EXPECT_EQ(_segment_data[1], (const uint8_t *) msg->payload);
+    EXPECT_EQ(_segment_len[1], 6);
+    EXPECT_EQ(_segment_len[0] + _segment_len[1], reference_len);
+
+    // on_tx sees each segment
+    EXPECT_EQ(_on_tx_count, 2);
+    EXPECT_EQ(_on_tx_len, 6);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, segments_addressed_no_payload_single_segment)
+{
+    setup_test();
+    init_direct(&_interface_segments);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+
+    msg->mti = 0x0488;  // Verify Node ID Addressed
+    msg->source_id = 0x010203040506ULL;
+    msg->dest_id = 0x0A0B0C0D0E0FULL;
+    msg->payload_count = 0;
+
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+
+    ASSERT_EQ(_segment_count, 1);
+    EXPECT_EQ(_segment_len[0], TCP_TX_HEADER_LEN);
+    EXPECT_EQ(TcpUtilities_decode_length(_segment_header), 12u + 14u);
+    EXPECT_EQ(TcpUtilities_decode_node_id(&_segment_header[TCP_PREAMBLE_LEN + TCP_BODY_OFFSET_DEST_NODE_ID]),
+              0x0A0B0C0D0E0FULL);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, segments_payload_larger_than_tx_buffer)
+{
+    setup_test();
+    init_direct(&_interface_segments);
+
+    static uint8_t big_payload[USER_DEFINED_TCP_TX_BUFFER_LEN + 500];
+    for (size_t i = 0; i < sizeof(big_payload); i++)
+        big_payload[i] = (uint8_t) i;
+
+    openlcb_msg_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.mti = 0x1F88;  // Stream Data Send (addressed)
+    msg.source_id = 0x010203040506ULL;
+    msg.dest_id = 0x0A0B0C0D0E0FULL;
+    msg.payload = (openlcb_payload_t *) big_payload;
+    msg.payload_count = sizeof(big_payload);
+
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(&msg));
+
+    ASSERT_EQ(_segment_count, 2);
+    EXPECT_EQ(_segment_data[1], big_payload);
+    EXPECT_EQ(_segment_len[1], sizeof(big_payload));
+    EXPECT_EQ(TcpUtilities_decode_length(_segment_header), 12u + 14u + sizeof(big_payload));
+
+    // The copying path still rejects it
+    init_direct(&_interface);
+    EXPECT_FALSE(TcpTxStatemachine_send_openlcb_message(&msg));
+}
+
+TEST(TCP_TxStatemachine, segments_busy_and_failure)
+{
+    setup_test();
+    init_direct(&_interface_segments);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    msg->mti = 0x0490;
+    msg->source_id = 0x010203040506ULL;
+    msg->payload_count = 0;
+
+    _tx_buffer_clear = false;
+    EXPECT_FALSE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_FALSE(_transmit_called);
+
+    _tx_buffer_clear = true;
+    _transmit_should_fail = true;
+    EXPECT_FALSE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_TRUE(_transmit_called);
+    EXPECT_FALSE(_on_tx_called);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, segments_link_control)
+{
+    setup_test();
+    init_direct(&_interface_segments);
+
+    uint8_t body[2];
+    TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
+
+    EXPECT_TRUE(TcpTxStatemachine_send_link_control(0, TCP_FLAGS_MESSAGE, body, 2));
+
+    ASSERT_EQ(_segment_count, 2);
+    EXPECT_EQ(_segment_len[0], TCP_PREAMBLE_LEN);
+    EXPECT_EQ(_segment_data[1], body);
+    EXPECT_EQ(_segment_len[1], 2);
+
+    // Bit 15 forced clear for link control
+    EXPECT_FALSE(TcpUtilities_is_openlcb_message(TcpUtilities_decode_flags(_segment_header)));
+    EXPECT_EQ(TcpUtilities_decode_length(_segment_header), 12u + 2u);
+}
+
+// =============================================================================
+// TX coalescing
+// =============================================================================
+
+static void init_coalescing(const interface_tcp_tx_statemachine_t *interface)
+{
+    TcpTxStatemachine_initialize(interface);
+    TcpTxStatemachine_reset_coalesce_stats();
+}
+
+static void load_unaddressed(openlcb_msg_t *msg, uint16_t mti)
+{
+    msg->mti = mti;
+    msg->source_id = 0x010203040506ULL;
+    msg->dest_id = 0;
+    msg->payload_count = 0;
+}
+
+TEST(TCP_TxStatemachine, coalesce_packs_until_idle_run)
+{
+    setup_test();
+    init_coalescing(&_interface);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+
+    for (int i = 0; i < 3; i++) {
+        load_unaddressed(msg, (uint16_t) (0x0914 + i));
+        EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+    }
+    EXPECT_FALSE(_transmit_called);
+
+    // First run: messages were queued since the last pass, keep packing
+    EXPECT_TRUE(TcpTxStatemachine_run());
+    EXPECT_FALSE(_transmit_called);
+
+    // Second run: nothing new, the main loop is idle — flush
+    EXPECT_FALSE(TcpTxStatemachine_run());
+    EXPECT_EQ(_transmit_calls, 1);
+    ASSERT_EQ(_transmitted_len, 75);
+
+    // Three back-to-back messages, in order
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(TcpUtilities_decode_length(&_transmitted_data[i * 25]), 12u + 8u);
+        EXPECT_EQ(TcpUtilities_decode_mti(&_transmitted_data[i * 25 + TCP_PREAMBLE_LEN]), 0x0914 + i);
+    }
+
+    const tcp_tx_coalesce_stats_t *stats = TcpTxStatemachine_get_coalesce_stats();
+    EXPECT_EQ(stats->messages_coalesced, 3u);
+    EXPECT_EQ(stats->batches_sent, 1u);
+    EXPECT_EQ(stats->segments_saved, 2u);
+    EXPECT_EQ(stats->flush_idle, 1u);
+    EXPECT_TRUE(_on_tx_called);
+    EXPECT_EQ(_on_tx_len, 75);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, coalesce_flushes_on_addressed_message)
+{
+    setup_test();
+    init_coalescing(&_interface);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+
+    load_unaddressed(msg, 0x0914);
+    TcpTxStatemachine_send_openlcb_message(msg);
+    TcpTxStatemachine_send_openlcb_message(msg);
+    EXPECT_FALSE(_transmit_called);
+
+    msg->mti = 0x0488;  // Verify Node ID Addressed — a peer is waiting
+    msg->dest_id = 0x0A0B0C0D0E0FULL;
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+
+    EXPECT_EQ(_transmit_calls, 1);
+    EXPECT_EQ(_transmitted_len, 25 + 25 + 31);
+    EXPECT_EQ(TcpUtilities_decode_mti(&_transmitted_data[50 + TCP_PREAMBLE_LEN]), 0x0488);
+    EXPECT_EQ(TcpTxStatemachine_get_coalesce_stats()->flush_priority, 1u);
+
+    // Nothing left to flush
+    EXPECT_FALSE(TcpTxStatemachine_run());
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, coalesce_flushes_on_deadline)
+{
+    setup_test();
+    init_coalescing(&_interface);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0914);
+
+    // A steady trickle keeps the loop busy, so only the deadline flushes
+    TcpTxStatemachine_send_openlcb_message(msg);
+    TcpTxStatemachine_run();
+    _capture_time += USER_DEFINED_TCP_TX_COALESCE_DEADLINE_MS - 1;
+    TcpTxStatemachine_send_openlcb_message(msg);
+    TcpTxStatemachine_run();
+    EXPECT_FALSE(_transmit_called);
+
+    _capture_time += 1;
+    TcpTxStatemachine_send_openlcb_message(msg);
+    TcpTxStatemachine_run();
+
+    EXPECT_EQ(_transmit_calls, 1);
+    EXPECT_EQ(_transmitted_len, 75);
+    EXPECT_EQ(TcpTxStatemachine_get_coalesce_stats()->flush_deadline, 1u);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, coalesce_flushes_when_full)
+{
+    setup_test();
+    init_coalescing(&_interface);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0914);
+
+    int per_batch = USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN / 25;
+
+    for (int i = 0; i < per_batch; i++)
+        TcpTxStatemachine_send_openlcb_message(msg);
+
+    if (per_batch * 25 < USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD) {
+
+        EXPECT_FALSE(_transmit_called);
+
+    }
+
+    // One more does not fit behind the batch: flush, then start a new one
+    TcpTxStatemachine_send_openlcb_message(msg);
+
+    EXPECT_EQ(_transmit_calls, 1);
+    EXPECT_EQ(_transmitted_len, per_batch * 25);
+
+    const tcp_tx_coalesce_stats_t *stats = TcpTxStatemachine_get_coalesce_stats();
+    EXPECT_EQ(stats->flush_size, 1u);
+    EXPECT_EQ(stats->segments_saved, (uint32_t) (per_batch - 1));
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, coalesce_large_message_flushes_batch_first)
+{
+    setup_test();
+    init_coalescing(&_interface_segments);
+
+    openlcb_msg_t *small = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(small, nullptr);
+    load_unaddressed(small, 0x0914);
+    TcpTxStatemachine_send_openlcb_message(small);
+    EXPECT_EQ(_segment_calls, 0);
+
+    static uint8_t big_payload[USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN];
+    openlcb_msg_t big;
+    memset(&big, 0, sizeof(big));
+    big.mti = 0x1F88;
+    big.source_id = 0x010203040506ULL;
+    big.dest_id = 0x0A0B0C0D0E0FULL;
+    big.payload = (openlcb_payload_t *) big_payload;
+    big.payload_count = sizeof(big_payload);
+
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(&big));
+
+    // Batch (one segment) went first, then the large message (header + payload)
+    EXPECT_EQ(_segment_calls, 2);
+    EXPECT_EQ(_segment_count, 2);
+    EXPECT_EQ(_segment_data[1], big_payload);
+
+    OpenLcbBufferStore_free_buffer(small);
+}
+
+TEST(TCP_TxStatemachine, coalesce_link_control_flushes_batch_first)
+{
+    setup_test();
+    init_coalescing(&_interface);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0914);
+    TcpTxStatemachine_send_openlcb_message(msg);
+
+    uint8_t body[2];
+    TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REPLY);
+    EXPECT_TRUE(TcpTxStatemachine_send_link_control(0, 0, body, 2));
+
+    EXPECT_EQ(_transmit_calls, 2);
+    EXPECT_FALSE(TcpUtilities_is_openlcb_message(TcpUtilities_decode_flags(_transmitted_data)));
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, coalesce_failed_flush_is_retried)
+{
+    setup_test();
+    init_coalescing(&_interface);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0914);
+    TcpTxStatemachine_send_openlcb_message(msg);
+    TcpTxStatemachine_run();
+
+    _transmit_should_fail = true;
+    EXPECT_TRUE(TcpTxStatemachine_run());
+    EXPECT_EQ(TcpTxStatemachine_get_coalesce_stats()->batches_sent, 0u);
+
+    _transmit_should_fail = false;
+    EXPECT_FALSE(TcpTxStatemachine_run());
+    EXPECT_EQ(_transmitted_len, 25);
+    EXPECT_EQ(TcpTxStatemachine_get_coalesce_stats()->batches_sent, 1u);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, coalesce_reset_discards_and_disable_flushes)
+{
+    setup_test();
+    init_coalescing(&_interface);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0914);
+
+    TcpTxStatemachine_send_openlcb_message(msg);
+    TcpTxStatemachine_reset(0);
+    EXPECT_FALSE(TcpTxStatemachine_run());
+    EXPECT_FALSE(_transmit_called);
+
+    // Turning coalescing off sends the pending batch ahead of the next message
+    TcpTxStatemachine_send_openlcb_message(msg);
+    TcpTxStatemachine_set_coalescing(false);
+    TcpTxStatemachine_send_openlcb_message(msg);
+
+    EXPECT_EQ(_transmit_calls, 2);
+    EXPECT_EQ(TcpTxStatemachine_get_coalesce_stats()->batches_sent, 1u);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+// =============================================================================
+// Multiple connections
+// =============================================================================
+
+TEST(TCP_TxStatemachine, global_message_fans_out_to_open_connections)
+{
+    setup_test();
+    _open_mask = 0x03;
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0914);
+
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_EQ(_transmit_calls_on[0], 1);
+    EXPECT_EQ(_transmit_calls_on[1], 1);
+    EXPECT_EQ(_on_tx_count, 2);
+
+    // A closed connection is left out
+    _open_mask = 0x02;
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_EQ(_transmit_calls_on[0], 1);
+    EXPECT_EQ(_transmit_calls_on[1], 2);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, addressed_message_follows_learned_route)
+{
+    setup_test();
+    _open_mask = 0x03;
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    msg->mti = 0x0488;
+    msg->source_id = 0x010203040506ULL;
+    msg->dest_id = 0x0A0B0C0D0E0FULL;
+    msg->payload_count = 0;
+
+    // Unknown destination: every open connection
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_EQ(_transmit_calls_on[0], 1);
+    EXPECT_EQ(_transmit_calls_on[1], 1);
+
+    TcpTxStatemachine_learn_route(1, 0x0A0B0C0D0E0FULL);
+    EXPECT_EQ(TcpTxStatemachine_find_route(0x0A0B0C0D0E0FULL), 1);
+
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_EQ(_transmit_calls_on[0], 1);
+    EXPECT_EQ(_transmit_calls_on[1], 2);
+    EXPECT_EQ(_transmitted_connection, 1);
+
+    // Route to a connection that has closed: fall back to fan-out
+    _open_mask = 0x01;
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_EQ(_transmit_calls_on[0], 2);
+    EXPECT_EQ(_transmit_calls_on[1], 2);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, busy_target_blocks_whole_fan_out)
+{
+    setup_test();
+    _open_mask = 0x03;
+    _busy_mask = 0x02;
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0914);
+
+    // Nothing sent, so the caller's retry cannot duplicate it on connection 0
+    EXPECT_FALSE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_FALSE(_transmit_called);
+
+    _busy_mask = 0;
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_EQ(_transmit_calls, 2);
+
+    // No open connection at all
+    _open_mask = 0;
+    EXPECT_FALSE(TcpTxStatemachine_send_openlcb_message(msg));
+    EXPECT_EQ(_transmit_calls, 2);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, send_to_one_connection)
+{
+    setup_test();
+    _open_mask = 0x01;
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0490);
+
+    // Login sends on a connection that is not yet counted as open
+    EXPECT_TRUE(TcpTxStatemachine_send_openlcb_message_to(1, msg));
+    EXPECT_EQ(_transmit_calls, 1);
+    EXPECT_EQ(_transmitted_connection, 1);
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, coalesce_batches_are_per_connection)
+{
+    setup_test();
+    init_coalescing(&_interface);
+    _open_mask = 0x03;
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    load_unaddressed(msg, 0x0914);
+
+    TcpTxStatemachine_send_openlcb_message(msg);
+    TcpTxStatemachine_send_openlcb_message_to(1, msg);
+    EXPECT_FALSE(_transmit_called);
+
+    // Connection 1 drops: its batch and routes go, connection 0 keeps its batch
+    TcpTxStatemachine_learn_route(1, 0x0A0B0C0D0E0FULL);
+    TcpTxStatemachine_reset(1);
+    EXPECT_EQ(TcpTxStatemachine_find_route(0x0A0B0C0D0E0FULL), TCP_CONNECTION_NONE);
+
+    TcpTxStatemachine_run();
+    EXPECT_FALSE(TcpTxStatemachine_run());
+
+    EXPECT_EQ(_transmit_calls_on[0], 1);
+    EXPECT_EQ(_transmit_calls_on[1], 0);
+    EXPECT_EQ(_transmitted_len, 25);
+
+    // Link control on one connection flushes only that connection's batch
+    TcpTxStatemachine_send_openlcb_message(msg);
+    uint8_t body[2];
+    TcpUtilities_encode_uint16(body, TCP_LINK_CONTROL_STATUS_REQUEST);
+    TcpTxStatemachine_send_link_control(1, 0, body, 2);
+
+    EXPECT_EQ(_transmit_calls_on[0], 1);
+    EXPECT_EQ(_transmit_calls_on[1], 2);
+    EXPECT_TRUE(TcpTxStatemachine_run());
+
+    OpenLcbBufferStore_free_buffer(msg);
+}
+
+TEST(TCP_TxStatemachine, route_table_replaces_oldest_when_full)
+{
+    setup_test();
+
+    for (int i = 0; i < USER_DEFINED_TCP_ROUTE_TABLE_DEPTH; i++)
+        TcpTxStatemachine_learn_route(1, (node_id_t) (0x100 + i));
+
+    // Relearning moves an existing entry instead of adding one
+    TcpTxStatemachine_learn_route(0, 0x100 + 1);
+    EXPECT_EQ(TcpTxStatemachine_find_route(0x100 + 1), 0);
+
+    TcpTxStatemachine_learn_route(0, 0x999);
+
+    EXPECT_EQ(TcpTxStatemachine_find_route(0x100), TCP_CONNECTION_NONE);
+    EXPECT_EQ(TcpTxStatemachine_find_route(0x999), 0);
+    EXPECT_EQ(TcpTxStatemachine_find_route(0x100 + USER_DEFINED_TCP_ROUTE_TABLE_DEPTH - 1), 1);
+
+    // Node ID 0 and out-of-range connections are never learned
+    TcpTxStatemachine_learn_route(0, 0);
+    TcpTxStatemachine_learn_route(USER_DEFINED_TCP_MAX_CONNECTIONS, 0x777);
+    EXPECT_EQ(TcpTxStatemachine_find_route(0), TCP_CONNECTION_NONE);
+    EXPECT_EQ(TcpTxStatemachine_find_route(0x777), TCP_CONNECTION_NONE);
+}
@@ -97,16 +97,138 @@ extern "C" {
 #endif
 
     /**
-     * @brief Maximum concurrent multi-part message reassemblies.
+     * @brief Bytes in the TX coalescing buffer; 0 disables coalescing.
      *
-     * @details Override at compile time: -D USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES=4
+     * @details When enabled, consecutive messages that fit are packed into one
+     * buffer and handed to the driver as a single send (one TCP segment) instead
+     * of one send per message.  1460 (one Ethernet MSS) is a good choice.
+     * Override at compile time: -D USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN=1460
+     */
+#ifndef USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN
+#define USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN        0
+#endif
+
+#if (USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN != 0) && (USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN < 25)
+#error "USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN must be 0 (disabled) or >= 25 (17 preamble + 2 MTI + 6 source)"
+#endif
+
+    /**
+     * @brief Coalescing buffer fill level that triggers a flush.
+     *
+     * @details Defaults to the full buffer; a smaller value trades a little
+     * packing for earlier sends.
+     */
+#ifndef USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD
+#define USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD   USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN
+#endif
+
+#if USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD > USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN
+#error "USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD must be <= USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN"
+#endif
+
+    /**
+     * @brief Longest time in milliseconds a message may wait in the coalescing buffer.
+     *
+     * @details Measured with get_capture_time_ms() from the first message in the batch.
+     */
+#ifndef USER_DEFINED_TCP_TX_COALESCE_DEADLINE_MS
+#define USER_DEFINED_TCP_TX_COALESCE_DEADLINE_MS       10
+#endif
+
+    /** @brief Array length for the coalescing buffer (at least 1 when disabled). */
+#if USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN > 0
+#define LEN_TCP_TX_COALESCE_BUFFER                     USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN
+#else
+#define LEN_TCP_TX_COALESCE_BUFFER                     1
+#endif
+
+    /**
+     * @brief Number of concurrent TCP connections the transport serves.
+     *
+     * @details Each connection has its own link state, login sequence, RX ring,
+     * multi-part table and coalescing batch.  1 is a node talking to one hub;
+     * larger values let the node accept JMRI and configuration-tool clients
+     * directly.  Override at compile time: -D USER_DEFINED_TCP_MAX_CONNECTIONS=4
+     */
+#ifndef USER_DEFINED_TCP_MAX_CONNECTIONS
+#define USER_DEFINED_TCP_MAX_CONNECTIONS               1
+#endif
+
+#if (USER_DEFINED_TCP_MAX_CONNECTIONS < 1) || (USER_DEFINED_TCP_MAX_CONNECTIONS > 254)
+#error "USER_DEFINED_TCP_MAX_CONNECTIONS must be 1..254"
+#endif
+
+    /**
+     * @brief Remote Node IDs remembered with the connection they were last heard on.
+     *
+     * @details Addressed messages to a remembered node go out on that connection
+     * only; everything else is sent on every open connection.  When the table is
+     * full the oldest entry is replaced.
+     */
+#ifndef USER_DEFINED_TCP_ROUTE_TABLE_DEPTH
+#define USER_DEFINED_TCP_ROUTE_TABLE_DEPTH             16
+#endif
+
+#if USER_DEFINED_TCP_ROUTE_TABLE_DEPTH < 1
+#error "USER_DEFINED_TCP_ROUTE_TABLE_DEPTH must be >= 1"
+#endif
+
+    /**
+     * @brief Maximum concurrent multi-part message reassemblies, shared by all
+     * connections.
+     *
+     * @details An entry holds only the message header; payload bytes live in
+     * the shared arena, so entries are cheap.
+     * Override at compile time: -D USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES=64
      */
 #ifndef USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES
 #define USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES      2
 #endif
 
-#if USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES < 1
-#error "USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES must be >= 1"
+#if (USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES < 1) || (USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES > 0xFFFE)
+#error "USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES must be 1..65534"
+#endif
+
+    /**
+     * @brief Hash buckets indexing the multi-part table by originating Node ID.
+     *
+     * @details Must be a power of two.  About one bucket per assembly keeps
+     * lookups to a single compare.
+     */
+#ifndef USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS
+#define USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS        8
+#endif
+
+#if (USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS < 1) || \
+    ((USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS & (USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS - 1)) != 0)
+#error "USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS must be a power of two"
+#endif
+
+    /**
+     * @brief Blocks of TCP_MULTIPART_ARENA_BLOCK_LEN bytes in the payload arena
+     * shared by every multi-part reassembly.
+     *
+     * @details An assembly takes blocks as its payload grows and returns them
+     * when it completes, times out or its connection resets.
+     */
+#ifndef USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS
+#define USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS        16
+#endif
+
+#if (USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS < 1) || (USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS > 0xFFFE)
+#error "USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS must be 1..65534"
+#endif
+
+    /**
+     * @brief 100 ms ticks a multi-part reassembly may wait for its next part
+     * before it is dropped and its arena blocks reclaimed.
+     */
+#ifndef USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS
+#define USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS       30
+#endif
+
+#if (USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS < 1) || (USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS > 254)
+#error "USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS must be 1..254"
 #endif
 
     // =========================================================================
@@ -116,6 +238,9 @@ extern "C" {
     /** @brief Total preamble length: 2 flags + 3 length + 6 originating NodeID + 6 capture time. */
 #define TCP_PREAMBLE_LEN                               17
 
+    /** @brief Connection index meaning "no connection" (unrouted or not found). */
+#define TCP_CONNECTION_NONE                            0xFF
+
     /** @brief Byte offset of the flags field in the preamble. */
 #define TCP_PREAMBLE_OFFSET_FLAGS                      0
 
@@ -224,7 +349,8 @@ extern "C" {
      * @typedef tcp_statemachine_info_t
      * @brief Context block passed through the TCP state machine on every iteration.
      *
-     * @details Carries the current node pointer and control flags.
+     * @details Carries the current node pointer and control flags.  There is
+     * one per connection; connection identifies which.
      * Analogous to @ref can_statemachine_info_t for the CAN driver.
      *
      * @see tcp_main_statemachine.h
@@ -235,32 +361,61 @@ extern "C" {
         tcp_login_state_enum login_state;    /**< @brief Current login state for this node. */
         tcp_link_state_enum link_state;      /**< @brief Current link state. */
         uint8_t current_tick;                /**< @brief Snapshot of the global 100ms tick. */
+        uint8_t connection;                  /**< @brief Index of the connection this block belongs to. */
         uint8_t pending_status_reply : 1;    /**< @brief Status Reply needs retry. */
         uint8_t pending_drop_reply : 1;      /**< @brief Drop Link Reply needs retry. */
     } tcp_statemachine_info_t;
 
     // =========================================================================
-    // Multi-part Message Accumulation Entry
+    // Multi-part Message Accumulation
     // =========================================================================
 
+    /** @brief Bytes in one block of the multi-part payload arena. */
+#define TCP_MULTIPART_ARENA_BLOCK_LEN 32
+
+    /** @brief Index value meaning "no entry" / "no block" in the multi-part table. */
+#define TCP_MULTIPART_INDEX_NONE 0xFFFF
+
     /**
      * @typedef tcp_multipart_entry_t
-     * @brief One slot in the multi-part message reassembly table.
+     * @brief One multi-part message being reassembled.
      *
-     * @details Keyed by originating Node ID from the preamble.  Accumulates
-     * payload bytes across first/middle/last parts until a complete OpenLCB
-     * message can be forwarded to the protocol layer.
+     * @details Keyed by connection and originating Node ID from the preamble.
+     * Holds the header of the first part; payload bytes are chained through
+     * the arena from first_block to last_block.  Entries are linked into a
+     * hash bucket (or the free list) through hash_next and, while in use,
+     * into an oldest-first activity list through age_prev/age_next.
      */
     typedef struct tcp_multipart_entry_struct {
-        node_id_t originating_node_id;   /**< @brief Key: originating Node ID from preamble. 0 = unused. */
-        openlcb_msg_t *openlcb_msg;      /**< @brief Allocated message buffer being assembled. */
+        node_id_t originating_node_id;   /**< @brief Key: originating Node ID from preamble. */
+        node_id_t source_id;             /**< @brief Source Node ID from the first part. */
+        node_id_t dest_id;               /**< @brief Destination Node ID from the first part (0 if unaddressed). */
+        uint16_t mti;                    /**< @brief MTI from the first part. */
+        uint16_t payload_count;          /**< @brief Payload bytes accumulated so far. */
+        uint16_t first_block;            /**< @brief First arena block, or TCP_MULTIPART_INDEX_NONE. */
+        uint16_t last_block;             /**< @brief Arena block being filled, or TCP_MULTIPART_INDEX_NONE. */
+        uint16_t hash_next;              /**< @brief Next entry in the bucket or free list. */
+        uint16_t age_prev;               /**< @brief Entry that saw a part less recently. */
+        uint16_t age_next;               /**< @brief Entry that saw a part more recently. */
+        uint8_t connection;              /**< @brief Key: connection the parts arrive on. */
+        uint8_t last_tick;               /**< @brief 100 ms tick the latest part arrived. */
     } tcp_multipart_entry_t;
 
     /**
      * @typedef tcp_multipart_table_t
-     * @brief Table of all multi-part reassembly slots.
+     * @brief Multi-part reassemblies of every connection with their hash index
+     * and shared payload arena.
      */
-    typedef tcp_multipart_entry_t tcp_multipart_table_t[USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES];
+    typedef struct tcp_multipart_table_struct {
+        tcp_multipart_entry_t entry[USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES];       /**< @brief Entry pool. */
+        uint16_t bucket[USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS];                     /**< @brief First entry of each hash chain. */
+        uint16_t free_entry;                                                          /**< @brief First unused entry. */
+        uint16_t oldest;                                                              /**< @brief Entry with the oldest latest part. */
+        uint16_t newest;                                                              /**< @brief Entry with the newest latest part. */
+        uint8_t block[USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS][TCP_MULTIPART_ARENA_BLOCK_LEN]; /**< @brief Payload arena. */
+        uint16_t block_next[USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS];                 /**< @brief Next block of an assembly or the free list. */
+        uint16_t free_block;                                                          /**< @brief First unused arena block. */
+    } tcp_multipart_table_t;
 
     // =========================================================================
     // RX Accumulation Buffer Type
@@ -272,6 +427,93 @@ extern "C" {
      */
     typedef uint8_t tcp_rx_accumulation_buffer_t[USER_DEFINED_TCP_RX_ACCUMULATION_BUFFER_LEN];
 
+    /**
+     * @typedef tcp_rx_connection_t
+     * @brief Receive state of one connection.
+     *
+     * @details The unparsed bytes start at head and wrap at the end of buffer.
+     */
+    typedef struct tcp_rx_connection_struct {
+        tcp_rx_accumulation_buffer_t buffer;     /**< @brief Ring of received bytes. */
+        uint16_t head;                           /**< @brief Ring index of the first unparsed byte. */
+        uint16_t count;                          /**< @brief Unparsed bytes in the ring. */
+        uint32_t discard;                        /**< @brief Bytes still to skip of a message too large for the ring. */
+    } tcp_rx_connection_t;
+
+    // =========================================================================
+    // TX Coalescing
+    // =========================================================================
+
+    /**
+     * @typedef tcp_tx_coalesce_buffer_t
+     * @brief Static byte buffer packing consecutive outgoing messages.
+     */
+    typedef uint8_t tcp_tx_coalesce_buffer_t[LEN_TCP_TX_COALESCE_BUFFER];
+
+    /**
+     * @typedef tcp_tx_coalesce_stats_t
+     * @brief Counters describing how well the TX coalescing stage is packing.
+     *
+     * @details segments_saved is messages_coalesced - batches_sent: the number
+     * of driver sends (and usually TCP segments) that batching avoided.
+     */
+    typedef struct tcp_tx_coalesce_stats_struct {
+        uint32_t messages_coalesced;     /**< @brief Messages that went out inside a batch. */
+        uint32_t batches_sent;           /**< @brief Batches handed to the driver. */
+        uint32_t segments_saved;         /**< @brief Driver sends avoided by batching. */
+        uint32_t flush_size;             /**< @brief Flushes because the batch reached the threshold or was full. */
+        uint32_t flush_deadline;         /**< @brief Flushes because the oldest message hit the deadline. */
+        uint32_t flush_priority;         /**< @brief Flushes because an addressed (someone-is-waiting) message was queued. */
+        uint32_t flush_idle;             /**< @brief Flushes because no message was queued between two run calls. */
+    } tcp_tx_coalesce_stats_t;
+
+    /**
+     * @typedef tcp_tx_connection_t
+     * @brief Transmit state of one connection: its coalescing batch.
+     */
+    typedef struct tcp_tx_connection_struct {
+        tcp_tx_coalesce_buffer_t batch;  /**< @brief Messages packed back to back, waiting for a flush. */
+        uint16_t batch_len;              /**< @brief Bytes in the batch. */
+        uint16_t batch_count;            /**< @brief Messages in the batch. */
+        uint64_t batch_start_ms;         /**< @brief Capture time of the first message in the batch. */
+        bool batch_appended;             /**< @brief A message was added since the last TcpTxStatemachine_run(). */
+    } tcp_tx_connection_t;
+
+    // =========================================================================
+    // Outbound Routing
+    // =========================================================================
+
+    /**
+     * @typedef tcp_route_entry_t
+     * @brief A remote Node ID and the connection it was last heard on.
+     */
+    typedef struct tcp_route_entry_struct {
+        node_id_t node_id;               /**< @brief Remote Node ID. 0 = unused. */
+        uint8_t connection;              /**< @brief Connection index the node was heard on. */
+    } tcp_route_entry_t;
+
+    // =========================================================================
+    // Scatter-Gather Transmit Segment
+    // =========================================================================
+
+    /** @brief Most segments handed to one transmit_raw_tcp_segments() call (header + payload). */
+#define TCP_TX_MAX_SEGMENTS                            2
+
+    /** @brief Largest encoded header: preamble + MTI + source and destination Node IDs. */
+#define TCP_TX_HEADER_LEN                              (TCP_PREAMBLE_LEN + TCP_BODY_MTI_LEN + TCP_BODY_NODE_ID_LEN + TCP_BODY_NODE_ID_LEN)
+
+    /**
+     * @typedef tcp_tx_segment_t
+     * @brief One piece of a scatter-gather transmit, in the spirit of struct iovec.
+     *
+     * @details Segments are only valid for the duration of the transmit call;
+     * the driver must send or copy them before returning.
+     */
+    typedef struct tcp_tx_segment_struct {
+        const uint8_t *data;             /**< @brief First byte of the segment. */
+        uint16_t len;                    /**< @brief Bytes in the segment. */
+    } tcp_tx_segment_t;
+
     // =========================================================================
     // TX Scratch Buffer Type
     // =========================================================================
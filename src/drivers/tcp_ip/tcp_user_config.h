@@ -34,13 +34,46 @@
 
 #define USER_DEFINED_TCP_TX_BUFFER_LEN                 1024
 
+// =============================================================================
+// TCP Transmit Coalescing
+// =============================================================================
+// Consecutive small messages (event enumeration, login) are packed into one
+// buffer and sent with a single transmit call instead of one TCP segment each.
+// A batch is flushed when it reaches FLUSH_THRESHOLD bytes, when its oldest
+// message is DEADLINE_MS old, when an addressed message is queued, or when the
+// main loop runs without queuing anything new.  1460 = one Ethernet MSS.
+// Set the buffer length to 0 to send every message immediately.
+
+#define USER_DEFINED_TCP_TX_COALESCE_BUFFER_LEN        1460
+#define USER_DEFINED_TCP_TX_COALESCE_FLUSH_THRESHOLD   1460
+#define USER_DEFINED_TCP_TX_COALESCE_DEADLINE_MS       10
+
+// =============================================================================
+// TCP Connections
+// =============================================================================
+// Number of TCP connections served at once, each with its own RX ring and TX
+// batch (RAM grows with every connection).  1 is enough for a node that talks
+// to one hub; more lets JMRI and configuration tools connect to the node
+// directly.  Addressed messages go to the connection their destination was
+// last heard on (ROUTE_TABLE_DEPTH remote nodes remembered); everything else
+// goes to every open connection.
+
+#define USER_DEFINED_TCP_MAX_CONNECTIONS               2
+#define USER_DEFINED_TCP_ROUTE_TABLE_DEPTH             16
+
 // =============================================================================
 // Multi-part Message Accumulation
 // =============================================================================
-// Maximum number of concurrent multi-part message reassemblies (keyed by
-// originating Node ID).  Most point-to-point links need only 1.  Hub nodes
-// receiving from multiple spokes may need more.
+// Concurrent multi-part message reassemblies across all connections, found by
+// originating Node ID through HASH_BUCKETS buckets (power of two, about one per
+// assembly).  An assembly holds only the message header; its payload is kept
+// in ARENA_BLOCKS shared 32-byte blocks, so hubs can allow many assemblies and
+// size the arena for the payload actually in flight.  An assembly that hears
+// no part for TIMEOUT_TICKS (100 ms each) is dropped and its blocks reclaimed.
 
-#define USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES      2
+#define USER_DEFINED_TCP_MAX_MULTIPART_ASSEMBLIES      8
+#define USER_DEFINED_TCP_MULTIPART_HASH_BUCKETS        8
+#define USER_DEFINED_TCP_MULTIPART_ARENA_BLOCKS        32
+#define USER_DEFINED_TCP_MULTIPART_TIMEOUT_TICKS       30
 
 #endif /* __TCP_USER_CONFIG__ */
@@ -29,6 +29,8 @@
  *
  * @details Circular buffer with one wasted slot for full/empty detection.
  * Head = next insertion, tail = next removal.  Empty when head == tail.
+ * Queued messages are also chained into a source-alias index so an AMR scrub
+ * visits only the released alias's bucket.
  *
  * @author Jim Kueneman
  * @date 17 Mar 2026
@@ -43,6 +45,7 @@
 
 #include "openlcb_types.h"
 #include "openlcb_buffer_store.h"
+#include "openlcb_utilities.h"
 
 
 
@@ -61,11 +64,14 @@ typedef struct {
 /** @brief Static FIFO instance (single global queue) */
 static openlcb_msg_fifo_t _openlcb_msg_buffer_fifo;
 
+/** @brief Source-alias index over the queued messages (chain heads). */
+static openlcb_msg_t *_alias_index[LEN_MESSAGE_ALIAS_INDEX];
+
     /**
     * @brief Initializes the FIFO.
     *
     * @details Algorithm:
-    * -# Clear all slots to NULL
+    * -# Clear all slots and alias index buckets to NULL
     * -# Reset head and tail to 0
     */
 void OpenLcbBufferFifo_initialize(void) {
@@ -76,6 +82,12 @@ void OpenLcbBufferFifo_initialize(void) {
 
     }
 
+    for (int i = 0; i < LEN_MESSAGE_ALIAS_INDEX; i++) {
+
+        _alias_index[i] = NULL;
+
+    }
+
     _openlcb_msg_buffer_fifo.head = 0;
     _openlcb_msg_buffer_fifo.tail = 0;
 
@@ -87,7 +99,8 @@ void OpenLcbBufferFifo_initialize(void) {
     * @details Algorithm:
     * -# Compute next head position with wraparound
     * -# If next == tail the FIFO is full, return NULL
-    * -# Store pointer at head, advance head, return the pointer
+    * -# Store pointer at head, link it into the alias index, advance head,
+    *    return the pointer
     *
     * @verbatim
     * @param new_msg Pointer to @ref openlcb_msg_t allocated from OpenLcbBufferStore
@@ -109,6 +122,12 @@ openlcb_msg_t *OpenLcbBufferFifo_push(openlcb_msg_t *new_msg) {
         _openlcb_msg_buffer_fifo.list[_openlcb_msg_buffer_fifo.head] = new_msg;
         _openlcb_msg_buffer_fifo.head = next;
 
+        if (new_msg) {
+
+            OpenLcbUtilities_alias_chain_insert(_alias_index, LEN_MESSAGE_ALIAS_INDEX - 1, new_msg);
+
+        }
+
         return new_msg;
 
     }
@@ -123,7 +142,7 @@ openlcb_msg_t *OpenLcbBufferFifo_push(openlcb_msg_t *new_msg) {
     * @details Algorithm:
     * -# If head == tail the FIFO is empty, return NULL
     * -# Retrieve pointer at tail, advance tail with wraparound
-    * -# Return the pointer
+    * -# Unlink it from the alias index and return the pointer
     *
     * @return Pointer to the oldest @ref openlcb_msg_t, or NULL if the FIFO is empty
     */
@@ -143,6 +162,12 @@ openlcb_msg_t *OpenLcbBufferFifo_pop(void) {
 
         }
 
+        if (result) {
+
+            OpenLcbUtilities_alias_chain_remove(_alias_index, LEN_MESSAGE_ALIAS_INDEX - 1, result);
+
+        }
+
     }
 
     return result;
@@ -159,8 +184,8 @@ bool OpenLcbBufferFifo_is_empty(void) {
     /**
      * @brief Marks all queued incoming messages from a released alias as invalid.
      *
-     * @details Walks the FIFO from tail to head and sets state.invalid on any
-     * message whose source_alias matches the released alias.  These are
+     * @details Walks the released alias's bucket of the source-alias index and
+     * sets state.invalid on any message whose source_alias matches.  These are
      * completed incoming messages from a node that has gone away — processing
      * them could generate replies to a stale alias that may now belong to a
      * different node.  The pop-phase guard or TX guard will discard them.
@@ -180,24 +205,17 @@ void OpenLcbBufferFifo_check_and_invalidate_messages_by_source_alias(uint16_t al
 
     }
 
-    uint16_t index = _openlcb_msg_buffer_fifo.tail;
+    openlcb_msg_t *msg = _alias_index[alias & (LEN_MESSAGE_ALIAS_INDEX - 1)];
 
-    while (index != _openlcb_msg_buffer_fifo.head) {
+    while (msg) {
 
-        openlcb_msg_t *msg = _openlcb_msg_buffer_fifo.list[index];
-
-        if (msg && msg->source_alias == alias) {
+        if (msg->source_alias == alias) {
 
             msg->state.invalid = true;
 
         }
 
-        index = index + 1;
-        if (index >= LEN_MESSAGE_FIFO_BUFFER) {
-
-            index = 0;
-
-        }
+        msg = msg->alias_chain_next;
 
     }
 
@@ -83,8 +83,8 @@ extern "C" {
         /**
          * @brief Marks all queued incoming messages from a released alias as invalid.
          *
-         * @details Walks the FIFO from tail to head and sets state.invalid on
-         * any message whose source_alias matches the released alias.  These
+         * @details Walks only the released alias's source-alias index bucket
+         * and sets state.invalid on each queued message from that alias.  These
          * are incoming messages from a node that has gone away — processing
          * them could generate replies to a stale alias.  The pop-phase guard
          * or TX guard will discard them.  Used when an AMR (Alias Map Reset)
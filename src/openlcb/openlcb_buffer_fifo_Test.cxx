@@ -1042,3 +1042,44 @@ TEST(OpenLcbBufferFIFO, check_and_invalidate_by_source_alias_wraparound)
     EXPECT_TRUE(OpenLcbBufferFifo_is_empty());
 }
 
+
+/**
+ * Test: Invalidation skips messages that share the alias's index bucket
+ * and messages already popped
+ */
+TEST(OpenLcbBufferFIFO, check_and_invalidate_by_source_alias_shared_bucket)
+{
+    OpenLcbBufferStore_initialize();
+    OpenLcbBufferFifo_initialize();
+
+    uint16_t target_alias = 0x0101;
+    uint16_t neighbour_alias = 0x0101 + LEN_MESSAGE_ALIAS_INDEX;
+
+    openlcb_msg_t *popped_early = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *target = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *neighbour = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(neighbour, nullptr);
+
+    popped_early->source_alias = target_alias;
+    target->source_alias = target_alias;
+    neighbour->source_alias = neighbour_alias;
+
+    OpenLcbBufferFifo_push(popped_early);
+    OpenLcbBufferFifo_push(target);
+    OpenLcbBufferFifo_push(neighbour);
+
+    EXPECT_EQ(OpenLcbBufferFifo_pop(), popped_early);
+
+    OpenLcbBufferFifo_check_and_invalidate_messages_by_source_alias(target_alias);
+
+    EXPECT_FALSE(popped_early->state.invalid);
+    EXPECT_TRUE(target->state.invalid);
+    EXPECT_FALSE(neighbour->state.invalid);
+
+    EXPECT_EQ(OpenLcbBufferFifo_pop(), target);
+    EXPECT_EQ(OpenLcbBufferFifo_pop(), neighbour);
+
+    OpenLcbBufferStore_free_buffer(popped_early);
+    OpenLcbBufferStore_free_buffer(target);
+    OpenLcbBufferStore_free_buffer(neighbour);
+}
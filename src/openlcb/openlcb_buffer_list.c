@@ -27,8 +27,10 @@
  * @file openlcb_buffer_list.c
  * @brief Random-access list of OpenLCB message pointers.
  *
- * @details Fixed-size array with linear search.  NULL slots are free.
- * Supports indexed access and attribute-based search (alias + MTI).
+ * @details Fixed-size array of slots.  NULL slots are free.
+ * Supports indexed access and attribute-based search (alias + MTI).  Members
+ * are also chained into a source-alias index so searches by alias visit only
+ * that alias's bucket instead of every slot.
  *
  * @author Jim Kueneman
  * @date 4 Mar 2026
@@ -43,6 +45,7 @@
 
 #include "openlcb_types.h"
 #include "openlcb_buffer_store.h"
+#include "openlcb_utilities.h"
 
     /** @brief Multi-frame assembly timeout in 100ms ticks (3 seconds). */
 #define BUFFER_LIST_INPROCESS_TIMEOUT_TICKS 30
@@ -50,11 +53,17 @@
 /** @brief Static array of message pointers for the list */
 static openlcb_msg_t *_openlcb_msg_buffer_list[LEN_MESSAGE_BUFFER];
 
+/** @brief Source-alias index over the list members (chain heads). */
+static openlcb_msg_t *_alias_index[LEN_MESSAGE_ALIAS_INDEX];
+
+/** @brief Number of non-NULL slots. */
+static uint16_t _count;
+
     /**
     * @brief Initializes the buffer list.
     *
     * @details Algorithm:
-    * -# Clear all slots to NULL
+    * -# Clear all slots and alias index buckets to NULL, zero the count
     */
 void OpenLcbBufferList_initialize(void) {
 
@@ -64,14 +73,24 @@ void OpenLcbBufferList_initialize(void) {
 
     }
 
+    for (int i = 0; i < LEN_MESSAGE_ALIAS_INDEX; i++) {
+
+        _alias_index[i] = NULL;
+
+    }
+
+    _count = 0;
+
 }
 
     /**
     * @brief Inserts a message pointer into the first available slot.
     *
     * @details Algorithm:
+    * -# Return NULL for a NULL message
     * -# Search for first NULL slot
-    * -# Store the pointer and return it, or return NULL if full
+    * -# Store the pointer, link it into the alias index and return it, or
+    *    return NULL if full
     *
     * @verbatim
     * @param new_msg Pointer to @ref openlcb_msg_t from the buffer store
@@ -81,12 +100,21 @@ void OpenLcbBufferList_initialize(void) {
     */
 openlcb_msg_t *OpenLcbBufferList_add(openlcb_msg_t *new_msg) {
 
+    if (!new_msg) {
+
+        return NULL;
+
+    }
+
     for (int i = 0; i < LEN_MESSAGE_BUFFER; i++) {
 
         if (!_openlcb_msg_buffer_list[i]) {
 
             _openlcb_msg_buffer_list[i] = new_msg;
 
+            OpenLcbUtilities_alias_chain_insert(_alias_index, LEN_MESSAGE_ALIAS_INDEX - 1, new_msg);
+            _count++;
+
             return new_msg;
 
         }
@@ -101,7 +129,7 @@ openlcb_msg_t *OpenLcbBufferList_add(openlcb_msg_t *new_msg) {
     * @brief Finds a message matching source alias, dest alias, and MTI.
     *
     * @details Algorithm:
-    * -# Search all non-NULL slots for a triple match
+    * -# Walk the source alias's index bucket for a triple match
     * -# Return the first match, or NULL if none found
     *
     * @verbatim
@@ -114,18 +142,39 @@ openlcb_msg_t *OpenLcbBufferList_add(openlcb_msg_t *new_msg) {
     */
 openlcb_msg_t *OpenLcbBufferList_find(uint16_t source_alias, uint16_t dest_alias, uint16_t mti) {
 
-    for (int i = 0; i < LEN_MESSAGE_BUFFER; i++) {
+    openlcb_msg_t *msg = _alias_index[source_alias & (LEN_MESSAGE_ALIAS_INDEX - 1)];
+
+    while (msg) {
 
-        if (_openlcb_msg_buffer_list[i]) {
+        if ((msg->dest_alias == dest_alias) && (msg->source_alias == source_alias) && (msg->mti == mti)) {
 
-            if ((_openlcb_msg_buffer_list[i]->dest_alias == dest_alias) && (_openlcb_msg_buffer_list[i]->source_alias == source_alias) && (_openlcb_msg_buffer_list[i]->mti == mti)) {
+            return msg;
 
-                return _openlcb_msg_buffer_list[i];
+        }
 
-            }
+        msg = msg->alias_chain_next;
+
+    }
+
+    return NULL;
+
+}
+
+    /** @brief Returns the first list member whose source_alias matches, walking one index bucket. */
+openlcb_msg_t *OpenLcbBufferList_find_by_source_alias(uint16_t source_alias) {
+
+    openlcb_msg_t *msg = _alias_index[source_alias & (LEN_MESSAGE_ALIAS_INDEX - 1)];
+
+    while (msg) {
+
+        if (msg->source_alias == source_alias) {
+
+            return msg;
 
         }
 
+        msg = msg->alias_chain_next;
+
     }
 
     return NULL;
@@ -137,7 +186,8 @@ openlcb_msg_t *OpenLcbBufferList_find(uint16_t source_alias, uint16_t dest_alias
     *
     * @details Algorithm:
     * -# If NULL, return NULL
-    * -# Search for the pointer, clear the slot, return the pointer
+    * -# Search for the pointer, clear the slot, unlink it from the alias
+    *    index, return the pointer
     * -# Return NULL if not found
     *
     * @verbatim
@@ -160,6 +210,9 @@ openlcb_msg_t *OpenLcbBufferList_release(openlcb_msg_t *msg) {
 
             _openlcb_msg_buffer_list[i] = NULL;
 
+            OpenLcbUtilities_alias_chain_remove(_alias_index, LEN_MESSAGE_ALIAS_INDEX - 1, msg);
+            _count--;
+
             return msg;
 
         }
@@ -186,17 +239,7 @@ openlcb_msg_t *OpenLcbBufferList_index_of(uint16_t index) {
     /** @brief Returns true if the list contains no messages. */
 bool OpenLcbBufferList_is_empty(void) {
 
-    for (int i = 0; i < LEN_MESSAGE_BUFFER; i++) {
-
-        if (_openlcb_msg_buffer_list[i] != NULL) {
-
-            return false;
-
-        }
-
-    }
-
-    return true;
+    return (_count == 0);
 
 }
 
@@ -213,6 +256,8 @@ void OpenLcbBufferList_check_timeouts(uint8_t current_tick) {
             if (elapsed >= BUFFER_LIST_INPROCESS_TIMEOUT_TICKS) {
 
                 _openlcb_msg_buffer_list[i] = NULL;
+                OpenLcbUtilities_alias_chain_remove(_alias_index, LEN_MESSAGE_ALIAS_INDEX - 1, msg);
+                _count--;
                 OpenLcbBufferStore_free_buffer(msg);
 
             }
@@ -79,6 +79,19 @@ extern "C" {
          */
     extern openlcb_msg_t *OpenLcbBufferList_find(uint16_t source_alias, uint16_t dest_alias, uint16_t mti);
 
+        /**
+         * @brief Finds any message from the given source alias.
+         *
+         * @details Walks a single source-alias index bucket, so the cost depends
+         * on the messages sharing that bucket rather than on LEN_MESSAGE_BUFFER.
+         * Call repeatedly, releasing each result, to drain an alias.
+         *
+         * @param source_alias  12-bit CAN alias of the originating node.
+         *
+         * @return Pointer to a matching @ref openlcb_msg_t, or NULL if none.
+         */
+    extern openlcb_msg_t *OpenLcbBufferList_find_by_source_alias(uint16_t source_alias);
+
         /**
          * @brief Removes a message from the list without freeing it.
          *
@@ -97,7 +110,7 @@ extern "C" {
          */
     extern openlcb_msg_t *OpenLcbBufferList_index_of(uint16_t index);
 
-        /** @brief Returns true if the list contains no messages. */
+        /** @brief Returns true if the list contains no messages (O(1), from a member count). */
     extern bool OpenLcbBufferList_is_empty(void);
 
         /**
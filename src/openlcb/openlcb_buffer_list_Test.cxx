@@ -1084,3 +1084,83 @@ TEST(OpenLcbBufferList, completed_buffer_not_timed_out)
     OpenLcbBufferList_release(msg);
     OpenLcbBufferStore_free_buffer(msg);
 }
+
+/**
+ * Test: find_by_source_alias drains one alias and leaves others alone
+ * - Aliases 0x0101 and 0x0101 + LEN_MESSAGE_ALIAS_INDEX share an index bucket
+ * - Draining the first must not touch the second or a third alias
+ */
+TEST(OpenLcbBufferList, find_by_source_alias_drains_only_that_alias)
+{
+    OpenLcbBufferStore_initialize();
+    OpenLcbBufferList_initialize();
+
+    uint16_t alias_a = 0x0101;
+    uint16_t alias_b = 0x0101 + LEN_MESSAGE_ALIAS_INDEX;
+    uint16_t alias_c = 0x0202;
+
+    openlcb_msg_t *a1 = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *b1 = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *a2 = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *c1 = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(c1, nullptr);
+
+    a1->source_alias = alias_a;
+    a1->mti = 0x0001;
+    b1->source_alias = alias_b;
+    a2->source_alias = alias_a;
+    a2->mti = 0x0002;
+    c1->source_alias = alias_c;
+
+    OpenLcbBufferList_add(a1);
+    OpenLcbBufferList_add(b1);
+    OpenLcbBufferList_add(a2);
+    OpenLcbBufferList_add(c1);
+
+    EXPECT_EQ(OpenLcbBufferList_find(alias_a, 0, 0x0002), a2);
+
+    int drained = 0;
+    openlcb_msg_t *msg = OpenLcbBufferList_find_by_source_alias(alias_a);
+
+    while (msg) {
+
+        EXPECT_EQ(msg->source_alias, alias_a);
+        OpenLcbBufferList_release(msg);
+        drained++;
+        msg = OpenLcbBufferList_find_by_source_alias(alias_a);
+
+    }
+
+    EXPECT_EQ(drained, 2);
+    EXPECT_EQ(OpenLcbBufferList_find_by_source_alias(alias_b), b1);
+    EXPECT_EQ(OpenLcbBufferList_find_by_source_alias(alias_c), c1);
+    EXPECT_EQ(OpenLcbBufferList_find(alias_a, 0, 0x0001), nullptr);
+
+    OpenLcbBufferList_release(b1);
+    OpenLcbBufferList_release(c1);
+
+    EXPECT_TRUE(OpenLcbBufferList_is_empty());
+    EXPECT_EQ(OpenLcbBufferList_find_by_source_alias(alias_b), nullptr);
+}
+
+/**
+ * Test: timeout removal unlinks the message from the alias index
+ */
+TEST(OpenLcbBufferList, timeout_unlinks_from_alias_index)
+{
+    OpenLcbBufferStore_initialize();
+    OpenLcbBufferList_initialize();
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+
+    msg->source_alias = 0x0123;
+    msg->timer.assembly_ticks = 0;
+    msg->state.inprocess = true;
+
+    OpenLcbBufferList_add(msg);
+    OpenLcbBufferList_check_timeouts(100);
+
+    EXPECT_TRUE(OpenLcbBufferList_is_empty());
+    EXPECT_EQ(OpenLcbBufferList_find_by_source_alias(0x0123), nullptr);
+}
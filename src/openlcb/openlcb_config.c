@@ -48,6 +48,7 @@
 #include "openlcb_main_statemachine.h"
 #include "openlcb_login_statemachine.h"
 #include "openlcb_login_statemachine_handler.h"
+#include "openlcb_timer.h"
 #include "protocol_message_network.h"
 #include "protocol_snip.h"
 
@@ -65,6 +66,10 @@
 #include "protocol_config_mem_operations_handler.h"
 #endif
 
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+#include "openlcb_config_mem_cache.h"
+#endif
+
 #ifdef OPENLCB_COMPILE_BROADCAST_TIME
 #include "protocol_broadcast_time_handler.h"
 #include "openlcb_application_broadcast_time.h"
@@ -92,12 +97,24 @@
 #ifdef OPENLCB_COMPILE_CAN
 #include "../drivers/canbus/can_tx_statemachine.h"
 #include "../drivers/canbus/can_main_statemachine.h"
+#include "../drivers/canbus/can_bus_monitor.h"
 #endif
 
 #ifdef OPENLCB_COMPILE_TCP
 #include "../drivers/tcp_ip/tcp_config.h"
 #endif
 
+#ifdef OPENLCB_COMPILE_ROUTER
+#include "openlcb_router.h"
+#include "../drivers/canbus/can_alias_pool.h"
+#if USER_DEFINED_ALIAS_POOL_DEPTH < 1
+#error "The CAN <-> TCP router takes proxy aliases from the alias pool; USER_DEFINED_ALIAS_POOL_DEPTH must be >= 1"
+#endif
+#if USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH < 1
+#error "The CAN <-> TCP router forwards CAN traffic under the sender's Node ID from the remote alias cache; USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH must be >= 1"
+#endif
+#endif
+
 // ---- Internal storage for built interface structs ----
 
 static interface_openlcb_main_statemachine_t _main_sm;
@@ -107,6 +124,7 @@ static interface_openlcb_node_t _node;
 static interface_openlcb_application_t _app;
 static interface_openlcb_protocol_snip_t _snip;
 static interface_openlcb_protocol_message_network_t _msg_network;
+static interface_openlcb_timer_t _timer;
 
 #ifdef OPENLCB_COMPILE_EVENTS
 static interface_openlcb_protocol_event_transport_t _event_transport;
@@ -120,6 +138,14 @@ static interface_protocol_datagram_handler_t _datagram;
 static interface_protocol_config_mem_read_handler_t _config_read;
 static interface_protocol_config_mem_write_handler_t _config_write;
 static interface_protocol_config_mem_operations_handler_t _config_ops;
+
+/** @brief Config memory access used by every module: the user callbacks, or the write-back cache in front of them. */
+static uint16_t (*_config_mem_read)(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
+static uint16_t (*_config_mem_write)(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
+#endif
+
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+static interface_openlcb_config_mem_cache_t _config_mem_cache;
 #endif
 
 #ifdef OPENLCB_COMPILE_BROADCAST_TIME
@@ -145,6 +171,10 @@ static interface_protocol_config_mem_stream_handler_t _config_mem_stream;
 #endif
 #endif
 
+#ifdef OPENLCB_COMPILE_ROUTER
+static interface_openlcb_router_t _router;
+#endif
+
 static const openlcb_config_t *_config;
 
     /**
@@ -186,6 +216,20 @@ uint8_t OpenLcbConfig_get_global_100ms_tick(void) {
 
     return _global_100ms_tick;
 
+}
+
+    /**
+     * @brief Returns the library millisecond clock.
+     *
+     * @details The user's get_time_ms when provided, otherwise built from the
+     * 100ms tick.  Injected into modules the same way as the tick.
+     *
+     * @return Milliseconds (wraps at 2^32).
+     */
+uint32_t OpenLcbConfig_get_time_ms(void) {
+
+    return OpenLcbTimer_get_time_ms();
+
 }
 
 // ---- Build functions ----
@@ -380,13 +424,13 @@ static uint16_t _stream_read_request_all(openlcb_node_t *node, uint32_t address,
     /** @brief Stream read from Config Memory (0xFD): delegate to user callback. */
 static uint16_t _stream_read_request_configuration_memory(openlcb_node_t *node, uint32_t address, uint16_t count, uint8_t *buffer) {
 
-    if (!_config->config_mem_read) {
+    if (!_config_mem_read) {
 
         return 0;
 
     }
 
-    return _config->config_mem_read(node, address, count, (configuration_memory_buffer_t *) buffer);
+    return _config_mem_read(node, address, count, (configuration_memory_buffer_t *) buffer);
 
 }
 
@@ -509,7 +553,7 @@ static uint16_t _stream_read_request_acdi_user(openlcb_node_t *node, uint32_t ad
         } else if (pos >= CONFIG_MEM_ACDI_USER_NAME_ADDRESS &&  // GCOV_EXCL_BR_LINE
                 pos < CONFIG_MEM_ACDI_USER_NAME_ADDRESS + CONFIG_MEM_ACDI_USER_NAME_LEN) {
 
-            if (!_config->config_mem_read) {
+            if (!_config_mem_read) {
 
                 buffer[filled] = 0;
                 filled++;
@@ -529,7 +573,7 @@ static uint16_t _stream_read_request_acdi_user(openlcb_node_t *node, uint32_t ad
 
             }
 
-            uint16_t actual = _config->config_mem_read(node, config_addr, to_read, (configuration_memory_buffer_t *) &buffer[filled]);
+            uint16_t actual = _config_mem_read(node, config_addr, to_read, (configuration_memory_buffer_t *) &buffer[filled]);
 
             filled += actual;
 
@@ -542,7 +586,7 @@ static uint16_t _stream_read_request_acdi_user(openlcb_node_t *node, uint32_t ad
         } else if (pos >= CONFIG_MEM_ACDI_USER_DESCRIPTION_ADDRESS &&  // GCOV_EXCL_BR_LINE
                 pos < CONFIG_MEM_ACDI_USER_DESCRIPTION_ADDRESS + CONFIG_MEM_ACDI_USER_DESCRIPTION_LEN) {
 
-            if (!_config->config_mem_read) {
+            if (!_config_mem_read) {
 
                 buffer[filled] = 0;
                 filled++;
@@ -562,7 +606,7 @@ static uint16_t _stream_read_request_acdi_user(openlcb_node_t *node, uint32_t ad
 
             }
 
-            uint16_t actual = _config->config_mem_read(node, config_addr, to_read, (configuration_memory_buffer_t *) &buffer[filled]);
+            uint16_t actual = _config_mem_read(node, config_addr, to_read, (configuration_memory_buffer_t *) &buffer[filled]);
 
             filled += actual;
 
@@ -646,7 +690,7 @@ static uint16_t _stream_read_request_train_function_config_memory(openlcb_node_t
     /** @brief Stream write to Config Memory (0xFD): delegates to user config_mem_write. */
 static uint16_t _stream_write_request_configuration_memory(openlcb_node_t *node, uint32_t address, uint16_t count, const uint8_t *buffer) {
 
-    return _config->config_mem_write(node, address, count, (configuration_memory_buffer_t *) buffer);
+    return _config_mem_write(node, address, count, (configuration_memory_buffer_t *) buffer);
 
 }
 
@@ -655,7 +699,7 @@ static uint16_t _stream_write_request_acdi_user(openlcb_node_t *node, uint32_t a
 
     uint32_t config_address = address + node->parameters->address_space_acdi_user.low_address;
 
-    return _config->config_mem_write(node, config_address, count, (configuration_memory_buffer_t *) buffer);
+    return _config_mem_write(node, config_address, count, (configuration_memory_buffer_t *) buffer);
 
 }
 
@@ -712,10 +756,11 @@ static void _build_config_mem_stream_handler(void) {
 
     memset(&_config_mem_stream, 0, sizeof(_config_mem_stream));
 
-#ifdef OPENLCB_COMPILE_CAN
+#if defined(OPENLCB_COMPILE_ROUTER)
+    _config_mem_stream.send_openlcb_msg = &OpenLcbRouter_send_openlcb_msg;
+#elif defined(OPENLCB_COMPILE_CAN)
     _config_mem_stream.send_openlcb_msg = &CanTxStatemachine_send_openlcb_message;
-#endif
-#ifdef OPENLCB_COMPILE_TCP
+#elif defined(OPENLCB_COMPILE_TCP)
     _config_mem_stream.send_openlcb_msg = TcpConfig_get_send_openlcb_msg();
 #endif
 
@@ -729,6 +774,10 @@ static void _build_config_mem_stream_handler(void) {
     _config_mem_stream.stream_send_complete     = &ProtocolStreamHandler_send_complete;
     _config_mem_stream.stream_send_terminate    = &ProtocolStreamHandler_send_terminate;
 
+#if defined(OPENLCB_COMPILE_CAN) && (USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0) && (USER_DEFINED_CAN_BUS_THROTTLE_PERCENT > 0)
+    _config_mem_stream.is_transport_congested = &CanBusMonitor_is_congested;
+#endif
+
     // Per-space read request callbacks
     _config_mem_stream.read_request_config_definition_info  = &_stream_read_request_config_definition_info;
     _config_mem_stream.read_request_all                     = &_stream_read_request_all;
@@ -762,6 +811,16 @@ static void _build_config_mem_stream_handler(void) {
 
 #endif /* OPENLCB_COMPILE_STREAM */
 
+    /** @brief Wires the 100ms tick and the optional user millisecond counter into the timer service. */
+static void _build_timer(void) {
+
+    memset(&_timer, 0, sizeof(_timer));
+
+    _timer.get_current_tick = &OpenLcbConfig_get_global_100ms_tick;
+    _timer.get_time_ms      = _config->get_time_ms;
+
+}
+
     /** @brief Wires the user 100ms timer callback into the node interface struct. */
 static void _build_node(void) {
 
@@ -790,10 +849,11 @@ static void _build_login_statemachine(void) {
     memset(&_login_sm, 0, sizeof(_login_sm));
 
     // Direct transport send — login has its own inline sibling dispatch (Phase 2)
-#ifdef OPENLCB_COMPILE_CAN
+#if defined(OPENLCB_COMPILE_ROUTER)
+    _login_sm.send_openlcb_msg = &OpenLcbRouter_send_openlcb_msg;
+#elif defined(OPENLCB_COMPILE_CAN)
     _login_sm.send_openlcb_msg = &CanTxStatemachine_send_openlcb_message;
-#endif
-#ifdef OPENLCB_COMPILE_TCP
+#elif defined(OPENLCB_COMPILE_TCP)
     _login_sm.send_openlcb_msg = TcpConfig_get_send_openlcb_msg();
 #endif
 
@@ -827,13 +887,52 @@ static void _build_msg_network(void) {
 
 }
 
+#ifdef OPENLCB_COMPILE_MEMORY_CONFIGURATION
+
+    /** @brief Selects the config memory access path: straight to the user callbacks, or through the write-back cache. */
+static void _build_config_mem_access(void) {
+
+    _config_mem_read  = _config->config_mem_read;
+    _config_mem_write = _config->config_mem_write;
+
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+    memset(&_config_mem_cache, 0, sizeof(_config_mem_cache));
+
+    if (_config->config_mem_read && _config->config_mem_write) {
+
+        _config_mem_cache.config_memory_read  = _config->config_mem_read;
+        _config_mem_cache.config_memory_write = _config->config_mem_write;
+
+        _config_mem_read  = &OpenLcbConfigMemCache_read;
+        _config_mem_write = &OpenLcbConfigMemCache_write;
+
+    }
+#endif
+
+}
+
+#endif /* OPENLCB_COMPILE_MEMORY_CONFIGURATION */
+
     /** @brief Wires the config memory read callback into the SNIP interface struct. */
 static void _build_snip(void) {
 
     memset(&_snip, 0, sizeof(_snip));
 
 #ifdef OPENLCB_COMPILE_MEMORY_CONFIGURATION
-    _snip.config_memory_read = _config->config_mem_read;
+    _snip.config_memory_read = _config_mem_read;
+
+    // A pending user name/description read parks the reply with the config read handler
+#ifndef OPENLCB_COMPILE_BOOTLOADER
+    _snip.can_park_read = &ProtocolConfigMemReadHandler_can_park_read;
+    _snip.park_read = &ProtocolConfigMemReadHandler_park_read;
+#if defined(OPENLCB_COMPILE_ROUTER)
+    _snip.send_openlcb_msg = &OpenLcbRouter_send_openlcb_msg;
+#elif defined(OPENLCB_COMPILE_CAN)
+    _snip.send_openlcb_msg = &CanTxStatemachine_send_openlcb_message;
+#elif defined(OPENLCB_COMPILE_TCP)
+    _snip.send_openlcb_msg = TcpConfig_get_send_openlcb_msg();
+#endif
+#endif
 #endif
 
 }
@@ -848,7 +947,16 @@ static void _build_config_mem_read(void) {
     // Library-internal wiring
     _config_read.load_datagram_received_ok_message       = &ProtocolDatagramHandler_load_datagram_received_ok_message;
     _config_read.load_datagram_received_rejected_message = &ProtocolDatagramHandler_load_datagram_rejected_message;
-    _config_read.config_memory_read = _config->config_mem_read;
+    _config_read.config_memory_read = _config_mem_read;
+
+    // Transmit path for replies finished by the *_complete_read/write calls
+#if defined(OPENLCB_COMPILE_ROUTER)
+    _config_read.send_openlcb_msg = &OpenLcbRouter_send_openlcb_msg;
+#elif defined(OPENLCB_COMPILE_CAN)
+    _config_read.send_openlcb_msg = &CanTxStatemachine_send_openlcb_message;
+#elif defined(OPENLCB_COMPILE_TCP)
+    _config_read.send_openlcb_msg = TcpConfig_get_send_openlcb_msg();
+#endif
 
     // ACDI/SNIP support -- library standard implementations
     _config_read.snip_load_manufacturer_version_id = &ProtocolSnip_load_manufacturer_version_id;
@@ -866,6 +974,10 @@ static void _build_config_mem_read(void) {
     _config_read.read_request_config_mem = &ProtocolConfigMemReadHandler_read_request_config_mem;
     _config_read.read_request_acdi_manufacturer = &ProtocolConfigMemReadHandler_read_request_acdi_manufacturer;
     _config_read.read_request_acdi_user = &ProtocolConfigMemReadHandler_read_request_acdi_user;
+
+    // Completions for reads parked by SNIP and write-under-mask
+    _config_read.snip_complete_read = &ProtocolSnip_complete_read;
+    _config_read.write_under_mask_complete_read = &ProtocolConfigMemWriteHandler_complete_write_under_mask_read;
 #endif
 
     // Train profile: FDI + Function Config Memory read request handlers
@@ -887,11 +999,22 @@ static void _build_config_mem_write(void) {
 
     _config_write.load_datagram_received_ok_message       = &ProtocolDatagramHandler_load_datagram_received_ok_message;
     _config_write.load_datagram_received_rejected_message = &ProtocolDatagramHandler_load_datagram_rejected_message;
-    _config_write.config_memory_write                     = _config->config_mem_write;
-    _config_write.config_memory_read                      = _config->config_mem_read;
+    _config_write.config_memory_write                     = _config_mem_write;
+    _config_write.config_memory_read                      = _config_mem_read;
+
+    // Transmit path for replies finished by the *_complete_read/write calls
+#if defined(OPENLCB_COMPILE_ROUTER)
+    _config_write.send_openlcb_msg = &OpenLcbRouter_send_openlcb_msg;
+#elif defined(OPENLCB_COMPILE_CAN)
+    _config_write.send_openlcb_msg = &CanTxStatemachine_send_openlcb_message;
+#elif defined(OPENLCB_COMPILE_TCP)
+    _config_write.send_openlcb_msg = TcpConfig_get_send_openlcb_msg();
+#endif
 #ifndef OPENLCB_COMPILE_BOOTLOADER
     _config_write.write_request_config_mem                = &ProtocolConfigMemWriteHandler_write_request_config_mem;
     _config_write.write_request_acdi_user                 =  &ProtocolConfigMemWriteHandler_write_request_acdi_user;
+    _config_write.can_park_read                           = &ProtocolConfigMemReadHandler_can_park_read;
+    _config_write.park_read                               = &ProtocolConfigMemReadHandler_park_read;
 #endif
 
     // Train profile: Function Config Memory write request handler
@@ -910,6 +1033,43 @@ static void _build_config_mem_write(void) {
 
 }
 
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+
+    /** @brief Reboot: write the cache back first so nothing accepted is lost, then call the user reboot. */
+static void _config_mem_cache_reboot(openlcb_statemachine_info_t *statemachine_info, config_mem_operations_request_info_t *config_mem_operations_request_info) {
+
+    OpenLcbConfigMemCache_flush(NULL);
+
+    _config->reboot(statemachine_info, config_mem_operations_request_info);
+
+}
+
+#ifndef OPENLCB_COMPILE_BOOTLOADER
+
+    /** @brief Update Complete: the configuration tool is done, write the node's cache lines back. No reply beyond the Datagram OK. */
+static void _config_mem_cache_update_complete(openlcb_statemachine_info_t *statemachine_info, config_mem_operations_request_info_t *config_mem_operations_request_info) {
+
+    (void) config_mem_operations_request_info;
+
+    OpenLcbConfigMemCache_flush(statemachine_info->openlcb_node);
+
+    statemachine_info->outgoing_msg_info.valid = false;
+
+}
+
+    /** @brief Factory Reset: drop the node's unwritten lines so they cannot overwrite the restored defaults. */
+static void _config_mem_cache_factory_reset(openlcb_statemachine_info_t *statemachine_info, config_mem_operations_request_info_t *config_mem_operations_request_info) {
+
+    OpenLcbConfigMemCache_discard(statemachine_info->openlcb_node);
+
+    _config->factory_reset(statemachine_info, config_mem_operations_request_info);
+
+}
+
+#endif /* OPENLCB_COMPILE_BOOTLOADER */
+
+#endif /* OPENLCB_COMPILE_CONFIG_MEM_CACHE */
+
     /** @brief Wires operations commands (options, address space info, lock, reboot, factory reset) into the config ops interface. */
 static void _build_config_mem_operations(void) {
 
@@ -934,6 +1094,24 @@ static void _build_config_mem_operations(void) {
     _config_ops.operations_request_factory_reset          = _config->factory_reset;
 #endif
 
+    // Write-back cache: flush on Update Complete and before a reboot, drop on factory reset
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+    if (_config->reboot) {
+
+        _config_ops.operations_request_reset_reboot       = &_config_mem_cache_reboot;
+
+    }
+#ifndef OPENLCB_COMPILE_BOOTLOADER
+    _config_ops.operations_request_update_complete        = &_config_mem_cache_update_complete;
+
+    if (_config->factory_reset) {
+
+        _config_ops.operations_request_factory_reset      = &_config_mem_cache_factory_reset;
+
+    }
+#endif
+#endif
+
 }
 
 #endif /* OPENLCB_COMPILE_MEMORY_CONFIGURATION */
@@ -948,6 +1126,15 @@ static void _build_datagram_handler(void) {
     _datagram.lock_shared_resources   = _config->lock_shared_resources;
     _datagram.unlock_shared_resources = _config->unlock_shared_resources;
 
+    // Resend of datagrams rejected with the resend-OK bit
+#if defined(OPENLCB_COMPILE_ROUTER)
+    _datagram.resend_datagram = &OpenLcbRouter_send_openlcb_msg;
+#elif defined(OPENLCB_COMPILE_CAN)
+    _datagram.resend_datagram = &CanTxStatemachine_send_openlcb_message;
+#elif defined(OPENLCB_COMPILE_TCP)
+    _datagram.resend_datagram = TcpConfig_get_send_openlcb_msg();
+#endif
+
 #ifdef OPENLCB_COMPILE_MEMORY_CONFIGURATION
 
 #ifndef OPENLCB_COMPILE_BOOTLOADER
@@ -1068,6 +1255,29 @@ static void _build_datagram_handler(void) {
 
 #endif /* OPENLCB_COMPILE_DATAGRAMS */
 
+#ifdef OPENLCB_COMPILE_ROUTER
+    /** @brief Wires both transports, the CAN alias pool and node lookup into the router interface. */
+static void _build_router(void) {
+
+    memset(&_router, 0, sizeof(_router));
+
+    _router.send_can_msg = &CanTxStatemachine_send_openlcb_message;
+    _router.send_tcp_msg = TcpConfig_get_send_openlcb_msg();
+    _router.is_tcp_link_up = &TcpConfig_is_link_up;
+
+    _router.proxy_alias_claim = &CanAliasPool_claim;
+    _router.proxy_alias_announce = &CanAliasPool_announce;
+    _router.proxy_alias_is_held = &CanAliasPool_is_held;
+    _router.proxy_alias_release = &CanAliasPool_release;
+
+    _router.openlcb_node_find_by_alias = &OpenLcbNode_find_by_alias;
+    _router.openlcb_node_find_by_node_id = &OpenLcbNode_find_by_node_id;
+    _router.get_current_tick = &OpenLcbConfig_get_global_100ms_tick;
+
+}
+
+#endif /* OPENLCB_COMPILE_ROUTER */
+
     /** @brief Wires all protocol handlers into the main state machine dispatch interface. */
 static void _build_main_statemachine(void) {
 
@@ -1076,15 +1286,27 @@ static void _build_main_statemachine(void) {
     // Hardware bindings
     _main_sm.lock_shared_resources   = _config->lock_shared_resources;
     _main_sm.unlock_shared_resources = _config->unlock_shared_resources;
-#ifdef OPENLCB_COMPILE_CAN
+#if defined(OPENLCB_COMPILE_ROUTER)
+    _main_sm.send_openlcb_msg        = &OpenLcbRouter_send_openlcb_msg;
+#elif defined(OPENLCB_COMPILE_CAN)
     _main_sm.send_openlcb_msg        = &CanTxStatemachine_send_openlcb_message;
-#endif
-#ifdef OPENLCB_COMPILE_TCP
+#elif defined(OPENLCB_COMPILE_TCP)
     _main_sm.send_openlcb_msg        = TcpConfig_get_send_openlcb_msg();
 #endif
 
     // Clock access (injected to maintain decoupling)
     _main_sm.get_current_tick = &OpenLcbConfig_get_global_100ms_tick;
+    _main_sm.get_time_ms      = &OpenLcbConfig_get_time_ms;
+
+    // Bus-load feedback (optional -- defers multi-message enumeration)
+#if defined(OPENLCB_COMPILE_CAN) && (USER_DEFINED_CAN_BUS_MONITOR_BITRATE > 0) && (USER_DEFINED_CAN_BUS_THROTTLE_PERCENT > 0)
+    _main_sm.is_transport_congested = &CanBusMonitor_is_congested;
+#endif
+
+    // CAN <-> TCP forwarding of received traffic (optional)
+#ifdef OPENLCB_COMPILE_ROUTER
+    _main_sm.forward_incoming_msg = &OpenLcbRouter_forward_incoming_msg;
+#endif
 
     // Library-internal wiring -- always the same
     _main_sm.openlcb_node_get_first    = &OpenLcbNode_get_first;
@@ -1184,8 +1406,8 @@ static void _build_application(void) {
     _app.send_openlcb_msg    = &OpenLcbMainStatemachine_send_with_sibling_dispatch;
 
 #ifdef OPENLCB_COMPILE_MEMORY_CONFIGURATION
-    _app.config_memory_read  = _config->config_mem_read;
-    _app.config_memory_write = _config->config_mem_write;
+    _app.config_memory_read  = _config_mem_read;
+    _app.config_memory_write = _config_mem_write;
 #endif
 
 }
@@ -1215,6 +1437,10 @@ void OpenLcbConfig_initialize(const openlcb_config_t *config) {
     OpenLcbBufferFifo_initialize();
 
     // 2. Build all internal interface structs from user config
+#ifdef OPENLCB_COMPILE_MEMORY_CONFIGURATION
+    _build_config_mem_access();
+#endif
+    _build_timer();
     _build_node();
     _build_login_message_handler();
     _build_login_statemachine();
@@ -1259,7 +1485,15 @@ void OpenLcbConfig_initialize(const openlcb_config_t *config) {
 
     _build_main_statemachine();
 
+#ifdef OPENLCB_COMPILE_ROUTER
+    _build_router();
+#endif
+
     // 3. Initialize modules in dependency order
+    OpenLcbTimer_initialize(&_timer);
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+    OpenLcbConfigMemCache_initialize(&_config_mem_cache);
+#endif
     ProtocolSnip_initialize(&_snip);
 
 #ifdef OPENLCB_COMPILE_DATAGRAMS
@@ -1307,6 +1541,10 @@ void OpenLcbConfig_initialize(const openlcb_config_t *config) {
     OpenLcbLoginStatemachine_initialize(&_login_sm);
     OpenLcbMainStatemachine_initialize(&_main_sm);
 
+#ifdef OPENLCB_COMPILE_ROUTER
+    OpenLcbRouter_initialize(&_router);
+#endif
+
     OpenLcbApplication_initialize(&_app);
 
 }
@@ -1330,19 +1568,23 @@ openlcb_node_t *OpenLcbConfig_create_node(node_id_t node_id, const node_paramete
     /**
      * @brief Runs all periodic service tasks from the main loop.
      *
-     * @details Reads the global clock once and passes it to each module.
-     * All work happens in the main loop context where it is safe to send
-     * messages, free buffers, and call application callbacks.
+     * @details Reads the global clocks once and passes them to each module,
+     * then fires any due OpenLcbTimer timers.  All work happens in the main
+     * loop context where it is safe to send messages, free buffers, and call
+     * application callbacks.
      */
 static void _run_periodic_services(void) {
 
     uint8_t tick = _global_100ms_tick;
+    uint32_t time_ms = OpenLcbTimer_get_time_ms();
+
+    OpenLcbTimer_run();
 
     OpenLcbNode_100ms_timer_tick(tick);
 
 #ifdef OPENLCB_COMPILE_DATAGRAMS
     ProtocolDatagramHandler_100ms_timer_tick(tick);
-    ProtocolDatagramHandler_check_timeouts(tick);
+    ProtocolDatagramHandler_check_timeouts(time_ms);
 #endif
 
 #ifdef OPENLCB_COMPILE_STREAM
@@ -85,6 +85,10 @@
 #error "OPENLCB_COMPILE_FIRMWARE requires OPENLCB_COMPILE_MEMORY_CONFIGURATION"
 #endif
 
+#if defined(OPENLCB_COMPILE_CONFIG_MEM_CACHE) && !defined(OPENLCB_COMPILE_MEMORY_CONFIGURATION)
+#error "OPENLCB_COMPILE_CONFIG_MEM_CACHE requires OPENLCB_COMPILE_MEMORY_CONFIGURATION"
+#endif
+
 #if defined(OPENLCB_COMPILE_DCC_DETECTOR) && !defined(OPENLCB_COMPILE_EVENTS)
 #error "OPENLCB_COMPILE_DCC_DETECTOR requires OPENLCB_COMPILE_EVENTS"
 #endif
@@ -125,6 +129,10 @@
 #pragma message "OpenLcbCLib: TRANSPORT = TCP/IP"
 #endif
 
+#ifdef OPENLCB_COMPILE_ROUTER
+#pragma message "OpenLcbCLib: ROUTER = CAN <-> TCP/IP"
+#endif
+
 #ifdef OPENLCB_COMPILE_EVENTS
 #pragma message "OpenLcbCLib: EVENTS = ON"
 #else
@@ -143,6 +151,12 @@
 #pragma message "OpenLcbCLib: MEMORY_CONFIGURATION = OFF"
 #endif
 
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+#pragma message "OpenLcbCLib: CONFIG_MEM_CACHE = ON"
+#else
+#pragma message "OpenLcbCLib: CONFIG_MEM_CACHE = OFF"
+#endif
+
 #ifdef OPENLCB_COMPILE_FIRMWARE
 #pragma message "OpenLcbCLib: FIRMWARE = ON"
 #else
@@ -226,6 +240,15 @@ typedef struct {
         /** @brief Re-enable interrupts / release mutex. REQUIRED. */
     void (*unlock_shared_resources)(void);
 
+        /**
+         * @brief Free-running millisecond counter (wraps at 2^32). Optional.
+         *
+         * @details Gives protocol timeouts (CAN login wait, datagram resend
+         * backoff) 1 ms resolution.  NULL = timing runs in 100 ms steps off
+         * OpenLcbConfig_100ms_timer_tick().
+         */
+    uint32_t (*get_time_ms)(void);
+
 #ifdef OPENLCB_COMPILE_MEMORY_CONFIGURATION
 
     // =========================================================================
@@ -240,7 +263,15 @@ typedef struct {
          * @param count Number of bytes to read
          * @param buffer Destination @ref configuration_memory_buffer_t
          *
-         * @return Number of bytes actually read
+         * @details Slow storage may return CONFIG_MEM_ACCESS_PENDING instead of
+         * blocking.  Every read is then handled the same way: the request
+         * (datagram read of 0xFD or 0xFB, SNIP reply, or write-under-mask) is
+         * parked and finished when the application calls
+         * ProtocolConfigMemReadHandler_complete_read() with the bytes; the
+         * main loop moves on meanwhile.  Set config_mem_read_delayed_reply_time
+         * so the requester waits long enough.
+         *
+         * @return Number of bytes actually read, or CONFIG_MEM_ACCESS_PENDING
          */
     uint16_t (*config_mem_read)(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
 
@@ -252,7 +283,17 @@ typedef struct {
          * @param count Number of bytes to write
          * @param buffer Source @ref configuration_memory_buffer_t
          *
-         * @return Number of bytes actually written
+         * @details May return CONFIG_MEM_ACCESS_PENDING after copying buffer;
+         * the reply is sent when the application calls
+         * ProtocolConfigMemWriteHandler_complete_write().
+         *
+         * With OPENLCB_COMPILE_CONFIG_MEM_CACHE the library calls this only
+         * to write back merged cache lines: on Update Complete, after
+         * USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS without writes, before
+         * reboot, or when a line is evicted.  A PENDING answer then means the
+         * data was taken; there is no reply waiting on it.
+         *
+         * @return Number of bytes actually written, or CONFIG_MEM_ACCESS_PENDING
          */
     uint16_t (*config_mem_write)(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
 
@@ -625,6 +666,17 @@ extern void OpenLcbConfig_100ms_timer_tick(void);
      */
 extern uint8_t OpenLcbConfig_get_global_100ms_tick(void);
 
+    /**
+     * @brief Returns the library millisecond clock.
+     *
+     * @details The user's get_time_ms when provided, otherwise built from the
+     * 100ms tick in 100 ms steps.  Used by wiring code the same way as
+     * OpenLcbConfig_get_global_100ms_tick().
+     *
+     * @return Milliseconds (wraps at 2^32).
+     */
+extern uint32_t OpenLcbConfig_get_time_ms(void);
+
     /**
      * @brief Allocates and registers a new node on the OpenLCB network.
      *
@@ -0,0 +1,540 @@
+/** \copyright
+ * Copyright (c) 2026, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file openlcb_config_mem_cache.c
+ * @brief Write-back cache between the config memory handlers and the
+ *        application's config_mem_read / config_mem_write.
+ *
+ * @details Each line caches one aligned block for one node and keeps a single
+ * contiguous dirty range [dirty_start, dirty_end).  Only that range is ever
+ * written back, so bytes of the block the protocol never touched are never
+ * read or rewritten unless they sit between two writes.  A line in use always
+ * has a non-empty dirty range; flushing a line frees it.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#include "openlcb_config_mem_cache.h"
+
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "openlcb_defines.h"
+#include "openlcb_timer.h"
+
+    /** @brief One cached block of a node's config memory. */
+typedef struct {
+
+    openlcb_node_t *openlcb_node;   /**< @brief Owner; NULL when the line is free. */
+    uint32_t base;                  /**< @brief Address of data[0], a multiple of the line size. */
+    uint16_t dirty_start;           /**< @brief First byte not yet written back. */
+    uint16_t dirty_end;             /**< @brief One past the last byte not yet written back. */
+    uint32_t last_write;            /**< @brief _write_sequence of the latest write, for eviction. */
+    uint8_t data[USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE];  /**< @brief Block contents. */
+
+} config_mem_cache_line_t;
+
+/** @brief Saved pointer to the dependency-injected cache interface. */
+static const interface_openlcb_config_mem_cache_t *_interface;
+
+/** @brief Cache lines. */
+static config_mem_cache_line_t _lines[USER_DEFINED_CONFIG_MEM_CACHE_LINES];
+
+/** @brief Bumped on every cached write; the line with the oldest value is evicted first. */
+static uint32_t _write_sequence;
+
+/** @brief Flushes everything once writes have stopped for USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS. */
+static openlcb_timer_t _idle_timer;
+
+    /** @brief True if the line is in use and belongs to openlcb_node (any node when NULL). */
+static bool _is_match(config_mem_cache_line_t *line, openlcb_node_t *openlcb_node) {
+
+    return line->openlcb_node && (!openlcb_node || line->openlcb_node == openlcb_node);
+
+}
+
+    /**
+     * @brief Registers the interface and empties the cache without writing anything.
+     *
+     * @verbatim
+     * @param interface  Pointer to a populated interface_openlcb_config_mem_cache_t.
+     * @endverbatim
+     */
+void OpenLcbConfigMemCache_initialize(const interface_openlcb_config_mem_cache_t *interface) {
+
+    _interface = interface;
+    _write_sequence = 0;
+
+    memset(_lines, 0, sizeof(_lines));
+    memset(&_idle_timer, 0, sizeof(_idle_timer));
+
+}
+
+    /** @brief Returns the line caching the block at base for the node, or NULL. */
+static config_mem_cache_line_t *_find_line(openlcb_node_t *openlcb_node, uint32_t base) {
+
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_CACHE_LINES; i++) {
+
+        if (_lines[i].openlcb_node == openlcb_node && _lines[i].base == base) {
+
+            return &_lines[i];
+
+        }
+
+    }
+
+    return NULL;
+
+}
+
+    /**
+     * @brief Writes a line's dirty range to storage in one call.
+     *
+     * @details A CONFIG_MEM_ACCESS_PENDING answer counts as written: the
+     * application has copied the data and finishes the write on its own.
+     *
+     * @return true if storage accepted every dirty byte.
+     */
+static bool _write_back(config_mem_cache_line_t *line) {
+
+    uint16_t count = line->dirty_end - line->dirty_start;
+
+    uint16_t written = _interface->config_memory_write(
+            line->openlcb_node,
+            line->base + line->dirty_start,
+            count,
+            (configuration_memory_buffer_t *) &line->data[line->dirty_start]);
+
+    return (written == CONFIG_MEM_ACCESS_PENDING) || (written >= count);
+
+}
+
+    /** @brief Writes a line back and frees it; a failed write leaves it dirty. */
+static bool _flush_line(config_mem_cache_line_t *line) {
+
+    if (!_write_back(line)) {
+
+        return false;
+
+    }
+
+    line->openlcb_node = NULL;
+
+    return true;
+
+}
+
+    /**
+     * @brief Takes a line for a block, evicting the least recently written one if all are busy.
+     *
+     * @details Algorithm:
+     * -# Use a free line if there is one
+     * -# Otherwise flush the line written longest ago; give up if that fails
+     * -# Claim it with an empty dirty range
+     *
+     * @return The line, or NULL if nothing could be freed.
+     */
+static config_mem_cache_line_t *_claim_line(openlcb_node_t *openlcb_node, uint32_t base) {
+
+    config_mem_cache_line_t *line = NULL;
+
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_CACHE_LINES; i++) {
+
+        if (!_lines[i].openlcb_node) {
+
+            line = &_lines[i];
+
+            break;
+
+        }
+
+        if (!line || (_write_sequence - _lines[i].last_write) > (_write_sequence - line->last_write)) {
+
+            line = &_lines[i];
+
+        }
+
+    }
+
+    if (line->openlcb_node && !_flush_line(line)) {
+
+        return NULL;
+
+    }
+
+    line->openlcb_node = openlcb_node;
+    line->base = base;
+    line->dirty_start = 0;
+    line->dirty_end = 0;
+
+    return line;
+
+}
+
+    /**
+     * @brief Makes [start, end) contiguous with the line's dirty range.
+     *
+     * @details Algorithm:
+     * -# Nothing to do if the range is empty, overlaps or touches the new bytes
+     * -# Otherwise read the gap between them from storage into the line
+     * -# If storage cannot supply it, write the current range back and empty
+     *    it so the new bytes start a fresh range
+     *
+     * @return false if the line could neither be extended nor written back.
+     */
+static bool _join_dirty_range(config_mem_cache_line_t *line, uint16_t start, uint16_t end) {
+
+    uint16_t gap_start;
+    uint16_t gap_end;
+
+    if (line->dirty_end == line->dirty_start) {
+
+        return true;
+
+    }
+
+    if (start > line->dirty_end) {
+
+        gap_start = line->dirty_end;
+        gap_end = start;
+
+    } else if (end < line->dirty_start) {
+
+        gap_start = end;
+        gap_end = line->dirty_start;
+
+    } else {
+
+        return true;
+
+    }
+
+    uint16_t count = gap_end - gap_start;
+
+    if (_interface->config_memory_read(line->openlcb_node, line->base + gap_start, count, (configuration_memory_buffer_t *) &line->data[gap_start]) == count) {
+
+        return true;
+
+    }
+
+    if (!_write_back(line)) {
+
+        return false;
+
+    }
+
+    line->dirty_start = 0;
+    line->dirty_end = 0;
+
+    return true;
+
+}
+
+    /**
+     * @brief Caches a write that falls inside one block.
+     *
+     * @details Algorithm:
+     * -# Find or claim the block's line
+     * -# Join the new bytes to its dirty range, copy them in and widen the range
+     * -# If no line can be had, or the range cannot be joined, write the bytes
+     *    straight to storage instead (they do not overlap anything cached)
+     *
+     * @return Bytes accepted.
+     */
+static uint16_t _write_block(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, const uint8_t *source) {
+
+    uint32_t base = address - (address % USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE);
+    uint16_t start = (uint16_t) (address - base);
+    uint16_t end = start + count;
+
+    config_mem_cache_line_t *line = _find_line(openlcb_node, base);
+
+    if (!line) {
+
+        line = _claim_line(openlcb_node, base);
+
+    }
+
+    if (!line || !_join_dirty_range(line, start, end)) {
+
+        uint16_t written = _interface->config_memory_write(openlcb_node, address, count, (configuration_memory_buffer_t *) source);
+
+        return (written == CONFIG_MEM_ACCESS_PENDING) ? count : written;
+
+    }
+
+    memcpy(&line->data[start], source, count);
+
+    if (line->dirty_end == line->dirty_start) {
+
+        line->dirty_start = start;
+        line->dirty_end = end;
+
+    } else {
+
+        if (start < line->dirty_start) {
+
+            line->dirty_start = start;
+
+        }
+
+        if (end > line->dirty_end) {
+
+            line->dirty_end = end;
+
+        }
+
+    }
+
+    _write_sequence++;
+    line->last_write = _write_sequence;
+
+    return count;
+
+}
+
+    /** @brief Idle timer callback: flush everything, try again later if storage refused. */
+static void _idle_timeout(void *context) {
+
+    (void) context;
+
+    if (!OpenLcbConfigMemCache_flush(NULL)) {
+
+        OpenLcbTimer_start(&_idle_timer, USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS, &_idle_timeout, NULL);
+
+    }
+
+}
+
+    /**
+     * @brief Stores a config memory write in the cache.
+     *
+     * @details Algorithm:
+     * -# Split the write at block boundaries and cache each piece
+     * -# Stop early if a piece written straight to storage came up short
+     * -# Restart the idle flush timer while anything is dirty
+     *
+     * @verbatim
+     * @param openlcb_node  Node whose memory is written.
+     * @param address       Start address.
+     * @param count         Bytes to write.
+     * @param buffer        Source.
+     * @endverbatim
+     *
+     * @return Bytes accepted.
+     */
+uint16_t OpenLcbConfigMemCache_write(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer) {
+
+    uint16_t done = 0;
+
+    while (done < count) {
+
+        uint32_t block_offset = (address + done) % USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE;
+        uint16_t piece = USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE - block_offset;
+
+        if (piece > count - done) {
+
+            piece = count - done;
+
+        }
+
+        uint16_t written = _write_block(openlcb_node, address + done, piece, &(*buffer)[done]);
+
+        done += written;
+
+        if (written < piece) {
+
+            break;
+
+        }
+
+    }
+
+    if (OpenLcbConfigMemCache_is_dirty(NULL)) {
+
+        OpenLcbTimer_start(&_idle_timer, USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS, &_idle_timeout, NULL);
+
+    }
+
+    return done;
+
+}
+
+    /**
+     * @brief Reads config memory, including bytes written but not yet flushed.
+     *
+     * @details Algorithm:
+     * -# If one line's dirty range holds every requested byte, copy it and
+     *    skip storage
+     * -# Otherwise write back every line of the node whose dirty range
+     *    overlaps the request, so storage holds those bytes even if its read
+     *    answers CONFIG_MEM_ACCESS_PENDING and is completed later from storage
+     * -# Fail the read (0 bytes) if one of them could not be written back
+     * -# Read storage, passing CONFIG_MEM_ACCESS_PENDING through
+     *
+     * @verbatim
+     * @param openlcb_node  Node whose memory is read.
+     * @param address       Start address.
+     * @param count         Bytes to read.
+     * @param buffer        Destination.
+     * @endverbatim
+     *
+     * @return Bytes read, 0 if dirty bytes could not be written back, or
+     *         CONFIG_MEM_ACCESS_PENDING.
+     */
+uint16_t OpenLcbConfigMemCache_read(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer) {
+
+    uint32_t base = address - (address % USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE);
+    uint32_t start = address - base;
+    config_mem_cache_line_t *line = _find_line(openlcb_node, base);
+
+    if (line && start >= line->dirty_start && start + count <= line->dirty_end) {
+
+        memcpy(buffer, &line->data[start], count);
+
+        return count;
+
+    }
+
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_CACHE_LINES; i++) {
+
+        line = &_lines[i];
+
+        if (line->openlcb_node != openlcb_node) {
+
+            continue;
+
+        }
+
+        uint32_t dirty_first = line->base + line->dirty_start;
+        uint32_t dirty_last = line->base + line->dirty_end;
+
+        if (dirty_first < dirty_last && dirty_first < address + count && address < dirty_last && !_flush_line(line)) {
+
+            return 0;
+
+        }
+
+    }
+
+    return _interface->config_memory_read(openlcb_node, address, count, buffer);
+
+}
+
+    /**
+     * @brief Writes dirty lines back to storage.
+     *
+     * @details Algorithm:
+     * -# Flush every line of the node (every line when NULL); a failed line
+     *    stays dirty and is tried again next time
+     * -# Stop the idle timer once nothing is dirty
+     *
+     * @verbatim
+     * @param openlcb_node  Node to flush, or NULL for every node.
+     * @endverbatim
+     *
+     * @return true if nothing dirty is left for the node(s).
+     */
+bool OpenLcbConfigMemCache_flush(openlcb_node_t *openlcb_node) {
+
+    bool result = true;
+
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_CACHE_LINES; i++) {
+
+        if (_is_match(&_lines[i], openlcb_node) && !_flush_line(&_lines[i])) {
+
+            result = false;
+
+        }
+
+    }
+
+    if (!OpenLcbConfigMemCache_is_dirty(NULL)) {
+
+        OpenLcbTimer_stop(&_idle_timer);
+
+    }
+
+    return result;
+
+}
+
+    /**
+     * @brief Drops a node's dirty lines without writing them.
+     *
+     * @verbatim
+     * @param openlcb_node  Node to drop, or NULL for every node.
+     * @endverbatim
+     */
+void OpenLcbConfigMemCache_discard(openlcb_node_t *openlcb_node) {
+
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_CACHE_LINES; i++) {
+
+        if (_is_match(&_lines[i], openlcb_node)) {
+
+            _lines[i].openlcb_node = NULL;
+
+        }
+
+    }
+
+    if (!OpenLcbConfigMemCache_is_dirty(NULL)) {
+
+        OpenLcbTimer_stop(&_idle_timer);
+
+    }
+
+}
+
+    /**
+     * @brief Returns true while any line of the node holds unwritten data.
+     *
+     * @verbatim
+     * @param openlcb_node  Node to check, or NULL for any node.
+     * @endverbatim
+     */
+bool OpenLcbConfigMemCache_is_dirty(openlcb_node_t *openlcb_node) {
+
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_CACHE_LINES; i++) {
+
+        if (_is_match(&_lines[i], openlcb_node)) {
+
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+#endif /* OPENLCB_COMPILE_CONFIG_MEM_CACHE */
@@ -0,0 +1,163 @@
+/** \copyright
+ * Copyright (c) 2026, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file openlcb_config_mem_cache.h
+ * @brief Write-back cache between the config memory handlers and the
+ *        application's config_mem_read / config_mem_write.
+ *
+ * @details A configuration tool writing a whole CDI sends dozens of small
+ * datagrams, often a few bytes each into the same EEPROM page, and each one
+ * used to cost a page program.  With OPENLCB_COMPILE_CONFIG_MEM_CACHE defined,
+ * OpenLcbConfig routes every config memory access through this module:
+ *
+ * - Writes land in RAM lines of USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE bytes,
+ *   aligned to that size.  Writes that overlap or touch the dirty bytes of a
+ *   line merge into one range; a gap between them is filled from storage.
+ * - Reads come straight from the line when it already holds every requested
+ *   byte.  Otherwise any dirty bytes they overlap are written back first and
+ *   the read goes to storage, so a read that storage leaves pending still
+ *   sees them when it completes.
+ * - A line is written back in one config_mem_write call on Update Complete,
+ *   USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS after the last write, before
+ *   a reboot, when a read overlaps it, or when its slot is needed for another
+ *   block.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __OPENLCB_OPENLCB_CONFIG_MEM_CACHE__
+#define __OPENLCB_OPENLCB_CONFIG_MEM_CACHE__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "openlcb_types.h"
+
+#ifdef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+
+    /**
+     * @brief Dependency-injection interface for the config memory cache.
+     *
+     * @see OpenLcbConfigMemCache_initialize
+     */
+typedef struct {
+
+        /** @brief REQUIRED. Reads the backing storage.  Typical impl: openlcb_config_t.config_mem_read. */
+    uint16_t (*config_memory_read)(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
+
+        /** @brief REQUIRED. Writes the backing storage.  Typical impl: openlcb_config_t.config_mem_write. */
+    uint16_t (*config_memory_write)(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
+
+} interface_openlcb_config_mem_cache_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+        /**
+         * @brief Registers the interface and empties the cache without writing anything.
+         *
+         * @param interface  Pointer to a populated @ref interface_openlcb_config_mem_cache_t.
+         *                   Must remain valid for the lifetime of the application.
+         *
+         * @warning Call after OpenLcbTimer_initialize().
+         * @warning NOT thread-safe - call during single-threaded initialization only.
+         */
+    extern void OpenLcbConfigMemCache_initialize(const interface_openlcb_config_mem_cache_t *interface);
+
+        /**
+         * @brief Reads config memory, including bytes written but not yet flushed.
+         *
+         * @details Same contract as config_mem_read, so it can be wired in its place.
+         * A read not served entirely from one line first writes the node's
+         * overlapping dirty bytes back, so a storage read left pending and
+         * completed later still returns them.
+         *
+         * @param openlcb_node  Node whose memory is read.
+         * @param address       Start address.
+         * @param count         Bytes to read.
+         * @param buffer        Destination.
+         *
+         * @return Bytes read, 0 if dirty bytes could not be written back, or
+         *         CONFIG_MEM_ACCESS_PENDING passed through from storage.
+         */
+    extern uint16_t OpenLcbConfigMemCache_read(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
+
+        /**
+         * @brief Stores a config memory write in the cache.
+         *
+         * @details Same contract as config_mem_write, so it can be wired in its
+         * place.  Restarts the idle flush timer.  When no line can be freed the
+         * write goes straight to storage.
+         *
+         * @param openlcb_node  Node whose memory is written.
+         * @param address       Start address.
+         * @param count         Bytes to write.
+         * @param buffer        Source.
+         *
+         * @return Bytes accepted; less than count only if a write-through to storage came up short.
+         */
+    extern uint16_t OpenLcbConfigMemCache_write(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
+
+        /**
+         * @brief Writes dirty lines back to storage.
+         *
+         * @details A line whose write answers CONFIG_MEM_ACCESS_PENDING counts as
+         * written; the application has taken a copy.  Lines whose write comes up
+         * short stay dirty for the next flush.
+         *
+         * @param openlcb_node  Node to flush, or NULL for every node.
+         *
+         * @return true if nothing dirty is left for the node(s).
+         */
+    extern bool OpenLcbConfigMemCache_flush(openlcb_node_t *openlcb_node);
+
+        /**
+         * @brief Drops a node's dirty lines without writing them.
+         *
+         * @details Used before a factory reset, which rewrites storage directly.
+         *
+         * @param openlcb_node  Node to drop, or NULL for every node.
+         */
+    extern void OpenLcbConfigMemCache_discard(openlcb_node_t *openlcb_node);
+
+        /**
+         * @brief Returns true while any line of the node holds unwritten data.
+         *
+         * @param openlcb_node  Node to check, or NULL for any node.
+         */
+    extern bool OpenLcbConfigMemCache_is_dirty(openlcb_node_t *openlcb_node);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* OPENLCB_COMPILE_CONFIG_MEM_CACHE */
+
+#endif /* __OPENLCB_OPENLCB_CONFIG_MEM_CACHE__ */
@@ -0,0 +1,479 @@
+/** \copyright
+* Copyright (c) 2026, Jim Kueneman
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  - Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+*  - Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* @file openlcb_config_mem_cache_Test.cxx
+* @brief Unit tests for the config memory write-back cache.
+*
+* @details Covers write merging (adjacent, overlapping, gap filled from
+* storage), writes spanning lines, reads that see dirty bytes (also when
+* storage answers pending), eviction, write-through when nothing can be
+* evicted, the idle flush timer, short and pending write-backs, and discard.
+* Uses the default 4 lines of 64 bytes.
+*
+* @author Jim Kueneman
+* @date 18 Oct 2026
+*/
+
+#include "test/main_Test.hxx"
+
+#include <string.h>
+
+#include "openlcb_config_mem_cache.h"
+#include "openlcb_defines.h"
+#include "openlcb_timer.h"
+
+// ============================================================================
+// Mock storage
+// ============================================================================
+
+#define STORAGE_SIZE 1024
+
+static uint8_t _storage[STORAGE_SIZE];
+
+static int _read_calls = 0;
+static int _write_calls = 0;
+static uint32_t _last_write_address = 0;
+static uint16_t _last_write_count = 0;
+
+static bool _read_pending = false;
+static bool _write_pending = false;
+static bool _write_short = false;
+
+static uint16_t _storage_read(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer) {
+
+    (void) openlcb_node;
+
+    _read_calls++;
+
+    if (_read_pending) {
+
+        return CONFIG_MEM_ACCESS_PENDING;
+
+    }
+
+    memcpy(buffer, &_storage[address], count);
+
+    return count;
+
+}
+
+static uint16_t _storage_write(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer) {
+
+    (void) openlcb_node;
+
+    _write_calls++;
+    _last_write_address = address;
+    _last_write_count = count;
+
+    if (_write_short) {
+
+        return 0;
+
+    }
+
+    memcpy(&_storage[address], buffer, count);
+
+    return _write_pending ? CONFIG_MEM_ACCESS_PENDING : count;
+
+}
+
+static const interface_openlcb_config_mem_cache_t _interface = {
+
+    .config_memory_read = &_storage_read,
+    .config_memory_write = &_storage_write,
+
+};
+
+// ============================================================================
+// Mock clock
+// ============================================================================
+
+static uint32_t _time_ms = 0;
+
+static uint8_t _get_current_tick(void) { return 0; }
+static uint32_t _get_time_ms(void) { return _time_ms; }
+
+static const interface_openlcb_timer_t _timer_interface = {
+
+    .get_current_tick = &_get_current_tick,
+    .get_time_ms = &_get_time_ms,
+
+};
+
+static openlcb_node_t _node_a;
+static openlcb_node_t _node_b;
+
+static void _reset(void) {
+
+    for (int i = 0; i < STORAGE_SIZE; i++) {
+
+        _storage[i] = (uint8_t) i;
+
+    }
+
+    _read_calls = 0;
+    _write_calls = 0;
+    _last_write_address = 0;
+    _last_write_count = 0;
+    _read_pending = false;
+    _write_pending = false;
+    _write_short = false;
+    _time_ms = 0;
+
+    OpenLcbTimer_initialize(&_timer_interface);
+    OpenLcbConfigMemCache_initialize(&_interface);
+
+}
+
+static uint16_t _write(openlcb_node_t *node, uint32_t address, uint16_t count, uint8_t value) {
+
+    configuration_memory_buffer_t buffer;
+
+    memset(buffer, value, sizeof(buffer));
+
+    return OpenLcbConfigMemCache_write(node, address, count, &buffer);
+
+}
+
+// ============================================================================
+// TEST: Adjacent and overlapping writes merge into one write-back
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, merge_adjacent_and_overlapping)
+{
+
+    _reset();
+
+    EXPECT_EQ(_write(&_node_a, 10, 4, 0xA1), 4);
+    EXPECT_EQ(_write(&_node_a, 14, 4, 0xA2), 4);
+    EXPECT_EQ(_write(&_node_a, 8, 4, 0xA3), 4);
+
+    EXPECT_EQ(_write_calls, 0);
+    EXPECT_EQ(_read_calls, 0);
+    EXPECT_TRUE(OpenLcbConfigMemCache_is_dirty(&_node_a));
+    EXPECT_FALSE(OpenLcbConfigMemCache_is_dirty(&_node_b));
+
+    EXPECT_TRUE(OpenLcbConfigMemCache_flush(&_node_a));
+
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_EQ(_last_write_address, 8u);
+    EXPECT_EQ(_last_write_count, 10);
+    EXPECT_EQ(_storage[8], 0xA3);
+    EXPECT_EQ(_storage[11], 0xA3);
+    EXPECT_EQ(_storage[12], 0xA1);
+    EXPECT_EQ(_storage[14], 0xA2);
+    EXPECT_EQ(_storage[17], 0xA2);
+    EXPECT_EQ(_storage[18], 18);
+    EXPECT_FALSE(OpenLcbConfigMemCache_is_dirty(NULL));
+
+}
+
+// ============================================================================
+// TEST: A gap between two writes in one line is filled from storage
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, gap_filled_from_storage)
+{
+
+    _reset();
+
+    _write(&_node_a, 4, 2, 0xB1);
+    _write(&_node_a, 20, 2, 0xB2);
+
+    EXPECT_EQ(_read_calls, 1);
+
+    OpenLcbConfigMemCache_flush(NULL);
+
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_EQ(_last_write_address, 4u);
+    EXPECT_EQ(_last_write_count, 18);
+    EXPECT_EQ(_storage[5], 0xB1);
+    EXPECT_EQ(_storage[6], 6);
+    EXPECT_EQ(_storage[19], 19);
+    EXPECT_EQ(_storage[20], 0xB2);
+
+}
+
+// ============================================================================
+// TEST: When the gap cannot be read the old range is written back first
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, gap_read_pending_writes_back_first)
+{
+
+    _reset();
+
+    _write(&_node_a, 4, 2, 0xB1);
+
+    _read_pending = true;
+    _write(&_node_a, 20, 2, 0xB2);
+
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_EQ(_last_write_address, 4u);
+    EXPECT_EQ(_last_write_count, 2);
+
+    OpenLcbConfigMemCache_flush(NULL);
+
+    EXPECT_EQ(_write_calls, 2);
+    EXPECT_EQ(_last_write_address, 20u);
+    EXPECT_EQ(_last_write_count, 2);
+
+}
+
+// ============================================================================
+// TEST: A write spanning a line boundary lands in two lines
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, write_spans_lines)
+{
+
+    _reset();
+
+    EXPECT_EQ(_write(&_node_a, 60, 8, 0xC1), 8);
+
+    OpenLcbConfigMemCache_flush(NULL);
+
+    EXPECT_EQ(_write_calls, 2);
+    EXPECT_EQ(_storage[59], 59);
+    EXPECT_EQ(_storage[60], 0xC1);
+    EXPECT_EQ(_storage[67], 0xC1);
+    EXPECT_EQ(_storage[68], 68);
+
+}
+
+// ============================================================================
+// TEST: Reads see dirty bytes; fully dirty reads skip storage
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, read_sees_dirty_bytes)
+{
+
+    _reset();
+
+    _write(&_node_a, 100, 8, 0xD1);
+    _write(&_node_b, 100, 8, 0xD2);
+
+    configuration_memory_buffer_t buffer;
+
+    // Entirely inside node A's dirty range: no storage access
+    EXPECT_EQ(OpenLcbConfigMemCache_read(&_node_a, 102, 4, &buffer), 4);
+    EXPECT_EQ(_read_calls, 0);
+    EXPECT_EQ(_write_calls, 0);
+    EXPECT_EQ(buffer[0], 0xD1);
+    EXPECT_EQ(buffer[3], 0xD1);
+
+    // Straddles the range: node A's line is written back, then storage read
+    EXPECT_EQ(OpenLcbConfigMemCache_read(&_node_a, 96, 16, &buffer), 16);
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_EQ(_last_write_address, 100u);
+    EXPECT_EQ(_read_calls, 1);
+    EXPECT_EQ(buffer[3], 99);
+    EXPECT_EQ(buffer[4], 0xD1);
+    EXPECT_EQ(buffer[11], 0xD1);
+    EXPECT_EQ(buffer[12], 108);
+    EXPECT_FALSE(OpenLcbConfigMemCache_is_dirty(&_node_a));
+    EXPECT_TRUE(OpenLcbConfigMemCache_is_dirty(&_node_b));
+
+    // Clear of every dirty range: nothing written back
+    EXPECT_EQ(OpenLcbConfigMemCache_read(&_node_b, 200, 8, &buffer), 8);
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_TRUE(OpenLcbConfigMemCache_is_dirty(&_node_b));
+
+}
+
+// ============================================================================
+// TEST: A storage read left pending still returns the written bytes
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, read_pending_after_write)
+{
+
+    _reset();
+
+    _write(&_node_a, 100, 8, 0xD1);
+
+    configuration_memory_buffer_t buffer;
+
+    _read_pending = true;
+
+    EXPECT_EQ(OpenLcbConfigMemCache_read(&_node_a, 96, 16, &buffer), CONFIG_MEM_ACCESS_PENDING);
+
+    // The application finishes the read from storage, which already has them
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_EQ(_storage[99], 99);
+    EXPECT_EQ(_storage[100], 0xD1);
+    EXPECT_EQ(_storage[107], 0xD1);
+    EXPECT_FALSE(OpenLcbConfigMemCache_is_dirty(NULL));
+
+    // Write-back refused: the read fails rather than return stale bytes
+    _read_pending = false;
+    _write_short = true;
+    _write(&_node_a, 300, 4, 0xD3);
+    _read_calls = 0;
+
+    EXPECT_EQ(OpenLcbConfigMemCache_read(&_node_a, 296, 16, &buffer), 0);
+    EXPECT_EQ(_read_calls, 0);
+    EXPECT_TRUE(OpenLcbConfigMemCache_is_dirty(&_node_a));
+
+}
+
+// ============================================================================
+// TEST: With every line busy the least recently written one is evicted
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, evicts_least_recently_written)
+{
+
+    _reset();
+
+    _write(&_node_a, 0, 1, 0xE0);
+    _write(&_node_a, 64, 1, 0xE1);
+    _write(&_node_a, 128, 1, 0xE2);
+    _write(&_node_a, 192, 1, 0xE3);
+    _write(&_node_a, 1, 1, 0xE0);      // line 0 is now the most recent
+
+    EXPECT_EQ(_write_calls, 0);
+
+    _write(&_node_a, 256, 1, 0xE4);
+
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_EQ(_last_write_address, 64u);
+    EXPECT_EQ(_storage[64], 0xE1);
+
+}
+
+// ============================================================================
+// TEST: When no line can be freed the write goes straight to storage
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, write_through_when_eviction_fails)
+{
+
+    _reset();
+
+    _write(&_node_a, 0, 1, 0xF0);
+    _write(&_node_a, 64, 1, 0xF1);
+    _write(&_node_a, 128, 1, 0xF2);
+    _write(&_node_a, 192, 1, 0xF3);
+
+    _write_short = true;
+    EXPECT_EQ(_write(&_node_a, 256, 2, 0xF4), 0);
+    EXPECT_EQ(_write_calls, 2);      // eviction attempt, then write-through
+    EXPECT_EQ(_last_write_address, 256u);
+
+    // Storage recovers: the oldest line is evicted and the write is cached
+    _write_short = false;
+    EXPECT_EQ(_write(&_node_a, 256, 2, 0xF4), 2);
+    EXPECT_EQ(_write_calls, 3);
+    EXPECT_EQ(_last_write_address, 0u);
+
+    configuration_memory_buffer_t buffer;
+
+    EXPECT_EQ(OpenLcbConfigMemCache_read(&_node_a, 256, 2, &buffer), 2);
+    EXPECT_EQ(buffer[1], 0xF4);
+
+}
+
+// ============================================================================
+// TEST: Idle timer flushes once writes stop, and retries on failure
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, idle_flush)
+{
+
+    _reset();
+
+    _write(&_node_a, 0, 4, 0x11);
+
+    _time_ms = USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS - 1;
+    _write(&_node_a, 4, 4, 0x12);    // restarts the timer
+
+    // Timers fire once their deadline is strictly in the past
+    _time_ms += USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS;
+    OpenLcbTimer_run();
+    EXPECT_EQ(_write_calls, 0);
+
+    _write_short = true;
+    _time_ms += 1;
+    OpenLcbTimer_run();
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_TRUE(OpenLcbConfigMemCache_is_dirty(NULL));
+
+    _write_short = false;
+    _time_ms += USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS + 1;
+    OpenLcbTimer_run();
+    EXPECT_EQ(_write_calls, 2);
+    EXPECT_EQ(_last_write_count, 8);
+    EXPECT_FALSE(OpenLcbConfigMemCache_is_dirty(NULL));
+
+}
+
+// ============================================================================
+// TEST: Short write-backs stay dirty; pending write-backs count as done
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, flush_short_and_pending)
+{
+
+    _reset();
+
+    _write(&_node_a, 0, 4, 0x21);
+
+    _write_short = true;
+    EXPECT_FALSE(OpenLcbConfigMemCache_flush(&_node_a));
+    EXPECT_TRUE(OpenLcbConfigMemCache_is_dirty(&_node_a));
+
+    _write_short = false;
+    _write_pending = true;
+    EXPECT_TRUE(OpenLcbConfigMemCache_flush(&_node_a));
+    EXPECT_FALSE(OpenLcbConfigMemCache_is_dirty(&_node_a));
+    EXPECT_EQ(_write_calls, 2);
+
+}
+
+// ============================================================================
+// TEST: Discard drops one node's lines without writing them
+// ============================================================================
+
+TEST(OpenLcbConfigMemCache, discard)
+{
+
+    _reset();
+
+    _write(&_node_a, 0, 4, 0x31);
+    _write(&_node_b, 0, 4, 0x32);
+
+    OpenLcbConfigMemCache_discard(&_node_a);
+
+    EXPECT_FALSE(OpenLcbConfigMemCache_is_dirty(&_node_a));
+    EXPECT_TRUE(OpenLcbConfigMemCache_is_dirty(&_node_b));
+
+    OpenLcbConfigMemCache_flush(NULL);
+
+    EXPECT_EQ(_write_calls, 1);
+    EXPECT_EQ(_storage[0], 0x32);
+
+}
@@ -0,0 +1,412 @@
+/** \copyright
+* Copyright (c) 2026, Jim Kueneman
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  - Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+*  - Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* @file openlcb_config_mem_cache_e2e_Test.cxx
+* @brief Integration tests: Config space datagrams through the write-back cache.
+*
+* @details The real read and write handlers are wired to OpenLcbConfigMemCache
+* in place of config_memory_read/config_memory_write, the way OpenLcbConfig
+* wires them when OPENLCB_COMPILE_CONFIG_MEM_CACHE is defined, with a RAM
+* array standing in for storage.  Built only against the config_mem_cache
+* user config.
+*
+* @author Jim Kueneman
+* @date 18 Oct 2026
+*/
+
+#include "test/main_Test.hxx"
+
+#include <string.h>
+
+#include "openlcb_config_mem_cache.h"
+#include "openlcb_timer.h"
+#include "protocol_config_mem_read_handler.h"
+#include "protocol_config_mem_write_handler.h"
+#include "openlcb_types.h"
+#include "openlcb_defines.h"
+#include "openlcb_node.h"
+#include "openlcb_utilities.h"
+#include "openlcb_buffer_store.h"
+#include "openlcb_buffer_fifo.h"
+
+#ifndef OPENLCB_COMPILE_CONFIG_MEM_CACHE
+#error "OPENLCB_COMPILE_CONFIG_MEM_CACHE must be defined in config_mem_cache config"
+#endif
+
+#define SOURCE_ALIAS 0x222
+#define SOURCE_ID 0x010203040506
+#define DEST_ALIAS 0xBBB
+#define DEST_ID 0x060504030201
+
+#define STORAGE_SIZE 1024
+
+// ============================================================================
+// Node parameters -- only the Config space (0xFD) is used
+// ============================================================================
+
+const node_parameters_t _node_parameters_main_node = {
+
+    .snip = {
+        .mfg_version = 4,
+        .name = "Cache E2E",
+        .model = "Cache E2E Model",
+        .hardware_version = "1.0",
+        .software_version = "1.0",
+        .user_version = 2
+    },
+
+    .protocol_support = (PSI_DATAGRAM | PSI_MEMORY_CONFIGURATION),
+
+    .consumer_count_autocreate = 0,
+    .producer_count_autocreate = 0,
+
+    .address_space_config_memory = {
+        .present = true,
+        .read_only = false,
+        .low_address_valid = false,
+        .address_space = CONFIG_MEM_SPACE_CONFIGURATION_MEMORY,
+        .highest_address = STORAGE_SIZE - 1,
+        .low_address = 0,
+        .description = "Configuration memory storage"
+    },
+
+};
+
+interface_openlcb_node_t interface_openlcb_node = {};
+
+// ============================================================================
+// Mock storage behind the cache
+// ============================================================================
+
+static uint8_t _storage[STORAGE_SIZE];
+
+static int _storage_write_calls = 0;
+static bool _storage_read_pending = false;
+
+static uint16_t _storage_read(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer) {
+
+    (void) openlcb_node;
+
+    if (_storage_read_pending) {
+
+        return CONFIG_MEM_ACCESS_PENDING;
+
+    }
+
+    memcpy(buffer, &_storage[address], count);
+
+    return count;
+
+}
+
+static uint16_t _storage_write(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer) {
+
+    (void) openlcb_node;
+
+    _storage_write_calls++;
+
+    memcpy(&_storage[address], buffer, count);
+
+    return count;
+
+}
+
+static const interface_openlcb_config_mem_cache_t _cache_interface = {
+
+    .config_memory_read = &_storage_read,
+    .config_memory_write = &_storage_write,
+
+};
+
+// ============================================================================
+// Mock clock
+// ============================================================================
+
+static uint8_t _get_current_tick(void) { return 0; }
+static uint32_t _get_time_ms(void) { return 0; }
+
+static const interface_openlcb_timer_t _timer_interface = {
+
+    .get_current_tick = &_get_current_tick,
+    .get_time_ms = &_get_time_ms,
+
+};
+
+// ============================================================================
+// Datagram acknowledge mocks
+// ============================================================================
+
+static uint16_t _datagram_rejected_code = 0;
+
+static void _load_datagram_received_ok_message(openlcb_statemachine_info_t *statemachine_info, uint16_t reply_pending_time_in_seconds) {
+
+    (void) statemachine_info;
+    (void) reply_pending_time_in_seconds;
+
+}
+
+static void _load_datagram_received_rejected_message(openlcb_statemachine_info_t *statemachine_info, uint16_t return_code) {
+
+    (void) statemachine_info;
+
+    _datagram_rejected_code = return_code;
+
+}
+
+// ============================================================================
+// Transmit mock for deferred replies
+// ============================================================================
+
+static openlcb_msg_t _sent_msg;
+static payload_datagram_t _sent_payload;
+static int _sent_count = 0;
+
+static bool _send_openlcb_msg(openlcb_msg_t *openlcb_msg) {
+
+    _sent_count++;
+    _sent_msg = *openlcb_msg;
+    memcpy(&_sent_payload, openlcb_msg->payload, sizeof(_sent_payload));
+    _sent_msg.payload = (openlcb_payload_t *) &_sent_payload;
+
+    return true;
+
+}
+
+static const interface_protocol_config_mem_read_handler_t _read_interface = {
+
+    .load_datagram_received_ok_message = &_load_datagram_received_ok_message,
+    .load_datagram_received_rejected_message = &_load_datagram_received_rejected_message,
+    .config_memory_read = &OpenLcbConfigMemCache_read,
+
+    .read_request_config_mem = &ProtocolConfigMemReadHandler_read_request_config_mem,
+
+    .send_openlcb_msg = &_send_openlcb_msg,
+
+};
+
+static const interface_protocol_config_mem_write_handler_t _write_interface = {
+
+    .load_datagram_received_ok_message = &_load_datagram_received_ok_message,
+    .load_datagram_received_rejected_message = &_load_datagram_received_rejected_message,
+
+    .config_memory_write = &OpenLcbConfigMemCache_write,
+    .config_memory_read = &OpenLcbConfigMemCache_read,
+
+    .write_request_config_mem = &ProtocolConfigMemWriteHandler_write_request_config_mem,
+
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static openlcb_node_t *_node;
+static openlcb_msg_t *_incoming_msg;
+static openlcb_msg_t *_outgoing_msg;
+static openlcb_statemachine_info_t _statemachine_info;
+
+static void _reset(void) {
+
+    for (int i = 0; i < STORAGE_SIZE; i++) {
+
+        _storage[i] = (uint8_t) i;
+
+    }
+
+    _storage_write_calls = 0;
+    _storage_read_pending = false;
+    _datagram_rejected_code = 0;
+    _sent_count = 0;
+
+    OpenLcbBufferStore_initialize();
+    OpenLcbBufferFifo_initialize();
+    OpenLcbNode_initialize(&interface_openlcb_node);
+    OpenLcbTimer_initialize(&_timer_interface);
+    OpenLcbConfigMemCache_initialize(&_cache_interface);
+    ProtocolConfigMemReadHandler_initialize(&_read_interface);
+    ProtocolConfigMemWriteHandler_initialize(&_write_interface);
+
+    _node = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    _node->alias = DEST_ALIAS;
+
+    _incoming_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    _outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+}
+
+static void _load_request(uint8_t command, uint32_t address) {
+
+    _statemachine_info.openlcb_node = _node;
+    _statemachine_info.incoming_msg_info.msg_ptr = _incoming_msg;
+    _statemachine_info.outgoing_msg_info.msg_ptr = _outgoing_msg;
+    _statemachine_info.outgoing_msg_info.valid = false;
+    _statemachine_info.incoming_msg_info.enumerate = false;
+
+    _incoming_msg->mti = MTI_DATAGRAM;
+    _incoming_msg->source_id = SOURCE_ID;
+    _incoming_msg->source_alias = SOURCE_ALIAS;
+    _incoming_msg->dest_id = DEST_ID;
+    _incoming_msg->dest_alias = DEST_ALIAS;
+    *_incoming_msg->payload[0] = CONFIG_MEM_CONFIGURATION;
+    *_incoming_msg->payload[1] = command;
+    OpenLcbUtilities_copy_dword_to_openlcb_payload(_incoming_msg, address, 2);
+
+}
+
+    // Write Config space: Datagram Received OK, then the write itself
+static void _write_config_mem(uint32_t address, const uint8_t *data, uint16_t count) {
+
+    _load_request(CONFIG_MEM_WRITE_SPACE_FD, address);
+
+    for (uint16_t i = 0; i < count; i++) {
+
+        *_incoming_msg->payload[6 + i] = data[i];
+
+    }
+
+    _incoming_msg->payload_count = 6 + count;
+
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&_statemachine_info);
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&_statemachine_info);
+
+}
+
+    // Read Config space: Datagram Received OK, then the read itself
+static void _read_config_mem(uint32_t address, uint8_t count) {
+
+    _load_request(CONFIG_MEM_READ_SPACE_FD, address);
+
+    *_incoming_msg->payload[6] = count;
+    _incoming_msg->payload_count = 7;
+
+    ProtocolConfigMemReadHandler_read_space_config_memory(&_statemachine_info);
+    ProtocolConfigMemReadHandler_read_space_config_memory(&_statemachine_info);
+
+}
+
+// ============================================================================
+// TEST: A written value reads back before it reaches storage
+// ============================================================================
+
+TEST(OpenLcbConfigMemCacheE2E, write_then_read_back_before_flush)
+{
+
+    _reset();
+
+    uint8_t data[4] = {0xA1, 0xA2, 0xA3, 0xA4};
+
+    _write_config_mem(0x20, data, 4);
+
+    EXPECT_TRUE(_statemachine_info.outgoing_msg_info.valid);
+    EXPECT_EQ(*_outgoing_msg->payload[1], CONFIG_MEM_WRITE_REPLY_OK_SPACE_FD);
+    EXPECT_EQ(_storage_write_calls, 0);
+    EXPECT_EQ(_storage[0x20], 0x20);
+    EXPECT_TRUE(OpenLcbConfigMemCache_is_dirty(_node));
+
+    // Read straddles the written bytes: dirty bytes laid over storage
+    _read_config_mem(0x1E, 8);
+
+    EXPECT_TRUE(_statemachine_info.outgoing_msg_info.valid);
+    EXPECT_EQ(*_outgoing_msg->payload[1], CONFIG_MEM_READ_REPLY_OK_SPACE_FD);
+    EXPECT_EQ(_outgoing_msg->payload_count, 6 + 8);
+    EXPECT_EQ(*_outgoing_msg->payload[6], 0x1E);
+    EXPECT_EQ(*_outgoing_msg->payload[7], 0x1F);
+    EXPECT_EQ(*_outgoing_msg->payload[8], 0xA1);
+    EXPECT_EQ(*_outgoing_msg->payload[11], 0xA4);
+    EXPECT_EQ(*_outgoing_msg->payload[12], 0x24);
+    EXPECT_EQ(*_outgoing_msg->payload[13], 0x25);
+
+    // Flush lands the write in storage as one write-back
+    EXPECT_TRUE(OpenLcbConfigMemCache_flush(_node));
+
+    EXPECT_EQ(_storage_write_calls, 1);
+    EXPECT_EQ(_storage[0x20], 0xA1);
+    EXPECT_EQ(_storage[0x23], 0xA4);
+    EXPECT_FALSE(OpenLcbConfigMemCache_is_dirty(NULL));
+
+}
+
+// ============================================================================
+// TEST: Back-to-back writes are merged into a single storage write
+// ============================================================================
+
+TEST(OpenLcbConfigMemCacheE2E, consecutive_writes_merge)
+{
+
+    _reset();
+
+    uint8_t first[2] = {0x11, 0x12};
+    uint8_t second[2] = {0x13, 0x14};
+
+    _write_config_mem(0x40, first, 2);
+    _write_config_mem(0x42, second, 2);
+
+    EXPECT_EQ(_storage_write_calls, 0);
+    EXPECT_EQ(_datagram_rejected_code, 0);
+
+    EXPECT_TRUE(OpenLcbConfigMemCache_flush(NULL));
+
+    EXPECT_EQ(_storage_write_calls, 1);
+    EXPECT_EQ(_storage[0x40], 0x11);
+    EXPECT_EQ(_storage[0x43], 0x14);
+    EXPECT_EQ(_storage[0x44], 0x44);
+
+}
+
+// ============================================================================
+// TEST: A read that storage leaves pending still returns the written bytes
+// ============================================================================
+
+TEST(OpenLcbConfigMemCacheE2E, write_then_pending_read_completes_with_written_bytes)
+{
+
+    _reset();
+
+    uint8_t data[4] = {0xC1, 0xC2, 0xC3, 0xC4};
+
+    _write_config_mem(0x80, data, 4);
+
+    EXPECT_EQ(_storage_write_calls, 0);
+
+    // Storage goes async: the read is parked with no reply
+    _storage_read_pending = true;
+    _read_config_mem(0x7E, 8);
+
+    EXPECT_FALSE(_statemachine_info.outgoing_msg_info.valid);
+    EXPECT_EQ(_sent_count, 0);
+
+    // The application finishes the read from its storage
+    EXPECT_TRUE(ProtocolConfigMemReadHandler_complete_read(_node, &_storage[0x7E], 8));
+
+    EXPECT_EQ(_sent_count, 1);
+    EXPECT_EQ(_sent_payload[1], CONFIG_MEM_READ_REPLY_OK_SPACE_FD);
+    EXPECT_EQ(_sent_msg.payload_count, 6 + 8);
+    EXPECT_EQ(_sent_payload[6], 0x7E);
+    EXPECT_EQ(_sent_payload[8], 0xC1);
+    EXPECT_EQ(_sent_payload[11], 0xC4);
+    EXPECT_EQ(_sent_payload[12], 0x84);
+
+}
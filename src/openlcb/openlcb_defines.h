@@ -1165,6 +1165,17 @@ extern "C" {
 
     /** @} */ // end of config_mem_reply_offsets
 
+/**
+ * @defgroup config_mem_access_status Configuration Memory Access Status
+ * @brief Special return value of the config_memory_read / config_memory_write callbacks.
+ * @{
+ */
+
+    /** @brief Access started but not finished; the result follows through a completion call */
+#define CONFIG_MEM_ACCESS_PENDING 0xFFFF
+
+    /** @} */ // end of config_mem_access_status
+
 /**
  * @defgroup config_options_bits Configuration Options Bit Flags
  * @brief Capability flags returned by Get Configuration Options.
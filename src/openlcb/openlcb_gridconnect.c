@@ -33,10 +33,15 @@
  *
  * Implementation features:
  * - Stateful streaming parser for byte-by-byte reception
+ * - Bulk parser decoding whole receive buffers straight into can_msg_t, with an
+ *   SSE2/NEON (or word-at-a-time) delimiter scan
  * - Automatic error detection and recovery
  * - Bidirectional conversion between CAN and GridConnect formats
+ * - Lookup-table hex encode/decode with no libc string calls
  * - No dynamic memory allocation
- * - Single-threaded design (not thread-safe)
+ * - Reentrant parser contexts (gridconnect_parser_t) for parsing several
+ *   streams at once; the byte parser and OpenLcbGridConnect_parse_buffer()
+ *   keep a single static context each
  *
  * The parser state machine handles:
  * - Message synchronization (finding ':X' start sequence)
@@ -67,9 +72,14 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
-#include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "openlcb_gridconnect.h"
 #include "openlcb_types.h"
 #include "../drivers/canbus/can_types.h"
@@ -83,10 +93,40 @@ static uint8_t _receive_buffer_index = 0;
     /** @brief Internal buffer for assembling incoming GridConnect messages. */
 static gridconnect_buffer_t _receive_buffer;
 
+    /** @brief Parser context behind OpenLcbGridConnect_parse_buffer(), independent of the byte parser's. */
+static gridconnect_parser_t _bulk_parser;
+
+    /** @brief Set in @ref _hex_decode entries that are valid hexadecimal digits. */
+#define GRIDCONNECT_HEX_VALID 0x10
+
+    /** @brief Nibble value of each ASCII character, OR'd with GRIDCONNECT_HEX_VALID for hex digits. */
+static const uint8_t _hex_decode[256] = {
+
+    ['0'] = 0x10, ['1'] = 0x11, ['2'] = 0x12, ['3'] = 0x13, ['4'] = 0x14,
+    ['5'] = 0x15, ['6'] = 0x16, ['7'] = 0x17, ['8'] = 0x18, ['9'] = 0x19,
+    ['A'] = 0x1A, ['B'] = 0x1B, ['C'] = 0x1C, ['D'] = 0x1D, ['E'] = 0x1E, ['F'] = 0x1F,
+    ['a'] = 0x1A, ['b'] = 0x1B, ['c'] = 0x1C, ['d'] = 0x1D, ['e'] = 0x1E, ['f'] = 0x1F,
+
+};
+
+    /** @brief Uppercase ASCII digit for each nibble value. */
+static const uint8_t _hex_encode[16] = {
+
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+
+};
+
     /** @brief Return true when the byte is a valid hexadecimal digit. */
 static bool _is_valid_hex_char(uint8_t next_byte) {
 
-    return (((next_byte >= '0') && (next_byte <= '9')) || ((next_byte >= 'A') && (next_byte <= 'F')) || ((next_byte >= 'a') && (next_byte <= 'f')));
+    return (_hex_decode[next_byte] & GRIDCONNECT_HEX_VALID) != 0;
+
+}
+
+    /** @brief Returns the value of a validated hexadecimal digit. */
+static uint8_t _hex_nibble(uint8_t hex_char) {
+
+    return _hex_decode[hex_char] & 0x0F;
 
 }
 
@@ -241,10 +281,11 @@ bool OpenLcbGridConnect_copy_out_gridconnect_when_done(uint8_t next_byte, gridco
     * @brief Converts a GridConnect message string to a CAN message structure.
     *
     * @details Algorithm:
+    * -# Find the terminating NUL, bounded by MAX_GRID_CONNECT_LEN
     * -# Validate message length is at least GRIDCONNECT_HEADER_LEN
-    * -# Extract 8-char hex identifier via strtoul()
+    * -# Shift the 8 identifier digits in through the nibble decode table
     * -# Calculate payload byte count from remaining hex characters
-    * -# Extract data bytes in pairs via strtoul()
+    * -# Decode data bytes in pairs through the same table
     *
     * Use cases:
     * - Processing received GridConnect messages from serial/TCP
@@ -263,10 +304,14 @@ bool OpenLcbGridConnect_copy_out_gridconnect_when_done(uint8_t next_byte, gridco
     */
 void OpenLcbGridConnect_to_can_msg(gridconnect_buffer_t *gridconnect_buffer, can_msg_t *can_msg) {
 
-    size_t message_length;
-    unsigned long data_char_count;
+    uint8_t *buffer = *gridconnect_buffer;
+    uint8_t message_length = 0;
+
+    while ((message_length < MAX_GRID_CONNECT_LEN) && (buffer[message_length] != 0)) {
 
-    message_length = strlen((char *)gridconnect_buffer);
+        message_length++;
+
+    }
 
     if (message_length < GRIDCONNECT_HEADER_LEN) {
 
@@ -276,37 +321,23 @@ void OpenLcbGridConnect_to_can_msg(gridconnect_buffer_t *gridconnect_buffer, can
 
     }
 
-    char identifier_str[GRIDCONNECT_IDENTIFIER_LEN + 1];
+    uint32_t identifier = 0;
 
     for (int i = GRIDCONNECT_IDENTIFIER_START_POS; i < GRIDCONNECT_IDENTIFIER_START_POS + GRIDCONNECT_IDENTIFIER_LEN; i++) {
 
-        identifier_str[i - GRIDCONNECT_IDENTIFIER_START_POS] = (*gridconnect_buffer)[i];
+        identifier = (identifier << 4) | _hex_nibble(buffer[i]);
 
     }
-    identifier_str[GRIDCONNECT_IDENTIFIER_LEN] = 0;
-
-    char hex_it[64] = "0x";
-    strcat(hex_it, identifier_str);
-    can_msg->identifier = (uint32_t)strtoul(hex_it, NULL, 0);
 
-    data_char_count = message_length - GRIDCONNECT_HEADER_LEN;
-    can_msg->payload_count = (uint8_t)(data_char_count / 2);
+    can_msg->identifier = identifier;
+    can_msg->payload_count = (uint8_t) ((message_length - GRIDCONNECT_HEADER_LEN) / 2);
 
-    char byte_str[3];
-    uint8_t byte;
-    int payload_index = 0;
-    int char_index = GRIDCONNECT_DATA_START_POS;
+    uint8_t *hex = &buffer[GRIDCONNECT_DATA_START_POS];
 
-    while (char_index < (int)(data_char_count + GRIDCONNECT_DATA_START_POS)) {
-
-        byte_str[0] = (*gridconnect_buffer)[char_index];
-        byte_str[1] = (*gridconnect_buffer)[char_index + 1];
-        byte_str[2] = 0;
+    for (int i = 0; i < can_msg->payload_count; i++) {
 
-        byte = (uint8_t)strtoul((char *)byte_str, NULL, 16);
-        can_msg->payload[payload_index] = byte;
-        payload_index++;
-        char_index += 2;
+        can_msg->payload[i] = (uint8_t) ((_hex_nibble(hex[0]) << 4) | _hex_nibble(hex[1]));
+        hex += 2;
 
     }
 
@@ -317,10 +348,10 @@ void OpenLcbGridConnect_to_can_msg(gridconnect_buffer_t *gridconnect_buffer, can
     *
     * @details Algorithm:
     * -# Write ":X" start sequence
-    * -# Format 32-bit CAN identifier as 8-char uppercase hex
-    * -# Append "N" normal priority flag
-    * -# Format each payload byte as 2-char uppercase hex
-    * -# Append ";" terminator
+    * -# Write the identifier as 8 uppercase hex digits, high nibble first, from the encode table
+    * -# Write "N" normal priority flag
+    * -# Write each payload byte as 2 uppercase hex digits
+    * -# Write ";" terminator and a NUL
     *
     * Use cases:
     * - Transmitting CAN messages over serial/TCP connections
@@ -331,30 +362,438 @@ void OpenLcbGridConnect_to_can_msg(gridconnect_buffer_t *gridconnect_buffer, can
     * @param can_msg Pointer to source CAN message structure to convert
     * @endverbatim
     *
+    * @return Length of the GridConnect string, not counting the NUL.
+    *
     * @warning Pointers must NOT be NULL
     * @warning Payload count must not exceed 8
     *
     * @see OpenLcbGridConnect_to_can_msg - Reverse conversion
     */
-void OpenLcbGridConnect_from_can_msg(gridconnect_buffer_t *gridconnect_buffer, can_msg_t *can_msg) {
+uint8_t OpenLcbGridConnect_from_can_msg(gridconnect_buffer_t *gridconnect_buffer, can_msg_t *can_msg) {
 
-    char temp_str[9];
+    uint8_t *out = *gridconnect_buffer;
+    uint32_t identifier = can_msg->identifier;
 
-    (*gridconnect_buffer)[0] = 0;
-    strcat((char *)gridconnect_buffer, ":");
-    strcat((char *)gridconnect_buffer, "X");
+    out[0] = ':';
+    out[1] = 'X';
 
-    sprintf(temp_str, "%08lX", (unsigned long)can_msg->identifier);
-    strcat((char *)gridconnect_buffer, temp_str);
-    strcat((char *)gridconnect_buffer, "N");
+    for (int i = GRIDCONNECT_IDENTIFIER_START_POS + GRIDCONNECT_IDENTIFIER_LEN - 1; i >= GRIDCONNECT_IDENTIFIER_START_POS; i--) {
+
+        out[i] = _hex_encode[identifier & 0x0F];
+        identifier >>= 4;
+
+    }
+
+    out[GRIDCONNECT_NORMAL_FLAG_POS] = 'N';
+
+    uint8_t *hex = &out[GRIDCONNECT_DATA_START_POS];
 
     for (int i = 0; i < can_msg->payload_count; i++) {
 
-        sprintf(temp_str, "%02X", can_msg->payload[i]);
-        strcat((char *)gridconnect_buffer, temp_str);
+        hex[0] = _hex_encode[can_msg->payload[i] >> 4];
+        hex[1] = _hex_encode[can_msg->payload[i] & 0x0F];
+        hex += 2;
+
+    }
+
+    hex[0] = ';';
+    hex[1] = 0;
+
+    return (uint8_t) (hex - out + 1);
+
+}
+
+// ---- Bulk parser ----
+
+    /** @brief Largest write position before the byte parser gives up on a frame. */
+#define GRIDCONNECT_MAX_INDEX (MAX_GRID_CONNECT_LEN - 1)
+
+    /**
+     * @brief Returns the offset of the first byte equal to first or second.
+     *
+     * @details 16 bytes per step with SSE2 or NEON when the compiler targets
+     * them, otherwise 4 bytes per step with the classic "has zero byte" word
+     * trick, then a byte loop for the tail.
+     *
+     * @verbatim
+     * @param data    Bytes to search.
+     * @param len     Number of bytes.
+     * @param first   Delimiter to find.
+     * @param second  Alternative delimiter (pass first again for one).
+     * @endverbatim
+     *
+     * @return Offset of the match, or len if there is none.
+     */
+static size_t _find_delimiter(const uint8_t *data, size_t len, uint8_t first, uint8_t second) {
+
+    size_t offset = 0;
+
+#if defined(__SSE2__)
+
+    __m128i match_first = _mm_set1_epi8((char) first);
+    __m128i match_second = _mm_set1_epi8((char) second);
+
+    while (offset + 16 <= len) {
+
+        __m128i block = _mm_loadu_si128((const __m128i *) (data + offset));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, match_first), _mm_cmpeq_epi8(block, match_second)));
+
+        if (mask != 0) {
+
+            return offset + (size_t) __builtin_ctz((unsigned int) mask);
+
+        }
+
+        offset += 16;
+
+    }
+
+#elif defined(__ARM_NEON)
+
+    uint8x16_t match_first = vdupq_n_u8(first);
+    uint8x16_t match_second = vdupq_n_u8(second);
+
+    while (offset + 16 <= len) {
+
+        uint8x16_t block = vld1q_u8(data + offset);
+        uint64x2_t hits = vreinterpretq_u64_u8(vorrq_u8(vceqq_u8(block, match_first), vceqq_u8(block, match_second)));
+
+        if ((vgetq_lane_u64(hits, 0) | vgetq_lane_u64(hits, 1)) != 0) {
+
+            break;  // the byte loop below pinpoints it within these 16
+
+        }
+
+        offset += 16;
+
+    }
+
+#else
+
+    uint32_t pattern_first = 0x01010101UL * first;
+    uint32_t pattern_second = 0x01010101UL * second;
+
+    while (offset + 4 <= len) {
+
+        uint32_t word;
+        memcpy(&word, data + offset, sizeof(word));
+
+        uint32_t diff_first = word ^ pattern_first;
+        uint32_t diff_second = word ^ pattern_second;
+
+        if ((((diff_first - 0x01010101UL) & ~diff_first) | ((diff_second - 0x01010101UL) & ~diff_second)) & 0x80808080UL) {
+
+            break;  // the byte loop below pinpoints it within these 4
+
+        }
+
+        offset += 4;
+
+    }
+
+#endif
+
+    while (offset < len) {
+
+        if ((data[offset] == first) || (data[offset] == second)) {
+
+            return offset;
+
+        }
+
+        offset++;
+
+    }
+
+    return len;
+
+}
+
+    /** @brief Stores one data digit at position digit of the frame being decoded. */
+static void _store_data_nibble(can_msg_t *can_msg, uint8_t digit, uint8_t hex_char) {
+
+    uint8_t byte_index = digit >> 1;
+
+    if (byte_index >= LEN_CAN_BYTE_ARRAY) {
+
+        return;  // overlong frame, rejected by the length rules before it completes
+
+    }
+
+    if ((digit & 0x01) == 0) {
+
+        can_msg->payload[byte_index] = (uint8_t) (_hex_nibble(hex_char) << 4);
+
+    } else {
+
+        can_msg->payload[byte_index] |= _hex_nibble(hex_char);
+
+    }
+
+}
+
+    /**
+     * @brief Runs the header state over as many bytes as it needs.
+     *
+     * @details Applies the byte parser's rules: hex digits are shifted into the
+     * identifier, 'N'/'n' is accepted only after exactly 8 of them, anything
+     * else (including a 9th digit's successor) is consumed and resets to
+     * SYNC_START.
+     *
+     * @return Bytes consumed.
+     */
+static size_t _bulk_find_header(gridconnect_parser_t *parser, const uint8_t *data, size_t len) {
+
+    size_t offset = 0;
+
+    while ((offset < len) && (parser->state == GRIDCONNECT_STATE_SYNC_FIND_HEADER)) {
+
+        uint8_t next_byte = data[offset];
+        offset++;
+
+        if (parser->index > GRIDCONNECT_NORMAL_FLAG_POS) {
+
+            parser->state = GRIDCONNECT_STATE_SYNC_START;
+
+        } else if ((next_byte == 'N') || (next_byte == 'n')) {
+
+            if (parser->index == GRIDCONNECT_NORMAL_FLAG_POS) {
+
+                parser->index++;
+                parser->can_msg.payload_count = 0;
+                parser->state = GRIDCONNECT_STATE_SYNC_FIND_DATA;
+
+            } else {
+
+                parser->state = GRIDCONNECT_STATE_SYNC_START;
+
+            }
+
+        } else if (_is_valid_hex_char(next_byte)) {
+
+            parser->can_msg.identifier = (parser->can_msg.identifier << 4) | _hex_nibble(next_byte);
+            parser->index++;
+
+        } else {
+
+            parser->state = GRIDCONNECT_STATE_SYNC_START;
+
+        }
+
+    }
+
+    return offset;
+
+}
+
+    /**
+     * @brief Runs the data state: scans for ';', validates and decodes the digits before it.
+     *
+     * @details Algorithm:
+     * -# Limit the window to the bytes the length rule still allows
+     * -# Find ';' in the window with the delimiter scan
+     * -# Decode the digits up to it; a non-hex byte is consumed and resets
+     * -# If no ';' was found and the window reached the length limit, reset
+     * -# On ';' with an even digit count, set payload_count and report the frame
+     *
+     * @verbatim
+     * @param parser      Context being advanced.
+     * @param data        Bytes after the ones already consumed.
+     * @param len         Number of bytes.
+     * @param is_frame    Set true when parser->can_msg holds a completed frame.
+     * @endverbatim
+     *
+     * @return Bytes consumed.
+     */
+static size_t _bulk_find_data(gridconnect_parser_t *parser, const uint8_t *data, size_t len, bool *is_frame) {
+
+    size_t room = (size_t) (GRIDCONNECT_MAX_INDEX - parser->index + 1);
+    size_t window = (len < room) ? len : room;
+    size_t terminator = _find_delimiter(data, window, ';', ';');
+
+    for (size_t i = 0; i < terminator; i++) {
+
+        if (!_is_valid_hex_char(data[i])) {
+
+            parser->state = GRIDCONNECT_STATE_SYNC_START;
+
+            return i + 1;
+
+        }
+
+        _store_data_nibble(&parser->can_msg, (uint8_t) (parser->index - GRIDCONNECT_DATA_START_POS), data[i]);
+        parser->index++;
+
+    }
+
+    if (terminator == window) {
+
+        if (parser->index > GRIDCONNECT_MAX_INDEX) {
+
+            parser->state = GRIDCONNECT_STATE_SYNC_START;
+
+        }
+
+        return window;
+
+    }
+
+    parser->state = GRIDCONNECT_STATE_SYNC_START;
+
+    if (((parser->index + 1) % 2) == 0) {
+
+        parser->can_msg.payload_count = (uint8_t) ((parser->index - GRIDCONNECT_DATA_START_POS) / 2);
+        *is_frame = true;
+
+    }
+
+    return terminator + 1;
+
+}
+
+    /**
+     * @brief Advances a context until one frame completes or the bytes run out.
+     *
+     * @details Algorithm:
+     * -# SYNC_START: skip to the next 'X'/'x' with the delimiter scan
+     * -# FIND_HEADER: shift the identifier digits in, expect 'N' after 8
+     * -# FIND_DATA: scan for ';', decode the digits before it
+     * -# Stop as soon as a frame completes so the caller can hand it on
+     *
+     * @verbatim
+     * @param parser  Context being advanced.
+     * @param data    Received bytes.
+     * @param len     Number of bytes.
+     * @param offset  In: first unconsumed byte.  Out: first byte after the ones consumed.
+     * @endverbatim
+     *
+     * @return true if parser->can_msg holds a completed frame.
+     */
+static bool _parse_next(gridconnect_parser_t *parser, const uint8_t *data, size_t len, size_t *offset) {
+
+    bool is_frame = false;
+
+    while ((*offset < len) && !is_frame) {
+
+        switch (parser->state) {
+
+            case GRIDCONNECT_STATE_SYNC_FIND_HEADER:
+
+                *offset += _bulk_find_header(parser, data + *offset, len - *offset);
+
+                break;
+
+            case GRIDCONNECT_STATE_SYNC_FIND_DATA:
+
+                *offset += _bulk_find_data(parser, data + *offset, len - *offset, &is_frame);
+
+                break;
+
+            default:
+
+                *offset += _find_delimiter(data + *offset, len - *offset, 'X', 'x');
+
+                if (*offset < len) {
+
+                    (*offset)++;
+                    parser->index = GRIDCONNECT_IDENTIFIER_START_POS;
+                    parser->can_msg.identifier = 0;
+                    parser->state = GRIDCONNECT_STATE_SYNC_FIND_HEADER;
+
+                }
+
+                break;
+
+        }
+
+    }
+
+    return is_frame;
+
+}
+
+    /**
+     * @brief Parses a buffer of GridConnect text, calling on_can_msg for every complete frame.
+     *
+     * @details Runs the static context through _parse_next() until the buffer
+     * is used up; a partial frame carries over to the next call.  Accepts and
+     * rejects exactly the frames OpenLcbGridConnect_copy_out_gridconnect_when_done()
+     * would for the same byte stream.
+     *
+     * @verbatim
+     * @param data        Received bytes.
+     * @param len         Number of bytes.
+     * @param on_can_msg  Called with each decoded frame; the frame is reused after it returns.
+     * @endverbatim
+     *
+     * @return Number of frames decoded.
+     *
+     * @warning NOT thread-safe — uses a static parser context
+     */
+uint16_t OpenLcbGridConnect_parse_buffer(const uint8_t *data, size_t len, void (*on_can_msg)(can_msg_t *can_msg)) {
+
+    uint16_t frame_count = 0;
+    size_t offset = 0;
+
+    while (_parse_next(&_bulk_parser, data, len, &offset)) {
+
+        if (on_can_msg) {
+
+            on_can_msg(&_bulk_parser.can_msg);
+
+        }
+
+        frame_count++;
+
+    }
+
+    return frame_count;
+
+}
+
+    /** @brief Resets a parser context to SYNC_START and stores the caller's user_context. */
+void OpenLcbGridConnect_ctx_init(gridconnect_parser_t *ctx, void *user_context) {
+
+    ctx->state = GRIDCONNECT_STATE_SYNC_START;
+    ctx->index = 0;
+    ctx->can_msg.identifier = 0;
+    ctx->can_msg.payload_count = 0;
+    ctx->user_context = user_context;
+
+}
+
+    /**
+     * @brief Parses a buffer through one caller-owned context.
+     *
+     * @details Same rules as OpenLcbGridConnect_parse_buffer(), but all state
+     * lives in ctx, so each connection can be parsed on its own thread.
+     *
+     * @verbatim
+     * @param ctx         Context initialised with OpenLcbGridConnect_ctx_init().
+     * @param data        Received bytes.
+     * @param len         Number of bytes.
+     * @param on_can_msg  Called with ctx->user_context and each decoded frame.
+     * @endverbatim
+     *
+     * @return Number of frames decoded.
+     */
+uint16_t OpenLcbGridConnect_ctx_feed(gridconnect_parser_t *ctx, const uint8_t *data, size_t len, void (*on_can_msg)(void *user_context, can_msg_t *can_msg)) {
+
+    uint16_t frame_count = 0;
+    size_t offset = 0;
+
+    while (_parse_next(ctx, data, len, &offset)) {
+
+        if (on_can_msg) {
+
+            on_can_msg(ctx->user_context, &ctx->can_msg);
+
+        }
+
+        frame_count++;
 
     }
 
-    strcat((char *)gridconnect_buffer, ";");
+    return frame_count;
 
 }
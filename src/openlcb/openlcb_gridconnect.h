@@ -29,7 +29,8 @@
  *
  * @details Converts between @ref can_msg_t structures and the GridConnect ASCII
  * wire format (:X<8-hex-ID>N<hex-data>;).  Includes a streaming byte-at-a-time
- * parser with automatic error recovery for use over serial or TCP/IP links.
+ * parser with automatic error recovery for use over serial or TCP/IP links, a
+ * bulk buffer parser, and reentrant parser contexts for multi-port hubs.
  *
  * @author Jim Kueneman
  * @date 4 Mar 2026
@@ -42,6 +43,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #include "../drivers/canbus/can_types.h"
 
@@ -75,6 +77,24 @@
 /** @brief Type definition for GridConnect message buffer */
 typedef uint8_t gridconnect_buffer_t[MAX_GRID_CONNECT_LEN];
 
+    /**
+     * @brief One GridConnect stream's parser state.
+     *
+     * @details Give each serial port or socket its own context and feed it with
+     * OpenLcbGridConnect_ctx_feed(); contexts share nothing, so different
+     * connections can be parsed on different threads without a lock.
+     *
+     * @see OpenLcbGridConnect_ctx_init
+     */
+typedef struct gridconnect_parser_struct {
+
+    uint8_t state;          /**< @brief GRIDCONNECT_STATE_* */
+    uint8_t index;          /**< @brief Equivalent write position in a gridconnect_buffer_t (2 after ':X', 11 after 'N'). */
+    can_msg_t can_msg;      /**< @brief Frame being decoded. */
+    void *user_context;     /**< @brief Caller's pointer, passed back with each frame (e.g. the connection). */
+
+} gridconnect_parser_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -83,6 +103,7 @@ extern "C" {
          * @brief Feeds one byte into the streaming GridConnect parser.
          *
          * @details Uses static state — NOT thread-safe, single context only.
+         * Use a @ref gridconnect_parser_t context for several streams.
          * Malformed input resets the parser automatically.
          *
          * @param next_byte              Next byte from the incoming stream.
@@ -92,6 +113,48 @@ extern "C" {
          */
     extern bool OpenLcbGridConnect_copy_out_gridconnect_when_done(uint8_t next_byte, gridconnect_buffer_t *gridconnect_buffer);
 
+        /**
+         * @brief Parses a whole receive buffer and calls on_can_msg for each complete frame.
+         *
+         * @details Decodes straight into a @ref can_msg_t with no intermediate
+         * @ref gridconnect_buffer_t, finding delimiters 16 bytes at a time with
+         * SSE2/NEON where available.  Frames split across calls are carried over.
+         * Accepts exactly what OpenLcbGridConnect_copy_out_gridconnect_when_done()
+         * accepts.  Uses one static context — NOT thread-safe, single stream only;
+         * see OpenLcbGridConnect_ctx_feed() for several streams.
+         *
+         * @param data        Received bytes (need not be NUL-terminated).
+         * @param len         Number of bytes.
+         * @param on_can_msg  Called once per decoded frame; may be NULL to only count.
+         *
+         * @return Number of frames decoded from this buffer.
+         */
+    extern uint16_t OpenLcbGridConnect_parse_buffer(const uint8_t *data, size_t len, void (*on_can_msg)(can_msg_t *can_msg));
+
+        /**
+         * @brief Resets a parser context.
+         *
+         * @param ctx           Context to reset.
+         * @param user_context  Caller's pointer handed back with every frame; may be NULL.
+         */
+    extern void OpenLcbGridConnect_ctx_init(gridconnect_parser_t *ctx, void *user_context);
+
+        /**
+         * @brief Parses a receive buffer through one caller-owned context.
+         *
+         * @details Reentrant form of OpenLcbGridConnect_parse_buffer(): all state
+         * lives in ctx, so separate connections may be fed from separate threads.
+         * A context itself must only be fed from one thread at a time.
+         *
+         * @param ctx         Context set up by OpenLcbGridConnect_ctx_init().
+         * @param data        Received bytes.
+         * @param len         Number of bytes.
+         * @param on_can_msg  Called with ctx->user_context and each decoded frame; may be NULL.
+         *
+         * @return Number of frames decoded from this buffer.
+         */
+    extern uint16_t OpenLcbGridConnect_ctx_feed(gridconnect_parser_t *ctx, const uint8_t *data, size_t len, void (*on_can_msg)(void *user_context, can_msg_t *can_msg));
+
         /**
          * @brief Converts a validated GridConnect string to a @ref can_msg_t.
          *
@@ -105,14 +168,17 @@ extern "C" {
         /**
          * @brief Converts a @ref can_msg_t to a null-terminated GridConnect string.
          *
-         * @details Output is uppercase hex with leading zeros on the 8-char ID.
+         * @details Output is uppercase hex with leading zeros on the 8-char ID,
+         * written straight into the buffer from a nibble table.
          *
          * @param gridconnect_buffer     Destination buffer (>= MAX_GRID_CONNECT_LEN).
          * @param can_msg                Source CAN message.
          *
+         * @return Length of the string written, not counting the NUL.
+         *
          * @warning Payload count must not exceed 8 or buffer overflow will occur.
          */
-    extern void OpenLcbGridConnect_from_can_msg(gridconnect_buffer_t *gridconnect_buffer, can_msg_t *can_msg);
+    extern uint8_t OpenLcbGridConnect_from_can_msg(gridconnect_buffer_t *gridconnect_buffer, can_msg_t *can_msg);
 
 #ifdef __cplusplus
 }
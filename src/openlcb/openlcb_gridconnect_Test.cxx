@@ -8,6 +8,12 @@
 
 #include "test/main_Test.hxx"
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
 #include "openlcb_gridconnect.h"
 #include "openlcb_types.h"
 
@@ -770,3 +776,522 @@ TEST(OpenLcbGridConnect, all_ff_payload)
     EXPECT_EQ(can_msg_back.payload[1], 0xFF);
     EXPECT_EQ(can_msg_back.payload[2], 0xFF);
 }
+
+// ============================================================================
+// BULK PARSER
+// ============================================================================
+
+#define MAX_BULK_FRAMES 512
+
+static can_msg_t _bulk_frames[MAX_BULK_FRAMES];
+static int _bulk_frame_count = 0;
+
+static void _on_bulk_frame(can_msg_t *can_msg)
+{
+    if (_bulk_frame_count < MAX_BULK_FRAMES)
+    {
+        _bulk_frames[_bulk_frame_count] = *can_msg;
+    }
+    _bulk_frame_count++;
+}
+
+/** A non-hex byte drops any partial frame in both parsers. */
+static void _reset_parsers(void)
+{
+    gridconnect_buffer_t gridconnect_buffer;
+
+    OpenLcbGridConnect_parse_buffer((const uint8_t *)"G", 1, NULL);
+    OpenLcbGridConnect_copy_out_gridconnect_when_done('G', &gridconnect_buffer);
+    _bulk_frame_count = 0;
+}
+
+static uint16_t _parse_string(const char *text)
+{
+    return OpenLcbGridConnect_parse_buffer((const uint8_t *)text, strlen(text), &_on_bulk_frame);
+}
+
+/**
+ * @brief Bulk parser decodes several frames from one buffer
+ *
+ * Verifies:
+ * - Every frame in the buffer is reported, in order
+ * - Identifier and payload are decoded directly
+ * - Garbage and line endings between frames are skipped
+ */
+TEST(OpenLcbGridConnect, parse_buffer_many_frames)
+{
+    _reset_parsers();
+
+    EXPECT_EQ(_parse_string("junk:X19828BC7N06EB;\r\n:x19970bc7n;\n  :X195B4123N0102030405060708;"), 3);
+
+    ASSERT_EQ(_bulk_frame_count, 3);
+    EXPECT_EQ(_bulk_frames[0].identifier, 0x19828BC7u);
+    EXPECT_EQ(_bulk_frames[0].payload_count, 2);
+    EXPECT_EQ(_bulk_frames[0].payload[0], 0x06);
+    EXPECT_EQ(_bulk_frames[0].payload[1], 0xEB);
+    EXPECT_EQ(_bulk_frames[1].identifier, 0x19970BC7u);
+    EXPECT_EQ(_bulk_frames[1].payload_count, 0);
+    EXPECT_EQ(_bulk_frames[2].identifier, 0x195B4123u);
+    EXPECT_EQ(_bulk_frames[2].payload_count, 8);
+    EXPECT_EQ(_bulk_frames[2].payload[7], 0x08);
+}
+
+/**
+ * @brief Bulk parser carries a partial frame across calls
+ *
+ * Verifies:
+ * - A frame split at every possible point still decodes once
+ */
+TEST(OpenLcbGridConnect, parse_buffer_split_frames)
+{
+    const char *frame = ":X19A28640N0AFF3C;";
+    size_t len = strlen(frame);
+
+    for (size_t split = 0; split <= len; split++)
+    {
+        _reset_parsers();
+
+        OpenLcbGridConnect_parse_buffer((const uint8_t *)frame, split, &_on_bulk_frame);
+        OpenLcbGridConnect_parse_buffer((const uint8_t *)frame + split, len - split, &_on_bulk_frame);
+
+        ASSERT_EQ(_bulk_frame_count, 1) << "split at " << split;
+        EXPECT_EQ(_bulk_frames[0].identifier, 0x19A28640u);
+        EXPECT_EQ(_bulk_frames[0].payload_count, 3);
+        EXPECT_EQ(_bulk_frames[0].payload[2], 0x3C);
+    }
+}
+
+/**
+ * @brief Bulk parser rejects what the byte parser rejects
+ *
+ * Verifies:
+ * - Bad hex, short header, odd data count and overlong data are dropped
+ * - The next good frame still decodes
+ */
+TEST(OpenLcbGridConnect, parse_buffer_rejects_malformed)
+{
+    _reset_parsers();
+
+    EXPECT_EQ(_parse_string(":X19970GC7N;"), 0);
+    EXPECT_EQ(_parse_string(":X1997BC7N;"), 0);
+    EXPECT_EQ(_parse_string(":X19970BC7N06E;"), 0);
+    EXPECT_EQ(_parse_string(":X19970BC7N010203040506070809;"), 0);
+    EXPECT_EQ(_parse_string(":X19970BC7N0102030405060708090;"), 0);
+    EXPECT_EQ(_parse_string(":X19970BC7N06EB;"), 1);
+
+    ASSERT_EQ(_bulk_frame_count, 1);
+    EXPECT_EQ(_bulk_frames[0].identifier, 0x19970BC7u);
+}
+
+/**
+ * @brief Bulk parser matches the byte parser on random streams
+ *
+ * Verifies:
+ * - Random mixes of valid frames, truncated frames and noise, fed in random
+ *   chunk sizes, produce exactly the frames the byte parser produces
+ */
+TEST(OpenLcbGridConnect, parse_buffer_matches_byte_parser)
+{
+    static const char alphabet[] = ":XxNn;0123456789ABCDEFabcdefG \n";
+    static uint8_t stream[8192];
+    static can_msg_t expected[MAX_BULK_FRAMES];
+    uint32_t seed = 0xC0FFEE;
+
+    for (int trial = 0; trial < 20; trial++)
+    {
+        size_t len = 0;
+
+        while (len < sizeof(stream) - MAX_GRID_CONNECT_LEN)
+        {
+            seed = seed * 1103515245 + 12345;
+
+            if ((seed >> 16) % 3 == 0)
+            {
+                // Noise run
+                int noise = (int)((seed >> 8) % 6);
+                for (int i = 0; i < noise; i++)
+                {
+                    seed = seed * 1103515245 + 12345;
+                    stream[len++] = (uint8_t)alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+                }
+            }
+            else
+            {
+                // Valid frame, sometimes cut short
+                can_msg_t can_msg;
+                gridconnect_buffer_t text;
+
+                can_msg.identifier = seed & 0x1FFFFFFF;
+                can_msg.payload_count = (uint8_t)((seed >> 4) % 9);
+                for (int i = 0; i < 8; i++)
+                {
+                    can_msg.payload[i] = (uint8_t)(seed >> i);
+                }
+
+                uint8_t text_len = OpenLcbGridConnect_from_can_msg(&text, &can_msg);
+                if ((seed >> 20) % 7 == 0)
+                {
+                    text_len = (uint8_t)((seed >> 24) % text_len);
+                }
+
+                memcpy(&stream[len], text, text_len);
+                len += text_len;
+            }
+        }
+
+        // Reference: byte parser
+        gridconnect_buffer_t gridconnect_buffer;
+        int expected_count = 0;
+
+        _reset_parsers();
+
+        for (size_t i = 0; i < len; i++)
+        {
+            if (OpenLcbGridConnect_copy_out_gridconnect_when_done(stream[i], &gridconnect_buffer))
+            {
+                ASSERT_LT(expected_count, MAX_BULK_FRAMES);
+                OpenLcbGridConnect_to_can_msg(&gridconnect_buffer, &expected[expected_count]);
+                expected_count++;
+            }
+        }
+
+        // Bulk parser in random chunks
+        size_t offset = 0;
+        int reported = 0;
+
+        while (offset < len)
+        {
+            seed = seed * 1103515245 + 12345;
+            size_t chunk = 1 + (seed >> 16) % 97;
+            if (chunk > len - offset)
+            {
+                chunk = len - offset;
+            }
+
+            reported += OpenLcbGridConnect_parse_buffer(&stream[offset], chunk, &_on_bulk_frame);
+            offset += chunk;
+        }
+
+        ASSERT_EQ(_bulk_frame_count, expected_count) << "trial " << trial;
+        EXPECT_EQ(reported, expected_count);
+
+        for (int i = 0; i < expected_count; i++)
+        {
+            ASSERT_EQ(_bulk_frames[i].identifier, expected[i].identifier) << "trial " << trial << " frame " << i;
+            ASSERT_EQ(_bulk_frames[i].payload_count, expected[i].payload_count);
+            EXPECT_EQ(0, memcmp(_bulk_frames[i].payload, expected[i].payload, expected[i].payload_count));
+        }
+    }
+}
+
+// ============================================================================
+// PARSER CONTEXTS
+// ============================================================================
+
+struct test_port_t
+{
+    int id;
+    int frame_count;
+    can_msg_t frames[64];
+};
+
+static void _on_port_frame(void *user_context, can_msg_t *can_msg)
+{
+    test_port_t *port = (test_port_t *)user_context;
+
+    if (port->frame_count < 64)
+    {
+        port->frames[port->frame_count] = *can_msg;
+    }
+    port->frame_count++;
+}
+
+/**
+ * @brief Two contexts keep separate partial frames
+ *
+ * Verifies:
+ * - Interleaved halves of different frames on two ports decode correctly
+ * - Each frame is reported with its own port's user_context
+ */
+TEST(OpenLcbGridConnect, ctx_interleaved_ports)
+{
+    gridconnect_parser_t ctx_a;
+    gridconnect_parser_t ctx_b;
+    test_port_t port_a = {1, 0, {}};
+    test_port_t port_b = {2, 0, {}};
+
+    OpenLcbGridConnect_ctx_init(&ctx_a, &port_a);
+    OpenLcbGridConnect_ctx_init(&ctx_b, &port_b);
+
+    const char *a1 = ":X19A28";
+    const char *b1 = ":X195B4123N01";
+    const char *a2 = "640N0AFF;:X19170640N;";
+    const char *b2 = "02;";
+
+    EXPECT_EQ(OpenLcbGridConnect_ctx_feed(&ctx_a, (const uint8_t *)a1, strlen(a1), &_on_port_frame), 0);
+    EXPECT_EQ(OpenLcbGridConnect_ctx_feed(&ctx_b, (const uint8_t *)b1, strlen(b1), &_on_port_frame), 0);
+    EXPECT_EQ(OpenLcbGridConnect_ctx_feed(&ctx_a, (const uint8_t *)a2, strlen(a2), &_on_port_frame), 2);
+    EXPECT_EQ(OpenLcbGridConnect_ctx_feed(&ctx_b, (const uint8_t *)b2, strlen(b2), &_on_port_frame), 1);
+
+    ASSERT_EQ(port_a.frame_count, 2);
+    EXPECT_EQ(port_a.frames[0].identifier, 0x19A28640u);
+    EXPECT_EQ(port_a.frames[0].payload_count, 2);
+    EXPECT_EQ(port_a.frames[1].identifier, 0x19170640u);
+
+    ASSERT_EQ(port_b.frame_count, 1);
+    EXPECT_EQ(port_b.frames[0].identifier, 0x195B4123u);
+    EXPECT_EQ(port_b.frames[0].payload_count, 2);
+    EXPECT_EQ(port_b.frames[0].payload[1], 0x02);
+}
+
+/**
+ * @brief ctx_init drops a partial frame
+ */
+TEST(OpenLcbGridConnect, ctx_init_discards_partial_frame)
+{
+    gridconnect_parser_t ctx;
+    test_port_t port = {1, 0, {}};
+
+    OpenLcbGridConnect_ctx_init(&ctx, &port);
+    OpenLcbGridConnect_ctx_feed(&ctx, (const uint8_t *)":X19A2", 6, &_on_port_frame);
+
+    OpenLcbGridConnect_ctx_init(&ctx, &port);
+    OpenLcbGridConnect_ctx_feed(&ctx, (const uint8_t *)"8640N;", 6, &_on_port_frame);
+
+    EXPECT_EQ(port.frame_count, 0);
+    EXPECT_EQ(OpenLcbGridConnect_ctx_feed(&ctx, (const uint8_t *)":X19A28640N;", 12, NULL), 1);
+}
+
+/**
+ * @brief Separate contexts parse concurrently on separate threads
+ *
+ * Verifies:
+ * - No shared state: each thread decodes every one of its frames
+ */
+TEST(OpenLcbGridConnect, ctx_parallel_threads)
+{
+    static const int THREADS = 4;
+    static const int FRAMES = 2000;
+
+    struct worker_t
+    {
+        gridconnect_parser_t ctx;
+        uint32_t identifier_sum;
+        int frame_count;
+    };
+
+    static worker_t workers[THREADS];
+    std::thread threads[THREADS];
+
+    for (int t = 0; t < THREADS; t++)
+    {
+        workers[t].identifier_sum = 0;
+        workers[t].frame_count = 0;
+        OpenLcbGridConnect_ctx_init(&workers[t].ctx, &workers[t]);
+
+        threads[t] = std::thread([t]() {
+            worker_t *worker = &workers[t];
+
+            for (int i = 0; i < FRAMES; i++)
+            {
+                can_msg_t can_msg = {};
+                gridconnect_buffer_t text;
+
+                can_msg.identifier = (uint32_t)(t << 20) | (uint32_t)i;
+                can_msg.payload_count = (uint8_t)(i % 9);
+
+                uint8_t len = OpenLcbGridConnect_from_can_msg(&text, &can_msg);
+
+                // Feed in two pieces so state really carries between calls
+                OpenLcbGridConnect_ctx_feed(&worker->ctx, text, len / 2, [](void *user_context, can_msg_t *msg) {
+                    ((worker_t *)user_context)->identifier_sum += msg->identifier;
+                    ((worker_t *)user_context)->frame_count++;
+                });
+                OpenLcbGridConnect_ctx_feed(&worker->ctx, &text[len / 2], (size_t)(len - len / 2), [](void *user_context, can_msg_t *msg) {
+                    ((worker_t *)user_context)->identifier_sum += msg->identifier;
+                    ((worker_t *)user_context)->frame_count++;
+                });
+            }
+        });
+    }
+
+    for (int t = 0; t < THREADS; t++)
+    {
+        threads[t].join();
+    }
+
+    for (int t = 0; t < THREADS; t++)
+    {
+        uint32_t expected_sum = 0;
+
+        for (int i = 0; i < FRAMES; i++)
+        {
+            expected_sum += (uint32_t)(t << 20) | (uint32_t)i;
+        }
+
+        EXPECT_EQ(workers[t].frame_count, FRAMES);
+        EXPECT_EQ(workers[t].identifier_sum, expected_sum);
+    }
+}
+
+// ============================================================================
+// ENCODE/DECODE BENCHMARK - table codec against the former libc version
+// ============================================================================
+
+/** Former OpenLcbGridConnect_from_can_msg (strcat + sprintf), kept as the baseline. */
+static void _legacy_from_can_msg(gridconnect_buffer_t *gridconnect_buffer, can_msg_t *can_msg)
+{
+    char temp_str[9];
+
+    (*gridconnect_buffer)[0] = 0;
+    strcat((char *)gridconnect_buffer, ":X");
+    snprintf(temp_str, sizeof(temp_str), "%08lX", (unsigned long)can_msg->identifier);
+    strcat((char *)gridconnect_buffer, temp_str);
+    strcat((char *)gridconnect_buffer, "N");
+
+    for (int i = 0; i < can_msg->payload_count; i++)
+    {
+        snprintf(temp_str, sizeof(temp_str), "%02X", can_msg->payload[i]);
+        strcat((char *)gridconnect_buffer, temp_str);
+    }
+
+    strcat((char *)gridconnect_buffer, ";");
+}
+
+/** Former OpenLcbGridConnect_to_can_msg (strlen + strtoul), kept as the baseline. */
+static void _legacy_to_can_msg(gridconnect_buffer_t *gridconnect_buffer, can_msg_t *can_msg)
+{
+    size_t message_length = strlen((char *)gridconnect_buffer);
+
+    if (message_length < GRIDCONNECT_HEADER_LEN)
+    {
+        can_msg->identifier = 0;
+        can_msg->payload_count = 0;
+        return;
+    }
+
+    char hex_it[16] = "0x";
+    memcpy(&hex_it[2], &(*gridconnect_buffer)[GRIDCONNECT_IDENTIFIER_START_POS], GRIDCONNECT_IDENTIFIER_LEN);
+    hex_it[2 + GRIDCONNECT_IDENTIFIER_LEN] = 0;
+    can_msg->identifier = (uint32_t)strtoul(hex_it, NULL, 0);
+
+    size_t data_char_count = message_length - GRIDCONNECT_HEADER_LEN;
+    can_msg->payload_count = (uint8_t)(data_char_count / 2);
+
+    char byte_str[3] = {0, 0, 0};
+
+    for (int i = 0; i < can_msg->payload_count; i++)
+    {
+        byte_str[0] = (*gridconnect_buffer)[GRIDCONNECT_DATA_START_POS + i * 2];
+        byte_str[1] = (*gridconnect_buffer)[GRIDCONNECT_DATA_START_POS + i * 2 + 1];
+        can_msg->payload[i] = (uint8_t)strtoul(byte_str, NULL, 16);
+    }
+}
+
+#define BENCHMARK_FRAME_SET 256
+#define BENCHMARK_ROUNDS 400
+
+/** Frames of every payload length with pseudo-random identifiers and data. */
+static void _build_frame_set(can_msg_t *frames)
+{
+    uint32_t seed = 0x12345678;
+
+    for (int i = 0; i < BENCHMARK_FRAME_SET; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        frames[i].identifier = seed & 0x1FFFFFFF;
+        frames[i].payload_count = (uint8_t)(i % 9);
+
+        for (int j = 0; j < LEN_CAN_BYTE_ARRAY; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            frames[i].payload[j] = (uint8_t)(seed >> 16);
+        }
+    }
+}
+
+/**
+ * @brief Table codec matches the former libc codec
+ *
+ * Verifies:
+ * - Byte-identical GridConnect output and identical decoded frames
+ * - Returned length equals the string length
+ */
+TEST(OpenLcbGridConnect, table_codec_matches_libc)
+{
+    static can_msg_t frames[BENCHMARK_FRAME_SET];
+    gridconnect_buffer_t ours;
+    gridconnect_buffer_t legacy;
+    can_msg_t decoded;
+    can_msg_t legacy_decoded;
+
+    _build_frame_set(frames);
+
+    for (int i = 0; i < BENCHMARK_FRAME_SET; i++)
+    {
+        uint8_t length = OpenLcbGridConnect_from_can_msg(&ours, &frames[i]);
+        _legacy_from_can_msg(&legacy, &frames[i]);
+
+        ASSERT_STREQ((char *)ours, (char *)legacy);
+        EXPECT_EQ(length, strlen((char *)ours));
+
+        OpenLcbGridConnect_to_can_msg(&ours, &decoded);
+        _legacy_to_can_msg(&legacy, &legacy_decoded);
+
+        ASSERT_EQ(decoded.identifier, legacy_decoded.identifier);
+        ASSERT_EQ(decoded.payload_count, legacy_decoded.payload_count);
+        EXPECT_EQ(0, memcmp(decoded.payload, legacy_decoded.payload, decoded.payload_count));
+    }
+}
+
+/**
+ * @brief Prints frames/second for the table codec and the former libc codec
+ *
+ * Timing only, so it is disabled by default; run it with
+ * --gtest_also_run_disabled_tests --gtest_filter=*benchmark*
+ */
+TEST(OpenLcbGridConnect, DISABLED_benchmark_table_codec_against_libc)
+{
+    static can_msg_t frames[BENCHMARK_FRAME_SET];
+    gridconnect_buffer_t ours;
+    gridconnect_buffer_t legacy;
+    can_msg_t decoded;
+
+    _build_frame_set(frames);
+
+    volatile uint32_t sink = 0;
+    double seconds[2];
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (int round = 0; round < BENCHMARK_ROUNDS; round++)
+        {
+            for (int i = 0; i < BENCHMARK_FRAME_SET; i++)
+            {
+                if (pass == 0)
+                {
+                    _legacy_from_can_msg(&legacy, &frames[i]);
+                    _legacy_to_can_msg(&legacy, &decoded);
+                }
+                else
+                {
+                    OpenLcbGridConnect_from_can_msg(&ours, &frames[i]);
+                    OpenLcbGridConnect_to_can_msg(&ours, &decoded);
+                }
+
+                sink = sink + decoded.identifier;
+            }
+        }
+
+        seconds[pass] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double frames_run = (double)BENCHMARK_ROUNDS * BENCHMARK_FRAME_SET;
+
+    printf("    gridconnect encode+decode: libc %.0f frames/s, table %.0f frames/s (%.1fx)\n",
+           frames_run / seconds[0], frames_run / seconds[1], seconds[0] / seconds[1]);
+
+    (void)sink;
+}
@@ -123,6 +123,18 @@ static openlcb_worker_message_t _path_b_pending_msg;
 static openlcb_msg_t *_path_b_pending_ptr;
 static bool _path_b_pending;
 
+    /** @brief True while the popped incoming message still has to be offered to forward_incoming_msg. */
+static bool _forward_pending;
+
+// ---- Deferred enumeration (transport congested) ----
+
+    /** @brief Global message whose reply enumeration was set aside while the
+     *  transport was congested, so the receive path keeps moving.  NULL if none. */
+static openlcb_msg_t *_deferred_enumerate_msg;
+
+    /** @brief Node the deferred enumeration resumes on. */
+static openlcb_node_t *_deferred_enumerate_node;
+
     /**
     * @brief Stores the callback interface and wires up the outgoing message buffer.
     *
@@ -174,6 +186,11 @@ void OpenLcbMainStatemachine_initialize(const interface_openlcb_main_statemachin
     _path_b_pending_ptr->payload_type = WORKER;
     _path_b_pending = false;
 
+    _forward_pending = false;
+
+    _deferred_enumerate_msg = NULL;
+    _deferred_enumerate_node = NULL;
+
     // Sibling response queue
     for (int i = 0; i < SIBLING_RESPONSE_QUEUE_DEPTH; i++) {
 
@@ -1171,13 +1188,89 @@ bool OpenLcbMainStatemachine_handle_outgoing_openlcb_message(void) {
 
     return false;
 
+}
+
+    /** @brief Returns true if the transport asked for low-priority traffic to hold off. */
+static bool _is_transport_congested(void) {
+
+    return _interface->is_transport_congested && _interface->is_transport_congested();
+
+}
+
+    /**
+    * @brief Sets the current global message's enumeration aside so the next
+    * message can be popped.  Only one is held; the node enumerator position is
+    * rebuilt on resume.
+    *
+    * @return true if set aside.
+    */
+static bool _try_defer_enumeration(void) {
+
+    if (_deferred_enumerate_msg || !_statemachine_info.incoming_msg_info.msg_ptr ||
+            OpenLcbUtilities_is_addressed_openlcb_message(_statemachine_info.incoming_msg_info.msg_ptr)) {
+
+        return false;
+
+    }
+
+    _deferred_enumerate_msg = _statemachine_info.incoming_msg_info.msg_ptr;
+    _deferred_enumerate_node = _statemachine_info.openlcb_node;
+
+    _statemachine_info.incoming_msg_info.msg_ptr = NULL;
+    _statemachine_info.incoming_msg_info.enumerate = false;
+    _statemachine_info.openlcb_node = NULL;
+
+    return true;
+
+}
+
+    /**
+    * @brief Puts a deferred enumeration back into the idle main context.
+    *
+    * @details Walks the main node enumerator back to the node the enumeration
+    * stopped on so the remaining nodes still see the message afterwards.
+    */
+static void _resume_deferred_enumeration(void) {
+
+    openlcb_node_t *openlcb_node = _interface->openlcb_node_get_first(OPENLCB_MAIN_STATMACHINE_NODE_ENUMERATOR_INDEX);
+
+    while (openlcb_node && (openlcb_node != _deferred_enumerate_node)) {
+
+        openlcb_node = _interface->openlcb_node_get_next(OPENLCB_MAIN_STATMACHINE_NODE_ENUMERATOR_INDEX);
+
+    }
+
+    _statemachine_info.incoming_msg_info.msg_ptr = _deferred_enumerate_msg;
+    _statemachine_info.openlcb_node = openlcb_node;
+    _statemachine_info.current_tick = _interface->get_current_tick();
+    _statemachine_info.current_time_ms = _interface->get_time_ms();
+
+    _deferred_enumerate_msg = NULL;
+    _deferred_enumerate_node = NULL;
+
+    if (!openlcb_node) {
+
+        _free_incoming_message(&_statemachine_info); // node list changed under it
+
+        return;
+
+    }
+
+    _statemachine_info.incoming_msg_info.enumerate = true;
+
 }
 
     /**
     * @brief Re-dispatches the current message when a handler requests multi-message enumeration.
     *
     * @details Algorithm:
+    * -# If enumerate flag is set and the transport is congested, set a global
+    *    message's enumeration aside and return false so the next message is
+    *    popped; addressed enumerations (datagram replies, addressed Identify
+    *    Events) and a second global one carry on
     * -# If enumerate flag is set, call process_main_statemachine again
+    * -# With the main context idle and the load down, resume a deferred
+    *    enumeration before popping anything new
     * -# Return true while flag remains set, false when enumeration is complete
     *
     * @return true if re-enumeration active, false if complete
@@ -1186,6 +1279,12 @@ bool OpenLcbMainStatemachine_handle_try_reenumerate(void) {
 
     if (_statemachine_info.incoming_msg_info.enumerate) {
 
+        if (_is_transport_congested() && _try_defer_enumeration()) {
+
+            return false; // remaining replies wait; the receive path keeps moving
+
+        }
+
         // Continue the processing of the incoming message on the node
         _interface->process_main_statemachine(&_statemachine_info);
 
@@ -1193,6 +1292,14 @@ bool OpenLcbMainStatemachine_handle_try_reenumerate(void) {
 
     }
 
+    if (_deferred_enumerate_msg && !_statemachine_info.incoming_msg_info.msg_ptr && !_is_transport_congested()) {
+
+        _resume_deferred_enumeration();
+
+        return true;
+
+    }
+
     return false;
 
 }
@@ -1201,11 +1308,15 @@ bool OpenLcbMainStatemachine_handle_try_reenumerate(void) {
     * @brief Pops the next incoming message from the receive FIFO when idle.
     *
     * @details Algorithm:
-    * -# If already holding a message, return false
-    * -# Lock shared resources, pop from FIFO, unlock
-    * -# Return true if pop attempted (even if queue was empty), false if busy
+    * -# If not holding a message: lock shared resources, pop from FIFO, unlock;
+    *    return true if the queue was empty, otherwise mark it for forwarding
+    *    when forward_incoming_msg is wired
+    * -# While forwarding is pending, offer the message to forward_incoming_msg;
+    *    return true (hold it from the nodes) until it accepts
+    * -# Return false so node enumeration can proceed
     *
-    * @return true if pop attempted, false if still processing previous message
+    * @return true if pop attempted or forwarding is still pending, false if
+    *         the current message is ready for node dispatch
     */
 bool OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message(void) {
 
@@ -1225,8 +1336,27 @@ bool OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message(void)
         }
 
         _statemachine_info.current_tick = _interface->get_current_tick();
+        _statemachine_info.current_time_ms = _interface->get_time_ms();
+
+        if (!_statemachine_info.incoming_msg_info.msg_ptr) {
+
+            return true;
+
+        }
+
+        _forward_pending = (_interface->forward_incoming_msg != NULL);
+
+    }
+
+    if (_forward_pending) {
+
+        if (!_interface->forward_incoming_msg(_statemachine_info.incoming_msg_info.msg_ptr)) {
+
+            return true;
+
+        }
 
-        return (!_statemachine_info.incoming_msg_info.msg_ptr);
+        _forward_pending = false;
 
     }
 
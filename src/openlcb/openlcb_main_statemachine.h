@@ -70,6 +70,9 @@ typedef struct {
         /** @brief Return current value of the global 100ms tick counter.  REQUIRED. */
     uint8_t (*get_current_tick)(void);
 
+        /** @brief Return the millisecond clock.  REQUIRED.  Typical: OpenLcbTimer_get_time_ms. */
+    uint32_t (*get_time_ms)(void);
+
     // =========================================================================
     // Node Enumeration (all REQUIRED)
     // =========================================================================
@@ -377,6 +380,39 @@ typedef struct {
     bool (*is_emergency_event)(event_id_t event_id);
 #endif /* OPENLCB_COMPILE_TRAIN */
 
+    // =========================================================================
+    // Optional Transport Load Feedback (NULL = never defer)
+    // =========================================================================
+
+        /**
+         * @brief Test whether the transport is too busy for low-priority traffic.
+         *
+         * @details While it returns true, the reply enumeration of a global
+         *          message (e.g. Identify Events) is set aside and resumed once
+         *          it returns false; messages received meanwhile are still
+         *          popped and dispatched.  Addressed enumerations are not held.
+         *          Typical: CanBusMonitor_is_congested.
+         *
+         * @return true to defer low-priority enumeration this pass.
+         */
+    bool (*is_transport_congested)(void);
+
+    // =========================================================================
+    // Optional Router Hook (NULL = single transport, nothing forwarded)
+    // =========================================================================
+
+        /**
+         * @brief Offer each received message to the transport router.
+         *
+         * @details Called for every message popped from the incoming FIFO,
+         *          before any node sees it.  Returning false holds the message
+         *          (the far link is busy) and it is offered again on the next
+         *          run.  Typical: OpenLcbRouter_forward_incoming_msg.
+         *
+         * @return true once the message needs no further forwarding.
+         */
+    bool (*forward_incoming_msg)(openlcb_msg_t *msg);
+
 } interface_openlcb_main_statemachine_t;
 
 #ifdef __cplusplus
@@ -125,6 +125,8 @@ bool train_emergency_event_handler_called = false;
 bool load_datagram_rejected_called = false;
 bool force_is_last_node = false;
 bool train_search_handler_set_valid = false;
+bool transport_congested = false;
+bool verify_node_id_addressed_handler_called = false;
 
 // Static dummy train state for tests
 static train_state_t _dummy_train_state;
@@ -229,6 +231,20 @@ uint8_t _mock_get_current_tick(void)
 
 }
 
+uint32_t _mock_get_time_ms(void)
+{
+
+    return (uint32_t) _test_global_100ms_tick * 100;
+
+}
+
+bool _mock_is_transport_congested(void)
+{
+
+    return transport_congested;
+
+}
+
 // ============================================================================
 // Mock Protocol Handlers - SNIP
 // ============================================================================
@@ -260,6 +276,7 @@ void _ProtocolMessageNetwork_initialization_complete_simple(openlcb_statemachine
 void _ProtocolMessageNetwork_handle_verify_node_id_addressed(openlcb_statemachine_info_t *statemachine_info)
 {
     _update_called_function_ptr((void *)&_ProtocolMessageNetwork_handle_verify_node_id_addressed);
+    verify_node_id_addressed_handler_called = true;
 }
 
 void _ProtocolMessageNetwork_handle_verify_node_id_global(openlcb_statemachine_info_t *statemachine_info)
@@ -754,6 +771,7 @@ const interface_openlcb_main_statemachine_t interface_openlcb_main_statemachine
     .unlock_shared_resources = &_ExampleDrivers_unlock_shared_resources,
     .send_openlcb_msg = &_CanTxStatemachine_send_openlcb_message,
     .get_current_tick = &_mock_get_current_tick,
+    .get_time_ms = &_mock_get_time_ms,
 
     // Node Enumeration (REQUIRED)
     .openlcb_node_get_first = &_OpenLcbNode_get_first,
@@ -840,7 +858,10 @@ const interface_openlcb_main_statemachine_t interface_openlcb_main_statemachine
     // Event Classification Filters
     .is_broadcast_time_event = &ProtocolBroadcastTimeHandler_is_time_event,
     .is_train_search_event = &ProtocolTrainSearchHandler_is_search_event,
-    .is_emergency_event = &ProtocolTrainHandler_is_emergency_event
+    .is_emergency_event = &ProtocolTrainHandler_is_emergency_event,
+
+    // Transport Back-Pressure
+    .is_transport_congested = &_mock_is_transport_congested
 };
 
 /**
@@ -854,6 +875,7 @@ const interface_openlcb_main_statemachine_t interface_openlcb_main_statemachine_
     .unlock_shared_resources = &_ExampleDrivers_unlock_shared_resources,
     .send_openlcb_msg = &_CanTxStatemachine_send_openlcb_message,
     .get_current_tick = &_mock_get_current_tick,
+    .get_time_ms = &_mock_get_time_ms,
 
     // Node Enumeration (REQUIRED)
     .openlcb_node_get_first = &_OpenLcbNode_get_first,
@@ -983,6 +1005,8 @@ void _reset_variables(void)
     load_datagram_rejected_called = false;
     force_is_last_node = false;
     train_search_handler_set_valid = false;
+    transport_congested = false;
+    verify_node_id_addressed_handler_called = false;
     memset(&_dummy_train_state, 0, sizeof(_dummy_train_state));
 }
 
@@ -1518,6 +1542,144 @@ TEST(OpenLcbMainStatemachine, handle_reenumerate_flag_clear)
     EXPECT_FALSE(process_statemachine_called);
 }
 
+// ============================================================================
+// TEST: handle_try_reenumerate - Congested global enumeration is set aside
+// ============================================================================
+
+TEST(OpenLcbMainStatemachine, handle_reenumerate_congested_defers_global)
+{
+    _global_initialize();
+
+    openlcb_statemachine_info_t *state = OpenLcbMainStatemachine_get_statemachine_info();
+
+    openlcb_node_t *node = OpenLcbNode_allocate(0x060504030201, &_node_parameters_main_node);
+    node->state.initialized = true;
+    node->state.run_state = RUNSTATE_RUN;
+    node->alias = 0xBBB;
+
+    openlcb_msg_t *global_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(global_msg, nullptr);
+    global_msg->mti = MTI_EVENTS_IDENTIFY;
+
+    state->incoming_msg_info.msg_ptr = global_msg;
+    state->incoming_msg_info.enumerate = true;
+    state->openlcb_node = node;
+    transport_congested = true;
+
+    bool result = OpenLcbMainStatemachine_handle_try_reenumerate();
+
+    // Slot released so the receive path keeps moving
+    EXPECT_FALSE(result);
+    EXPECT_FALSE(process_statemachine_called);
+    EXPECT_EQ(state->incoming_msg_info.msg_ptr, nullptr);
+    EXPECT_FALSE(state->incoming_msg_info.enumerate);
+    EXPECT_EQ(state->openlcb_node, nullptr);
+
+    // Still congested, nothing to resume
+    EXPECT_FALSE(OpenLcbMainStatemachine_handle_try_reenumerate());
+    EXPECT_EQ(state->incoming_msg_info.msg_ptr, nullptr);
+
+    // An addressed message received meanwhile is popped and dispatched
+    openlcb_msg_t *addressed_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(addressed_msg, nullptr);
+    addressed_msg->mti = MTI_VERIFY_NODE_ID_ADDRESSED;
+    addressed_msg->dest_alias = 0xBBB;
+    OpenLcbBufferFifo_push(addressed_msg);
+
+    node_get_first = node;
+    node_get_next = nullptr;
+
+    EXPECT_FALSE(OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message());
+    EXPECT_EQ(state->incoming_msg_info.msg_ptr, addressed_msg);
+
+    EXPECT_TRUE(OpenLcbMainStatemachine_handle_try_enumerate_first_node());
+    EXPECT_TRUE(process_statemachine_called);
+    EXPECT_TRUE(verify_node_id_addressed_handler_called);
+
+    EXPECT_TRUE(OpenLcbMainStatemachine_handle_try_enumerate_next_node());
+    EXPECT_EQ(state->incoming_msg_info.msg_ptr, nullptr);
+
+    // Congestion clears: the global enumeration resumes on the same node
+    transport_congested = false;
+    process_statemachine_called = false;
+
+    result = OpenLcbMainStatemachine_handle_try_reenumerate();
+
+    EXPECT_TRUE(result);
+    EXPECT_FALSE(process_statemachine_called);
+    EXPECT_EQ(state->incoming_msg_info.msg_ptr, global_msg);
+    EXPECT_TRUE(state->incoming_msg_info.enumerate);
+    EXPECT_EQ(state->openlcb_node, node);
+
+    EXPECT_TRUE(OpenLcbMainStatemachine_handle_try_reenumerate());
+    EXPECT_TRUE(process_statemachine_called);
+}
+
+// ============================================================================
+// TEST: handle_try_reenumerate - Congested addressed enumeration continues
+// ============================================================================
+
+TEST(OpenLcbMainStatemachine, handle_reenumerate_congested_addressed_continues)
+{
+    _global_initialize();
+
+    openlcb_statemachine_info_t *state = OpenLcbMainStatemachine_get_statemachine_info();
+
+    openlcb_node_t *node = OpenLcbNode_allocate(0x060504030201, &_node_parameters_main_node);
+    node->state.initialized = true;
+    node->state.run_state = RUNSTATE_RUN;
+    node->alias = 0xBBB;
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    msg->mti = MTI_VERIFY_NODE_ID_ADDRESSED;
+    msg->dest_alias = 0xBBB;
+
+    state->incoming_msg_info.msg_ptr = msg;
+    state->incoming_msg_info.enumerate = true;
+    state->openlcb_node = node;
+    transport_congested = true;
+
+    bool result = OpenLcbMainStatemachine_handle_try_reenumerate();
+
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(process_statemachine_called);
+    EXPECT_TRUE(verify_node_id_addressed_handler_called);
+    EXPECT_EQ(state->incoming_msg_info.msg_ptr, msg);
+}
+
+// ============================================================================
+// TEST: handle_try_reenumerate - Deferred node freed before resuming
+// ============================================================================
+
+TEST(OpenLcbMainStatemachine, handle_reenumerate_deferred_node_gone)
+{
+    _global_initialize();
+
+    openlcb_statemachine_info_t *state = OpenLcbMainStatemachine_get_statemachine_info();
+
+    openlcb_node_t *node = OpenLcbNode_allocate(0x060504030201, &_node_parameters_main_node);
+
+    openlcb_msg_t *msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(msg, nullptr);
+    msg->mti = MTI_EVENTS_IDENTIFY;
+
+    state->incoming_msg_info.msg_ptr = msg;
+    state->incoming_msg_info.enumerate = true;
+    state->openlcb_node = node;
+    transport_congested = true;
+
+    EXPECT_FALSE(OpenLcbMainStatemachine_handle_try_reenumerate());
+
+    transport_congested = false;
+    node_get_first = nullptr;
+
+    EXPECT_TRUE(OpenLcbMainStatemachine_handle_try_reenumerate());
+    EXPECT_EQ(state->incoming_msg_info.msg_ptr, nullptr);
+    EXPECT_FALSE(state->incoming_msg_info.enumerate);
+    EXPECT_EQ(OpenLcbBufferStore_basic_messages_allocated(), 0);
+}
+
 // ============================================================================
 // TEST: handle_try_pop - Message already present
 // ============================================================================
@@ -1586,6 +1748,60 @@ TEST(OpenLcbMainStatemachine, handle_pop_fifo_empty)
     EXPECT_EQ(state->incoming_msg_info.msg_ptr, nullptr);  // Still no message
 }
 
+// ============================================================================
+// TEST: handle_try_pop - Router hook holds the message until it is forwarded
+// ============================================================================
+
+static bool _forward_accept;
+static int _forward_calls;
+static openlcb_msg_t *_forward_last_msg;
+
+static bool _mock_forward_incoming_msg(openlcb_msg_t *msg)
+{
+    _forward_calls++;
+    _forward_last_msg = msg;
+
+    return _forward_accept;
+}
+
+TEST(OpenLcbMainStatemachine, handle_pop_holds_message_until_forwarded)
+{
+    _reset_variables();
+
+    static interface_openlcb_main_statemachine_t forwarding_interface;
+    forwarding_interface = interface_openlcb_main_statemachine;
+    forwarding_interface.forward_incoming_msg = &_mock_forward_incoming_msg;
+
+    OpenLcbMainStatemachine_initialize(&forwarding_interface);
+    OpenLcbNode_initialize(&interface_openlcb_node);
+    OpenLcbBufferStore_initialize();
+    OpenLcbBufferFifo_initialize();
+
+    _forward_accept = false;
+    _forward_calls = 0;
+    _forward_last_msg = nullptr;
+
+    openlcb_statemachine_info_t *state = OpenLcbMainStatemachine_get_statemachine_info();
+
+    openlcb_msg_t *fifo_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    ASSERT_NE(fifo_msg, nullptr);
+    fifo_msg->mti = MTI_VERIFIED_NODE_ID;
+    OpenLcbBufferFifo_push(fifo_msg);
+
+    // Far link busy: popped but held back from the nodes
+    EXPECT_TRUE(OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message());
+    EXPECT_EQ(state->incoming_msg_info.msg_ptr, fifo_msg);
+    EXPECT_EQ(_forward_last_msg, fifo_msg);
+    EXPECT_TRUE(OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message());
+    EXPECT_EQ(_forward_calls, 2);
+
+    // Forwarded: released to node dispatch and not offered again
+    _forward_accept = true;
+    EXPECT_FALSE(OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message());
+    EXPECT_FALSE(OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message());
+    EXPECT_EQ(_forward_calls, 3);
+}
+
 // ============================================================================
 // TEST: handle_try_pop - Invalid message discarded immediately
 // ============================================================================
@@ -4599,6 +4815,7 @@ static const interface_openlcb_main_statemachine_t _st_interface = {
     .unlock_shared_resources = &_ExampleDrivers_unlock_shared_resources,
     .send_openlcb_msg = &_st_wire_send,
     .get_current_tick = &_mock_get_current_tick,
+    .get_time_ms = &_mock_get_time_ms,
 
     // Real node enumeration
     .openlcb_node_get_first = &OpenLcbNode_get_first,
@@ -4619,6 +4836,15 @@ static const interface_openlcb_main_statemachine_t _st_interface = {
     .message_network_protocol_support_inquiry = &_st_log_handler,
     .message_network_protocol_support_reply = &_st_log_handler,
 
+    // Real internal handlers
+    .process_main_statemachine = &OpenLcbMainStatemachine_process_main_statemachine,
+    .does_node_process_msg = &OpenLcbMainStatemachine_does_node_process_msg,
+    .handle_outgoing_openlcb_message = &OpenLcbMainStatemachine_handle_outgoing_openlcb_message,
+    .handle_try_reenumerate = &OpenLcbMainStatemachine_handle_try_reenumerate,
+    .handle_try_pop_next_incoming_openlcb_message = &OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message,
+    .handle_try_enumerate_first_node = &OpenLcbMainStatemachine_handle_try_enumerate_first_node,
+    .handle_try_enumerate_next_node = &OpenLcbMainStatemachine_handle_try_enumerate_next_node,
+
     .snip_simple_node_info_request = &_st_log_handler,
     .snip_simple_node_info_reply = &_st_log_handler,
 
@@ -4655,15 +4881,6 @@ static const interface_openlcb_main_statemachine_t _st_interface = {
     .stream_data_proceed = &_st_log_handler,
     .stream_data_complete = &_st_log_handler,
 
-    // Real internal handlers
-    .process_main_statemachine = &OpenLcbMainStatemachine_process_main_statemachine,
-    .does_node_process_msg = &OpenLcbMainStatemachine_does_node_process_msg,
-    .handle_outgoing_openlcb_message = &OpenLcbMainStatemachine_handle_outgoing_openlcb_message,
-    .handle_try_reenumerate = &OpenLcbMainStatemachine_handle_try_reenumerate,
-    .handle_try_pop_next_incoming_openlcb_message = &OpenLcbMainStatemachine_handle_try_pop_next_incoming_openlcb_message,
-    .handle_try_enumerate_first_node = &OpenLcbMainStatemachine_handle_try_enumerate_first_node,
-    .handle_try_enumerate_next_node = &OpenLcbMainStatemachine_handle_try_enumerate_next_node,
-
 };
 
     /** @brief Initialize for sibling dispatch integration tests. */
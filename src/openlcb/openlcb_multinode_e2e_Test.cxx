@@ -228,6 +228,7 @@ static void _e2e_process_main_statemachine(openlcb_statemachine_info_t *si) {
 static void _e2e_lock(void) { }
 static void _e2e_unlock(void) { }
 static uint8_t _e2e_get_tick(void) { return 0; }
+static uint32_t _e2e_get_time_ms(void) { return 0; }
 static void _e2e_noop_handler(openlcb_statemachine_info_t *si) { (void)si; }
 
 static void _e2e_load_interaction_rejected(openlcb_statemachine_info_t *si) {
@@ -312,6 +313,7 @@ static const interface_openlcb_main_statemachine_t _e2e_main_interface = {
     .unlock_shared_resources = &_e2e_unlock,
     .send_openlcb_msg        = &_e2e_wire_send,
     .get_current_tick        = &_e2e_get_tick,
+    .get_time_ms             = &_e2e_get_time_ms,
 
     // Real node enumeration
     .openlcb_node_get_first  = &OpenLcbNode_get_first,
@@ -85,10 +85,20 @@ static void _clear_node(openlcb_node_t *openlcb_node) {
     openlcb_node->state.resend_datagram = false;
     openlcb_node->state.firmware_upgrade_active = false;
     openlcb_node->timerticks = 0;
+    openlcb_node->timer_ms = 0;
     openlcb_node->owner_node = 0;
     openlcb_node->index = 0;
 
-    openlcb_node->last_received_datagram = NULL;
+    for (int i = 0; i < USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH; i++) {
+
+        openlcb_node->outstanding_datagrams[i].datagram = NULL;
+        openlcb_node->outstanding_datagrams[i].heap_index = DATAGRAM_HEAP_INDEX_NONE;
+        openlcb_node->outstanding_datagrams[i].deadline_ms = 0;
+        openlcb_node->outstanding_datagrams[i].retry_count = 0;
+        openlcb_node->outstanding_datagrams[i].resend = false;
+
+    }
+
     openlcb_node->train_state = NULL;
 
     openlcb_node->consumers.count = 0;
@@ -0,0 +1,834 @@
+/** \copyright
+ * Copyright (c) 2026, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file openlcb_router.c
+ * @brief Forwards OpenLCB traffic between the CAN and TCP/IP transports.
+ *
+ * @details Keeps a proxy table of TCP nodes (with the CAN alias each one uses
+ * on the bus) and one learned consumer-event table per link.  Forwarding
+ * temporarily rewrites the addressing of the received message for the far
+ * transport and restores it afterwards.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#include "openlcb_router.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "openlcb_defines.h"
+#include "openlcb_types.h"
+#include "openlcb_utilities.h"
+
+
+/** @brief Saved pointer to the dependency-injected router interface. */
+static const interface_openlcb_router_t *_interface;
+
+/** @brief TCP nodes and their CAN proxy aliases. */
+static router_proxy_entry_t _proxies[USER_DEFINED_ROUTER_PROXY_DEPTH];
+
+/** @brief Consumed events learned from each link. */
+static router_event_filter_entry_t _filters[ROUTER_LINK_COUNT][USER_DEFINED_ROUTER_EVENT_FILTER_DEPTH];
+
+/** @brief Entries in use in each _filters row. */
+static uint16_t _filter_count[ROUTER_LINK_COUNT];
+
+/** @brief ROUTER_EVENT_FILTER_* per link. */
+static uint8_t _filter_state[ROUTER_LINK_COUNT];
+
+/** @brief Tick the Identify Events went onto each link (ROUTER_EVENT_FILTER_LEARNING). */
+static uint8_t _filter_learn_tick[ROUTER_LINK_COUNT];
+
+/** @brief Local message that reached CAN but not yet TCP; its retry skips CAN. */
+static openlcb_msg_t *_partial_msg;
+
+/** @brief Received message waiting for a busy far link. */
+static openlcb_msg_t *_retry_msg;
+
+/** @brief Tick _retry_msg was first offered. */
+static uint8_t _retry_start_tick;
+
+    /** @brief Empties one link's learned consumers and opens its filter. */
+static void _clear_event_filter(uint8_t link) {
+
+    _filter_count[link] = 0;
+    _filter_state[link] = ROUTER_EVENT_FILTER_OPEN;
+
+}
+
+    /**
+     * @brief Stores the interface pointer and clears all router state.
+     *
+     * @verbatim
+     * @param interface Pointer to the populated dependency-injection interface.
+     * @endverbatim
+     */
+void OpenLcbRouter_initialize(const interface_openlcb_router_t *interface) {
+
+    _interface = interface;
+
+    for (int i = 0; i < USER_DEFINED_ROUTER_PROXY_DEPTH; i++) {
+
+        _proxies[i].node_id = 0;
+        _proxies[i].alias = 0;
+        _proxies[i].is_announced = false;
+        _proxies[i].last_used_tick = 0;
+
+    }
+
+    for (uint8_t link = 0; link < ROUTER_LINK_COUNT; link++) {
+
+        _clear_event_filter(link);
+
+    }
+
+    _partial_msg = NULL;
+    _retry_msg = NULL;
+    _retry_start_tick = 0;
+
+}
+
+// =============================================================================
+// Event filter
+// =============================================================================
+
+    /**
+     * @brief Returns the don't-care bits of an Event ID range.
+     *
+     * @details A range is encoded by its trailing run of identical bits: the
+     * run, whether of 1s or 0s, covers every value of those bits.
+     *
+     * @verbatim
+     * @param event_id Range Event ID from a Range Identified message.
+     * @endverbatim
+     */
+static event_id_t _range_mask(event_id_t event_id) {
+
+    uint64_t low_bit = event_id & 0x01;
+    event_id_t mask = 0;
+
+    for (int i = 0; i < 64; i++) {
+
+        if (((event_id >> i) & 0x01) != low_bit) {
+
+            break;
+
+        }
+
+        mask = (mask << 1) | 0x01;
+
+    }
+
+    return mask;
+
+}
+
+    /** @brief Returns true if entry covers event_id. */
+static bool _filter_entry_matches(const router_event_filter_entry_t *entry, event_id_t event_id, event_id_t mask) {
+
+    return (entry->mask >= mask) && ((entry->event_id & ~entry->mask) == (event_id & ~entry->mask));
+
+}
+
+    /**
+     * @brief Records that a node on link consumes event_id (or the range).
+     *
+     * @details Algorithm:
+     * -# Ignore if an existing entry already covers it.
+     * -# Append it; when the table is full open the filter instead.
+     *
+     * @verbatim
+     * @param link     Link the Consumer Identified arrived on.
+     * @param event_id Event or range Event ID.
+     * @param mask     Don't-care bits (0 for a single event).
+     * @endverbatim
+     */
+static void _learn_consumer(uint8_t link, event_id_t event_id, event_id_t mask) {
+
+    for (uint16_t i = 0; i < _filter_count[link]; i++) {
+
+        if (_filter_entry_matches(&_filters[link][i], event_id, mask)) {
+
+            return;
+
+        }
+
+    }
+
+    if (_filter_count[link] >= USER_DEFINED_ROUTER_EVENT_FILTER_DEPTH) {
+
+        _filter_state[link] = ROUTER_EVENT_FILTER_OPEN;
+
+        return;
+
+    }
+
+    _filters[link][_filter_count[link]].event_id = event_id;
+    _filters[link][_filter_count[link]].mask = mask;
+    _filter_count[link]++;
+
+}
+
+    /**
+     * @brief Learns consumers from a message received on link.
+     *
+     * @verbatim
+     * @param link Link the message arrived on.
+     * @param msg  Received message.
+     * @endverbatim
+     */
+static void _learn_from(uint8_t link, openlcb_msg_t *msg) {
+
+    switch (msg->mti) {
+
+        case MTI_CONSUMER_IDENTIFIED_UNKNOWN:
+        case MTI_CONSUMER_IDENTIFIED_SET:
+        case MTI_CONSUMER_IDENTIFIED_CLEAR:
+        case MTI_CONSUMER_IDENTIFIED_RESERVED:
+
+            _learn_consumer(link, OpenLcbUtilities_extract_event_id_from_openlcb_payload(msg), 0);
+
+            break;
+
+        case MTI_CONSUMER_RANGE_IDENTIFIED: {
+
+            event_id_t event_id = OpenLcbUtilities_extract_event_id_from_openlcb_payload(msg);
+
+            _learn_consumer(link, event_id, _range_mask(event_id));
+
+            break;
+
+        }
+
+        default:
+
+            break;
+
+    }
+
+}
+
+    /**
+     * @brief Notes a message about to be sent onto link.
+     *
+     * @details An Identify Events makes every consumer on link answer, so its
+     * table is cleared and relearned from the replies.
+     *
+     * @verbatim
+     * @param link Link the message is going onto.
+     * @param msg  Outgoing message.
+     * @endverbatim
+     */
+static void _note_sent_to(uint8_t link, openlcb_msg_t *msg) {
+
+    if (msg->mti == MTI_EVENTS_IDENTIFY) {
+
+        _filter_count[link] = 0;
+        _filter_state[link] = ROUTER_EVENT_FILTER_LEARNING;
+        _filter_learn_tick[link] = _interface->get_current_tick();
+
+    }
+
+}
+
+    /**
+     * @brief Returns true if a message received elsewhere must be sent onto link.
+     *
+     * @details Only event reports are filtered; they pass while the filter is
+     * open or learning, or when a learned consumer covers the event.
+     *
+     * @verbatim
+     * @param link Link the message would go onto.
+     * @param msg  Received message.
+     * @endverbatim
+     */
+static bool _is_wanted_on(uint8_t link, openlcb_msg_t *msg) {
+
+    if ((msg->mti != MTI_PC_EVENT_REPORT) && (msg->mti != MTI_PC_EVENT_REPORT_WITH_PAYLOAD)) {
+
+        return true;
+
+    }
+
+    if (_filter_state[link] == ROUTER_EVENT_FILTER_LEARNING) {
+
+        if ((uint8_t) (_interface->get_current_tick() - _filter_learn_tick[link]) < USER_DEFINED_ROUTER_EVENT_LEARN_TICKS) {
+
+            return true;
+
+        }
+
+        _filter_state[link] = ROUTER_EVENT_FILTER_ARMED;
+
+    }
+
+    if (_filter_state[link] != ROUTER_EVENT_FILTER_ARMED) {
+
+        return true;
+
+    }
+
+    event_id_t event_id = OpenLcbUtilities_extract_event_id_from_openlcb_payload(msg);
+
+    for (uint16_t i = 0; i < _filter_count[link]; i++) {
+
+        if (_filter_entry_matches(&_filters[link][i], event_id, 0)) {
+
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+// =============================================================================
+// Proxy table
+// =============================================================================
+
+    /** @brief Returns the proxy slot for a TCP node, or NULL. */
+static router_proxy_entry_t *_find_proxy(node_id_t node_id) {
+
+    if (node_id == 0) {
+
+        return NULL;
+
+    }
+
+    for (int i = 0; i < USER_DEFINED_ROUTER_PROXY_DEPTH; i++) {
+
+        if (_proxies[i].node_id == node_id) {
+
+            return &_proxies[i];
+
+        }
+
+    }
+
+    return NULL;
+
+}
+
+    /** @brief Returns the proxy slot announced on CAN under alias, or NULL. */
+static router_proxy_entry_t *_find_proxy_by_alias(uint16_t alias) {
+
+    if (alias == 0) {
+
+        return NULL;
+
+    }
+
+    for (int i = 0; i < USER_DEFINED_ROUTER_PROXY_DEPTH; i++) {
+
+        if ((_proxies[i].alias == alias) && _proxies[i].is_announced) {
+
+            return &_proxies[i];
+
+        }
+
+    }
+
+    return NULL;
+
+}
+
+    /** @brief Releases a slot's alias (if any) and frees the slot. */
+static void _free_proxy(router_proxy_entry_t *proxy) {
+
+    if (proxy->alias != 0) {
+
+        _interface->proxy_alias_release(proxy->alias);
+
+    }
+
+    proxy->node_id = 0;
+    proxy->alias = 0;
+    proxy->is_announced = false;
+
+}
+
+    /**
+     * @brief Returns the slot for a TCP node, taking a free or the LRU slot if new.
+     *
+     * @details Algorithm:
+     * -# Return the existing slot, refreshing its LRU tick.
+     * -# Otherwise use the first free slot, or release the least recently used
+     *    one, and record node_id without an alias.
+     *
+     * @verbatim
+     * @param node_id TCP node seen as a message source.
+     * @endverbatim
+     */
+static router_proxy_entry_t *_touch_proxy(node_id_t node_id) {
+
+    uint8_t current_tick = _interface->get_current_tick();
+    router_proxy_entry_t *proxy = _find_proxy(node_id);
+
+    if (!proxy) {
+
+        router_proxy_entry_t *oldest = &_proxies[0];
+
+        for (int i = 0; i < USER_DEFINED_ROUTER_PROXY_DEPTH; i++) {
+
+            if (_proxies[i].node_id == 0) {
+
+                proxy = &_proxies[i];
+
+                break;
+
+            }
+
+            if ((uint8_t) (current_tick - _proxies[i].last_used_tick) > (uint8_t) (current_tick - oldest->last_used_tick)) {
+
+                oldest = &_proxies[i];
+
+            }
+
+        }
+
+        if (!proxy) {
+
+            proxy = oldest;
+            _free_proxy(proxy);
+
+        }
+
+        proxy->node_id = node_id;
+
+    }
+
+    proxy->last_used_tick = current_tick;
+
+    return proxy;
+
+}
+
+    /**
+     * @brief Makes sure a proxy has an announced CAN alias.
+     *
+     * @details Algorithm:
+     * -# Drop an alias that was lost to a duplicate.
+     * -# Claim one from the alias pool if the slot has none.
+     * -# Send its AMD if not done yet.
+     *
+     * @verbatim
+     * @param proxy Slot of the TCP node that is about to appear on CAN.
+     * @endverbatim
+     *
+     * @return true when the alias is usable, false to retry later.
+     */
+static bool _ensure_proxy_alias(router_proxy_entry_t *proxy) {
+
+    if ((proxy->alias != 0) && !_interface->proxy_alias_is_held(proxy->alias, proxy->node_id)) {
+
+        proxy->alias = 0;
+        proxy->is_announced = false;
+
+    }
+
+    if (proxy->alias == 0) {
+
+        proxy->alias = _interface->proxy_alias_claim(proxy->node_id);
+
+        if (proxy->alias == 0) {
+
+            return false;
+
+        }
+
+    }
+
+    if (!proxy->is_announced) {
+
+        proxy->is_announced = _interface->proxy_alias_announce(proxy->alias, proxy->node_id);
+
+    }
+
+    return proxy->is_announced;
+
+}
+
+// =============================================================================
+// Forwarding
+// =============================================================================
+
+    /**
+     * @brief Forwards a CAN message to TCP if it needs to cross.
+     *
+     * @details Algorithm:
+     * -# Learn consumers from it.
+     * -# Skip it if TCP is down or its source has no known Node ID.
+     * -# Addressed: skip unless the destination alias is a proxy; send with the
+     *    proxy's Node ID as destination.
+     * -# Global: skip event reports no TCP consumer wants.
+     *
+     * @verbatim
+     * @param msg Message received on CAN.
+     * @endverbatim
+     *
+     * @return false if TCP was busy.
+     */
+static bool _forward_to_tcp(openlcb_msg_t *msg) {
+
+    _learn_from(ROUTER_LINK_CAN, msg);
+
+    if (_interface->is_tcp_link_up && !_interface->is_tcp_link_up()) {
+
+        return true;
+
+    }
+
+    if (msg->source_id == 0) {
+
+        return true;
+
+    }
+
+    if (OpenLcbUtilities_is_addressed_openlcb_message(msg)) {
+
+        router_proxy_entry_t *proxy = _find_proxy_by_alias(msg->dest_alias);
+
+        if (!proxy) {
+
+            return true;
+
+        }
+
+        proxy->last_used_tick = _interface->get_current_tick();
+
+        node_id_t saved_dest_id = msg->dest_id;
+
+        msg->dest_id = proxy->node_id;
+        bool result = _interface->send_tcp_msg(msg);
+        msg->dest_id = saved_dest_id;
+
+        return result;
+
+    }
+
+    if (!_is_wanted_on(ROUTER_LINK_TCP, msg)) {
+
+        return true;
+
+    }
+
+    if (!_interface->send_tcp_msg(msg)) {
+
+        return false;
+
+    }
+
+    _note_sent_to(ROUTER_LINK_TCP, msg);
+
+    return true;
+
+}
+
+    /**
+     * @brief Forwards a TCP message to CAN if it needs to cross.
+     *
+     * @details Algorithm:
+     * -# Record the source as a TCP node and learn consumers from it.
+     * -# Addressed: skip if the destination is a local or TCP node.
+     * -# Global: skip event reports no CAN consumer wants.
+     * -# Make sure the source has an announced proxy alias, then send with it
+     *    (the CAN transmit path resolves the destination alias).
+     *
+     * @verbatim
+     * @param msg Message received on TCP.
+     * @endverbatim
+     *
+     * @return false if no proxy alias was ready or CAN was busy.
+     */
+static bool _forward_to_can(openlcb_msg_t *msg) {
+
+    if ((msg->source_id == 0) || _interface->openlcb_node_find_by_node_id(msg->source_id)) {
+
+        return true;
+
+    }
+
+    router_proxy_entry_t *proxy = _touch_proxy(msg->source_id);
+
+    _learn_from(ROUTER_LINK_TCP, msg);
+
+    if (OpenLcbUtilities_is_addressed_openlcb_message(msg)) {
+
+        if (_interface->openlcb_node_find_by_node_id(msg->dest_id) || _find_proxy(msg->dest_id)) {
+
+            return true;
+
+        }
+
+    } else if (!_is_wanted_on(ROUTER_LINK_CAN, msg)) {
+
+        return true;
+
+    }
+
+    if (!_ensure_proxy_alias(proxy)) {
+
+        return false;
+
+    }
+
+    uint16_t saved_source_alias = msg->source_alias;
+    uint16_t saved_dest_alias = msg->dest_alias;
+
+    msg->source_alias = proxy->alias;
+    bool result = _interface->send_can_msg(msg);
+    msg->source_alias = saved_source_alias;
+    msg->dest_alias = saved_dest_alias;
+
+    if (result) {
+
+        _note_sent_to(ROUTER_LINK_CAN, msg);
+
+    }
+
+    return result;
+
+}
+
+    /**
+     * @brief Forwards a received message, giving up after the forward timeout.
+     *
+     * @details Algorithm:
+     * -# Ignore messages whose source is a local node or one of our proxies.
+     * -# A non-zero source alias means CAN; forward to TCP, otherwise to CAN.
+     * -# On failure remember the message and its first tick; once it has
+     *    waited USER_DEFINED_ROUTER_FORWARD_TIMEOUT_TICKS, drop it.
+     *
+     * @verbatim
+     * @param msg Message popped from the incoming FIFO.
+     * @endverbatim
+     *
+     * @return true when done with the message, false to offer it again.
+     */
+bool OpenLcbRouter_forward_incoming_msg(openlcb_msg_t *msg) {
+
+    bool result = true;
+
+    if (msg->source_alias != 0) {
+
+        if (!_interface->openlcb_node_find_by_alias(msg->source_alias) && !_find_proxy_by_alias(msg->source_alias)) {
+
+            result = _forward_to_tcp(msg);
+
+        }
+
+    } else {
+
+        result = _forward_to_can(msg);
+
+    }
+
+    if (result) {
+
+        _retry_msg = NULL;
+
+        return true;
+
+    }
+
+    uint8_t current_tick = _interface->get_current_tick();
+
+    if (_retry_msg != msg) {
+
+        _retry_msg = msg;
+        _retry_start_tick = current_tick;
+
+    }
+
+    if ((uint8_t) (current_tick - _retry_start_tick) >= USER_DEFINED_ROUTER_FORWARD_TIMEOUT_TICKS) {
+
+        _retry_msg = NULL;
+
+        return true;
+
+    }
+
+    return false;
+
+}
+
+    /**
+     * @brief Sends a local node's message on every link that needs it.
+     *
+     * @details Algorithm:
+     * -# Addressed to a known TCP node (by Node ID or proxy alias): TCP only.
+     *    Addressed with another CAN alias: CAN only.  Otherwise both.
+     * -# Skip CAN if this is the retry of a message CAN already took.
+     * -# Send on CAN, then on TCP if a connection is up; if TCP is busy after
+     *    CAN succeeded, remember the message so the retry only goes to TCP.
+     *
+     * @verbatim
+     * @param msg Outgoing message.
+     * @endverbatim
+     *
+     * @return true when every target link took the message.
+     */
+bool OpenLcbRouter_send_openlcb_msg(openlcb_msg_t *msg) {
+
+    bool to_can = true;
+    bool to_tcp = true;
+
+    if (OpenLcbUtilities_is_addressed_openlcb_message(msg)) {
+
+        if (_find_proxy(msg->dest_id) || _find_proxy_by_alias(msg->dest_alias)) {
+
+            to_can = false;
+
+        } else if (msg->dest_alias != 0) {
+
+            to_tcp = false;
+
+        }
+
+    }
+
+    if (to_tcp && _interface->is_tcp_link_up && !_interface->is_tcp_link_up()) {
+
+        to_tcp = false;
+
+    }
+
+    if (to_can && (_partial_msg != msg)) {
+
+        if (!_interface->send_can_msg(msg)) {
+
+            return false;
+
+        }
+
+        _note_sent_to(ROUTER_LINK_CAN, msg);
+
+    }
+
+    if (to_tcp) {
+
+        node_id_t saved_dest_id = msg->dest_id;
+        router_proxy_entry_t *proxy = _find_proxy_by_alias(msg->dest_alias);
+
+        if (proxy) {
+
+            msg->dest_id = proxy->node_id;
+
+        }
+
+        bool result = _interface->send_tcp_msg(msg);
+        msg->dest_id = saved_dest_id;
+
+        if (!result) {
+
+            _partial_msg = to_can ? msg : NULL;
+
+            return false;
+
+        }
+
+        _note_sent_to(ROUTER_LINK_TCP, msg);
+
+    }
+
+    _partial_msg = NULL;
+
+    return true;
+
+}
+
+    /** @brief Opens link's event filter; for TCP also releases every proxy. */
+void OpenLcbRouter_link_down(uint8_t link) {
+
+    if (link >= ROUTER_LINK_COUNT) {
+
+        return;
+
+    }
+
+    _clear_event_filter(link);
+
+    if (link == ROUTER_LINK_TCP) {
+
+        for (int i = 0; i < USER_DEFINED_ROUTER_PROXY_DEPTH; i++) {
+
+            if (_proxies[i].node_id != 0) {
+
+                _free_proxy(&_proxies[i]);
+
+            }
+
+        }
+
+    }
+
+}
+
+    /** @brief Returns the announced proxy alias for node_id, or 0. */
+uint16_t OpenLcbRouter_get_proxy_alias(node_id_t node_id) {
+
+    router_proxy_entry_t *proxy = _find_proxy(node_id);
+
+    if (proxy && proxy->is_announced) {
+
+        return proxy->alias;
+
+    }
+
+    return 0;
+
+}
+
+    /** @brief Returns a pointer to proxy slot index, or NULL if out of range. */
+router_proxy_entry_t *OpenLcbRouter_get_proxy_entry(uint16_t index) {
+
+    if (index >= USER_DEFINED_ROUTER_PROXY_DEPTH) {
+
+        return NULL;
+
+    }
+
+    return &_proxies[index];
+
+}
+
+    /** @brief Returns ROUTER_EVENT_FILTER_* for link (OPEN if out of range). */
+uint8_t OpenLcbRouter_get_event_filter_state(uint8_t link) {
+
+    if (link >= ROUTER_LINK_COUNT) {
+
+        return ROUTER_EVENT_FILTER_OPEN;
+
+    }
+
+    return _filter_state[link];
+
+}
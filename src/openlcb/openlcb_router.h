@@ -0,0 +1,268 @@
+/** \copyright
+ * Copyright (c) 2026, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file openlcb_router.h
+ * @brief Forwards OpenLCB traffic between the CAN and TCP/IP transports.
+ *
+ * @details Compiled in when both OPENLCB_COMPILE_CAN and OPENLCB_COMPILE_TCP
+ * are defined.  Local nodes send through OpenLcbRouter_send_openlcb_msg(),
+ * which reaches both links.  Every message received on one link is offered to
+ * OpenLcbRouter_forward_incoming_msg() by the main state machine and crosses
+ * to the other link only when it has to:
+ *
+ * - Addressed messages cross only if the destination is on the far side.  On
+ *   CAN that means the destination alias is one of our proxy aliases; from TCP
+ *   it means the destination is neither a local node nor a known TCP node.
+ * - Event reports cross only if a consumer on the far side has identified the
+ *   event (or a range covering it).  Each side's filter is learned from
+ *   Consumer Identified replies and stays open, passing everything, until an
+ *   Identify Events has gone onto that side and USER_DEFINED_ROUTER_EVENT_LEARN_TICKS
+ *   have passed for the replies, or after its table overflows.
+ * - Everything else global crosses.
+ *
+ * TCP nodes appear on CAN under proxy aliases taken from the CAN alias pool
+ * (so USER_DEFINED_ALIAS_POOL_DEPTH must be > 0).  A proxy alias is claimed and
+ * announced with AMD the first time one of its node's messages has to reach
+ * CAN, and the CAN receive path defends it like a local alias.  When the proxy
+ * table is full the least recently used proxy is released with AMR.  CAN
+ * sources are translated to Node IDs through the remote alias cache (so
+ * USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH must be > 0); a message whose source
+ * cannot be translated is not forwarded.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __OPENLCB_OPENLCB_ROUTER__
+#define __OPENLCB_OPENLCB_ROUTER__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "openlcb_types.h"
+
+// =============================================================================
+// User configuration (override in openlcb_user_config.h)
+// =============================================================================
+
+    /** @brief TCP nodes that can hold a CAN proxy alias at once. */
+#ifndef USER_DEFINED_ROUTER_PROXY_DEPTH
+#define USER_DEFINED_ROUTER_PROXY_DEPTH 8
+#endif
+#if USER_DEFINED_ROUTER_PROXY_DEPTH < 1
+#error "USER_DEFINED_ROUTER_PROXY_DEPTH must be >= 1 to avoid a zero-length array"
+#endif
+
+    /** @brief Consumed events (or ranges) remembered per link before its filter opens. */
+#ifndef USER_DEFINED_ROUTER_EVENT_FILTER_DEPTH
+#define USER_DEFINED_ROUTER_EVENT_FILTER_DEPTH 32
+#endif
+#if USER_DEFINED_ROUTER_EVENT_FILTER_DEPTH < 1
+#error "USER_DEFINED_ROUTER_EVENT_FILTER_DEPTH must be >= 1 to avoid a zero-length array"
+#endif
+
+    /** @brief 100 ms ticks allowed for Consumer Identified replies after an Identify Events. */
+#ifndef USER_DEFINED_ROUTER_EVENT_LEARN_TICKS
+#define USER_DEFINED_ROUTER_EVENT_LEARN_TICKS 10
+#endif
+
+    /** @brief 100 ms ticks a received message may wait for a busy far link before it is dropped. */
+#ifndef USER_DEFINED_ROUTER_FORWARD_TIMEOUT_TICKS
+#define USER_DEFINED_ROUTER_FORWARD_TIMEOUT_TICKS 5
+#endif
+
+/** @brief Link index for the CAN transport. */
+#define ROUTER_LINK_CAN 0
+
+/** @brief Link index for the TCP/IP transport. */
+#define ROUTER_LINK_TCP 1
+
+/** @brief Number of links the router joins. */
+#define ROUTER_LINK_COUNT 2
+
+/** @brief Event filter passes everything (nothing learned yet, or table overflowed). */
+#define ROUTER_EVENT_FILTER_OPEN 0
+
+/** @brief Identify Events sent onto the link; waiting for the Consumer Identified replies. */
+#define ROUTER_EVENT_FILTER_LEARNING 1
+
+/** @brief Event filter passes only learned consumers. */
+#define ROUTER_EVENT_FILTER_ARMED 2
+
+    /**
+     * @brief One TCP node known to the router.
+     *
+     * @details alias is 0 until a message from the node has had to cross to CAN.
+     */
+typedef struct {
+
+    node_id_t node_id;          /**< @brief TCP node, 0 when the slot is free. */
+    uint16_t alias;             /**< @brief CAN proxy alias, 0 if none claimed yet. */
+    bool is_announced;          /**< @brief AMD has been sent for alias. */
+    uint8_t last_used_tick;     /**< @brief Tick of the last message to or from the node (LRU). */
+
+} router_proxy_entry_t;
+
+    /**
+     * @brief One consumed event or event range on a link.
+     *
+     * @details mask holds the don't-care low bits of a range (0 for a single event).
+     */
+typedef struct {
+
+    event_id_t event_id;        /**< @brief Event, or any event of the range. */
+    event_id_t mask;            /**< @brief Don't-care bits. */
+
+} router_event_filter_entry_t;
+
+    /**
+     * @brief Dependency-injection interface for the router.
+     *
+     * @details All function pointers are REQUIRED except is_tcp_link_up.
+     *
+     * @see OpenLcbRouter_initialize
+     */
+typedef struct {
+
+        /** @brief REQUIRED. Send a message on CAN. Typical impl: CanTxStatemachine_send_openlcb_message. */
+    bool (*send_can_msg)(openlcb_msg_t *msg);
+
+        /** @brief REQUIRED. Send a message on TCP. Typical impl: TcpConfig_get_send_openlcb_msg(). */
+    bool (*send_tcp_msg)(openlcb_msg_t *msg);
+
+        /** @brief OPTIONAL. True while any TCP connection carries traffic (NULL = always). Typical impl: TcpConfig_is_link_up. */
+    bool (*is_tcp_link_up)(void);
+
+        /** @brief REQUIRED. Take a reserved CAN alias for a Node ID, 0 if none ready. Typical impl: CanAliasPool_claim. */
+    uint16_t (*proxy_alias_claim)(node_id_t node_id);
+
+        /** @brief REQUIRED. Send AMD for a claimed alias. Typical impl: CanAliasPool_announce. */
+    bool (*proxy_alias_announce)(uint16_t alias, node_id_t node_id);
+
+        /** @brief REQUIRED. True while a claimed alias is still ours. Typical impl: CanAliasPool_is_held. */
+    bool (*proxy_alias_is_held)(uint16_t alias, node_id_t node_id);
+
+        /** @brief REQUIRED. Give a claimed alias back. Typical impl: CanAliasPool_release. */
+    void (*proxy_alias_release)(uint16_t alias);
+
+        /** @brief REQUIRED. Typical impl: OpenLcbNode_find_by_alias. */
+    openlcb_node_t *(*openlcb_node_find_by_alias)(uint16_t alias);
+
+        /** @brief REQUIRED. Typical impl: OpenLcbNode_find_by_node_id. */
+    openlcb_node_t *(*openlcb_node_find_by_node_id)(uint64_t node_id);
+
+        /** @brief REQUIRED. Current value of the global 100 ms tick. Typical impl: OpenLcbConfig_get_global_100ms_tick. */
+    uint8_t (*get_current_tick)(void);
+
+} interface_openlcb_router_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+        /**
+         * @brief Registers the interface and clears the proxy table and event filters.
+         *
+         * @param interface  Pointer to a populated @ref interface_openlcb_router_t.
+         *                   Must remain valid for the lifetime of the application.
+         *
+         * @warning NOT thread-safe - call during single-threaded initialization only.
+         */
+    extern void OpenLcbRouter_initialize(const interface_openlcb_router_t *interface);
+
+        /**
+         * @brief Sends a message from a local node on the links it needs.
+         *
+         * @details Addressed messages go only to the side their destination is
+         * known on (both if unknown); global messages go to both.  If CAN took the
+         * message but TCP was busy, the retry with the same message only goes to
+         * TCP.
+         *
+         * @param msg  Outgoing message.
+         *
+         * @return true when every target link took the message, false to retry.
+         */
+    extern bool OpenLcbRouter_send_openlcb_msg(openlcb_msg_t *msg);
+
+        /**
+         * @brief Forwards a received message to the other link if it needs to cross.
+         *
+         * @details Messages with a non-zero source alias came from CAN, the rest
+         * from TCP.  The message is restored to its received addressing before
+         * returning, so local nodes see it unchanged.
+         *
+         * @param msg  Message popped from the incoming FIFO.
+         *
+         * @return false while the far link is busy (offer it again), true once it
+         *         was forwarded, filtered out, or waited longer than
+         *         USER_DEFINED_ROUTER_FORWARD_TIMEOUT_TICKS.
+         */
+    extern bool OpenLcbRouter_forward_incoming_msg(openlcb_msg_t *msg);
+
+        /**
+         * @brief Forgets what the router learned about one link.
+         *
+         * @details Opens that link's event filter.  For ROUTER_LINK_TCP it also
+         * releases every proxy alias.  Call when the last TCP connection drops.
+         *
+         * @param link  ROUTER_LINK_CAN or ROUTER_LINK_TCP.
+         */
+    extern void OpenLcbRouter_link_down(uint8_t link);
+
+        /**
+         * @brief Returns the proxy alias used on CAN for a TCP node.
+         *
+         * @param node_id  TCP node.
+         *
+         * @return Announced proxy alias, or 0 if the node has none.
+         */
+    extern uint16_t OpenLcbRouter_get_proxy_alias(node_id_t node_id);
+
+        /**
+         * @brief Returns a pointer to one proxy slot (for testing/debugging).
+         *
+         * @param index  Slot index (0 to USER_DEFINED_ROUTER_PROXY_DEPTH - 1).
+         *
+         * @return Pointer to the @ref router_proxy_entry_t, or NULL if out of range.
+         */
+    extern router_proxy_entry_t *OpenLcbRouter_get_proxy_entry(uint16_t index);
+
+        /**
+         * @brief Returns the state of a link's event filter (for testing/debugging).
+         *
+         * @param link  ROUTER_LINK_CAN or ROUTER_LINK_TCP.
+         *
+         * @return ROUTER_EVENT_FILTER_OPEN, _LEARNING or _ARMED.
+         */
+    extern uint8_t OpenLcbRouter_get_event_filter_state(uint8_t link);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __OPENLCB_OPENLCB_ROUTER__ */
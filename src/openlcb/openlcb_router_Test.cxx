@@ -0,0 +1,673 @@
+/** \copyright
+* Copyright (c) 2024, Jim Kueneman
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  - Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+*  - Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* @file openlcb_router_Test.cxx
+* @brief Unit tests for the CAN <-> TCP router.
+*
+* @details Covers direction detection, destination filtering on both sides,
+* proxy alias claim/announce/loss/LRU release, the forward timeout, the learned
+* event filter (single events, ranges, overflow) and fan-out of local traffic
+* with partial-send retries.
+*
+* @author Jim Kueneman
+* @date 18 Oct 2026
+*/
+
+#include "test/main_Test.hxx"
+
+#include "openlcb_router.h"
+#include "openlcb_defines.h"
+#include "openlcb_types.h"
+#include "openlcb_utilities.h"
+
+#include <cstring>
+
+#define LOCAL_NODE_ID   0x050101010100ULL
+#define LOCAL_ALIAS     0x0AAA
+#define CAN_NODE_ID     0x050101010200ULL
+#define CAN_ALIAS       0x0222
+#define TCP_NODE_ID     0x050101010300ULL
+#define FIRST_PROXY     0x0700
+#define TEST_EVENT      0x0501010101000001ULL
+
+// ============================================================================
+// Mocks
+// ============================================================================
+
+static uint8_t _tick;
+
+static int _can_count;
+static bool _can_busy;
+static uint16_t _can_source_alias;
+static node_id_t _can_dest_id;
+
+static int _tcp_count;
+static bool _tcp_busy;
+static bool _tcp_up;
+static node_id_t _tcp_dest_id;
+
+static uint16_t _next_alias;
+static bool _pool_empty;
+static int _claim_count;
+static bool _announce_ok;
+static int _announce_count;
+static bool _held;
+static uint16_t _released[USER_DEFINED_ROUTER_PROXY_DEPTH + 1];
+static int _release_count;
+
+static openlcb_node_t _local_node;
+
+static bool _send_can(openlcb_msg_t *msg) {
+
+    if (_can_busy) { return false; }
+
+    _can_count++;
+    _can_source_alias = msg->source_alias;
+    _can_dest_id = msg->dest_id;
+    msg->dest_alias = 0x0999;  // the real CAN path resolves and writes it
+
+    return true;
+
+}
+
+static bool _send_tcp(openlcb_msg_t *msg) {
+
+    if (_tcp_busy) { return false; }
+
+    _tcp_count++;
+    _tcp_dest_id = msg->dest_id;
+
+    return true;
+
+}
+
+static bool _is_tcp_link_up(void) { return _tcp_up; }
+
+static uint16_t _claim(node_id_t node_id) {
+
+    (void) node_id;
+
+    if (_pool_empty) { return 0; }
+
+    _claim_count++;
+
+    return _next_alias++;
+
+}
+
+static bool _announce(uint16_t alias, node_id_t node_id) {
+
+    (void) alias;
+    (void) node_id;
+    _announce_count++;
+
+    return _announce_ok;
+
+}
+
+static bool _is_held(uint16_t alias, node_id_t node_id) {
+
+    (void) alias;
+    (void) node_id;
+
+    return _held;
+
+}
+
+static void _release(uint16_t alias) {
+
+    if (_release_count <= USER_DEFINED_ROUTER_PROXY_DEPTH) {
+
+        _released[_release_count] = alias;
+
+    }
+
+    _release_count++;
+
+}
+
+static openlcb_node_t *_find_by_alias(uint16_t alias) {
+
+    return (alias == LOCAL_ALIAS) ? &_local_node : NULL;
+
+}
+
+static openlcb_node_t *_find_by_node_id(uint64_t node_id) {
+
+    return (node_id == LOCAL_NODE_ID) ? &_local_node : NULL;
+
+}
+
+static uint8_t _get_tick(void) { return _tick; }
+
+static const interface_openlcb_router_t _interface = {
+
+    .send_can_msg = &_send_can,
+    .send_tcp_msg = &_send_tcp,
+    .is_tcp_link_up = &_is_tcp_link_up,
+    .proxy_alias_claim = &_claim,
+    .proxy_alias_announce = &_announce,
+    .proxy_alias_is_held = &_is_held,
+    .proxy_alias_release = &_release,
+    .openlcb_node_find_by_alias = &_find_by_alias,
+    .openlcb_node_find_by_node_id = &_find_by_node_id,
+    .get_current_tick = &_get_tick,
+
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static openlcb_msg_t _msg;
+static payload_basic_t _payload;
+
+static void _setup(void) {
+
+    _tick = 0;
+    _can_count = 0;
+    _can_busy = false;
+    _can_source_alias = 0;
+    _can_dest_id = 0;
+    _tcp_count = 0;
+    _tcp_busy = false;
+    _tcp_up = true;
+    _tcp_dest_id = 0;
+    _next_alias = FIRST_PROXY;
+    _pool_empty = false;
+    _claim_count = 0;
+    _announce_ok = true;
+    _announce_count = 0;
+    _held = true;
+    _release_count = 0;
+    memset(_released, 0, sizeof(_released));
+    memset(&_local_node, 0, sizeof(_local_node));
+
+    OpenLcbRouter_initialize(&_interface);
+
+}
+
+static openlcb_msg_t *_load(uint16_t source_alias, node_id_t source_id, uint16_t dest_alias, node_id_t dest_id, uint16_t mti) {
+
+    memset(&_msg, 0, sizeof(_msg));
+    _msg.payload = (openlcb_payload_t *) _payload;
+    _msg.payload_type = BASIC;
+    OpenLcbUtilities_load_openlcb_message(&_msg, source_alias, source_id, dest_alias, dest_id, mti);
+
+    return &_msg;
+
+}
+
+static openlcb_msg_t *_load_event(uint16_t source_alias, node_id_t source_id, uint16_t mti, event_id_t event_id) {
+
+    openlcb_msg_t *msg = _load(source_alias, source_id, 0, 0, mti);
+
+    OpenLcbUtilities_copy_event_id_to_openlcb_payload(msg, event_id);
+
+    return msg;
+
+}
+
+// Gives TCP_NODE_ID an announced proxy by forwarding one of its global messages.
+static uint16_t _make_proxy(node_id_t node_id) {
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(0, node_id, 0, 0, MTI_INITIALIZATION_COMPLETE)));
+
+    return OpenLcbRouter_get_proxy_alias(node_id);
+
+}
+
+// ============================================================================
+// Received traffic
+// ============================================================================
+
+TEST(OpenLcbRouter, initialize)
+{
+
+    _setup();
+
+    for (uint16_t i = 0; i < USER_DEFINED_ROUTER_PROXY_DEPTH; i++) {
+
+        EXPECT_EQ(OpenLcbRouter_get_proxy_entry(i)->node_id, 0u);
+
+    }
+
+    EXPECT_EQ(OpenLcbRouter_get_proxy_entry(USER_DEFINED_ROUTER_PROXY_DEPTH), nullptr);
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_CAN), ROUTER_EVENT_FILTER_OPEN);
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_TCP), ROUTER_EVENT_FILTER_OPEN);
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_COUNT), ROUTER_EVENT_FILTER_OPEN);
+
+}
+
+TEST(OpenLcbRouter, can_global_goes_to_tcp_only)
+{
+
+    _setup();
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(CAN_ALIAS, CAN_NODE_ID, 0, 0, MTI_VERIFY_NODE_ID_GLOBAL)));
+
+    EXPECT_EQ(_tcp_count, 1);
+    EXPECT_EQ(_can_count, 0);
+
+}
+
+TEST(OpenLcbRouter, can_message_not_forwarded_when_untranslated_or_tcp_down)
+{
+
+    _setup();
+
+    // Source alias not in the remote alias cache
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(CAN_ALIAS, 0, 0, 0, MTI_VERIFY_NODE_ID_GLOBAL)));
+    EXPECT_EQ(_tcp_count, 0);
+
+    _tcp_up = false;
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(CAN_ALIAS, CAN_NODE_ID, 0, 0, MTI_VERIFY_NODE_ID_GLOBAL)));
+    EXPECT_EQ(_tcp_count, 0);
+
+}
+
+TEST(OpenLcbRouter, local_sources_are_never_forwarded)
+{
+
+    _setup();
+
+    // Reject synthesized by the CAN receive path on behalf of a local node
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(LOCAL_ALIAS, 0, CAN_ALIAS, 0, MTI_OPTIONAL_INTERACTION_REJECTED)));
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(0, LOCAL_NODE_ID, 0, 0, MTI_VERIFY_NODE_ID_GLOBAL)));
+
+    EXPECT_EQ(_tcp_count, 0);
+    EXPECT_EQ(_can_count, 0);
+
+}
+
+TEST(OpenLcbRouter, tcp_global_claims_and_announces_proxy)
+{
+
+    _setup();
+
+    openlcb_msg_t *msg = _load(0, TCP_NODE_ID, 0, 0, MTI_INITIALIZATION_COMPLETE);
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(msg));
+
+    EXPECT_EQ(_claim_count, 1);
+    EXPECT_EQ(_announce_count, 1);
+    EXPECT_EQ(_can_count, 1);
+    EXPECT_EQ(_can_source_alias, FIRST_PROXY);
+    EXPECT_EQ(_tcp_count, 0);
+
+    // Local nodes still see the message as it arrived
+    EXPECT_EQ(msg->source_alias, 0);
+    EXPECT_EQ(msg->dest_alias, 0);
+    EXPECT_EQ(OpenLcbRouter_get_proxy_alias(TCP_NODE_ID), FIRST_PROXY);
+
+    // The next message reuses the proxy
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(0, TCP_NODE_ID, 0, 0, MTI_VERIFY_NODE_ID_GLOBAL)));
+    EXPECT_EQ(_claim_count, 1);
+    EXPECT_EQ(_announce_count, 1);
+    EXPECT_EQ(_can_count, 2);
+
+}
+
+TEST(OpenLcbRouter, can_addressed_crosses_only_to_proxy)
+{
+
+    _setup();
+
+    uint16_t proxy_alias = _make_proxy(TCP_NODE_ID);
+    ASSERT_EQ(proxy_alias, FIRST_PROXY);
+
+    // Addressed to another CAN node: stays on CAN
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(CAN_ALIAS, CAN_NODE_ID, 0x0333, 0, MTI_VERIFY_NODE_ID_ADDRESSED)));
+    EXPECT_EQ(_tcp_count, 0);
+
+    // Addressed to a local node: stays local
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(CAN_ALIAS, CAN_NODE_ID, LOCAL_ALIAS, 0, MTI_VERIFY_NODE_ID_ADDRESSED)));
+    EXPECT_EQ(_tcp_count, 0);
+
+    // Addressed to the proxy: goes to TCP with the real Node ID
+    openlcb_msg_t *msg = _load(CAN_ALIAS, CAN_NODE_ID, proxy_alias, 0, MTI_VERIFY_NODE_ID_ADDRESSED);
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(msg));
+    EXPECT_EQ(_tcp_count, 1);
+    EXPECT_EQ(_tcp_dest_id, TCP_NODE_ID);
+    EXPECT_EQ(msg->dest_id, 0u);
+
+}
+
+TEST(OpenLcbRouter, tcp_addressed_stays_off_can_for_local_and_tcp_nodes)
+{
+
+    _setup();
+
+    _make_proxy(TCP_NODE_ID);
+    _can_count = 0;
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(0, TCP_NODE_ID + 1, 0, LOCAL_NODE_ID, MTI_VERIFY_NODE_ID_ADDRESSED)));
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(0, TCP_NODE_ID + 1, 0, TCP_NODE_ID, MTI_VERIFY_NODE_ID_ADDRESSED)));
+    EXPECT_EQ(_can_count, 0);
+
+    // Anyone else may be on CAN
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(0, TCP_NODE_ID + 1, 0, CAN_NODE_ID, MTI_VERIFY_NODE_ID_ADDRESSED)));
+    EXPECT_EQ(_can_count, 1);
+    EXPECT_EQ(_can_dest_id, CAN_NODE_ID);
+    EXPECT_EQ(_msg.dest_alias, 0);
+
+}
+
+TEST(OpenLcbRouter, forward_waits_for_alias_then_times_out)
+{
+
+    _setup();
+
+    _pool_empty = true;
+    openlcb_msg_t *msg = _load(0, TCP_NODE_ID, 0, 0, MTI_INITIALIZATION_COMPLETE);
+
+    EXPECT_FALSE(OpenLcbRouter_forward_incoming_msg(msg));
+    _tick = USER_DEFINED_ROUTER_FORWARD_TIMEOUT_TICKS - 1;
+    EXPECT_FALSE(OpenLcbRouter_forward_incoming_msg(msg));
+
+    // The pool refilled in time
+    _pool_empty = false;
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(msg));
+    EXPECT_EQ(_can_count, 1);
+
+    // A busy CAN link is given up on after the timeout
+    _can_busy = true;
+    msg = _load(0, TCP_NODE_ID, 0, 0, MTI_VERIFY_NODE_ID_GLOBAL);
+    EXPECT_FALSE(OpenLcbRouter_forward_incoming_msg(msg));
+    _tick += USER_DEFINED_ROUTER_FORWARD_TIMEOUT_TICKS;
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(msg));
+    EXPECT_EQ(_can_count, 1);
+
+}
+
+TEST(OpenLcbRouter, failed_announce_is_retried)
+{
+
+    _setup();
+
+    _announce_ok = false;
+    openlcb_msg_t *msg = _load(0, TCP_NODE_ID, 0, 0, MTI_INITIALIZATION_COMPLETE);
+
+    EXPECT_FALSE(OpenLcbRouter_forward_incoming_msg(msg));
+    EXPECT_EQ(OpenLcbRouter_get_proxy_alias(TCP_NODE_ID), 0);
+    EXPECT_EQ(_can_count, 0);
+
+    _announce_ok = true;
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(msg));
+    EXPECT_EQ(_claim_count, 1);
+    EXPECT_EQ(_announce_count, 2);
+    EXPECT_EQ(_can_count, 1);
+
+}
+
+TEST(OpenLcbRouter, lost_proxy_alias_is_replaced)
+{
+
+    _setup();
+
+    EXPECT_EQ(_make_proxy(TCP_NODE_ID), FIRST_PROXY);
+
+    // A CAN node took the alias
+    _held = false;
+    _make_proxy(TCP_NODE_ID);
+    _held = true;
+
+    EXPECT_EQ(OpenLcbRouter_get_proxy_alias(TCP_NODE_ID), FIRST_PROXY + 1);
+    EXPECT_EQ(_claim_count, 2);
+    EXPECT_EQ(_announce_count, 2);
+    EXPECT_EQ(_can_source_alias, FIRST_PROXY + 1);
+
+}
+
+TEST(OpenLcbRouter, least_recently_used_proxy_is_released)
+{
+
+    _setup();
+
+    for (int i = 0; i < USER_DEFINED_ROUTER_PROXY_DEPTH; i++) {
+
+        _tick = (uint8_t) i;
+        _make_proxy(TCP_NODE_ID + i);
+
+    }
+
+    // Node 0 is used again, so node 1 becomes the oldest
+    _tick = USER_DEFINED_ROUTER_PROXY_DEPTH;
+    _make_proxy(TCP_NODE_ID);
+
+    _tick++;
+    EXPECT_EQ(_make_proxy(TCP_NODE_ID + 100), FIRST_PROXY + USER_DEFINED_ROUTER_PROXY_DEPTH);
+
+    ASSERT_EQ(_release_count, 1);
+    EXPECT_EQ(_released[0], FIRST_PROXY + 1);
+    EXPECT_EQ(OpenLcbRouter_get_proxy_alias(TCP_NODE_ID + 1), 0);
+    EXPECT_EQ(OpenLcbRouter_get_proxy_alias(TCP_NODE_ID), FIRST_PROXY);
+
+}
+
+TEST(OpenLcbRouter, tcp_link_down_releases_every_proxy)
+{
+
+    _setup();
+
+    _make_proxy(TCP_NODE_ID);
+    _make_proxy(TCP_NODE_ID + 1);
+
+    OpenLcbRouter_link_down(ROUTER_LINK_TCP);
+
+    EXPECT_EQ(_release_count, 2);
+    EXPECT_EQ(OpenLcbRouter_get_proxy_alias(TCP_NODE_ID), 0);
+    EXPECT_EQ(OpenLcbRouter_get_proxy_entry(0)->node_id, 0u);
+
+    // Out of range is ignored
+    OpenLcbRouter_link_down(ROUTER_LINK_COUNT);
+
+}
+
+// ============================================================================
+// Event filter
+// ============================================================================
+
+TEST(OpenLcbRouter, event_filter_learns_consumers_after_identify)
+{
+
+    _setup();
+
+    // Nothing learned yet: every report crosses
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(0, TCP_NODE_ID, MTI_PC_EVENT_REPORT, TEST_EVENT + 5)));
+    EXPECT_EQ(_can_count, 1);
+
+    // Identify Events from TCP goes onto CAN and starts the learning window
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(0, TCP_NODE_ID, 0, 0, MTI_EVENTS_IDENTIFY)));
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_CAN), ROUTER_EVENT_FILTER_LEARNING);
+
+    // A CAN consumer answers (and the reply crosses to TCP)
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(CAN_ALIAS, CAN_NODE_ID, MTI_CONSUMER_IDENTIFIED_UNKNOWN, TEST_EVENT)));
+    EXPECT_EQ(_tcp_count, 1);
+
+    // Still learning: unknown events pass
+    _can_count = 0;
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(0, TCP_NODE_ID, MTI_PC_EVENT_REPORT, TEST_EVENT + 5)));
+    EXPECT_EQ(_can_count, 1);
+
+    _tick = USER_DEFINED_ROUTER_EVENT_LEARN_TICKS;
+
+    _can_count = 0;
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(0, TCP_NODE_ID, MTI_PC_EVENT_REPORT, TEST_EVENT + 5)));
+    EXPECT_EQ(_can_count, 0);
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_CAN), ROUTER_EVENT_FILTER_ARMED);
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(0, TCP_NODE_ID, MTI_PC_EVENT_REPORT, TEST_EVENT)));
+    EXPECT_EQ(_can_count, 1);
+
+    // The TCP side was never identified, so it stays open
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(CAN_ALIAS, CAN_NODE_ID, MTI_PC_EVENT_REPORT, TEST_EVENT + 5)));
+    EXPECT_EQ(_tcp_count, 2);
+
+}
+
+TEST(OpenLcbRouter, event_filter_matches_consumer_ranges)
+{
+
+    _setup();
+
+    // Local node identifies: both links start learning
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(_load(LOCAL_ALIAS, LOCAL_NODE_ID, 0, 0, MTI_EVENTS_IDENTIFY)));
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_CAN), ROUTER_EVENT_FILTER_LEARNING);
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_TCP), ROUTER_EVENT_FILTER_LEARNING);
+
+    // TCP consumer of 0x...0100 - 0x...01FF
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(0, TCP_NODE_ID, MTI_CONSUMER_RANGE_IDENTIFIED, 0x05010101010101FFULL)));
+
+    _tick = USER_DEFINED_ROUTER_EVENT_LEARN_TICKS;
+    _tcp_count = 0;
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(CAN_ALIAS, CAN_NODE_ID, MTI_PC_EVENT_REPORT, 0x0501010101010142ULL)));
+    EXPECT_EQ(_tcp_count, 1);
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(CAN_ALIAS, CAN_NODE_ID, MTI_PC_EVENT_REPORT, 0x0501010101010242ULL)));
+    EXPECT_EQ(_tcp_count, 1);
+
+    // Other global traffic is not filtered
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(CAN_ALIAS, CAN_NODE_ID, MTI_PRODUCER_IDENTIFIED_SET, 0x0501010101010242ULL)));
+    EXPECT_EQ(_tcp_count, 2);
+
+}
+
+TEST(OpenLcbRouter, event_filter_opens_on_overflow_and_link_down)
+{
+
+    _setup();
+
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(CAN_ALIAS, CAN_NODE_ID, 0, 0, MTI_EVENTS_IDENTIFY)));
+    ASSERT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_TCP), ROUTER_EVENT_FILTER_LEARNING);
+
+    for (int i = 0; i <= USER_DEFINED_ROUTER_EVENT_FILTER_DEPTH; i++) {
+
+        OpenLcbRouter_forward_incoming_msg(_load_event(0, TCP_NODE_ID, MTI_CONSUMER_IDENTIFIED_SET, TEST_EVENT + (2 * i)));
+
+    }
+
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_TCP), ROUTER_EVENT_FILTER_OPEN);
+
+    _tick = USER_DEFINED_ROUTER_EVENT_LEARN_TICKS;
+    _tcp_count = 0;
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load_event(CAN_ALIAS, CAN_NODE_ID, MTI_PC_EVENT_REPORT, TEST_EVENT + 1)));
+    EXPECT_EQ(_tcp_count, 1);
+
+    // Re-arm, then drop the link
+    EXPECT_TRUE(OpenLcbRouter_forward_incoming_msg(_load(CAN_ALIAS, CAN_NODE_ID, 0, 0, MTI_EVENTS_IDENTIFY)));
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_TCP), ROUTER_EVENT_FILTER_LEARNING);
+    OpenLcbRouter_link_down(ROUTER_LINK_TCP);
+    EXPECT_EQ(OpenLcbRouter_get_event_filter_state(ROUTER_LINK_TCP), ROUTER_EVENT_FILTER_OPEN);
+
+}
+
+// ============================================================================
+// Local traffic
+// ============================================================================
+
+TEST(OpenLcbRouter, local_global_goes_to_both_links)
+{
+
+    _setup();
+
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(_load(LOCAL_ALIAS, LOCAL_NODE_ID, 0, 0, MTI_INITIALIZATION_COMPLETE)));
+    EXPECT_EQ(_can_count, 1);
+    EXPECT_EQ(_tcp_count, 1);
+
+    // No TCP connection: CAN only
+    _tcp_up = false;
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(_load(LOCAL_ALIAS, LOCAL_NODE_ID, 0, 0, MTI_INITIALIZATION_COMPLETE)));
+    EXPECT_EQ(_can_count, 2);
+    EXPECT_EQ(_tcp_count, 1);
+
+}
+
+TEST(OpenLcbRouter, local_addressed_goes_to_destination_side)
+{
+
+    _setup();
+
+    uint16_t proxy_alias = _make_proxy(TCP_NODE_ID);
+    _can_count = 0;
+
+    // Reply to a TCP node (received with no alias)
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(_load(LOCAL_ALIAS, LOCAL_NODE_ID, 0, TCP_NODE_ID, MTI_VERIFY_NODE_ID_ADDRESSED)));
+    EXPECT_EQ(_can_count, 0);
+    EXPECT_EQ(_tcp_count, 1);
+
+    // Addressed to the proxy alias only
+    openlcb_msg_t *msg = _load(LOCAL_ALIAS, LOCAL_NODE_ID, proxy_alias, 0, MTI_VERIFY_NODE_ID_ADDRESSED);
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(msg));
+    EXPECT_EQ(_can_count, 0);
+    EXPECT_EQ(_tcp_count, 2);
+    EXPECT_EQ(_tcp_dest_id, TCP_NODE_ID);
+    EXPECT_EQ(msg->dest_id, 0u);
+
+    // Reply to a CAN node
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(_load(LOCAL_ALIAS, LOCAL_NODE_ID, CAN_ALIAS, CAN_NODE_ID, MTI_VERIFY_NODE_ID_ADDRESSED)));
+    EXPECT_EQ(_can_count, 1);
+    EXPECT_EQ(_tcp_count, 2);
+
+    // Unknown destination: both
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(_load(LOCAL_ALIAS, LOCAL_NODE_ID, 0, CAN_NODE_ID + 7, MTI_VERIFY_NODE_ID_ADDRESSED)));
+    EXPECT_EQ(_can_count, 2);
+    EXPECT_EQ(_tcp_count, 3);
+
+}
+
+TEST(OpenLcbRouter, local_partial_send_retries_tcp_only)
+{
+
+    _setup();
+
+    openlcb_msg_t *msg = _load(LOCAL_ALIAS, LOCAL_NODE_ID, 0, 0, MTI_INITIALIZATION_COMPLETE);
+
+    // CAN busy: nothing sent
+    _can_busy = true;
+    EXPECT_FALSE(OpenLcbRouter_send_openlcb_msg(msg));
+    EXPECT_EQ(_tcp_count, 0);
+
+    // CAN takes it, TCP busy
+    _can_busy = false;
+    _tcp_busy = true;
+    EXPECT_FALSE(OpenLcbRouter_send_openlcb_msg(msg));
+    EXPECT_EQ(_can_count, 1);
+
+    // Retry goes to TCP only
+    _tcp_busy = false;
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(msg));
+    EXPECT_EQ(_can_count, 1);
+    EXPECT_EQ(_tcp_count, 1);
+
+    // The next message goes to both again
+    EXPECT_TRUE(OpenLcbRouter_send_openlcb_msg(msg));
+    EXPECT_EQ(_can_count, 2);
+    EXPECT_EQ(_tcp_count, 2);
+
+}
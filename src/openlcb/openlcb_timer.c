@@ -0,0 +1,231 @@
+/** \copyright
+ * Copyright (c) 2026, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file openlcb_timer.c
+ * @brief Millisecond clock and one-shot timers for protocol timeouts.
+ *
+ * @details Active timers are kept in a singly linked list sorted by deadline,
+ * so OpenLcbTimer_run() only looks at the head.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#include "openlcb_timer.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+
+/** @brief Saved pointer to the dependency-injected timer interface. */
+static const interface_openlcb_timer_t *_interface;
+
+/** @brief Earliest active timer, NULL when none. */
+static openlcb_timer_t *_head;
+
+/** @brief Tick clock: last 100 ms tick folded into _tick_clock_ms. */
+static uint8_t _last_tick;
+
+/** @brief Tick clock: milliseconds since initialize in 100 ms steps. */
+static uint32_t _tick_clock_ms;
+
+    /** @brief True if clock value a is strictly later than b (wrap safe). */
+static bool _is_after(uint32_t a, uint32_t b) {
+
+    return (int32_t) (a - b) > 0;
+
+}
+
+    /**
+     * @brief Registers the interface, cancels all timers and starts the clock.
+     *
+     * @details Algorithm:
+     * -# Store the interface pointer
+     * -# Drop the timer list (callers' timers are left as they are)
+     * -# Zero the tick clock at the current tick
+     *
+     * @verbatim
+     * @param interface  Pointer to a populated interface_openlcb_timer_t.
+     * @endverbatim
+     */
+void OpenLcbTimer_initialize(const interface_openlcb_timer_t *interface) {
+
+    _interface = interface;
+    _head = NULL;
+    _last_tick = _interface->get_current_tick();
+    _tick_clock_ms = 0;
+
+}
+
+    /**
+     * @brief Returns the monotonic millisecond clock.
+     *
+     * @details Algorithm:
+     * -# With get_time_ms wired, return it
+     * -# Otherwise add OPENLCB_TIMER_TICK_MS for every tick since the last
+     *    call (unsigned 8-bit difference) and return the running total
+     *
+     * @return Milliseconds (wraps at 2^32).
+     */
+uint32_t OpenLcbTimer_get_time_ms(void) {
+
+    if (_interface->get_time_ms) {
+
+        return _interface->get_time_ms();
+
+    }
+
+    uint8_t tick = _interface->get_current_tick();
+
+    _tick_clock_ms += (uint32_t) ((uint8_t) (tick - _last_tick)) * OPENLCB_TIMER_TICK_MS;
+    _last_tick = tick;
+
+    return _tick_clock_ms;
+
+}
+
+    /**
+     * @brief Returns true once strictly more than duration_ms has passed since start_ms.
+     *
+     * @verbatim
+     * @param start_ms     Clock value when the wait began.
+     * @param duration_ms  Minimum wait.
+     * @endverbatim
+     */
+bool OpenLcbTimer_has_elapsed(uint32_t start_ms, uint32_t duration_ms) {
+
+    return (uint32_t) (OpenLcbTimer_get_time_ms() - start_ms) > duration_ms;
+
+}
+
+    /**
+     * @brief Cancels a timer.
+     *
+     * @details Algorithm:
+     * -# If the timer is active, unlink it from the list
+     * -# Mark it inactive
+     *
+     * @verbatim
+     * @param timer  Timer to cancel.
+     * @endverbatim
+     */
+void OpenLcbTimer_stop(openlcb_timer_t *timer) {
+
+    if (timer->active) {
+
+        openlcb_timer_t **link = &_head;
+
+        while (*link) {
+
+            if (*link == timer) {
+
+                *link = timer->next;
+
+                break;
+
+            }
+
+            link = &(*link)->next;
+
+        }
+
+    }
+
+    timer->next = NULL;
+    timer->active = false;
+
+}
+
+    /**
+     * @brief Schedules (or reschedules) a one-shot timer.
+     *
+     * @details Algorithm:
+     * -# Stop the timer if it is already scheduled
+     * -# Set its deadline to now + delay_ms and store callback and context
+     * -# Insert it after every timer with the same or an earlier deadline
+     *
+     * @verbatim
+     * @param timer     Caller-owned timer.
+     * @param delay_ms  Fires once strictly more than this has elapsed.
+     * @param callback  Function to call on expiry.
+     * @param context   Passed to callback.
+     * @endverbatim
+     */
+void OpenLcbTimer_start(openlcb_timer_t *timer, uint32_t delay_ms, openlcb_timer_callback_t callback, void *context) {
+
+    OpenLcbTimer_stop(timer);
+
+    timer->deadline_ms = OpenLcbTimer_get_time_ms() + delay_ms;
+    timer->callback = callback;
+    timer->context = context;
+    timer->active = true;
+
+    openlcb_timer_t **link = &_head;
+
+    while (*link && !_is_after((*link)->deadline_ms, timer->deadline_ms)) {
+
+        link = &(*link)->next;
+
+    }
+
+    timer->next = *link;
+    *link = timer;
+
+}
+
+    /**
+     * @brief Fires every timer whose deadline has passed, earliest first.
+     *
+     * @details Algorithm:
+     * -# Read the clock once
+     * -# While the head timer's deadline is strictly before now, unlink it,
+     *    mark it inactive and call its callback
+     *
+     * A timer restarted from its own callback gets a deadline of at least now,
+     * so it cannot fire again in the same call.
+     */
+void OpenLcbTimer_run(void) {
+
+    uint32_t now = OpenLcbTimer_get_time_ms();
+
+    while (_head && _is_after(now, _head->deadline_ms)) {
+
+        openlcb_timer_t *timer = _head;
+
+        _head = timer->next;
+        timer->next = NULL;
+        timer->active = false;
+
+        if (timer->callback) {
+
+            timer->callback(timer->context);
+
+        }
+
+    }
+
+}
@@ -0,0 +1,170 @@
+/** \copyright
+ * Copyright (c) 2026, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file openlcb_timer.h
+ * @brief Millisecond clock and one-shot timers for protocol timeouts.
+ *
+ * @details The library clock has always been the 100 ms tick, so a 200 ms wait
+ * really lasted 200 to 300 ms and nothing could fire between tick boundaries.
+ * This module gives every subsystem one monotonic 32-bit millisecond clock:
+ *
+ * - With the OPTIONAL get_time_ms wired (a hardware millisecond counter) the
+ *   clock has 1 ms resolution.
+ * - Without it the clock is built from the 100 ms tick and advances in 100 ms
+ *   steps, so small MCUs keep working unchanged.
+ *
+ * Subsystems either compare timestamps from the clock (elapsed = now - start,
+ * wrapping every 49 days) or schedule an @ref openlcb_timer_t, which
+ * OpenLcbTimer_run() fires from the main loop once its deadline has passed.
+ * Timer storage belongs to the caller, so no pool has to be sized.
+ *
+ * A wait is over when strictly more than its duration has elapsed.  On the
+ * tick clock that rounds up by one step, which keeps every wait at least as
+ * long as asked for.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef __OPENLCB_OPENLCB_TIMER__
+#define __OPENLCB_OPENLCB_TIMER__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Milliseconds per step of the 100 ms tick the fallback clock is built from. */
+#define OPENLCB_TIMER_TICK_MS 100
+
+    /**
+     * @brief Called from OpenLcbTimer_run() when a timer expires.
+     *
+     * @param context  Pointer given to OpenLcbTimer_start().
+     */
+typedef void (*openlcb_timer_callback_t)(void *context);
+
+    /**
+     * @brief One-shot timer.  Owned by the caller; must stay valid while active.
+     *
+     * @details Fields are managed by this module.  Zero-initialize (or stop)
+     * before first use.
+     */
+typedef struct openlcb_timer_struct {
+
+    struct openlcb_timer_struct *next;  /**< @brief Next timer in deadline order. */
+    uint32_t deadline_ms;               /**< @brief Clock value the timer fires after. */
+    openlcb_timer_callback_t callback;  /**< @brief Function to call on expiry. */
+    void *context;                      /**< @brief Passed to callback. */
+    bool active;                        /**< @brief Scheduled and not yet fired. */
+
+} openlcb_timer_t;
+
+    /**
+     * @brief Dependency-injection interface for the timer service.
+     *
+     * @see OpenLcbTimer_initialize
+     */
+typedef struct {
+
+        /** @brief REQUIRED. Current value of the global 100 ms tick. Typical impl: OpenLcbConfig_get_global_100ms_tick. */
+    uint8_t (*get_current_tick)(void);
+
+        /** @brief OPTIONAL. Free-running millisecond counter (wraps at 2^32). NULL = build the clock from the 100 ms tick. */
+    uint32_t (*get_time_ms)(void);
+
+} interface_openlcb_timer_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+        /**
+         * @brief Registers the interface, cancels all timers and starts the clock.
+         *
+         * @param interface  Pointer to a populated @ref interface_openlcb_timer_t.
+         *                   Must remain valid for the lifetime of the application.
+         *
+         * @warning NOT thread-safe - call during single-threaded initialization only.
+         */
+    extern void OpenLcbTimer_initialize(const interface_openlcb_timer_t *interface);
+
+        /**
+         * @brief Returns the monotonic millisecond clock.
+         *
+         * @details On the tick fallback the clock is advanced by the ticks seen
+         * since the last call, so it must be read at least once every 25.5 s.
+         * OpenLcbTimer_run() does that from the main loop.
+         *
+         * @return Milliseconds since initialize (wraps at 2^32).
+         *
+         * @warning Main loop only.
+         */
+    extern uint32_t OpenLcbTimer_get_time_ms(void);
+
+        /**
+         * @brief Returns true once strictly more than duration_ms has passed since start_ms.
+         *
+         * @param start_ms     Clock value when the wait began.
+         * @param duration_ms  Minimum wait (less than 2^31).
+         *
+         * @warning Main loop only.
+         */
+    extern bool OpenLcbTimer_has_elapsed(uint32_t start_ms, uint32_t duration_ms);
+
+        /**
+         * @brief Schedules (or reschedules) a one-shot timer.
+         *
+         * @param timer        Caller-owned timer.
+         * @param delay_ms     Fires once strictly more than this has elapsed (less than 2^31).
+         * @param callback     Function to call on expiry.
+         * @param context      Passed to callback.
+         *
+         * @warning Main loop only.
+         */
+    extern void OpenLcbTimer_start(openlcb_timer_t *timer, uint32_t delay_ms, openlcb_timer_callback_t callback, void *context);
+
+        /**
+         * @brief Cancels a timer.  Safe to call on a timer that is not active.
+         *
+         * @param timer  Timer to cancel.
+         */
+    extern void OpenLcbTimer_stop(openlcb_timer_t *timer);
+
+        /**
+         * @brief Fires every timer whose deadline has passed, earliest first.
+         *
+         * @details A callback may start or stop any timer, including its own.
+         *
+         * @warning Main loop only.
+         */
+    extern void OpenLcbTimer_run(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __OPENLCB_OPENLCB_TIMER__ */
@@ -0,0 +1,374 @@
+/** \copyright
+* Copyright (c) 2024, Jim Kueneman
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  - Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+*  - Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* @file openlcb_timer_Test.cxx
+* @brief Unit tests for the millisecond clock and one-shot timers.
+*
+* @details Covers the 100 ms tick fallback clock (including tick wrap), the
+* hardware millisecond clock, has_elapsed rounding, deadline ordering,
+* stop/restart, and timers started from inside a callback.
+*
+* @author Jim Kueneman
+* @date 18 Oct 2026
+*/
+
+#include "test/main_Test.hxx"
+
+#include "openlcb_timer.h"
+
+// ============================================================================
+// Mock clocks
+// ============================================================================
+
+static uint8_t _tick = 0;
+static uint32_t _time_ms = 0;
+
+static uint8_t _get_current_tick(void) { return _tick; }
+static uint32_t _get_time_ms(void) { return _time_ms; }
+
+static const interface_openlcb_timer_t _tick_interface = {
+
+    .get_current_tick = &_get_current_tick,
+    .get_time_ms = NULL,
+
+};
+
+static const interface_openlcb_timer_t _ms_interface = {
+
+    .get_current_tick = &_get_current_tick,
+    .get_time_ms = &_get_time_ms,
+
+};
+
+// ============================================================================
+// Callback recording
+// ============================================================================
+
+#define MAX_FIRED 8
+
+static int _fired[MAX_FIRED];
+static int _fired_count = 0;
+
+static void _record(void *context) {
+
+    if (_fired_count < MAX_FIRED) {
+
+        _fired[_fired_count] = *(int *) context;
+
+    }
+
+    _fired_count++;
+
+}
+
+static void _reset(const interface_openlcb_timer_t *interface) {
+
+    _tick = 0;
+    _time_ms = 0;
+    _fired_count = 0;
+
+    for (int i = 0; i < MAX_FIRED; i++) {
+
+        _fired[i] = -1;
+
+    }
+
+    OpenLcbTimer_initialize(interface);
+
+}
+
+// ============================================================================
+// TEST: Tick fallback clock advances 100 ms per tick and survives tick wrap
+// ============================================================================
+
+TEST(OpenLcbTimer, tick_clock)
+{
+
+    _tick = 250;
+    _fired_count = 0;
+    OpenLcbTimer_initialize(&_tick_interface);
+
+    EXPECT_EQ(OpenLcbTimer_get_time_ms(), 0u);
+
+    _tick = 253;
+    EXPECT_EQ(OpenLcbTimer_get_time_ms(), 300u);
+
+    // 8-bit tick wraps, clock keeps counting
+    _tick = 4;
+    EXPECT_EQ(OpenLcbTimer_get_time_ms(), 1000u);
+    EXPECT_EQ(OpenLcbTimer_get_time_ms(), 1000u);
+
+}
+
+// ============================================================================
+// TEST: Hardware clock is passed straight through
+// ============================================================================
+
+TEST(OpenLcbTimer, hardware_clock)
+{
+
+    _reset(&_ms_interface);
+
+    _time_ms = 12345;
+    _tick = 7;
+
+    EXPECT_EQ(OpenLcbTimer_get_time_ms(), 12345u);
+
+    _time_ms = 0xFFFFFFF0UL;
+    EXPECT_EQ(OpenLcbTimer_get_time_ms(), 0xFFFFFFF0UL);
+
+}
+
+// ============================================================================
+// TEST: has_elapsed needs strictly more than the duration, across the wrap
+// ============================================================================
+
+TEST(OpenLcbTimer, has_elapsed)
+{
+
+    _reset(&_ms_interface);
+
+    _time_ms = 1200;
+    EXPECT_FALSE(OpenLcbTimer_has_elapsed(1000, 200));
+
+    _time_ms = 1201;
+    EXPECT_TRUE(OpenLcbTimer_has_elapsed(1000, 200));
+
+    _time_ms = 50;
+    EXPECT_FALSE(OpenLcbTimer_has_elapsed(0xFFFFFFFFUL - 149, 200));
+
+    _time_ms = 51;
+    EXPECT_TRUE(OpenLcbTimer_has_elapsed(0xFFFFFFFFUL - 149, 200));
+
+    // On the tick clock a 200 ms wait takes three ticks
+    _reset(&_tick_interface);
+
+    uint32_t start = OpenLcbTimer_get_time_ms();
+
+    _tick = 2;
+    EXPECT_FALSE(OpenLcbTimer_has_elapsed(start, 200));
+
+    _tick = 3;
+    EXPECT_TRUE(OpenLcbTimer_has_elapsed(start, 200));
+
+}
+
+// ============================================================================
+// TEST: Timers fire in deadline order once their deadline has passed
+// ============================================================================
+
+TEST(OpenLcbTimer, run_fires_in_deadline_order)
+{
+
+    _reset(&_ms_interface);
+
+    openlcb_timer_t a = {};
+    openlcb_timer_t b = {};
+    openlcb_timer_t c = {};
+    int id_a = 1;
+    int id_b = 2;
+    int id_c = 3;
+
+    OpenLcbTimer_start(&a, 300, &_record, &id_a);
+    OpenLcbTimer_start(&b, 100, &_record, &id_b);
+    OpenLcbTimer_start(&c, 200, &_record, &id_c);
+
+    EXPECT_TRUE(a.active);
+    EXPECT_EQ(a.deadline_ms, 300u);
+
+    _time_ms = 100;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 0);
+
+    _time_ms = 250;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 2);
+    EXPECT_EQ(_fired[0], 2);
+    EXPECT_EQ(_fired[1], 3);
+    EXPECT_FALSE(b.active);
+    EXPECT_FALSE(c.active);
+    EXPECT_TRUE(a.active);
+
+    _time_ms = 1000;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 3);
+    EXPECT_EQ(_fired[2], 1);
+    EXPECT_FALSE(a.active);
+
+}
+
+// ============================================================================
+// TEST: Equal deadlines fire in the order they were started
+// ============================================================================
+
+TEST(OpenLcbTimer, equal_deadlines_fifo)
+{
+
+    _reset(&_ms_interface);
+
+    openlcb_timer_t a = {};
+    openlcb_timer_t b = {};
+    int id_a = 1;
+    int id_b = 2;
+
+    OpenLcbTimer_start(&a, 100, &_record, &id_a);
+    OpenLcbTimer_start(&b, 100, &_record, &id_b);
+
+    _time_ms = 101;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 2);
+    EXPECT_EQ(_fired[0], 1);
+    EXPECT_EQ(_fired[1], 2);
+
+}
+
+// ============================================================================
+// TEST: Stop and restart
+// ============================================================================
+
+TEST(OpenLcbTimer, stop_and_restart)
+{
+
+    _reset(&_ms_interface);
+
+    openlcb_timer_t a = {};
+    openlcb_timer_t b = {};
+    int id_a = 1;
+    int id_b = 2;
+
+    // Stopping a timer that was never started is harmless
+    OpenLcbTimer_stop(&a);
+
+    OpenLcbTimer_start(&a, 100, &_record, &id_a);
+    OpenLcbTimer_start(&b, 200, &_record, &id_b);
+    OpenLcbTimer_stop(&a);
+
+    EXPECT_FALSE(a.active);
+
+    // Restarting moves the deadline rather than adding a second entry
+    OpenLcbTimer_start(&b, 50, &_record, &id_b);
+    OpenLcbTimer_start(&b, 400, &_record, &id_b);
+
+    _time_ms = 300;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 0);
+
+    _time_ms = 401;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 1);
+    EXPECT_EQ(_fired[0], 2);
+
+    _time_ms = 1000;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 1);
+
+}
+
+// ============================================================================
+// TEST: A callback may restart its own timer; it does not refire in the same run
+// ============================================================================
+
+static openlcb_timer_t _periodic;
+static int _periodic_count = 0;
+
+static void _periodic_callback(void *context) {
+
+    (void) context;
+
+    _periodic_count++;
+
+    OpenLcbTimer_start(&_periodic, 0, &_periodic_callback, NULL);
+
+}
+
+TEST(OpenLcbTimer, restart_from_callback)
+{
+
+    _reset(&_ms_interface);
+
+    _periodic_count = 0;
+    OpenLcbTimer_stop(&_periodic);
+    OpenLcbTimer_start(&_periodic, 100, &_periodic_callback, NULL);
+
+    _time_ms = 101;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_periodic_count, 1);
+    EXPECT_TRUE(_periodic.active);
+
+    _time_ms = 102;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_periodic_count, 2);
+
+    OpenLcbTimer_stop(&_periodic);
+
+}
+
+// ============================================================================
+// TEST: Deadlines that straddle the 32-bit wrap stay ordered
+// ============================================================================
+
+TEST(OpenLcbTimer, deadline_wraparound)
+{
+
+    _reset(&_ms_interface);
+
+    openlcb_timer_t a = {};
+    openlcb_timer_t b = {};
+    int id_a = 1;
+    int id_b = 2;
+
+    _time_ms = 0xFFFFFF00UL;
+
+    OpenLcbTimer_start(&a, 0x200, &_record, &id_a);
+    OpenLcbTimer_start(&b, 0x80, &_record, &id_b);
+
+    _time_ms = 0xFFFFFF81UL;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 1);
+    EXPECT_EQ(_fired[0], 2);
+
+    _time_ms = 0x100;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 1);
+
+    _time_ms = 0x101;
+    OpenLcbTimer_run();
+
+    EXPECT_EQ(_fired_count, 2);
+    EXPECT_EQ(_fired[1], 1);
+
+}
@@ -85,8 +85,10 @@
 // so that every header including openlcb_types.h sees the resolved flag)
 // =============================================================================
 
+// Both transports together run the CAN <-> TCP router (openlcb_router.h):
+// local nodes reach both links and received traffic crosses when it has to.
 #if defined(OPENLCB_COMPILE_CAN) && defined(OPENLCB_COMPILE_TCP)
-#error "Only one transport can be active at a time. Define OPENLCB_COMPILE_CAN or OPENLCB_COMPILE_TCP, not both."
+#define OPENLCB_COMPILE_ROUTER
 #endif
 
 #if !defined(OPENLCB_COMPILE_CAN) && !defined(OPENLCB_COMPILE_TCP)
@@ -150,6 +152,43 @@ extern "C" {
 #endif
 #if USER_DEFINED_MAX_CONCURRENT_ACTIVE_STREAMS < 1
 #error "USER_DEFINED_MAX_CONCURRENT_ACTIVE_STREAMS must be >= 1 to avoid a zero-length array"
+#endif
+
+    /** @brief Outgoing datagrams a node can have awaiting a reply, each to a different remote node */
+#ifndef USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH
+#define USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH      2
+#endif
+#if USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH < 1
+#error "USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH must be >= 1 to avoid a zero-length array"
+#endif
+
+    /** @brief Config memory reads (and, separately, writes) that can wait on a CONFIG_MEM_ACCESS_PENDING access at once */
+#ifndef USER_DEFINED_CONFIG_MEM_PENDING_DEPTH
+#define USER_DEFINED_CONFIG_MEM_PENDING_DEPTH        1
+#endif
+#if USER_DEFINED_CONFIG_MEM_PENDING_DEPTH < 1
+#error "USER_DEFINED_CONFIG_MEM_PENDING_DEPTH must be >= 1 to avoid a zero-length array"
+#endif
+
+    /** @brief Lines in the config memory write-back cache (OPENLCB_COMPILE_CONFIG_MEM_CACHE) */
+#ifndef USER_DEFINED_CONFIG_MEM_CACHE_LINES
+#define USER_DEFINED_CONFIG_MEM_CACHE_LINES          4
+#endif
+#if USER_DEFINED_CONFIG_MEM_CACHE_LINES < 1
+#error "USER_DEFINED_CONFIG_MEM_CACHE_LINES must be >= 1 to avoid a zero-length array"
+#endif
+
+    /** @brief Bytes per cache line; set to the EEPROM/flash page size so a flush is one page program */
+#ifndef USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE
+#define USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE      64
+#endif
+#if (USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE < 1) || (USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE > 64)
+#error "USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE must be 1..64 (one configuration_memory_buffer_t)"
+#endif
+
+    /** @brief Milliseconds without a config memory write before dirty cache lines are flushed */
+#ifndef USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS
+#define USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS  1000
 #endif
 
     /** @brief Maximum number of virtual nodes that can be allocated */
@@ -299,6 +338,16 @@ extern "C" {
     /** @brief Total number of message buffers (sum of all buffer types) */
 #define LEN_MESSAGE_BUFFER (USER_DEFINED_BASIC_BUFFER_DEPTH + USER_DEFINED_DATAGRAM_BUFFER_DEPTH + USER_DEFINED_SNIP_BUFFER_DEPTH + USER_DEFINED_STREAM_BUFFER_DEPTH)
 
+    /**
+     * @brief Buckets in each source-alias message index (BufferList, BufferFifo).
+     *
+     * @details Power of two, about one bucket per buffer, capped at 64.
+     *
+     * @see OpenLcbUtilities_alias_chain_insert
+     */
+#define LEN_MESSAGE_ALIAS_INDEX \
+    ((LEN_MESSAGE_BUFFER) <= 8 ? 8 : (LEN_MESSAGE_BUFFER) <= 16 ? 16 : (LEN_MESSAGE_BUFFER) <= 32 ? 32 : 64)
+
     /** @brief Maximum datagram payload after protocol overhead */
 #define LEN_DATAGRAM_MAX_PAYLOAD 64
 
@@ -555,26 +604,15 @@ extern "C" {
         /**
          * @brief Timer field union for openlcb_msg_t.
          *
-         * @details Shares one byte between two mutually exclusive uses:
-         * - assembly_ticks: full 8-bit tick snapshot for multi-frame assembly
-         *   timeout (used by CAN RX message handler and BufferList timeout).
-         * - datagram: split into a 5-bit tick snapshot and a 3-bit retry
-         *   counter for datagram rejected/resend logic.
-         *
-         * Only one interpretation is active at a time depending on the
-         * message lifecycle stage.
+         * @details assembly_ticks is the full 8-bit tick snapshot for
+         * multi-frame assembly timeout (used by CAN RX message handler and
+         * BufferList timeout).  Retry state of outgoing datagrams lives in
+         * the node's @ref datagram_outstanding_t table, not in the message.
          */
     typedef union {
 
         uint8_t assembly_ticks;     /**< Full 8-bit tick for multi-frame assembly timeout */
 
-        struct {
-
-            uint8_t tick_snapshot : 5;  /**< 5-bit tick snapshot (0-31) for datagram retry timeout */
-            uint8_t retry_count : 3;   /**< Datagram retry counter (0-7) */
-
-        } datagram;
-
     } openlcb_msg_timer_t;
 
         /**
@@ -584,9 +622,14 @@ extern "C" {
          * reference count.  Multi-frame messages are assembled with
          * state.inprocess = 1 until the final frame arrives.
          *
+         * alias_chain_next/prev link the message into the source-alias index
+         * of whichever container (BufferList or BufferFifo) holds it, so an
+         * AMR only visits that alias's messages.  A message is in at most one
+         * container at a time, and source_alias must not change while it is.
+         *
          * @warning Reference count must be managed correctly to prevent leaks.
          */
-    typedef struct {
+    typedef struct openlcb_msg_struct {
 
         openlcb_msg_state_t state;      /**< Message state flags */
         uint16_t mti;                   /**< Message Type Indicator */
@@ -599,6 +642,8 @@ extern "C" {
         openlcb_payload_t *payload;     /**< Pointer to payload buffer */
         openlcb_msg_timer_t timer;      /**< Timer/retry union (assembly or datagram) */
         uint8_t reference_count;        /**< Number of active references to this message */
+        struct openlcb_msg_struct *alias_chain_next; /**< Next message in the same source-alias bucket */
+        struct openlcb_msg_struct *alias_chain_prev; /**< Previous message in the bucket, NULL at the head */
 
     } openlcb_msg_t;
 
@@ -732,7 +777,7 @@ extern "C" {
         bool initialized : 1;              /**< Node fully initialized */
         bool duplicate_id_detected : 1;     /**< Duplicate Node ID conflict */
         bool openlcb_datagram_ack_sent : 1; /**< Datagram ACK sent, awaiting reply */
-        bool resend_datagram : 1;           /**< Resend last datagram (retry logic) */
+        bool resend_datagram : 1;           /**< An outstanding datagram is waiting to be resent */
         bool firmware_upgrade_active : 1;   /**< Firmware upgrade in progress */
 
     } openlcb_node_state_t;
@@ -782,6 +827,28 @@ extern "C" {
 
     } train_state_t;
 
+    /** @brief datagram_outstanding_t heap_index of an entry not in the deadline heap */
+#define DATAGRAM_HEAP_INDEX_NONE 0xFFFF
+
+        /**
+         * @brief One outgoing datagram awaiting Datagram Received OK or Rejected.
+         *
+         * @details Keyed by the remote node the datagram was sent to (its
+         * dest_alias / dest_id).  Each entry keeps its own retry counter and
+         * deadline, so transfers with different peers time out and retry
+         * independently.  Scheduled entries sit in the datagram handler's
+         * deadline heap at heap_index.
+         */
+    typedef struct {
+
+        openlcb_msg_t *datagram;    /**< Stored copy for resend; NULL = entry free */
+        uint16_t heap_index;        /**< Slot in the deadline heap, or DATAGRAM_HEAP_INDEX_NONE */
+        uint32_t deadline_ms;       /**< Clock (ms) the reply times out, or the resend is due */
+        uint8_t retry_count;        /**< Temporary rejections so far */
+        bool resend : 1;            /**< Rejected with resend OK; waiting to go out again */
+
+    } datagram_outstanding_t;
+
         /**
          * @brief OpenLCB virtual node.
          *
@@ -798,8 +865,9 @@ extern "C" {
         event_id_producer_list_t producers;
         const node_parameters_t *parameters;
         uint16_t timerticks;                    /**< 100ms timer tick counter */
+        uint32_t timer_ms;                      /**< Millisecond clock snapshot (CAN login wait) */
         uint64_t owner_node;                    /**< Node ID that has locked this node */
-        openlcb_msg_t *last_received_datagram;  /**< Saved for reply processing */
+        datagram_outstanding_t outstanding_datagrams[USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH]; /**< Sent datagrams awaiting a reply */
         uint8_t index;                          /**< Index in node array */
         struct train_state_TAG *train_state;    /**< NULL if not a train node */
 
@@ -857,6 +925,7 @@ extern "C" {
         openlcb_incoming_msg_info_t incoming_msg_info;
         openlcb_outgoing_msg_info_t outgoing_msg_info;
         uint8_t current_tick;
+        uint32_t current_time_ms;   /**< Millisecond clock when the message was popped */
 
     } openlcb_statemachine_info_t;
 
@@ -951,6 +1020,38 @@ extern "C" {
          */
     typedef void (*write_result_t)(openlcb_statemachine_info_t *statemachine_info, config_mem_write_request_info_t *config_mem_write_request_info, bool success);
 
+        /** @brief What a parked config memory read finishes once its data arrives. */
+    typedef enum {
+
+        CONFIG_MEM_PENDING_READ_REPLY = 0,          /**< Datagram read (0xFD, 0xFB): send the Read Reply */
+        CONFIG_MEM_PENDING_SNIP_USER_NAME,          /**< SNIP reply waiting on the user name */
+        CONFIG_MEM_PENDING_SNIP_USER_DESCRIPTION,   /**< SNIP reply waiting on the user description */
+        CONFIG_MEM_PENDING_WRITE_UNDER_MASK         /**< Write-under-mask waiting on the bytes it merges into */
+
+    } config_mem_pending_kind_enum;
+
+        /**
+         * @brief A config memory read or write waiting on a CONFIG_MEM_ACCESS_PENDING access.
+         *
+         * @details Holds what is needed to build the reply once the application
+         * completes the access, after the request message itself has been freed.
+         */
+    typedef struct {
+
+        openlcb_node_t *openlcb_node;  /**< Node being accessed, NULL when the slot is free */
+        config_mem_pending_kind_enum kind; /**< What completing a parked read finishes (reads only) */
+        openlcb_msg_t *held_msg;       /**< Buffer kept until completion (SNIP reply, write-under-mask request), or NULL */
+        uint16_t reply_alias;          /**< Requester alias */
+        node_id_t reply_id;            /**< Requester Node ID */
+        uint8_t command;               /**< Request command byte (payload[1]) */
+        uint8_t space;                 /**< Request space byte (payload[6]) */
+        space_encoding_enum encoding;  /**< Where the space number was encoded */
+        uint32_t address;              /**< Address echoed in the reply */
+        uint16_t bytes;                /**< Bytes requested */
+        uint16_t data_start;           /**< Reply data offset */
+
+    } config_mem_pending_request_t;
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -148,6 +148,84 @@ void OpenLcbUtilities_clear_openlcb_message(openlcb_msg_t *openlcb_msg) {
     openlcb_msg->state.allocated = false;
     openlcb_msg->state.inprocess = false;
     openlcb_msg->state.invalid = false;
+    openlcb_msg->alias_chain_next = NULL;
+    openlcb_msg->alias_chain_prev = NULL;
+
+}
+
+    /** @brief Links msg at the tail of the bucket chosen by its source_alias, keeping arrival order. */
+void OpenLcbUtilities_alias_chain_insert(openlcb_msg_t **index, uint16_t mask, openlcb_msg_t *msg) {
+
+    openlcb_msg_t **link = &index[msg->source_alias & mask];
+    openlcb_msg_t *prev = NULL;
+
+    while (*link) {
+
+        prev = *link;
+        link = &prev->alias_chain_next;
+
+    }
+
+    msg->alias_chain_prev = prev;
+    msg->alias_chain_next = NULL;
+
+    *link = msg;
+
+}
+
+    /**
+     * @brief Unlinks a message from a source-alias index.
+     *
+     * @details Algorithm:
+     * -# If msg has a predecessor, bypass it there
+     * -# Otherwise msg heads a bucket: try its home bucket, then every bucket
+     *    (covers a source_alias rewritten while linked); return if not found
+     * -# Bypass it in the successor and clear both links
+     *
+     * @verbatim
+     * @param index  Bucket array of mask + 1 heads.
+     * @param mask   Bucket count - 1.
+     * @param msg    Message currently linked into index.
+     * @endverbatim
+     */
+void OpenLcbUtilities_alias_chain_remove(openlcb_msg_t **index, uint16_t mask, openlcb_msg_t *msg) {
+
+    if (msg->alias_chain_prev) {
+
+        msg->alias_chain_prev->alias_chain_next = msg->alias_chain_next;
+
+    } else if (index[msg->source_alias & mask] == msg) {
+
+        index[msg->source_alias & mask] = msg->alias_chain_next;
+
+    } else {
+
+        uint16_t bucket = 0;
+
+        while ((bucket <= mask) && (index[bucket] != msg)) {
+
+            bucket++;
+
+        }
+
+        if (bucket > mask) {
+
+            return;
+
+        }
+
+        index[bucket] = msg->alias_chain_next;
+
+    }
+
+    if (msg->alias_chain_next) {
+
+        msg->alias_chain_next->alias_chain_prev = msg->alias_chain_prev;
+
+    }
+
+    msg->alias_chain_next = NULL;
+    msg->alias_chain_prev = NULL;
 
 }
 
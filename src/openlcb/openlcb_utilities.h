@@ -82,6 +82,32 @@ extern "C" {
          */
     extern void OpenLcbUtilities_clear_openlcb_message(openlcb_msg_t *openlcb_msg);
 
+        /**
+         * @brief Links a message into a source-alias index.
+         *
+         * @details The index is an array of mask + 1 chain heads; the bucket is
+         * source_alias & mask and msg is appended, so a walk through
+         * alias_chain_next visits one alias's messages oldest first.
+         *
+         * @param index  Bucket array of mask + 1 heads.
+         * @param mask   Bucket count - 1 (bucket count is a power of two).
+         * @param msg    Message not currently linked into any index.
+         *
+         * @see OpenLcbUtilities_alias_chain_remove
+         */
+    extern void OpenLcbUtilities_alias_chain_insert(openlcb_msg_t **index, uint16_t mask, openlcb_msg_t *msg);
+
+        /**
+         * @brief Unlinks a message from a source-alias index and clears its links.
+         *
+         * @param index  Bucket array the message was inserted into.
+         * @param mask   Bucket count - 1.
+         * @param msg    Message currently linked into index.
+         *
+         * @see OpenLcbUtilities_alias_chain_insert
+         */
+    extern void OpenLcbUtilities_alias_chain_remove(openlcb_msg_t **index, uint16_t mask, openlcb_msg_t *msg);
+
     // =========================================================================
     // Payload Insert Functions (all big-endian, all increment payload_count)
     // =========================================================================
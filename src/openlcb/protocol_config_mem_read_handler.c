@@ -58,6 +58,9 @@
     /** @brief Stored callback interface pointer; set by _initialize(). */
 static interface_protocol_config_mem_read_handler_t *_interface;
 
+    /** @brief Reads waiting on a CONFIG_MEM_ACCESS_PENDING access, whoever issued them. */
+static config_mem_pending_request_t _pending_reads[USER_DEFINED_CONFIG_MEM_PENDING_DEPTH];
+
     /**
      * @brief Stores the callback interface.  Call once at startup.
      *
@@ -71,6 +74,142 @@ void ProtocolConfigMemReadHandler_initialize(const interface_protocol_config_mem
 
     _interface = (interface_protocol_config_mem_read_handler_t *) interface_protocol_config_mem_read_handler;
 
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_PENDING_DEPTH; i++) {
+
+        _pending_reads[i].openlcb_node = NULL;
+        _pending_reads[i].held_msg = NULL;
+
+    }
+
+}
+
+    /** @brief Returns the read parked for openlcb_node, or NULL. */
+static config_mem_pending_request_t *_find_pending_read(openlcb_node_t *openlcb_node) {
+
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_PENDING_DEPTH; i++) {
+
+        if (_pending_reads[i].openlcb_node == openlcb_node) {
+
+            return &_pending_reads[i];
+
+        }
+
+    }
+
+    return NULL;
+
+}
+
+    /**
+     * @brief Returns true if a read for the node could be parked right now.
+     *
+     * @verbatim
+     * @param openlcb_node  Node about to be read.
+     * @endverbatim
+     *
+     * @return true if no read is parked for the node and a slot is free.
+     */
+bool ProtocolConfigMemReadHandler_can_park_read(openlcb_node_t *openlcb_node) {
+
+    return !_find_pending_read(openlcb_node) && _find_pending_read(NULL);
+
+}
+
+    /**
+     * @brief Parks a read issued outside this handler (SNIP, write-under-mask).
+     *
+     * @verbatim
+     * @param request  Filled-in request; copied into the slot.
+     * @endverbatim
+     *
+     * @return true if parked.
+     */
+bool ProtocolConfigMemReadHandler_park_read(const config_mem_pending_request_t *request) {
+
+    if (!request->openlcb_node || !ProtocolConfigMemReadHandler_can_park_read(request->openlcb_node)) {
+
+        return false;
+
+    }
+
+    *_find_pending_read(NULL) = *request;
+
+    return true;
+
+}
+
+    /**
+     * @brief True while a read for the node is parked or every park slot is
+     * taken, for the spaces whose read goes through config_memory_read and so
+     * can park (Config 0xFD and ACDI-User 0xFB).  Other spaces are never blocked.
+     */
+static bool _is_read_blocked(openlcb_node_t *openlcb_node, config_mem_read_request_info_t *config_mem_read_request_info) {
+
+    if ((config_mem_read_request_info->read_space_func != &ProtocolConfigMemReadHandler_read_request_config_mem) &&
+            (config_mem_read_request_info->read_space_func != &ProtocolConfigMemReadHandler_read_request_acdi_user)) {
+
+        return false;
+
+    }
+
+    return !ProtocolConfigMemReadHandler_can_park_read(openlcb_node);
+
+}
+
+    /**
+     * @brief Parks a read whose config_memory_read returned CONFIG_MEM_ACCESS_PENDING.
+     *
+     * @details Copies the requester and request header out of the incoming
+     * datagram so the reply can be built after that buffer is freed.
+     *
+     * @param statemachine_info            Context with incoming message.
+     * @param config_mem_read_request_info  Request being parked.
+     *
+     * @return true if a slot was free.
+     */
+static bool _park_read(openlcb_statemachine_info_t *statemachine_info, config_mem_read_request_info_t *config_mem_read_request_info) {
+
+    config_mem_pending_request_t *pending = _find_pending_read(NULL);
+
+    if (!pending) {
+
+        return false;
+
+    }
+
+    pending->openlcb_node = statemachine_info->openlcb_node;
+    pending->kind = CONFIG_MEM_PENDING_READ_REPLY;
+    pending->held_msg = NULL;
+    pending->reply_alias = statemachine_info->incoming_msg_info.msg_ptr->source_alias;
+    pending->reply_id = statemachine_info->incoming_msg_info.msg_ptr->source_id;
+    pending->command = *statemachine_info->incoming_msg_info.msg_ptr->payload[1];
+    pending->space = *statemachine_info->incoming_msg_info.msg_ptr->payload[6];
+    pending->encoding = config_mem_read_request_info->encoding;
+    pending->address = config_mem_read_request_info->address;
+    pending->bytes = config_mem_read_request_info->bytes;
+    pending->data_start = config_mem_read_request_info->data_start;
+
+    return true;
+
+}
+
+    /**
+     * @brief Parks a datagram read whose data is not ready, or fails it if no
+     * slot is free (phase 1 normally guarantees one).
+     */
+static void _park_or_fail_read(openlcb_statemachine_info_t *statemachine_info, config_mem_read_request_info_t *config_mem_read_request_info) {
+
+    if (_park_read(statemachine_info, config_mem_read_request_info)) {
+
+        statemachine_info->outgoing_msg_info.valid = false;
+
+        return;
+
+    }
+
+    OpenLcbUtilities_load_config_mem_reply_read_fail_message_header(statemachine_info, config_mem_read_request_info, ERROR_TEMPORARY_TRANSFER_ERROR);
+    statemachine_info->outgoing_msg_info.valid = true;
+
 }
 
     /**
@@ -160,7 +299,10 @@ static void _check_for_read_overrun(openlcb_statemachine_info_t *statemachine_in
      * @details Algorithm:
      * -# Extract parameters from incoming datagram
      * -# Phase 1: validate → reject or ACK + re-invoke
-     * -# Phase 2: clamp overrun, call space-specific read, reset flags
+     * -# Phase 1 also rejects Config space (0xFD) reads with a temporary error
+     *    while a read for the node is parked or no park slot is free
+     * -# Phase 2: clamp overrun, call space-specific read, reset flags unless
+     *    the space handler asked to be called again
      *
      * @param statemachine_info            Context.
      * @param config_mem_read_request_info  Carries callback + space_info.
@@ -175,6 +317,12 @@ static void _handle_read_request(openlcb_statemachine_info_t *statemachine_info,
 
         error_code = _is_valid_read_parameters(config_mem_read_request_info);
 
+        if (!error_code && _is_read_blocked(statemachine_info->openlcb_node, config_mem_read_request_info)) {
+
+            error_code = ERROR_TEMPORARY_BUFFER_UNAVAILABLE; // earlier read still waiting on storage
+
+        }
+
         if (error_code) {
 
             _interface->load_datagram_received_rejected_message(statemachine_info, error_code);
@@ -312,6 +460,8 @@ void ProtocolConfigMemReadHandler_read_request_train_function_config_memory(open
      * @brief Read from Config space (0xFD) via config_memory_read callback.
      *
      * @details Partial reads (fewer bytes than requested) return TRANSFER_ERROR.
+     * A CONFIG_MEM_ACCESS_PENDING return parks the request with no reply; the
+     * application sends it later through ProtocolConfigMemReadHandler_complete_read().
      */
 void ProtocolConfigMemReadHandler_read_request_config_mem(openlcb_statemachine_info_t *statemachine_info, config_mem_read_request_info_t *config_mem_read_request_info) {
 
@@ -326,6 +476,20 @@ void ProtocolConfigMemReadHandler_read_request_config_mem(openlcb_statemachine_i
                 (configuration_memory_buffer_t*) & statemachine_info->outgoing_msg_info.msg_ptr->payload[config_mem_read_request_info->data_start]
                 );
 
+        if (read_count == CONFIG_MEM_ACCESS_PENDING) {
+
+            if (_park_read(statemachine_info, config_mem_read_request_info)) {
+
+                statemachine_info->outgoing_msg_info.valid = false;
+
+                return;
+
+            }
+
+            read_count = 0; // nowhere to park it, fail the read
+
+        }
+
         statemachine_info->outgoing_msg_info.msg_ptr->payload_count += read_count;
 
         if (read_count < config_mem_read_request_info->bytes) {
@@ -349,6 +513,110 @@ void ProtocolConfigMemReadHandler_read_request_config_mem(openlcb_statemachine_i
 
     }
 
+}
+
+    /**
+     * @brief Finishes a read that config_memory_read left pending.
+     *
+     * @details Algorithm:
+     * -# Find the read parked for the node; fail if none
+     * -# SNIP and write-under-mask reads are handed to the protocol that parked
+     *    them, which frees the slot once it is done with it
+     * -# Otherwise it is a datagram read: fail if no send_openlcb_msg
+     * -# Rebuild a minimal request (requester, command and space bytes) so the
+     *    standard reply header loaders can be used
+     * -# Load Read Reply with the data, or Read Reply Fail (TRANSFER_ERROR)
+     *    if fewer than the requested bytes were supplied
+     * -# Send it; free the slot only if the send was accepted
+     *
+     * @verbatim
+     * @param openlcb_node  Node passed to config_memory_read.
+     * @param data          Bytes read.
+     * @param count         Number of bytes in data.
+     * @endverbatim
+     *
+     * @return true if the reply was sent.
+     */
+bool ProtocolConfigMemReadHandler_complete_read(openlcb_node_t *openlcb_node, const uint8_t *data, uint16_t count) {
+
+    config_mem_pending_request_t *pending = _find_pending_read(openlcb_node);
+
+    if (!pending || !openlcb_node) {
+
+        return false;
+
+    }
+
+    switch (pending->kind) {
+
+        case CONFIG_MEM_PENDING_SNIP_USER_NAME:
+        case CONFIG_MEM_PENDING_SNIP_USER_DESCRIPTION:
+
+            return _interface->snip_complete_read && _interface->snip_complete_read(pending, data, count);
+
+        case CONFIG_MEM_PENDING_WRITE_UNDER_MASK:
+
+            return _interface->write_under_mask_complete_read && _interface->write_under_mask_complete_read(pending, data, count);
+
+        default:
+
+            break;
+
+    }
+
+    if (!_interface->send_openlcb_msg) {
+
+        return false;
+
+    }
+
+    openlcb_msg_t request_msg = {0};
+    payload_basic_t request_payload = {0};
+    openlcb_msg_t reply_msg = {0};
+    payload_datagram_t reply_payload;
+    openlcb_statemachine_info_t statemachine_info = {0};
+    config_mem_read_request_info_t config_mem_read_request_info = {0};
+
+    request_msg.payload = (openlcb_payload_t *) &request_payload;
+    request_msg.payload_type = BASIC;
+    request_msg.source_alias = pending->reply_alias;
+    request_msg.source_id = pending->reply_id;
+    request_payload[1] = pending->command;
+    request_payload[6] = pending->space;
+
+    reply_msg.payload = (openlcb_payload_t *) &reply_payload;
+    reply_msg.payload_type = DATAGRAM;
+
+    statemachine_info.openlcb_node = openlcb_node;
+    statemachine_info.incoming_msg_info.msg_ptr = &request_msg;
+    statemachine_info.outgoing_msg_info.msg_ptr = &reply_msg;
+
+    config_mem_read_request_info.encoding = pending->encoding;
+    config_mem_read_request_info.address = pending->address;
+    config_mem_read_request_info.bytes = pending->bytes;
+    config_mem_read_request_info.data_start = pending->data_start;
+
+    if (data && count >= pending->bytes) {
+
+        OpenLcbUtilities_load_config_mem_reply_read_ok_message_header(&statemachine_info, &config_mem_read_request_info);
+        OpenLcbUtilities_copy_byte_array_to_openlcb_payload(&reply_msg, data, pending->data_start, pending->bytes);
+
+    } else {
+
+        OpenLcbUtilities_load_config_mem_reply_read_fail_message_header(&statemachine_info, &config_mem_read_request_info, ERROR_TEMPORARY_TRANSFER_ERROR);
+
+    }
+
+    if (!_interface->send_openlcb_msg(&reply_msg)) {
+
+        return false;
+
+    }
+
+    pending->openlcb_node = NULL;
+
+    return true;
+
 }
 
     /** @brief Read from ACDI-Mfg (0xFC): dispatch to SNIP loaders by address. */
@@ -450,7 +718,14 @@ void ProtocolConfigMemReadHandler_read_request_acdi_manufacturer(openlcb_statema
 
 }
 
-    /** @brief Read from ACDI-User (0xFB): dispatch to SNIP loaders by address. */
+    /**
+     * @brief Read from ACDI-User (0xFB): dispatch to SNIP loaders by address.
+     *
+     * @details The user name and description come from config_memory_read via
+     * the SNIP loaders, which load nothing while that access is pending.  The
+     * request is then parked like a Config space read and answered through
+     * ProtocolConfigMemReadHandler_complete_read().
+     */
 void ProtocolConfigMemReadHandler_read_request_acdi_user(openlcb_statemachine_info_t *statemachine_info, config_mem_read_request_info_t *config_mem_read_request_info) {
 
     OpenLcbUtilities_load_config_mem_reply_read_ok_message_header(statemachine_info, config_mem_read_request_info);
@@ -477,7 +752,13 @@ void ProtocolConfigMemReadHandler_read_request_acdi_user(openlcb_statemachine_in
 
             if (_interface->snip_load_user_name) {
 
-                _interface->snip_load_user_name(statemachine_info->openlcb_node, statemachine_info->outgoing_msg_info.msg_ptr, config_mem_read_request_info->data_start, config_mem_read_request_info->bytes);
+                if (_interface->snip_load_user_name(statemachine_info->openlcb_node, statemachine_info->outgoing_msg_info.msg_ptr, config_mem_read_request_info->data_start, config_mem_read_request_info->bytes) == config_mem_read_request_info->data_start) {
+
+                    _park_or_fail_read(statemachine_info, config_mem_read_request_info); // storage busy, nothing loaded
+
+                    return;
+
+                }
 
             } else {
 
@@ -493,7 +774,13 @@ void ProtocolConfigMemReadHandler_read_request_acdi_user(openlcb_statemachine_in
 
             if (_interface->snip_load_user_description) {
 
-                _interface->snip_load_user_description(statemachine_info->openlcb_node, statemachine_info->outgoing_msg_info.msg_ptr, config_mem_read_request_info->data_start, config_mem_read_request_info->bytes);
+                if (_interface->snip_load_user_description(statemachine_info->openlcb_node, statemachine_info->outgoing_msg_info.msg_ptr, config_mem_read_request_info->data_start, config_mem_read_request_info->bytes) == config_mem_read_request_info->data_start) {
+
+                    _park_or_fail_read(statemachine_info, config_mem_read_request_info); // storage busy, nothing loaded
+
+                    return;
+
+                }
 
             } else {
 
@@ -59,7 +59,8 @@ typedef struct {
         /** @brief Build Datagram Rejected with error code.  REQUIRED. */
     void (*load_datagram_received_rejected_message)(openlcb_statemachine_info_t *statemachine_info, uint16_t return_code);
 
-        /** @brief Read bytes from config memory into buffer.  Returns bytes read.  REQUIRED. */
+        /** @brief Read bytes from config memory into buffer.  Returns bytes read, or
+         *  CONFIG_MEM_ACCESS_PENDING to finish later via ProtocolConfigMemReadHandler_complete_read().  REQUIRED. */
     uint16_t(*config_memory_read)(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
 
     // ---- Optional SNIP field loaders (needed only for ACDI 0xFC / 0xFB spaces) ----
@@ -104,6 +105,18 @@ typedef struct {
         /** @brief Optional — Returns train state for the given node (DI for train module). */
     train_state_t *(*get_train_state)(openlcb_node_t *openlcb_node);
 
+        /** @brief Send a reply outside the main dispatch.  Optional; needed only when
+         *  config_memory_read returns CONFIG_MEM_ACCESS_PENDING.  Typical: the transport's send_openlcb_msg. */
+    bool (*send_openlcb_msg)(openlcb_msg_t *openlcb_msg);
+
+        /** @brief Finish a SNIP reply parked on a pending user name/description read.  Optional;
+         *  NULL fails such completions.  Typical: ProtocolSnip_complete_read. */
+    bool (*snip_complete_read)(config_mem_pending_request_t *pending, const uint8_t *data, uint16_t count);
+
+        /** @brief Finish a write-under-mask parked on its pending read.  Optional; NULL fails such
+         *  completions.  Typical: ProtocolConfigMemWriteHandler_complete_write_under_mask_read. */
+    bool (*write_under_mask_complete_read)(config_mem_pending_request_t *pending, const uint8_t *data, uint16_t count);
+
 } interface_protocol_config_mem_read_handler_t;
 
 
@@ -169,6 +182,61 @@ extern "C" {
          */
     extern void ProtocolConfigMemReadHandler_read_space_train_function_config_memory(openlcb_statemachine_info_t *statemachine_info);
 
+        /**
+         * @brief Finishes a read that config_memory_read left pending.
+         *
+         * @details Every caller of config_memory_read treats CONFIG_MEM_ACCESS_PENDING
+         * the same way: the request is parked here, the incoming message is
+         * released, and nothing is answered until the application calls this
+         * with the bytes it was asked for.  At most one read per node is parked
+         * at a time; while one is, new requests to that node that could park
+         * (or to any node when all USER_DEFINED_CONFIG_MEM_PENDING_DEPTH slots
+         * are taken) are turned away with a temporary error so the requester
+         * retries.
+         *
+         * What is sent depends on the parked request: a Read Reply for a Config
+         * (0xFD) or ACDI-User (0xFB) datagram read, the SNIP reply, or the
+         * write-under-mask Write Reply.  Fewer than the requested bytes fails
+         * the request with TRANSFER_ERROR.  Finishing a SNIP reply may call
+         * config_memory_read again for the user description; if that is pending
+         * too the request stays parked and this returns true.
+         *
+         * @param openlcb_node  Node passed to config_memory_read.
+         * @param data          Bytes read (copied before return).
+         * @param count         Number of bytes in data.
+         *
+         * @return true if the completion was taken; false if no read is parked
+         *         for the node or the transmit path is busy (call again later).
+         */
+    extern bool ProtocolConfigMemReadHandler_complete_read(openlcb_node_t *openlcb_node, const uint8_t *data, uint16_t count);
+
+        /**
+         * @brief Returns true if a read for the node could be parked right now.
+         *
+         * @details False while a read for the node is already parked or every
+         * park slot is taken.  Check it before calling config_memory_read from a
+         * path that parks, so a pending answer always has somewhere to go.
+         *
+         * @param openlcb_node  Node about to be read.
+         *
+         * @return true if ProtocolConfigMemReadHandler_park_read() would succeed.
+         */
+    extern bool ProtocolConfigMemReadHandler_can_park_read(openlcb_node_t *openlcb_node);
+
+        /**
+         * @brief Parks a read whose config_memory_read returned CONFIG_MEM_ACCESS_PENDING.
+         *
+         * @details Used by SNIP and write-under-mask; datagram reads park
+         * internally.  The request is copied.  Ownership of request->held_msg
+         * passes to the slot; the kind's completion frees it.
+         *
+         * @param request  Filled-in request (openlcb_node, kind, requester, ...).
+         *
+         * @return true if parked; false if the node already has a parked read or
+         *         no slot is free.
+         */
+    extern bool ProtocolConfigMemReadHandler_park_read(const config_mem_pending_request_t *request);
+
     // ---- Outgoing read requests (client side — reading from another node) ----
 
         /**
@@ -3112,3 +3112,328 @@ TEST(ProtocolConfigMemReadHandler, read_request_function_config_memory_midrange)
     EXPECT_EQ(*statemachine_info.outgoing_msg_info.msg_ptr->payload[8], 0x34);
 
 }
+
+// ============================================================================
+// Deferred (CONFIG_MEM_ACCESS_PENDING) reads
+// ============================================================================
+
+bool send_openlcb_msg_fail = false;
+int send_openlcb_msg_count = 0;
+openlcb_msg_t sent_msg;
+payload_datagram_t sent_payload;
+
+uint16_t _config_memory_read_pending(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer)
+{
+
+    _update_called_function_ptr((void *)&_config_memory_read_pending);
+
+    return CONFIG_MEM_ACCESS_PENDING;
+}
+
+bool _send_openlcb_msg(openlcb_msg_t *openlcb_msg)
+{
+
+    if (send_openlcb_msg_fail)
+    {
+
+        return false;
+    }
+
+    send_openlcb_msg_count++;
+    sent_msg = *openlcb_msg;
+    memcpy(&sent_payload, openlcb_msg->payload, sizeof(sent_payload));
+    sent_msg.payload = (openlcb_payload_t *)&sent_payload;
+
+    return true;
+}
+
+const interface_protocol_config_mem_read_handler_t interface_protocol_config_mem_read_handler_pending = {
+
+    .load_datagram_received_ok_message = &_load_datagram_received_ok_message,
+    .load_datagram_received_rejected_message = &_load_datagram_rejected_message,
+    .config_memory_read = &_config_memory_read_pending,
+
+    .snip_load_manufacturer_version_id = &ProtocolSnip_load_manufacturer_version_id,
+    .snip_load_name = &ProtocolSnip_load_name,
+    .snip_load_model = &ProtocolSnip_load_model,
+    .snip_load_hardware_version = &ProtocolSnip_load_hardware_version,
+    .snip_load_software_version = &ProtocolSnip_load_software_version,
+    .snip_load_user_version_id = &ProtocolSnip_load_user_version_id,
+    .snip_load_user_name = &ProtocolSnip_load_user_name,
+    .snip_load_user_description = &ProtocolSnip_load_user_description,
+
+    .read_request_config_definition_info = &_read_request_config_decscription_info,
+    .read_request_all = &_read_request_all,
+    .read_request_config_mem = &ProtocolConfigMemReadHandler_read_request_config_mem,
+    .read_request_acdi_manufacturer = &_read_request_acdi_manufacturer,
+    .read_request_acdi_user = &ProtocolConfigMemReadHandler_read_request_acdi_user,
+    .read_request_train_function_config_definition_info = &_read_request_train_config_decscription_info,
+    .read_request_train_function_config_memory = &_read_request_train_config_memory,
+
+    .delayed_reply_time = nullptr,
+    .get_train_state = &OpenLcbApplicationTrain_get_state,
+    .send_openlcb_msg = &_send_openlcb_msg,
+    .snip_complete_read = nullptr,
+    .write_under_mask_complete_read = nullptr
+
+};
+
+interface_openlcb_protocol_snip_t interface_openlcb_protocol_snip_pending = {
+
+    .config_memory_read = &_config_memory_read_pending
+
+};
+
+void _global_initialize_with_pending(void)
+{
+
+    ProtocolConfigMemReadHandler_initialize(&interface_protocol_config_mem_read_handler_pending);
+    OpenLcbNode_initialize(&interface_openlcb_node);
+    ProtocolSnip_initialize(&interface_openlcb_protocol_snip_pending);
+    OpenLcbBufferFifo_initialize();
+    OpenLcbBufferStore_initialize();
+
+    send_openlcb_msg_fail = false;
+    send_openlcb_msg_count = 0;
+}
+
+static void _load_read_fd_request(openlcb_statemachine_info_t *statemachine_info, openlcb_node_t *node, openlcb_msg_t *incoming_msg, openlcb_msg_t *outgoing_msg)
+{
+
+    statemachine_info->openlcb_node = node;
+    statemachine_info->incoming_msg_info.msg_ptr = incoming_msg;
+    statemachine_info->outgoing_msg_info.msg_ptr = outgoing_msg;
+    statemachine_info->outgoing_msg_info.valid = false;
+    statemachine_info->incoming_msg_info.enumerate = false;
+    incoming_msg->mti = MTI_DATAGRAM;
+    incoming_msg->source_id = SOURCE_ID;
+    incoming_msg->source_alias = SOURCE_ALIAS;
+    incoming_msg->dest_id = DEST_ID;
+    incoming_msg->dest_alias = DEST_ALIAS;
+    *incoming_msg->payload[0] = CONFIG_MEM_CONFIGURATION;
+    *incoming_msg->payload[1] = CONFIG_MEM_READ_SPACE_FD;
+    OpenLcbUtilities_copy_dword_to_openlcb_payload(incoming_msg, 0x00000010, 2);
+    *incoming_msg->payload[6] = 4;
+    incoming_msg->payload_count = 7;
+}
+
+TEST(ProtocolConfigMemReadHandler, read_pending_then_complete)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    _load_read_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+
+    // Phase 1: Datagram Received OK
+    ProtocolConfigMemReadHandler_read_space_config_memory(&statemachine_info);
+    EXPECT_TRUE(node1->state.openlcb_datagram_ack_sent);
+
+    // Phase 2: storage answers pending, nothing goes out, request is finished
+    _reset_variables();
+    ProtocolConfigMemReadHandler_read_space_config_memory(&statemachine_info);
+
+    EXPECT_EQ(called_function_ptr, (void *)&_config_memory_read_pending);
+    EXPECT_FALSE(statemachine_info.outgoing_msg_info.valid);
+    EXPECT_FALSE(statemachine_info.incoming_msg_info.enumerate);
+    EXPECT_FALSE(node1->state.openlcb_datagram_ack_sent);
+    EXPECT_EQ(send_openlcb_msg_count, 0);
+
+    // A second read to the same node is turned away until the first completes
+    _reset_variables();
+    _load_read_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+    ProtocolConfigMemReadHandler_read_space_config_memory(&statemachine_info);
+
+    EXPECT_EQ(called_function_ptr, (void *)&_load_datagram_rejected_message);
+    EXPECT_EQ(datagram_reply_code, ERROR_TEMPORARY_BUFFER_UNAVAILABLE);
+    EXPECT_FALSE(node1->state.openlcb_datagram_ack_sent);
+
+    // Transmit path busy: the read stays parked
+    uint8_t data[4] = {0x11, 0x22, 0x33, 0x44};
+
+    send_openlcb_msg_fail = true;
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_complete_read(node1, data, 4));
+    send_openlcb_msg_fail = false;
+
+    EXPECT_TRUE(ProtocolConfigMemReadHandler_complete_read(node1, data, 4));
+    EXPECT_EQ(send_openlcb_msg_count, 1);
+
+    EXPECT_EQ(sent_msg.mti, MTI_DATAGRAM);
+    EXPECT_EQ(sent_msg.source_alias, DEST_ALIAS);
+    EXPECT_EQ(sent_msg.dest_alias, SOURCE_ALIAS);
+    EXPECT_EQ(sent_msg.dest_id, SOURCE_ID);
+    EXPECT_EQ(sent_payload[0], CONFIG_MEM_CONFIGURATION);
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_READ_REPLY_OK_SPACE_FD);
+    EXPECT_EQ(OpenLcbUtilities_extract_dword_from_openlcb_payload(&sent_msg, 2), 0x00000010);
+    EXPECT_EQ(sent_msg.payload_count, 6 + 4);
+    EXPECT_EQ(sent_payload[6], 0x11);
+    EXPECT_EQ(sent_payload[9], 0x44);
+
+    // Nothing left to complete
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_complete_read(node1, data, 4));
+    EXPECT_EQ(send_openlcb_msg_count, 1);
+}
+
+TEST(ProtocolConfigMemReadHandler, read_pending_complete_short)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    _load_read_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+
+    ProtocolConfigMemReadHandler_read_space_config_memory(&statemachine_info);
+    ProtocolConfigMemReadHandler_read_space_config_memory(&statemachine_info);
+
+    uint8_t data[4] = {0};
+
+    EXPECT_TRUE(ProtocolConfigMemReadHandler_complete_read(node1, data, 2));
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_READ_REPLY_FAIL_SPACE_FD);
+    EXPECT_EQ(OpenLcbUtilities_extract_word_from_openlcb_payload(&sent_msg, 6), ERROR_TEMPORARY_TRANSFER_ERROR);
+
+    // Not parked, nothing to send, and no node
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_complete_read(nullptr, data, 4));
+}
+
+TEST(ProtocolConfigMemReadHandler, read_pending_acdi_user_parks)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    config_mem_read_request_info_t config_mem_read_request_info;
+
+    _load_read_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+    *incoming_msg->payload[1] = CONFIG_MEM_READ_SPACE_IN_BYTE_6;
+    *incoming_msg->payload[6] = CONFIG_MEM_SPACE_ACDI_USER_ACCESS;
+    *incoming_msg->payload[7] = CONFIG_MEM_ACDI_USER_NAME_LEN;
+    incoming_msg->payload_count = 8;
+
+    config_mem_read_request_info.encoding = ADDRESS_SPACE_IN_BYTE_6;
+    config_mem_read_request_info.address = CONFIG_MEM_ACDI_USER_NAME_ADDRESS;
+    config_mem_read_request_info.bytes = CONFIG_MEM_ACDI_USER_NAME_LEN;
+    config_mem_read_request_info.data_start = 7;
+    config_mem_read_request_info.space_info = nullptr;
+    config_mem_read_request_info.read_space_func = nullptr;
+
+    ProtocolConfigMemReadHandler_read_request_acdi_user(&statemachine_info, &config_mem_read_request_info);
+
+    // Parked like a Config space read, nothing asks to be called again
+    EXPECT_FALSE(statemachine_info.outgoing_msg_info.valid);
+    EXPECT_FALSE(statemachine_info.incoming_msg_info.enumerate);
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_can_park_read(node1));
+
+    // With the node's slot taken a second pending read fails instead of parking
+    config_mem_read_request_info.address = CONFIG_MEM_ACDI_USER_DESCRIPTION_ADDRESS;
+    config_mem_read_request_info.bytes = CONFIG_MEM_ACDI_USER_DESCRIPTION_LEN;
+
+    ProtocolConfigMemReadHandler_read_request_acdi_user(&statemachine_info, &config_mem_read_request_info);
+
+    EXPECT_TRUE(statemachine_info.outgoing_msg_info.valid);
+    EXPECT_FALSE(statemachine_info.incoming_msg_info.enumerate);
+    EXPECT_EQ(*outgoing_msg->payload[1], CONFIG_MEM_READ_REPLY_FAIL_SPACE_IN_BYTE_6);
+    EXPECT_EQ(OpenLcbUtilities_extract_word_from_openlcb_payload(outgoing_msg, 7), ERROR_TEMPORARY_TRANSFER_ERROR);
+
+    // Completing the user name read sends the ACDI-User Read Reply
+    uint8_t data[CONFIG_MEM_ACDI_USER_NAME_LEN] = {'N', 'o', 'd', 'e'};
+
+    EXPECT_TRUE(ProtocolConfigMemReadHandler_complete_read(node1, data, CONFIG_MEM_ACDI_USER_NAME_LEN));
+    EXPECT_EQ(send_openlcb_msg_count, 1);
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_READ_REPLY_OK_SPACE_IN_BYTE_6);
+    EXPECT_EQ(sent_payload[6], CONFIG_MEM_SPACE_ACDI_USER_ACCESS);
+    EXPECT_EQ(OpenLcbUtilities_extract_dword_from_openlcb_payload(&sent_msg, 2), CONFIG_MEM_ACDI_USER_NAME_ADDRESS);
+    EXPECT_EQ(sent_payload[7], 'N');
+    EXPECT_EQ(sent_msg.payload_count, 7 + CONFIG_MEM_ACDI_USER_NAME_LEN);
+    EXPECT_TRUE(ProtocolConfigMemReadHandler_can_park_read(node1));
+}
+
+TEST(ProtocolConfigMemReadHandler, park_read_dispatches_by_kind)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    config_mem_pending_request_t request = {0};
+
+    // No node, nothing parked
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_park_read(&request));
+
+    request.openlcb_node = node1;
+    request.kind = CONFIG_MEM_PENDING_WRITE_UNDER_MASK;
+
+    EXPECT_TRUE(ProtocolConfigMemReadHandler_park_read(&request));
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_can_park_read(node1));
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_park_read(&request));
+
+    // Completion goes to the kind's hook, which is not wired here; no Read Reply is sent
+    uint8_t data[4] = {0};
+
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_complete_read(node1, data, 4));
+    EXPECT_EQ(send_openlcb_msg_count, 0);
+
+    // Re-initializing drops the parked request
+    ProtocolConfigMemReadHandler_initialize(&interface_protocol_config_mem_read_handler_pending);
+    request.kind = CONFIG_MEM_PENDING_SNIP_USER_NAME;
+    EXPECT_TRUE(ProtocolConfigMemReadHandler_park_read(&request));
+    EXPECT_FALSE(ProtocolConfigMemReadHandler_complete_read(node1, data, 4));
+    EXPECT_EQ(send_openlcb_msg_count, 0);
+}
+
+TEST(ProtocolConfigMemReadHandler, read_pending_other_space_not_blocked)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    _load_read_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+
+    // Park a Config space read
+    ProtocolConfigMemReadHandler_read_space_config_memory(&statemachine_info);
+    ProtocolConfigMemReadHandler_read_space_config_memory(&statemachine_info);
+    EXPECT_FALSE(node1->state.openlcb_datagram_ack_sent);
+
+    // A CDI read to the same node cannot park, so it is accepted
+    _reset_variables();
+    _load_read_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+    *incoming_msg->payload[1] = CONFIG_MEM_READ_SPACE_FF;
+    ProtocolConfigMemReadHandler_read_space_config_description_info(&statemachine_info);
+
+    EXPECT_EQ(called_function_ptr, (void *)&_load_datagram_received_ok_message);
+    EXPECT_TRUE(node1->state.openlcb_datagram_ack_sent);
+
+    // The parked read is still there to complete
+    uint8_t data[4] = {0x11, 0x22, 0x33, 0x44};
+
+    EXPECT_TRUE(ProtocolConfigMemReadHandler_complete_read(node1, data, 4));
+}
@@ -964,6 +964,12 @@ void ProtocolConfigMemStreamHandler_run(void) {
 
                 }
 
+                if (_interface->is_transport_congested && _interface->is_transport_congested()) {
+
+                    break;  // bulk data waits; replies and completes still go out
+
+                }
+
                 _pump_next_chunk(ctx);
 
                 _pump_index = (idx + 1) % USER_DEFINED_MAX_CONCURRENT_ACTIVE_STREAMS;
@@ -1008,7 +1014,8 @@ void ProtocolConfigMemStreamHandler_run(void) {
      * @details If the active operation is in WAIT_INITIATE_REPLY, PUMPING,
      * WRITE_WAIT_STREAM_INITIATE, or WRITE_RECEIVING and the elapsed time
      * exceeds the timeout threshold, terminates the stream (if open) and
-     * resets to idle.
+     * resets to idle.  A PUMPING context is held while the transport is
+     * congested, so its snapshot is restarted instead.
      *
      * @verbatim
      * @param current_tick  Current value of the global 100ms tick counter.
@@ -1029,6 +1036,15 @@ void ProtocolConfigMemStreamHandler_check_timeouts(uint8_t current_tick) {
 
         }
 
+        if (ctx->phase == CONFIG_MEM_STREAM_PHASE_PUMPING &&
+                _interface->is_transport_congested && _interface->is_transport_congested()) {
+
+            ctx->tick_snapshot = current_tick;  // we are the ones holding it
+
+            continue;
+
+        }
+
         uint8_t elapsed = (uint8_t) (current_tick - ctx->tick_snapshot);
 
         if (elapsed < CONFIG_MEM_STREAM_TIMEOUT_TICKS) {
@@ -227,6 +227,9 @@ typedef struct {
         /** @brief Send Terminate Due To Error and free the stream slot. */
     void (*stream_send_terminate)(openlcb_statemachine_info_t *statemachine_info, stream_state_t *stream, uint16_t error_code);
 
+        /** @brief Optional.  Return true to hold data chunks while the transport is busy.  Typical: CanBusMonitor_is_congested. */
+    bool (*is_transport_congested)(void);
+
     // ---- Per-space read request callbacks ----
 
         /** @brief Read from CDI (0xFF).  NULL if space not supported. */
@@ -475,6 +478,7 @@ extern "C" {
          * @details Called from the periodic services loop with the current
          * global 100ms tick.  If the active operation has stalled for longer
          * than the timeout threshold, terminates the stream and resets to idle.
+         * A pump held back by is_transport_congested does not time out.
          *
          * @param current_tick  Current value of the global 100ms tick counter.
          */
@@ -1162,6 +1162,62 @@ TEST(ProtocolConfigMemStreamHandler, pump_sends_reply_datagram_then_pumps_data)
 
 }
 
+static bool _transport_congested = false;
+
+static bool _mock_is_transport_congested(void) {
+
+    return _transport_congested;
+
+}
+
+TEST(ProtocolConfigMemStreamHandler, pump_holds_data_while_transport_congested) {
+
+    interface_protocol_config_mem_stream_handler_t iface = _interface_full;
+    iface.is_transport_congested = &_mock_is_transport_congested;
+    _global_init(&iface);
+    _transport_congested = false;
+
+    openlcb_node_t *node = OpenLcbNode_allocate(DEST_ID, &_node_params);
+    node->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *outgoing = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    ASSERT_NE(incoming, nullptr);
+    ASSERT_NE(outgoing, nullptr);
+
+    _load_read_stream_cdi_datagram(incoming, 0, 0x10, 0);
+
+    openlcb_statemachine_info_t info = _build_sm_info(node, incoming, outgoing);
+    info.current_tick = 5;
+    _run_two_phase_dispatch(&info);
+
+    _simulate_stream_accepted();
+    ProtocolConfigMemStreamHandler_on_initiate_reply(&info, &_mock_stream);
+
+    _send_msg_return = true;
+    ProtocolConfigMemStreamHandler_run();  // loads reply datagram
+    ProtocolConfigMemStreamHandler_run();  // sends reply datagram
+
+    // Congested: no data goes out and the stall timer does not run
+    _transport_congested = true;
+    _reset_counters();
+    ProtocolConfigMemStreamHandler_run();
+    ProtocolConfigMemStreamHandler_check_timeouts(200);
+
+    EXPECT_EQ(_stream_send_data_called, 0);
+    EXPECT_EQ(_stream_send_terminate_called, 0);
+
+    // Bus clears: pumping resumes
+    _transport_congested = false;
+    ProtocolConfigMemStreamHandler_run();
+
+    EXPECT_EQ(_stream_send_data_called, 1);
+
+    OpenLcbBufferStore_free_buffer(incoming);
+    OpenLcbBufferStore_free_buffer(outgoing);
+
+}
+
 TEST(ProtocolConfigMemStreamHandler, pump_sends_complete_after_all_data) {
 
     _global_init(&_interface_full);
@@ -59,6 +59,9 @@
     /** @brief Stored callback interface pointer; set by _initialize(). */
 static interface_protocol_config_mem_write_handler_t *_interface;
 
+    /** @brief Writes waiting on a CONFIG_MEM_ACCESS_PENDING access. */
+static config_mem_pending_request_t _pending_writes[USER_DEFINED_CONFIG_MEM_PENDING_DEPTH];
+
     /**
      * @brief Stores the callback interface.  Call once at startup.
      *
@@ -72,6 +75,62 @@ void ProtocolConfigMemWriteHandler_initialize(const interface_protocol_config_me
 
     _interface = (interface_protocol_config_mem_write_handler_t*) interface_protocol_config_mem_write_handler;
 
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_PENDING_DEPTH; i++) {
+
+        _pending_writes[i].openlcb_node = NULL;
+
+    }
+
+}
+
+    /** @brief Returns the write parked for openlcb_node, or NULL. */
+static config_mem_pending_request_t *_find_pending_write(openlcb_node_t *openlcb_node) {
+
+    for (int i = 0; i < USER_DEFINED_CONFIG_MEM_PENDING_DEPTH; i++) {
+
+        if (_pending_writes[i].openlcb_node == openlcb_node) {
+
+            return &_pending_writes[i];
+
+        }
+
+    }
+
+    return NULL;
+
+}
+
+    /**
+     * @brief True if the space's write handler goes through config_memory_write
+     * and so can park on CONFIG_MEM_ACCESS_PENDING (Config 0xFD and ACDI-User 0xFB).
+     */
+static bool _can_park_write(write_config_mem_space_func_t write_space_func) {
+
+#ifdef OPENLCB_COMPILE_BOOTLOADER
+    (void) write_space_func;
+
+    return false;
+#else
+    return (write_space_func == &ProtocolConfigMemWriteHandler_write_request_config_mem) ||
+            (write_space_func == &ProtocolConfigMemWriteHandler_write_request_acdi_user);
+#endif
+
+}
+
+    /**
+     * @brief True while a parkable write for the node is parked or every park
+     * slot is taken.  Writes that can never park are not blocked.
+     */
+static bool _is_write_blocked(openlcb_node_t *openlcb_node, bool can_park) {
+
+    if (!can_park) {
+
+        return false;
+
+    }
+
+    return _find_pending_write(openlcb_node) || !_find_pending_write(NULL);
+
 }
 
     /**
@@ -161,7 +220,10 @@ static void _check_for_write_overrun(openlcb_statemachine_info_t *statemachine_i
      * @details Algorithm:
      * -# Extract parameters from incoming datagram
      * -# Phase 1: validate → reject or ACK + re-invoke
-     * -# Phase 2: clamp overrun, call space-specific write, reset flags
+     * -# Phase 1 also rejects with a temporary error, for spaces whose write
+     *    can park, while a write for the node is parked or no park slot is free
+     * -# Phase 2: clamp overrun, call space-specific write, reset flags unless
+     *    the space handler asked to be called again
      *
      * @param statemachine_info             Context.
      * @param config_mem_write_request_info  Carries callback + space_info.
@@ -176,6 +238,12 @@ static void _dispatch_write_request(openlcb_statemachine_info_t *statemachine_in
 
         error_code = _is_valid_write_parameters(config_mem_write_request_info);
 
+        if (!error_code && _is_write_blocked(statemachine_info->openlcb_node, _can_park_write(config_mem_write_request_info->write_space_func))) {
+
+            error_code = ERROR_TEMPORARY_BUFFER_UNAVAILABLE; // earlier write still waiting on storage
+
+        }
+
         if (error_code) {
 
             _interface->load_datagram_received_rejected_message(statemachine_info, error_code);
@@ -242,6 +310,82 @@ static void _write_result(openlcb_statemachine_info_t *statemachine_info, config
 
     statemachine_info->outgoing_msg_info.valid = true;
 
+}
+
+    /**
+     * @brief Finishes a write that config_memory_write left pending.
+     *
+     * @details Algorithm:
+     * -# Find the write parked for the node; fail if none or no send_openlcb_msg
+     * -# Rebuild a minimal request (requester, command and space bytes) so the
+     *    standard reply header loaders can be used
+     * -# Load Write Reply, or Write Reply Fail (TRANSFER_ERROR) if fewer than
+     *    the requested bytes were written
+     * -# Send it; free the slot only if the send was accepted
+     *
+     * @verbatim
+     * @param openlcb_node  Node passed to config_memory_write.
+     * @param write_count   Number of bytes written.
+     * @endverbatim
+     *
+     * @return true if the reply was sent.
+     */
+bool ProtocolConfigMemWriteHandler_complete_write(openlcb_node_t *openlcb_node, uint16_t write_count) {
+
+    config_mem_pending_request_t *pending = _find_pending_write(openlcb_node);
+
+    if (!pending || !openlcb_node || !_interface->send_openlcb_msg) {
+
+        return false;
+
+    }
+
+    openlcb_msg_t request_msg = {0};
+    payload_basic_t request_payload = {0};
+    openlcb_msg_t reply_msg = {0};
+    payload_datagram_t reply_payload;
+    openlcb_statemachine_info_t statemachine_info = {0};
+    config_mem_write_request_info_t config_mem_write_request_info = {0};
+
+    request_msg.payload = (openlcb_payload_t *) &request_payload;
+    request_msg.payload_type = BASIC;
+    request_msg.source_alias = pending->reply_alias;
+    request_msg.source_id = pending->reply_id;
+    request_payload[1] = pending->command;
+    request_payload[6] = pending->space;
+
+    reply_msg.payload = (openlcb_payload_t *) &reply_payload;
+    reply_msg.payload_type = DATAGRAM;
+
+    statemachine_info.openlcb_node = openlcb_node;
+    statemachine_info.incoming_msg_info.msg_ptr = &request_msg;
+    statemachine_info.outgoing_msg_info.msg_ptr = &reply_msg;
+
+    config_mem_write_request_info.encoding = pending->encoding;
+    config_mem_write_request_info.address = pending->address;
+    config_mem_write_request_info.bytes = pending->bytes;
+    config_mem_write_request_info.data_start = pending->data_start;
+
+    if (write_count >= pending->bytes && write_count != CONFIG_MEM_ACCESS_PENDING) {
+
+        OpenLcbUtilities_load_config_mem_reply_write_ok_message_header(&statemachine_info, &config_mem_write_request_info);
+
+    } else {
+
+        OpenLcbUtilities_load_config_mem_reply_write_fail_message_header(&statemachine_info, &config_mem_write_request_info, ERROR_TEMPORARY_TRANSFER_ERROR);
+
+    }
+
+    if (!_interface->send_openlcb_msg(&reply_msg)) {
+
+        return false;
+
+    }
+
+    pending->openlcb_node = NULL;
+
+    return true;
+
 }
 
     /**
@@ -278,6 +422,44 @@ void ProtocolConfigMemWriteHandler_write_space_firmware(openlcb_statemachine_inf
 
 #ifndef OPENLCB_COMPILE_BOOTLOADER
 
+    /**
+     * @brief Parks a write whose config_memory_write returned CONFIG_MEM_ACCESS_PENDING.
+     *
+     * @details Copies the requester and request header out of the incoming
+     * datagram so the reply can be built after that buffer is freed.  On
+     * success no reply is sent now.
+     *
+     * @param statemachine_info             Context with incoming message.
+     * @param config_mem_write_request_info  Request being parked.
+     *
+     * @return true if a slot was free.
+     */
+static bool _park_write(openlcb_statemachine_info_t *statemachine_info, config_mem_write_request_info_t *config_mem_write_request_info) {
+
+    config_mem_pending_request_t *pending = _find_pending_write(NULL);
+
+    if (!pending) {
+
+        return false;
+
+    }
+
+    pending->openlcb_node = statemachine_info->openlcb_node;
+    pending->reply_alias = statemachine_info->incoming_msg_info.msg_ptr->source_alias;
+    pending->reply_id = statemachine_info->incoming_msg_info.msg_ptr->source_id;
+    pending->command = *statemachine_info->incoming_msg_info.msg_ptr->payload[1];
+    pending->space = *statemachine_info->incoming_msg_info.msg_ptr->payload[6];
+    pending->encoding = config_mem_write_request_info->encoding;
+    pending->address = config_mem_write_request_info->address;
+    pending->bytes = config_mem_write_request_info->bytes;
+    pending->data_start = config_mem_write_request_info->data_start;
+
+    statemachine_info->outgoing_msg_info.valid = false;
+
+    return true;
+
+}
+
     /** @brief Dispatch CDI (0xFF) write to two-phase handler. */
 void ProtocolConfigMemWriteHandler_write_space_config_description_info(openlcb_statemachine_info_t *statemachine_info) {
 
@@ -450,7 +632,7 @@ static uint16_t _is_valid_write_under_mask_parameters(openlcb_statemachine_info_
 }
 
     /**
-     * @brief Read-modify-write: read current data, apply mask, write back.
+     * @brief Merge the (Mask, Data) pairs into the current bytes and write back.
      *
      * @details Per MemoryConfigurationS section 4.10, the payload after the
      * header contains interleaved (Mask, Data) byte pairs:
@@ -462,27 +644,17 @@ static uint16_t _is_valid_write_under_mask_parameters(openlcb_statemachine_info_
      * @param statemachine_info             Context for reply messages.
      * @param config_mem_write_request_info Request with address, bytes, write_buffer
      *                                      pointing to the first (Mask, Data) pair.
+     * @param temp                          Current bytes; merged in place.
+     * @param read_count                    Number of current bytes read.
      *
-     * @return Number of bytes written, or 0 on failure.
+     * A pending write is parked for ProtocolConfigMemWriteHandler_complete_write().
+     *
+     * @return Number of bytes written, or 0 on failure or while pending.
      */
-static uint16_t _write_data_under_mask(openlcb_statemachine_info_t *statemachine_info, config_mem_write_request_info_t *config_mem_write_request_info) {
+static uint16_t _merge_and_write_under_mask(openlcb_statemachine_info_t *statemachine_info, config_mem_write_request_info_t *config_mem_write_request_info, configuration_memory_buffer_t *temp, uint16_t read_count) {
 
-    configuration_memory_buffer_t temp;
-    uint16_t read_count = 0;
     uint16_t write_count = 0;
 
-    if (!_interface->config_memory_read) {
-
-        OpenLcbUtilities_load_config_mem_reply_write_fail_message_header(statemachine_info, config_mem_write_request_info, ERROR_PERMANENT_INVALID_ARGUMENTS);
-        statemachine_info->outgoing_msg_info.valid = true;
-
-        return 0;
-
-    }
-
-    // Step 1: Read current values
-    read_count = _interface->config_memory_read(statemachine_info->openlcb_node, config_mem_write_request_info->address, config_mem_write_request_info->bytes, &temp);
-
     if (read_count < config_mem_write_request_info->bytes) {
 
         OpenLcbUtilities_load_config_mem_reply_write_fail_message_header(statemachine_info, config_mem_write_request_info, ERROR_TEMPORARY_TRANSFER_ERROR);
@@ -499,14 +671,26 @@ static uint16_t _write_data_under_mask(openlcb_statemachine_info_t *statemachine
 
         uint8_t mask = pairs[i * 2];
         uint8_t data = pairs[i * 2 + 1];
-        temp[i] = (temp[i] & ~mask) | (data & mask);
+        (*temp)[i] = ((*temp)[i] & ~mask) | (data & mask);
 
     }
 
     // Step 3: Write back merged values
     if (_interface->config_memory_write) {
 
-        write_count = _interface->config_memory_write(statemachine_info->openlcb_node, config_mem_write_request_info->address, config_mem_write_request_info->bytes, &temp);
+        write_count = _interface->config_memory_write(statemachine_info->openlcb_node, config_mem_write_request_info->address, config_mem_write_request_info->bytes, temp);
+
+        if (write_count == CONFIG_MEM_ACCESS_PENDING) {
+
+            if (_park_write(statemachine_info, config_mem_write_request_info)) {
+
+                return 0;
+
+            }
+
+            write_count = 0; // nowhere to park it, fail the write
+
+        }
 
         if (write_count < config_mem_write_request_info->bytes) {
 
@@ -524,6 +708,174 @@ static uint16_t _write_data_under_mask(openlcb_statemachine_info_t *statemachine
 
     return write_count;
 
+}
+
+    /**
+     * @brief Parks a write-under-mask whose read came back pending.
+     *
+     * @details The request datagram is held (reference counted) until
+     * ProtocolConfigMemWriteHandler_complete_write_under_mask_read() merges
+     * its (Mask, Data) pairs.  If it cannot be parked the write fails with a
+     * temporary error so the requester resends.
+     *
+     * @param statemachine_info             Context with incoming message.
+     * @param config_mem_write_request_info  Request being parked.
+     */
+static void _park_write_under_mask_read(openlcb_statemachine_info_t *statemachine_info, config_mem_write_request_info_t *config_mem_write_request_info) {
+
+    openlcb_msg_t *incoming_msg = statemachine_info->incoming_msg_info.msg_ptr;
+
+    if (_interface->park_read) {
+
+        config_mem_pending_request_t request = {0};
+
+        request.openlcb_node = statemachine_info->openlcb_node;
+        request.kind = CONFIG_MEM_PENDING_WRITE_UNDER_MASK;
+        request.held_msg = incoming_msg;
+        request.reply_alias = incoming_msg->source_alias;
+        request.reply_id = incoming_msg->source_id;
+        request.command = *incoming_msg->payload[1];
+        request.space = *incoming_msg->payload[6];
+        request.encoding = config_mem_write_request_info->encoding;
+        request.address = config_mem_write_request_info->address;
+        request.bytes = config_mem_write_request_info->bytes;
+        request.data_start = config_mem_write_request_info->data_start;
+
+        OpenLcbBufferStore_inc_reference_count(incoming_msg);
+
+        if (_interface->park_read(&request)) {
+
+            statemachine_info->outgoing_msg_info.valid = false;
+
+            return;
+
+        }
+
+        OpenLcbBufferStore_free_buffer(incoming_msg);
+
+    }
+
+    OpenLcbUtilities_load_config_mem_reply_write_fail_message_header(statemachine_info, config_mem_write_request_info, ERROR_TEMPORARY_TRANSFER_ERROR);
+    statemachine_info->outgoing_msg_info.valid = true;
+
+}
+
+    /**
+     * @brief Read-modify-write: read current data, apply mask, write back.
+     *
+     * @details A CONFIG_MEM_ACCESS_PENDING read parks the request through
+     * park_read; a pending write is parked for
+     * ProtocolConfigMemWriteHandler_complete_write().
+     *
+     * @param statemachine_info             Context for reply messages.
+     * @param config_mem_write_request_info Request with address, bytes, write_buffer
+     *                                      pointing to the first (Mask, Data) pair.
+     *
+     * @return Number of bytes written, or 0 on failure or while pending.
+     */
+static uint16_t _write_data_under_mask(openlcb_statemachine_info_t *statemachine_info, config_mem_write_request_info_t *config_mem_write_request_info) {
+
+    configuration_memory_buffer_t temp;
+    uint16_t read_count = 0;
+
+    if (!_interface->config_memory_read) {
+
+        OpenLcbUtilities_load_config_mem_reply_write_fail_message_header(statemachine_info, config_mem_write_request_info, ERROR_PERMANENT_INVALID_ARGUMENTS);
+        statemachine_info->outgoing_msg_info.valid = true;
+
+        return 0;
+
+    }
+
+    // Step 1: Read current values
+    read_count = _interface->config_memory_read(statemachine_info->openlcb_node, config_mem_write_request_info->address, config_mem_write_request_info->bytes, &temp);
+
+    if (read_count == CONFIG_MEM_ACCESS_PENDING) {
+
+        _park_write_under_mask_read(statemachine_info, config_mem_write_request_info);
+
+        return 0;
+
+    }
+
+    return _merge_and_write_under_mask(statemachine_info, config_mem_write_request_info, &temp, read_count);
+
+}
+
+    /**
+     * @brief Finishes a write-under-mask parked on a pending read.
+     *
+     * @details Algorithm:
+     * -# Rebuild the request around the held datagram so the standard reply
+     *    loaders and _park_write() can be used
+     * -# Merge and write back (a pending write parks in the write slots)
+     * -# Send the Write Reply if one was loaded; on a busy transmit path keep
+     *    everything so the same completion can be repeated
+     * -# Free the held datagram and the read slot
+     *
+     * @verbatim
+     * @param pending  Parked request.
+     * @param data     Bytes read.
+     * @param count    Number of bytes in data.
+     * @endverbatim
+     *
+     * @return true if taken; false if the reply could not be sent.
+     */
+bool ProtocolConfigMemWriteHandler_complete_write_under_mask_read(config_mem_pending_request_t *pending, const uint8_t *data, uint16_t count) {
+
+    openlcb_msg_t *held_msg = pending->held_msg;
+
+    if (!held_msg || !_interface->send_openlcb_msg) {
+
+        return false;
+
+    }
+
+    configuration_memory_buffer_t temp;
+    openlcb_msg_t reply_msg = {0};
+    payload_datagram_t reply_payload;
+    openlcb_statemachine_info_t statemachine_info = {0};
+    config_mem_write_request_info_t config_mem_write_request_info = {0};
+
+    reply_msg.payload = (openlcb_payload_t *) &reply_payload;
+    reply_msg.payload_type = DATAGRAM;
+
+    statemachine_info.openlcb_node = pending->openlcb_node;
+    statemachine_info.incoming_msg_info.msg_ptr = held_msg;
+    statemachine_info.outgoing_msg_info.msg_ptr = &reply_msg;
+
+    config_mem_write_request_info.encoding = pending->encoding;
+    config_mem_write_request_info.address = pending->address;
+    config_mem_write_request_info.bytes = pending->bytes;
+    config_mem_write_request_info.data_start = pending->data_start;
+    config_mem_write_request_info.write_buffer = (configuration_memory_buffer_t *) & held_msg->payload[pending->data_start];
+
+    if (!data || count > sizeof(temp)) {
+
+        count = 0;
+
+    } else {
+
+        memcpy(temp, data, count);
+
+    }
+
+    OpenLcbUtilities_load_config_mem_reply_write_ok_message_header(&statemachine_info, &config_mem_write_request_info);
+    _merge_and_write_under_mask(&statemachine_info, &config_mem_write_request_info, &temp, count);
+
+    if (statemachine_info.outgoing_msg_info.valid && !_interface->send_openlcb_msg(&reply_msg)) {
+
+        return false;
+
+    }
+
+    OpenLcbBufferStore_free_buffer(held_msg);
+
+    pending->held_msg = NULL;
+    pending->openlcb_node = NULL;
+
+    return true;
+
 }
 
     /**
@@ -533,7 +885,10 @@ static uint16_t _write_data_under_mask(openlcb_statemachine_info_t *statemachine
      * @details Algorithm:
      * -# Extract data/mask parameters from incoming datagram
      * -# Phase 1: validate → reject or ACK + re-invoke
-     * -# Phase 2: clamp overrun, read current data, apply mask, write back
+     * -# Phase 1 also rejects with a temporary error while a read or write for
+     *    the node is parked or no park slot is free
+     * -# Phase 2: clamp overrun, read current data, apply mask, write back;
+     *    a pending read parks the request until its bytes arrive
      *
      * @param statemachine_info             Context.
      * @param config_mem_write_request_info Carries space_info pointer.
@@ -548,6 +903,14 @@ static void _dispatch_write_under_mask_request(openlcb_statemachine_info_t *stat
 
         error_code = _is_valid_write_under_mask_parameters(statemachine_info, config_mem_write_request_info);
 
+        // Every space's write-under-mask goes through config_memory_write, so any can park
+        if (!error_code && (_is_write_blocked(statemachine_info->openlcb_node, true) ||
+                (_interface->can_park_read && !_interface->can_park_read(statemachine_info->openlcb_node)))) {
+
+            error_code = ERROR_TEMPORARY_BUFFER_UNAVAILABLE; // earlier access still waiting on storage
+
+        }
+
         if (error_code) {
 
             _interface->load_datagram_received_rejected_message(statemachine_info, error_code);
@@ -769,6 +1132,7 @@ void ProtocolConfigMemWriteHandler_write_reply_fail_message(openlcb_statemachine
     *      * Source buffer points to write data from incoming datagram
     *    - Store actual bytes written count
     *    - Update outgoing payload_count by adding bytes written
+    *    - If CONFIG_MEM_ACCESS_PENDING, park the request and return with no reply
     *    - Check if write count is less than requested:
     *      * If partial write, load write fail message with TRANSFER_ERROR
     * -# If callback not registered:
@@ -799,6 +1163,18 @@ static uint16_t _write_data(openlcb_statemachine_info_t *statemachine_info, conf
 
         write_count = _interface->config_memory_write(statemachine_info->openlcb_node, config_mem_write_request_info->address, config_mem_write_request_info->bytes, config_mem_write_request_info->write_buffer);
 
+        if (write_count == CONFIG_MEM_ACCESS_PENDING) {
+
+            if (_park_write(statemachine_info, config_mem_write_request_info)) {
+
+                return 0;
+
+            }
+
+            write_count = 0; // nowhere to park it, fail the write
+
+        }
+
         if (write_count < config_mem_write_request_info->bytes) {
 
             OpenLcbUtilities_load_config_mem_reply_write_fail_message_header(statemachine_info, config_mem_write_request_info, ERROR_TEMPORARY_TRANSFER_ERROR);
@@ -824,6 +1200,9 @@ static uint16_t _write_data(openlcb_statemachine_info_t *statemachine_info, conf
     * -# Load write reply OK message header
     * -# Call _write_data to perform the actual write operation
     *
+    * If config_memory_write returns CONFIG_MEM_ACCESS_PENDING no reply is sent;
+    * the application finishes it with ProtocolConfigMemWriteHandler_complete_write().
+    *
     * This function handles writes to the primary configuration data storage space.
     * The actual write is delegated to the config_memory_write callback which can
     * implement any storage mechanism (EEPROM, flash, RAM, etc.).
@@ -866,6 +1245,7 @@ void ProtocolConfigMemWriteHandler_write_request_config_mem(openlcb_statemachine
     *      * Call _write_data to write user description
     *    - default (unrecognized address):
     *      * Load write fail message with OUT_OF_BOUNDS_INVALID_ADDRESS error
+    * -# If the write returned CONFIG_MEM_ACCESS_PENDING, park it and send nothing
     * -# Set outgoing message valid
     *
     * This function maps fixed ACDI user addresses to SNIP data fields for
@@ -955,6 +1335,18 @@ void ProtocolConfigMemWriteHandler_write_request_acdi_user(openlcb_statemachine_
 
     // Build the reply using the original ACDI address (untouched in the struct).
 
+    if (write_count == CONFIG_MEM_ACCESS_PENDING) {
+
+        if (_park_write(statemachine_info, config_mem_write_request_info)) {
+
+            return;
+
+        }
+
+        write_count = 0; // nowhere to park it, fail the write
+
+    }
+
     if (!_interface->config_memory_write || write_count < config_mem_write_request_info->bytes) {
 
         if (!_interface->config_memory_write) {
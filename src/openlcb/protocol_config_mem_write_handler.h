@@ -65,10 +65,13 @@ typedef struct {
         /** @brief REQUIRED — Send Datagram Received Rejected with error code. */
     void (*load_datagram_received_rejected_message)(openlcb_statemachine_info_t *statemachine_info, uint16_t return_code);
 
-        /** @brief REQUIRED — Write bytes to config memory; returns bytes written. */
+        /** @brief REQUIRED — Write bytes to config memory; returns bytes written, or
+         *  CONFIG_MEM_ACCESS_PENDING to finish later via ProtocolConfigMemWriteHandler_complete_write(). */
     uint16_t(*config_memory_write) (openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
 
-        /** @brief OPTIONAL — Read bytes from config memory; needed for write-under-mask read-modify-write. */
+        /** @brief OPTIONAL — Read bytes from config memory; needed for write-under-mask read-modify-write.
+         *  CONFIG_MEM_ACCESS_PENDING parks the write-under-mask through park_read until
+         *  ProtocolConfigMemReadHandler_complete_read() supplies the bytes. */
     uint16_t(*config_memory_read) (openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
 
     // ---- Optional per-space write handlers ----
@@ -101,6 +104,19 @@ typedef struct {
         /** @brief Optional — Returns train state for the given node (DI for train module). */
     train_state_t *(*get_train_state)(openlcb_node_t *openlcb_node);
 
+        /** @brief Optional — Send a reply outside the main dispatch; needed only when
+         *  config_memory_write returns CONFIG_MEM_ACCESS_PENDING.  Typical: the transport's send_openlcb_msg. */
+    bool (*send_openlcb_msg)(openlcb_msg_t *openlcb_msg);
+
+        /** @brief Optional — Returns true if a pending read for the node could be parked.  NULL
+         *  (with park_read) fails a write-under-mask whose read is pending.
+         *  Typical: ProtocolConfigMemReadHandler_can_park_read. */
+    bool (*can_park_read)(openlcb_node_t *openlcb_node);
+
+        /** @brief Optional — Parks a write-under-mask whose read is pending.
+         *  Typical: ProtocolConfigMemReadHandler_park_read. */
+    bool (*park_read)(const config_mem_pending_request_t *request);
+
 } interface_protocol_config_mem_write_handler_t;
 
 #ifdef __cplusplus
@@ -230,6 +246,43 @@ extern "C" {
          */
     extern void ProtocolConfigMemWriteHandler_write_under_mask_space_firmware(openlcb_statemachine_info_t *statemachine_info);
 
+        /**
+         * @brief Finishes a write that config_memory_write left pending.
+         *
+         * @details Covers Config (0xFD) and ACDI-User (0xFB) writes, plain or
+         * under mask.  The write buffer handed to config_memory_write is only
+         * valid during that call, so copy the data before returning
+         * CONFIG_MEM_ACCESS_PENDING.  Call this once the storage has finished to
+         * send the Write Reply; fewer than the requested bytes sends Write Reply
+         * Fail (TRANSFER_ERROR).  While a write is parked, new writes to the same
+         * node (or any node when all USER_DEFINED_CONFIG_MEM_PENDING_DEPTH slots
+         * are taken) are rejected with a temporary error so the requester resends.
+         *
+         * @param openlcb_node  Node passed to config_memory_write.
+         * @param write_count   Number of bytes written.
+         *
+         * @return true if the reply was sent; false if no write is parked for the
+         *         node or the transmit path is busy (call again later).
+         */
+    extern bool ProtocolConfigMemWriteHandler_complete_write(openlcb_node_t *openlcb_node, uint16_t write_count);
+
+        /**
+         * @brief Finishes a write-under-mask parked on a pending read.
+         *
+         * @details Called through ProtocolConfigMemReadHandler_complete_read().
+         * Merges the held request's (Mask, Data) pairs into the bytes read and
+         * writes them back.  A pending write is then parked like any other for
+         * ProtocolConfigMemWriteHandler_complete_write(); otherwise the Write
+         * Reply is sent now.
+         *
+         * @param pending  Parked request (kind CONFIG_MEM_PENDING_WRITE_UNDER_MASK).
+         * @param data     Bytes read.
+         * @param count    Number of bytes in data.
+         *
+         * @return true if taken; false if the reply could not be sent (call again).
+         */
+    extern bool ProtocolConfigMemWriteHandler_complete_write_under_mask_read(config_mem_pending_request_t *pending, const uint8_t *data, uint16_t count);
+
     // ---- Outgoing write requests (client side — writing to another node) ----
 
         /**
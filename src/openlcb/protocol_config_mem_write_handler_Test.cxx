@@ -4373,3 +4373,392 @@ TEST(ProtocolConfigMemWriteHandler, write_under_mask_too_many_bytes)
     EXPECT_EQ(datagram_reply_code, ERROR_PERMANENT_INVALID_ARGUMENTS);
 
 }
+
+// ============================================================================
+// Deferred (CONFIG_MEM_ACCESS_PENDING) writes
+// ============================================================================
+
+bool config_memory_write_pending = false;
+bool config_memory_read_pending = false;
+int send_openlcb_msg_count = 0;
+openlcb_msg_t sent_msg;
+payload_datagram_t sent_payload;
+
+uint16_t _config_memory_write_pending(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer)
+{
+
+    _update_called_function_ptr((void *)&_config_memory_write_pending);
+
+    if (config_memory_write_pending)
+    {
+
+        return CONFIG_MEM_ACCESS_PENDING;
+    }
+
+    memcpy(&mock_config_memory[address], buffer, count);
+
+    return count;
+}
+
+uint16_t _config_memory_read_maybe_pending(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer)
+{
+
+    if (config_memory_read_pending)
+    {
+
+        return CONFIG_MEM_ACCESS_PENDING;
+    }
+
+    memcpy(buffer, &mock_config_memory[address], count);
+
+    return count;
+}
+
+config_mem_pending_request_t parked_read;
+
+bool _can_park_read(openlcb_node_t *openlcb_node)
+{
+
+    return parked_read.openlcb_node == nullptr;
+}
+
+bool _park_read(const config_mem_pending_request_t *request)
+{
+
+    if (parked_read.openlcb_node)
+    {
+
+        return false;
+    }
+
+    parked_read = *request;
+
+    return true;
+}
+
+bool _send_openlcb_msg(openlcb_msg_t *openlcb_msg)
+{
+
+    send_openlcb_msg_count++;
+    sent_msg = *openlcb_msg;
+    memcpy(&sent_payload, openlcb_msg->payload, sizeof(sent_payload));
+    sent_msg.payload = (openlcb_payload_t *)&sent_payload;
+
+    return true;
+}
+
+const interface_protocol_config_mem_write_handler_t interface_protocol_config_mem_write_handler_pending = {
+
+    .load_datagram_received_ok_message = &_load_datagram_received_ok_message,
+    .load_datagram_received_rejected_message = &_load_datagram_rejected_message,
+
+    .config_memory_write = &_config_memory_write_pending,
+    .config_memory_read = &_config_memory_read_maybe_pending,
+
+    .write_request_config_definition_info = &_write_request_config_decscription_info,
+    .write_request_config_mem = &ProtocolConfigMemWriteHandler_write_request_config_mem,
+    .write_request_acdi_user = &ProtocolConfigMemWriteHandler_write_request_acdi_user,
+
+    .delayed_reply_time = nullptr,
+    .send_openlcb_msg = &_send_openlcb_msg,
+    .can_park_read = &_can_park_read,
+    .park_read = &_park_read
+
+};
+
+void _global_initialize_with_pending(void)
+{
+
+    ProtocolConfigMemWriteHandler_initialize(&interface_protocol_config_mem_write_handler_pending);
+    OpenLcbNode_initialize(&interface_openlcb_node);
+    ProtocolSnip_initialize(&interface_openlcb_protocol_snip);
+    OpenLcbBufferFifo_initialize();
+    OpenLcbBufferStore_initialize();
+
+    config_memory_write_pending = true;
+    config_memory_read_pending = false;
+    send_openlcb_msg_count = 0;
+    memset(&parked_read, 0, sizeof(parked_read));
+}
+
+static void _load_write_fd_request(openlcb_statemachine_info_t *statemachine_info, openlcb_node_t *node, openlcb_msg_t *incoming_msg, openlcb_msg_t *outgoing_msg)
+{
+
+    statemachine_info->openlcb_node = node;
+    statemachine_info->incoming_msg_info.msg_ptr = incoming_msg;
+    statemachine_info->outgoing_msg_info.msg_ptr = outgoing_msg;
+    statemachine_info->outgoing_msg_info.valid = false;
+    statemachine_info->incoming_msg_info.enumerate = false;
+    incoming_msg->mti = MTI_DATAGRAM;
+    incoming_msg->source_id = SOURCE_ID;
+    incoming_msg->source_alias = SOURCE_ALIAS;
+    incoming_msg->dest_id = DEST_ID;
+    incoming_msg->dest_alias = DEST_ALIAS;
+    *incoming_msg->payload[0] = CONFIG_MEM_CONFIGURATION;
+    *incoming_msg->payload[1] = CONFIG_MEM_WRITE_SPACE_FD;
+    OpenLcbUtilities_copy_dword_to_openlcb_payload(incoming_msg, 0x00000020, 2);
+    *incoming_msg->payload[6] = 0xA1;
+    *incoming_msg->payload[7] = 0xA2;
+    *incoming_msg->payload[8] = 0xA3;
+    *incoming_msg->payload[9] = 0xA4;
+    incoming_msg->payload_count = 10;
+}
+
+TEST(ProtocolConfigMemWriteHandler, write_pending_then_complete)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+
+    // Phase 1: Datagram Received OK
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&statemachine_info);
+    EXPECT_TRUE(node1->state.openlcb_datagram_ack_sent);
+
+    // Phase 2: storage answers pending, no reply yet
+    _reset_variables();
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&statemachine_info);
+
+    EXPECT_EQ(called_function_ptr, (void *)&_config_memory_write_pending);
+    EXPECT_FALSE(statemachine_info.outgoing_msg_info.valid);
+    EXPECT_FALSE(statemachine_info.incoming_msg_info.enumerate);
+    EXPECT_FALSE(node1->state.openlcb_datagram_ack_sent);
+
+    // A second write to the same node is turned away until the first completes
+    _reset_variables();
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&statemachine_info);
+
+    EXPECT_EQ(called_function_ptr, (void *)&_load_datagram_rejected_message);
+    EXPECT_EQ(datagram_reply_code, ERROR_TEMPORARY_BUFFER_UNAVAILABLE);
+
+    EXPECT_TRUE(ProtocolConfigMemWriteHandler_complete_write(node1, 4));
+    EXPECT_EQ(send_openlcb_msg_count, 1);
+
+    EXPECT_EQ(sent_msg.mti, MTI_DATAGRAM);
+    EXPECT_EQ(sent_msg.source_alias, DEST_ALIAS);
+    EXPECT_EQ(sent_msg.dest_alias, SOURCE_ALIAS);
+    EXPECT_EQ(sent_payload[0], CONFIG_MEM_CONFIGURATION);
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_WRITE_REPLY_OK_SPACE_FD);
+    EXPECT_EQ(OpenLcbUtilities_extract_dword_from_openlcb_payload(&sent_msg, 2), 0x00000020);
+    EXPECT_EQ(sent_msg.payload_count, 6);
+
+    EXPECT_FALSE(ProtocolConfigMemWriteHandler_complete_write(node1, 4));
+
+    // Slot is free again: the next write is accepted
+    _reset_variables();
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&statemachine_info);
+
+    EXPECT_EQ(called_function_ptr, (void *)&_load_datagram_received_ok_message);
+
+    // Short completion reports a transfer error
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&statemachine_info);
+
+    EXPECT_TRUE(ProtocolConfigMemWriteHandler_complete_write(node1, 1));
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_WRITE_REPLY_FAIL_SPACE_FD);
+    EXPECT_EQ(OpenLcbUtilities_extract_word_from_openlcb_payload(&sent_msg, 6), ERROR_TEMPORARY_TRANSFER_ERROR);
+}
+
+TEST(ProtocolConfigMemWriteHandler, write_under_mask_pending_read_then_write)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+
+    *incoming_msg->payload[1] = CONFIG_MEM_WRITE_UNDER_MASK_SPACE_IN_BYTE_6;
+    OpenLcbUtilities_copy_dword_to_openlcb_payload(incoming_msg, 0x00000000, 2);
+    *incoming_msg->payload[6] = CONFIG_MEM_SPACE_CONFIGURATION_MEMORY;
+    *incoming_msg->payload[7] = 0x0F; // mask
+    *incoming_msg->payload[8] = 0x55; // data
+    incoming_msg->payload_count = 9;
+
+    mock_config_memory[0] = 0xFF;
+
+    ProtocolConfigMemWriteHandler_write_under_mask_space_config_memory(&statemachine_info);
+    EXPECT_TRUE(node1->state.openlcb_datagram_ack_sent);
+
+    // Read step pending: parked with the request datagram held, slot released
+    config_memory_read_pending = true;
+    ProtocolConfigMemWriteHandler_write_under_mask_space_config_memory(&statemachine_info);
+
+    EXPECT_FALSE(statemachine_info.outgoing_msg_info.valid);
+    EXPECT_FALSE(statemachine_info.incoming_msg_info.enumerate);
+    EXPECT_FALSE(node1->state.openlcb_datagram_ack_sent);
+    EXPECT_EQ(parked_read.openlcb_node, node1);
+    EXPECT_EQ(parked_read.kind, CONFIG_MEM_PENDING_WRITE_UNDER_MASK);
+    EXPECT_EQ(parked_read.held_msg, incoming_msg);
+    EXPECT_EQ(parked_read.bytes, 1);
+    EXPECT_EQ(incoming_msg->reference_count, 2);
+    EXPECT_FALSE(ProtocolConfigMemWriteHandler_complete_write(node1, 1));
+
+    // A new write-under-mask to the node is turned away while the read is parked
+    _reset_variables();
+    ProtocolConfigMemWriteHandler_write_under_mask_space_config_memory(&statemachine_info);
+
+    EXPECT_EQ(called_function_ptr, (void *)&_load_datagram_rejected_message);
+    EXPECT_EQ(datagram_reply_code, ERROR_TEMPORARY_BUFFER_UNAVAILABLE);
+
+    // Read completes, write step pending: parked as a write
+    uint8_t current[1] = {0xFF};
+
+    EXPECT_TRUE(ProtocolConfigMemWriteHandler_complete_write_under_mask_read(&parked_read, current, 1));
+
+    EXPECT_EQ(send_openlcb_msg_count, 0);
+    EXPECT_EQ(parked_read.openlcb_node, nullptr);
+    EXPECT_EQ(parked_read.held_msg, nullptr);
+    EXPECT_EQ(incoming_msg->reference_count, 1);
+
+    EXPECT_TRUE(ProtocolConfigMemWriteHandler_complete_write(node1, 1));
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_WRITE_UNDER_MASK_SPACE_IN_BYTE_6 + CONFIG_MEM_REPLY_OK_OFFSET);
+    EXPECT_EQ(sent_payload[6], CONFIG_MEM_SPACE_CONFIGURATION_MEMORY);
+    EXPECT_EQ(sent_msg.payload_count, 7);
+}
+
+TEST(ProtocolConfigMemWriteHandler, write_under_mask_pending_read_complete_merges)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+
+    *incoming_msg->payload[1] = CONFIG_MEM_WRITE_UNDER_MASK_SPACE_IN_BYTE_6;
+    OpenLcbUtilities_copy_dword_to_openlcb_payload(incoming_msg, 0x00000000, 2);
+    *incoming_msg->payload[6] = CONFIG_MEM_SPACE_CONFIGURATION_MEMORY;
+    *incoming_msg->payload[7] = 0x0F; // mask
+    *incoming_msg->payload[8] = 0x55; // data
+    incoming_msg->payload_count = 9;
+
+    mock_config_memory[0] = 0x00;
+
+    ProtocolConfigMemWriteHandler_write_under_mask_space_config_memory(&statemachine_info);
+
+    config_memory_read_pending = true;
+    config_memory_write_pending = false;
+    ProtocolConfigMemWriteHandler_write_under_mask_space_config_memory(&statemachine_info);
+
+    ASSERT_EQ(parked_read.openlcb_node, node1);
+
+    // Merged into the bytes supplied by the completion, not the stale storage
+    uint8_t current[1] = {0xF0};
+
+    EXPECT_TRUE(ProtocolConfigMemWriteHandler_complete_write_under_mask_read(&parked_read, current, 1));
+
+    EXPECT_EQ(mock_config_memory[0], 0xF5);
+    EXPECT_EQ(send_openlcb_msg_count, 1);
+    EXPECT_EQ(sent_msg.dest_alias, SOURCE_ALIAS);
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_WRITE_UNDER_MASK_SPACE_IN_BYTE_6 + CONFIG_MEM_REPLY_OK_OFFSET);
+    EXPECT_EQ(parked_read.openlcb_node, nullptr);
+
+    // A short read fails the write
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+    *incoming_msg->payload[1] = CONFIG_MEM_WRITE_UNDER_MASK_SPACE_IN_BYTE_6;
+    OpenLcbUtilities_copy_dword_to_openlcb_payload(incoming_msg, 0x00000000, 2);
+    *incoming_msg->payload[6] = CONFIG_MEM_SPACE_CONFIGURATION_MEMORY;
+    incoming_msg->payload_count = 9;
+
+    ProtocolConfigMemWriteHandler_write_under_mask_space_config_memory(&statemachine_info);
+    ProtocolConfigMemWriteHandler_write_under_mask_space_config_memory(&statemachine_info);
+
+    EXPECT_TRUE(ProtocolConfigMemWriteHandler_complete_write_under_mask_read(&parked_read, nullptr, 0));
+    EXPECT_EQ(send_openlcb_msg_count, 2);
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_WRITE_UNDER_MASK_SPACE_IN_BYTE_6 + CONFIG_MEM_REPLY_FAIL_OFFSET);
+    EXPECT_EQ(OpenLcbUtilities_extract_word_from_openlcb_payload(&sent_msg, 7), ERROR_TEMPORARY_TRANSFER_ERROR);
+    EXPECT_EQ(incoming_msg->reference_count, 1);
+}
+
+TEST(ProtocolConfigMemWriteHandler, write_pending_acdi_user)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    config_mem_write_request_info_t config_mem_write_request_info;
+
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+    *incoming_msg->payload[1] = CONFIG_MEM_WRITE_SPACE_IN_BYTE_6;
+    *incoming_msg->payload[6] = CONFIG_MEM_SPACE_ACDI_USER_ACCESS;
+
+    config_mem_write_request_info.encoding = ADDRESS_SPACE_IN_BYTE_6;
+    config_mem_write_request_info.address = CONFIG_MEM_ACDI_USER_NAME_ADDRESS;
+    config_mem_write_request_info.bytes = 2;
+    config_mem_write_request_info.data_start = 7;
+    config_mem_write_request_info.write_buffer = (configuration_memory_buffer_t *)incoming_msg->payload[7];
+    config_mem_write_request_info.space_info = nullptr;
+    config_mem_write_request_info.write_space_func = nullptr;
+
+    ProtocolConfigMemWriteHandler_write_request_acdi_user(&statemachine_info, &config_mem_write_request_info);
+
+    EXPECT_FALSE(statemachine_info.outgoing_msg_info.valid);
+
+    // Reply echoes the ACDI address, not the remapped config memory address
+    EXPECT_TRUE(ProtocolConfigMemWriteHandler_complete_write(node1, 2));
+    EXPECT_EQ(sent_payload[1], CONFIG_MEM_WRITE_REPLY_OK_SPACE_IN_BYTE_6);
+    EXPECT_EQ(OpenLcbUtilities_extract_dword_from_openlcb_payload(&sent_msg, 2), CONFIG_MEM_ACDI_USER_NAME_ADDRESS);
+    EXPECT_EQ(sent_payload[6], CONFIG_MEM_SPACE_ACDI_USER_ACCESS);
+}
+
+TEST(ProtocolConfigMemWriteHandler, write_pending_other_space_not_blocked)
+{
+
+    _reset_variables();
+    _global_initialize_with_pending();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+
+    // Park a Config space write
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&statemachine_info);
+    ProtocolConfigMemWriteHandler_write_space_config_memory(&statemachine_info);
+    EXPECT_FALSE(node1->state.openlcb_datagram_ack_sent);
+
+    // A CDI write to the same node cannot park, so it is accepted
+    _reset_variables();
+    _load_write_fd_request(&statemachine_info, node1, incoming_msg, outgoing_msg);
+    *incoming_msg->payload[1] = CONFIG_MEM_WRITE_SPACE_FF;
+    ProtocolConfigMemWriteHandler_write_space_config_description_info(&statemachine_info);
+
+    EXPECT_EQ(called_function_ptr, (void *)&_load_datagram_received_ok_message);
+    EXPECT_TRUE(node1->state.openlcb_datagram_ack_sent);
+
+    // The parked write is still there to complete
+    EXPECT_TRUE(ProtocolConfigMemWriteHandler_complete_write(node1, 4));
+}
@@ -61,21 +61,42 @@
 #include "openlcb_buffer_store.h"
 #include "openlcb_node.h"
 
-    /** @brief Default datagram timeout in 100ms ticks (3 seconds). */
-#define DATAGRAM_TIMEOUT_TICKS 30
+    /** @brief Default datagram reply timeout in milliseconds. */
+#define DATAGRAM_TIMEOUT_MS 3000
 
     /** @brief Maximum datagram retry attempts before abandoning. */
 #define DATAGRAM_MAX_RETRIES 3
 
+    /** @brief Wait before the first resend after a temporary rejection, in milliseconds; doubles on each retry. */
+#define DATAGRAM_RESEND_BACKOFF_MS 200
+
+    /** @brief One outstanding datagram per slot of every node can be scheduled at once. */
+#define LEN_DATAGRAM_DEADLINE_HEAP (USER_DEFINED_NODE_BUFFER_DEPTH * USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH)
+
+    /** @brief A scheduled outstanding datagram and the node that sent it. */
+typedef struct {
+
+    openlcb_node_t *node;
+    datagram_outstanding_t *entry;
+
+} datagram_deadline_t;
+
 
     /** @brief Stored callback interface pointer; set by _initialize(). */
 static interface_protocol_datagram_handler_t *_interface;
 
+    /** @brief Min-heap of outstanding datagrams ordered by deadline (earliest at 0). */
+static datagram_deadline_t _deadline_heap[LEN_DATAGRAM_DEADLINE_HEAP];
+
+    /** @brief Number of scheduled entries in _deadline_heap. */
+static uint16_t _deadline_count;
+
     /**
      * @brief Stores the callback interface.  Call once at startup.
      *
      * @details Algorithm:
      * -# Cast away const and store the pointer in module-level static
+     * -# Empty the deadline heap
      *
      * @verbatim
      * @param interface_protocol_datagram_handler  Populated callback table.
@@ -86,6 +107,7 @@ static interface_protocol_datagram_handler_t *_interface;
 void ProtocolDatagramHandler_initialize(const interface_protocol_datagram_handler_t *interface_protocol_datagram_handler) {
 
     _interface = (interface_protocol_datagram_handler_t *) interface_protocol_datagram_handler;
+    _deadline_count = 0;
 
 }
 
@@ -1454,22 +1476,237 @@ void ProtocolDatagramHandler_load_datagram_rejected_message(openlcb_statemachine
 
     statemachine_info->outgoing_msg_info.valid = true;
 
+}
+
+    /**
+     * @brief Returns true if a stored datagram was sent to the given remote node.
+     *
+     * @details Matches on alias when both sides carry one (CAN), otherwise on
+     * Node ID (TCP/IP, where aliases are 0).
+     */
+static bool _is_sent_to(const openlcb_msg_t *datagram, uint16_t remote_alias, node_id_t remote_id) {
+
+    if (datagram->dest_alias != 0 && remote_alias != 0) {
+
+        return datagram->dest_alias == remote_alias;
+
+    }
+
+    return datagram->dest_id == remote_id;
+
+}
+
+    /** @brief Sets the node's resend_datagram flag if any outstanding entry is waiting for a resend. */
+static void _update_resend_flag(openlcb_node_t *openlcb_node) {
+
+    openlcb_node->state.resend_datagram = false;
+
+    for (int i = 0; i < USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH; i++) {
+
+        if (openlcb_node->outstanding_datagrams[i].datagram && openlcb_node->outstanding_datagrams[i].resend) {
+
+            openlcb_node->state.resend_datagram = true;
+
+        }
+
+    }
+
+}
+
+    /** @brief True if clock value a falls before b (wrap-safe for values < 2^31 ms apart). */
+static bool _deadline_before(uint32_t a, uint32_t b) {
+
+    return (int32_t) (a - b) < 0;
+
+}
+
+    /** @brief Places a heap element at index and records the index in its entry. */
+static void _heap_place(uint16_t index, datagram_deadline_t element) {
+
+    _deadline_heap[index] = element;
+    element.entry->heap_index = index;
+
+}
+
+    /** @brief Moves the element at index toward the root until its parent is not later. */
+static void _heap_sift_up(uint16_t index) {
+
+    datagram_deadline_t element = _deadline_heap[index];
+
+    while (index > 0) {
+
+        uint16_t parent = (index - 1) / 2;
+
+        if (!_deadline_before(element.entry->deadline_ms, _deadline_heap[parent].entry->deadline_ms)) {
+
+            break;
+
+        }
+
+        _heap_place(index, _deadline_heap[parent]);
+        index = parent;
+
+    }
+
+    _heap_place(index, element);
+
+}
+
+    /** @brief Moves the element at index toward the leaves until no child is earlier. */
+static void _heap_sift_down(uint16_t index) {
+
+    datagram_deadline_t element = _deadline_heap[index];
+
+    for (;;) {
+
+        uint16_t child = (uint16_t) (index * 2 + 1);
+
+        if (child >= _deadline_count) {
+
+            break;
+
+        }
+
+        if (child + 1 < _deadline_count &&
+                _deadline_before(_deadline_heap[child + 1].entry->deadline_ms, _deadline_heap[child].entry->deadline_ms)) {
+
+            child++;
+
+        }
+
+        if (!_deadline_before(_deadline_heap[child].entry->deadline_ms, element.entry->deadline_ms)) {
+
+            break;
+
+        }
+
+        _heap_place(index, _deadline_heap[child]);
+        index = child;
+
+    }
+
+    _heap_place(index, element);
+
+}
+
+    /**
+     * @brief Schedules an entry at its deadline, or moves it if already scheduled.
+     *
+     * @details The heap has a slot for every entry of every node, so it
+     * cannot overflow.
+     */
+static void _heap_schedule(openlcb_node_t *openlcb_node, datagram_outstanding_t *entry) {
+
+    if ((entry->heap_index < _deadline_count) && (_deadline_heap[entry->heap_index].entry == entry)) {
+
+        _heap_sift_up(entry->heap_index);
+        _heap_sift_down(entry->heap_index);
+
+        return;
+
+    }
+
+    datagram_deadline_t element = {openlcb_node, entry};
+
+    _heap_place(_deadline_count, element);
+    _deadline_count++;
+    _heap_sift_up(entry->heap_index);
+
+}
+
+    /** @brief Removes the heap slot at index and restores heap order. */
+static void _heap_remove_at(uint16_t index) {
+
+    datagram_outstanding_t *entry = _deadline_heap[index].entry;
+
+    if (entry->heap_index == index) {
+
+        entry->heap_index = DATAGRAM_HEAP_INDEX_NONE;
+
+    }
+
+    _deadline_count--;
+
+    if (index == _deadline_count) {
+
+        return;
+
+    }
+
+    _heap_place(index, _deadline_heap[_deadline_count]);
+    _heap_sift_up(index);
+    _heap_sift_down(index);
+
+}
+
+    /** @brief Takes an entry off the deadline heap if it is scheduled. */
+static void _heap_unschedule(datagram_outstanding_t *entry) {
+
+    uint16_t index = entry->heap_index;
+
+    if ((index < _deadline_count) && (_deadline_heap[index].entry == entry)) {
+
+        _heap_remove_at(index);
+
+    }
+
+    entry->heap_index = DATAGRAM_HEAP_INDEX_NONE;
+
+}
+
+    /** @brief Frees an entry's stored datagram and unschedules it. */
+static void _release_outstanding(datagram_outstanding_t *entry) {
+
+    _heap_unschedule(entry);
+
+    if (entry->datagram) {
+
+        _interface->lock_shared_resources();
+        OpenLcbBufferStore_free_buffer(entry->datagram);
+        _interface->unlock_shared_resources();
+
+    }
+
+    entry->datagram = NULL;
+    entry->retry_count = 0;
+    entry->resend = false;
+
+}
+
+    /** @brief Frees the entry awaiting a reply from the sender of the incoming message, if any. */
+static void _clear_outstanding_for_reply(openlcb_statemachine_info_t *statemachine_info) {
+
+    openlcb_msg_t *reply = statemachine_info->incoming_msg_info.msg_ptr;
+    datagram_outstanding_t *entry = ProtocolDatagramHandler_find_outgoing_datagram(
+            statemachine_info->openlcb_node, reply->source_alias, reply->source_id);
+
+    if (entry) {
+
+        _release_outstanding(entry);
+
+    }
+
+    _update_resend_flag(statemachine_info->openlcb_node);
+
 }
 
     /**
      * @brief Handle incoming Datagram Received OK (MTI 0x0A28).
      *
      * @details Algorithm:
-     * -# Clear resend flag and free the stored datagram buffer
+     * -# Find the outstanding datagram sent to the replying node
+     * -# Free it and refresh the node's resend flag
      * -# Set outgoing_msg_info.valid = false (nothing to send)
      *
+     * Datagrams outstanding to other nodes are not affected.
+     *
      * @verbatim
      * @param statemachine_info  Context with the received OK reply.
      * @endverbatim
      */
 void ProtocolDatagramHandler_datagram_received_ok(openlcb_statemachine_info_t *statemachine_info) {
 
-    ProtocolDatagramHandler_clear_resend_datagram_message(statemachine_info->openlcb_node);
+    _clear_outstanding_for_reply(statemachine_info);
 
     statemachine_info->outgoing_msg_info.valid = false;
 
@@ -1479,14 +1716,16 @@ void ProtocolDatagramHandler_datagram_received_ok(openlcb_statemachine_info_t *s
      * @brief Handle incoming Datagram Rejected (MTI 0x0A48).
      *
      * @details Algorithm:
-     * -# Extract error code from payload word 0
-     * -# If ERROR_TEMPORARY bit set and a stored datagram exists:
-     *    a. Read retry count from timer.datagram.retry_count
-     *    b. Increment retry count
-     *    c. If retries < DATAGRAM_MAX_RETRIES, store new retry count and
-     *       fresh tick snapshot, set resend_datagram flag
-     *    d. If retries >= DATAGRAM_MAX_RETRIES, abandon (clear and free)
-     * -# If permanent error, clear resend flag and free stored buffer
+     * -# Find the outstanding datagram sent to the rejecting node
+     * -# If ERROR_TEMPORARY bit set (resend OK) and one exists:
+     *    a. Increment its retry count
+     *    b. If retries < DATAGRAM_MAX_RETRIES, mark it for resend and
+     *       reschedule it DATAGRAM_RESEND_BACKOFF_MS << (retries - 1)
+     *       out when resend_datagram is wired, otherwise a full
+     *       DATAGRAM_TIMEOUT_MS for the application to resend
+     *    c. If retries >= DATAGRAM_MAX_RETRIES, abandon (free) it
+     * -# If permanent error, free it
+     * -# Refresh the node's resend flag
      * -# Set outgoing_msg_info.valid = false
      *
      * @verbatim
@@ -1497,28 +1736,43 @@ void ProtocolDatagramHandler_datagram_rejected(openlcb_statemachine_info_t *stat
 
     if ((OpenLcbUtilities_extract_word_from_openlcb_payload(statemachine_info->incoming_msg_info.msg_ptr, 0) & ERROR_TEMPORARY) == ERROR_TEMPORARY) {
 
-        if (statemachine_info->openlcb_node->last_received_datagram) {
+        openlcb_msg_t *reply = statemachine_info->incoming_msg_info.msg_ptr;
+        datagram_outstanding_t *entry = ProtocolDatagramHandler_find_outgoing_datagram(
+                statemachine_info->openlcb_node, reply->source_alias, reply->source_id);
+
+        if (entry) {
+
+            entry->retry_count++;
+
+            if (entry->retry_count < DATAGRAM_MAX_RETRIES) {
+
+                entry->resend = true;
+
+                if (_interface->resend_datagram) {
 
-            uint8_t retries = statemachine_info->openlcb_node->last_received_datagram->timer.datagram.retry_count;
-            retries++;
+                    entry->deadline_ms = statemachine_info->current_time_ms + ((uint32_t) DATAGRAM_RESEND_BACKOFF_MS << (entry->retry_count - 1));
 
-            if (retries < DATAGRAM_MAX_RETRIES) {
+                } else {
 
-                statemachine_info->openlcb_node->last_received_datagram->timer.datagram.retry_count = retries;
-                statemachine_info->openlcb_node->last_received_datagram->timer.datagram.tick_snapshot = statemachine_info->current_tick;
-                statemachine_info->openlcb_node->state.resend_datagram = true;
+                    entry->deadline_ms = statemachine_info->current_time_ms + DATAGRAM_TIMEOUT_MS;
+
+                }
+
+                _heap_schedule(statemachine_info->openlcb_node, entry);
 
             } else {
 
-                ProtocolDatagramHandler_clear_resend_datagram_message(statemachine_info->openlcb_node);
+                _release_outstanding(entry);
 
             }
 
         }
 
+        _update_resend_flag(statemachine_info->openlcb_node);
+
     } else {
 
-        ProtocolDatagramHandler_clear_resend_datagram_message(statemachine_info->openlcb_node);
+        _clear_outstanding_for_reply(statemachine_info);
 
     }
 
@@ -1527,10 +1781,88 @@ void ProtocolDatagramHandler_datagram_rejected(openlcb_statemachine_info_t *stat
 }
 
     /**
-     * @brief Free stored datagram and clear resend flag for a node.
+     * @brief Start tracking a datagram the node has sent.
      *
      * @details Algorithm:
-     * -# If last_received_datagram exists, lock/free/unlock it and NULL the pointer
+     * -# Refuse if a datagram to the same remote node is already outstanding
+     *    (a sender waits for the reply before its next datagram to that node)
+     * -# Take a free entry, store the datagram and schedule its reply
+     *    timeout DATAGRAM_TIMEOUT_MS out
+     * -# Return false if every entry is busy
+     *
+     * @verbatim
+     * @param openlcb_node  Sending node.
+     * @param datagram      Copy of the sent datagram; the table owns it on success.
+     * @param current_time_ms  Millisecond clock when the datagram was sent.
+     * @endverbatim
+     *
+     * @return true if the datagram is now tracked.
+     */
+bool ProtocolDatagramHandler_track_outgoing_datagram(openlcb_node_t *openlcb_node, openlcb_msg_t *datagram, uint32_t current_time_ms) {
+
+    if (ProtocolDatagramHandler_find_outgoing_datagram(openlcb_node, datagram->dest_alias, datagram->dest_id)) {
+
+        return false;
+
+    }
+
+    for (int i = 0; i < USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH; i++) {
+
+        datagram_outstanding_t *entry = &openlcb_node->outstanding_datagrams[i];
+
+        if (!entry->datagram) {
+
+            entry->datagram = datagram;
+            entry->deadline_ms = current_time_ms + DATAGRAM_TIMEOUT_MS;
+            entry->retry_count = 0;
+            entry->resend = false;
+
+            _heap_schedule(openlcb_node, entry);
+
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+    /**
+     * @brief Find the outstanding datagram sent to a remote node.
+     *
+     * @verbatim
+     * @param openlcb_node  Sending node.
+     * @param remote_alias  CAN alias of the remote node (0 on TCP/IP).
+     * @param remote_id     Node ID of the remote node.
+     * @endverbatim
+     *
+     * @return Entry, or NULL if nothing is outstanding to that node.
+     */
+datagram_outstanding_t *ProtocolDatagramHandler_find_outgoing_datagram(openlcb_node_t *openlcb_node, uint16_t remote_alias, node_id_t remote_id) {
+
+    for (int i = 0; i < USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH; i++) {
+
+        datagram_outstanding_t *entry = &openlcb_node->outstanding_datagrams[i];
+
+        if (entry->datagram && _is_sent_to(entry->datagram, remote_alias, remote_id)) {
+
+            return entry;
+
+        }
+
+    }
+
+    return NULL;
+
+}
+
+    /**
+     * @brief Free every outstanding datagram and clear the resend flag for a node.
+     *
+     * @details Algorithm:
+     * -# Unschedule and free each stored datagram, locking around each free
      * -# Clear resend_datagram flag
      *
      * @verbatim
@@ -1541,13 +1873,9 @@ void ProtocolDatagramHandler_datagram_rejected(openlcb_statemachine_info_t *stat
      */
 void ProtocolDatagramHandler_clear_resend_datagram_message(openlcb_node_t *openlcb_node) {
 
-    if (openlcb_node->last_received_datagram) {
-
-        _interface->lock_shared_resources();
-        OpenLcbBufferStore_free_buffer(openlcb_node->last_received_datagram);
-        _interface->unlock_shared_resources();
+    for (int i = 0; i < USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH; i++) {
 
-        openlcb_node->last_received_datagram = NULL;
+        _release_outstanding(&openlcb_node->outstanding_datagrams[i]);
 
     }
 
@@ -1573,45 +1901,64 @@ void ProtocolDatagramHandler_100ms_timer_tick(uint8_t current_tick) {
 }
 
     /**
-     * @brief Scans for timed-out or max-retried pending datagrams and frees them.
+     * @brief Services outstanding datagrams whose deadline has passed.
      *
-     * @details Must be called from the main processing loop, not from an
-     * interrupt. Acquires the shared resource lock internally.
+     * @details Algorithm:
+     * -# While the earliest deadline in the heap is due, take it off the heap
+     * -# Skip an entry whose datagram was already dropped (node reset)
+     * -# A pending resend with resend_datagram wired: send it again and wait
+     *    DATAGRAM_TIMEOUT_MS for the reply, or retry a millisecond later if the
+     *    transmit path is busy
+     * -# Anything else has timed out: free the datagram
+     *
+     * Only due entries are touched; the shared resource lock is held just
+     * while a buffer is freed.  Must be called from the main processing loop,
+     * not from an interrupt.
      *
      * @verbatim
-     * @param current_tick  Current value of the global 100ms tick, passed from the main loop.
+     * @param current_time_ms  Millisecond clock, passed from the main loop.
      * @endverbatim
      */
-void ProtocolDatagramHandler_check_timeouts(uint8_t current_tick) {
+void ProtocolDatagramHandler_check_timeouts(uint32_t current_time_ms) {
+
+    while (_deadline_count > 0 && !_deadline_before(current_time_ms, _deadline_heap[0].entry->deadline_ms)) {
+
+        openlcb_node_t *node = _deadline_heap[0].node;
+        datagram_outstanding_t *entry = _deadline_heap[0].entry;
+
+        _heap_remove_at(0);
+
+        if (!entry->datagram) {
 
-    _interface->lock_shared_resources();
+            continue;
 
-    openlcb_node_t *node = OpenLcbNode_get_first(DATAGRAM_TIMEOUT_ENUM_KEY);
+        }
 
-    while (node) {
+        if (entry->resend && _interface->resend_datagram) {
 
-        if (node->last_received_datagram) {
+            if (_interface->resend_datagram(entry->datagram)) {
 
-            uint8_t snapshot = node->last_received_datagram->timer.datagram.tick_snapshot;
-            uint8_t retries = node->last_received_datagram->timer.datagram.retry_count;
-            uint8_t elapsed = (current_tick - snapshot) & 0x1F;
+                entry->resend = false;
+                entry->deadline_ms = current_time_ms + DATAGRAM_TIMEOUT_MS;
 
-            if (elapsed >= DATAGRAM_TIMEOUT_TICKS || retries >= DATAGRAM_MAX_RETRIES) {
+            } else {
 
-                OpenLcbBufferStore_free_buffer(node->last_received_datagram);
-                node->last_received_datagram = NULL;
-                node->state.resend_datagram = false;
+                entry->deadline_ms = current_time_ms + 1;
 
             }
 
+            _heap_schedule(node, entry);
+
+        } else {
+
+            _release_outstanding(entry);
+
         }
 
-        node = OpenLcbNode_get_next(DATAGRAM_TIMEOUT_ENUM_KEY);
+        _update_resend_flag(node);
 
     }
 
-    _interface->unlock_shared_resources();
-
 }
 
 #endif /* OPENLCB_COMPILE_DATAGRAMS */
@@ -332,6 +332,15 @@ typedef struct {
         /** @brief Factory Reset command.  Optional. */
     void (*memory_factory_reset)(openlcb_statemachine_info_t *statemachine_info);
 
+    // =========================================================================
+    // Datagram resend (OPTIONAL)
+    // =========================================================================
+
+        /** @brief Send a stored datagram again once its resend backoff expires.
+         *  Optional; NULL leaves the resend to the application (state.resend_datagram).
+         *  Typical: the transport's send_openlcb_msg. */
+    bool (*resend_datagram)(openlcb_msg_t *datagram);
+
 } interface_protocol_datagram_handler_t;
 
 
@@ -378,23 +387,52 @@ extern "C" {
     extern void ProtocolDatagramHandler_datagram(openlcb_statemachine_info_t *statemachine_info);
 
         /**
-         * @brief Handles an incoming Datagram Received OK reply.  Clears the resend
-         *        flag and frees the stored datagram awaiting acknowledgement.
+         * @brief Handles an incoming Datagram Received OK reply.  Frees the
+         *        outstanding datagram sent to the replying node.
          *
          * @param statemachine_info  Pointer to @ref openlcb_statemachine_info_t context with the received reply.
          */
     extern void ProtocolDatagramHandler_datagram_received_ok(openlcb_statemachine_info_t *statemachine_info);
 
         /**
-         * @brief Handles an incoming Datagram Rejected reply.  Sets the resend flag
-         *        for temporary errors; clears retry state for permanent errors.
+         * @brief Handles an incoming Datagram Rejected reply.  Schedules the
+         *        datagram sent to the rejecting node for resend on temporary
+         *        errors, backing off exponentially; frees it on permanent errors
+         *        or after DATAGRAM_MAX_RETRIES.
          *
          * @param statemachine_info  Pointer to @ref openlcb_statemachine_info_t context with the received rejection.
          */
     extern void ProtocolDatagramHandler_datagram_rejected(openlcb_statemachine_info_t *statemachine_info);
 
         /**
-         * @brief Frees any stored datagram and clears the resend flag for the node.
+         * @brief Starts tracking a datagram the node sent, until its reply or timeout.
+         *
+         * @details Up to USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH datagrams per
+         * node can be outstanding at once, each to a different remote node,
+         * so transfers with independent peers do not wait on each other.
+         *
+         * @param openlcb_node  Pointer to @ref openlcb_node_t sending node.
+         * @param datagram      Copy of the sent datagram.  Owned by the table on success.
+         * @param current_time_ms  Millisecond clock when it was sent (statemachine_info current_time_ms).
+         *
+         * @return true if tracked, false if one is already outstanding to the
+         *         same node or the table is full (caller keeps ownership).
+         */
+    extern bool ProtocolDatagramHandler_track_outgoing_datagram(openlcb_node_t *openlcb_node, openlcb_msg_t *datagram, uint32_t current_time_ms);
+
+        /**
+         * @brief Returns the outstanding datagram sent to a remote node.
+         *
+         * @param openlcb_node  Pointer to @ref openlcb_node_t sending node.
+         * @param remote_alias  CAN alias of the remote node (0 on TCP/IP).
+         * @param remote_id     Node ID of the remote node.
+         *
+         * @return Pointer to the @ref datagram_outstanding_t entry, or NULL.
+         */
+    extern datagram_outstanding_t *ProtocolDatagramHandler_find_outgoing_datagram(openlcb_node_t *openlcb_node, uint16_t remote_alias, node_id_t remote_id);
+
+        /**
+         * @brief Frees every outstanding datagram and clears the resend flag for the node.
          *
          * @param openlcb_node  Pointer to @ref openlcb_node_t target node.
          */
@@ -411,14 +449,18 @@ extern "C" {
     extern void ProtocolDatagramHandler_100ms_timer_tick(uint8_t current_tick);
 
         /**
-         * @brief Scans for timed-out or max-retried pending datagrams and frees them.
+         * @brief Services outstanding datagrams whose deadline has passed.
          *
-         * @details Must be called from the main processing loop, not from an
-         * interrupt. Acquires the shared resource lock internally.
+         * @details Deadlines are kept in a min-heap, so only due entries are
+         * touched and an idle call costs one compare regardless of node
+         * count.  A due resend goes out through resend_datagram; a due reply
+         * wait frees the datagram.  Must be called from the main processing
+         * loop, not from an interrupt.  Takes the shared resource lock only
+         * while freeing a buffer.
          *
-         * @param current_tick  Current value of the global 100ms tick, passed from the main loop.
+         * @param current_time_ms  Millisecond clock (OpenLcbTimer_get_time_ms), passed from the main loop.
          */
-    extern void ProtocolDatagramHandler_check_timeouts(uint8_t current_tick);
+    extern void ProtocolDatagramHandler_check_timeouts(uint32_t current_time_ms);
 
 #ifdef __cplusplus
 }
@@ -93,6 +93,9 @@
 void *called_function_ptr = nullptr;
 bool lock_shared_resources_called = false;
 bool unlock_shared_resources_called = false;
+int resend_datagram_count = 0;
+bool resend_datagram_accept = true;
+openlcb_msg_t *resend_datagram_msg = nullptr;
 
 node_parameters_t _node_parameters_main_node = {
 
@@ -182,6 +185,21 @@ node_parameters_t _node_parameters_main_node = {
 
 interface_openlcb_node_t interface_openlcb_node = {};
 
+bool _resend_datagram(openlcb_msg_t *datagram)
+{
+
+    if (!resend_datagram_accept) {
+
+        return false;
+
+    }
+
+    resend_datagram_count++;
+    resend_datagram_msg = datagram;
+
+    return true;
+}
+
 void _update_called_function_ptr(void *function_ptr)
 {
     called_function_ptr = (void *)((long long)function_ptr + (long long)called_function_ptr);
@@ -1043,6 +1061,9 @@ void _reset_variables(void)
     called_function_ptr = nullptr;
     lock_shared_resources_called = false;
     unlock_shared_resources_called = false;
+    resend_datagram_count = 0;
+    resend_datagram_accept = true;
+    resend_datagram_msg = nullptr;
 }
 
 void _global_initialize(void)
@@ -3736,7 +3757,9 @@ TEST(ProtocolDatagramHandler, handle_datagram_received_ok)
 
     openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
 
-    node1->last_received_datagram = datagram_msg;
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 0);
 
     EXPECT_NE(node1, nullptr);
     EXPECT_NE(incoming_msg, nullptr);
@@ -3762,7 +3785,7 @@ TEST(ProtocolDatagramHandler, handle_datagram_received_ok)
     EXPECT_TRUE(lock_shared_resources_called);
     EXPECT_TRUE(unlock_shared_resources_called);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
     EXPECT_FALSE(node1->state.resend_datagram);
 }
 
@@ -3780,7 +3803,9 @@ TEST(ProtocolDatagramHandler, handle_datagram_rejected_temporary)
 
     openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
 
-    node1->last_received_datagram = datagram_msg;
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 0);
 
     EXPECT_NE(node1, nullptr);
     EXPECT_NE(incoming_msg, nullptr);
@@ -3810,7 +3835,7 @@ TEST(ProtocolDatagramHandler, handle_datagram_rejected_temporary)
     EXPECT_FALSE(lock_shared_resources_called);
     EXPECT_FALSE(unlock_shared_resources_called);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 1);
-    EXPECT_EQ(node1->last_received_datagram, datagram_msg);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, datagram_msg);
     EXPECT_TRUE(node1->state.resend_datagram);
 }
 
@@ -3828,7 +3853,9 @@ TEST(ProtocolDatagramHandler, handle_datagram_rejected_permenent)
 
     openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
 
-    node1->last_received_datagram = datagram_msg;
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 0);
 
     EXPECT_NE(node1, nullptr);
     EXPECT_NE(incoming_msg, nullptr);
@@ -3858,7 +3885,7 @@ TEST(ProtocolDatagramHandler, handle_datagram_rejected_permenent)
     EXPECT_TRUE(lock_shared_resources_called);
     EXPECT_TRUE(unlock_shared_resources_called);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
     EXPECT_FALSE(node1->state.resend_datagram);
 }
 
@@ -3896,14 +3923,14 @@ TEST(ProtocolDatagramHandler, handle_datagram_rejected_temporary_no_resend_messa
     incoming_msg->dest_alias = DEST_ALIAS;
 
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
 
     ProtocolDatagramHandler_datagram_rejected(&statemachine_info);
 
     EXPECT_FALSE(lock_shared_resources_called);
     EXPECT_FALSE(unlock_shared_resources_called);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
     EXPECT_FALSE(node1->state.resend_datagram);
 
     ProtocolDatagramHandler_clear_resend_datagram_message(node1);
@@ -4022,12 +4049,13 @@ TEST(ProtocolDatagramHandler, check_timeouts_no_nodes)
 
     ProtocolDatagramHandler_check_timeouts(0);
 
-    EXPECT_TRUE(lock_shared_resources_called);
-    EXPECT_TRUE(unlock_shared_resources_called);
+    // Nothing scheduled, nothing to lock
+    EXPECT_FALSE(lock_shared_resources_called);
+    EXPECT_FALSE(unlock_shared_resources_called);
 }
 
 // @details Verifies that check_timeouts does nothing when node has no pending datagram
-// @coverage ProtocolDatagramHandler_check_timeouts NULL last_received_datagram
+// @coverage ProtocolDatagramHandler_check_timeouts empty outstanding table
 
 TEST(ProtocolDatagramHandler, check_timeouts_no_pending_datagram)
 {
@@ -4038,17 +4066,17 @@ TEST(ProtocolDatagramHandler, check_timeouts_no_pending_datagram)
     openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
     node1->alias = DEST_ALIAS;
 
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
 
-    ProtocolDatagramHandler_check_timeouts(10);
+    ProtocolDatagramHandler_check_timeouts(1000);
 
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
-    EXPECT_TRUE(lock_shared_resources_called);
-    EXPECT_TRUE(unlock_shared_resources_called);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
+    EXPECT_FALSE(lock_shared_resources_called);
+    EXPECT_FALSE(unlock_shared_resources_called);
 }
 
 // @details Verifies that check_timeouts does NOT free a datagram that has not timed out
-// @coverage ProtocolDatagramHandler_check_timeouts elapsed < DATAGRAM_TIMEOUT_TICKS
+// @coverage ProtocolDatagramHandler_check_timeouts elapsed < DATAGRAM_TIMEOUT_MS
 
 TEST(ProtocolDatagramHandler, check_timeouts_not_expired)
 {
@@ -4060,25 +4088,26 @@ TEST(ProtocolDatagramHandler, check_timeouts_not_expired)
     node1->alias = DEST_ALIAS;
 
     openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
-    node1->last_received_datagram = datagram_msg;
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    // Sent at 500 ms, deadline 3500
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 500);
+    node1->outstanding_datagrams[0].resend = true;
     node1->state.resend_datagram = true;
 
-    // Stamp with tick snapshot = 5, retry count = 0
-    datagram_msg->timer.datagram.tick_snapshot = 5;
-    datagram_msg->timer.datagram.retry_count = 0;
-
+    EXPECT_EQ(node1->outstanding_datagrams[0].deadline_ms, 500 + 3000);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 1);
 
-    // Call check_timeouts at tick 10 (elapsed = 5, less than 30)
-    ProtocolDatagramHandler_check_timeouts(10);
+    // Call check_timeouts at 1000 ms (elapsed = 500, less than 3000)
+    ProtocolDatagramHandler_check_timeouts(1000);
 
-    EXPECT_NE(node1->last_received_datagram, nullptr);
+    EXPECT_NE(node1->outstanding_datagrams[0].datagram, nullptr);
     EXPECT_TRUE(node1->state.resend_datagram);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 1);
 }
 
-// @details Verifies that check_timeouts frees a datagram whose elapsed time >= DATAGRAM_TIMEOUT_TICKS
-// @coverage ProtocolDatagramHandler_check_timeouts elapsed >= DATAGRAM_TIMEOUT_TICKS
+// @details Verifies that check_timeouts frees a datagram whose elapsed time >= DATAGRAM_TIMEOUT_MS
+// @coverage ProtocolDatagramHandler_check_timeouts elapsed >= DATAGRAM_TIMEOUT_MS
 
 TEST(ProtocolDatagramHandler, check_timeouts_expired)
 {
@@ -4090,27 +4119,36 @@ TEST(ProtocolDatagramHandler, check_timeouts_expired)
     node1->alias = DEST_ALIAS;
 
     openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
-    node1->last_received_datagram = datagram_msg;
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 0);
+    node1->outstanding_datagrams[0].resend = true;
     node1->state.resend_datagram = true;
 
-    // Stamp with tick snapshot = 0, retry count = 0
-    datagram_msg->timer.datagram.tick_snapshot = 0;
-    datagram_msg->timer.datagram.retry_count = 0;
-
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 1);
 
-    // Call check_timeouts at tick 30 (elapsed = 30, equals DATAGRAM_TIMEOUT_TICKS)
-    ProtocolDatagramHandler_check_timeouts(30);
+    // 100 ms early: still waiting
+    ProtocolDatagramHandler_check_timeouts(2900);
 
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_NE(node1->outstanding_datagrams[0].datagram, nullptr);
+    EXPECT_FALSE(lock_shared_resources_called);
+
+    // Call check_timeouts at 3000 ms (elapsed equals the timeout)
+    ProtocolDatagramHandler_check_timeouts(3000);
+
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].heap_index, DATAGRAM_HEAP_INDEX_NONE);
     EXPECT_FALSE(node1->state.resend_datagram);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
+    EXPECT_TRUE(lock_shared_resources_called);
+    EXPECT_TRUE(unlock_shared_resources_called);
 }
 
-// @details Verifies that check_timeouts frees a datagram when retry count >= DATAGRAM_MAX_RETRIES
-// @coverage ProtocolDatagramHandler_check_timeouts retries >= DATAGRAM_MAX_RETRIES
+// @details Verifies that check_timeouts services deadlines in order and
+// leaves entries that are not yet due untouched, across nodes
+// @coverage ProtocolDatagramHandler_check_timeouts deadline heap ordering
 
-TEST(ProtocolDatagramHandler, check_timeouts_max_retries_reached)
+TEST(ProtocolDatagramHandler, check_timeouts_only_due_entries)
 {
 
     _reset_variables();
@@ -4118,26 +4156,50 @@ TEST(ProtocolDatagramHandler, check_timeouts_max_retries_reached)
 
     openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
     node1->alias = DEST_ALIAS;
+    openlcb_node_t *node2 = OpenLcbNode_allocate(DEST_ID + 1, &_node_parameters_main_node);
+    node2->alias = DEST_ALIAS + 1;
 
-    openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
-    node1->last_received_datagram = datagram_msg;
-    node1->state.resend_datagram = true;
+    openlcb_msg_t *late = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *early = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *middle = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
 
-    // Stamp with retry count = 3 (>= DATAGRAM_MAX_RETRIES), tick snapshot = 0
-    datagram_msg->timer.datagram.retry_count = 3;
-    datagram_msg->timer.datagram.tick_snapshot = 0;
+    late->dest_alias = SOURCE_ALIAS;
+    late->dest_id = SOURCE_ID;
+    early->dest_alias = SOURCE_ALIAS;
+    early->dest_id = SOURCE_ID;
+    middle->dest_alias = SOURCE_ALIAS + 1;
+    middle->dest_id = SOURCE_ID + 1;
 
-    EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 1);
+    // Tracked out of deadline order: 5000, 3000, 4000
+    EXPECT_TRUE(ProtocolDatagramHandler_track_outgoing_datagram(node1, late, 2000));
+    EXPECT_TRUE(ProtocolDatagramHandler_track_outgoing_datagram(node2, early, 0));
+    EXPECT_TRUE(ProtocolDatagramHandler_track_outgoing_datagram(node2, middle, 1000));
 
-    // Call check_timeouts at tick 0 (elapsed = 0, but retries >= max)
-    ProtocolDatagramHandler_check_timeouts(0);
+    ProtocolDatagramHandler_check_timeouts(3000);
 
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
-    EXPECT_FALSE(node1->state.resend_datagram);
+    EXPECT_EQ(ProtocolDatagramHandler_find_outgoing_datagram(node2, SOURCE_ALIAS, SOURCE_ID), nullptr);
+    EXPECT_NE(ProtocolDatagramHandler_find_outgoing_datagram(node2, SOURCE_ALIAS + 1, SOURCE_ID + 1), nullptr);
+    EXPECT_NE(ProtocolDatagramHandler_find_outgoing_datagram(node1, SOURCE_ALIAS, SOURCE_ID), nullptr);
+    EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 2);
+
+    ProtocolDatagramHandler_check_timeouts(4500);
+
+    EXPECT_EQ(ProtocolDatagramHandler_find_outgoing_datagram(node2, SOURCE_ALIAS + 1, SOURCE_ID + 1), nullptr);
+    EXPECT_NE(ProtocolDatagramHandler_find_outgoing_datagram(node1, SOURCE_ALIAS, SOURCE_ID), nullptr);
+
+    // A reply removes an entry from the middle of the schedule
+    ProtocolDatagramHandler_clear_resend_datagram_message(node1);
+
+    EXPECT_EQ(node1->outstanding_datagrams[0].heap_index, DATAGRAM_HEAP_INDEX_NONE);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
+
+    _reset_variables();
+    ProtocolDatagramHandler_check_timeouts(6000);
+
+    EXPECT_FALSE(lock_shared_resources_called);
 }
 
-// @details Verifies that datagram_rejected increments retry count and stamps fresh tick
+// @details Verifies that datagram_rejected increments retry count and stamps a fresh deadline
 // @coverage ProtocolDatagramHandler_datagram_rejected retry count increment
 
 TEST(ProtocolDatagramHandler, datagram_rejected_retry_increment)
@@ -4153,18 +4215,16 @@ TEST(ProtocolDatagramHandler, datagram_rejected_retry_increment)
     openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
 
     openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
-    node1->last_received_datagram = datagram_msg;
-
-    // Start with retry count = 0, tick snapshot = 5
-    datagram_msg->timer.datagram.retry_count = 0;
-    datagram_msg->timer.datagram.tick_snapshot = 5;
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 500);
 
     openlcb_statemachine_info_t statemachine_info;
 
     statemachine_info.openlcb_node = node1;
     statemachine_info.incoming_msg_info.msg_ptr = incoming_msg;
     statemachine_info.incoming_msg_info.enumerate = false;
-    statemachine_info.current_tick = 10;
+    statemachine_info.current_time_ms = 1000;
     OpenLcbUtilities_copy_word_to_openlcb_payload(statemachine_info.incoming_msg_info.msg_ptr, ERROR_TEMPORARY_BUFFER_UNAVAILABLE, 0);
     statemachine_info.incoming_msg_info.msg_ptr->mti = MTI_DATAGRAM_REJECTED_REPLY;
     statemachine_info.incoming_msg_info.msg_ptr->payload_count = 2;
@@ -4179,11 +4239,12 @@ TEST(ProtocolDatagramHandler, datagram_rejected_retry_increment)
 
     ProtocolDatagramHandler_datagram_rejected(&statemachine_info);
 
-    // After first rejection: retry count = 1, tick snapshot = 10 (current_tick)
-    EXPECT_NE(node1->last_received_datagram, nullptr);
+    // After first rejection: retry count = 1, no resend_datagram wired so the
+    // application gets a full timeout from the rejection to resend
+    EXPECT_NE(node1->outstanding_datagrams[0].datagram, nullptr);
     EXPECT_TRUE(node1->state.resend_datagram);
-    EXPECT_EQ(datagram_msg->timer.datagram.retry_count, 1);
-    EXPECT_EQ(datagram_msg->timer.datagram.tick_snapshot, 10);
+    EXPECT_EQ(node1->outstanding_datagrams[0].retry_count, 1);
+    EXPECT_EQ(node1->outstanding_datagrams[0].deadline_ms, 1000 + 3000);
 }
 
 // @details Verifies that datagram_rejected abandons after DATAGRAM_MAX_RETRIES
@@ -4202,18 +4263,19 @@ TEST(ProtocolDatagramHandler, datagram_rejected_max_retries_abandon)
     openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
 
     openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
-    node1->last_received_datagram = datagram_msg;
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 0);
 
     // Start with retry count = 2 (one more rejection will reach max of 3)
-    datagram_msg->timer.datagram.retry_count = 2;
-    datagram_msg->timer.datagram.tick_snapshot = 0;
+    node1->outstanding_datagrams[0].retry_count = 2;
 
     openlcb_statemachine_info_t statemachine_info;
 
     statemachine_info.openlcb_node = node1;
     statemachine_info.incoming_msg_info.msg_ptr = incoming_msg;
     statemachine_info.incoming_msg_info.enumerate = false;
-    statemachine_info.current_tick = 15;
+    statemachine_info.current_time_ms = 1500;
     OpenLcbUtilities_copy_word_to_openlcb_payload(statemachine_info.incoming_msg_info.msg_ptr, ERROR_TEMPORARY_BUFFER_UNAVAILABLE, 0);
     statemachine_info.incoming_msg_info.msg_ptr->mti = MTI_DATAGRAM_REJECTED_REPLY;
     statemachine_info.incoming_msg_info.msg_ptr->payload_count = 2;
@@ -4231,15 +4293,15 @@ TEST(ProtocolDatagramHandler, datagram_rejected_max_retries_abandon)
     ProtocolDatagramHandler_datagram_rejected(&statemachine_info);
 
     // After 3rd rejection: retries = 3 >= DATAGRAM_MAX_RETRIES, should abandon
-    EXPECT_EQ(node1->last_received_datagram, nullptr);
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
     EXPECT_FALSE(node1->state.resend_datagram);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
 }
 
-// @details Verifies that check_timeouts handles tick wraparound correctly
+// @details Verifies that check_timeouts handles millisecond clock wraparound correctly
 // @coverage ProtocolDatagramHandler_check_timeouts unsigned subtraction wraparound
 
-TEST(ProtocolDatagramHandler, check_timeouts_tick_wraparound)
+TEST(ProtocolDatagramHandler, check_timeouts_clock_wraparound)
 {
 
     _reset_variables();
@@ -4249,23 +4311,225 @@ TEST(ProtocolDatagramHandler, check_timeouts_tick_wraparound)
     node1->alias = DEST_ALIAS;
 
     openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
-    node1->last_received_datagram = datagram_msg;
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    // Sent 1000 ms before the 32-bit clock wraps, deadline wraps to 2000
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 0xFFFFFFFFUL - 999);
+    node1->outstanding_datagrams[0].resend = true;
     node1->state.resend_datagram = true;
 
-    // Stamp with tick snapshot = 30 (0x1E), retry count = 0
-    datagram_msg->timer.datagram.tick_snapshot = 30;
-    datagram_msg->timer.datagram.retry_count = 0;
-
+    EXPECT_EQ(node1->outstanding_datagrams[0].deadline_ms, 2000);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 1);
 
-    // Current tick = 5 (wrapped around from 31 -> 0 -> 1 -> ... -> 5)
-    // Elapsed = (5 - 30) & 0x1F = (-25) & 0x1F = 7
-    // 7 < 30 so should NOT expire
-    ProtocolDatagramHandler_check_timeouts(5);
+    // Not yet due either side of the wrap
+    ProtocolDatagramHandler_check_timeouts(0xFFFFFFFFUL - 499);
+    ProtocolDatagramHandler_check_timeouts(500);
 
-    EXPECT_NE(node1->last_received_datagram, nullptr);
+    EXPECT_NE(node1->outstanding_datagrams[0].datagram, nullptr);
     EXPECT_TRUE(node1->state.resend_datagram);
     EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 1);
+
+    ProtocolDatagramHandler_check_timeouts(2000);
+
+    EXPECT_EQ(node1->outstanding_datagrams[0].datagram, nullptr);
+    EXPECT_FALSE(node1->state.resend_datagram);
+    EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
+}
+
+// @details With resend_datagram wired, a temporary rejection is resent after
+// an exponential backoff, and a busy transmit path is retried 1 ms later
+// @coverage ProtocolDatagramHandler_datagram_rejected backoff,
+// ProtocolDatagramHandler_check_timeouts resend
+
+TEST(ProtocolDatagramHandler, datagram_rejected_resend_backoff)
+{
+
+    _reset_variables();
+    _global_initialize();
+
+    interface_protocol_datagram_handler_t resend_interface = interface_protocol_datagram_handler;
+    resend_interface.resend_datagram = &_resend_datagram;
+    ProtocolDatagramHandler_initialize(&resend_interface);
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    datagram_msg->dest_alias = SOURCE_ALIAS;
+    datagram_msg->dest_id = SOURCE_ID;
+    ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 0);
+
+    openlcb_statemachine_info_t statemachine_info;
+
+    statemachine_info.openlcb_node = node1;
+    statemachine_info.incoming_msg_info.msg_ptr = incoming_msg;
+    statemachine_info.incoming_msg_info.enumerate = false;
+    statemachine_info.current_time_ms = 1000;
+    OpenLcbUtilities_copy_word_to_openlcb_payload(incoming_msg, ERROR_TEMPORARY_BUFFER_UNAVAILABLE, 0);
+    incoming_msg->mti = MTI_DATAGRAM_REJECTED_REPLY;
+    incoming_msg->payload_count = 2;
+    statemachine_info.outgoing_msg_info.msg_ptr = outgoing_msg;
+    statemachine_info.outgoing_msg_info.enumerate = false;
+    statemachine_info.outgoing_msg_info.valid = false;
+    incoming_msg->source_id = SOURCE_ID;
+    incoming_msg->source_alias = SOURCE_ALIAS;
+    incoming_msg->dest_id = DEST_ID;
+    incoming_msg->dest_alias = DEST_ALIAS;
+
+    datagram_outstanding_t *entry = &node1->outstanding_datagrams[0];
+
+    // First rejection: resend DATAGRAM_RESEND_BACKOFF_MS (200) later
+    ProtocolDatagramHandler_datagram_rejected(&statemachine_info);
+
+    EXPECT_TRUE(entry->resend);
+    EXPECT_EQ(entry->deadline_ms, 1200);
+
+    ProtocolDatagramHandler_check_timeouts(1100);
+
+    EXPECT_EQ(resend_datagram_count, 0);
+
+    ProtocolDatagramHandler_check_timeouts(1200);
+
+    EXPECT_EQ(resend_datagram_count, 1);
+    EXPECT_EQ(resend_datagram_msg, datagram_msg);
+    EXPECT_FALSE(entry->resend);
+    EXPECT_FALSE(node1->state.resend_datagram);
+    EXPECT_EQ(entry->deadline_ms, 1200 + 3000);
+
+    // Second rejection doubles the backoff; transmit path busy the first time
+    statemachine_info.current_time_ms = 2000;
+    ProtocolDatagramHandler_datagram_rejected(&statemachine_info);
+
+    EXPECT_EQ(entry->retry_count, 2);
+    EXPECT_EQ(entry->deadline_ms, 2400);
+
+    resend_datagram_accept = false;
+    ProtocolDatagramHandler_check_timeouts(2400);
+
+    EXPECT_EQ(resend_datagram_count, 1);
+    EXPECT_TRUE(entry->resend);
+    EXPECT_EQ(entry->deadline_ms, 2401);
+
+    resend_datagram_accept = true;
+    ProtocolDatagramHandler_check_timeouts(2500);
+
+    EXPECT_EQ(resend_datagram_count, 2);
+    EXPECT_FALSE(entry->resend);
+
+    // Nothing else happens until the reply timeout
+    ProtocolDatagramHandler_check_timeouts(5400);
+
+    EXPECT_EQ(entry->datagram, datagram_msg);
+
+    ProtocolDatagramHandler_check_timeouts(5500);
+
+    EXPECT_EQ(entry->datagram, nullptr);
+    EXPECT_EQ(resend_datagram_count, 2);
+    EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
+}
+
+// @details Two peers each with a datagram outstanding: a reply from one only
+// touches its own entry
+// @coverage ProtocolDatagramHandler_track_outgoing_datagram, per-peer lookup
+
+TEST(ProtocolDatagramHandler, outstanding_datagrams_per_peer)
+{
+
+    _reset_variables();
+    _global_initialize();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *to_a = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *to_b = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    openlcb_msg_t *to_a_again = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+
+    to_a->dest_alias = SOURCE_ALIAS;
+    to_a->dest_id = SOURCE_ID;
+    to_b->dest_alias = SOURCE_ALIAS + 1;
+    to_b->dest_id = SOURCE_ID + 1;
+    to_a_again->dest_alias = SOURCE_ALIAS;
+    to_a_again->dest_id = SOURCE_ID;
+
+    EXPECT_TRUE(ProtocolDatagramHandler_track_outgoing_datagram(node1, to_a, 0));
+    EXPECT_TRUE(ProtocolDatagramHandler_track_outgoing_datagram(node1, to_b, 2000));
+
+    // Only one datagram at a time to the same peer
+    EXPECT_FALSE(ProtocolDatagramHandler_track_outgoing_datagram(node1, to_a_again, 2000));
+    OpenLcbBufferStore_free_buffer(to_a_again);
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+    openlcb_statemachine_info_t statemachine_info;
+
+    statemachine_info.openlcb_node = node1;
+    statemachine_info.incoming_msg_info.msg_ptr = incoming_msg;
+    statemachine_info.incoming_msg_info.enumerate = false;
+    statemachine_info.outgoing_msg_info.msg_ptr = outgoing_msg;
+    statemachine_info.outgoing_msg_info.enumerate = false;
+    statemachine_info.outgoing_msg_info.valid = false;
+    statemachine_info.current_time_ms = 2500;
+    incoming_msg->source_id = SOURCE_ID + 1;
+    incoming_msg->source_alias = SOURCE_ALIAS + 1;
+    incoming_msg->dest_id = DEST_ID;
+    incoming_msg->dest_alias = DEST_ALIAS;
+    OpenLcbUtilities_copy_word_to_openlcb_payload(incoming_msg, ERROR_TEMPORARY_BUFFER_UNAVAILABLE, 0);
+    incoming_msg->payload_count = 2;
+
+    // Peer B rejects with resend OK: only B's entry is marked
+    ProtocolDatagramHandler_datagram_rejected(&statemachine_info);
+
+    datagram_outstanding_t *entry_a = ProtocolDatagramHandler_find_outgoing_datagram(node1, SOURCE_ALIAS, SOURCE_ID);
+    datagram_outstanding_t *entry_b = ProtocolDatagramHandler_find_outgoing_datagram(node1, SOURCE_ALIAS + 1, SOURCE_ID + 1);
+
+    ASSERT_NE(entry_a, nullptr);
+    ASSERT_NE(entry_b, nullptr);
+    EXPECT_FALSE(entry_a->resend);
+    EXPECT_EQ(entry_a->retry_count, 0);
+    EXPECT_TRUE(entry_b->resend);
+    EXPECT_EQ(entry_b->retry_count, 1);
+    EXPECT_TRUE(node1->state.resend_datagram);
+
+    // A's 3 second timeout expires while B (rejected at 25) keeps waiting
+    ProtocolDatagramHandler_check_timeouts(3000);
+
+    EXPECT_EQ(ProtocolDatagramHandler_find_outgoing_datagram(node1, SOURCE_ALIAS, SOURCE_ID), nullptr);
+    EXPECT_EQ(ProtocolDatagramHandler_find_outgoing_datagram(node1, SOURCE_ALIAS + 1, SOURCE_ID + 1), entry_b);
+
+    // Peer B acknowledges
+    ProtocolDatagramHandler_datagram_received_ok(&statemachine_info);
+
+    EXPECT_EQ(ProtocolDatagramHandler_find_outgoing_datagram(node1, SOURCE_ALIAS + 1, SOURCE_ID + 1), nullptr);
+    EXPECT_FALSE(node1->state.resend_datagram);
+    EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
+}
+
+// @details Matching falls back to Node ID when aliases are 0 (TCP/IP)
+// @coverage ProtocolDatagramHandler_find_outgoing_datagram Node ID match
+
+TEST(ProtocolDatagramHandler, outstanding_datagram_matches_node_id_without_alias)
+{
+
+    _reset_variables();
+    _global_initialize();
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+
+    openlcb_msg_t *datagram_msg = OpenLcbBufferStore_allocate_buffer(DATAGRAM);
+    datagram_msg->dest_alias = 0;
+    datagram_msg->dest_id = SOURCE_ID;
+
+    EXPECT_TRUE(ProtocolDatagramHandler_track_outgoing_datagram(node1, datagram_msg, 0));
+    EXPECT_NE(ProtocolDatagramHandler_find_outgoing_datagram(node1, 0, SOURCE_ID), nullptr);
+    EXPECT_EQ(ProtocolDatagramHandler_find_outgoing_datagram(node1, 0, SOURCE_ID + 1), nullptr);
+
+    ProtocolDatagramHandler_clear_resend_datagram_message(node1);
+
+    EXPECT_EQ(OpenLcbBufferStore_datagram_messages_allocated(), 0);
 }
 
 // ============================================================================
@@ -214,7 +214,8 @@ uint16_t ProtocolSnip_load_user_version_id(openlcb_node_t *openlcb_node, openlcb
      *
      * @details Algorithm:
      * -# Compute config-memory address (base + low_address offset if valid)
-     * -# Read via config_memory_read callback
+     * -# Read via config_memory_read callback; on CONFIG_MEM_ACCESS_PENDING
+     *    return the offset unchanged without writing
      * -# Copy into payload via _process_snip_string
      *
      * @verbatim
@@ -240,7 +241,11 @@ uint16_t ProtocolSnip_load_user_name(openlcb_node_t *openlcb_node, openlcb_msg_t
 
     if (_interface->config_memory_read) {
 
-        _interface->config_memory_read(openlcb_node, data_address, requested_bytes, &configuration_memory_buffer);
+        if (_interface->config_memory_read(openlcb_node, data_address, requested_bytes, &configuration_memory_buffer) == CONFIG_MEM_ACCESS_PENDING) {
+
+            return offset; // storage busy, caller parks the reply
+
+        }
 
         _process_snip_string(outgoing_msg, &offset, (char*) (&configuration_memory_buffer[0]), LEN_SNIP_USER_NAME_BUFFER, requested_bytes);
 
@@ -259,7 +264,8 @@ uint16_t ProtocolSnip_load_user_name(openlcb_node_t *openlcb_node, openlcb_msg_t
      *
      * @details Algorithm:
      * -# Compute config-memory address (base + low_address offset if valid)
-     * -# Read via config_memory_read callback
+     * -# Read via config_memory_read callback; on CONFIG_MEM_ACCESS_PENDING
+     *    return the offset unchanged without writing
      * -# Copy into payload via _process_snip_string
      *
      * @verbatim
@@ -284,7 +290,11 @@ uint16_t ProtocolSnip_load_user_description(openlcb_node_t *openlcb_node, openlc
 
     if (_interface->config_memory_read) {
 
-        _interface->config_memory_read(openlcb_node, data_address, requested_bytes, &configuration_memory_buffer); // grab string from config memory
+        if (_interface->config_memory_read(openlcb_node, data_address, requested_bytes, &configuration_memory_buffer) == CONFIG_MEM_ACCESS_PENDING) {
+
+            return offset; // storage busy, caller parks the reply
+
+        }
 
         _process_snip_string(outgoing_msg, &offset, (char*) (&configuration_memory_buffer[0]), LEN_SNIP_USER_DESCRIPTION_BUFFER, requested_bytes);
 
@@ -296,15 +306,92 @@ uint16_t ProtocolSnip_load_user_description(openlcb_node_t *openlcb_node, openlc
 
     return offset;
 
+}
+
+    /** @brief Answers the request with Optional Interaction Rejected (temporary) so it is resent. */
+static void _reject_busy(openlcb_statemachine_info_t *statemachine_info) {
+
+    OpenLcbUtilities_load_openlcb_message(statemachine_info->outgoing_msg_info.msg_ptr,
+            statemachine_info->openlcb_node->alias,
+            statemachine_info->openlcb_node->id,
+            statemachine_info->incoming_msg_info.msg_ptr->source_alias,
+            statemachine_info->incoming_msg_info.msg_ptr->source_id,
+            MTI_OPTIONAL_INTERACTION_REJECTED);
+
+    OpenLcbUtilities_copy_word_to_openlcb_payload(statemachine_info->outgoing_msg_info.msg_ptr, ERROR_TEMPORARY_BUFFER_UNAVAILABLE, 0);
+    OpenLcbUtilities_copy_word_to_openlcb_payload(statemachine_info->outgoing_msg_info.msg_ptr, statemachine_info->incoming_msg_info.msg_ptr->mti, 2);
+
+    statemachine_info->outgoing_msg_info.valid = true;
+
+}
+
+    /**
+     * @brief Parks the reply built so far until its user field read completes.
+     *
+     * @details Algorithm:
+     * -# Copy the header and the payload_offset bytes built so far into a SNIP buffer
+     * -# Hand it to park_read; the read handler owns it until
+     *    ProtocolSnip_complete_read() sends and frees it
+     *
+     * @verbatim
+     * @param statemachine_info  Context with the partial reply.
+     * @param payload_offset     Bytes of the reply already built.
+     * @param kind               User field the reply is waiting on.
+     * @endverbatim
+     *
+     * @return true if parked; false if there is no buffer, no slot or no hooks.
+     */
+static bool _park_reply(openlcb_statemachine_info_t *statemachine_info, uint16_t payload_offset, config_mem_pending_kind_enum kind) {
+
+    if (!_interface->park_read || !_interface->send_openlcb_msg) {
+
+        return false;
+
+    }
+
+    openlcb_msg_t *outgoing_msg = statemachine_info->outgoing_msg_info.msg_ptr;
+    openlcb_msg_t *held_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    if (!held_msg) {
+
+        return false;
+
+    }
+
+    OpenLcbUtilities_load_openlcb_message(held_msg, outgoing_msg->source_alias, outgoing_msg->source_id, outgoing_msg->dest_alias, outgoing_msg->dest_id, outgoing_msg->mti);
+    OpenLcbUtilities_copy_byte_array_to_openlcb_payload(held_msg, (const uint8_t *) outgoing_msg->payload, 0, payload_offset);
+
+    config_mem_pending_request_t request = {0};
+
+    request.openlcb_node = statemachine_info->openlcb_node;
+    request.kind = kind;
+    request.held_msg = held_msg;
+    request.reply_alias = outgoing_msg->dest_alias;
+    request.reply_id = outgoing_msg->dest_id;
+
+    if (!_interface->park_read(&request)) {
+
+        OpenLcbBufferStore_free_buffer(held_msg);
+
+        return false;
+
+    }
+
+    return true;
+
 }
 
     /**
      * @brief Build and return a SNIP reply (MTI 0x0A08).
      *
      * @details Algorithm:
+     * -# Turn the request away (temporary) if a user field read could not be
+     *    parked should it come back pending
      * -# Prepare outgoing message header addressed to the requester
      * -# Append 8 fields sequentially: mfg version, name, model, HW ver,
      *    SW ver, user version, user name, user description
+     * -# If a user field read came back pending, park the partial reply and
+     *    send nothing; ProtocolSnip_complete_read() finishes it
      * -# Mark outgoing message valid
      *
      * @verbatim
@@ -314,6 +401,17 @@ uint16_t ProtocolSnip_load_user_description(openlcb_node_t *openlcb_node, openlc
 void ProtocolSnip_handle_simple_node_info_request(openlcb_statemachine_info_t *statemachine_info) {
 
     uint16_t payload_offset = 0;
+    uint16_t user_offset = 0;
+
+    statemachine_info->incoming_msg_info.enumerate = false;
+
+    if (_interface->config_memory_read && _interface->can_park_read && !_interface->can_park_read(statemachine_info->openlcb_node)) {
+
+        _reject_busy(statemachine_info); // earlier read still waiting on storage
+
+        return;
+
+    }
 
     OpenLcbUtilities_load_openlcb_message(statemachine_info->outgoing_msg_info.msg_ptr,
             statemachine_info->openlcb_node->alias,
@@ -334,12 +432,143 @@ void ProtocolSnip_handle_simple_node_info_request(openlcb_statemachine_info_t *s
 
     payload_offset = ProtocolSnip_load_user_version_id(statemachine_info->openlcb_node, statemachine_info->outgoing_msg_info.msg_ptr, payload_offset, 1);
 
+    user_offset = payload_offset;
+
     payload_offset = ProtocolSnip_load_user_name(statemachine_info->openlcb_node, statemachine_info->outgoing_msg_info.msg_ptr, payload_offset, LEN_SNIP_USER_NAME_BUFFER - 1);
 
+    if (payload_offset == user_offset) {
+
+        if (_park_reply(statemachine_info, payload_offset, CONFIG_MEM_PENDING_SNIP_USER_NAME)) {
+
+            statemachine_info->outgoing_msg_info.valid = false;
+
+        } else {
+
+            _reject_busy(statemachine_info);
+
+        }
+
+        return;
+
+    }
+
+    user_offset = payload_offset;
+
     payload_offset = ProtocolSnip_load_user_description(statemachine_info->openlcb_node, statemachine_info->outgoing_msg_info.msg_ptr, payload_offset, LEN_SNIP_USER_DESCRIPTION_BUFFER - 1);
 
+    if (payload_offset == user_offset) {
+
+        if (_park_reply(statemachine_info, payload_offset, CONFIG_MEM_PENDING_SNIP_USER_DESCRIPTION)) {
+
+            statemachine_info->outgoing_msg_info.valid = false;
+
+        } else {
+
+            _reject_busy(statemachine_info);
+
+        }
+
+        return;
+
+    }
+
     statemachine_info->outgoing_msg_info.valid = true;
 
+}
+
+    /** @brief Appends a completed user field read as a null-terminated SNIP string. */
+static void _append_user_field(openlcb_msg_t *held_msg, uint16_t *payload_offset, const uint8_t *data, uint16_t count, uint16_t max_str_len) {
+
+    configuration_memory_buffer_t configuration_memory_buffer;
+
+    memset(configuration_memory_buffer, 0x00, sizeof(configuration_memory_buffer));
+
+    if (count > max_str_len - 1) {
+
+        count = max_str_len - 1;
+
+    }
+
+    if (data) {
+
+        memcpy(configuration_memory_buffer, data, count);
+
+    }
+
+    _process_snip_string(held_msg, payload_offset, (char*) (&configuration_memory_buffer[0]), max_str_len, max_str_len - 1);
+
+}
+
+    /**
+     * @brief Finishes a SNIP reply parked on a pending user field read.
+     *
+     * @details Algorithm:
+     * -# Append the completed field to the held reply
+     * -# After the user name, read the description; if that is pending, wait
+     *    for the next completion with the reply still parked
+     * -# Send the reply; on a busy transmit path roll back so the same
+     *    completion can be repeated
+     * -# Free the held reply and the slot
+     *
+     * @verbatim
+     * @param pending  Parked request.
+     * @param data     Bytes read.
+     * @param count    Number of bytes in data.
+     * @endverbatim
+     *
+     * @return true if taken; false if the reply could not be sent.
+     */
+bool ProtocolSnip_complete_read(config_mem_pending_request_t *pending, const uint8_t *data, uint16_t count) {
+
+    openlcb_msg_t *held_msg = pending->held_msg;
+
+    if (!held_msg || !_interface->send_openlcb_msg) {
+
+        return false;
+
+    }
+
+    config_mem_pending_kind_enum kind = pending->kind;
+    uint16_t rollback_count = held_msg->payload_count;
+    uint16_t payload_offset = held_msg->payload_count;
+
+    if (kind == CONFIG_MEM_PENDING_SNIP_USER_NAME) {
+
+        _append_user_field(held_msg, &payload_offset, data, count, LEN_SNIP_USER_NAME_BUFFER);
+
+        uint16_t user_offset = payload_offset;
+
+        payload_offset = ProtocolSnip_load_user_description(pending->openlcb_node, held_msg, payload_offset, LEN_SNIP_USER_DESCRIPTION_BUFFER - 1);
+
+        if (payload_offset == user_offset) {
+
+            pending->kind = CONFIG_MEM_PENDING_SNIP_USER_DESCRIPTION; // still parked
+
+            return true;
+
+        }
+
+    } else {
+
+        _append_user_field(held_msg, &payload_offset, data, count, LEN_SNIP_USER_DESCRIPTION_BUFFER);
+
+    }
+
+    if (!_interface->send_openlcb_msg(held_msg)) {
+
+        held_msg->payload_count = rollback_count;
+
+        return false;
+
+    }
+
+    OpenLcbBufferStore_free_buffer(held_msg);
+
+    pending->held_msg = NULL;
+    pending->openlcb_node = NULL;
+
+    return true;
+
 }
 
     /** @brief Handle incoming SNIP reply — no automatic response generated. */
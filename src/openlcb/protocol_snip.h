@@ -52,6 +52,19 @@ typedef struct {
         /** @brief Read from config memory (ACDI User space) for user name/description.  REQUIRED. */
    uint16_t(*config_memory_read)(openlcb_node_t *openlcb_node, uint32_t address, uint16_t count, configuration_memory_buffer_t *buffer);
 
+        /** @brief Returns true if a pending read for the node could be parked.  OPTIONAL; NULL
+         *  (with park_read) answers every pending read with a temporary rejection.
+         *  Typical: ProtocolConfigMemReadHandler_can_park_read. */
+   bool (*can_park_read)(openlcb_node_t *openlcb_node);
+
+        /** @brief Parks a reply whose user name/description read is pending.  OPTIONAL.
+         *  Typical: ProtocolConfigMemReadHandler_park_read. */
+   bool (*park_read)(const config_mem_pending_request_t *request);
+
+        /** @brief Sends a parked reply once its read completes.  OPTIONAL; needed with park_read.
+         *  Typical: the transport's send_openlcb_msg. */
+   bool (*send_openlcb_msg)(openlcb_msg_t *openlcb_msg);
+
 } interface_openlcb_protocol_snip_t;
 
 #ifdef __cplusplus
@@ -71,10 +84,32 @@ extern "C" {
          * @details Assembles eight fields: mfg version, name, model, HW ver, SW ver,
          *          user version, user name, user description.  Max 253 bytes.
          *
+         *          If config_memory_read answers CONFIG_MEM_ACCESS_PENDING the reply
+         *          built so far is moved to a SNIP buffer and parked through park_read;
+         *          nothing is sent until ProtocolSnip_complete_read() finishes it.
+         *          When it cannot be parked the request is answered with Optional
+         *          Interaction Rejected (temporary) so the requester asks again.
+         *
          * @param statemachine_info  Pointer to @ref openlcb_statemachine_info_t context.
          */
     extern void ProtocolSnip_handle_simple_node_info_request(openlcb_statemachine_info_t *statemachine_info);
 
+        /**
+         * @brief Finishes a SNIP reply parked on a pending user name/description read.
+         *
+         * @details Called through ProtocolConfigMemReadHandler_complete_read().
+         *          A user name completion goes on to read the description; if
+         *          that is pending too the reply stays parked.  Fewer bytes than
+         *          were asked for are sent as a truncated (possibly empty) string.
+         *
+         * @param pending  Parked request (kind CONFIG_MEM_PENDING_SNIP_USER_*).
+         * @param data     Bytes read.
+         * @param count    Number of bytes in data.
+         *
+         * @return true if taken; false if the reply could not be sent (call again).
+         */
+    extern bool ProtocolSnip_complete_read(config_mem_pending_request_t *pending, const uint8_t *data, uint16_t count);
+
         /**
          * @brief Handles an incoming SNIP reply (MTI 0x0A08).  No automatic response.
          *
@@ -160,7 +195,8 @@ extern "C" {
          * @param outgoing_msg     Pointer to @ref openlcb_msg_t reply being built.
          * @param offset           Payload byte offset to write at.
          * @param requested_bytes  Maximum bytes to copy.
-         * @return Bytes actually written.
+         * @return Bytes actually written.  Returns offset unchanged when
+         *         config_memory_read answers CONFIG_MEM_ACCESS_PENDING.
          */
     extern uint16_t ProtocolSnip_load_user_name(openlcb_node_t *openlcb_node, openlcb_msg_t *outgoing_msg, uint16_t offset, uint16_t requested_bytes);
 
@@ -171,7 +207,8 @@ extern "C" {
          * @param outgoing_msg     Pointer to @ref openlcb_msg_t reply being built.
          * @param offset           Payload byte offset to write at.
          * @param requested_bytes  Maximum bytes to copy.
-         * @return Bytes actually written.
+         * @return Bytes actually written.  Returns offset unchanged when
+         *         config_memory_read answers CONFIG_MEM_ACCESS_PENDING.
          */
     extern uint16_t ProtocolSnip_load_user_description(openlcb_node_t *openlcb_node, openlcb_msg_t *outgoing_msg, uint16_t offset, uint16_t requested_bytes);
 
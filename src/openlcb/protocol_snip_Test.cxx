@@ -97,7 +97,12 @@
 
 static uint32_t config_read_address = 0;
 static uint16_t config_read_count = 0;
-static uint16_t config_read_type = 0;  // 0=none, 1=short, 2=full
+static uint16_t config_read_type = 0;  // 0=none, 1=short, 2=full, 3=pending
+static config_mem_pending_request_t parked_request;
+static bool send_openlcb_msg_fail = false;
+static int send_openlcb_msg_count = 0;
+static openlcb_msg_t sent_msg;
+static payload_snip_t sent_payload;
 
 // ============================================================================
 // NODE PARAMETER CONFIGURATIONS
@@ -276,6 +281,9 @@ uint16_t mock_config_memory_read(openlcb_node_t *openlcb_node, uint32_t address,
             (*buffer)[copy_count] = '\0';  // Ensure null termination
         }
         return copy_count;
+    } else if (config_read_type == 3) {
+        // Storage busy
+        return CONFIG_MEM_ACCESS_PENDING;
     }
 
     return 0;
@@ -289,6 +297,45 @@ interface_openlcb_protocol_snip_t interface_protocol_snip = {
     .config_memory_read = mock_config_memory_read
 };
 
+/**
+ * @brief Mock park hooks standing in for the config memory read handler
+ * @details One slot; can_park_read is false while it is taken
+ */
+bool mock_can_park_read(openlcb_node_t *openlcb_node)
+{
+    return parked_request.openlcb_node == NULL;
+}
+
+bool mock_park_read(const config_mem_pending_request_t *request)
+{
+    if (parked_request.openlcb_node) {
+        return false;
+    }
+
+    parked_request = *request;
+    return true;
+}
+
+bool mock_send_openlcb_msg(openlcb_msg_t *openlcb_msg)
+{
+    if (send_openlcb_msg_fail) {
+        return false;
+    }
+
+    send_openlcb_msg_count++;
+    sent_msg = *openlcb_msg;
+    memcpy(&sent_payload, openlcb_msg->payload, sizeof(sent_payload));
+    sent_msg.payload = (openlcb_payload_t *)&sent_payload;
+    return true;
+}
+
+interface_openlcb_protocol_snip_t interface_protocol_snip_parking = {
+    .config_memory_read = mock_config_memory_read,
+    .can_park_read = mock_can_park_read,
+    .park_read = mock_park_read,
+    .send_openlcb_msg = mock_send_openlcb_msg
+};
+
 interface_openlcb_protocol_snip_t interface_protocol_snip_null = {
     .config_memory_read = NULL  // NULL callback for safety testing
 };
@@ -307,6 +354,9 @@ void _reset_variables(void)
     config_read_address = 0;
     config_read_count = 0;
     config_read_type = 0;
+    memset(&parked_request, 0, sizeof(parked_request));
+    send_openlcb_msg_fail = false;
+    send_openlcb_msg_count = 0;
 }
 
 /**
@@ -681,6 +731,175 @@ TEST(ProtocolSnip, handle_simple_node_info_request)
     EXPECT_EQ(payload_ptr[0], 4);  // Manufacturer version
 }
 
+// ============================================================================
+// TEST: Handle Simple Node Info Request With Pending Storage
+// @details A pending user name read parks the partial reply; completing the
+//          name (description ready) sends it without re-running the request
+// @coverage ProtocolSnip_handle_simple_node_info_request()
+// @coverage ProtocolSnip_complete_read()
+// ============================================================================
+
+TEST(ProtocolSnip, handle_simple_node_info_request_pending)
+{
+    _reset_variables();
+    _global_initialize();
+    ProtocolSnip_initialize(&interface_protocol_snip_parking);
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    ASSERT_NE(node1, nullptr);
+    ASSERT_NE(incoming_msg, nullptr);
+    ASSERT_NE(outgoing_msg, nullptr);
+
+    openlcb_statemachine_info_t statemachine_info;
+    statemachine_info.openlcb_node = node1;
+    statemachine_info.incoming_msg_info.msg_ptr = incoming_msg;
+    statemachine_info.incoming_msg_info.enumerate = false;
+    statemachine_info.outgoing_msg_info.msg_ptr = outgoing_msg;
+    statemachine_info.outgoing_msg_info.enumerate = false;
+    statemachine_info.outgoing_msg_info.valid = false;
+
+    OpenLcbUtilities_load_openlcb_message(incoming_msg, SOURCE_ALIAS, SOURCE_ID, DEST_ALIAS, DEST_ID, MTI_SIMPLE_NODE_INFO_REQUEST);
+
+    config_read_type = 3;  // Storage busy
+
+    EXPECT_EQ(ProtocolSnip_load_user_name(node1, outgoing_msg, 10, LEN_SNIP_USER_NAME_BUFFER - 1), 10);
+    EXPECT_EQ(ProtocolSnip_load_user_description(node1, outgoing_msg, 10, LEN_SNIP_USER_DESCRIPTION_BUFFER - 1), 10);
+
+    ProtocolSnip_handle_simple_node_info_request(&statemachine_info);
+
+    // Nothing sent and nothing asks to be re-run; the reply so far is held
+    EXPECT_FALSE(statemachine_info.outgoing_msg_info.valid);
+    EXPECT_FALSE(statemachine_info.incoming_msg_info.enumerate);
+    EXPECT_EQ(parked_request.openlcb_node, node1);
+    EXPECT_EQ(parked_request.kind, CONFIG_MEM_PENDING_SNIP_USER_NAME);
+    ASSERT_NE(parked_request.held_msg, nullptr);
+    EXPECT_EQ(parked_request.held_msg->mti, MTI_SIMPLE_NODE_INFO_REPLY);
+    EXPECT_EQ(parked_request.held_msg->dest_alias, SOURCE_ALIAS);
+    EXPECT_EQ(OpenLcbBufferStore_snip_messages_allocated(), 2);
+
+    config_read_type = 1;  // Description ready when the name completes
+
+    // Transmit path busy: the reply stays held and the completion can be repeated
+    send_openlcb_msg_fail = true;
+    EXPECT_FALSE(ProtocolSnip_complete_read(&parked_request, (const uint8_t *)"Name", 5));
+    send_openlcb_msg_fail = false;
+
+    EXPECT_TRUE(ProtocolSnip_complete_read(&parked_request, (const uint8_t *)"Name", 5));
+
+    EXPECT_EQ(send_openlcb_msg_count, 1);
+    EXPECT_EQ(sent_msg.mti, MTI_SIMPLE_NODE_INFO_REPLY);
+    EXPECT_TRUE(ProtocolSnip_validate_snip_reply(&sent_msg));
+    EXPECT_EQ(parked_request.openlcb_node, nullptr);
+    EXPECT_EQ(parked_request.held_msg, nullptr);
+    EXPECT_EQ(OpenLcbBufferStore_snip_messages_allocated(), 1);
+}
+
+// ============================================================================
+// TEST: Handle Simple Node Info Request With Both User Fields Pending
+// @details Completing the name reads the description; that is pending too,
+//          so the reply stays parked until the second completion
+// @coverage ProtocolSnip_complete_read()
+// ============================================================================
+
+TEST(ProtocolSnip, handle_simple_node_info_request_pending_description)
+{
+    _reset_variables();
+    _global_initialize();
+    ProtocolSnip_initialize(&interface_protocol_snip_parking);
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    statemachine_info.openlcb_node = node1;
+    statemachine_info.incoming_msg_info.msg_ptr = incoming_msg;
+    statemachine_info.incoming_msg_info.enumerate = false;
+    statemachine_info.outgoing_msg_info.msg_ptr = outgoing_msg;
+    statemachine_info.outgoing_msg_info.valid = false;
+
+    OpenLcbUtilities_load_openlcb_message(incoming_msg, SOURCE_ALIAS, SOURCE_ID, DEST_ALIAS, DEST_ID, MTI_SIMPLE_NODE_INFO_REQUEST);
+
+    config_read_type = 3;  // Storage busy
+
+    ProtocolSnip_handle_simple_node_info_request(&statemachine_info);
+
+    EXPECT_EQ(parked_request.kind, CONFIG_MEM_PENDING_SNIP_USER_NAME);
+
+    EXPECT_TRUE(ProtocolSnip_complete_read(&parked_request, (const uint8_t *)"Name", 5));
+
+    EXPECT_EQ(send_openlcb_msg_count, 0);
+    EXPECT_EQ(parked_request.openlcb_node, node1);
+    EXPECT_EQ(parked_request.kind, CONFIG_MEM_PENDING_SNIP_USER_DESCRIPTION);
+
+    EXPECT_TRUE(ProtocolSnip_complete_read(&parked_request, (const uint8_t *)"Description", 12));
+
+    EXPECT_EQ(send_openlcb_msg_count, 1);
+    EXPECT_TRUE(ProtocolSnip_validate_snip_reply(&sent_msg));
+    EXPECT_EQ(sent_payload[sent_msg.payload_count - 12], 'D');
+    EXPECT_EQ(parked_request.openlcb_node, nullptr);
+}
+
+// ============================================================================
+// TEST: Handle Simple Node Info Request That Cannot Park
+// @details A request that could not be parked is rejected (temporary) so the
+//          requester asks again, both up front and on an unhooked interface
+// @coverage ProtocolSnip_handle_simple_node_info_request()
+// ============================================================================
+
+TEST(ProtocolSnip, handle_simple_node_info_request_pending_no_slot)
+{
+    _reset_variables();
+    _global_initialize();
+    ProtocolSnip_initialize(&interface_protocol_snip_parking);
+
+    openlcb_node_t *node1 = OpenLcbNode_allocate(DEST_ID, &_node_parameters_main_node);
+    node1->alias = DEST_ALIAS;
+
+    openlcb_msg_t *incoming_msg = OpenLcbBufferStore_allocate_buffer(BASIC);
+    openlcb_msg_t *outgoing_msg = OpenLcbBufferStore_allocate_buffer(SNIP);
+
+    openlcb_statemachine_info_t statemachine_info;
+    statemachine_info.openlcb_node = node1;
+    statemachine_info.incoming_msg_info.msg_ptr = incoming_msg;
+    statemachine_info.incoming_msg_info.enumerate = false;
+    statemachine_info.outgoing_msg_info.msg_ptr = outgoing_msg;
+    statemachine_info.outgoing_msg_info.valid = false;
+
+    OpenLcbUtilities_load_openlcb_message(incoming_msg, SOURCE_ALIAS, SOURCE_ID, DEST_ALIAS, DEST_ID, MTI_SIMPLE_NODE_INFO_REQUEST);
+
+    // Slot already taken: turned away before storage is touched
+    parked_request.openlcb_node = node1;
+    config_read_type = 1;
+
+    ProtocolSnip_handle_simple_node_info_request(&statemachine_info);
+
+    EXPECT_TRUE(statemachine_info.outgoing_msg_info.valid);
+    EXPECT_FALSE(statemachine_info.incoming_msg_info.enumerate);
+    EXPECT_EQ(outgoing_msg->mti, MTI_OPTIONAL_INTERACTION_REJECTED);
+    EXPECT_EQ(OpenLcbUtilities_extract_word_from_openlcb_payload(outgoing_msg, 0), ERROR_TEMPORARY_BUFFER_UNAVAILABLE);
+    EXPECT_EQ(OpenLcbUtilities_extract_word_from_openlcb_payload(outgoing_msg, 2), MTI_SIMPLE_NODE_INFO_REQUEST);
+    EXPECT_EQ(config_read_count, 0);
+
+    // No park hooks: a pending read is rejected the same way
+    ProtocolSnip_initialize(&interface_protocol_snip);
+    config_read_type = 3;
+    statemachine_info.outgoing_msg_info.valid = false;
+
+    ProtocolSnip_handle_simple_node_info_request(&statemachine_info);
+
+    EXPECT_TRUE(statemachine_info.outgoing_msg_info.valid);
+    EXPECT_EQ(outgoing_msg->mti, MTI_OPTIONAL_INTERACTION_REJECTED);
+    EXPECT_EQ(OpenLcbBufferStore_snip_messages_allocated(), 1);
+}
+
 // ============================================================================
 // TEST: Handle Simple Node Info Reply
 // @details Tests SNIP reply handler (passive - no response)
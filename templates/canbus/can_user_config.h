@@ -23,4 +23,85 @@
 
 #define USER_DEFINED_CAN_MSG_BUFFER_DEPTH            20     // must be >= 1; enforced by compiler
 
+// =============================================================================
+// Pre-reserved Alias Pool
+// =============================================================================
+// Number of CAN aliases kept reserved in the background (CID/RID already sent)
+// so nodes created at run time -- train search "allocate on no match", throttle
+// proxies -- can claim one and send AMD immediately instead of waiting out a
+// full 200 ms alias reservation.  0 disables the pool.  Each slot costs one
+// alias mapping entry; refilling needs 4 free CAN buffers at a time.
+//
+// The pool reserves under placeholder Node IDs BASE + slot and seeds its alias
+// generator from BASE.  Take BASE from a Node ID range this unit owns (every
+// unit needs its own); REQUIRED when DEPTH > 0, there is no default.
+
+#define USER_DEFINED_ALIAS_POOL_DEPTH                0      // 0 = disabled, max 255
+#define USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS 1     // 100 ms ticks between new reservations
+// #define USER_DEFINED_ALIAS_POOL_NODE_ID_BASE      0x050101010000ULL  // your own range
+
+// =============================================================================
+// Remote Alias Cache
+// =============================================================================
+// Number of other nodes' alias / Node ID pairs remembered from AMD, Verified
+// Node ID and Initialization Complete traffic.  Lets incoming messages carry
+// the sender's Node ID and lets the application address a message by Node ID
+// alone (dest_alias = 0) without a Verify Node ID round trip.  Least recently
+// used entries are replaced when full.  0 disables the cache.
+
+#define USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH        0      // 0 = disabled, max 4095
+
+// =============================================================================
+// Hardware Acceptance Filters
+// =============================================================================
+// Number of ID/mask filter banks the CAN controller gives the stack (bxCAN
+// has 14, for example).  When set, the library builds filters that pass
+// control frames, global/addressed standard frames and datagram/stream frames
+// for this device's aliases, and calls on_acceptance_filters_changed in
+// can_config_t whenever an alias changes.  Frames for other nodes then never
+// interrupt the CPU.  0 disables the generator.
+
+#define USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT     0      // 0 = disabled, max 255
+
+// =============================================================================
+// Bulk Listener Alias Verification (requires OPENLCB_COMPILE_TRAIN)
+// =============================================================================
+// With this many consist listeners registered or more, the listener alias
+// prober stops sending one targeted AME per entry and instead revalidates the
+// whole table with one global AME every LISTENER_PROBE_INTERVAL_TICKS, so no
+// listener alias is older than that interval.  Every node on the segment
+// answers a global AME, so keep this well above the typical consist size.
+// 0 always probes one listener at a time.
+
+#define USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD  32     // 0 = never bulk, max 16384
+
+// =============================================================================
+// Bus-Load Monitor
+// =============================================================================
+// Bit rate of the CAN segment.  When set, every received and transmitted frame
+// is counted and CanBusMonitor_get_stats() reports utilisation, frames per
+// 100 ms, a frame-rate histogram and error frames (reported by the driver via
+// CanBusMonitor_count_error_frame()).  0 disables the monitor.
+//
+// THROTTLE_PERCENT -- smoothed utilisation at which multi-message event
+// enumeration and config-memory stream data are held back so other traffic
+// gets through.  0 never holds anything back.
+
+#define USER_DEFINED_CAN_BUS_MONITOR_BITRATE         0      // 0 = disabled, LCC uses 125000
+#define USER_DEFINED_CAN_BUS_THROTTLE_PERCENT        0      // 0 = never defer, max 100
+
+// =============================================================================
+// TX Priority Scheduler
+// =============================================================================
+// Frames queued for transmit wait here and every free hardware mailbox is
+// loaded with the lowest-identifier frame allowed to go next, so control
+// frames and high-priority messages win locally as they would on the bus.
+// Frames from one alias keep their order and only one is in a mailbox at a
+// time.  Takes effect only when can_config_t.get_free_tx_mailbox_count is set;
+// the driver's TX-complete interrupt calls CanTxScheduler_on_tx_complete().
+// 0 sends each frame straight to the driver as before.
+
+#define USER_DEFINED_CAN_TX_QUEUE_DEPTH              0      // 0 = disabled
+#define USER_DEFINED_CAN_TX_MAILBOX_COUNT            1      // controller TX mailboxes, 1-32
+
 #endif /* __CAN_USER_CONFIG__ */
@@ -34,6 +34,7 @@
  *    #define OPENLCB_COMPILE_STREAM            // stream transport for large transfers
  *    #define OPENLCB_COMPILE_BROADCAST_TIME    // clock synchronization
  *    #define OPENLCB_COMPILE_DCC_DETECTOR      // DCC detection protocol
+ *    #define OPENLCB_COMPILE_CONFIG_MEM_CACHE  // write-back cache for config memory
  *
  *  Minimal bootloader (firmware upgrade only):
  *    Use templates/bootloader/openlcb_user_config.h instead
@@ -61,6 +62,7 @@
 // #define OPENLCB_COMPILE_TRAIN
 // #define OPENLCB_COMPILE_TRAIN_SEARCH
 // #define OPENLCB_COMPILE_DCC_DETECTOR
+// #define OPENLCB_COMPILE_CONFIG_MEM_CACHE
 
 // =============================================================================
 // Debug -- uncomment to print feature summary during compilation
@@ -85,6 +87,10 @@
 #define USER_DEFINED_SNIP_BUFFER_DEPTH               4      // must be >= 1; enforced by compiler
 #define USER_DEFINED_STREAM_BUFFER_DEPTH             1      // must be >= 1; enforced by compiler
 
+// Datagrams each node can have sent and awaiting a reply at the same time, one
+// per remote node, so transfers with two configuration tools run in parallel.
+#define USER_DEFINED_DATAGRAM_OUTSTANDING_DEPTH      2      // must be >= 1; enforced by compiler
+
 // =============================================================================
 // Stream Transport (requires OPENLCB_COMPILE_STREAM)
 // =============================================================================
@@ -127,6 +133,15 @@
 // begin.  The standard layout puts the user name at address 0 and the user
 // description immediately after at byte 62:
 //   63 = LEN_SNIP_USER_NAME_BUFFER (63)
+//
+// With OPENLCB_COMPILE_CONFIG_MEM_CACHE, writes are collected in RAM lines and
+// merged before reaching config_mem_write.  Set the line size to the EEPROM or
+// flash page size.  Lines are written back on Update Complete, after the idle
+// time, before a reboot, or when a line is needed for another block.
+
+// #define USER_DEFINED_CONFIG_MEM_CACHE_LINES          4      // must be >= 1; enforced by compiler
+// #define USER_DEFINED_CONFIG_MEM_CACHE_LINE_SIZE      64     // 1..64 bytes; enforced by compiler
+// #define USER_DEFINED_CONFIG_MEM_CACHE_IDLE_FLUSH_MS  1000
 
 // =============================================================================
 // Train Protocol (requires OPENLCB_COMPILE_TRAIN)
@@ -0,0 +1,37 @@
+/** @file can_user_config.h
+ *  @brief CAN driver configuration for the optional-feature test targets
+ *
+ *  The shared typical config keeps every optional CAN driver feature at its
+ *  shipped default (off) so the disabled paths stay covered.  The can_features_*
+ *  test targets are built against this file instead, with the features on.
+ */
+
+#ifndef __CAN_USER_CONFIG__
+#define __CAN_USER_CONFIG__
+
+#define USER_DEFINED_CAN_MSG_BUFFER_DEPTH            20
+
+// Pre-reserved Alias Pool
+#define USER_DEFINED_ALIAS_POOL_DEPTH                4
+#define USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS 1
+#define USER_DEFINED_ALIAS_POOL_NODE_ID_BASE         0x050101012200ULL
+
+// Remote Alias Cache
+#define USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH        16
+
+// Hardware Acceptance Filters
+#define USER_DEFINED_CAN_ACCEPTANCE_FILTER_COUNT     8
+
+// Bulk Listener Alias Verification -- below the typical 24-slot listener
+// table so the bulk path is reachable
+#define USER_DEFINED_LISTENER_BULK_VERIFY_THRESHOLD  16
+
+// Bus-Load Monitor
+#define USER_DEFINED_CAN_BUS_MONITOR_BITRATE         125000
+#define USER_DEFINED_CAN_BUS_THROTTLE_PERCENT        80
+
+// TX Priority Scheduler
+#define USER_DEFINED_CAN_TX_QUEUE_DEPTH              8
+#define USER_DEFINED_CAN_TX_MAILBOX_COUNT            3
+
+#endif /* __CAN_USER_CONFIG__ */
@@ -0,0 +1,117 @@
+/** @file openlcb_user_config.h
+ *  @brief Test configuration -- typical, plus the config memory write-back cache
+ *
+ *  The shared typical config leaves OPENLCB_COMPILE_CONFIG_MEM_CACHE off so the
+ *  uncached config memory path stays covered.  The config_mem_cache_* test
+ *  targets are built against this file instead.
+ */
+
+#ifndef __OPENLCB_USER_CONFIG__
+#define __OPENLCB_USER_CONFIG__
+
+// =============================================================================
+// Transport Selection -- exactly one must be defined
+// =============================================================================
+
+ #define OPENLCB_COMPILE_CAN
+// #define OPENLCB_COMPILE_TCP
+
+
+// =============================================================================
+// Feature Flags
+// =============================================================================
+
+#define OPENLCB_COMPILE_EVENTS
+#define OPENLCB_COMPILE_DATAGRAMS
+#define OPENLCB_COMPILE_MEMORY_CONFIGURATION
+#define OPENLCB_COMPILE_CONFIG_MEM_CACHE
+#define OPENLCB_COMPILE_FIRMWARE
+#define OPENLCB_COMPILE_BROADCAST_TIME
+#define OPENLCB_COMPILE_TRAIN
+#define OPENLCB_COMPILE_TRAIN_SEARCH
+#define OPENLCB_COMPILE_STREAM
+#define OPENLCB_COMPILE_DCC_DETECTOR
+
+// =============================================================================
+// Core Message Buffer Pool
+// =============================================================================
+// The library uses a pool of message buffers of different sizes.  Tune these
+// for your platform's available RAM.  The total number of buffers is the sum
+// of all four types.  On 8-bit processors the total must not exceed 126.
+//
+//   BASIC    (16 bytes each)  -- most OpenLCB messages fit in this size
+//   DATAGRAM (72 bytes each)  -- datagram protocol messages
+//   SNIP     (256 bytes each) -- SNIP replies and Events with Payload
+//   STREAM   (USER_DEFINED_STREAM_BUFFER_LEN bytes each) -- stream data transfer
+
+#define USER_DEFINED_BASIC_BUFFER_DEPTH              32  // must be >= 1; enforced by compiler
+#define USER_DEFINED_DATAGRAM_BUFFER_DEPTH           4   // must be >= 1; enforced by compiler
+#define USER_DEFINED_SNIP_BUFFER_DEPTH               4   // must be >= 1; enforced by compiler
+#define USER_DEFINED_STREAM_BUFFER_DEPTH             1   // must be >= 1; enforced by compiler
+
+// =============================================================================
+// Stream Transport (requires OPENLCB_COMPILE_STREAM)
+// =============================================================================
+// STREAM_BUFFER_LEN is the maximum bytes per stream data frame this node can
+// accept.  The spec uses a 2-byte field so the protocol max is 65535.  During
+// negotiation the smaller of the two nodes' buffer sizes wins.
+//
+// MAX_CONCURRENT_ACTIVE_STREAMS controls how many streams can be open at the
+// same time across all nodes.  Each active stream uses a small state struct,
+// not a full payload buffer.  The expensive RAM is governed by
+// STREAM_BUFFER_DEPTH in the buffer pool above.
+#define USER_DEFINED_STREAM_BUFFER_LEN               256    // ignored and overridden to 1 if OPENLCB_COMPILE_STREAM is not defined
+#define USER_DEFINED_MAX_CONCURRENT_ACTIVE_STREAMS   2      // must be >= 1; enforced by compiler
+
+// =============================================================================
+// Virtual Node Allocation
+// =============================================================================
+// How many virtual nodes this device can host.  Most simple devices use 1.
+// Train command stations may need more (one per locomotive being controlled).
+
+#define USER_DEFINED_NODE_BUFFER_DEPTH               50  // must be >= 1; enforced by compiler
+
+// =============================================================================
+// Events (requires OPENLCB_COMPILE_EVENTS)
+// =============================================================================
+// Maximum number of produced/consumed events per node, and how many event ID
+// ranges each node can handle.  Ranges are used by protocols like Train Search
+// that work with contiguous blocks of event IDs.
+// Range counts must be at least 1 for valid array sizing.
+
+#define USER_DEFINED_PRODUCER_COUNT                  64  // must be >= 1; enforced by compiler
+#define USER_DEFINED_PRODUCER_RANGE_COUNT            5   // must be >= 1; enforced by compiler
+#define USER_DEFINED_CONSUMER_COUNT                  32  // must be >= 1; enforced by compiler
+#define USER_DEFINED_CONSUMER_RANGE_COUNT            5   // must be >= 1; enforced by compiler
+
+// =============================================================================
+// Memory Configuration (requires OPENLCB_COMPILE_MEMORY_CONFIGURATION)
+// =============================================================================
+//
+// The two address values tell the SNIP protocol where in your node's
+// configuration memory space the user-editable name and description strings
+// begin.  The standard layout puts the user name at address 0 and the user
+// description immediately after at byte 62:
+//   63 = LEN_SNIP_USER_NAME_BUFFER (63)
+
+// =============================================================================
+// Train Protocol (requires OPENLCB_COMPILE_TRAIN)
+// =============================================================================
+// TRAIN_NODE_COUNT        -- max simultaneous train nodes (often equals
+//                            NODE_BUFFER_DEPTH for a dedicated command station)
+// MAX_LISTENERS_PER_TRAIN -- max consist members (listener slots) per train
+// MAX_TRAIN_FUNCTIONS     -- number of DCC function outputs: 29 = F0 through F28
+
+#define USER_DEFINED_TRAIN_NODE_COUNT                4   // must be >= 1; enforced by compiler
+#define USER_DEFINED_MAX_LISTENERS_PER_TRAIN         6   // must be >= 1; enforced by compiler
+#define USER_DEFINED_MAX_TRAIN_FUNCTIONS             29  // must be >= 1; enforced by compiler
+
+// =============================================================================
+// Listener Alias Verification (requires OPENLCB_COMPILE_TRAIN)
+// =============================================================================
+
+#define USER_DEFINED_LISTENER_PROBE_TICK_INTERVAL    1
+#define USER_DEFINED_LISTENER_PROBE_INTERVAL_TICKS   250
+#define USER_DEFINED_LISTENER_VERIFY_TIMEOUT_TICKS   30
+
+#endif /* __OPENLCB_USER_CONFIG__ */
@@ -0,0 +1,22 @@
+/** @file can_user_config.h
+ *  @brief CAN driver configuration for the router-without-cache build check
+ *
+ *  The router needs the alias pool (present here) and the remote alias cache
+ *  (left off) -- without the cache no CAN message carries a source Node ID and
+ *  nothing would cross to TCP.
+ */
+
+#ifndef __CAN_USER_CONFIG__
+#define __CAN_USER_CONFIG__
+
+#define USER_DEFINED_CAN_MSG_BUFFER_DEPTH            20
+
+// Pre-reserved Alias Pool
+#define USER_DEFINED_ALIAS_POOL_DEPTH                4
+#define USER_DEFINED_ALIAS_POOL_REFILL_INTERVAL_TICKS 1
+#define USER_DEFINED_ALIAS_POOL_NODE_ID_BASE         0x050101012200ULL
+
+// Remote Alias Cache
+#define USER_DEFINED_REMOTE_ALIAS_CACHE_DEPTH        0
+
+#endif /* __CAN_USER_CONFIG__ */
@@ -0,0 +1,15 @@
+/** @file openlcb_user_config.h
+ *  @brief Test configuration -- typical with both transports (CAN <-> TCP router)
+ *
+ *  Paired with can_user_config.h in this directory, which leaves the remote
+ *  alias cache off.  openlcb_config.c must refuse to build against it.
+ */
+
+#ifndef __ROUTER_NO_CACHE_OPENLCB_USER_CONFIG__
+#define __ROUTER_NO_CACHE_OPENLCB_USER_CONFIG__
+
+ #define OPENLCB_COMPILE_TCP
+
+#include "../typical/openlcb_user_config.h"
+
+#endif /* __ROUTER_NO_CACHE_OPENLCB_USER_CONFIG__ */
@@ -0,0 +1,820 @@
+/** \copyright
+ * Copyright (c) 2024, Jim Kueneman
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file gridconnect_hub.c
+ * @brief Linux GridConnect TCP hub with shared-buffer fan-out.
+ *
+ * @details Accepts any number of GridConnect TCP clients on one epoll loop.
+ * Every client owns a reentrant gridconnect_parser_t, so each incoming frame is
+ * parsed exactly once.  The frame is then re-encoded once into a reference
+ * counted hub_frame_t and a pointer to it is queued on every other client.
+ * Queues are drained with writev(), up to HUB_IOV_MAX frames per call; a client
+ * whose socket stays full until its queue reaches the limit is evicted so one
+ * slow tool cannot stall the segment.
+ *
+ * Throughput and latency counters (receive time to last byte written) are
+ * printed every stats interval and once more on SIGINT/SIGTERM.
+ *
+ * This is a host tool, so unlike the library it uses malloc() and POSIX
+ * sockets freely.
+ *
+ * @author Jim Kueneman
+ * @date 18 Oct 2026
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <limits.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "openlcb/openlcb_gridconnect.h"
+
+    /** @brief Default listen port (same as the olcbchecker bridge). */
+#define HUB_DEFAULT_PORT 12021
+
+    /** @brief Default per-client queue limit in frames before eviction. */
+#define HUB_DEFAULT_QUEUE_LIMIT 4096
+
+    /** @brief Default seconds between statistics reports (0 = only on exit). */
+#define HUB_DEFAULT_STATS_INTERVAL 10
+
+    /** @brief Most frames handed to a single writev() call. */
+#define HUB_IOV_MAX 64
+
+    /** @brief Receive chunk size per read(). */
+#define HUB_RX_CHUNK 4096
+
+    /** @brief Most epoll events handled per wakeup. */
+#define HUB_MAX_EVENTS 64
+
+    /** @brief One encoded frame shared by every client it is queued on. */
+typedef struct hub_frame_struct {
+
+    uint32_t refs;                  /**< @brief Client queues still holding this frame. */
+    uint64_t rx_time_ns;            /**< @brief CLOCK_MONOTONIC time the frame was parsed. */
+    uint8_t len;                    /**< @brief Encoded length including the trailing '\n'. */
+    gridconnect_buffer_t text;      /**< @brief ":X...N...;\n" (not NUL terminated). */
+
+} hub_frame_t;
+
+    /** @brief One connected TCP client. */
+typedef struct hub_client_struct {
+
+    int fd;                                 /**< @brief Socket. */
+    char name[INET6_ADDRSTRLEN + 8];        /**< @brief "address:port" for logging. */
+    gridconnect_parser_t parser;            /**< @brief Receive-side parser context. */
+
+    hub_frame_t **queue;                    /**< @brief Ring of pending frames (queue_limit slots). */
+    uint32_t head;                          /**< @brief Ring index of the oldest frame. */
+    uint32_t count;                         /**< @brief Frames in the ring. */
+    uint8_t head_offset;                    /**< @brief Bytes of the oldest frame already written. */
+
+    bool want_write;                        /**< @brief EPOLLOUT currently armed. */
+    bool dirty;                             /**< @brief On the flush list for this wakeup. */
+    bool closing;                           /**< @brief Disconnect at the end of this wakeup. */
+    const char *close_reason;               /**< @brief Logged when the client is dropped. */
+
+    struct hub_client_struct *next;         /**< @brief Client list link. */
+    struct hub_client_struct *next_dirty;   /**< @brief Flush list link. */
+
+} hub_client_t;
+
+    /** @brief Hub-wide counters, reset by each periodic report except the totals. */
+typedef struct {
+
+    uint64_t frames_in;         /**< @brief Frames parsed from clients. */
+    uint64_t bytes_in;          /**< @brief Raw bytes read from clients. */
+    uint64_t frames_out;        /**< @brief Frame deliveries fully written to clients. */
+    uint64_t bytes_out;         /**< @brief Bytes written to clients. */
+    uint64_t latency_sum_ns;    /**< @brief Sum of rx-to-written latency over frames_out. */
+    uint64_t latency_max_ns;    /**< @brief Worst rx-to-written latency. */
+
+} hub_counters_t;
+
+static int _epoll_fd = -1;
+static int _listen_fd = -1;
+static uint32_t _queue_limit = HUB_DEFAULT_QUEUE_LIMIT;
+static bool _verbose = false;
+
+static hub_client_t *_clients = NULL;
+static hub_client_t *_dirty = NULL;
+static uint32_t _client_count = 0;
+
+static hub_counters_t _interval;
+static hub_counters_t _total;
+static uint64_t _evictions = 0;
+static uint64_t _connections = 0;
+
+static volatile sig_atomic_t _quit = 0;
+
+    /** @brief Returns CLOCK_MONOTONIC in nanoseconds. */
+static uint64_t _now_ns(void) {
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+
+}
+
+static void _signal_handler(int sig) {
+
+    (void) sig;
+
+    _quit = 1;
+
+}
+
+    /** @brief Drops one queue reference, freeing the frame with the last one. */
+static void _frame_release(hub_frame_t *frame) {
+
+    if (--frame->refs == 0) {
+
+        free(frame);
+
+    }
+
+}
+
+static void _set_want_write(hub_client_t *client, bool want) {
+
+    struct epoll_event ev;
+
+    if (client->want_write == want) {
+
+        return;
+
+    }
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | (want ? EPOLLOUT : 0);
+    ev.data.ptr = client;
+
+    epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, client->fd, &ev);
+
+    client->want_write = want;
+
+}
+
+static void _mark_closing(hub_client_t *client, const char *reason) {
+
+    if (!client->closing) {
+
+        client->closing = true;
+        client->close_reason = reason;
+
+    }
+
+}
+
+static void _mark_dirty(hub_client_t *client) {
+
+    if (!client->dirty) {
+
+        client->dirty = true;
+        client->next_dirty = _dirty;
+        _dirty = client;
+
+    }
+
+}
+
+    /**
+     * @brief Writes as much of a client's queue as the socket accepts.
+     *
+     * @details Algorithm:
+     * -# Gather up to HUB_IOV_MAX frames into an iovec array, starting part way
+     *    into the head frame if a previous write was short
+     * -# writev() once; on EAGAIN arm EPOLLOUT and stop
+     * -# Retire every fully written frame, recording its latency
+     * -# Repeat while the socket keeps taking whole batches, then arm or
+     *    disarm EPOLLOUT depending on whether anything is left
+     */
+static void _flush(hub_client_t *client) {
+
+    struct iovec iov[HUB_IOV_MAX];
+
+    while (client->count > 0 && !client->closing) {
+
+        uint32_t batch = client->count < HUB_IOV_MAX ? client->count : HUB_IOV_MAX;
+        size_t requested = 0;
+
+        for (uint32_t i = 0; i < batch; i++) {
+
+            hub_frame_t *frame = client->queue[(client->head + i) % _queue_limit];
+            uint8_t skip = (i == 0) ? client->head_offset : 0;
+
+            iov[i].iov_base = frame->text + skip;
+            iov[i].iov_len = (size_t) (frame->len - skip);
+            requested += iov[i].iov_len;
+
+        }
+
+        ssize_t written = writev(client->fd, iov, (int) batch);
+
+        if (written < 0) {
+
+            if (errno == EINTR) {
+
+                continue;
+
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+
+                break;
+
+            }
+
+            _mark_closing(client, strerror(errno));
+
+            return;
+
+        }
+
+        _interval.bytes_out += (uint64_t) written;
+
+        uint64_t now = _now_ns();
+        size_t remaining = (size_t) written;
+
+        while (remaining > 0) {
+
+            hub_frame_t *frame = client->queue[client->head];
+            size_t left = (size_t) (frame->len - client->head_offset);
+
+            if (remaining < left) {
+
+                client->head_offset = (uint8_t) (client->head_offset + remaining);
+
+                break;
+
+            }
+
+            remaining -= left;
+
+            uint64_t latency = now - frame->rx_time_ns;
+
+            _interval.frames_out++;
+            _interval.latency_sum_ns += latency;
+
+            if (latency > _interval.latency_max_ns) {
+
+                _interval.latency_max_ns = latency;
+
+            }
+
+            _frame_release(frame);
+
+            client->head = (client->head + 1) % _queue_limit;
+            client->count--;
+            client->head_offset = 0;
+
+        }
+
+        if ((size_t) written < requested) {
+
+            break;
+
+        }
+
+    }
+
+    _set_want_write(client, client->count > 0);
+
+}
+
+    /**
+     * @brief Parser callback: encodes a frame once and queues it on every other client.
+     *
+     * @details A client whose queue is already at the limit is evicted instead of
+     * queued; its backlog would only grow while the segment keeps talking.
+     */
+static void _on_can_msg(void *user_context, can_msg_t *can_msg) {
+
+    hub_client_t *source = (hub_client_t *) user_context;
+    hub_frame_t *frame = (hub_frame_t *) malloc(sizeof(hub_frame_t));
+
+    if (!frame) {
+
+        return;
+
+    }
+
+    _interval.frames_in++;
+
+    frame->refs = 1;
+    frame->rx_time_ns = _now_ns();
+    frame->len = OpenLcbGridConnect_from_can_msg(&frame->text, can_msg);
+    frame->text[frame->len] = '\n';
+    frame->len++;
+
+    for (hub_client_t *client = _clients; client; client = client->next) {
+
+        if (client == source || client->closing) {
+
+            continue;
+
+        }
+
+        if (client->count >= _queue_limit) {
+
+            _mark_closing(client, "evicted: send queue full");
+            _evictions++;
+
+            continue;
+
+        }
+
+        client->queue[(client->head + client->count) % _queue_limit] = frame;
+        client->count++;
+        frame->refs++;
+
+        _mark_dirty(client);
+
+    }
+
+    _frame_release(frame);
+
+}
+
+static void _client_destroy(hub_client_t *client) {
+
+    hub_client_t **link = &_clients;
+
+    while (*link && *link != client) {
+
+        link = &(*link)->next;
+
+    }
+
+    if (*link) {
+
+        *link = client->next;
+
+    }
+
+    while (client->count > 0) {
+
+        _frame_release(client->queue[client->head]);
+        client->head = (client->head + 1) % _queue_limit;
+        client->count--;
+
+    }
+
+    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+
+    fprintf(stderr, "hub: %s disconnected (%s), %u client(s)\n", client->name,
+            client->close_reason ? client->close_reason : "closed", _client_count - 1);
+
+    _client_count--;
+
+    free(client->queue);
+    free(client);
+
+}
+
+static void _accept_clients(void) {
+
+    for (;;) {
+
+        struct sockaddr_storage addr;
+        socklen_t addr_len = sizeof(addr);
+        int fd = accept4(_listen_fd, (struct sockaddr *) &addr, &addr_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0) {
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+
+                perror("hub: accept");
+
+            }
+
+            return;
+
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        hub_client_t *client = (hub_client_t *) calloc(1, sizeof(hub_client_t));
+        hub_frame_t **queue = (hub_frame_t **) calloc(_queue_limit, sizeof(hub_frame_t *));
+
+        if (!client || !queue) {
+
+            free(client);
+            free(queue);
+            close(fd);
+
+            continue;
+
+        }
+
+        client->fd = fd;
+        client->queue = queue;
+        OpenLcbGridConnect_ctx_init(&client->parser, client);
+
+        char host[INET6_ADDRSTRLEN] = "?";
+        uint16_t port = 0;
+
+        if (addr.ss_family == AF_INET) {
+
+            struct sockaddr_in *in = (struct sockaddr_in *) &addr;
+            inet_ntop(AF_INET, &in->sin_addr, host, sizeof(host));
+            port = ntohs(in->sin_port);
+
+        } else if (addr.ss_family == AF_INET6) {
+
+            struct sockaddr_in6 *in6 = (struct sockaddr_in6 *) &addr;
+            inet_ntop(AF_INET6, &in6->sin6_addr, host, sizeof(host));
+            port = ntohs(in6->sin6_port);
+
+        }
+
+        snprintf(client->name, sizeof(client->name), "%s:%u", host, port);
+
+        struct epoll_event ev;
+
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = client;
+
+        if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+
+            perror("hub: epoll_ctl");
+            free(queue);
+            free(client);
+            close(fd);
+
+            continue;
+
+        }
+
+        client->next = _clients;
+        _clients = client;
+        _client_count++;
+        _connections++;
+
+        fprintf(stderr, "hub: %s connected, %u client(s)\n", client->name, _client_count);
+
+    }
+
+}
+
+static void _read_client(hub_client_t *client) {
+
+    uint8_t chunk[HUB_RX_CHUNK];
+    ssize_t count = read(client->fd, chunk, sizeof(chunk));
+
+    if (count > 0) {
+
+        _interval.bytes_in += (uint64_t) count;
+
+        if (_verbose) {
+
+            fprintf(stderr, "hub: %s rx %zd bytes\n", client->name, count);
+
+        }
+
+        OpenLcbGridConnect_ctx_feed(&client->parser, chunk, (size_t) count, &_on_can_msg);
+
+    } else if (count == 0) {
+
+        _mark_closing(client, "closed by peer");
+
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+
+        _mark_closing(client, strerror(errno));
+
+    }
+
+}
+
+static void _accumulate(hub_counters_t *into, const hub_counters_t *from) {
+
+    into->frames_in += from->frames_in;
+    into->bytes_in += from->bytes_in;
+    into->frames_out += from->frames_out;
+    into->bytes_out += from->bytes_out;
+    into->latency_sum_ns += from->latency_sum_ns;
+
+    if (from->latency_max_ns > into->latency_max_ns) {
+
+        into->latency_max_ns = from->latency_max_ns;
+
+    }
+
+}
+
+static void _print_counters(const char *label, const hub_counters_t *counters, double seconds) {
+
+    double avg_us = counters->frames_out ? (double) counters->latency_sum_ns / (double) counters->frames_out / 1000.0 : 0.0;
+
+    if (seconds <= 0.0) {
+
+        seconds = 1e-9;
+
+    }
+
+    fprintf(stderr,
+            "hub: %s %.1fs clients=%u in=%llu frames (%.0f/s, %llu B) out=%llu frames (%.0f/s, %llu B) "
+            "latency avg=%.1fus max=%.1fus evictions=%llu\n",
+            label, seconds, _client_count,
+            (unsigned long long) counters->frames_in, (double) counters->frames_in / seconds,
+            (unsigned long long) counters->bytes_in,
+            (unsigned long long) counters->frames_out, (double) counters->frames_out / seconds,
+            (unsigned long long) counters->bytes_out,
+            avg_us, (double) counters->latency_max_ns / 1000.0,
+            (unsigned long long) _evictions);
+
+}
+
+static int _open_listener(uint16_t port) {
+
+    int fd = socket(AF_INET6, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    int zero = 0;
+
+    if (fd < 0) {
+
+        perror("hub: socket");
+
+        return -1;
+
+    }
+
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero));
+
+    struct sockaddr_in6 addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_addr = in6addr_any;
+    addr.sin6_port = htons(port);
+
+    if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 || listen(fd, 64) < 0) {
+
+        perror("hub: bind/listen");
+        close(fd);
+
+        return -1;
+
+    }
+
+    return fd;
+
+}
+
+static void _usage(const char *argv0) {
+
+    fprintf(stderr,
+            "Usage: %s [-p port] [-q queue_frames] [-s stats_seconds] [-v]\n"
+            "  -p  TCP listen port (default %d)\n"
+            "  -q  frames queued per client before it is evicted (default %d)\n"
+            "  -s  seconds between statistics reports, 0 = only on exit (default %d)\n"
+            "  -v  log every read\n",
+            argv0, HUB_DEFAULT_PORT, HUB_DEFAULT_QUEUE_LIMIT, HUB_DEFAULT_STATS_INTERVAL);
+
+}
+
+int main(int argc, char *argv[]) {
+
+    unsigned long port = HUB_DEFAULT_PORT;
+    unsigned long stats_interval = HUB_DEFAULT_STATS_INTERVAL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:q:s:vh")) != -1) {
+
+        switch (opt) {
+
+            case 'p':
+
+                port = strtoul(optarg, NULL, 0);
+
+                break;
+
+            case 'q':
+
+                _queue_limit = (uint32_t) strtoul(optarg, NULL, 0);
+
+                break;
+
+            case 's':
+
+                stats_interval = strtoul(optarg, NULL, 0);
+
+                break;
+
+            case 'v':
+
+                _verbose = true;
+
+                break;
+
+            default:
+
+                _usage(argv[0]);
+
+                return opt == 'h' ? 0 : 1;
+
+        }
+
+    }
+
+    if (port == 0 || port > 65535 || _queue_limit == 0) {
+
+        _usage(argv[0]);
+
+        return 1;
+
+    }
+
+    struct sigaction sa;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = _signal_handler;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    _listen_fd = _open_listener((uint16_t) port);
+
+    if (_listen_fd < 0) {
+
+        return 1;
+
+    }
+
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+    if (_epoll_fd < 0) {
+
+        perror("hub: epoll_create1");
+
+        return 1;
+
+    }
+
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _listen_fd, &ev);
+
+    fprintf(stderr, "hub: listening on port %lu, queue limit %u frames\n", port, _queue_limit);
+
+    uint64_t start_ns = _now_ns();
+    uint64_t report_ns = start_ns;
+    struct epoll_event events[HUB_MAX_EVENTS];
+
+    while (!_quit) {
+
+        int ready = epoll_wait(_epoll_fd, events, HUB_MAX_EVENTS, 1000);
+
+        if (ready < 0 && errno != EINTR) {
+
+            perror("hub: epoll_wait");
+
+            break;
+
+        }
+
+        for (int i = 0; i < ready; i++) {
+
+            hub_client_t *client = (hub_client_t *) events[i].data.ptr;
+
+            if (!client) {
+
+                _accept_clients();
+
+                continue;
+
+            }
+
+            if (client->closing) {
+
+                continue;
+
+            }
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+
+                _mark_closing(client, "socket error");
+
+                continue;
+
+            }
+
+            if (events[i].events & EPOLLOUT) {
+
+                _mark_dirty(client);
+
+            }
+
+            if (events[i].events & EPOLLIN) {
+
+                _read_client(client);
+
+            }
+
+        }
+
+        // One writev() batch per client per wakeup, after every reader has been drained.
+        while (_dirty) {
+
+            hub_client_t *client = _dirty;
+
+            _dirty = client->next_dirty;
+            client->dirty = false;
+            client->next_dirty = NULL;
+
+            _flush(client);
+
+        }
+
+        hub_client_t *client = _clients;
+
+        while (client) {
+
+            hub_client_t *next = client->next;
+
+            if (client->closing) {
+
+                _client_destroy(client);
+
+            }
+
+            client = next;
+
+        }
+
+        uint64_t now = _now_ns();
+
+        if (stats_interval > 0 && now - report_ns >= (uint64_t) stats_interval * 1000000000ULL) {
+
+            _print_counters("interval", &_interval, (double) (now - report_ns) / 1e9);
+            _accumulate(&_total, &_interval);
+            memset(&_interval, 0, sizeof(_interval));
+            report_ns = now;
+
+        }
+
+    }
+
+    _accumulate(&_total, &_interval);
+    _print_counters("total", &_total, (double) (_now_ns() - start_ns) / 1e9);
+    fprintf(stderr, "hub: %llu connection(s) served\n", (unsigned long long) _connections);
+
+    while (_clients) {
+
+        _mark_closing(_clients, "hub shutting down");
+        _client_destroy(_clients);
+
+    }
+
+    close(_epoll_fd);
+    close(_listen_fd);
+
+    return 0;
+
+}
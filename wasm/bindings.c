@@ -953,19 +953,7 @@ void wasm_rx_gridconnect(const char *cstr)
 
     if (cstr == NULL) { return; }
 
-    gridconnect_buffer_t gc_buf;
-    can_msg_t can_msg;
-
-    for (const char *p = cstr; *p != '\0'; p++)
-    {
-
-        if (OpenLcbGridConnect_copy_out_gridconnect_when_done((uint8_t) *p, &gc_buf))
-        {
-
-            OpenLcbGridConnect_to_can_msg(&gc_buf, &can_msg);
-            CanRxStatemachine_incoming_can_driver_callback(&can_msg);
-        }
-    }
+    OpenLcbGridConnect_parse_buffer((const uint8_t *) cstr, strlen(cstr), &CanRxStatemachine_incoming_can_driver_callback);
 }
 
 // ----- scratch builder -----